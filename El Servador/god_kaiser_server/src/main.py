@@ -55,6 +55,7 @@ from .mqtt.handlers import (
     lwt_handler,
     queue_pressure_handler,
     recovery_confirm_handler,
+    sensor_batch_handler,
     sensor_handler,
     subzone_ack_handler,
     zone_ack_handler,
@@ -261,6 +262,10 @@ async def lifespan(app: FastAPI):
         _subscriber_instance.register_handler(
             "kaiser/+/esp/+/sensor/+/data", sensor_handler.handle_sensor_data
         )
+        # Raw sample batches (delta frames) — expanded into single sensor readings
+        _subscriber_instance.register_handler(
+            "kaiser/+/esp/+/sensor/batch", sensor_batch_handler.handle_sensor_batch
+        )
         _subscriber_instance.register_handler(
             "kaiser/+/esp/+/actuator/+/status", actuator_handler.handle_actuator_status
         )
@@ -16,6 +16,7 @@ from . import intent_outcome_lifecycle_handler
 from . import lwt_handler
 from . import queue_pressure_handler
 from . import recovery_confirm_handler
+from . import sensor_batch_handler
 from . import sensor_handler
 from . import subzone_ack_handler
 from . import zone_ack_handler
@@ -37,6 +38,7 @@ __all__ = [
     "lwt_handler",
     "queue_pressure_handler",
     "recovery_confirm_handler",
+    "sensor_batch_handler",
     "sensor_handler",
     "subzone_ack_handler",
     "zone_ack_handler",
@@ -7,6 +7,13 @@ to audit logging and WebSocket realtime consumers.
 Topic: kaiser/{kaiser_id}/esp/{esp_id}/system/intent_outcome
 QoS: 1 (At Least Once)
 
+**Batches (``intent_outcome_batch_v1``):** Firmware may aggregate outcomes of one lane
+into a single message with an ``items`` list. Batch-level fields (counters, retry and
+recovery info, ``ts``) apply to every item; each item carries its own ``intent_id``,
+``correlation_id``, ``generation`` and ``seq`` and is processed exactly like a single
+message. The batch is ACKed only when every item was persisted; on redelivery the
+already stored items hit the stale/dedup path.
+
 **Stale / deduplicated deliveries:** When ``upsert_outcome`` reports ``is_stale`` (duplicate
 or out-of-order generation/seq, or monotonic finality guard), the handler still **commits**
 the transaction and returns ``True`` so MQTT ACKs the message, but it **skips** audit log
@@ -48,6 +55,8 @@ logger = get_logger(__name__)
 class IntentOutcomeHandler:
     """Handle intent outcome messages from ESP devices."""
 
+    _BATCH_ENVELOPE_FIELDS = frozenset({"schema", "items", "batch_id", "lane", "count"})
+
     async def handle_intent_outcome(self, topic: str, payload: dict) -> bool:
         """Validate and process intent outcome payload."""
         try:
@@ -56,6 +65,9 @@ class IntentOutcomeHandler:
                 logger.error("Failed to parse intent_outcome topic: %s", topic)
                 return False
 
+            if isinstance(payload.get("items"), list):
+                return await self._handle_outcome_batch(topic, payload)
+
             payload = dict(payload)
             merge_intent_outcome_nested_data(payload)
             esp_id = parsed_topic["esp_id"]
@@ -263,6 +275,31 @@ class IntentOutcomeHandler:
             logger.error("Error handling intent_outcome message: %s", exc, exc_info=True)
             return False
 
+    async def _handle_outcome_batch(self, topic: str, payload: dict) -> bool:
+        """Unwrap an ``intent_outcome_batch_v1`` message into single outcomes."""
+        shared = {
+            key: value
+            for key, value in payload.items()
+            if key not in self._BATCH_ENVELOPE_FIELDS
+        }
+        items = payload["items"]
+        logger.debug(
+            "Intent outcome batch received: batch_id=%s lane=%s items=%d",
+            payload.get("batch_id"),
+            payload.get("lane"),
+            len(items),
+        )
+        all_persisted = True
+        for item in items:
+            if not isinstance(item, dict):
+                logger.error("Invalid intent_outcome batch item (not an object): topic=%s", topic)
+                continue
+            item_payload = {**shared, **item}
+            item_payload.pop("items", None)
+            if not await self.handle_intent_outcome(topic, item_payload):
+                all_persisted = False
+        return all_persisted
+
     def _validate_payload(self, payload: dict) -> Optional[str]:
         """Return validation error string, or None when valid."""
         required_fields = ("intent_id", "flow", "outcome", "ts")
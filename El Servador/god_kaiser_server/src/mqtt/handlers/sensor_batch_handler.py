@@ -0,0 +1,228 @@
+"""
+MQTT Handler: Raw Sample Batches (Server-Centric High-Rate Raw Mode)
+
+El Trabajante (ESP32) ships streams with a batch policy (batch_max_samples > 1)
+as one delta-encoded frame on ``kaiser/{kaiser_id}/esp/{esp_id}/sensor/batch``
+instead of one ``sensor/{gpio}/data`` publish per sample
+(firmware: services/sensor/raw_sample_batch.h, SensorManager::flushRawBatch).
+
+Payload:
+
+    {
+        "esp_id": "ESP_12AB34CD",
+        "seq": 17,
+        "zone_id": "zone_a",
+        "subzone_id": "",
+        "gpio": 34,
+        "sensor_type": "ph",
+        "raw_mode": true,
+        "enc": "delta",
+        "n": 5,                         # samples in the frame (1..32)
+        "base_ts": 1718000000,          # Unix seconds of sample 0
+        "raw0": 1801,                   # raw value of sample 0 (signed)
+        "d": [-6, 17, -22, 16],         # raw deltas to the previous sample (n-1)
+        "dt": 1000,                     # spacing in ms, or a list of n-1 gaps
+        "time_valid": true,
+        "onewire_address": "28FF...",   # optional
+        "i2c_address": 68               # optional
+    }
+
+Each sample is expanded into a regular sensor data payload and processed by
+SensorDataHandler.handle_sensor_data() in order — same validation, config
+lookup, Pi-Enhanced processing, persistence and logic triggers as a sample
+published on its own.
+
+Error Codes:
+- Uses ValidationErrorCode for topic parse and frame decode failures.
+"""
+
+from typing import Optional
+
+from ...core.error_codes import ValidationErrorCode
+from ...core.logging_config import get_logger
+from ..topics import TopicBuilder
+from .sensor_handler import get_sensor_handler
+
+logger = get_logger(__name__)
+
+# Firmware ring size (RAW_BATCH_MAX_SAMPLES) — larger frames are not produced
+RAW_BATCH_MAX_SAMPLES = 32
+
+# Frame fields; everything else in the payload is the per-sample envelope
+_FRAME_KEYS = ("enc", "n", "base_ts", "raw0", "d", "dt", "seq")
+
+
+def _is_int(value) -> bool:
+    return isinstance(value, int) and not isinstance(value, bool)
+
+
+def decode_delta_frame(payload: dict) -> list[tuple[int, int]]:
+    """
+    Decode a delta frame into samples.
+
+    Args:
+        payload: Batch payload with n, raw0, d and dt
+
+    Returns:
+        [(raw, offset_ms), ...] in chronological order, offset relative to sample 0
+
+    Raises:
+        ValueError: if the frame is malformed
+    """
+    n = payload.get("n")
+    if not _is_int(n) or n < 1 or n > RAW_BATCH_MAX_SAMPLES:
+        raise ValueError(f"Field 'n' must be an integer 1-{RAW_BATCH_MAX_SAMPLES}, got {n!r}")
+
+    raw0 = payload.get("raw0")
+    if not _is_int(raw0):
+        raise ValueError("Field 'raw0' must be integer")
+
+    deltas = payload.get("d", [])
+    if not isinstance(deltas, list) or len(deltas) != n - 1 or not all(_is_int(x) for x in deltas):
+        raise ValueError(f"Field 'd' must be a list of {n - 1} integers")
+
+    dt = payload.get("dt", 0)
+    if _is_int(dt):
+        gaps = [dt] * (n - 1)
+    elif isinstance(dt, list):
+        gaps = dt
+    else:
+        raise ValueError("Field 'dt' must be integer or list")
+    if len(gaps) != n - 1 or not all(_is_int(x) and x >= 0 for x in gaps):
+        raise ValueError(f"Field 'dt' must hold {n - 1} non-negative integers")
+
+    samples = [(raw0, 0)]
+    for delta, gap in zip(deltas, gaps):
+        raw, offset_ms = samples[-1]
+        samples.append((raw + delta, offset_ms + gap))
+    return samples
+
+
+def expand_sensor_batch(payload: dict) -> list[dict]:
+    """
+    Expand a batch payload into single-sample sensor data payloads.
+
+    Args:
+        payload: Batch payload (see module docstring)
+
+    Returns:
+        One payload per sample: envelope fields + "raw" + "ts"
+        (base_ts plus the sample offset, fractional seconds)
+
+    Raises:
+        ValueError: if the frame is malformed or not delta-encoded
+    """
+    if payload.get("enc") != "delta":
+        raise ValueError(f"Unsupported batch encoding: {payload.get('enc')!r}")
+    base_ts = payload.get("base_ts")
+    if not isinstance(base_ts, (int, float)) or isinstance(base_ts, bool):
+        raise ValueError("Field 'base_ts' must be numeric (Unix timestamp)")
+
+    envelope = {key: value for key, value in payload.items() if key not in _FRAME_KEYS}
+    readings = []
+    for raw, offset_ms in decode_delta_frame(payload):
+        reading = dict(envelope)
+        reading["raw"] = raw
+        reading["ts"] = base_ts + offset_ms / 1000.0
+        readings.append(reading)
+    return readings
+
+
+class SensorBatchHandler:
+    """
+    Handles raw sample batches from ESP32 devices.
+
+    Flow:
+    1. Parse topic -> extract kaiser_id, esp_id
+    2. Decode the delta frame into single-sample payloads
+    3. Feed each sample through SensorDataHandler on its sensor/{gpio}/data topic
+    """
+
+    async def handle_sensor_batch(self, topic: str, payload: dict) -> bool:
+        """
+        Handle a sensor batch message.
+
+        Args:
+            topic: MQTT topic string (``kaiser/{kaiser_id}/esp/{esp_id}/sensor/batch``)
+            payload: Parsed JSON payload dict
+
+        Returns:
+            True if every sample was processed, False otherwise
+        """
+        try:
+            parsed_topic = TopicBuilder.parse_sensor_batch_topic(topic)
+            if not parsed_topic:
+                logger.error(
+                    f"[{ValidationErrorCode.MISSING_REQUIRED_FIELD}] "
+                    f"Failed to parse sensor batch topic: {topic}"
+                )
+                return False
+
+            esp_id = parsed_topic["esp_id"]
+            gpio = payload.get("gpio")
+            if not _is_int(gpio):
+                logger.error(
+                    f"[{ValidationErrorCode.INVALID_GPIO}] "
+                    f"Sensor batch from {esp_id} without integer gpio"
+                )
+                return False
+
+            try:
+                readings = expand_sensor_batch(payload)
+            except ValueError as e:
+                logger.error(
+                    f"[{ValidationErrorCode.INVALID_PAYLOAD_FORMAT}] "
+                    f"Invalid sensor batch from {esp_id} (gpio={gpio}): {e}"
+                )
+                return False
+
+            data_topic = TopicBuilder.build_sensor_data_topic(
+                esp_id, gpio, parsed_topic["kaiser_id"]
+            )
+            sensor_handler = get_sensor_handler()
+            processed = 0
+            for reading in readings:
+                if await sensor_handler.handle_sensor_data(data_topic, reading):
+                    processed += 1
+
+            logger.debug(
+                f"Sensor batch: esp_id={esp_id}, gpio={gpio}, "
+                f"sensor_type={payload.get('sensor_type')}, samples={processed}/{len(readings)}"
+            )
+            return processed == len(readings)
+
+        except Exception as e:
+            logger.error(f"Error handling sensor batch: {e}", exc_info=True)
+            return False
+
+
+# Global handler instance
+_handler_instance: Optional[SensorBatchHandler] = None
+
+
+def get_sensor_batch_handler() -> SensorBatchHandler:
+    """
+    Get singleton sensor batch handler instance.
+
+    Returns:
+        SensorBatchHandler instance
+    """
+    global _handler_instance
+    if _handler_instance is None:
+        _handler_instance = SensorBatchHandler()
+    return _handler_instance
+
+
+async def handle_sensor_batch(topic: str, payload: dict) -> bool:
+    """
+    Handle sensor batch message (convenience function).
+
+    Args:
+        topic: MQTT topic string
+        payload: Parsed JSON payload dict
+
+    Returns:
+        True if every sample was processed
+    """
+    handler = get_sensor_batch_handler()
+    return await handler.handle_sensor_batch(topic, payload)
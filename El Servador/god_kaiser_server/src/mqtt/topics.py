@@ -310,7 +310,8 @@ class TopicBuilder:
         """
         Build sensor batch data topic for ESP.
 
-        Used by Mock ESPs to publish batch sensor data messages.
+        El Trabajante publishes delta-encoded raw sample frames here
+        (handled by sensor_batch_handler); also used by Mock ESPs.
 
         Args:
             esp_id: ESP device ID (e.g., ESP_12AB34CD)
@@ -372,6 +373,34 @@ class TopicBuilder:
             }
         return None
 
+    @staticmethod
+    def parse_sensor_batch_topic(topic: str) -> Optional[Dict[str, any]]:
+        """
+        Parse sensor batch topic.
+
+        Args:
+            topic: kaiser/{kaiser_id}/esp/ESP_12AB34CD/sensor/batch
+
+        Returns:
+            {
+                "kaiser_id": "god",
+                "esp_id": "ESP_12AB34CD",
+                "type": "sensor_batch"
+            }
+            or None if parse fails
+        """
+        # Pattern: kaiser/{any_kaiser_id}/esp/{esp_id}/sensor/batch
+        pattern = r"^kaiser/([a-zA-Z0-9_]+)/esp/([A-Z0-9_]+)/sensor/batch$"
+        match = re.match(pattern, topic)
+
+        if match:
+            return {
+                "kaiser_id": match.group(1),
+                "esp_id": match.group(2),
+                "type": "sensor_batch",
+            }
+        return None
+
     @staticmethod
     def parse_sensor_response_topic(topic: str) -> Optional[Dict[str, any]]:
         """
@@ -1183,6 +1212,7 @@ class TopicBuilder:
         # Try all parsers
         parsers = [
             cls.parse_sensor_data_topic,
+            cls.parse_sensor_batch_topic,
             cls.parse_actuator_status_topic,
             cls.parse_actuator_response_topic,
             cls.parse_actuator_alert_topic,
@@ -536,3 +536,83 @@ async def test_recovered_intent_outcome_increments_metrics():
     mock_retry_metric.assert_called_once_with(3)
     mock_recovered_metric.assert_called_once()
     mock_drop_metric.assert_called_once_with("ESP_REC", 1)
+
+
+@pytest.mark.asyncio
+async def test_outcome_batch_is_unwrapped_into_single_outcomes():
+    handler = IntentOutcomeHandler()
+    payload = {
+        "schema": "intent_outcome_batch_v1",
+        "batch_id": 17,
+        "lane": "critical",
+        "count": 2,
+        "contract_version": 2,
+        "retry_count": 1,
+        "recovered": True,
+        "ts": 1735818000,
+        "items": [
+            {
+                "seq": 41,
+                "flow": "command",
+                "intent_id": "intent-b1",
+                "correlation_id": "corr-b1",
+                "generation": 2,
+                "outcome": "applied",
+                "collapsed": 1,
+            },
+            {
+                "seq": 42,
+                "flow": "config",
+                "intent_id": "intent-b2",
+                "correlation_id": "corr-b2",
+                "outcome": "persisted",
+                "ts": 1735818001,
+            },
+        ],
+    }
+
+    session = SimpleNamespace(commit=AsyncMock())
+    captured_payloads: list[dict] = []
+    contract_repo = MagicMock()
+    contract_repo.upsert_intent = AsyncMock(
+        side_effect=lambda p, esp_id: captured_payloads.append(dict(p))
+    )
+    # Stale path keeps the test independent of audit/WS serialization
+    contract_repo.upsert_outcome = AsyncMock(
+        return_value=(SimpleNamespace(outcome="applied", correlation_id="corr-b1"), True)
+    )
+
+    @asynccontextmanager
+    async def fake_resilient_session():
+        yield session
+
+    with (
+        patch(
+            "src.mqtt.handlers.intent_outcome_handler.TopicBuilder.parse_intent_outcome_topic",
+            return_value={"esp_id": "ESP_20"},
+        ),
+        patch(
+            "src.mqtt.handlers.intent_outcome_handler.resilient_session",
+            fake_resilient_session,
+        ),
+        patch(
+            "src.mqtt.handlers.intent_outcome_handler.CommandContractRepository",
+            return_value=contract_repo,
+        ),
+    ):
+        result = await handler.handle_intent_outcome(
+            "kaiser/god/esp/ESP_20/system/intent_outcome",
+            payload,
+        )
+
+    assert result is True
+    assert contract_repo.upsert_outcome.await_count == 2
+    assert [p["intent_id"] for p in captured_payloads] == ["intent-b1", "intent-b2"]
+    assert [p["seq"] for p in captured_payloads] == [41, 42]
+    # Batch-level fields are inherited, item fields win
+    assert captured_payloads[0]["ts"] == 1735818000
+    assert captured_payloads[1]["ts"] == 1735818001
+    assert captured_payloads[0]["recovered"] is True
+    assert captured_payloads[0]["retry_count"] == 1
+    assert "items" not in captured_payloads[0]
+    assert "batch_id" not in captured_payloads[0]
@@ -0,0 +1,210 @@
+"""
+Unit Tests: SensorBatchHandler (MQTT Raw Sample Batches)
+
+Tests the handler for delta-encoded raw sample frames published by
+El Trabajante on kaiser/{kaiser_id}/esp/{esp_id}/sensor/batch.
+
+The frames below are byte-identical to the output of the firmware encoder
+(RawSampleBatch::encode), pinned in
+El Trabajante/test/test_managers/test_raw_sample_batch.cpp — a format change
+on either side breaks one of the two tests.
+
+Mock Strategy:
+- get_sensor_handler: patched to a mock whose handle_sensor_data records the
+  single-sample payloads the batch is expanded into
+"""
+
+import json
+from unittest.mock import AsyncMock, MagicMock, patch
+
+import pytest
+
+from src.mqtt.handlers.sensor_batch_handler import (
+    RAW_BATCH_MAX_SAMPLES,
+    SensorBatchHandler,
+    decode_delta_frame,
+    expand_sensor_batch,
+)
+from src.mqtt.handlers.sensor_handler import SensorDataHandler
+
+# =============================================================================
+# Test Data Constants
+# =============================================================================
+
+BATCH_TOPIC = "kaiser/god/esp/ESP_TEST_001/sensor/batch"
+DATA_TOPIC = "kaiser/god/esp/ESP_TEST_001/sensor/34/data"
+
+# test_batch_roundtrip_uniform_spacing: pH raw ADC at 1 Hz
+FIRMWARE_FRAME_UNIFORM = '"n":5,"base_ts":1718000000,"raw0":1801,"d":[-6,17,-22,16],"dt":1000'
+UNIFORM_RAWS = [1801, 1795, 1812, 1790, 1806]
+
+# test_batch_roundtrip_jittered_spacing_and_negative_raw: DS18B20 raw with loop jitter
+FIRMWARE_FRAME_JITTERED = (
+    '"n":6,"base_ts":42,"raw0":8,"d":[-5,-5,-7,-7,12],"dt":[1010,985,1005,1020,981]'
+)
+JITTERED_RAWS = [8, 3, -2, -9, -16, -4]
+JITTERED_OFFSETS_MS = [0, 1010, 1995, 3000, 4020, 5001]
+
+
+def firmware_payload(frame: str, **envelope) -> dict:
+    """Batch payload as assembled by SensorManager::flushRawBatch()."""
+    fields = {
+        "esp_id": "ESP_TEST_001",
+        "seq": 17,
+        "zone_id": "zone_a",
+        "subzone_id": "",
+        "gpio": 34,
+        "sensor_type": "ph",
+        "raw_mode": True,
+        "enc": "delta",
+    }
+    fields.update(envelope)
+    head = json.dumps(fields)[:-1]
+    return json.loads(f'{head}, {frame}, "time_valid": true}}')
+
+
+def create_mock_sensor_handler(result: bool = True) -> MagicMock:
+    handler = MagicMock()
+    handler.handle_sensor_data = AsyncMock(return_value=result)
+    return handler
+
+
+# =============================================================================
+# Frame Decoding
+# =============================================================================
+
+
+class TestDecodeDeltaFrame:
+    """Decoding of the firmware delta frame."""
+
+    def test_uniform_spacing_roundtrip(self):
+        samples = decode_delta_frame(firmware_payload(FIRMWARE_FRAME_UNIFORM))
+        assert [raw for raw, _ in samples] == UNIFORM_RAWS
+        assert [offset for _, offset in samples] == [0, 1000, 2000, 3000, 4000]
+
+    def test_jittered_spacing_and_negative_raw_roundtrip(self):
+        samples = decode_delta_frame(firmware_payload(FIRMWARE_FRAME_JITTERED))
+        assert [raw for raw, _ in samples] == JITTERED_RAWS
+        assert [offset for _, offset in samples] == JITTERED_OFFSETS_MS
+
+    def test_single_sample_frame(self):
+        samples = decode_delta_frame({"n": 1, "raw0": 1800, "d": [], "dt": 0})
+        assert samples == [(1800, 0)]
+
+    @pytest.mark.parametrize(
+        "frame",
+        [
+            {"n": 0, "raw0": 1, "d": [], "dt": 0},
+            {"n": RAW_BATCH_MAX_SAMPLES + 1, "raw0": 1, "d": [0] * RAW_BATCH_MAX_SAMPLES, "dt": 1},
+            {"n": 3, "raw0": 1, "d": [1], "dt": 1000},
+            {"n": 3, "raw0": 1, "d": [1, 2], "dt": [1000]},
+            {"n": 2, "raw0": 1.5, "d": [1], "dt": 1000},
+            {"n": 2, "raw0": 1, "d": ["1"], "dt": 1000},
+            {"n": 2, "raw0": 1, "d": [1], "dt": -5},
+            {"n": True, "raw0": 1, "d": [], "dt": 0},
+        ],
+    )
+    def test_malformed_frames_rejected(self, frame):
+        with pytest.raises(ValueError):
+            decode_delta_frame(frame)
+
+
+class TestExpandSensorBatch:
+    """Expansion into single-sample sensor data payloads."""
+
+    def test_samples_carry_envelope_raw_and_timestamp(self):
+        readings = expand_sensor_batch(
+            firmware_payload(
+                FIRMWARE_FRAME_JITTERED, sensor_type="ds18b20", onewire_address="28FF641E8D3C0C79"
+            )
+        )
+        assert len(readings) == 6
+        for reading, raw, offset_ms in zip(readings, JITTERED_RAWS, JITTERED_OFFSETS_MS):
+            assert reading["raw"] == raw
+            assert reading["ts"] == pytest.approx(42 + offset_ms / 1000.0)
+            assert reading["gpio"] == 34
+            assert reading["sensor_type"] == "ds18b20"
+            assert reading["onewire_address"] == "28FF641E8D3C0C79"
+            assert reading["time_valid"] is True
+            for frame_key in ("enc", "n", "base_ts", "raw0", "d", "dt", "seq"):
+                assert frame_key not in reading
+
+    def test_samples_pass_sensor_payload_validation(self):
+        validator = SensorDataHandler(publisher=MagicMock())
+        for reading in expand_sensor_batch(firmware_payload(FIRMWARE_FRAME_UNIFORM)):
+            result = validator._validate_payload(reading)
+            assert result["valid"], result["error"]
+
+    def test_unknown_encoding_rejected(self):
+        with pytest.raises(ValueError):
+            expand_sensor_batch(firmware_payload(FIRMWARE_FRAME_UNIFORM, enc="zlib"))
+
+
+# =============================================================================
+# Handler
+# =============================================================================
+
+
+class TestSensorBatchHandler:
+    """Unit tests for SensorBatchHandler."""
+
+    @pytest.mark.asyncio
+    async def test_batch_feeds_each_sample_through_sensor_handler(self):
+        sensor_handler = create_mock_sensor_handler()
+        with patch(
+            "src.mqtt.handlers.sensor_batch_handler.get_sensor_handler",
+            return_value=sensor_handler,
+        ):
+            result = await SensorBatchHandler().handle_sensor_batch(
+                BATCH_TOPIC, firmware_payload(FIRMWARE_FRAME_UNIFORM)
+            )
+
+        assert result is True
+        calls = sensor_handler.handle_sensor_data.await_args_list
+        assert [call.args[0] for call in calls] == [DATA_TOPIC] * 5
+        assert [call.args[1]["raw"] for call in calls] == UNIFORM_RAWS
+        assert [call.args[1]["ts"] for call in calls] == [
+            1718000000.0,
+            1718000001.0,
+            1718000002.0,
+            1718000003.0,
+            1718000004.0,
+        ]
+
+    @pytest.mark.asyncio
+    async def test_failed_sample_reported(self):
+        sensor_handler = create_mock_sensor_handler(result=False)
+        with patch(
+            "src.mqtt.handlers.sensor_batch_handler.get_sensor_handler",
+            return_value=sensor_handler,
+        ):
+            result = await SensorBatchHandler().handle_sensor_batch(
+                BATCH_TOPIC, firmware_payload(FIRMWARE_FRAME_UNIFORM)
+            )
+
+        assert result is False
+        assert sensor_handler.handle_sensor_data.await_count == 5
+
+    @pytest.mark.asyncio
+    @pytest.mark.parametrize(
+        "topic, payload",
+        [
+            (
+                "kaiser/god/esp/ESP_TEST_001/sensor/34/data",
+                firmware_payload(FIRMWARE_FRAME_UNIFORM),
+            ),
+            (BATCH_TOPIC, firmware_payload(FIRMWARE_FRAME_UNIFORM, gpio="34")),
+            (BATCH_TOPIC, firmware_payload('"n":3,"base_ts":1,"raw0":1,"d":[1],"dt":1000')),
+            (BATCH_TOPIC, {"esp_id": "ESP_TEST_001", "gpio": 34, "sensors": []}),
+        ],
+    )
+    async def test_invalid_batch_not_processed(self, topic, payload):
+        sensor_handler = create_mock_sensor_handler()
+        with patch(
+            "src.mqtt.handlers.sensor_batch_handler.get_sensor_handler",
+            return_value=sensor_handler,
+        ):
+            result = await SensorBatchHandler().handle_sensor_batch(topic, payload)
+
+        assert result is False
+        sensor_handler.handle_sensor_data.assert_not_awaited()
@@ -110,6 +110,15 @@ class TestTopicBuilderParse:
         assert result["gpio"] == 34
         assert result["type"] == "sensor_data"
 
+    def test_parse_sensor_batch_topic(self):
+        """Parse sensor batch topic (no GPIO segment)."""
+        result = TopicBuilder.parse_sensor_batch_topic("kaiser/god/esp/ESP_12AB34CD/sensor/batch")
+        assert result is not None
+        assert result["kaiser_id"] == "god"
+        assert result["esp_id"] == "ESP_12AB34CD"
+        assert result["type"] == "sensor_batch"
+        assert TopicBuilder.parse_sensor_batch_topic("kaiser/god/esp/ESP_12AB34CD/sensor/34/data") is None
+
     def test_parse_sensor_data_topic_different_gpio(self):
         """Parse sensor data topic with different GPIO pins."""
         result = TopicBuilder.parse_sensor_data_topic("kaiser/god/esp/ESP_AABBCC/sensor/0/data")
@@ -24,6 +24,17 @@
 // DEFAULT: Disabled (opt-in, full legacy heartbeat preserved)
 // #define ENABLE_METRICS_SPLIT
 
+// ============================================
+// POWER MANAGEMENT (solar / battery field nodes)
+// ============================================
+// Safety-Task and Comm-Task block until the next real deadline (measurement,
+// offline rule evaluation, heartbeat) instead of polling every 10/50 ms.
+// With CONFIG_PM_ENABLE (+ CONFIG_FREERTOS_USE_TICKLESS_IDLE) esp_pm adds DFS
+// and automatic light sleep; WiFi runs in modem sleep.
+// Running actuators and queued commands keep the full 10 ms cadence.
+// DEFAULT: Disabled (opt-in per node type)
+// #define ENABLE_POWER_MANAGEMENT
+
 // ============================================
 // CORE-QUEUE SAFETY CONTRACT (R0-R4)
 // ============================================
@@ -36,4 +47,14 @@
 #define ENABLE_CONFIG_PENDING_REPLAY
 #define ENABLE_LEGACY_FALLBACK_DEGRADE
 
+// ============================================
+// INTENT OUTCOME BATCHING
+// ============================================
+// Outcomes are collected per lane (critical / status) for a short window and
+// published as one intent_outcome_batch_v1 message; accepted → applied for the
+// same intent collapses into the final state. Undeliverable critical batches
+// are persisted as one NVS blob. Requires server-side batch unwrapping.
+// Rollback: comment out → one message per outcome (blob outbox still drains).
+#define ENABLE_INTENT_OUTCOME_BATCHING
+
 #endif
@@ -1 +1,352 @@
+#include "system_controller.h"
+#include "../utils/logger.h"
 
+static const char* TAG = "STATE";
+
+// ============================================
+// TRANSITION TABLE
+// ============================================
+#define SYS_STATE_BIT(state) (1UL << (state))
+
+static const uint32_t SYS_ALL_STATES = (1UL << (STATE_ERROR + 1)) - 1;
+// Portal owns its exits (reconnect / config received → reboot)
+static const uint32_t SYS_NOT_PORTAL = SYS_ALL_STATES & ~SYS_STATE_BIT(STATE_SAFE_MODE_PROVISIONING);
+// Target marker: back to the state saved when the row's source state was entered
+static const uint8_t SYS_TARGET_RESUME = 0xFF;
+
+struct SystemTransition {
+    SystemEvent event;
+    uint32_t from_mask;
+    uint8_t to;             // SystemState or SYS_TARGET_RESUME
+};
+
+// First matching row wins
+static const SystemTransition TRANSITIONS[] = {
+    { SystemEvent::BOOT_LOOP_DETECTED,        SYS_ALL_STATES,                                   STATE_SAFE_MODE },
+    { SystemEvent::STATE_REPAIRED,            SYS_STATE_BIT(STATE_SAFE_MODE_PROVISIONING),      STATE_BOOT },
+    { SystemEvent::PROVISIONING_REQUIRED,     SYS_NOT_PORTAL,                                   STATE_SAFE_MODE_PROVISIONING },
+    { SystemEvent::PORTAL_RECONNECTED,        SYS_STATE_BIT(STATE_SAFE_MODE_PROVISIONING),      STATE_OPERATIONAL },
+    { SystemEvent::OFFLINE_AUTONOMY,          SYS_NOT_PORTAL,                                   STATE_OPERATIONAL },
+    { SystemEvent::CONNECTED_APPROVED,        SYS_NOT_PORTAL,                                   STATE_OPERATIONAL },
+    { SystemEvent::CONNECTED_UNAPPROVED,      SYS_NOT_PORTAL,                                   STATE_PENDING_APPROVAL },
+    { SystemEvent::APPROVAL_GRANTED,          SYS_STATE_BIT(STATE_PENDING_APPROVAL) |
+                                              SYS_STATE_BIT(STATE_ERROR),                       STATE_OPERATIONAL },
+    // Config-pending leaves through the readiness gate only
+    { SystemEvent::APPROVAL_PENDING,          SYS_NOT_PORTAL &
+                                              ~SYS_STATE_BIT(STATE_CONFIG_PENDING_AFTER_RESET), STATE_PENDING_APPROVAL },
+    { SystemEvent::DEVICE_REJECTED,           SYS_NOT_PORTAL,                                   STATE_ERROR },
+    { SystemEvent::ZONE_ASSIGNED,             SYS_NOT_PORTAL,                                   STATE_ZONE_CONFIGURED },
+    { SystemEvent::ZONE_REMOVED,              SYS_NOT_PORTAL,                                   STATE_PENDING_APPROVAL },
+    { SystemEvent::CONFIG_INCOMPLETE,         SYS_NOT_PORTAL & ~SYS_STATE_BIT(STATE_SAFE_MODE) &
+                                              ~SYS_STATE_BIT(STATE_ERROR),                      STATE_CONFIG_PENDING_AFTER_RESET },
+    { SystemEvent::CONFIG_READY_APPROVED,     SYS_STATE_BIT(STATE_CONFIG_PENDING_AFTER_RESET),  STATE_OPERATIONAL },
+    { SystemEvent::CONFIG_READY_UNAPPROVED,   SYS_STATE_BIT(STATE_CONFIG_PENDING_AFTER_RESET),  STATE_PENDING_APPROVAL },
+    { SystemEvent::LIBRARY_DOWNLOAD_STARTED,  SYS_NOT_PORTAL,                                   STATE_LIBRARY_DOWNLOADING },
+    { SystemEvent::LIBRARY_DOWNLOAD_FINISHED, SYS_STATE_BIT(STATE_LIBRARY_DOWNLOADING),         SYS_TARGET_RESUME },
+};
+static const uint8_t TRANSITION_COUNT = sizeof(TRANSITIONS) / sizeof(TRANSITIONS[0]);
+
+// LIBRARY_DOWNLOADING holds the actuators safe until the OtaUpdater is done.
+// Runtime events during the download are matched against the resume state
+// and only retarget it; the switch happens on LIBRARY_DOWNLOAD_FINISHED.
+static bool isDeferredDuringDownload(SystemEvent event) {
+    return event != SystemEvent::BOOT_LOOP_DETECTED &&
+           event != SystemEvent::LIBRARY_DOWNLOAD_STARTED &&
+           event != SystemEvent::LIBRARY_DOWNLOAD_FINISHED;
+}
+
+// ============================================
+// WORK LANES PER STATE
+// ============================================
+// Restricted admission (pending approval / config pending): link only.
+// Setup states, ERROR and LIBRARY_DOWNLOADING keep the full runtime; only
+// OPERATIONAL escalates a lost link to the portal.
+static const uint8_t SYS_WORK_RUNTIME = SYSTEM_WORK_LINK | SYSTEM_WORK_CONTROL;
+
+static const uint8_t WORK_MASKS[STATE_ERROR + 1] = {
+    SYS_WORK_RUNTIME,                           // STATE_BOOT
+    SYS_WORK_RUNTIME,                           // STATE_WIFI_SETUP
+    SYS_WORK_RUNTIME,                           // STATE_WIFI_CONNECTED
+    SYS_WORK_RUNTIME,                           // STATE_MQTT_CONNECTING
+    SYS_WORK_RUNTIME,                           // STATE_MQTT_CONNECTED
+    SYS_WORK_RUNTIME,                           // STATE_AWAITING_USER_CONFIG
+    SYS_WORK_RUNTIME,                           // STATE_ZONE_CONFIGURED
+    SYS_WORK_RUNTIME,                           // STATE_SENSORS_CONFIGURED
+    SYSTEM_WORK_LINK,                           // STATE_CONFIG_PENDING_AFTER_RESET
+    SYS_WORK_RUNTIME | SYSTEM_WORK_LINK_WATCH,  // STATE_OPERATIONAL
+    SYSTEM_WORK_LINK,                           // STATE_PENDING_APPROVAL
+    SYS_WORK_RUNTIME,                           // STATE_LIBRARY_DOWNLOADING
+    SYS_WORK_RUNTIME,                           // STATE_SAFE_MODE
+    SYSTEM_WORK_PORTAL,                         // STATE_SAFE_MODE_PROVISIONING
+    SYS_WORK_RUNTIME,                           // STATE_ERROR
+};
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+SystemController& systemController = SystemController::getInstance();
+
+SystemController& SystemController::getInstance() {
+    static SystemController instance;
+    return instance;
+}
+
+SystemController::SystemController() {
+#ifndef NATIVE_TEST
+    mutex_ = xSemaphoreCreateRecursiveMutexStatic(&mutex_storage_);
+#endif
+    init();  // No lock here: static init runs before the scheduler starts
+}
+
+void SystemController::reset() {
+    lock();
+    init();
+    unlock();
+}
+
+void SystemController::init() {
+    fallback_state_ = STATE_BOOT;
+    state_ = &fallback_state_;
+    resume_state_ = STATE_OPERATIONAL;
+    for (uint8_t i = 0; i <= STATE_ERROR; i++) {
+        actions_[i].on_enter = nullptr;
+        actions_[i].on_exit = nullptr;
+    }
+    listener_ = nullptr;
+    log_head_ = 0;
+    log_count_ = 0;
+    transition_count_ = 0;
+    ignored_count_ = 0;
+}
+
+void SystemController::lock() const {
+#ifdef NATIVE_TEST
+    mutex_.lock();
+#else
+    xSemaphoreTakeRecursive(mutex_, portMAX_DELAY);
+#endif
+}
+
+void SystemController::unlock() const {
+#ifdef NATIVE_TEST
+    mutex_.unlock();
+#else
+    xSemaphoreGiveRecursive(mutex_);
+#endif
+}
+
+void SystemController::begin(SystemState* state, uint32_t now_ms) {
+    lock();
+    state_ = state != nullptr ? state : &fallback_state_;
+    if (*state_ > STATE_ERROR) {
+        *state_ = STATE_BOOT;  // Corrupt NVS value
+    }
+    if (*state_ == STATE_LIBRARY_DOWNLOADING) {
+        resume_state_ = STATE_OPERATIONAL;  // Download did not survive the reboot
+    }
+    LOGF_I(TAG, "Restored state %s at %lu ms", stateName(*state_), (unsigned long)now_ms);
+    unlock();
+}
+
+// ============================================
+// EVENTS
+// ============================================
+int SystemController::findTransition(SystemEvent event, SystemState from) const {
+    for (uint8_t i = 0; i < TRANSITION_COUNT; i++) {
+        if (TRANSITIONS[i].event == event && (TRANSITIONS[i].from_mask & SYS_STATE_BIT(from)) != 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool SystemController::canHandle(SystemEvent event) const {
+    lock();
+    SystemState from = *state_;
+    if (from == STATE_LIBRARY_DOWNLOADING && isDeferredDuringDownload(event)) {
+        from = resume_state_;
+    }
+    bool result = findTransition(event, from) >= 0;
+    unlock();
+    return result;
+}
+
+bool SystemController::handleEvent(SystemEvent event, uint32_t now_ms) {
+    lock();
+    SystemState from = *state_;
+    if (from == STATE_LIBRARY_DOWNLOADING && isDeferredDuringDownload(event)) {
+        bool deferred = deferDuringDownload(event);
+        unlock();
+        return deferred;
+    }
+    int row = findTransition(event, from);
+    if (row < 0) {
+        ignored_count_++;
+        LOGF_D(TAG, "%s ignored in %s", eventName(event), stateName(from));
+        unlock();
+        return false;
+    }
+    SystemState to = TRANSITIONS[row].to == SYS_TARGET_RESUME
+        ? resume_state_
+        : static_cast<SystemState>(TRANSITIONS[row].to);
+    if (to == from) {
+        unlock();
+        return true;
+    }
+
+    if (actions_[from].on_exit != nullptr) {
+        actions_[from].on_exit(from, to, event);
+    }
+    if (to == STATE_LIBRARY_DOWNLOADING) {
+        resume_state_ = from;
+    }
+    *state_ = to;
+    if (actions_[to].on_enter != nullptr) {
+        actions_[to].on_enter(from, to, event);
+    }
+
+    SystemTransitionRecord& record = log_[log_head_];
+    record.timestamp_ms = now_ms;
+    record.from = from;
+    record.to = to;
+    record.event = event;
+    log_head_ = static_cast<uint8_t>((log_head_ + 1) % SYSTEM_TRANSITION_LOG_SIZE);
+    if (log_count_ < SYSTEM_TRANSITION_LOG_SIZE) {
+        log_count_++;
+    }
+    transition_count_++;
+    LOGF_I(TAG, "%s -> %s (%s) at %lu ms", stateName(from), stateName(to), eventName(event),
+           (unsigned long)now_ms);
+
+    if (listener_ != nullptr) {
+        listener_(from, to, event);
+    }
+    unlock();
+    return true;
+}
+
+// Caller holds the lock
+bool SystemController::deferDuringDownload(SystemEvent event) {
+    int row = findTransition(event, resume_state_);
+    if (row < 0) {
+        ignored_count_++;
+        LOGF_D(TAG, "%s ignored in %s (download, resume %s)", eventName(event),
+               stateName(STATE_LIBRARY_DOWNLOADING), stateName(resume_state_));
+        return false;
+    }
+    // Deferrable rows never target LIBRARY_DOWNLOADING or the resume marker
+    resume_state_ = static_cast<SystemState>(TRANSITIONS[row].to);
+    LOGF_I(TAG, "%s deferred until download finished (resume %s)", eventName(event),
+           stateName(resume_state_));
+    return true;
+}
+
+// ============================================
+// QUERIES
+// ============================================
+SystemState SystemController::getState() const {
+    lock();
+    SystemState state = *state_;
+    unlock();
+    return state;
+}
+
+uint8_t SystemController::getWorkMask() const {
+    return workMaskFor(getState());
+}
+
+uint8_t SystemController::workMaskFor(SystemState state) {
+    return state <= STATE_ERROR ? WORK_MASKS[state] : 0;
+}
+
+void SystemController::setStateActions(SystemState state, SystemStateAction on_enter, SystemStateAction on_exit) {
+    if (state > STATE_ERROR) {
+        return;
+    }
+    lock();
+    actions_[state].on_enter = on_enter;
+    actions_[state].on_exit = on_exit;
+    unlock();
+}
+
+void SystemController::setTransitionListener(SystemStateAction listener) {
+    lock();
+    listener_ = listener;
+    unlock();
+}
+
+uint8_t SystemController::getTransitionLog(SystemTransitionRecord* out, uint8_t max_records) const {
+    if (out == nullptr) {
+        return 0;
+    }
+    lock();
+    uint8_t count = log_count_ < max_records ? log_count_ : max_records;
+    // Newest `count` records, oldest first
+    uint8_t start = static_cast<uint8_t>((log_head_ + SYSTEM_TRANSITION_LOG_SIZE - count) % SYSTEM_TRANSITION_LOG_SIZE);
+    for (uint8_t i = 0; i < count; i++) {
+        out[i] = log_[(start + i) % SYSTEM_TRANSITION_LOG_SIZE];
+    }
+    unlock();
+    return count;
+}
+
+uint32_t SystemController::getTransitionCount() const {
+    lock();
+    uint32_t count = transition_count_;
+    unlock();
+    return count;
+}
+
+uint32_t SystemController::getIgnoredEventCount() const {
+    lock();
+    uint32_t count = ignored_count_;
+    unlock();
+    return count;
+}
+
+// ============================================
+// NAMES
+// ============================================
+const char* SystemController::stateName(SystemState state) {
+    switch (state) {
+        case STATE_BOOT: return "BOOT";
+        case STATE_WIFI_SETUP: return "WIFI_SETUP";
+        case STATE_WIFI_CONNECTED: return "WIFI_CONNECTED";
+        case STATE_MQTT_CONNECTING: return "MQTT_CONNECTING";
+        case STATE_MQTT_CONNECTED: return "MQTT_CONNECTED";
+        case STATE_AWAITING_USER_CONFIG: return "AWAITING_USER_CONFIG";
+        case STATE_ZONE_CONFIGURED: return "ZONE_CONFIGURED";
+        case STATE_SENSORS_CONFIGURED: return "SENSORS_CONFIGURED";
+        case STATE_CONFIG_PENDING_AFTER_RESET: return "CONFIG_PENDING_AFTER_RESET";
+        case STATE_OPERATIONAL: return "OPERATIONAL";
+        case STATE_PENDING_APPROVAL: return "PENDING_APPROVAL";
+        case STATE_LIBRARY_DOWNLOADING: return "LIBRARY_DOWNLOADING";
+        case STATE_SAFE_MODE: return "SAFE_MODE";
+        case STATE_SAFE_MODE_PROVISIONING: return "SAFE_MODE_PROVISIONING";
+        case STATE_ERROR: return "ERROR";
+        default: return "UNKNOWN";
+    }
+}
+
+const char* SystemController::eventName(SystemEvent event) {
+    switch (event) {
+        case SystemEvent::BOOT_LOOP_DETECTED: return "BOOT_LOOP_DETECTED";
+        case SystemEvent::STATE_REPAIRED: return "STATE_REPAIRED";
+        case SystemEvent::PROVISIONING_REQUIRED: return "PROVISIONING_REQUIRED";
+        case SystemEvent::PORTAL_RECONNECTED: return "PORTAL_RECONNECTED";
+        case SystemEvent::OFFLINE_AUTONOMY: return "OFFLINE_AUTONOMY";
+        case SystemEvent::CONNECTED_APPROVED: return "CONNECTED_APPROVED";
+        case SystemEvent::CONNECTED_UNAPPROVED: return "CONNECTED_UNAPPROVED";
+        case SystemEvent::APPROVAL_GRANTED: return "APPROVAL_GRANTED";
+        case SystemEvent::APPROVAL_PENDING: return "APPROVAL_PENDING";
+        case SystemEvent::DEVICE_REJECTED: return "DEVICE_REJECTED";
+        case SystemEvent::ZONE_ASSIGNED: return "ZONE_ASSIGNED";
+        case SystemEvent::ZONE_REMOVED: return "ZONE_REMOVED";
+        case SystemEvent::CONFIG_INCOMPLETE: return "CONFIG_INCOMPLETE";
+        case SystemEvent::CONFIG_READY_APPROVED: return "CONFIG_READY_APPROVED";
+        case SystemEvent::CONFIG_READY_UNAPPROVED: return "CONFIG_READY_UNAPPROVED";
+        case SystemEvent::LIBRARY_DOWNLOAD_STARTED: return "LIBRARY_DOWNLOAD_STARTED";
+        case SystemEvent::LIBRARY_DOWNLOAD_FINISHED: return "LIBRARY_DOWNLOAD_FINISHED";
+        default: return "UNKNOWN";
+    }
+}
@@ -1 +1,152 @@
+#ifndef CORE_SYSTEM_CONTROLLER_H
+#define CORE_SYSTEM_CONTROLLER_H
 
+#include <stdint.h>
+#include "../models/system_types.h"
+
+#ifdef NATIVE_TEST
+    #include <mutex>
+#else
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/semphr.h>
+#endif
+
+// ============================================
+// SYSTEM CONTROLLER (table-driven state machine)
+// ============================================
+// Owns every write of g_system_config.current_state. Callers report what
+// happened (SystemEvent); the transition table decides the next state:
+//
+//   event + current state ∈ from_mask → exit(old) → state = to → enter(new)
+//
+// Events without a row for the current state are ignored (e.g. a heartbeat
+// "approved" ACK while OPERATIONAL) — callers no longer pre-check states.
+// Transition to the current state is a no-op (no actions, not logged).
+//
+// LIBRARY_DOWNLOADING is only left by LIBRARY_DOWNLOAD_FINISHED (or a boot
+// loop): other events are matched against the state to resume and retarget
+// it, so actuator admission stays closed while the OtaUpdater is active.
+//
+// Each state carries a work mask (SYSTEM_WORK_*): the Communication-Task and
+// the legacy loop() run the lanes of the current state instead of branching
+// on individual states every tick.
+//
+// Every transition is kept in a ring log with its millis() timestamp
+// (diagnostics command) and logged once.
+//
+// Threading: handleEvent() from Core 0 (MQTT callbacks, Comm-Task) and
+// Core 1 (config lane → pending exit). Recursive lock: actions may query the
+// controller. Actions must not raise further events.
+// ============================================
+
+enum class SystemEvent : uint8_t {
+    BOOT_LOOP_DETECTED = 0,     // >5 boots in <60 s
+    STATE_REPAIRED,             // Persisted provisioning state but valid WiFi config
+    PROVISIONING_REQUIRED,      // WiFi/MQTT failed or long disconnect → portal
+    PORTAL_RECONNECTED,         // Server reachable again while the portal was open
+    OFFLINE_AUTONOMY,           // Boot without WiFi/MQTT, local rules take over
+    CONNECTED_APPROVED,         // Boot: MQTT up, device approved
+    CONNECTED_UNAPPROVED,       // Boot: MQTT up, approval outstanding
+    APPROVAL_GRANTED,           // Heartbeat ACK approved / online
+    APPROVAL_PENDING,           // Heartbeat ACK pending_approval
+    DEVICE_REJECTED,            // Heartbeat ACK rejected
+    ZONE_ASSIGNED,
+    ZONE_REMOVED,
+    CONFIG_INCOMPLETE,          // Runtime config partial after reset
+    CONFIG_READY_APPROVED,      // Pending exit: runtime complete, approved
+    CONFIG_READY_UNAPPROVED,    // Pending exit: runtime complete, not approved
+    LIBRARY_DOWNLOAD_STARTED,
+    LIBRARY_DOWNLOAD_FINISHED,  // Back to the state before the download
+    COUNT
+};
+
+// Work lanes of a state (bitmask)
+static const uint8_t SYSTEM_WORK_PORTAL = 0x01;      // Provisioning portal (AP + HTTP)
+static const uint8_t SYSTEM_WORK_LINK = 0x02;        // WiFi + MQTT + publish queue
+static const uint8_t SYSTEM_WORK_CONTROL = 0x04;     // Sensor/actuator lanes, telemetry shipping
+static const uint8_t SYSTEM_WORK_LINK_WATCH = 0x08;  // Disconnect debounce → portal
+
+static const uint8_t SYSTEM_TRANSITION_LOG_SIZE = 16;
+
+struct SystemTransitionRecord {
+    uint32_t timestamp_ms;
+    SystemState from;
+    SystemState to;
+    SystemEvent event;
+};
+
+// Entry / exit action and transition listener
+typedef void (*SystemStateAction)(SystemState from, SystemState to, SystemEvent event);
+
+class SystemController {
+public:
+    static SystemController& getInstance();
+
+    // Binds the state storage (g_system_config.current_state) and adopts the
+    // persisted value without running entry actions
+    void begin(SystemState* state, uint32_t now_ms);
+
+    // false: no transition for this event in the current state (ignored).
+    // During a library download true means "resume target updated".
+    bool handleEvent(SystemEvent event, uint32_t now_ms);
+    bool canHandle(SystemEvent event) const;
+
+    SystemState getState() const;
+    uint8_t getWorkMask() const;
+    bool allows(uint8_t work) const { return (getWorkMask() & work) == work; }
+
+    void setStateActions(SystemState state, SystemStateAction on_enter, SystemStateAction on_exit);
+    // Called after every transition (after the entry action)
+    void setTransitionListener(SystemStateAction listener);
+
+    // Oldest first; returns the number of records copied
+    uint8_t getTransitionLog(SystemTransitionRecord* out, uint8_t max_records) const;
+    uint32_t getTransitionCount() const;
+    uint32_t getIgnoredEventCount() const;
+
+    static const char* stateName(SystemState state);
+    static const char* eventName(SystemEvent event);
+    static uint8_t workMaskFor(SystemState state);
+
+    // Test helper: unbound, no actions, empty log
+    void reset();
+
+private:
+    SystemController();
+    SystemController(const SystemController&) = delete;
+    SystemController& operator=(const SystemController&) = delete;
+
+    void init();
+    void lock() const;
+    void unlock() const;
+    int findTransition(SystemEvent event, SystemState from) const;
+    bool deferDuringDownload(SystemEvent event);
+
+    struct StateActions {
+        SystemStateAction on_enter;
+        SystemStateAction on_exit;
+    };
+
+    SystemState* state_;
+    SystemState fallback_state_;    // Storage until begin()
+    SystemState resume_state_;      // State before LIBRARY_DOWNLOADING
+    StateActions actions_[STATE_ERROR + 1];
+    SystemStateAction listener_;
+
+    SystemTransitionRecord log_[SYSTEM_TRANSITION_LOG_SIZE];
+    uint8_t log_head_;              // Next write slot
+    uint8_t log_count_;
+    uint32_t transition_count_;
+    uint32_t ignored_count_;
+
+#ifdef NATIVE_TEST
+    mutable std::recursive_mutex mutex_;
+#else
+    SemaphoreHandle_t mutex_;
+    StaticSemaphore_t mutex_storage_;
+#endif
+};
+
+extern SystemController& systemController;
+
+#endif
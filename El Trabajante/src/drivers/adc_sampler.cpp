@@ -0,0 +1,343 @@
+#include "adc_sampler.h"
+#include "../utils/logger.h"
+#include <string.h>
+
+#ifndef UNIT_TEST
+    #include <Arduino.h>
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+    #include "hal/esp32_adc_continuous_hal.h"
+    #include "../error_handling/resource_monitor.h"
+#endif
+
+static const char* TAG = "ADC";
+
+static const size_t ADC_SAMPLER_READ_BATCH = 128;       // Samples per HAL read (512 B on the task stack)
+static const uint32_t ADC_SAMPLER_READ_TIMEOUT_MS = 50;
+
+// ============================================
+// WINDOW ACCUMULATOR
+// ============================================
+void AdcWindowAccumulator::reset() {
+    count_ = 0;
+    sum_ = 0;
+    sum_sq_ = 0;
+    min_ = UINT16_MAX;
+    max_ = 0;
+}
+
+bool AdcWindowAccumulator::add(uint16_t raw, uint16_t window_samples) {
+    count_++;
+    sum_ += raw;
+    sum_sq_ += static_cast<uint64_t>(raw) * raw;
+    if (raw < min_) min_ = raw;
+    if (raw > max_) max_ = raw;
+    return count_ >= window_samples;
+}
+
+void AdcWindowAccumulator::finish(uint8_t gpio, uint32_t window_seq, uint32_t end_ms,
+                                  AdcWindowStats& out) const {
+    out.gpio = gpio;
+    out.count = static_cast<uint16_t>(count_);
+    out.window_seq = window_seq;
+    out.end_ms = end_ms;
+    if (count_ == 0) {
+        out.min = out.max = out.mean_raw = 0;
+        out.mean = out.variance = 0.0f;
+        return;
+    }
+    out.min = min_;
+    out.max = max_;
+    out.mean = static_cast<float>(static_cast<double>(sum_) / count_);
+    out.mean_raw = static_cast<uint16_t>((sum_ + count_ / 2) / count_);
+    // n·Σx² - (Σx)² is exact in 64 bit and never negative
+    uint64_t spread = count_ * sum_sq_ - sum_ * sum_;
+    out.variance = count_ > 1
+        ? static_cast<float>(static_cast<double>(spread) / (static_cast<double>(count_) * (count_ - 1)))
+        : 0.0f;
+}
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+#ifndef UNIT_TEST
+static ESP32AdcContinuousHal s_production_adc_hal;
+#endif
+
+AdcSampler& adcSampler = AdcSampler::getInstance();
+
+AdcSampler& AdcSampler::getInstance() {
+    static AdcSampler instance;
+    return instance;
+}
+
+AdcSampler::AdcSampler() : hal_(nullptr), task_handle_(nullptr) {
+    reset();
+}
+
+void AdcSampler::reset() {
+    if (hal_ != nullptr) {
+        hal_->stop();
+    }
+    hal_ = nullptr;
+    config_ = AdcSamplerConfig();
+    for (uint8_t i = 0; i < ADC_SAMPLER_MAX_CHANNELS; i++) {
+        slots_[i].gpio.store(ADC_SAMPLER_NO_GPIO);
+        slots_[i].scanned_gpio.store(ADC_SAMPLER_NO_GPIO);
+        slots_[i].seq.store(0);
+        memset(&slots_[i].published, 0, sizeof(AdcWindowStats));
+        slots_[i].accumulator.reset();
+        slots_[i].window_seq = 0;
+    }
+    requested_generation_.store(0);
+    scanned_generation_ = 0;
+    scan_running_.store(false);
+    scan_failed_.store(false);
+    dropped_samples_.store(0);
+    restart_failures_.store(0);
+    memset(slot_of_gpio_, ADC_SAMPLER_NO_GPIO, sizeof(slot_of_gpio_));
+}
+
+// ============================================
+// SAMPLER TASK (production only)
+// ============================================
+#ifndef UNIT_TEST
+static const uint32_t ADC_SAMPLER_TASK_STACK_BYTES = 3072;
+static const UBaseType_t ADC_SAMPLER_TASK_PRIORITY = 1;  // Below Comm-Task (3)
+static const BaseType_t ADC_SAMPLER_TASK_CORE = 0;
+
+static void adcSamplerTaskFunction(void* param) {
+    (void)param;
+    for (;;) {
+        // HAL read blocks while a scan runs; idle scan → poll for channel changes
+        if (adcSampler.pump(millis(), ADC_SAMPLER_READ_TIMEOUT_MS) == 0) {
+            vTaskDelay(pdMS_TO_TICKS(ADC_SAMPLER_READ_TIMEOUT_MS));
+        }
+    }
+}
+#endif
+
+bool AdcSampler::begin(IAdcSamplerHal* hal, const AdcSamplerConfig& config) {
+#ifndef UNIT_TEST
+    if (hal == nullptr) {
+        hal = &s_production_adc_hal;
+    }
+#endif
+    if (hal == nullptr || hal_ != nullptr) {
+        return hal_ != nullptr && hal_ == hal;
+    }
+    config_ = config;
+    if (config_.window_samples == 0) {
+        config_.window_samples = ADC_SAMPLER_WINDOW_SAMPLES;
+    }
+    hal_ = hal;
+
+#ifndef UNIT_TEST
+    TaskHandle_t handle = nullptr;
+    BaseType_t created = xTaskCreatePinnedToCore(adcSamplerTaskFunction, "AdcSampler",
+                                                 ADC_SAMPLER_TASK_STACK_BYTES / sizeof(StackType_t),
+                                                 nullptr, ADC_SAMPLER_TASK_PRIORITY, &handle,
+                                                 ADC_SAMPLER_TASK_CORE);
+    if (created != pdPASS || handle == nullptr) {
+        LOG_E(TAG, "Failed to create ADC sampler task — analog sensors use analogRead()");
+        hal_ = nullptr;
+        return false;
+    }
+    task_handle_ = handle;
+    resourceMonitor.registerTask("AdcSampler", handle, ADC_SAMPLER_TASK_STACK_BYTES);
+#endif
+
+    LOG_I(TAG, "ADC sampler ready: " + String((unsigned long)config_.sample_rate_hz) + " Hz scan, " +
+               String(config_.window_samples) + " samples/window");
+    return true;
+}
+
+// ============================================
+// CHANNELS (Safety-Task)
+// ============================================
+bool AdcSampler::supportsPin(uint8_t gpio) const {
+    return hal_ != nullptr && gpio < sizeof(slot_of_gpio_) && hal_->supportsPin(gpio);
+}
+
+bool AdcSampler::isActive() const {
+    return hal_ != nullptr && !scan_failed_.load(std::memory_order_acquire);
+}
+
+int AdcSampler::findSlot(uint8_t gpio) const {
+    for (uint8_t i = 0; i < ADC_SAMPLER_MAX_CHANNELS; i++) {
+        if (slots_[i].gpio.load(std::memory_order_relaxed) == gpio) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool AdcSampler::hasChannel(uint8_t gpio) const {
+    return gpio != ADC_SAMPLER_NO_GPIO && findSlot(gpio) >= 0;
+}
+
+uint8_t AdcSampler::getChannelCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < ADC_SAMPLER_MAX_CHANNELS; i++) {
+        if (slots_[i].gpio.load(std::memory_order_relaxed) != ADC_SAMPLER_NO_GPIO) {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint32_t AdcSampler::getWindowMs() const {
+    uint32_t channels = getChannelCount();
+    if (channels == 0) {
+        channels = 1;
+    }
+    if (config_.sample_rate_hz == 0) {
+        return 0;
+    }
+    uint64_t scan_samples = static_cast<uint64_t>(config_.window_samples) * channels * 1000ULL;
+    return static_cast<uint32_t>((scan_samples + config_.sample_rate_hz - 1) / config_.sample_rate_hz);
+}
+
+bool AdcSampler::addChannel(uint8_t gpio) {
+    if (!supportsPin(gpio)) {
+        return false;
+    }
+    if (hasChannel(gpio)) {
+        return true;
+    }
+    int free_slot = findSlot(ADC_SAMPLER_NO_GPIO);
+    if (free_slot < 0) {
+        LOG_W(TAG, "No free ADC sampler slot for GPIO " + String(gpio));
+        return false;
+    }
+    slots_[free_slot].gpio.store(gpio, std::memory_order_relaxed);
+    requested_generation_.fetch_add(1, std::memory_order_release);
+    LOG_I(TAG, "GPIO " + String(gpio) + " added to continuous ADC scan");
+    return true;
+}
+
+void AdcSampler::removeChannel(uint8_t gpio) {
+    int slot = gpio != ADC_SAMPLER_NO_GPIO ? findSlot(gpio) : -1;
+    if (slot < 0) {
+        return;
+    }
+    slots_[slot].gpio.store(ADC_SAMPLER_NO_GPIO, std::memory_order_relaxed);
+    requested_generation_.fetch_add(1, std::memory_order_release);
+    LOG_I(TAG, "GPIO " + String(gpio) + " removed from continuous ADC scan");
+}
+
+// ============================================
+// LOCK-FREE READ (Safety-Task)
+// ============================================
+bool AdcSampler::getLatest(uint8_t gpio, AdcWindowStats& out, uint32_t now_ms) const {
+    if (gpio == ADC_SAMPLER_NO_GPIO) {
+        return false;
+    }
+    for (uint8_t i = 0; i < ADC_SAMPLER_MAX_CHANNELS; i++) {
+        const Slot& slot = slots_[i];
+        if (slot.scanned_gpio.load(std::memory_order_acquire) != gpio) {
+            continue;
+        }
+        uint32_t before;
+        uint32_t after;
+        do {
+            before = slot.seq.load(std::memory_order_acquire);
+            if (before & 1U) {
+                continue;  // Writer active — retry
+            }
+            memcpy(&out, &slot.published, sizeof(AdcWindowStats));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = slot.seq.load(std::memory_order_relaxed);
+        } while ((before & 1U) || before != after);
+
+        return out.gpio == gpio && out.count > 0 &&
+               now_ms - out.end_ms <= config_.max_window_age_ms;
+    }
+    return false;
+}
+
+// ============================================
+// PUMP (sampler task — single writer)
+// ============================================
+void AdcSampler::publish(Slot& slot, const AdcWindowStats& stats) {
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&slot.published, &stats, sizeof(AdcWindowStats));
+    slot.seq.store(seq + 2, std::memory_order_release);
+}
+
+bool AdcSampler::restartScan() {
+    hal_->stop();
+    scan_running_.store(false);
+    memset(slot_of_gpio_, ADC_SAMPLER_NO_GPIO, sizeof(slot_of_gpio_));
+
+    uint8_t gpios[ADC_SAMPLER_MAX_CHANNELS];
+    uint8_t count = 0;
+    AdcWindowStats empty;
+    memset(&empty, 0, sizeof(empty));
+    for (uint8_t i = 0; i < ADC_SAMPLER_MAX_CHANNELS; i++) {
+        Slot& slot = slots_[i];
+        uint8_t gpio = slot.gpio.load(std::memory_order_relaxed);
+        // Windows of the previous scan are invalid for the new pin set
+        slot.scanned_gpio.store(ADC_SAMPLER_NO_GPIO, std::memory_order_release);
+        publish(slot, empty);
+        slot.accumulator.reset();
+        slot.window_seq = 0;
+        if (gpio != ADC_SAMPLER_NO_GPIO) {
+            gpios[count++] = gpio;
+            slot_of_gpio_[gpio] = i;
+        }
+    }
+    if (count == 0) {
+        scan_failed_.store(false, std::memory_order_release);
+        return true;
+    }
+
+    if (!hal_->start(gpios, count, config_.sample_rate_hz)) {
+        restart_failures_.fetch_add(1, std::memory_order_relaxed);
+        scan_failed_.store(true, std::memory_order_release);
+        LOG_E(TAG, "Continuous ADC scan failed to start (" + String(count) +
+                   " pins) — falling back to analogRead()");
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        slots_[slot_of_gpio_[gpios[i]]].scanned_gpio.store(gpios[i], std::memory_order_release);
+    }
+    scan_failed_.store(false, std::memory_order_release);
+    scan_running_.store(true);
+    return true;
+}
+
+size_t AdcSampler::pump(uint32_t now_ms, uint32_t timeout_ms) {
+    if (hal_ == nullptr) {
+        return 0;
+    }
+    uint32_t generation = requested_generation_.load(std::memory_order_acquire);
+    if (generation != scanned_generation_) {
+        scanned_generation_ = generation;
+        restartScan();
+    }
+    if (!scan_running_.load()) {
+        return 0;
+    }
+
+    AdcRawSample samples[ADC_SAMPLER_READ_BATCH];
+    size_t count = hal_->read(samples, ADC_SAMPLER_READ_BATCH, timeout_ms);
+    for (size_t i = 0; i < count; i++) {
+        uint8_t gpio = samples[i].gpio;
+        uint8_t index = gpio < sizeof(slot_of_gpio_) ? slot_of_gpio_[gpio] : ADC_SAMPLER_NO_GPIO;
+        if (index == ADC_SAMPLER_NO_GPIO) {
+            dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        Slot& slot = slots_[index];
+        if (slot.accumulator.add(samples[i].raw, config_.window_samples)) {
+            AdcWindowStats stats;
+            slot.accumulator.finish(gpio, ++slot.window_seq, now_ms, stats);
+            publish(slot, stats);
+            slot.accumulator.reset();
+        }
+    }
+    return count;
+}
@@ -0,0 +1,152 @@
+#ifndef DRIVERS_ADC_SAMPLER_H
+#define DRIVERS_ADC_SAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "hal/iadc_sampler_hal.h"
+
+// ============================================
+// ADC SAMPLER (continuous DMA conversion + window statistics)
+// ============================================
+// Replaces the blocking analogRead() per measurement for analog sensors
+// (pH, EC, moisture): the ADC scans all registered pins in the background,
+// a low-priority task drains the DMA results and folds them into per-pin
+// accumulators. Every window_samples conversions of a pin the window
+// statistics (mean, min/max, variance) are published and the accumulator
+// starts over. A measurement only copies the latest published window.
+//
+// Lock-free publish: one writer (sampler task) per slot, readers
+// (Safety-Task) use a sequence counter — odd while the writer updates the
+// slot, a reader retries when the counter moved during its copy.
+//
+// Channel set changes (sensor added/removed, Safety-Task) bump a generation
+// counter; the sampler task restarts the scan with the new pin set and
+// discards the windows of the previous scan.
+//
+// Threading: addChannel/removeChannel/getLatest on the Safety-Task
+// (g_sensor_mutex held), pump() on the sampler task (Core 0).
+// ============================================
+
+static const uint8_t ADC_SAMPLER_MAX_CHANNELS = 8;          // ESP32 ADC1: 8 channels
+static const uint32_t ADC_SAMPLER_SAMPLE_RATE_HZ = 20000;   // Total scan rate (ESP32 minimum)
+static const uint16_t ADC_SAMPLER_WINDOW_SAMPLES = 1024;    // Per pin; 3 pins → ~150 ms window
+static const uint32_t ADC_SAMPLER_MAX_WINDOW_AGE_MS = 2000; // Older window → sampler stalled
+static const uint8_t ADC_SAMPLER_NO_GPIO = 0xFF;
+
+struct AdcWindowStats {
+    uint8_t gpio;
+    uint16_t count;       // Samples in the window (0 = no window yet)
+    uint16_t min;
+    uint16_t max;
+    uint16_t mean_raw;    // Mean rounded to a raw ADC count
+    float mean;
+    float variance;       // Sample variance (n-1), raw counts²
+    uint32_t window_seq;  // Windows published since the scan (re)started
+    uint32_t end_ms;      // millis() when the window closed
+};
+
+struct AdcSamplerConfig {
+    uint32_t sample_rate_hz;
+    uint16_t window_samples;
+    uint32_t max_window_age_ms;
+
+    AdcSamplerConfig()
+        : sample_rate_hz(ADC_SAMPLER_SAMPLE_RATE_HZ),
+          window_samples(ADC_SAMPLER_WINDOW_SAMPLES),
+          max_window_age_ms(ADC_SAMPLER_MAX_WINDOW_AGE_MS) {}
+};
+
+// ============================================
+// WINDOW ACCUMULATOR (writer side, no locking)
+// ============================================
+// Exact integer sums: 12 bit samples, window <= 65535 → sum_sq < 2^41 and
+// n * sum_sq < 2^57, so the variance needs no floating point accumulation.
+class AdcWindowAccumulator {
+public:
+    AdcWindowAccumulator() { reset(); }
+
+    void reset();
+    // Returns true when the window is full (call finish(), then reset())
+    bool add(uint16_t raw, uint16_t window_samples);
+    void finish(uint8_t gpio, uint32_t window_seq, uint32_t end_ms, AdcWindowStats& out) const;
+
+    uint32_t count() const { return count_; }
+
+private:
+    uint32_t count_;
+    uint64_t sum_;
+    uint64_t sum_sq_;
+    uint16_t min_;
+    uint16_t max_;
+};
+
+class AdcSampler {
+public:
+    static AdcSampler& getInstance();
+
+    // Production: hal == nullptr → ESP32AdcContinuousHal + sampler task.
+    // Native tests inject a mock HAL and drive pump() directly.
+    bool begin(IAdcSamplerHal* hal = nullptr, const AdcSamplerConfig& config = AdcSamplerConfig());
+
+    // Safety-Task: register / unregister an analog pin (restart on next pump)
+    bool addChannel(uint8_t gpio);
+    void removeChannel(uint8_t gpio);
+    bool hasChannel(uint8_t gpio) const;
+    bool supportsPin(uint8_t gpio) const;
+
+    // Sampler owns the ADC1 pins: false before begin() and after a failed
+    // scan start — only then may analogRead() be used on an ADC1 pin
+    // (continuous mode holds the ADC1 lock while running).
+    bool isActive() const;
+
+    // Latest complete window; false if none yet or older than max_window_age_ms
+    bool getLatest(uint8_t gpio, AdcWindowStats& out, uint32_t now_ms) const;
+
+    // Sampler task: applies channel changes, drains the HAL, publishes windows.
+    // Returns the number of samples consumed.
+    size_t pump(uint32_t now_ms, uint32_t timeout_ms);
+
+    uint8_t getChannelCount() const;
+    // Duration of one window with the current scan (ms, rounded up)
+    uint32_t getWindowMs() const;
+    uint32_t getDroppedSamples() const { return dropped_samples_.load(std::memory_order_relaxed); }
+    uint32_t getRestartFailures() const { return restart_failures_.load(std::memory_order_relaxed); }
+
+    // Test helper: back to power-on state
+    void reset();
+
+private:
+    AdcSampler();
+    AdcSampler(const AdcSampler&) = delete;
+    AdcSampler& operator=(const AdcSampler&) = delete;
+
+    struct Slot {
+        std::atomic<uint8_t> gpio;            // Requested pin (Safety-Task writes)
+        std::atomic<uint8_t> scanned_gpio;    // Pin of the running scan (sampler task writes)
+        std::atomic<uint32_t> seq;            // Seqlock counter for `published`
+        AdcWindowStats published;
+        AdcWindowAccumulator accumulator;     // Sampler task only
+        uint32_t window_seq;                  // Sampler task only
+    };
+
+    bool restartScan();
+    void publish(Slot& slot, const AdcWindowStats& stats);
+    int findSlot(uint8_t gpio) const;
+
+    IAdcSamplerHal* hal_;
+    AdcSamplerConfig config_;
+    Slot slots_[ADC_SAMPLER_MAX_CHANNELS];
+    std::atomic<uint32_t> requested_generation_;
+    uint32_t scanned_generation_;            // Sampler task only
+    std::atomic<bool> scan_running_;
+    std::atomic<bool> scan_failed_;
+    std::atomic<uint32_t> dropped_samples_;
+    std::atomic<uint32_t> restart_failures_;
+    uint8_t slot_of_gpio_[64];               // Sampler task only: gpio → slot of the running scan
+    void* task_handle_;
+};
+
+extern AdcSampler& adcSampler;
+
+#endif
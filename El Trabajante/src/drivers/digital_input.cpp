@@ -0,0 +1,237 @@
+#include "digital_input.h"
+#include "gpio_manager.h"
+#include "../utils/logger.h"
+
+static const char* TAG = "DIN";
+
+static const uint8_t DIGITAL_INPUT_NO_GPIO = 255;
+static const uint8_t DIGITAL_INPUT_QUEUE_MASK = DIGITAL_INPUT_QUEUE_SIZE - 1;
+
+// ISR path must live in IRAM (flash cache may be disabled during NVS writes)
+#ifdef UNIT_TEST
+    #define DIGITAL_INPUT_ISR_ATTR
+#else
+    #define DIGITAL_INPUT_ISR_ATTR IRAM_ATTR
+#endif
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+DigitalInputManager& digitalInputs = DigitalInputManager::getInstance();
+
+DigitalInputManager& DigitalInputManager::getInstance() {
+    static DigitalInputManager instance;
+    return instance;
+}
+
+DigitalInputManager::DigitalInputManager() : wake_hook_(nullptr) {
+    reset();
+}
+
+void DigitalInputManager::reset() {
+    for (uint8_t i = 0; i < DIGITAL_INPUT_MAX_CHANNELS; i++) {
+        channels_[i].gpio = DIGITAL_INPUT_NO_GPIO;
+        channels_[i].debounce_us = 0;
+        channels_[i].stable_level = false;
+        channels_[i].candidate_pending = false;
+        channels_[i].candidate_level = false;
+        channels_[i].candidate_us = 0;
+        channels_[i].first_edge_us = 0;
+        channels_[i].edge_seen = false;
+    }
+    head_.store(0);
+    tail_.store(0);
+    overflow_.store(false);
+    dropped_edges_.store(0);
+    attached_count_.store(0);
+    wake_hook_ = nullptr;
+}
+
+void DigitalInputManager::setWakeHook(void (*hook)()) {
+    wake_hook_ = hook;
+}
+
+// ============================================
+// CHANNELS
+// ============================================
+int DigitalInputManager::findChannel(uint8_t gpio) const {
+    for (uint8_t i = 0; i < DIGITAL_INPUT_MAX_CHANNELS; i++) {
+        if (channels_[i].gpio == gpio) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool DigitalInputManager::isAttached(uint8_t gpio) const {
+    return gpio != DIGITAL_INPUT_NO_GPIO && findChannel(gpio) >= 0;
+}
+
+bool DigitalInputManager::attach(uint8_t gpio, uint16_t debounce_ms) {
+    if (debounce_ms > DIGITAL_INPUT_MAX_DEBOUNCE_MS) {
+        debounce_ms = DIGITAL_INPUT_MAX_DEBOUNCE_MS;
+    }
+    int index = isAttached(gpio) ? findChannel(gpio) : -1;
+    if (index >= 0) {
+        channels_[index].debounce_us = static_cast<uint32_t>(debounce_ms) * 1000UL;
+        return true;
+    }
+    index = findChannel(DIGITAL_INPUT_NO_GPIO);
+    if (index < 0) {
+        LOG_E(TAG, "All digital input channels in use (GPIO " + String(gpio) + ")");
+        return false;
+    }
+    // Arm first, then read: an edge in between repeats the read level (no-op)
+    if (!gpioManager.attachEdgeInterrupt(gpio, &DigitalInputManager::onEdge, this)) {
+        return false;
+    }
+
+    Channel& channel = channels_[index];
+    channel.debounce_us = static_cast<uint32_t>(debounce_ms) * 1000UL;
+    channel.stable_level = gpioManager.readPin(gpio);
+    channel.candidate_pending = false;
+    channel.candidate_level = channel.stable_level;
+    channel.candidate_us = 0;
+    channel.first_edge_us = 0;
+    channel.edge_seen = false;
+    channel.gpio = gpio;
+    attached_count_.fetch_add(1, std::memory_order_relaxed);
+    LOG_I(TAG, "GPIO " + String(gpio) + " edge events armed (debounce " + String(debounce_ms) +
+               " ms, level " + String(channel.stable_level ? "HIGH" : "LOW") + ")");
+    return true;
+}
+
+void DigitalInputManager::detach(uint8_t gpio) {
+    int index = gpio != DIGITAL_INPUT_NO_GPIO ? findChannel(gpio) : -1;
+    if (index < 0) {
+        return;
+    }
+    gpioManager.detachEdgeInterrupt(gpio);
+    channels_[index].gpio = DIGITAL_INPUT_NO_GPIO;
+    attached_count_.fetch_sub(1, std::memory_order_relaxed);
+    LOG_I(TAG, "GPIO " + String(gpio) + " edge events disarmed");
+}
+
+bool DigitalInputManager::getState(uint8_t gpio, bool& level) const {
+    int index = gpio != DIGITAL_INPUT_NO_GPIO ? findChannel(gpio) : -1;
+    if (index < 0) {
+        return false;
+    }
+    level = channels_[index].stable_level;
+    return true;
+}
+
+// ============================================
+// ISR: EDGE RING (single producer)
+// ============================================
+void DIGITAL_INPUT_ISR_ATTR DigitalInputManager::onEdge(void* arg, uint8_t gpio, bool level, uint32_t time_us) {
+    DigitalInputManager* self = static_cast<DigitalInputManager*>(arg);
+    self->pushEdge(gpio, level, time_us);
+    if (self->wake_hook_ != nullptr) {
+        self->wake_hook_();
+    }
+}
+
+void DIGITAL_INPUT_ISR_ATTR DigitalInputManager::pushEdge(uint8_t gpio, bool level, uint32_t time_us) {
+    uint8_t head = head_.load(std::memory_order_relaxed);
+    uint8_t next = static_cast<uint8_t>((head + 1) & DIGITAL_INPUT_QUEUE_MASK);
+    if (next == tail_.load(std::memory_order_acquire)) {
+        overflow_.store(true, std::memory_order_relaxed);
+        dropped_edges_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring_[head].gpio = gpio;
+    ring_[head].level = level;
+    ring_[head].time_us = time_us;
+    head_.store(next, std::memory_order_release);
+}
+
+// ============================================
+// DEBOUNCE (Safety-Task)
+// ============================================
+void DigitalInputManager::applyEdge(Channel& channel, bool level, uint32_t time_us) {
+    // An edge within debounce_us of the previous one belongs to the same bounce
+    bool same_bounce = channel.edge_seen && (time_us - channel.candidate_us) < channel.debounce_us;
+    channel.edge_seen = true;
+    channel.candidate_us = time_us;
+
+    if (level == channel.stable_level) {
+        channel.candidate_pending = false;  // Glitch / bounced back
+        return;
+    }
+    if (!channel.candidate_pending) {
+        channel.candidate_pending = true;
+        if (!same_bounce) {
+            channel.first_edge_us = time_us;
+        }
+    }
+    channel.candidate_level = level;
+}
+
+void DigitalInputManager::resyncAll(uint32_t now_us) {
+    for (uint8_t i = 0; i < DIGITAL_INPUT_MAX_CHANNELS; i++) {
+        if (channels_[i].gpio != DIGITAL_INPUT_NO_GPIO) {
+            applyEdge(channels_[i], gpioManager.readPin(channels_[i].gpio), now_us);
+        }
+    }
+}
+
+uint8_t DigitalInputManager::poll(uint32_t now_ms, uint32_t now_us, DigitalInputEvent* out, uint8_t max_events) {
+    uint8_t tail = tail_.load(std::memory_order_relaxed);
+    while (tail != head_.load(std::memory_order_acquire)) {
+        RawEdge edge = ring_[tail];
+        tail = static_cast<uint8_t>((tail + 1) & DIGITAL_INPUT_QUEUE_MASK);
+        tail_.store(tail, std::memory_order_release);
+
+        int index = findChannel(edge.gpio);
+        if (index >= 0) {
+            applyEdge(channels_[index], edge.level, edge.time_us);
+        }
+    }
+    if (overflow_.exchange(false, std::memory_order_relaxed)) {
+        LOG_W(TAG, "Edge queue overflow (" + String((unsigned long)getDroppedEdges()) +
+                   " edges dropped) - resync from pin levels");
+        resyncAll(now_us);
+    }
+
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < DIGITAL_INPUT_MAX_CHANNELS && count < max_events; i++) {
+        Channel& channel = channels_[i];
+        if (channel.gpio == DIGITAL_INPUT_NO_GPIO || !channel.candidate_pending) {
+            continue;
+        }
+        if (now_us - channel.candidate_us < channel.debounce_us) {
+            continue;  // Still settling
+        }
+        channel.stable_level = channel.candidate_level;
+        channel.candidate_pending = false;
+
+        DigitalInputEvent& event = out[count++];
+        event.gpio = channel.gpio;
+        event.level = channel.stable_level;
+        event.edge_ms = now_ms - (now_us - channel.first_edge_us) / 1000UL;
+    }
+    return count;
+}
+
+uint32_t DigitalInputManager::getMsUntilSettled(uint32_t now_us) const {
+    if (tail_.load(std::memory_order_relaxed) != head_.load(std::memory_order_acquire) ||
+        overflow_.load(std::memory_order_relaxed)) {
+        return 0;  // Unprocessed edges
+    }
+    uint32_t next_ms = UINT32_MAX;
+    for (uint8_t i = 0; i < DIGITAL_INPUT_MAX_CHANNELS; i++) {
+        const Channel& channel = channels_[i];
+        if (channel.gpio == DIGITAL_INPUT_NO_GPIO || !channel.candidate_pending) {
+            continue;
+        }
+        uint32_t elapsed_us = now_us - channel.candidate_us;
+        uint32_t remaining_ms = elapsed_us >= channel.debounce_us
+                                    ? 0
+                                    : (channel.debounce_us - elapsed_us + 999UL) / 1000UL;
+        if (remaining_ms < next_ms) {
+            next_ms = remaining_ms;
+        }
+    }
+    return next_ms;
+}
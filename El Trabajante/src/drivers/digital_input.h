@@ -0,0 +1,111 @@
+#ifndef DRIVERS_DIGITAL_INPUT_H
+#define DRIVERS_DIGITAL_INPUT_H
+
+#include <stdint.h>
+#include <atomic>
+
+// ============================================
+// DIGITAL INPUTS (float switch, door contact, leak / rain detector)
+// ============================================
+// Binary inputs change rarely but must not be missed. Instead of polling at
+// the measurement interval, a CHANGE interrupt (armed via GPIOManager, pin
+// must be owned) pushes every raw edge into a lock-free ring:
+//   ISR (producer) → ring → poll() on the Safety-Task (consumer)
+// All GPIO interrupts share one dispatcher → single producer, so head/tail
+// atomics suffice (no critical section in the ISR).
+//
+// Software debounce in poll(): a new level is committed once it has been
+// stable for debounce_ms. Bounces and glitches shorter than debounce_ms
+// produce no event. The event carries the time of the FIRST edge that left
+// the previous state (real switching time, not the end of the bounce).
+//
+// Ring overflow: edges are dropped and counted; every channel is resynced
+// from the current pin level, so the debounced state is never stale.
+//
+// The ISR calls the wake hook (Safety-Task notify) → events are processed
+// within one tick even while the task blocks in power-save mode.
+// ============================================
+
+static const uint8_t DIGITAL_INPUT_MAX_CHANNELS = 8;
+static const uint8_t DIGITAL_INPUT_QUEUE_SIZE = 32;            // Power of two
+static const uint16_t DIGITAL_INPUT_DEFAULT_DEBOUNCE_MS = 50;  // Mechanical contacts
+static const uint16_t DIGITAL_INPUT_MAX_DEBOUNCE_MS = 5000;
+
+struct DigitalInputEvent {
+    uint8_t gpio;
+    bool level;         // New debounced pin level (true = HIGH)
+    uint32_t edge_ms;   // millis() of the first edge of this change
+};
+
+class DigitalInputManager {
+public:
+    static DigitalInputManager& getInstance();
+
+    // Pin must be requested + configured by the caller. Re-attach updates
+    // the debounce time and keeps the debounced state.
+    bool attach(uint8_t gpio, uint16_t debounce_ms);
+    void detach(uint8_t gpio);
+    bool isAttached(uint8_t gpio) const;
+    uint8_t getAttachedCount() const { return attached_count_.load(std::memory_order_relaxed); }
+
+    // Debounced level (false if not attached)
+    bool getState(uint8_t gpio, bool& level) const;
+
+    // Safety-Task: drain edges, commit debounced changes. now_us in the
+    // esp_timer domain (micros()). Returns number of events written.
+    uint8_t poll(uint32_t now_ms, uint32_t now_us, DigitalInputEvent* out, uint8_t max_events);
+
+    // Until the next pending debounce settles (UINT32_MAX: none pending)
+    uint32_t getMsUntilSettled(uint32_t now_us) const;
+
+    // ISR-safe hook, called after each queued edge (e.g. task notify)
+    void setWakeHook(void (*hook)());
+
+    uint32_t getDroppedEdges() const { return dropped_edges_.load(std::memory_order_relaxed); }
+
+    // Test helper: back to power-on state
+    void reset();
+
+    // GPIOEdgeCallback (ISR context)
+    static void onEdge(void* arg, uint8_t gpio, bool level, uint32_t time_us);
+
+private:
+    DigitalInputManager();
+    DigitalInputManager(const DigitalInputManager&) = delete;
+    DigitalInputManager& operator=(const DigitalInputManager&) = delete;
+
+    struct RawEdge {
+        uint8_t gpio;
+        bool level;
+        uint32_t time_us;
+    };
+
+    struct Channel {
+        uint8_t gpio;               // 255 = free
+        uint32_t debounce_us;
+        bool stable_level;          // Debounced state
+        bool candidate_pending;     // Level differs from stable, settling
+        bool candidate_level;
+        uint32_t candidate_us;      // Last edge → settle timer
+        uint32_t first_edge_us;     // First edge away from stable_level
+        bool edge_seen;             // candidate_us valid
+    };
+
+    int findChannel(uint8_t gpio) const;
+    void pushEdge(uint8_t gpio, bool level, uint32_t time_us);
+    void applyEdge(Channel& channel, bool level, uint32_t time_us);
+    void resyncAll(uint32_t now_us);
+
+    Channel channels_[DIGITAL_INPUT_MAX_CHANNELS];
+    RawEdge ring_[DIGITAL_INPUT_QUEUE_SIZE];
+    std::atomic<uint8_t> head_;             // Written by the ISR
+    std::atomic<uint8_t> tail_;             // Written by poll()
+    std::atomic<bool> overflow_;
+    std::atomic<uint32_t> dropped_edges_;
+    std::atomic<uint8_t> attached_count_;
+    void (*wake_hook_)();
+};
+
+extern DigitalInputManager& digitalInputs;
+
+#endif
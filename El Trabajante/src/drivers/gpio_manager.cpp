@@ -254,8 +254,9 @@ bool GPIOManager::releasePin(uint8_t gpio) {
         if (pin_info.pin == gpio) {
             LOG_I(TAG, "Releasing GPIO " + String(gpio) + " (was: " + String(pin_info.owner) + "/" + String(pin_info.component_name) + ")");
 
-            // Return hardware pin to safe state via HAL
+            // Return hardware pin to safe state via HAL (interrupt first, no stray edges)
             if (gpio_hal_) {
+                gpio_hal_->detachEdgeInterrupt(gpio);
                 gpio_hal_->releasePin(gpio);
             }
 
@@ -386,6 +387,41 @@ bool GPIOManager::configurePinMode(uint8_t gpio, uint8_t mode) {
     return false;
 }
 
+// ============================================
+// EDGE INTERRUPTS
+// ============================================
+
+bool GPIOManager::attachEdgeInterrupt(uint8_t gpio, GPIOEdgeCallback callback, void* arg) {
+    if (getPinInfo(gpio).owner[0] == '\0') {
+        LOG_E(TAG, "GPIOManager: Edge interrupt rejected - GPIO " + String(gpio) + " not owned");
+        return false;
+    }
+    if (!gpio_hal_ || !gpio_hal_->attachEdgeInterrupt(gpio, callback, arg)) {
+        LOG_E(TAG, "GPIOManager: Edge interrupt attach failed on GPIO " + String(gpio));
+        return false;
+    }
+    LOG_D(TAG, "GPIOManager: Edge interrupt armed on GPIO " + String(gpio));
+    return true;
+}
+
+void GPIOManager::detachEdgeInterrupt(uint8_t gpio) {
+    if (gpio_hal_) {
+        gpio_hal_->detachEdgeInterrupt(gpio);
+    }
+}
+
+bool GPIOManager::readPin(uint8_t gpio) {
+    return gpio_hal_ ? gpio_hal_->digitalRead(gpio) : false;
+}
+
+bool GPIOManager::writePin(uint8_t gpio, bool level) {
+    if (getPinInfo(gpio).owner[0] == '\0') {
+        LOG_E(TAG, "GPIOManager: Write rejected - GPIO " + String(gpio) + " not owned");
+        return false;
+    }
+    return gpio_hal_ != nullptr && gpio_hal_->digitalWrite(gpio, level);
+}
+
 // ============================================
 // PIN QUERIES
 // ============================================
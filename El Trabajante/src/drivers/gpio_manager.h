@@ -4,9 +4,7 @@
 #include <Arduino.h>
 #include <vector>
 #include <map>
-
-// Forward declaration of GPIOMode (defined in hal/igpio_hal.h)
-enum class GPIOMode : uint8_t;
+#include "hal/igpio_hal.h"  // GPIOMode, GPIOEdgeCallback
 
 // ============================================
 // GPIO Manager - Hardware Safety System
@@ -81,6 +79,21 @@ public:
     // Validates pin availability and hardware limitations
     bool configurePinMode(uint8_t gpio, uint8_t mode);
 
+    // ============================================
+    // EDGE INTERRUPTS (Digital Inputs)
+    // ============================================
+    // Arm a CHANGE interrupt on an owned pin; the callback runs in ISR context.
+    // Rejected for unowned pins — interrupts follow pin ownership.
+    // releasePin() disarms the interrupt automatically.
+    bool attachEdgeInterrupt(uint8_t gpio, GPIOEdgeCallback callback, void* arg);
+    void detachEdgeInterrupt(uint8_t gpio);
+
+    // Read digital input level (true = HIGH)
+    bool readPin(uint8_t gpio);
+
+    // Drive an owned output pin (e.g. sensor excitation). Rejected for unowned pins.
+    bool writePin(uint8_t gpio, bool level);
+
     // ============================================
     // PIN QUERIES
     // ============================================
@@ -0,0 +1,152 @@
+#ifndef DRIVERS_HAL_ESP32_ADC_CONTINUOUS_HAL_H
+#define DRIVERS_HAL_ESP32_ADC_CONTINUOUS_HAL_H
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include "iadc_sampler_hal.h"
+
+// ============================================
+// ESP32 ADC CONTINUOUS HAL - Production Thin Wrapper
+// ============================================
+// IDF 4.4 adc_digi_* continuous mode:
+// - ESP32: DMA via I2S0, ADC1 only, TYPE1 frames (2 bytes), conversion limit
+//   must stay enabled; sample rate 20 kHz .. 2 MHz
+// - ESP32-C3: GDMA, TYPE2 frames (4 bytes, carry the unit); ADC2 results are
+//   unreliable in DMA mode, so ADC1 only here as well
+// Attenuation 11 dB on all pins (same 100-3100 mV range as the analogRead path).
+//
+// analogRead() must not touch a pin of a running scan — SensorManager only
+// falls back to it for pins the sampler does not own.
+//
+// Used in: AdcSampler
+// NOT used in: Unit tests (use MockAdcSamplerHal instead)
+
+static const uint32_t ADC_DMA_STORE_BYTES = 1024;   // Driver ring buffer
+static const uint32_t ADC_DMA_FRAME_BYTES = 256;    // Bytes per conversion interrupt
+
+class ESP32AdcContinuousHal : public IAdcSamplerHal {
+public:
+    ESP32AdcContinuousHal() : running_(false) {
+        memset(gpio_of_channel_, 0xFF, sizeof(gpio_of_channel_));
+    }
+
+    bool supportsPin(uint8_t gpio) const override {
+        return adc1ChannelOf(gpio) >= 0;
+    }
+
+    bool start(const uint8_t* gpios, uint8_t count, uint32_t sample_rate_hz) override {
+        stop();
+        if (count == 0 || count > SOC_ADC_PATT_LEN_MAX) {
+            return false;
+        }
+
+        adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX] = {};
+        uint32_t channel_mask = 0;
+        memset(gpio_of_channel_, 0xFF, sizeof(gpio_of_channel_));
+        for (uint8_t i = 0; i < count; i++) {
+            int channel = adc1ChannelOf(gpios[i]);
+            if (channel < 0) {
+                return false;
+            }
+            pattern[i].atten = ADC_ATTEN_DB_11;
+            pattern[i].channel = static_cast<uint8_t>(channel);
+            pattern[i].unit = 0;  // ADC1
+            pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+            channel_mask |= (1UL << channel);
+            gpio_of_channel_[channel] = gpios[i];
+        }
+
+        adc_digi_init_config_t init_config = {};
+        init_config.max_store_buf_size = ADC_DMA_STORE_BYTES;
+        init_config.conv_num_each_intr = ADC_DMA_FRAME_BYTES;
+        init_config.adc1_chan_mask = channel_mask;
+        init_config.adc2_chan_mask = 0;
+        if (adc_digi_initialize(&init_config) != ESP_OK) {
+            return false;
+        }
+
+        adc_digi_configuration_t digi_config = {};
+#if CONFIG_IDF_TARGET_ESP32
+        digi_config.conv_limit_en = 1;
+        digi_config.conv_limit_num = 250;
+        digi_config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+#else
+        digi_config.conv_limit_en = 0;
+        digi_config.conv_limit_num = 250;
+        digi_config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+#endif
+        digi_config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+        digi_config.pattern_num = count;
+        digi_config.adc_pattern = pattern;
+        digi_config.sample_freq_hz = constrain(sample_rate_hz,
+                                               (uint32_t)SOC_ADC_SAMPLE_FREQ_THRES_LOW,
+                                               (uint32_t)SOC_ADC_SAMPLE_FREQ_THRES_HIGH);
+        if (adc_digi_controller_configure(&digi_config) != ESP_OK || adc_digi_start() != ESP_OK) {
+            adc_digi_deinitialize();
+            return false;
+        }
+        running_ = true;
+        return true;
+    }
+
+    void stop() override {
+        if (running_) {
+            adc_digi_stop();
+            adc_digi_deinitialize();
+            running_ = false;
+        }
+    }
+
+    size_t read(AdcRawSample* out, size_t max_samples, uint32_t timeout_ms) override {
+        if (!running_) {
+            return 0;
+        }
+        static const size_t RESULT_BYTES = sizeof(adc_digi_output_data_t);
+        size_t max_bytes = min(max_samples * RESULT_BYTES, sizeof(frame_));
+        uint32_t length = 0;
+        esp_err_t err = adc_digi_read_bytes(frame_, max_bytes, &length, timeout_ms);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {  // INVALID_STATE: ring overflowed, data still valid
+            return 0;
+        }
+
+        size_t written = 0;
+        for (uint32_t i = 0; i + RESULT_BYTES <= length; i += RESULT_BYTES) {
+            const adc_digi_output_data_t* result = reinterpret_cast<const adc_digi_output_data_t*>(&frame_[i]);
+#if CONFIG_IDF_TARGET_ESP32
+            uint32_t channel = result->type1.channel;
+            uint16_t data = result->type1.data;
+#else
+            if (result->type2.unit != 0) {
+                continue;
+            }
+            uint32_t channel = result->type2.channel;
+            uint16_t data = result->type2.data;
+#endif
+            if (channel >= ADC1_CHANNEL_MAX || gpio_of_channel_[channel] == 0xFF) {
+                continue;
+            }
+            out[written].gpio = gpio_of_channel_[channel];
+            out[written].raw = data;
+            written++;
+        }
+        return written;
+    }
+
+private:
+    static int adc1ChannelOf(uint8_t gpio) {
+        for (int channel = 0; channel < ADC1_CHANNEL_MAX; channel++) {
+            gpio_num_t pad;
+            if (adc1_pad_get_io_num(static_cast<adc1_channel_t>(channel), &pad) == ESP_OK &&
+                pad == static_cast<gpio_num_t>(gpio)) {
+                return channel;
+            }
+        }
+        return -1;
+    }
+
+    bool running_;
+    uint8_t gpio_of_channel_[ADC1_CHANNEL_MAX];
+    uint8_t frame_[ADC_DMA_FRAME_BYTES];
+};
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef DRIVERS_HAL_ESP32_GPIO_HAL_H
 #define DRIVERS_HAL_ESP32_GPIO_HAL_H
 
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#include <soc/soc_caps.h>
 #include "igpio_hal.h"
 #include "../gpio_manager.h"
 
@@ -22,7 +25,13 @@ public:
     // ============================================
     // CONSTRUCTOR
     // ============================================
-    ESP32GPIOHal() : gpio_manager_(&GPIOManager::getInstance()) {}
+    ESP32GPIOHal() : gpio_manager_(&GPIOManager::getInstance()) {
+        for (uint8_t i = 0; i < SOC_GPIO_PIN_COUNT; i++) {
+            edge_slots_[i].callback = nullptr;
+            edge_slots_[i].arg = nullptr;
+            edge_slots_[i].gpio = i;
+        }
+    }
 
     // ============================================
     // LIFECYCLE (No-op: GPIOManager handles internally)
@@ -105,6 +114,31 @@ public:
         return ::analogRead(gpio);
     }
 
+    // ============================================
+    // EDGE INTERRUPTS (Arduino attachInterruptArg, CHANGE)
+    // ============================================
+    // All GPIO interrupts share one dispatcher on the core that attached the
+    // first one → callbacks never run concurrently with each other.
+    bool attachEdgeInterrupt(uint8_t gpio, GPIOEdgeCallback callback, void* arg) override {
+        if (gpio >= SOC_GPIO_PIN_COUNT || callback == nullptr) {
+            return false;
+        }
+        detachEdgeInterrupt(gpio);
+        edge_slots_[gpio].callback = callback;
+        edge_slots_[gpio].arg = arg;
+        ::attachInterruptArg(gpio, edgeTrampoline, &edge_slots_[gpio], CHANGE);
+        return true;
+    }
+
+    void detachEdgeInterrupt(uint8_t gpio) override {
+        if (gpio >= SOC_GPIO_PIN_COUNT || edge_slots_[gpio].callback == nullptr) {
+            return;
+        }
+        ::detachInterrupt(gpio);
+        edge_slots_[gpio].callback = nullptr;
+        edge_slots_[gpio].arg = nullptr;
+    }
+
     // ============================================
     // EMERGENCY SAFE-MODE (No-op: GPIOManager handles internally)
     // ============================================
@@ -141,7 +175,23 @@ public:
     }
 
 private:
+    struct EdgeSlot {
+        GPIOEdgeCallback callback;
+        void* arg;
+        uint8_t gpio;
+    };
+
+    static void IRAM_ATTR edgeTrampoline(void* arg) {
+        EdgeSlot* slot = static_cast<EdgeSlot*>(arg);
+        GPIOEdgeCallback callback = slot->callback;
+        if (callback != nullptr) {
+            callback(slot->arg, slot->gpio, gpio_get_level(static_cast<gpio_num_t>(slot->gpio)) != 0,
+                     static_cast<uint32_t>(esp_timer_get_time()));
+        }
+    }
+
     GPIOManager* gpio_manager_;
+    EdgeSlot edge_slots_[SOC_GPIO_PIN_COUNT];
 };
 
 #endif  // DRIVERS_HAL_ESP32_GPIO_HAL_H
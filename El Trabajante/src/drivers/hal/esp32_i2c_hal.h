@@ -0,0 +1,39 @@
+#ifndef DRIVERS_HAL_ESP32_I2C_HAL_H
+#define DRIVERS_HAL_ESP32_I2C_HAL_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "ii2c_hal.h"
+
+// ============================================
+// ESP32 I2C HAL - Production Thin Wrapper
+// ============================================
+// Delegates to the Arduino Wire instance owned by I2CBusManager.
+// Used in: I2CBusManager (SHT3x periodic mode)
+// NOT used in: Unit tests (use MockI2CHal instead)
+class ESP32I2CHal : public II2CHal {
+public:
+    uint8_t write(uint8_t address, const uint8_t* data, size_t length) override {
+        Wire.beginTransmission(address);
+        for (size_t i = 0; i < length; i++) {
+            Wire.write(data[i]);
+        }
+        return Wire.endTransmission();
+    }
+
+    size_t read(uint8_t address, uint8_t* buffer, size_t length) override {
+        // requestFrom() is blocking on ESP32 — bytes are in the buffer on return
+        size_t received = Wire.requestFrom(address, static_cast<uint8_t>(length));
+        for (size_t i = 0; i < received && i < length; i++) {
+            buffer[i] = Wire.read();
+        }
+        return received;
+    }
+
+    void delayMs(uint32_t ms) override {
+        delay(ms);
+        yield();  // Feed watchdog after blocking delay
+    }
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef DRIVERS_HAL_ESP32_ONEWIRE_BITBANG_HAL_H
+#define DRIVERS_HAL_ESP32_ONEWIRE_BITBANG_HAL_H
+
+#include <Arduino.h>
+#include <OneWire.h>
+#include "ionewire_hal.h"
+
+// ============================================
+// ESP32 OneWire HAL - Bit-Bang Backend (OneWire library)
+// ============================================
+// Software-timed slots with interrupts disabled per bit. Kept as fallback
+// when no RMT channel pair is free and for Wokwi (no RMT RX simulation).
+// Used in: OneWireBusManager
+// NOT used in: Unit tests (use MockOneWireHal instead)
+class ESP32OneWireBitBangHal : public IOneWireHal {
+public:
+    explicit ESP32OneWireBitBangHal(uint8_t pin) : onewire_(pin) {}
+
+    bool reset() override {
+        return onewire_.reset() == 1;
+    }
+
+    void writeBits(const uint8_t* data, uint16_t bit_count, bool power_after = false) override {
+        uint16_t done = 0;
+        // Whole bytes via write(): the library keeps the pin driven high after
+        // the last byte when power is requested. Trailing bits carry no power.
+        while (bit_count - done >= 8) {
+            bool last = (bit_count - done == 8);
+            onewire_.write(data[done / 8], (power_after && last) ? 1 : 0);
+            done += 8;
+        }
+        for (; done < bit_count; done++) {
+            onewire_.write_bit((data[done / 8] >> (done % 8)) & 0x01);
+        }
+    }
+
+    void readBits(uint8_t* data, uint16_t bit_count) override {
+        uint16_t done = 0;
+        while (bit_count - done >= 8 && done % 8 == 0) {
+            data[done / 8] = onewire_.read();
+            done += 8;
+        }
+        for (; done < bit_count; done++) {
+            uint8_t mask = static_cast<uint8_t>(1U << (done % 8));
+            if (onewire_.read_bit()) {
+                data[done / 8] |= mask;
+            } else {
+                data[done / 8] &= static_cast<uint8_t>(~mask);
+            }
+        }
+    }
+
+    void depower() override {
+        onewire_.depower();
+    }
+
+    void delayMs(uint32_t ms) override {
+        delay(ms);
+    }
+
+    const char* getBackendName() const override { return "bitbang"; }
+
+private:
+    OneWire onewire_;
+};
+
+#endif
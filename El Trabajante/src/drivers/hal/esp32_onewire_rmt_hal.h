@@ -0,0 +1,240 @@
+#ifndef DRIVERS_HAL_ESP32_ONEWIRE_RMT_HAL_H
+#define DRIVERS_HAL_ESP32_ONEWIRE_RMT_HAL_H
+
+#include <Arduino.h>
+#include <driver/gpio.h>
+#include <driver/rmt.h>
+#include <freertos/ringbuf.h>
+#include <soc/soc_caps.h>
+#include "../onewire_rmt_transport.h"
+
+// ============================================
+// ESP32 OneWire RMT Channel - Production Implementation
+// ============================================
+// One TX + one RX RMT channel on the same open-drain pin (1 µs ticks).
+// TX generates reset/bit slots, RX samples the line (wired-AND with the
+// devices) during read transfers. While the hardware runs the slots the
+// calling task blocks on the driver semaphore / ring buffer — no CPU time,
+// no interrupt lock.
+//
+// Channels are taken from a small pool so several OneWire pins can be
+// active at once (ESP32: any 2 of 8 channels, ESP32-C3: TX 0–1 / RX 2–3
+// → max. 2 buses). create() returns nullptr when no pair is free; the
+// caller falls back to the bit-bang backend.
+// Used in: OneWireBusManager
+// NOT used in: Unit tests (MockOneWireRmtChannel replays a device model)
+class ESP32OneWireRmtChannel : public IOneWireRmtChannel {
+public:
+    static ESP32OneWireRmtChannel* create(uint8_t pin) {
+        int tx = allocateChannel(true);
+        if (tx < 0) {
+            return nullptr;
+        }
+        int rx = allocateChannel(false);
+        if (rx < 0) {
+            releaseChannel(tx);
+            return nullptr;
+        }
+        ESP32OneWireRmtChannel* channel = new ESP32OneWireRmtChannel(
+            pin, static_cast<rmt_channel_t>(tx), static_cast<rmt_channel_t>(rx));
+        if (channel == nullptr) {
+            releaseChannel(tx);
+            releaseChannel(rx);
+            return nullptr;
+        }
+        if (!channel->install()) {
+            delete channel;
+            return nullptr;
+        }
+        return channel;
+    }
+
+    ~ESP32OneWireRmtChannel() override {
+        if (installed_) {
+            rmt_driver_uninstall(tx_channel_);
+            rmt_driver_uninstall(rx_channel_);
+            gpio_reset_pin(static_cast<gpio_num_t>(pin_));
+        }
+        releaseChannel(tx_channel_);
+        releaseChannel(rx_channel_);
+    }
+
+    bool transfer(const OneWireRmtSymbol* tx, size_t tx_count,
+                  OneWireRmtSymbol* rx, size_t rx_capacity, size_t* rx_count) override {
+        if (tx_count > ONEWIRE_RMT_MAX_SLOTS) {
+            return false;
+        }
+        for (size_t i = 0; i < tx_count; i++) {
+            items_[i].level0 = 0;
+            items_[i].duration0 = tx[i].low_us;
+            items_[i].level1 = 1;
+            items_[i].duration1 = tx[i].high_us;
+        }
+        // End marker (duration 0), line stays released (idle high)
+        items_[tx_count].level0 = 1;
+        items_[tx_count].duration0 = 0;
+        items_[tx_count].level1 = 1;
+        items_[tx_count].duration1 = 0;
+
+        if (rx != nullptr) {
+            rmt_rx_start(rx_channel_, true);
+        }
+        if (rmt_write_items(tx_channel_, items_, static_cast<int>(tx_count + 1), true) != ESP_OK) {
+            if (rx != nullptr) {
+                rmt_rx_stop(rx_channel_);
+            }
+            return false;
+        }
+        if (rx == nullptr) {
+            return true;
+        }
+
+        // Capture ends after ONEWIRE_RMT_RX_IDLE_US of released line
+        size_t length = 0;
+        rmt_item32_t* captured = static_cast<rmt_item32_t*>(
+            xRingbufferReceive(rx_ring_, &length, pdMS_TO_TICKS(RX_TIMEOUT_MS)));
+        rmt_rx_stop(rx_channel_);
+        if (captured == nullptr) {
+            *rx_count = 0;
+            return false;
+        }
+        *rx_count = convertCapture(captured, length / sizeof(rmt_item32_t), rx, rx_capacity);
+        vRingbufferReturnItem(rx_ring_, captured);
+        return true;
+    }
+
+    void setStrongPullup(bool enabled) override {
+        // TX idle level is high: push-pull drives the bus, open drain releases it
+        gpio_set_direction(static_cast<gpio_num_t>(pin_),
+                           enabled ? GPIO_MODE_INPUT_OUTPUT : GPIO_MODE_INPUT_OUTPUT_OD);
+    }
+
+    void delayMs(uint32_t ms) override {
+        vTaskDelay(pdMS_TO_TICKS(ms));
+    }
+
+private:
+    static const uint32_t RX_TIMEOUT_MS = 20;
+    static const size_t RX_RING_BYTES = 512;
+
+    // ============================================
+    // CHANNEL POOL
+    // ============================================
+    static uint32_t& usedMask() {
+        static uint32_t mask = 0;
+        return mask;
+    }
+
+    static int allocateChannel(bool for_tx) {
+#if SOC_RMT_CHANNELS_PER_GROUP > SOC_RMT_TX_CANDIDATES_PER_GROUP
+        // Dedicated TX / RX channels (ESP32-C3, -S3)
+        int first = for_tx ? 0 : SOC_RMT_TX_CANDIDATES_PER_GROUP;
+        int last = for_tx ? SOC_RMT_TX_CANDIDATES_PER_GROUP : SOC_RMT_CHANNELS_PER_GROUP;
+#else
+        (void)for_tx;
+        int first = 0;
+        int last = SOC_RMT_CHANNELS_PER_GROUP;
+#endif
+        for (int ch = first; ch < last; ch++) {
+            if ((usedMask() & (1UL << ch)) == 0) {
+                usedMask() |= (1UL << ch);
+                return ch;
+            }
+        }
+        return -1;
+    }
+
+    static void releaseChannel(int channel) {
+        usedMask() &= ~(1UL << channel);
+    }
+
+    ESP32OneWireRmtChannel(uint8_t pin, rmt_channel_t tx, rmt_channel_t rx)
+        : pin_(pin), tx_channel_(tx), rx_channel_(rx), rx_ring_(nullptr), installed_(false) {}
+
+    bool install() {
+        gpio_num_t gpio = static_cast<gpio_num_t>(pin_);
+
+        rmt_config_t tx_config = RMT_DEFAULT_CONFIG_TX(gpio, tx_channel_);
+        tx_config.clk_div = 80;                                // 1 µs per tick
+        tx_config.tx_config.idle_level = RMT_IDLE_LEVEL_HIGH;
+        tx_config.tx_config.idle_output_en = true;
+        tx_config.tx_config.carrier_en = false;
+        if (rmt_config(&tx_config) != ESP_OK || rmt_driver_install(tx_channel_, 0, 0) != ESP_OK) {
+            return false;
+        }
+
+        rmt_config_t rx_config = RMT_DEFAULT_CONFIG_RX(gpio, rx_channel_);
+        rx_config.clk_div = 80;
+        rx_config.rx_config.idle_threshold = ONEWIRE_RMT_RX_IDLE_US;
+        rx_config.rx_config.filter_en = true;
+        rx_config.rx_config.filter_ticks_thresh = 30;          // Glitch filter (APB ticks)
+        if (rmt_config(&rx_config) != ESP_OK ||
+            rmt_driver_install(rx_channel_, RX_RING_BYTES, 0) != ESP_OK) {
+            rmt_driver_uninstall(tx_channel_);
+            return false;
+        }
+        if (rmt_get_ringbuf_handle(rx_channel_, &rx_ring_) != ESP_OK || rx_ring_ == nullptr) {
+            rmt_driver_uninstall(tx_channel_);
+            rmt_driver_uninstall(rx_channel_);
+            return false;
+        }
+
+        // Both channels on one pin; rmt_set_gpio() switches the pad to push-pull
+        // output, so open drain + input are re-applied afterwards.
+        rmt_set_gpio(rx_channel_, RMT_MODE_RX, gpio, false);
+        rmt_set_gpio(tx_channel_, RMT_MODE_TX, gpio, false);
+        gpio_set_pull_mode(gpio, GPIO_PULLUP_ONLY);            // External 4.7k still required
+        gpio_set_direction(gpio, GPIO_MODE_INPUT_OUTPUT_OD);
+
+        installed_ = true;
+        return true;
+    }
+
+    // RMT items (level/duration pairs) → low/high symbols; a leading high
+    // segment (idle before the first edge) is skipped, a zero duration ends
+    // the capture (idle threshold reached).
+    static size_t convertCapture(const rmt_item32_t* items, size_t item_count,
+                                 OneWireRmtSymbol* out, size_t capacity) {
+        size_t count = 0;
+        bool open_low = false;
+        for (size_t i = 0; i < item_count; i++) {
+            const uint32_t durations[2] = {items[i].duration0, items[i].duration1};
+            const uint32_t levels[2] = {items[i].level0, items[i].level1};
+            for (uint8_t half = 0; half < 2; half++) {
+                if (durations[half] == 0) {
+                    if (open_low && count < capacity) {
+                        out[count].high_us = ONEWIRE_RMT_RX_IDLE_US;
+                        count++;
+                    }
+                    return count;
+                }
+                if (levels[half] == 0) {
+                    if (count >= capacity) {
+                        return count;
+                    }
+                    out[count].low_us = static_cast<uint16_t>(durations[half]);
+                    out[count].high_us = 0;
+                    open_low = true;
+                } else if (open_low) {
+                    out[count].high_us = static_cast<uint16_t>(durations[half]);
+                    count++;
+                    open_low = false;
+                }
+            }
+        }
+        if (open_low && count < capacity) {
+            out[count].high_us = ONEWIRE_RMT_RX_IDLE_US;
+            count++;
+        }
+        return count;
+    }
+
+    uint8_t pin_;
+    rmt_channel_t tx_channel_;
+    rmt_channel_t rx_channel_;
+    RingbufHandle_t rx_ring_;
+    bool installed_;
+    rmt_item32_t items_[ONEWIRE_RMT_MAX_SLOTS + 1];
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef DRIVERS_HAL_ESP32_OTA_PARTITION_HAL_H
+#define DRIVERS_HAL_ESP32_OTA_PARTITION_HAL_H
+
+#include <Arduino.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include "iota_partition_hal.h"
+
+// ============================================
+// ESP32 OTA PARTITION HAL - Production Thin Wrapper
+// ============================================
+// esp_partition_* instead of esp_ota_begin/write: esp_ota_write() only streams
+// from offset 0 and erases on its own, so an interrupted transfer could not
+// be resumed. esp_ota_set_boot_partition() verifies the image (header,
+// segments, appended SHA-256) before it switches the boot slot.
+// Used in: LibraryManager (OTA)
+// NOT used in: Unit tests (use MockOtaPartitionHal instead)
+class ESP32OtaPartitionHal : public IOtaPartitionHal {
+public:
+    size_t targetSize() const override {
+        const esp_partition_t* target = esp_ota_get_next_update_partition(nullptr);
+        return target != nullptr ? target->size : 0;
+    }
+
+    bool eraseTarget(size_t offset, size_t length) override {
+        const esp_partition_t* target = esp_ota_get_next_update_partition(nullptr);
+        return target != nullptr && esp_partition_erase_range(target, offset, length) == ESP_OK;
+    }
+
+    bool writeTarget(size_t offset, const uint8_t* data, size_t length) override {
+        const esp_partition_t* target = esp_ota_get_next_update_partition(nullptr);
+        return target != nullptr && esp_partition_write(target, offset, data, length) == ESP_OK;
+    }
+
+    bool readTarget(size_t offset, uint8_t* buffer, size_t length) override {
+        const esp_partition_t* target = esp_ota_get_next_update_partition(nullptr);
+        return target != nullptr && esp_partition_read(target, offset, buffer, length) == ESP_OK;
+    }
+
+    size_t runningSize() const override {
+        const esp_partition_t* running = esp_ota_get_running_partition();
+        return running != nullptr ? running->size : 0;
+    }
+
+    bool readRunning(size_t offset, uint8_t* buffer, size_t length) override {
+        const esp_partition_t* running = esp_ota_get_running_partition();
+        return running != nullptr && esp_partition_read(running, offset, buffer, length) == ESP_OK;
+    }
+
+    bool activateTarget() override {
+        const esp_partition_t* target = esp_ota_get_next_update_partition(nullptr);
+        return target != nullptr && esp_ota_set_boot_partition(target) == ESP_OK;
+    }
+
+    bool isRunningPendingVerify() override {
+        esp_ota_img_states_t state;
+        return esp_ota_get_state_partition(esp_ota_get_running_partition(), &state) == ESP_OK &&
+               state == ESP_OTA_IMG_PENDING_VERIFY;
+    }
+
+    bool markRunningValid() override {
+        return esp_ota_mark_app_valid_cancel_rollback() == ESP_OK;
+    }
+
+    void rollbackAndReboot() override {
+        esp_ota_mark_app_invalid_rollback_and_reboot();
+        // Only returns if no previous valid slot exists
+    }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef DRIVERS_HAL_ESP32_PCNT_HAL_H
+#define DRIVERS_HAL_ESP32_PCNT_HAL_H
+
+#include <Arduino.h>
+#include <soc/soc_caps.h>
+#include "ipulse_counter_hal.h"
+
+#if SOC_PCNT_SUPPORTED
+#include <driver/pcnt.h>
+#endif
+
+// ============================================
+// ESP32 PCNT HAL - Production Thin Wrapper
+// ============================================
+// IDF 4.4 legacy PCNT driver: channel 0 of each unit counts rising edges,
+// falling edges and the control input are ignored. The H_LIM event resets
+// the counter to 0 and raises the wrap interrupt (IRAM, one per 32767
+// pulses). The glitch filter runs on the APB clock — light sleep stops it,
+// see PowerDeadlineInputs::keep_apb_clock.
+//
+// ESP32-C3: no PCNT peripheral → unitCount() == 0, pulse sensors are rejected.
+//
+// Used in: PulseCounterManager
+// NOT used in: Unit tests (use MockPulseCounterHal instead)
+class ESP32PcntHal : public IPulseCounterHal {
+public:
+#if SOC_PCNT_SUPPORTED
+    ESP32PcntHal() : isr_installed_(false) {
+        for (uint8_t i = 0; i < PCNT_UNIT_MAX; i++) {
+            wraps_[i] = 0;
+        }
+    }
+
+    uint8_t unitCount() const override { return PCNT_UNIT_MAX; }
+
+    bool attach(uint8_t unit, uint8_t gpio, uint16_t filter_ns) override {
+        if (unit >= PCNT_UNIT_MAX) {
+            return false;
+        }
+        if (!isr_installed_) {
+            esp_err_t err = pcnt_isr_service_install(0);
+            if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {  // INVALID_STATE: already installed
+                return false;
+            }
+            isr_installed_ = true;
+        }
+
+        pcnt_config_t config = {};
+        config.pulse_gpio_num = gpio;
+        config.ctrl_gpio_num = PCNT_PIN_NOT_USED;
+        config.channel = PCNT_CHANNEL_0;
+        config.unit = static_cast<pcnt_unit_t>(unit);
+        config.pos_mode = PCNT_COUNT_INC;
+        config.neg_mode = PCNT_COUNT_DIS;
+        config.lctrl_mode = PCNT_MODE_KEEP;
+        config.hctrl_mode = PCNT_MODE_KEEP;
+        config.counter_h_lim = static_cast<int16_t>(PULSE_COUNTER_HW_LIMIT);
+        config.counter_l_lim = -1;
+        pcnt_unit_t pcnt_unit = static_cast<pcnt_unit_t>(unit);
+        if (pcnt_unit_config(&config) != ESP_OK) {
+            return false;
+        }
+
+        // Filter in APB cycles (12.5 ns), 10-bit register
+        uint32_t cycles = (static_cast<uint32_t>(filter_ns) * 80U + 999U) / 1000U;
+        if (cycles > 1023U) cycles = 1023U;
+        if (cycles > 0) {
+            pcnt_set_filter_value(pcnt_unit, static_cast<uint16_t>(cycles));
+            pcnt_filter_enable(pcnt_unit);
+        } else {
+            pcnt_filter_disable(pcnt_unit);
+        }
+
+        wraps_[unit] = 0;
+        pcnt_counter_pause(pcnt_unit);
+        pcnt_counter_clear(pcnt_unit);
+        pcnt_event_enable(pcnt_unit, PCNT_EVT_H_LIM);
+        if (pcnt_isr_handler_add(pcnt_unit, wrapIsr, const_cast<uint32_t*>(&wraps_[unit])) != ESP_OK) {
+            return false;
+        }
+        return pcnt_counter_resume(pcnt_unit) == ESP_OK;
+    }
+
+    void detach(uint8_t unit) override {
+        if (unit >= PCNT_UNIT_MAX) {
+            return;
+        }
+        pcnt_unit_t pcnt_unit = static_cast<pcnt_unit_t>(unit);
+        pcnt_counter_pause(pcnt_unit);
+        pcnt_event_disable(pcnt_unit, PCNT_EVT_H_LIM);
+        pcnt_isr_handler_remove(pcnt_unit);
+        pcnt_set_pin(pcnt_unit, PCNT_CHANNEL_0, PCNT_PIN_NOT_USED, PCNT_PIN_NOT_USED);
+    }
+
+    bool read(uint8_t unit, uint32_t& wraps, uint16_t& count) override {
+        if (unit >= PCNT_UNIT_MAX) {
+            return false;
+        }
+        int16_t value = 0;
+        uint32_t before;
+        do {
+            before = wraps_[unit];
+            if (pcnt_get_counter_value(static_cast<pcnt_unit_t>(unit), &value) != ESP_OK) {
+                return false;
+            }
+        } while (before != wraps_[unit]);
+        wraps = before;
+        count = static_cast<uint16_t>(value < 0 ? 0 : value);
+        return true;
+    }
+
+private:
+    // arg: wrap counter of the unit
+    static void IRAM_ATTR wrapIsr(void* arg) {
+        (*static_cast<volatile uint32_t*>(arg))++;
+    }
+
+    bool isr_installed_;
+    volatile uint32_t wraps_[PCNT_UNIT_MAX];
+#else
+    uint8_t unitCount() const override { return 0; }
+    bool attach(uint8_t, uint8_t, uint16_t) override { return false; }
+    void detach(uint8_t) override {}
+    bool read(uint8_t, uint32_t&, uint16_t&) override { return false; }
+#endif
+};
+
+#endif
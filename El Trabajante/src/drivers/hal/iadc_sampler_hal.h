@@ -0,0 +1,38 @@
+#ifndef DRIVERS_HAL_IADC_SAMPLER_HAL_H
+#define DRIVERS_HAL_IADC_SAMPLER_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================
+// ADC SAMPLER HAL - Hardware Abstraction Layer Interface
+// ============================================
+// Continuous (DMA) conversion over a fixed set of pins. The hardware scans
+// the pins round-robin at sample_rate_hz (total, shared by all pins) and
+// read() drains the decoded conversion results.
+//
+// Implementation:
+// - Production: ESP32AdcContinuousHal (adc_digi_* continuous mode, ADC1 only)
+// - Test: MockAdcSamplerHal (synthetic sample streams)
+
+struct AdcRawSample {
+    uint8_t gpio;
+    uint16_t raw;   // 12 bit, 0..4095
+};
+
+class IAdcSamplerHal {
+public:
+    virtual ~IAdcSamplerHal() = default;
+
+    // Pin can be converted in continuous mode (ADC1 channel)
+    virtual bool supportsPin(uint8_t gpio) const = 0;
+
+    // (Re)starts the scan; a running scan is stopped first
+    virtual bool start(const uint8_t* gpios, uint8_t count, uint32_t sample_rate_hz) = 0;
+    virtual void stop() = 0;
+
+    // Blocks up to timeout_ms for converted samples; returns the number written
+    virtual size_t read(AdcRawSample* out, size_t max_samples, uint32_t timeout_ms) = 0;
+};
+
+#endif
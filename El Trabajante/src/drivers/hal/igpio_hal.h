@@ -31,6 +31,13 @@ enum class GPIOMode : uint8_t {
     GPIO_INPUT_PULLDOWN = 0x09   // Input with internal pulldown (ESP32-specific)
 };
 
+// ============================================
+// EDGE INTERRUPT CALLBACK
+// ============================================
+// Runs in ISR context (IRAM, no logging, no blocking).
+// level: pin level read in the ISR, time_us: esp_timer time of the edge
+typedef void (*GPIOEdgeCallback)(void* arg, uint8_t gpio, bool level, uint32_t time_us);
+
 // ============================================
 // IGPIO HAL INTERFACE
 // ============================================
@@ -104,6 +111,16 @@ public:
     // Returns: ADC value (0-4095 for ESP32 12-bit ADC)
     virtual uint16_t analogRead(uint8_t gpio) = 0;
 
+    // ============================================
+    // EDGE INTERRUPTS
+    // ============================================
+    // Attach a CHANGE interrupt (both edges). One callback per pin.
+    // Returns: true if the interrupt is armed
+    virtual bool attachEdgeInterrupt(uint8_t gpio, GPIOEdgeCallback callback, void* arg) = 0;
+
+    // Disarm the interrupt of a pin (no-op if none attached)
+    virtual void detachEdgeInterrupt(uint8_t gpio) = 0;
+
     // ============================================
     // EMERGENCY SAFE-MODE
     // ============================================
@@ -0,0 +1,33 @@
+#ifndef DRIVERS_HAL_II2C_HAL_H
+#define DRIVERS_HAL_II2C_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================
+// I2C HAL - Hardware Abstraction Layer Interface
+// ============================================
+// Minimal transaction-level interface for device drivers that need an
+// exact command sequence (SHT3x periodic mode).
+// Caller holds g_i2c_mutex — implementations do no locking.
+//
+// Implementation:
+// - Production: ESP32I2CHal (delegates to Wire)
+// - Test: MockI2CHal (records transactions, scripted responses)
+class II2CHal {
+public:
+    virtual ~II2CHal() = default;
+
+    // Write bytes in one transaction (START, addr+W, data, STOP).
+    // Returns: Wire endTransmission() code (0 = ACK, 2/3 = NACK, 4 = bus error, 5 = timeout)
+    virtual uint8_t write(uint8_t address, const uint8_t* data, size_t length) = 0;
+
+    // Read bytes directly (START, addr+R, data, STOP).
+    // Returns: number of bytes received (0 on address NACK)
+    virtual size_t read(uint8_t address, uint8_t* buffer, size_t length) = 0;
+
+    // Blocking wait between command and data phase
+    virtual void delayMs(uint32_t ms) = 0;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef DRIVERS_HAL_IONEWIRE_HAL_H
+#define DRIVERS_HAL_IONEWIRE_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================
+// ONEWIRE HAL - Transport Interface
+// ============================================
+// Slot-level OneWire transport: reset/presence plus write and read slots,
+// LSB first. ROM addressing, search and DS18B20 commands live in
+// OneWireProtocol on top of this interface.
+// Caller holds g_onewire_mutex — implementations do no locking.
+//
+// Implementation:
+// - Production: OneWireRmtTransport + ESP32OneWireRmtChannel (RMT generates
+//   and samples the slots in hardware), ESP32OneWireBitBangHal (OneWire
+//   library, fallback when no RMT channel pair is free / Wokwi)
+// - Test: MockOneWireHal (slot-level device model, bit-bang reference)
+class IOneWireHal {
+public:
+    virtual ~IOneWireHal() = default;
+
+    // Reset pulse; returns true if at least one device answered with presence
+    virtual bool reset() = 0;
+
+    // Write bit_count bits from data (LSB first). power_after: keep the line
+    // driven high afterwards (parasite power during conversion) until depower()
+    virtual void writeBits(const uint8_t* data, uint16_t bit_count, bool power_after = false) = 0;
+
+    // Issue bit_count read slots, store sampled bits in data (LSB first)
+    virtual void readBits(uint8_t* data, uint16_t bit_count) = 0;
+
+    // Release strong pullup after writeBits(..., power_after = true)
+    virtual void depower() = 0;
+
+    // Blocking wait (conversion time)
+    virtual void delayMs(uint32_t ms) = 0;
+
+    // Backend name for status output ("rmt", "bitbang", "mock")
+    virtual const char* getBackendName() const = 0;
+
+    // ============================================
+    // CONVENIENCE (byte/bit helpers)
+    // ============================================
+    void writeBytes(const uint8_t* data, size_t length, bool power_after = false) {
+        writeBits(data, static_cast<uint16_t>(length * 8), power_after);
+    }
+
+    void readBytes(uint8_t* data, size_t length) {
+        readBits(data, static_cast<uint16_t>(length * 8));
+    }
+
+    void writeByte(uint8_t value, bool power_after = false) {
+        writeBits(&value, 8, power_after);
+    }
+
+    uint8_t readByte() {
+        uint8_t value = 0;
+        readBits(&value, 8);
+        return value;
+    }
+
+    void writeBit(bool bit) {
+        uint8_t value = bit ? 1 : 0;
+        writeBits(&value, 1);
+    }
+
+    bool readBit() {
+        uint8_t value = 0;
+        readBits(&value, 1);
+        return (value & 0x01) != 0;
+    }
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef DRIVERS_HAL_IOTA_PARTITION_HAL_H
+#define DRIVERS_HAL_IOTA_PARTITION_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================
+// OTA PARTITION HAL - Hardware Abstraction Layer Interface
+// ============================================
+// Raw access to the two app slots (partitions.csv: app0/app1, 1.5 MB each):
+// the inactive slot is the write target, the running slot is the base for
+// delta images. Offsets are relative to the partition start.
+//
+// Flash semantics: eraseTarget() works on whole sectors (4 KB) and sets all
+// bits to 1; writeTarget() can only clear bits. Callers erase before writing.
+//
+// Implementation:
+// - Production: ESP32OtaPartitionHal (esp_partition_* / esp_ota_*)
+// - Test: MockOtaPartitionHal (file-backed target slot, records erase/write misuse)
+class IOtaPartitionHal {
+public:
+    virtual ~IOtaPartitionHal() = default;
+
+    // Inactive slot (update target)
+    virtual size_t targetSize() const = 0;
+    virtual bool eraseTarget(size_t offset, size_t length) = 0;
+    virtual bool writeTarget(size_t offset, const uint8_t* data, size_t length) = 0;
+    virtual bool readTarget(size_t offset, uint8_t* buffer, size_t length) = 0;
+
+    // Running slot (delta base)
+    virtual size_t runningSize() const = 0;
+    virtual bool readRunning(size_t offset, uint8_t* buffer, size_t length) = 0;
+
+    // Validates the image in the target slot and boots it next time
+    virtual bool activateTarget() = 0;
+
+    // Rollback support: the running image boots for the first time after an
+    // update and has not been confirmed yet
+    virtual bool isRunningPendingVerify() = 0;
+    virtual bool markRunningValid() = 0;
+    // Marks the running image invalid and reboots into the previous slot
+    virtual void rollbackAndReboot() = 0;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef DRIVERS_HAL_IPULSE_COUNTER_HAL_H
+#define DRIVERS_HAL_IPULSE_COUNTER_HAL_H
+
+#include <stdint.h>
+
+// ============================================
+// PULSE COUNTER HAL - Hardware Abstraction Layer Interface
+// ============================================
+// One hardware counter unit per pin, counting rising edges without CPU
+// involvement. The 16-bit counter resets to 0 when it reaches
+// PULSE_COUNTER_HW_LIMIT; the implementation counts these wraps (one
+// interrupt per PULSE_COUNTER_HW_LIMIT pulses).
+//
+// Implementation:
+// - Production: ESP32PcntHal (PCNT peripheral, ESP32 only — the C3 has none)
+// - Test: MockPulseCounterHal (simulated pulses, pending-wrap race)
+
+static const uint32_t PULSE_COUNTER_HW_LIMIT = 32767;   // PCNT h_lim (int16 max)
+static const uint16_t PULSE_COUNTER_MAX_FILTER_NS = 12787;  // 1023 APB cycles @ 80 MHz
+
+class IPulseCounterHal {
+public:
+    virtual ~IPulseCounterHal() = default;
+
+    // Number of counter units (0 = no pulse counting on this chip)
+    virtual uint8_t unitCount() const = 0;
+
+    // Count rising edges on gpio (pull-up enabled); pulses shorter than
+    // filter_ns are ignored (0 = filter off). Counter starts at 0.
+    virtual bool attach(uint8_t unit, uint8_t gpio, uint16_t filter_ns) = 0;
+    virtual void detach(uint8_t unit) = 0;
+
+    // Consistent snapshot: wraps counted so far + current counter value.
+    // A wrap whose interrupt is still pending shows as a counter that went
+    // backwards — callers must keep their totals monotonic.
+    virtual bool read(uint8_t unit, uint32_t& wraps, uint16_t& count) = 0;
+};
+
+#endif
@@ -498,6 +498,9 @@ bool I2CBusManager::recoverBus() {
         return false;
     }
 
+    // Devices may have lost their mode (SHT3x periodic) → re-armed on next read
+    bus_generation_++;
+
     LOG_I(TAG, "I2C: Bus recovery successful");
     errorTracker.trackError(
         ERROR_I2C_BUS_RECOVERED,
@@ -556,74 +559,12 @@ String I2CBusManager::getBusStatus() const {
     return status;
 }
 
-// ============================================
-// CRC-8 LOOKUP TABLE (SENSIRION STANDARD)
-// ============================================
-// Polynomial: x^8 + x^5 + x^4 + 1 (0x31)
-// Used by: SHT31, SHTC3, SHT4x, and other Sensirion sensors
-// Reference: Sensirion Application Note
-static const uint8_t CRC8_POLY31_TABLE[256] PROGMEM = {
-    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97,
-    0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
-    0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4,
-    0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
-    0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11,
-    0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
-    0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52,
-    0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
-    0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA,
-    0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
-    0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9,
-    0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
-    0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C,
-    0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
-    0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F,
-    0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
-    0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED,
-    0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
-    0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE,
-    0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
-    0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B,
-    0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
-    0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28,
-    0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
-    0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0,
-    0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
-    0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93,
-    0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
-    0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56,
-    0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
-    0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15,
-    0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC
-};
-
 // ============================================
 // CRC-8 CALCULATION
 // ============================================
 uint8_t I2CBusManager::calculateCRC8(const uint8_t* data, size_t len,
                                       uint8_t polynomial, uint8_t init_value) {
-    uint8_t crc = init_value;
-
-    if (polynomial == 0x31) {
-        // Table-based calculation for Sensirion polynomial (fast)
-        for (size_t i = 0; i < len; i++) {
-            crc = pgm_read_byte(&CRC8_POLY31_TABLE[crc ^ data[i]]);
-        }
-    } else {
-        // Bit-by-bit calculation for other polynomials
-        for (size_t i = 0; i < len; i++) {
-            crc ^= data[i];
-            for (uint8_t bit = 0; bit < 8; bit++) {
-                if (crc & 0x80) {
-                    crc = (crc << 1) ^ polynomial;
-                } else {
-                    crc <<= 1;
-                }
-            }
-        }
-    }
-
-    return crc;
+    return calculateI2CCRC8(data, len, polynomial, init_value);
 }
 
 bool I2CBusManager::validateCRC8(const uint8_t* data, size_t data_len,
@@ -737,14 +678,44 @@ bool I2CBusManager::readSensorRaw(const String& sensor_type, uint8_t i2c_address
         return false;
     }
 
-    LOG_D(TAG, "I2C: Reading " + sensor_type + " at 0x" + String(addr, HEX) +
+    return readSensorRawResolved(protocol, addr, buffer, buffer_size, bytes_read);
+}
+
+bool I2CBusManager::readSensorRaw(const I2CSensorBinding& binding,
+                                  uint8_t* buffer, size_t buffer_size,
+                                  size_t& bytes_read) {
+    bytes_read = 0;
+
+    if (!initialized_) {
+        LOG_E(TAG, "I2C: Bus not initialized for sensor read");
+        errorTracker.trackError(ERROR_I2C_READ_FAILED, ERROR_SEVERITY_ERROR,
+                               "Bus not initialized for sensor read");
+        return false;
+    }
+    // Binding was validated by resolveI2CSensorBinding() at configure time
+    if (binding.protocol == nullptr || buffer == nullptr ||
+        buffer_size < binding.protocol->expected_bytes) {
+        LOG_E(TAG, "I2C: Invalid binding or buffer for sensor read");
+        return false;
+    }
+
+    return readSensorRawResolved(binding.protocol, binding.i2c_address,
+                                 buffer, buffer_size, bytes_read);
+}
+
+bool I2CBusManager::readSensorRawResolved(const I2CSensorProtocol* protocol, uint8_t addr,
+                                          uint8_t* buffer, size_t buffer_size,
+                                          size_t& bytes_read) {
+    const char* sensor_type = protocol->sensor_type;
+
+    LOG_D(TAG, "I2C: Reading " + String(sensor_type) + " at 0x" + String(addr, HEX) +
               " (protocol: " + String((uint8_t)protocol->protocol_type) + ")");
 
     // SAFETY-RTOS M4: Wire is not thread-safe.
     // executeCommandBasedProtocol / executeRegisterBasedProtocol and their internal
     // attemptRecoveryIfNeeded calls are all within this mutex scope.
     if (xSemaphoreTake(g_i2c_mutex, pdMS_TO_TICKS(250)) != pdTRUE) {
-        LOG_W(TAG, "I2C: Mutex timeout — skipping readSensorRaw for " + sensor_type);
+        LOG_W(TAG, "I2C: Mutex timeout — skipping readSensorRaw for " + String(sensor_type));
         return false;
     }
 
@@ -752,8 +723,13 @@ bool I2CBusManager::readSensorRaw(const String& sensor_type, uint8_t i2c_address
     bool success = false;
     switch (protocol->protocol_type) {
         case I2CProtocolType::COMMAND_BASED:
-            success = executeCommandBasedProtocol(protocol, addr, buffer,
+            if (sht3x_.isManaged(addr) && strcmp(sensor_type, "sht31") == 0) {
+                success = executeSht3xPeriodicRead(protocol, addr, buffer,
                                                    buffer_size, bytes_read);
+            } else {
+                success = executeCommandBasedProtocol(protocol, addr, buffer,
+                                                       buffer_size, bytes_read);
+            }
             break;
 
         case I2CProtocolType::REGISTER_BASED:
@@ -772,15 +748,15 @@ bool I2CBusManager::readSensorRaw(const String& sensor_type, uint8_t i2c_address
                     bytes_read = received;
                     success = true;
                 } else {
-                    LOG_E(TAG, "I2C: Burst read failed for " + sensor_type);
+                    LOG_E(TAG, "I2C: Burst read failed for " + String(sensor_type));
                     errorTracker.trackError(ERROR_I2C_READ_FAILED, ERROR_SEVERITY_ERROR,
-                                           ("Burst read failed: " + sensor_type).c_str());
+                                           ("Burst read failed: " + String(sensor_type)).c_str());
                 }
             }
             break;
 
         default:
-            LOG_E(TAG, "I2C: Unknown protocol type for " + sensor_type);
+            LOG_E(TAG, "I2C: Unknown protocol type for " + String(sensor_type));
             errorTracker.trackError(ERROR_I2C_PROTOCOL_UNSUPPORTED, ERROR_SEVERITY_ERROR,
                                    "Unknown protocol type");
             xSemaphoreGive(g_i2c_mutex);
@@ -798,7 +774,7 @@ bool I2CBusManager::readSensorRaw(const String& sensor_type, uint8_t i2c_address
     }
 
     if (success) {
-        LOG_D(TAG, "I2C: " + sensor_type + " read successful (" +
+        LOG_D(TAG, "I2C: " + String(sensor_type) + " read successful (" +
                   String(bytes_read) + " bytes)");
     }
 
@@ -889,6 +865,78 @@ bool I2CBusManager::executeCommandBasedProtocol(const I2CSensorProtocol* protoco
     return true;
 }
 
+// ============================================
+// SHT3x PERIODIC MODE
+// ============================================
+bool I2CBusManager::configureSht3xPeriodic(uint8_t i2c_address, uint32_t interval_ms) {
+    if (!initialized_) {
+        return false;
+    }
+    if (xSemaphoreTake(g_i2c_mutex, pdMS_TO_TICKS(250)) != pdTRUE) {
+        LOG_W(TAG, "I2C: Mutex timeout — SHT3x periodic mode not configured");
+        return false;
+    }
+    bool periodic = sht3x_.arm(i2c_hal_, i2c_address, interval_ms, millis(), bus_generation_);
+    xSemaphoreGive(g_i2c_mutex);
+
+    if (periodic) {
+        LOG_I(TAG, "I2C: SHT3x 0x" + String(i2c_address, HEX) + " periodic mode (" +
+                  String(Sht3xPeriodicManager::periodMsForCommand(
+                      Sht3xPeriodicManager::selectPeriodicCommand(interval_ms))) + " ms period)");
+    } else {
+        LOG_W(TAG, "I2C: SHT3x 0x" + String(i2c_address, HEX) +
+                  " periodic mode unavailable — single-shot fallback");
+    }
+    return periodic;
+}
+
+void I2CBusManager::releaseSht3xPeriodic(uint8_t i2c_address) {
+    if (!initialized_ || !sht3x_.isManaged(i2c_address)) {
+        return;
+    }
+    if (xSemaphoreTake(g_i2c_mutex, pdMS_TO_TICKS(250)) != pdTRUE) {
+        LOG_W(TAG, "I2C: Mutex timeout — SHT3x periodic mode not released");
+        return;
+    }
+    sht3x_.release(i2c_hal_, i2c_address);
+    xSemaphoreGive(g_i2c_mutex);
+    LOG_D(TAG, "I2C: SHT3x 0x" + String(i2c_address, HEX) + " periodic mode stopped");
+}
+
+bool I2CBusManager::executeSht3xPeriodicRead(const I2CSensorProtocol* protocol,
+                                             uint8_t i2c_address,
+                                             uint8_t* buffer,
+                                             size_t buffer_size,
+                                             size_t& bytes_read) {
+    Sht3xReadResult result = sht3x_.read(i2c_hal_, i2c_address, buffer, buffer_size,
+                                         millis(), bus_generation_);
+    switch (result) {
+        case Sht3xReadResult::OK:
+            bytes_read = SHT3X_RESPONSE_BYTES;
+            return true;
+
+        case Sht3xReadResult::NOT_READY:
+            // Armed less than one period ago — next interval delivers data
+            LOG_D(TAG, "I2C: SHT3x 0x" + String(i2c_address, HEX) + " warming up, no data yet");
+            return false;
+
+        case Sht3xReadResult::BUS_ERROR:
+            // Successful recovery bumps bus_generation_ → next read re-arms
+            attemptRecoveryIfNeeded(4);
+            LOG_E(TAG, "I2C: Bus error reading " + String(protocol->sensor_type));
+            errorTracker.trackError(ERROR_I2C_BUS_ERROR, ERROR_SEVERITY_CRITICAL,
+                                   ("Bus error: " + String(protocol->sensor_type)).c_str());
+            return false;
+
+        case Sht3xReadResult::NACK:
+        default:
+            LOG_E(TAG, "I2C: SHT3x fetch failed at 0x" + String(i2c_address, HEX));
+            errorTracker.trackError(ERROR_I2C_TIMEOUT, ERROR_SEVERITY_ERROR,
+                                   (String(protocol->sensor_type) + " read timeout").c_str());
+            return false;
+    }
+}
+
 // ============================================
 // REGISTER-BASED PROTOCOL EXECUTION (BMP280)
 // ============================================
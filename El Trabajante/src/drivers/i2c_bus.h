@@ -4,6 +4,8 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include "i2c_sensor_protocol.h"
+#include "sht3x_periodic.h"
+#include "hal/esp32_i2c_hal.h"
 
 // ============================================
 // I2C Bus Manager - Hardware Abstraction Layer
@@ -110,6 +112,11 @@ public:
     bool readSensorRaw(const String& sensor_type, uint8_t i2c_address,
                        uint8_t* buffer, size_t buffer_size, size_t& bytes_read);
 
+    // Same as above with a binding resolved at configure time
+    // (resolveI2CSensorBinding) — no protocol lookup per read
+    bool readSensorRaw(const I2CSensorBinding& binding,
+                       uint8_t* buffer, size_t buffer_size, size_t& bytes_read);
+
     // Check if sensor type has registered protocol
     bool isSensorTypeSupported(const String& sensor_type) const;
 
@@ -119,6 +126,20 @@ public:
     // count: Output - actual number of entries
     void getSupportedI2CSensorTypes(String types[], uint8_t max_count, uint8_t& count) const;
 
+    // ============================================
+    // SHT3x PERIODIC MODE
+    // ============================================
+    // Arm periodic acquisition for an SHT3x at address (rate derived from the
+    // shortest measurement interval of its value types). Idempotent.
+    // readSensorRaw("sht31", addr, ...) then only fetches the latest result.
+    // Returns false if the device runs in single-shot fallback.
+    bool configureSht3xPeriodic(uint8_t i2c_address, uint32_t interval_ms);
+
+    // Stop periodic mode (last SHT3x value type at address removed)
+    void releaseSht3xPeriodic(uint8_t i2c_address);
+
+    const Sht3xPeriodicManager& getSht3xPeriodicManager() const { return sht3x_; }
+
     // ============================================
     // STATUS QUERIES
     // ============================================
@@ -148,7 +169,8 @@ private:
         : initialized_(false), 
           sda_pin_(0), 
           scl_pin_(0), 
-          frequency_(100000) {}
+          frequency_(100000),
+          bus_generation_(0) {}
     
     ~I2CBusManager() {}
 
@@ -159,10 +181,19 @@ private:
     uint8_t sda_pin_;       // SDA pin (from HardwareConfig)
     uint8_t scl_pin_;       // SCL pin (from HardwareConfig)
     uint32_t frequency_;    // Bus frequency in Hz (typically 100kHz)
+    uint32_t bus_generation_;  // Incremented per successful recoverBus() (SHT3x re-arm)
+
+    ESP32I2CHal i2c_hal_;
+    Sht3xPeriodicManager sht3x_;
 
     // ============================================
     // INTERNAL PROTOCOL EXECUTION
     // ============================================
+    // Shared by both readSensorRaw() variants once protocol + address are known:
+    // takes g_i2c_mutex, executes the protocol, validates CRC
+    bool readSensorRawResolved(const I2CSensorProtocol* protocol, uint8_t addr,
+                               uint8_t* buffer, size_t buffer_size, size_t& bytes_read);
+
     // Execute command-based protocol (SHT31 style)
     // 1. Write command bytes
     // 2. Wait for conversion
@@ -173,6 +204,14 @@ private:
                                      size_t buffer_size,
                                      size_t& bytes_read);
 
+    // SHT3x in periodic mode: fetch-data + read, no conversion wait.
+    // Caller MUST hold g_i2c_mutex. Not-ready (warm-up) returns false without error.
+    bool executeSht3xPeriodicRead(const I2CSensorProtocol* protocol,
+                                  uint8_t i2c_address,
+                                  uint8_t* buffer,
+                                  size_t buffer_size,
+                                  size_t& bytes_read);
+
     // Execute register-based protocol (BMP280 style)
     // 1. Write register address
     // 2. Read data bytes
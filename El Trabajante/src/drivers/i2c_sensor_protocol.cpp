@@ -1,5 +1,7 @@
 #include "i2c_sensor_protocol.h"
 
+#include <string.h>
+
 // ============================================
 // I2C SENSOR PROTOCOL REGISTRY
 // ============================================
@@ -199,6 +201,30 @@ uint8_t getDefaultI2CAddress(const String& sensor_type, uint8_t fallback) {
 // ============================================
 // Replaces hardcoded extraction in sensor_manager.cpp:960-967
 
+// Shared by extractRawValue() and extractBoundRawValue()
+static uint32_t extractValue(const I2CValueExtraction* ve,
+                             const uint8_t* buffer,
+                             size_t buffer_len) {
+    // Boundary check
+    if (ve->byte_offset + ve->byte_count > buffer_len) {
+        return 0;
+    }
+
+    uint32_t raw = 0;
+    if (ve->big_endian) {
+        // MSB first (e.g., SHT31, BMP280)
+        for (uint8_t b = 0; b < ve->byte_count; b++) {
+            raw = (raw << 8) | buffer[ve->byte_offset + b];
+        }
+    } else {
+        // LSB first
+        for (int8_t b = ve->byte_count - 1; b >= 0; b--) {
+            raw = (raw << 8) | buffer[ve->byte_offset + b];
+        }
+    }
+    return raw;
+}
+
 uint32_t extractRawValue(const String& sensor_type,
                          const String& value_type,
                          const uint8_t* buffer,
@@ -219,31 +245,129 @@ uint32_t extractRawValue(const String& sensor_type,
         }
 
         // Check for match
-        if (String(ve->value_type) == value_type) {
-            // Boundary check
-            if (ve->byte_offset + ve->byte_count > buffer_len) {
-                return 0;
+        if (value_type == ve->value_type) {
+            return extractValue(ve, buffer, buffer_len);
+        }
+    }
+
+    // Value type not found
+    return 0;
+}
+
+// ============================================
+// PRE-RESOLVED SENSOR BINDING
+// ============================================
+bool resolveI2CSensorBinding(const String& device_type,
+                             const char* const* value_types,
+                             uint8_t value_count,
+                             uint8_t i2c_address,
+                             I2CSensorBinding& out) {
+    memset(&out, 0, sizeof(out));
+    out.protocol = nullptr;
+
+    const I2CSensorProtocol* proto = findI2CSensorProtocol(device_type);
+    if (proto == nullptr || value_types == nullptr ||
+        value_count == 0 || value_count > I2C_BINDING_MAX_VALUES) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < value_count; i++) {
+        bool found = false;
+        for (uint8_t slot = 0; slot < proto->value_count && value_types[i] != nullptr; slot++) {
+            const char* candidate = proto->values[slot].value_type;
+            if (candidate != nullptr && strcmp(candidate, value_types[i]) == 0) {
+                out.value_slots[i] = slot;
+                found = true;
+                break;
             }
+        }
+        if (!found) {
+            return false;
+        }
+    }
 
-            // Extract bytes according to endianness
-            uint32_t raw = 0;
+    out.protocol = proto;
+    out.value_count = value_count;
+    out.i2c_address = (i2c_address != 0) ? i2c_address : proto->default_i2c_address;
+    return true;
+}
 
-            if (ve->big_endian) {
-                // MSB first (e.g., SHT31, BMP280)
-                for (uint8_t b = 0; b < ve->byte_count; b++) {
-                    raw = (raw << 8) | buffer[ve->byte_offset + b];
-                }
-            } else {
-                // LSB first
-                for (int8_t b = ve->byte_count - 1; b >= 0; b--) {
-                    raw = (raw << 8) | buffer[ve->byte_offset + b];
+uint32_t extractBoundRawValue(const I2CSensorBinding& binding,
+                              uint8_t index,
+                              const uint8_t* buffer,
+                              size_t buffer_len) {
+    if (binding.protocol == nullptr || buffer == nullptr || index >= binding.value_count) {
+        return 0;
+    }
+    return extractValue(&binding.protocol->values[binding.value_slots[index]], buffer, buffer_len);
+}
+
+// ============================================
+// CRC-8 LOOKUP TABLE (SENSIRION STANDARD)
+// ============================================
+// Polynomial: x^8 + x^5 + x^4 + 1 (0x31)
+// Used by: SHT31, SHTC3, SHT4x, and other Sensirion sensors
+// Reference: Sensirion Application Note
+static const uint8_t CRC8_POLY31_TABLE[256] PROGMEM = {
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97,
+    0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+    0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4,
+    0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+    0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11,
+    0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+    0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52,
+    0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+    0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA,
+    0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+    0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9,
+    0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+    0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C,
+    0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+    0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F,
+    0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+    0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED,
+    0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+    0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE,
+    0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+    0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B,
+    0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+    0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28,
+    0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+    0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0,
+    0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+    0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93,
+    0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+    0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56,
+    0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+    0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15,
+    0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC
+};
+
+// ============================================
+// CRC-8 CALCULATION
+// ============================================
+uint8_t calculateI2CCRC8(const uint8_t* data, size_t len,
+                         uint8_t polynomial, uint8_t init_value) {
+    uint8_t crc = init_value;
+
+    if (polynomial == 0x31) {
+        // Table-based calculation for Sensirion polynomial (fast)
+        for (size_t i = 0; i < len; i++) {
+            crc = pgm_read_byte(&CRC8_POLY31_TABLE[crc ^ data[i]]);
+        }
+    } else {
+        // Bit-by-bit calculation for other polynomials
+        for (size_t i = 0; i < len; i++) {
+            crc ^= data[i];
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                if (crc & 0x80) {
+                    crc = (crc << 1) ^ polynomial;
+                } else {
+                    crc <<= 1;
                 }
             }
-
-            return raw;
         }
     }
 
-    // Value type not found
-    return 0;
+    return crc;
 }
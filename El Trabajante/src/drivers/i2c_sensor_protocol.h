@@ -150,4 +150,56 @@ uint32_t extractRawValue(const String& sensor_type,
                          const uint8_t* buffer,
                          size_t buffer_len);
 
+// ============================================
+// PRE-RESOLVED SENSOR BINDING
+// ============================================
+// Resolved once per configured I2C device (SensorManager::configureSensor),
+// so the measurement path indexes the protocol table directly instead of
+// searching it by string for every read and every value.
+static const uint8_t I2C_BINDING_MAX_VALUES = 4;
+
+struct I2CSensorBinding {
+    const I2CSensorProtocol* protocol;              // nullptr = not bound
+    uint8_t i2c_address;                            // Resolved (protocol default if 0)
+    uint8_t value_count;                            // Entries in value_slots
+    uint8_t value_slots[I2C_BINDING_MAX_VALUES];    // Index into protocol->values, caller's order
+};
+
+/**
+ * Resolve protocol, address and value slots for a device
+ *
+ * @param device_type Device type identifier (e.g., "sht31")
+ * @param value_types Value type names in the order readings are produced
+ * @param value_count Number of entries in value_types (max I2C_BINDING_MAX_VALUES)
+ * @param i2c_address Configured address (0 = protocol default)
+ * @param out Resolved binding (protocol == nullptr on failure)
+ * @return false if the protocol or any value type is unknown
+ */
+bool resolveI2CSensorBinding(const String& device_type,
+                             const char* const* value_types,
+                             uint8_t value_count,
+                             uint8_t i2c_address,
+                             I2CSensorBinding& out);
+
+/**
+ * Extract raw value for the index-th bound value (no lookups)
+ *
+ * @return Extracted raw value, 0 if index or buffer is out of range
+ */
+uint32_t extractBoundRawValue(const I2CSensorBinding& binding,
+                              uint8_t index,
+                              const uint8_t* buffer,
+                              size_t buffer_len);
+
+// ============================================
+// CRC-8
+// ============================================
+
+/**
+ * CRC-8 over data (table-driven for the Sensirion polynomial 0x31,
+ * bitwise for any other polynomial)
+ */
+uint8_t calculateI2CCRC8(const uint8_t* data, size_t len,
+                         uint8_t polynomial, uint8_t init_value);
+
 #endif // DRIVERS_I2C_SENSOR_PROTOCOL_H
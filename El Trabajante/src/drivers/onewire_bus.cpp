@@ -1,7 +1,12 @@
 #include "onewire_bus.h"
+#include "onewire_protocol.h"
+#include "onewire_rmt_transport.h"
+#include "hal/esp32_onewire_bitbang_hal.h"
+#include "hal/esp32_onewire_rmt_hal.h"
 #include "../utils/logger.h"
 #include "../drivers/gpio_manager.h"
 #include "../error_handling/error_tracker.h"
+#include "../error_handling/watchdog_supervisor.h"
 #include "../models/error_codes.h"
 #include "../tasks/rtos_globals.h"  // SAFETY-RTOS M4.3: g_onewire_mutex (scan on Core 0 vs read on Core 1)
 #include <freertos/FreeRTOS.h>
@@ -24,6 +29,59 @@ static const char* TAG = "ONEWIRE";
 // ============================================
 OneWireBusManager& oneWireBusManager = OneWireBusManager::getInstance();
 
+// ============================================
+// BUS TABLE HELPERS
+// ============================================
+int OneWireBusManager::findBus(uint8_t pin) const {
+    for (uint8_t i = 0; i < bus_count_; i++) {
+        if (buses_[i].pin == pin) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool OneWireBusManager::createTransport(Bus& bus) {
+    // Wokwi simulates no RMT RX capture → bit-bang only
+    #ifndef WOKWI_SIMULATION
+        bus.rmt_channel = ESP32OneWireRmtChannel::create(bus.pin);
+        if (bus.rmt_channel != nullptr) {
+            bus.hal = new OneWireRmtTransport(*bus.rmt_channel);
+            if (bus.hal != nullptr) {
+                return true;
+            }
+            delete bus.rmt_channel;
+            bus.rmt_channel = nullptr;
+        }
+        LOG_W(TAG, "OneWire: No free RMT channel pair for GPIO " + String(bus.pin) +
+                   " - using bit-bang backend");
+    #endif
+    bus.hal = new ESP32OneWireBitBangHal(bus.pin);
+    return bus.hal != nullptr;
+}
+
+void OneWireBusManager::destroyTransport(Bus& bus) {
+    if (bus.hal != nullptr) {
+        delete bus.hal;
+        bus.hal = nullptr;
+    }
+    if (bus.rmt_channel != nullptr) {
+        delete bus.rmt_channel;
+        bus.rmt_channel = nullptr;
+    }
+}
+
+void OneWireBusManager::removeBusLocked(uint8_t index) {
+    destroyTransport(buses_[index]);
+    // Release GPIO pin (return to safe mode)
+    gpioManager.releasePin(buses_[index].pin);
+    for (uint8_t i = index; i + 1 < bus_count_; i++) {
+        buses_[i] = buses_[i + 1];
+    }
+    bus_count_--;
+    buses_[bus_count_] = Bus();
+}
+
 // ============================================
 // LIFECYCLE: INITIALIZATION
 // ============================================
@@ -39,23 +97,18 @@ bool OneWireBusManager::begin(uint8_t pin) {
     }
 
     // ============================================
-    // DOUBLE-INIT CHECK: Same pin OK, different pin ERROR
+    // DOUBLE-INIT CHECK: Same pin → reuse, new pin → additional bus
     // ============================================
-    if (initialized_) {
-        // Same pin → OK, bus already active
-        if (requested_pin == pin_) {
-            LOG_D(TAG, "OneWire: Already initialized on GPIO " + String(pin_) + ", reusing bus");
-            return true;
-        }
-        
-        // Different pin → ERROR (Single-Bus-Design!)
-        // Cannot switch OneWire bus to different pin without calling end() first
-        LOG_E(TAG, "OneWire: Bus active on GPIO " + String(pin_) + 
-                 ", cannot switch to GPIO " + String(requested_pin) + 
-                 " (Single-Bus-Design - call end() first if pin change needed)");
+    if (findBus(requested_pin) >= 0) {
+        LOG_D(TAG, "OneWire: Already initialized on GPIO " + String(requested_pin) + ", reusing bus");
+        return true;
+    }
+    if (bus_count_ >= ONEWIRE_MAX_BUSES) {
+        LOG_E(TAG, "OneWire: " + String(ONEWIRE_MAX_BUSES) +
+                   " buses active, cannot add GPIO " + String(requested_pin));
         errorTracker.trackError(ERROR_ONEWIRE_INIT_FAILED,
                                ERROR_SEVERITY_ERROR,
-                               ("Pin conflict: active=" + String(pin_) + ", requested=" + String(requested_pin)).c_str());
+                               "Bus table full");
         return false;
     }
 
@@ -69,57 +122,60 @@ bool OneWireBusManager::begin(uint8_t pin) {
     // ============================================
     // PIN ASSIGNMENT
     // ============================================
-    pin_ = requested_pin;
+    Bus& bus = buses_[bus_count_];
+    bus = Bus();
+    bus.pin = requested_pin;
     if (pin != 0 && pin <= 39) {
-        LOG_I(TAG, "OneWireBus: Using configured pin GPIO " + String(pin_));
+        LOG_I(TAG, "OneWireBus: Using configured pin GPIO " + String(bus.pin));
     } else {
-        LOG_I(TAG, "OneWireBus: Using hardware default pin GPIO " + String(pin_));
+        LOG_I(TAG, "OneWireBus: Using hardware default pin GPIO " + String(bus.pin));
         #ifdef WOKWI_SIMULATION
             LOG_D(TAG, "  (Wokwi mode - using diagram.json pin configuration)");
         #endif
     }
 
-    LOG_D(TAG, "OneWire Config: Pin=" + String(pin_));
+    LOG_D(TAG, "OneWire Config: Pin=" + String(bus.pin));
 
     // ============================================
     // GPIO SAFETY VALIDATION
     // ============================================
     // Use bus-sharing owner format: "bus/onewire/{pin}"
     // This allows SensorManager to recognize the pin as a shared OneWire bus
-    String bus_owner = "bus/onewire/" + String(pin_);
-    if (!gpioManager.requestPin(pin_, bus_owner.c_str(), "OneWireBus")) {
-        LOG_E(TAG, "Failed to reserve OneWire pin " + String(pin_));
+    String bus_owner = "bus/onewire/" + String(bus.pin);
+    if (!gpioManager.requestPin(bus.pin, bus_owner.c_str(), "OneWireBus")) {
+        LOG_E(TAG, "Failed to reserve OneWire pin " + String(bus.pin));
         errorTracker.trackError(ERROR_ONEWIRE_INIT_FAILED,
                                ERROR_SEVERITY_CRITICAL,
-                               ("Pin reservation failed: GPIO " + String(pin_)).c_str());
+                               ("Pin reservation failed: GPIO " + String(bus.pin)).c_str());
+        bus = Bus();
         xSemaphoreGive(g_onewire_mutex);
         return false;
     }
     
-    // Initialize OneWire library
-    onewire_ = new OneWire(pin_);
-    
-    if (onewire_ == nullptr) {
-        LOG_E(TAG, "OneWire object allocation failed");
+    // Create transport (RMT preferred, bit-bang fallback)
+    if (!createTransport(bus)) {
+        LOG_E(TAG, "OneWire transport allocation failed");
         errorTracker.trackError(ERROR_ONEWIRE_INIT_FAILED,
                                ERROR_SEVERITY_CRITICAL,
                                "Memory allocation failed");
-        gpioManager.releasePin(pin_);
+        destroyTransport(bus);
+        gpioManager.releasePin(bus.pin);
+        bus = Bus();
         xSemaphoreGive(g_onewire_mutex);
         return false;
     }
     
     // Verify bus is functional by attempting a reset
-    if (!onewire_->reset()) {
+    if (!bus.hal->reset()) {
         LOG_W(TAG, "OneWire bus reset failed - no devices present or bus error");
         // This is not necessarily an error - just means no devices connected yet
     }
     
-    initialized_ = true;
+    bus_count_++;
     
     LOG_I(TAG, "OneWire Bus Manager initialized successfully");
     LOG_I(TAG, "  Board: " + String(BOARD_TYPE));
-    LOG_I(TAG, "  Pin: GPIO " + String(pin_));
+    LOG_I(TAG, "  Pin: GPIO " + String(bus.pin) + " (" + String(bus.hal->getBackendName()) + ")");
 
     xSemaphoreGive(g_onewire_mutex);
     return true;
@@ -129,7 +185,7 @@ bool OneWireBusManager::begin(uint8_t pin) {
 // LIFECYCLE: DEINITIALIZATION
 // ============================================
 void OneWireBusManager::end() {
-    if (!initialized_) {
+    if (bus_count_ == 0) {
         LOG_W(TAG, "OneWire bus not initialized, nothing to end");
         return;
     }
@@ -141,26 +197,42 @@ void OneWireBusManager::end() {
     
     LOG_I(TAG, "OneWire Bus Manager shutdown initiated");
     
-    // Delete OneWire object
-    if (onewire_ != nullptr) {
-        delete onewire_;
-        onewire_ = nullptr;
+    while (bus_count_ > 0) {
+        removeBusLocked(bus_count_ - 1);
     }
     
-    // Release GPIO pin (return to safe mode)
-    gpioManager.releasePin(pin_);
-    
-    initialized_ = false;
-    
     LOG_I(TAG, "OneWire Bus Manager shutdown complete");
     xSemaphoreGive(g_onewire_mutex);
 }
 
+void OneWireBusManager::end(uint8_t pin) {
+    int index = findBus(pin);
+    if (index < 0) {
+        LOG_W(TAG, "OneWire bus on GPIO " + String(pin) + " not initialized, nothing to end");
+        return;
+    }
+
+    if (xSemaphoreTake(g_onewire_mutex, portMAX_DELAY) != pdTRUE) {
+        LOG_W(TAG, "OneWire: Mutex unavailable — end() skipped");
+        return;
+    }
+
+    removeBusLocked(static_cast<uint8_t>(index));
+    LOG_I(TAG, "OneWire bus on GPIO " + String(pin) + " shut down");
+    xSemaphoreGive(g_onewire_mutex);
+}
+
 // ============================================
 // DEVICE DISCOVERY
 // ============================================
 bool OneWireBusManager::scanDevices(uint8_t rom_codes[][8], uint8_t max_devices, uint8_t& found_count) {
-    if (!initialized_ || onewire_ == nullptr) {
+    return scanDevices(getPin(), rom_codes, max_devices, found_count);
+}
+
+bool OneWireBusManager::scanDevices(uint8_t pin, uint8_t rom_codes[][8], uint8_t max_devices,
+                                    uint8_t& found_count) {
+    int index = findBus(pin);
+    if (index < 0) {
         LOG_E(TAG, "OneWire bus not initialized");
         return false;
     }
@@ -170,18 +242,20 @@ bool OneWireBusManager::scanDevices(uint8_t rom_codes[][8], uint8_t max_devices,
         return false;
     }
     
-    LOG_I(TAG, "OneWire bus scan started");
+    LOG_I(TAG, "OneWire bus scan started (GPIO " + String(pin) + ")");
     
+    IOneWireHal& hal = *buses_[index].hal;
     found_count = 0;
     
     // Reset search
-    onewire_->reset_search();
+    OneWireSearchState search;
+    OneWireProtocol::resetSearch(search);
     
     // Search for devices
     uint8_t rom[8];
-    while (onewire_->search(rom)) {
+    while (OneWireProtocol::searchNext(hal, search, rom)) {
         // Check CRC
-        if (OneWire::crc8(rom, 7) != rom[7]) {
+        if (OneWireProtocol::crc8(rom, 7) != rom[7]) {
             LOG_W(TAG, "OneWire CRC error - device ignored");
             continue;
         }
@@ -218,7 +292,12 @@ bool OneWireBusManager::scanDevices(uint8_t rom_codes[][8], uint8_t max_devices,
 // DEVICE PRESENCE CHECK
 // ============================================
 bool OneWireBusManager::isDevicePresent(const uint8_t rom_code[8]) {
-    if (!initialized_ || onewire_ == nullptr) {
+    return isDevicePresent(getPin(), rom_code);
+}
+
+bool OneWireBusManager::isDevicePresent(uint8_t pin, const uint8_t rom_code[8]) {
+    int index = findBus(pin);
+    if (index < 0) {
         LOG_E(TAG, "OneWire bus not initialized");
         return false;
     }
@@ -228,35 +307,24 @@ bool OneWireBusManager::isDevicePresent(const uint8_t rom_code[8]) {
         return false;
     }
     
-    // Reset search and try to find this specific device
-    onewire_->reset_search();
-    
-    uint8_t rom[8];
-    while (onewire_->search(rom)) {
-        // Compare ROM codes
-        bool match = true;
-        for (uint8_t i = 0; i < 8; i++) {
-            if (rom[i] != rom_code[i]) {
-                match = false;
-                break;
-            }
-        }
-        
-        if (match) {
-            xSemaphoreGive(g_onewire_mutex);
-            return true;
-        }
-    }
+    // Single search pass along the target ROM instead of a full enumeration
+    bool present = OneWireProtocol::verify(*buses_[index].hal, rom_code);
 
     xSemaphoreGive(g_onewire_mutex);
-    return false;
+    return present;
 }
 
 // ============================================
 // RAW TEMPERATURE READING (PI-ENHANCED MODE)
 // ============================================
 bool OneWireBusManager::readRawTemperature(const uint8_t rom_code[8], int16_t& raw_value) {
-    if (!initialized_ || onewire_ == nullptr) {
+    return readRawTemperature(getPin(), rom_code, raw_value);
+}
+
+bool OneWireBusManager::readRawTemperature(uint8_t pin, const uint8_t rom_code[8], int16_t& raw_value,
+                                           uint8_t resolution_bits) {
+    int index = findBus(pin);
+    if (index < 0) {
         LOG_E(TAG, "OneWire bus not initialized");
         errorTracker.trackError(ERROR_ONEWIRE_READ_FAILED,
                                ERROR_SEVERITY_ERROR,
@@ -264,13 +332,29 @@ bool OneWireBusManager::readRawTemperature(const uint8_t rom_code[8], int16_t& r
         return false;
     }
 
+    // Mutex wait (scan on Core 0) + up to 750 ms conversion: attributed on WDT reset
+    static const uint8_t WDT_HB_CONVERSION = watchdogSupervisor.registerHeartbeat("onewire_conv", 1500);
+    WdtPhaseScope wdt_phase(WDT_HB_CONVERSION);
+
     if (xSemaphoreTake(g_onewire_mutex, portMAX_DELAY) != pdTRUE) {
         LOG_W(TAG, "OneWire: Mutex unavailable — read skipped");
         return false;
     }
+
+    IOneWireHal& hal = *buses_[index].hal;
     
-    // Verify device is present
-    if (!onewire_->reset()) {
+    // Reset, select device, start temperature conversion (0x44)
+    // External VCC: parasitic power bit = 0. Conversion time up to 750 ms @ 12-bit (datasheet),
+    // halved per bit below 12 (configured resolution, see configureResolution()).
+    // Wokwi: the virtual DS18B20 updates the scratchpad only after conversion completes; a short
+    // delay (e.g. 10 ms) reads stale/garbage bytes → scratchpad CRC8 check fails while ROM scan
+    // still works. Match real timing here (same as non-Wokwi path, minus strong pullup).
+    #ifdef WOKWI_SIMULATION
+        const bool parasite_power = false;
+    #else
+        const bool parasite_power = true;  // Strong pullup after write
+    #endif
+    if (OneWireProtocol::startConversion(hal, rom_code, parasite_power) != OneWireStatus::OK) {
         LOG_E(TAG, "OneWire reset failed - no devices on bus");
         errorTracker.trackError(ERROR_ONEWIRE_READ_FAILED,
                                ERROR_SEVERITY_ERROR,
@@ -278,25 +362,13 @@ bool OneWireBusManager::readRawTemperature(const uint8_t rom_code[8], int16_t& r
         xSemaphoreGive(g_onewire_mutex);
         return false;
     }
+    hal.delayMs(OneWireProtocol::conversionTimeMs(resolution_bits));
+    hal.depower();
     
-    // Select device
-    onewire_->select(rom_code);
-
-    // Start temperature conversion (0x44)
-    // External VCC: parasitic power bit = 0. Conversion time up to 750 ms @ 12-bit (datasheet).
-    // Wokwi: the virtual DS18B20 updates the scratchpad only after conversion completes; a short
-    // delay (e.g. 10 ms) reads stale/garbage bytes → scratchpad CRC8 check fails while ROM scan
-    // still works. Match real timing here (same as non-Wokwi path, minus strong pullup).
-    #ifdef WOKWI_SIMULATION
-        onewire_->write(0x44, 0);
-        delay(750);
-    #else
-        onewire_->write(0x44, 1);  // 1 = parasitic power (strong pullup after write)
-        delay(750);
-    #endif
-    
-    // Reset and select device again
-    if (!onewire_->reset()) {
+    // Reset, select device again, read scratchpad (0xBE, 9 bytes) + CRC check
+    uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+    OneWireStatus status = OneWireProtocol::readScratchpad(hal, rom_code, scratchpad);
+    if (status == OneWireStatus::NO_PRESENCE) {
         LOG_E(TAG, "OneWire reset failed after conversion");
         errorTracker.trackError(ERROR_ONEWIRE_READ_FAILED,
                                ERROR_SEVERITY_ERROR,
@@ -304,20 +376,7 @@ bool OneWireBusManager::readRawTemperature(const uint8_t rom_code[8], int16_t& r
         xSemaphoreGive(g_onewire_mutex);
         return false;
     }
-    
-    onewire_->select(rom_code);
-    
-    // Read scratchpad (0xBE)
-    onewire_->write(0xBE);
-    
-    // Read 9 bytes (scratchpad)
-    uint8_t scratchpad[9];
-    for (uint8_t i = 0; i < 9; i++) {
-        scratchpad[i] = onewire_->read();
-    }
-    
-    // Verify CRC
-    if (OneWire::crc8(scratchpad, 8) != scratchpad[8]) {
+    if (status == OneWireStatus::CRC_ERROR) {
         LOG_E(TAG, "OneWire CRC error on temperature read");
         errorTracker.trackError(ERROR_ONEWIRE_READ_FAILED,
                                ERROR_SEVERITY_ERROR,
@@ -329,8 +388,9 @@ bool OneWireBusManager::readRawTemperature(const uint8_t rom_code[8], int16_t& r
     // Extract raw temperature value (12-bit signed)
     // Temp is in bytes 0 (LSB) and 1 (MSB)
     raw_value = (scratchpad[1] << 8) | scratchpad[0];
+    raw_value = OneWireProtocol::maskRawTemperature(raw_value, resolution_bits);
     
-    // Raw value is in 1/16th degree units
+    // Raw value is in 1/16th degree units (at every resolution)
     // Range: -550 to +1250 (-55.0°C to +125.0°C)
     // Conversion formula (done on server): temp_celsius = raw_value * 0.0625
     
@@ -341,13 +401,76 @@ bool OneWireBusManager::readRawTemperature(const uint8_t rom_code[8], int16_t& r
     return true;
 }
 
+// ============================================
+// DS18B20 RESOLUTION
+// ============================================
+bool OneWireBusManager::configureResolution(uint8_t pin, const uint8_t rom_code[8],
+                                            uint8_t resolution_bits) {
+    int index = findBus(pin);
+    if (index < 0) {
+        LOG_E(TAG, "OneWire bus not initialized");
+        return false;
+    }
+    if (!OneWireProtocol::isValidResolution(resolution_bits)) {
+        LOG_E(TAG, "OneWire: Invalid DS18B20 resolution " + String(resolution_bits) + " bit");
+        return false;
+    }
+
+    if (xSemaphoreTake(g_onewire_mutex, portMAX_DELAY) != pdTRUE) {
+        LOG_W(TAG, "OneWire: Mutex unavailable — resolution config skipped");
+        return false;
+    }
+
+    #ifdef WOKWI_SIMULATION
+        const bool parasite_power = false;
+    #else
+        const bool parasite_power = true;  // EEPROM copy needs the strong pullup on parasite devices
+    #endif
+    bool eeprom_written = false;
+    OneWireStatus status = OneWireProtocol::configureResolution(
+        *buses_[index].hal, rom_code, resolution_bits, parasite_power, eeprom_written);
+    xSemaphoreGive(g_onewire_mutex);
+
+    if (status != OneWireStatus::OK) {
+        LOG_E(TAG, "OneWire: Resolution config failed (" +
+                   String(status == OneWireStatus::NO_PRESENCE ? "no presence" :
+                          status == OneWireStatus::CRC_ERROR ? "CRC error" : "verify failed") + ")");
+        errorTracker.trackError(ERROR_ONEWIRE_READ_FAILED,
+                               ERROR_SEVERITY_WARNING,
+                               "Resolution config failed");
+        return false;
+    }
+
+    if (eeprom_written) {
+        LOG_I(TAG, "OneWire: DS18B20 resolution set to " + String(resolution_bits) +
+                   " bit (EEPROM updated)");
+    } else {
+        LOG_D(TAG, "OneWire: DS18B20 already at " + String(resolution_bits) + " bit");
+    }
+    return true;
+}
+
 // ============================================
 // STATUS QUERIES
 // ============================================
+const char* OneWireBusManager::getBackendName(uint8_t pin) const {
+    int index = findBus(pin);
+    if (index < 0 || buses_[index].hal == nullptr) {
+        return nullptr;
+    }
+    return buses_[index].hal->getBackendName();
+}
+
 String OneWireBusManager::getBusStatus() const {
     String status = "OneWire[";
-    status += "Pin:" + String(pin_);
-    status += ",Init:" + String(initialized_ ? "true" : "false");
+    for (uint8_t i = 0; i < bus_count_; i++) {
+        status += "Pin:" + String(buses_[i].pin);
+        status += "(" + String(buses_[i].hal != nullptr ? buses_[i].hal->getBackendName() : "-") + "),";
+    }
+    if (bus_count_ == 0) {
+        status += "Pin:0,";
+    }
+    status += "Init:" + String(bus_count_ > 0 ? "true" : "false");
     status += "]";
     return status;
 }
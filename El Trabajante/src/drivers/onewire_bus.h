@@ -2,7 +2,10 @@
 #define DRIVERS_ONEWIRE_BUS_H
 
 #include <Arduino.h>
-#include <OneWire.h>
+#include "hal/ionewire_hal.h"
+#include "onewire_protocol.h"
+
+class ESP32OneWireRmtChannel;
 
 // ============================================
 // OneWire Bus Manager - Hardware Abstraction Layer
@@ -16,6 +19,14 @@
 // - Device discovery (ROM codes)
 // - Raw temperature reading for Pi-Enhanced processing
 // - NO local temperature conversion (Server-Centric!)
+//
+// Transport: one IOneWireHal per bus pin. RMT backend (slots in hardware,
+// see onewire_rmt_transport.h) when a channel pair is free, otherwise the
+// bit-bang OneWire library. Several pins can be active at once; the first
+// initialized bus is the "primary" bus used by the pin-less overloads.
+
+// Max. concurrently active OneWire pins
+static const uint8_t ONEWIRE_MAX_BUSES = 4;
 
 // ============================================
 // ONEWIRE BUS MANAGER CLASS
@@ -52,12 +63,16 @@ public:
     //
     // Example:
     //   oneWireBusManager.begin();      // Use default pin (GPIO 4 on ESP32 Dev)
-    //   oneWireBusManager.begin(21);    // Override to GPIO 21
+    //   oneWireBusManager.begin(21);    // Additional bus on GPIO 21
+    // Same pin again → reuses the bus; a new pin adds a bus (max ONEWIRE_MAX_BUSES)
     bool begin(uint8_t pin = 0);
 
-    // Deinitialize OneWire bus and release pin
+    // Deinitialize all OneWire buses and release their pins
     void end();
 
+    // Deinitialize the bus on one pin
+    void end(uint8_t pin);
+
     // ============================================
     // DEVICE DISCOVERY
     // ============================================
@@ -67,11 +82,13 @@ public:
     // found_count: Output parameter with number of found devices
     // Returns false if scan fails
     bool scanDevices(uint8_t rom_codes[][8], uint8_t max_devices, uint8_t& found_count);
+    bool scanDevices(uint8_t pin, uint8_t rom_codes[][8], uint8_t max_devices, uint8_t& found_count);
 
-    // Check if a specific device is present on bus
+    // Check if a specific device is present on bus (targeted search pass)
     // rom_code: 8-byte ROM code of device
     // Returns true if device responds
     bool isDevicePresent(const uint8_t rom_code[8]);
+    bool isDevicePresent(uint8_t pin, const uint8_t rom_code[8]);
 
     // ============================================
     // RAW TEMPERATURE READING (PI-ENHANCED MODE)
@@ -81,47 +98,74 @@ public:
     // raw_value: Output 12-bit signed temperature value
     //            Range: -550 to +1250 (represents -55.0°C to +125.0°C)
     //            Resolution: 0.0625°C per LSB
+    // resolution_bits: configured device resolution (9-12, see configureResolution).
+    //            Selects the conversion wait (94 / 188 / 375 / 750 ms); bits below
+    //            the resolution are cleared, units stay 0.0625°C per LSB.
     // Returns false if device not found or read fails
     //
     // IMPORTANT: NO local conversion to °C!
     // Raw value is sent to God-Kaiser for processing
     bool readRawTemperature(const uint8_t rom_code[8], int16_t& raw_value);
+    bool readRawTemperature(uint8_t pin, const uint8_t rom_code[8], int16_t& raw_value,
+                            uint8_t resolution_bits = DS18B20_RESOLUTION_DEFAULT);
+
+    // Write resolution to scratchpad + EEPROM (only if it differs from the device)
+    // Returns false if the device does not answer or the write cannot be verified;
+    // the device then keeps its previous resolution.
+    bool configureResolution(uint8_t pin, const uint8_t rom_code[8], uint8_t resolution_bits);
 
     // ============================================
     // STATUS QUERIES
     // ============================================
-    // Check if OneWire bus is initialized
-    bool isInitialized() const { return initialized_; }
+    // Check if any OneWire bus / the bus on a specific pin is initialized
+    bool isInitialized() const { return bus_count_ > 0; }
+    bool isInitialized(uint8_t pin) const { return findBus(pin) >= 0; }
 
-    // Get current OneWire pin (for debugging/verification)
+    // Get primary OneWire pin (for debugging/verification)
     // Returns 0 if not initialized
-    uint8_t getPin() const { return pin_; }
+    uint8_t getPin() const { return bus_count_ > 0 ? buses_[0].pin : 0; }
+
+    uint8_t getBusCount() const { return bus_count_; }
+
+    // Transport backend of the bus on pin ("rmt" / "bitbang"), nullptr if none
+    const char* getBackendName(uint8_t pin) const;
 
     // Get detailed bus status for debugging
-    // Format: "OneWire[Pin:6,Init:true]"
+    // Format: "OneWire[Pin:6(rmt),Pin:21(bitbang),Init:true]"
     String getBusStatus() const;
 
 private:
     // ============================================
     // PRIVATE CONSTRUCTOR (SINGLETON)
     // ============================================
-    OneWireBusManager() 
-        : onewire_(nullptr),
-          initialized_(false), 
-          pin_(0) {}
-    
+    OneWireBusManager() : bus_count_(0) {
+        for (uint8_t i = 0; i < ONEWIRE_MAX_BUSES; i++) {
+            buses_[i] = Bus();
+        }
+    }
+
     ~OneWireBusManager() {
-        if (onewire_ != nullptr) {
-            delete onewire_;
+        for (uint8_t i = 0; i < bus_count_; i++) {
+            destroyTransport(buses_[i]);
         }
     }
 
     // ============================================
     // INTERNAL STATE
     // ============================================
-    OneWire* onewire_;      // OneWire library instance
-    bool initialized_;      // Bus initialization status
-    uint8_t pin_;           // OneWire pin (from HardwareConfig)
+    struct Bus {
+        uint8_t pin = 0;
+        IOneWireHal* hal = nullptr;          // Transport (RMT or bit-bang)
+        ESP32OneWireRmtChannel* rmt_channel = nullptr;  // RMT backend only (owned)
+    };
+
+    Bus buses_[ONEWIRE_MAX_BUSES];  // [0] = primary bus
+    uint8_t bus_count_;
+
+    int findBus(uint8_t pin) const;
+    bool createTransport(Bus& bus);
+    static void destroyTransport(Bus& bus);
+    void removeBusLocked(uint8_t index);
 };
 
 // ============================================
@@ -0,0 +1,218 @@
+#include "onewire_protocol.h"
+
+#include <string.h>
+
+// ============================================
+// CRC8
+// ============================================
+uint8_t OneWireProtocol::crc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            uint8_t mix = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8C;
+            }
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+// ============================================
+// ROM ADDRESSING
+// ============================================
+OneWireStatus OneWireProtocol::select(IOneWireHal& hal, const uint8_t rom[8]) {
+    if (!hal.reset()) {
+        return OneWireStatus::NO_PRESENCE;
+    }
+    uint8_t frame[9];
+    frame[0] = ONEWIRE_CMD_MATCH_ROM;
+    memcpy(frame + 1, rom, 8);
+    hal.writeBytes(frame, sizeof(frame));
+    return OneWireStatus::OK;
+}
+
+// ============================================
+// SEARCH (Maxim AN187)
+// ============================================
+void OneWireProtocol::resetSearch(OneWireSearchState& state) {
+    memset(state.rom, 0, sizeof(state.rom));
+    state.last_discrepancy = 0;
+    state.last_device = false;
+}
+
+bool OneWireProtocol::searchNext(IOneWireHal& hal, OneWireSearchState& state, uint8_t rom_out[8]) {
+    if (state.last_device) {
+        return false;
+    }
+    if (!hal.reset()) {
+        resetSearch(state);
+        return false;
+    }
+    hal.writeByte(ONEWIRE_CMD_SEARCH_ROM);
+
+    uint8_t last_zero = 0;
+    for (uint8_t bit_number = 1; bit_number <= 64; bit_number++) {
+        uint8_t byte_index = (bit_number - 1) / 8;
+        uint8_t mask = static_cast<uint8_t>(1U << ((bit_number - 1) % 8));
+
+        // Triplet: bit, complement, chosen direction
+        uint8_t pair = 0;
+        hal.readBits(&pair, 2);
+        bool id_bit = (pair & 0x01) != 0;
+        bool cmp_id_bit = (pair & 0x02) != 0;
+
+        if (id_bit && cmp_id_bit) {
+            // No device took part in this pass (removed during search)
+            resetSearch(state);
+            return false;
+        }
+
+        bool direction;
+        if (id_bit != cmp_id_bit) {
+            direction = id_bit;
+        } else if (bit_number < state.last_discrepancy) {
+            direction = (state.rom[byte_index] & mask) != 0;
+        } else {
+            direction = (bit_number == state.last_discrepancy);
+        }
+        if (id_bit == cmp_id_bit && !direction) {
+            last_zero = bit_number;
+        }
+
+        if (direction) {
+            state.rom[byte_index] |= mask;
+        } else {
+            state.rom[byte_index] &= static_cast<uint8_t>(~mask);
+        }
+        hal.writeBit(direction);
+    }
+
+    state.last_discrepancy = last_zero;
+    state.last_device = (last_zero == 0);
+    memcpy(rom_out, state.rom, sizeof(state.rom));
+    return true;
+}
+
+bool OneWireProtocol::verify(IOneWireHal& hal, const uint8_t rom[8]) {
+    // Search pass forced down the path of the given ROM: at every
+    // discrepancy the stored bit is taken, ends on the target if present.
+    OneWireSearchState state;
+    memcpy(state.rom, rom, sizeof(state.rom));
+    state.last_discrepancy = 64;
+    state.last_device = false;
+
+    uint8_t found[8];
+    if (!searchNext(hal, state, found)) {
+        return false;
+    }
+    return memcmp(found, rom, sizeof(found)) == 0;
+}
+
+// ============================================
+// DS18B20 SEQUENCES
+// ============================================
+OneWireStatus OneWireProtocol::startConversion(IOneWireHal& hal, const uint8_t rom[8],
+                                               bool parasite_power) {
+    OneWireStatus status = select(hal, rom);
+    if (status != OneWireStatus::OK) {
+        return status;
+    }
+    hal.writeByte(DS18B20_CMD_CONVERT_T, parasite_power);
+    return OneWireStatus::OK;
+}
+
+OneWireStatus OneWireProtocol::readScratchpad(IOneWireHal& hal, const uint8_t rom[8],
+                                              uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]) {
+    OneWireStatus status = select(hal, rom);
+    if (status != OneWireStatus::OK) {
+        return status;
+    }
+    hal.writeByte(DS18B20_CMD_READ_SCRATCHPAD);
+    hal.readBytes(scratchpad, DS18B20_SCRATCHPAD_SIZE);
+    if (crc8(scratchpad, DS18B20_SCRATCHPAD_SIZE - 1) != scratchpad[DS18B20_SCRATCHPAD_SIZE - 1]) {
+        return OneWireStatus::CRC_ERROR;
+    }
+    return OneWireStatus::OK;
+}
+
+OneWireStatus OneWireProtocol::configureResolution(IOneWireHal& hal, const uint8_t rom[8],
+                                                   uint8_t resolution_bits, bool parasite_power,
+                                                   bool& eeprom_written) {
+    eeprom_written = false;
+    uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+    OneWireStatus status = readScratchpad(hal, rom, scratchpad);
+    if (status != OneWireStatus::OK) {
+        return status;
+    }
+    const uint8_t config = resolutionToConfig(resolution_bits);
+    if (configToResolution(scratchpad[DS18B20_SCRATCHPAD_CONFIG]) == configToResolution(config)) {
+        return OneWireStatus::OK;
+    }
+
+    // WRITE SCRATCHPAD: TH, TL, config (TH/TL unchanged)
+    status = select(hal, rom);
+    if (status != OneWireStatus::OK) {
+        return status;
+    }
+    const uint8_t frame[4] = {DS18B20_CMD_WRITE_SCRATCHPAD, scratchpad[2], scratchpad[3], config};
+    hal.writeBytes(frame, sizeof(frame));
+
+    // Read back before touching the EEPROM
+    status = readScratchpad(hal, rom, scratchpad);
+    if (status != OneWireStatus::OK) {
+        return status;
+    }
+    if (configToResolution(scratchpad[DS18B20_SCRATCHPAD_CONFIG]) != configToResolution(config)) {
+        return OneWireStatus::VERIFY_FAILED;
+    }
+
+    // COPY SCRATCHPAD → EEPROM (survives power cycles)
+    status = select(hal, rom);
+    if (status != OneWireStatus::OK) {
+        return status;
+    }
+    hal.writeByte(DS18B20_CMD_COPY_SCRATCHPAD, parasite_power);
+    hal.delayMs(DS18B20_COPY_SCRATCHPAD_MS);
+    hal.depower();
+    eeprom_written = true;
+    return OneWireStatus::OK;
+}
+
+// ============================================
+// DS18B20 RESOLUTION HELPERS
+// ============================================
+bool OneWireProtocol::hasResolutionConfig(const uint8_t rom[8]) {
+    return rom[0] == 0x28 || rom[0] == 0x22;
+}
+
+uint8_t OneWireProtocol::resolutionToConfig(uint8_t resolution_bits) {
+    if (!isValidResolution(resolution_bits)) {
+        resolution_bits = DS18B20_RESOLUTION_DEFAULT;
+    }
+    return static_cast<uint8_t>(((resolution_bits - DS18B20_RESOLUTION_MIN) << 5) | 0x1F);
+}
+
+uint8_t OneWireProtocol::configToResolution(uint8_t config) {
+    return static_cast<uint8_t>(DS18B20_RESOLUTION_MIN + ((config >> 5) & 0x03));
+}
+
+uint16_t OneWireProtocol::conversionTimeMs(uint8_t resolution_bits) {
+    switch (resolution_bits) {
+        case 9:  return 94;     // 93.75 ms
+        case 10: return 188;    // 187.5 ms
+        case 11: return 375;
+        default: return 750;
+    }
+}
+
+int16_t OneWireProtocol::maskRawTemperature(int16_t raw, uint8_t resolution_bits) {
+    if (!isValidResolution(resolution_bits)) {
+        return raw;
+    }
+    const uint16_t undefined_bits = static_cast<uint16_t>((1U << (DS18B20_RESOLUTION_MAX - resolution_bits)) - 1U);
+    return static_cast<int16_t>(static_cast<uint16_t>(raw) & static_cast<uint16_t>(~undefined_bits));
+}
@@ -0,0 +1,107 @@
+#ifndef DRIVERS_ONEWIRE_PROTOCOL_H
+#define DRIVERS_ONEWIRE_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hal/ionewire_hal.h"
+
+// ============================================
+// ONEWIRE PROTOCOL (transport independent)
+// ============================================
+// ROM addressing, search (Maxim AN187) and the DS18B20 command sequences on
+// top of IOneWireHal. Identical for the RMT and the bit-bang backend, so the
+// transport conformance test covers both with one device model.
+// Pure logic — caller holds g_onewire_mutex.
+
+// ROM commands
+static const uint8_t ONEWIRE_CMD_SEARCH_ROM = 0xF0;
+static const uint8_t ONEWIRE_CMD_READ_ROM = 0x33;
+static const uint8_t ONEWIRE_CMD_MATCH_ROM = 0x55;
+static const uint8_t ONEWIRE_CMD_SKIP_ROM = 0xCC;
+
+// DS18B20 function commands
+static const uint8_t DS18B20_CMD_CONVERT_T = 0x44;
+static const uint8_t DS18B20_CMD_WRITE_SCRATCHPAD = 0x4E;
+static const uint8_t DS18B20_CMD_READ_SCRATCHPAD = 0xBE;
+static const uint8_t DS18B20_CMD_COPY_SCRATCHPAD = 0x48;
+
+static const uint8_t DS18B20_SCRATCHPAD_SIZE = 9;
+static const uint8_t DS18B20_SCRATCHPAD_CONFIG = 4;        // Config register byte
+
+// Resolution 9..12 bit (config register bits R1:R0). Conversion time halves
+// per bit removed: 750 / 375 / 187.5 / 93.75 ms. Power-on default is 12 bit.
+static const uint8_t DS18B20_RESOLUTION_MIN = 9;
+static const uint8_t DS18B20_RESOLUTION_MAX = 12;
+static const uint8_t DS18B20_RESOLUTION_DEFAULT = 12;
+static const uint16_t DS18B20_COPY_SCRATCHPAD_MS = 10;     // EEPROM write (datasheet tWR)
+
+enum class OneWireStatus : uint8_t {
+    OK = 0,
+    NO_PRESENCE,        // Reset without presence pulse (no device / bus error)
+    CRC_ERROR,          // Data read but CRC8 mismatch
+    VERIFY_FAILED       // Written value not found on read-back
+};
+
+// Search state for enumerating all devices on one bus
+struct OneWireSearchState {
+    uint8_t rom[8];
+    uint8_t last_discrepancy;   // 1-based bit position, 0 = none
+    bool last_device;
+};
+
+class OneWireProtocol {
+public:
+    // Dallas/Maxim CRC8 (polynomial x^8 + x^5 + x^4 + 1)
+    static uint8_t crc8(const uint8_t* data, size_t length);
+
+    // Reset + MATCH ROM (one 72-bit write)
+    static OneWireStatus select(IOneWireHal& hal, const uint8_t rom[8]);
+
+    // Enumeration: resetSearch() once, then searchNext() until it returns false.
+    // ROM CRC is NOT checked here (caller decides whether to skip bad codes).
+    static void resetSearch(OneWireSearchState& state);
+    static bool searchNext(IOneWireHal& hal, OneWireSearchState& state, uint8_t rom_out[8]);
+
+    // Targeted search for one ROM code (single search pass, no full enumeration)
+    static bool verify(IOneWireHal& hal, const uint8_t rom[8]);
+
+    // DS18B20: start conversion on one device. parasite_power keeps the line
+    // driven high until the caller calls hal.depower() after the conversion time.
+    static OneWireStatus startConversion(IOneWireHal& hal, const uint8_t rom[8], bool parasite_power);
+
+    // DS18B20: read the 9-byte scratchpad and validate its CRC
+    static OneWireStatus readScratchpad(IOneWireHal& hal, const uint8_t rom[8],
+                                        uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]);
+
+    // DS18B20: set the conversion resolution and copy it to the device EEPROM.
+    // Write-once: if the scratchpad already holds the requested resolution,
+    // nothing is written (EEPROM endurance, no extra 10 ms on every boot).
+    // TH/TL are preserved. eeprom_written reports whether a copy took place.
+    static OneWireStatus configureResolution(IOneWireHal& hal, const uint8_t rom[8],
+                                             uint8_t resolution_bits, bool parasite_power,
+                                             bool& eeprom_written);
+
+    // ============================================
+    // DS18B20 RESOLUTION HELPERS
+    // ============================================
+    // Family codes with a resolution config register (DS18B20 0x28, DS1822 0x22)
+    static bool hasResolutionConfig(const uint8_t rom[8]);
+
+    static bool isValidResolution(uint8_t resolution_bits) {
+        return resolution_bits >= DS18B20_RESOLUTION_MIN && resolution_bits <= DS18B20_RESOLUTION_MAX;
+    }
+
+    // Config register value for 9..12 bit (reserved bits set as on the device)
+    static uint8_t resolutionToConfig(uint8_t resolution_bits);
+    static uint8_t configToResolution(uint8_t config);
+
+    // Max. conversion time (datasheet tCONV, rounded up to full ms)
+    static uint16_t conversionTimeMs(uint8_t resolution_bits);
+
+    // Raw value stays in 1/16 °C units at every resolution; the bits below
+    // the resolution are undefined on the device and are cleared here.
+    static int16_t maskRawTemperature(int16_t raw, uint8_t resolution_bits);
+};
+
+#endif // DRIVERS_ONEWIRE_PROTOCOL_H
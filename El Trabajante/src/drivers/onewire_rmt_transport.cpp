@@ -0,0 +1,153 @@
+#include "onewire_rmt_transport.h"
+
+#include <string.h>
+
+// ============================================
+// CODEC
+// ============================================
+static bool getBit(const uint8_t* data, uint16_t index) {
+    return (data[index / 8] & (1U << (index % 8))) != 0;
+}
+
+static void setBit(uint8_t* data, uint16_t index, bool value) {
+    uint8_t mask = static_cast<uint8_t>(1U << (index % 8));
+    if (value) {
+        data[index / 8] |= mask;
+    } else {
+        data[index / 8] &= static_cast<uint8_t>(~mask);
+    }
+}
+
+size_t OneWireRmtCodec::encodeReset(OneWireRmtSymbol* out) {
+    out[0].low_us = ONEWIRE_RMT_RESET_LOW_US;
+    out[0].high_us = ONEWIRE_RMT_RESET_HIGH_US;
+    return 1;
+}
+
+size_t OneWireRmtCodec::encodeWrite(const uint8_t* data, uint16_t first_bit, uint16_t count,
+                                    OneWireRmtSymbol* out) {
+    for (uint16_t i = 0; i < count; i++) {
+        if (getBit(data, first_bit + i)) {
+            out[i].low_us = ONEWIRE_RMT_WRITE1_LOW_US;
+            out[i].high_us = ONEWIRE_RMT_WRITE1_HIGH_US;
+        } else {
+            out[i].low_us = ONEWIRE_RMT_WRITE0_LOW_US;
+            out[i].high_us = ONEWIRE_RMT_WRITE0_HIGH_US;
+        }
+    }
+    return count;
+}
+
+size_t OneWireRmtCodec::encodeReadSlots(uint16_t count, OneWireRmtSymbol* out) {
+    for (uint16_t i = 0; i < count; i++) {
+        out[i].low_us = ONEWIRE_RMT_READ_LOW_US;
+        out[i].high_us = ONEWIRE_RMT_READ_HIGH_US;
+    }
+    return count;
+}
+
+bool OneWireRmtCodec::decodePresence(const OneWireRmtSymbol* rx, size_t rx_count) {
+    // rx[0] = our reset low; a shorted bus shows one endless low instead
+    if (rx_count < 2 || rx[0].low_us < ONEWIRE_RMT_RESET_LOW_US - ONEWIRE_RMT_READ_SAMPLE_US) {
+        return false;
+    }
+    for (size_t i = 1; i < rx_count; i++) {
+        if (rx[i].low_us >= ONEWIRE_RMT_PRESENCE_MIN_US &&
+            rx[i].low_us <= ONEWIRE_RMT_PRESENCE_MAX_US) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool OneWireRmtCodec::decodeReadSlots(const OneWireRmtSymbol* rx, size_t rx_count,
+                                      uint8_t* data, uint16_t first_bit, uint16_t count) {
+    if (rx_count < count) {
+        return false;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        setBit(data, first_bit + i, rx[i].low_us < ONEWIRE_RMT_READ_SAMPLE_US);
+    }
+    return true;
+}
+
+// ============================================
+// TRANSPORT
+// ============================================
+OneWireRmtTransport::OneWireRmtTransport(IOneWireRmtChannel& channel)
+    : channel_(channel), powered_(false) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+void OneWireRmtTransport::resetStats() {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+bool OneWireRmtTransport::reset() {
+    depower();
+    size_t tx_count = OneWireRmtCodec::encodeReset(tx_);
+    size_t rx_count = 0;
+    stats_.transfers++;
+    stats_.slots++;
+    if (!channel_.transfer(tx_, tx_count, rx_, ONEWIRE_RMT_RX_CAPACITY, &rx_count)) {
+        stats_.timeouts++;
+        return false;
+    }
+    return OneWireRmtCodec::decodePresence(rx_, rx_count);
+}
+
+void OneWireRmtTransport::writeBits(const uint8_t* data, uint16_t bit_count, bool power_after) {
+    for (uint16_t done = 0; done < bit_count;) {
+        uint16_t chunk = bit_count - done;
+        if (chunk > ONEWIRE_RMT_MAX_SLOTS) {
+            chunk = ONEWIRE_RMT_MAX_SLOTS;
+        }
+        size_t tx_count = OneWireRmtCodec::encodeWrite(data, done, chunk, tx_);
+        stats_.transfers++;
+        stats_.slots += chunk;
+        if (!channel_.transfer(tx_, tx_count, nullptr, 0, nullptr)) {
+            stats_.timeouts++;
+        }
+        done += chunk;
+    }
+    if (power_after) {
+        channel_.setStrongPullup(true);
+        powered_ = true;
+    }
+}
+
+void OneWireRmtTransport::readBits(uint8_t* data, uint16_t bit_count) {
+    for (uint16_t done = 0; done < bit_count;) {
+        uint16_t chunk = bit_count - done;
+        if (chunk > ONEWIRE_RMT_MAX_SLOTS) {
+            chunk = ONEWIRE_RMT_MAX_SLOTS;
+        }
+        size_t tx_count = OneWireRmtCodec::encodeReadSlots(chunk, tx_);
+        size_t rx_count = 0;
+        stats_.transfers++;
+        stats_.slots += chunk;
+        bool ok = channel_.transfer(tx_, tx_count, rx_, ONEWIRE_RMT_RX_CAPACITY, &rx_count);
+        if (!ok) {
+            stats_.timeouts++;
+        }
+        if (!ok || !OneWireRmtCodec::decodeReadSlots(rx_, rx_count, data, done, chunk)) {
+            // Released bus reads as 1 — same as the bit-bang backend without a device
+            for (uint16_t i = 0; i < chunk; i++) {
+                setBit(data, done + i, true);
+            }
+            stats_.decode_errors++;
+        }
+        done += chunk;
+    }
+}
+
+void OneWireRmtTransport::depower() {
+    if (powered_) {
+        channel_.setStrongPullup(false);
+        powered_ = false;
+    }
+}
+
+void OneWireRmtTransport::delayMs(uint32_t ms) {
+    channel_.delayMs(ms);
+}
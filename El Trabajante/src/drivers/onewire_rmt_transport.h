@@ -0,0 +1,119 @@
+#ifndef DRIVERS_ONEWIRE_RMT_TRANSPORT_H
+#define DRIVERS_ONEWIRE_RMT_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hal/ionewire_hal.h"
+
+// ============================================
+// ONEWIRE RMT TRANSPORT (slots generated by the RMT peripheral)
+// ============================================
+// The bit-bang library times every reset pulse and slot in software with
+// interrupts disabled (~70 us per bit, ~5 ms CPU for one DS18B20 read on
+// Core 1, WiFi ISR latency on the single-core ESP32-C3). Here each bus
+// operation is encoded into RMT symbols (low/high durations, 1 us ticks),
+// transmitted by the TX channel on the open-drain pin while the RX channel
+// on the same pin samples the line. The CPU only encodes/decodes a chunk
+// and blocks on the driver semaphore while the hardware runs the slots.
+//
+// Codec and transport are pure logic; the hardware side is the
+// IOneWireRmtChannel (ESP32OneWireRmtChannel on target, a device model in
+// native tests).
+// ============================================
+
+// One RMT item: line driven low for low_us, then released (pulled up) for high_us
+struct OneWireRmtSymbol {
+    uint16_t low_us;
+    uint16_t high_us;
+};
+
+// Slot timing (standard speed, µs) — write/read slot total 70 µs
+static const uint16_t ONEWIRE_RMT_RESET_LOW_US = 480;
+static const uint16_t ONEWIRE_RMT_RESET_HIGH_US = 70;       // Presence sample window start
+static const uint16_t ONEWIRE_RMT_WRITE1_LOW_US = 6;
+static const uint16_t ONEWIRE_RMT_WRITE1_HIGH_US = 64;
+static const uint16_t ONEWIRE_RMT_WRITE0_LOW_US = 60;
+static const uint16_t ONEWIRE_RMT_WRITE0_HIGH_US = 10;
+static const uint16_t ONEWIRE_RMT_READ_LOW_US = 6;
+static const uint16_t ONEWIRE_RMT_READ_HIGH_US = 64;
+static const uint16_t ONEWIRE_RMT_READ_SAMPLE_US = 15;      // Line low longer → device sent 0
+static const uint16_t ONEWIRE_RMT_PRESENCE_MIN_US = 30;     // Datasheet 60–240 µs, sampling margin
+static const uint16_t ONEWIRE_RMT_PRESENCE_MAX_US = 300;
+static const uint16_t ONEWIRE_RMT_RX_IDLE_US = 300;         // RX capture ends after this much high
+
+// Slots per transfer: one RX capture must fit an RMT memory block
+// (48 items on ESP32-C3, 64 on ESP32) including the end marker.
+static const uint8_t ONEWIRE_RMT_MAX_SLOTS = 32;
+static const uint8_t ONEWIRE_RMT_RX_CAPACITY = ONEWIRE_RMT_MAX_SLOTS + 2;
+
+// ============================================
+// RMT CHANNEL INTERFACE (hardware side)
+// ============================================
+class IOneWireRmtChannel {
+public:
+    virtual ~IOneWireRmtChannel() = default;
+
+    // Transmit tx symbols. With rx != nullptr the line is captured during the
+    // transfer (rx_count = captured symbols). Returns false on driver timeout.
+    virtual bool transfer(const OneWireRmtSymbol* tx, size_t tx_count,
+                          OneWireRmtSymbol* rx, size_t rx_capacity, size_t* rx_count) = 0;
+
+    // Drive the pin high push-pull (parasite power) / back to open drain
+    virtual void setStrongPullup(bool enabled) = 0;
+
+    virtual void delayMs(uint32_t ms) = 0;
+};
+
+// ============================================
+// CODEC
+// ============================================
+class OneWireRmtCodec {
+public:
+    static size_t encodeReset(OneWireRmtSymbol* out);
+    // Bits [first_bit, first_bit + count) of data, LSB first
+    static size_t encodeWrite(const uint8_t* data, uint16_t first_bit, uint16_t count,
+                              OneWireRmtSymbol* out);
+    static size_t encodeReadSlots(uint16_t count, OneWireRmtSymbol* out);
+
+    // Captured reset: reset low followed by a presence-length low pulse
+    static bool decodePresence(const OneWireRmtSymbol* rx, size_t rx_count);
+    // Captured read slots → bits [first_bit, first_bit + count) of data.
+    // False if fewer symbols than slots were captured.
+    static bool decodeReadSlots(const OneWireRmtSymbol* rx, size_t rx_count,
+                                uint8_t* data, uint16_t first_bit, uint16_t count);
+};
+
+// ============================================
+// TRANSPORT
+// ============================================
+struct OneWireRmtStats {
+    uint32_t transfers;          // RMT transactions (CPU setup cost unit)
+    uint32_t slots;              // Reset + bit slots generated by hardware
+    uint32_t timeouts;           // Channel transfer failures
+    uint32_t decode_errors;      // Incomplete captures (bits read as 1)
+};
+
+class OneWireRmtTransport : public IOneWireHal {
+public:
+    explicit OneWireRmtTransport(IOneWireRmtChannel& channel);
+
+    bool reset() override;
+    void writeBits(const uint8_t* data, uint16_t bit_count, bool power_after = false) override;
+    void readBits(uint8_t* data, uint16_t bit_count) override;
+    void depower() override;
+    void delayMs(uint32_t ms) override;
+    const char* getBackendName() const override { return "rmt"; }
+
+    const OneWireRmtStats& getStats() const { return stats_; }
+    void resetStats();
+
+private:
+    IOneWireRmtChannel& channel_;
+    bool powered_;
+    OneWireRmtStats stats_;
+    OneWireRmtSymbol tx_[ONEWIRE_RMT_MAX_SLOTS];
+    OneWireRmtSymbol rx_[ONEWIRE_RMT_RX_CAPACITY];
+};
+
+#endif // DRIVERS_ONEWIRE_RMT_TRANSPORT_H
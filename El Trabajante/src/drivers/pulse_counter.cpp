@@ -0,0 +1,185 @@
+#include "pulse_counter.h"
+#include "../utils/logger.h"
+
+#ifndef UNIT_TEST
+    #include "hal/esp32_pcnt_hal.h"
+#endif
+
+static const char* TAG = "PCNT";
+
+static const uint8_t PULSE_NO_GPIO = 255;
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+#ifndef UNIT_TEST
+static ESP32PcntHal s_production_pcnt_hal;
+#endif
+
+PulseCounterManager& pulseCounter = PulseCounterManager::getInstance();
+
+PulseCounterManager& PulseCounterManager::getInstance() {
+    static PulseCounterManager instance;
+    return instance;
+}
+
+PulseCounterManager::PulseCounterManager() : hal_(nullptr) {
+    reset();
+}
+
+void PulseCounterManager::reset() {
+    hal_ = nullptr;
+    for (uint8_t i = 0; i < PULSE_COUNTER_MAX_CHANNELS; i++) {
+        channels_[i].gpio = PULSE_NO_GPIO;
+        channels_[i].hw_total = 0;
+        channels_[i].reset_base = 0;
+        channels_[i].last_sample_total = 0;
+        channels_[i].last_sample_ms = 0;
+        channels_[i].reset_requested.store(false);
+    }
+    attached_count_.store(0);
+}
+
+bool PulseCounterManager::begin(IPulseCounterHal* hal) {
+#ifndef UNIT_TEST
+    if (hal == nullptr) {
+        hal = &s_production_pcnt_hal;
+    }
+#endif
+    hal_ = hal;
+    return isAvailable();
+}
+
+// ============================================
+// CHANNELS
+// ============================================
+int PulseCounterManager::findChannel(uint8_t gpio) const {
+    for (uint8_t i = 0; i < PULSE_COUNTER_MAX_CHANNELS; i++) {
+        if (channels_[i].gpio == gpio) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool PulseCounterManager::isAttached(uint8_t gpio) const {
+    return gpio != PULSE_NO_GPIO && findChannel(gpio) >= 0;
+}
+
+bool PulseCounterManager::attach(uint8_t gpio, uint16_t filter_ns, uint32_t now_ms) {
+    if (!isAvailable()) {
+        LOG_E(TAG, "No pulse counter hardware on this chip (GPIO " + String(gpio) + ")");
+        return false;
+    }
+    if (isAttached(gpio)) {
+        return true;  // Reconfigure keeps the running total
+    }
+    int unit = findChannel(PULSE_NO_GPIO);
+    if (unit < 0 || unit >= hal_->unitCount()) {
+        LOG_E(TAG, "All pulse counter units in use (GPIO " + String(gpio) + ")");
+        return false;
+    }
+    if (filter_ns > PULSE_COUNTER_MAX_FILTER_NS) {
+        filter_ns = PULSE_COUNTER_MAX_FILTER_NS;
+    }
+    if (!hal_->attach(static_cast<uint8_t>(unit), gpio, filter_ns)) {
+        LOG_E(TAG, "Pulse counter unit " + String(unit) + " setup failed (GPIO " + String(gpio) + ")");
+        return false;
+    }
+
+    Channel& channel = channels_[unit];
+    channel.gpio = gpio;
+    channel.hw_total = 0;
+    channel.reset_base = 0;
+    channel.last_sample_total = 0;
+    channel.last_sample_ms = now_ms;
+    channel.reset_requested.store(false);
+    attached_count_.fetch_add(1, std::memory_order_relaxed);
+    LOG_I(TAG, "GPIO " + String(gpio) + " counting on unit " + String(unit) +
+               " (filter " + String(filter_ns) + " ns)");
+    return true;
+}
+
+void PulseCounterManager::detach(uint8_t gpio) {
+    int unit = gpio != PULSE_NO_GPIO ? findChannel(gpio) : -1;
+    if (unit < 0) {
+        return;
+    }
+    hal_->detach(static_cast<uint8_t>(unit));
+    channels_[unit].gpio = PULSE_NO_GPIO;
+    attached_count_.fetch_sub(1, std::memory_order_relaxed);
+    LOG_I(TAG, "GPIO " + String(gpio) + " released from unit " + String(unit));
+}
+
+// ============================================
+// SAMPLING
+// ============================================
+bool PulseCounterManager::readHardwareTotal(uint8_t unit, Channel& channel) {
+    uint32_t wraps = 0;
+    uint16_t count = 0;
+    if (!hal_->read(unit, wraps, count)) {
+        return false;
+    }
+    uint64_t total = static_cast<uint64_t>(wraps) * PULSE_COUNTER_HW_LIMIT + count;
+    // Pending wrap interrupt: counter already back at 0, wrap not counted yet
+    if (total > channel.hw_total) {
+        channel.hw_total = total;
+    }
+    return true;
+}
+
+bool PulseCounterManager::sample(uint8_t gpio, uint32_t now_ms, PulseSample& out) {
+    int unit = gpio != PULSE_NO_GPIO ? findChannel(gpio) : -1;
+    if (unit < 0) {
+        return false;
+    }
+    Channel& channel = channels_[unit];
+    if (!readHardwareTotal(static_cast<uint8_t>(unit), channel)) {
+        return false;
+    }
+
+    uint64_t total = channel.hw_total - channel.reset_base;
+    uint64_t delta = total - channel.last_sample_total;
+    out.total_pulses = total;
+    out.delta_pulses = delta > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(delta);
+    out.elapsed_ms = now_ms - channel.last_sample_ms;
+
+    if (channel.reset_requested.exchange(false)) {
+        // Pulses of this interval still count for the rate, the total restarts
+        channel.reset_base = channel.hw_total;
+        total = 0;
+        out.total_pulses = 0;
+    }
+    channel.last_sample_total = total;
+    channel.last_sample_ms = now_ms;
+    return true;
+}
+
+bool PulseCounterManager::resetTotal(uint8_t gpio) {
+    int unit = gpio != PULSE_NO_GPIO ? findChannel(gpio) : -1;
+    if (unit < 0) {
+        return false;
+    }
+    channels_[unit].reset_requested.store(true);
+    return true;
+}
+
+// ============================================
+// CALIBRATION
+// ============================================
+float PulseCounterManager::pulsesToUnits(uint64_t pulses, float pulses_per_unit) {
+    if (pulses_per_unit <= 0.0f) {
+        return static_cast<float>(pulses);
+    }
+    return static_cast<float>(static_cast<double>(pulses) / pulses_per_unit);
+}
+
+float PulseCounterManager::computeRate(uint32_t delta_pulses, uint32_t elapsed_ms,
+                                       float pulses_per_unit, uint32_t rate_period_ms) {
+    if (elapsed_ms == 0) {
+        return 0.0f;
+    }
+    double units = pulses_per_unit > 0.0f ? delta_pulses / static_cast<double>(pulses_per_unit)
+                                          : static_cast<double>(delta_pulses);
+    return static_cast<float>(units * rate_period_ms / elapsed_ms);
+}
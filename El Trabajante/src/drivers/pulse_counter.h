@@ -0,0 +1,88 @@
+#ifndef DRIVERS_PULSE_COUNTER_H
+#define DRIVERS_PULSE_COUNTER_H
+
+#include <stdint.h>
+#include <atomic>
+#include "hal/ipulse_counter_hal.h"
+
+// ============================================
+// PULSE COUNTER (flow meters, rain gauges)
+// ============================================
+// Hall-effect flow meters deliver hundreds of pulses per second; counting
+// them with GPIO interrupts would cost an ISR per pulse on Core 1. The PCNT
+// peripheral counts in hardware and interrupts once per 32767 pulses.
+//
+// 64-bit totals: hardware wraps × PULSE_COUNTER_HW_LIMIT + counter value.
+// A wrap whose interrupt has not run yet looks like a step backwards; the
+// total is held until the wrap is counted, so it never decreases.
+//
+// sample() returns the pulses since the previous sample and the elapsed
+// time → rate over the measurement interval. resetTotal() may be called
+// from any task; the reset is applied by the next sample() (Safety-Task).
+//
+// Glitch filter: PCNT ignores pulses shorter than filter_ns (max 12.8 µs).
+// Reed-switch rain gauges bounce for milliseconds and need an RC filter.
+// ============================================
+
+static const uint8_t PULSE_COUNTER_MAX_CHANNELS = 8;         // ESP32: 8 PCNT units
+static const uint16_t PULSE_COUNTER_DEFAULT_FILTER_NS = 1000; // Hall sensors: clean edges
+
+struct PulseSample {
+    uint64_t total_pulses;    // Since attach / last reset
+    uint32_t delta_pulses;    // Since the previous sample
+    uint32_t elapsed_ms;      // Since the previous sample
+};
+
+class PulseCounterManager {
+public:
+    static PulseCounterManager& getInstance();
+
+    // Production: hal == nullptr → ESP32PcntHal. Tests inject a mock.
+    bool begin(IPulseCounterHal* hal = nullptr);
+
+    bool attach(uint8_t gpio, uint16_t filter_ns, uint32_t now_ms);
+    void detach(uint8_t gpio);
+    bool isAttached(uint8_t gpio) const;
+    uint8_t getAttachedCount() const { return attached_count_.load(std::memory_order_relaxed); }
+    bool isAvailable() const { return hal_ != nullptr && hal_->unitCount() > 0; }
+
+    // Safety-Task: pulses since the previous sample
+    bool sample(uint8_t gpio, uint32_t now_ms, PulseSample& out);
+
+    // Any task: total restarts at 0 with the next sample()
+    bool resetTotal(uint8_t gpio);
+
+    // Calibration helpers (pulses_per_unit <= 0 → raw pulses)
+    static float pulsesToUnits(uint64_t pulses, float pulses_per_unit);
+    // Units per rate_period_ms (e.g. 60000 → L/min)
+    static float computeRate(uint32_t delta_pulses, uint32_t elapsed_ms,
+                             float pulses_per_unit, uint32_t rate_period_ms);
+
+    // Test helper: back to power-on state
+    void reset();
+
+private:
+    PulseCounterManager();
+    PulseCounterManager(const PulseCounterManager&) = delete;
+    PulseCounterManager& operator=(const PulseCounterManager&) = delete;
+
+    struct Channel {
+        uint8_t gpio;                        // 255 = unit free
+        uint64_t hw_total;                   // Monotonic hardware total
+        uint64_t reset_base;                 // hw_total at the last reset
+        uint64_t last_sample_total;          // total_pulses at the previous sample
+        uint32_t last_sample_ms;
+        std::atomic<bool> reset_requested;
+    };
+
+    int findChannel(uint8_t gpio) const;
+    bool readHardwareTotal(uint8_t unit, Channel& channel);
+
+    IPulseCounterHal* hal_;
+    Channel channels_[PULSE_COUNTER_MAX_CHANNELS];
+    std::atomic<uint8_t> attached_count_;
+};
+
+extern PulseCounterManager& pulseCounter;
+
+#endif
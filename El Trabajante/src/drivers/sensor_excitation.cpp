@@ -0,0 +1,279 @@
+#include "sensor_excitation.h"
+#include "gpio_manager.h"
+#include "../utils/logger.h"
+
+static const char* TAG = "EXC";
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+SensorExcitationManager& sensorExcitation = SensorExcitationManager::getInstance();
+
+SensorExcitationManager& SensorExcitationManager::getInstance() {
+    static SensorExcitationManager instance;
+    return instance;
+}
+
+SensorExcitationManager::SensorExcitationManager() {
+    reset();
+}
+
+void SensorExcitationManager::reset() {
+    for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+        bindings_[i].sensor_gpio = SENSOR_EXCITATION_NO_GPIO;
+        bindings_[i].excitation_gpio = SENSOR_EXCITATION_NO_GPIO;
+        bindings_[i].settle_ms = 0;
+        bindings_[i].active_high = true;
+        bindings_[i].waiting = false;
+        bindings_[i].ready_at_ms = 0;
+        on_pins_[i] = SENSOR_EXCITATION_NO_GPIO;
+        on_since_ms_[i] = 0;
+    }
+}
+
+// ============================================
+// LOOKUP
+// ============================================
+int SensorExcitationManager::findBinding(uint8_t sensor_gpio) const {
+    if (sensor_gpio == SENSOR_EXCITATION_NO_GPIO) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+        if (bindings_[i].sensor_gpio == sensor_gpio) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool SensorExcitationManager::isPinShared(uint8_t excitation_gpio, int except_index) const {
+    for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+        if (static_cast<int>(i) != except_index && bindings_[i].sensor_gpio != SENSOR_EXCITATION_NO_GPIO &&
+            bindings_[i].excitation_gpio == excitation_gpio) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SensorExcitationManager::hasWaiter(uint8_t excitation_gpio, int except_index) const {
+    for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+        if (static_cast<int>(i) != except_index && bindings_[i].sensor_gpio != SENSOR_EXCITATION_NO_GPIO &&
+            bindings_[i].excitation_gpio == excitation_gpio && bindings_[i].waiting) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SensorExcitationManager::findPinOnSince(uint8_t excitation_gpio, uint32_t& on_since_ms) const {
+    for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+        if (on_pins_[i] == excitation_gpio) {
+            on_since_ms = on_since_ms_[i];
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool SensorExcitationManager::hasExcitation(uint8_t sensor_gpio) const {
+    return findBinding(sensor_gpio) >= 0;
+}
+
+uint8_t SensorExcitationManager::getAttachedCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+        if (bindings_[i].sensor_gpio != SENSOR_EXCITATION_NO_GPIO) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool SensorExcitationManager::isExcitationOn(uint8_t excitation_gpio) const {
+    uint32_t since = 0;
+    return excitation_gpio != SENSOR_EXCITATION_NO_GPIO && findPinOnSince(excitation_gpio, since) >= 0;
+}
+
+// ============================================
+// ATTACH / DETACH
+// ============================================
+bool SensorExcitationManager::attach(uint8_t sensor_gpio, uint8_t excitation_gpio, uint16_t settle_ms,
+                                     bool active_high) {
+    if (excitation_gpio == SENSOR_EXCITATION_NO_GPIO || excitation_gpio == sensor_gpio) {
+        LOG_E(TAG, "GPIO " + String(excitation_gpio) + " invalid as excitation for sensor GPIO " +
+                   String(sensor_gpio));
+        return false;
+    }
+    if (settle_ms > SENSOR_EXCITATION_MAX_SETTLE_MS) {
+        settle_ms = SENSOR_EXCITATION_MAX_SETTLE_MS;
+    }
+
+    int index = findBinding(sensor_gpio);
+    if (index >= 0 && bindings_[index].excitation_gpio != excitation_gpio) {
+        detach(sensor_gpio);  // Moved to another excitation pin
+        index = -1;
+    }
+    if (index < 0) {
+        for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS && index < 0; i++) {
+            if (bindings_[i].sensor_gpio == SENSOR_EXCITATION_NO_GPIO) {
+                index = i;
+            }
+        }
+        if (index < 0) {
+            LOG_E(TAG, "All excitation bindings in use (sensor GPIO " + String(sensor_gpio) + ")");
+            return false;
+        }
+    }
+
+    // Shared pin: one polarity per pin
+    for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+        if (static_cast<int>(i) != index && bindings_[i].sensor_gpio != SENSOR_EXCITATION_NO_GPIO &&
+            bindings_[i].excitation_gpio == excitation_gpio && bindings_[i].active_high != active_high) {
+            LOG_E(TAG, "Excitation GPIO " + String(excitation_gpio) + " shared with different polarity");
+            return false;
+        }
+    }
+
+    bool first_user = !isPinShared(excitation_gpio, -1);
+    if (first_user) {
+        if (!gpioManager.requestPin(excitation_gpio, "sensor", "excitation")) {
+            LOG_E(TAG, "Excitation GPIO " + String(excitation_gpio) + " not available");
+            return false;
+        }
+        if (!gpioManager.configurePinMode(excitation_gpio, OUTPUT)) {
+            gpioManager.releasePin(excitation_gpio);
+            return false;
+        }
+        gpioManager.writePin(excitation_gpio, !active_high);  // OFF until the first measurement
+    }
+
+    Binding& binding = bindings_[index];
+    if (binding.sensor_gpio == SENSOR_EXCITATION_NO_GPIO) {
+        binding.waiting = false;
+        binding.ready_at_ms = 0;
+    }
+    binding.sensor_gpio = sensor_gpio;
+    binding.excitation_gpio = excitation_gpio;
+    binding.settle_ms = settle_ms;
+    binding.active_high = active_high;
+    LOG_I(TAG, "Sensor GPIO " + String(sensor_gpio) + " excited via GPIO " + String(excitation_gpio) +
+               " (settle " + String(settle_ms) + " ms, active " + String(active_high ? "HIGH" : "LOW") + ")");
+    return true;
+}
+
+void SensorExcitationManager::detach(uint8_t sensor_gpio) {
+    int index = findBinding(sensor_gpio);
+    if (index < 0) {
+        return;
+    }
+    Binding& binding = bindings_[index];
+    uint8_t excitation_gpio = binding.excitation_gpio;
+    if (isExcitationOn(excitation_gpio) && !hasWaiter(excitation_gpio, index)) {
+        switchPin(binding, false, 0);
+    }
+    if (!isPinShared(excitation_gpio, index)) {
+        gpioManager.releasePin(excitation_gpio);
+    }
+    binding.sensor_gpio = SENSOR_EXCITATION_NO_GPIO;
+    binding.excitation_gpio = SENSOR_EXCITATION_NO_GPIO;
+    binding.waiting = false;
+    LOG_I(TAG, "Sensor GPIO " + String(sensor_gpio) + " excitation removed");
+}
+
+// ============================================
+// MEASUREMENT SEQUENCE
+// ============================================
+void SensorExcitationManager::switchPin(const Binding& binding, bool on, uint32_t now_ms) {
+    gpioManager.writePin(binding.excitation_gpio, on == binding.active_high);
+    uint32_t since = 0;
+    int slot = findPinOnSince(binding.excitation_gpio, since);
+    if (!on) {
+        if (slot >= 0) {
+            on_pins_[slot] = SENSOR_EXCITATION_NO_GPIO;
+        }
+        return;
+    }
+    if (slot < 0) {
+        for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+            if (on_pins_[i] == SENSOR_EXCITATION_NO_GPIO) {
+                on_pins_[i] = binding.excitation_gpio;
+                on_since_ms_[i] = now_ms;
+                break;
+            }
+        }
+    }
+}
+
+uint32_t SensorExcitationManager::prepare(uint8_t sensor_gpio, uint32_t now_ms, uint32_t extra_ms) {
+    int index = findBinding(sensor_gpio);
+    if (index < 0) {
+        return 0;  // No excitation configured
+    }
+    Binding& binding = bindings_[index];
+    uint32_t on_since = now_ms;
+    if (findPinOnSince(binding.excitation_gpio, on_since) < 0) {
+        switchPin(binding, true, now_ms);
+        on_since = now_ms;
+    }
+    binding.waiting = true;
+    binding.ready_at_ms = on_since + binding.settle_ms + extra_ms;
+    int32_t remaining = static_cast<int32_t>(binding.ready_at_ms - now_ms);
+    return remaining > 0 ? static_cast<uint32_t>(remaining) : 0;
+}
+
+uint32_t SensorExcitationManager::getMsUntilReady(uint8_t sensor_gpio, uint32_t now_ms) const {
+    int index = findBinding(sensor_gpio);
+    if (index < 0 || !bindings_[index].waiting) {
+        return UINT32_MAX;
+    }
+    int32_t remaining = static_cast<int32_t>(bindings_[index].ready_at_ms - now_ms);
+    return remaining > 0 ? static_cast<uint32_t>(remaining) : 0;
+}
+
+uint32_t SensorExcitationManager::getReadyAtMs(uint8_t sensor_gpio) const {
+    int index = findBinding(sensor_gpio);
+    return index >= 0 ? bindings_[index].ready_at_ms : 0;
+}
+
+void SensorExcitationManager::release(uint8_t sensor_gpio) {
+    int index = findBinding(sensor_gpio);
+    if (index < 0) {
+        return;
+    }
+    Binding& binding = bindings_[index];
+    binding.waiting = false;
+    if (!hasWaiter(binding.excitation_gpio, index)) {
+        switchPin(binding, false, 0);
+    }
+}
+
+void SensorExcitationManager::expire(uint32_t now_ms) {
+    for (uint8_t p = 0; p < SENSOR_EXCITATION_MAX_SENSORS; p++) {
+        uint8_t excitation_gpio = on_pins_[p];
+        if (excitation_gpio == SENSOR_EXCITATION_NO_GPIO) {
+            continue;
+        }
+        int any_binding = -1;
+        bool keep = false;
+        for (uint8_t i = 0; i < SENSOR_EXCITATION_MAX_SENSORS; i++) {
+            Binding& binding = bindings_[i];
+            if (binding.sensor_gpio == SENSOR_EXCITATION_NO_GPIO || binding.excitation_gpio != excitation_gpio) {
+                continue;
+            }
+            any_binding = i;
+            if (!binding.waiting) {
+                continue;
+            }
+            if (static_cast<int32_t>(now_ms - binding.ready_at_ms) < static_cast<int32_t>(SENSOR_EXCITATION_MAX_HOLD_MS)) {
+                keep = true;
+            } else {
+                binding.waiting = false;  // Never measured → give up this cycle
+            }
+        }
+        if (!keep && any_binding >= 0) {
+            LOG_W(TAG, "Excitation GPIO " + String(excitation_gpio) + " held without measurement - OFF");
+            switchPin(bindings_[any_binding], false, now_ms);
+        }
+    }
+}
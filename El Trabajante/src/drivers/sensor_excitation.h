@@ -0,0 +1,93 @@
+#ifndef DRIVERS_SENSOR_EXCITATION_H
+#define DRIVERS_SENSOR_EXCITATION_H
+
+#include <stdint.h>
+
+// ============================================
+// SENSOR EXCITATION (switched probe supply)
+// ============================================
+// Resistive / capacitive moisture probes and EC probes corrode under
+// continuous excitation (electrolysis) and draw constant current. An
+// optional excitation GPIO per sensor powers the probe only around a
+// measurement:
+//
+//   prepare()  → pin ON, returns ms until the probe has settled (0 = ready)
+//   ...          scheduler measures other sensors meanwhile (no delay);
+//                manual reads are parked in the sensor command queue
+//   prepare()  → 0 → read
+//   release()  → pin OFF (once no other sensor on the pin is waiting)
+//
+// Several probes may share one excitation pin (reference counted). Pins are
+// owned through GPIOManager ("sensor"); a pin held by anything else is
+// rejected. A pin left ON without a measurement (sensor paused, removed,
+// budget-split pass) is switched off by expire() after
+// settle + SENSOR_EXCITATION_MAX_HOLD_MS.
+//
+// Threading: Safety-Task only (configure + measure path, g_sensor_mutex).
+// ============================================
+
+static const uint8_t SENSOR_EXCITATION_MAX_SENSORS = 8;
+static const uint8_t SENSOR_EXCITATION_NO_GPIO = 255;
+static const uint16_t SENSOR_EXCITATION_DEFAULT_SETTLE_MS = 100;
+static const uint16_t SENSOR_EXCITATION_MAX_SETTLE_MS = 10000;
+static const uint32_t SENSOR_EXCITATION_MAX_HOLD_MS = 2000;   // ON past settle without a read
+
+class SensorExcitationManager {
+public:
+    static SensorExcitationManager& getInstance();
+
+    // Bind sensor_gpio to an excitation pin. Requests + configures the pin
+    // (OUTPUT, OFF) on first use; re-attach updates settle time / polarity.
+    bool attach(uint8_t sensor_gpio, uint8_t excitation_gpio, uint16_t settle_ms, bool active_high);
+    // Unbind; the pin is switched off and released with its last sensor
+    void detach(uint8_t sensor_gpio);
+    bool hasExcitation(uint8_t sensor_gpio) const;
+    uint8_t getAttachedCount() const;
+
+    // Switch on (if needed). extra_ms extends the settle time for this read
+    // (e.g. one ADC window). Returns ms until ready, 0 = ready / no excitation.
+    uint32_t prepare(uint8_t sensor_gpio, uint32_t now_ms, uint32_t extra_ms = 0);
+    // Remaining settle time without switching (UINT32_MAX: not prepared)
+    uint32_t getMsUntilReady(uint8_t sensor_gpio, uint32_t now_ms) const;
+    // millis() when the probe settled (valid once prepare() returned 0)
+    uint32_t getReadyAtMs(uint8_t sensor_gpio) const;
+    // Measurement done: OFF unless another sensor on the pin is waiting
+    void release(uint8_t sensor_gpio);
+
+    // Safety net: switch off pins held past settle + SENSOR_EXCITATION_MAX_HOLD_MS
+    void expire(uint32_t now_ms);
+
+    bool isExcitationOn(uint8_t excitation_gpio) const;
+
+    // Test helper: back to power-on state (no pin release)
+    void reset();
+
+private:
+    SensorExcitationManager();
+    SensorExcitationManager(const SensorExcitationManager&) = delete;
+    SensorExcitationManager& operator=(const SensorExcitationManager&) = delete;
+
+    struct Binding {
+        uint8_t sensor_gpio;        // SENSOR_EXCITATION_NO_GPIO = free
+        uint8_t excitation_gpio;
+        uint16_t settle_ms;
+        bool active_high;
+        bool waiting;               // prepare() called, release() pending
+        uint32_t ready_at_ms;       // Valid while waiting
+    };
+
+    int findBinding(uint8_t sensor_gpio) const;
+    bool isPinShared(uint8_t excitation_gpio, int except_index) const;
+    bool hasWaiter(uint8_t excitation_gpio, int except_index) const;
+    int findPinOnSince(uint8_t excitation_gpio, uint32_t& on_since_ms) const;
+    void switchPin(const Binding& binding, bool on, uint32_t now_ms);
+
+    Binding bindings_[SENSOR_EXCITATION_MAX_SENSORS];
+    // Per excitation pin: ON state + switch-on time (pins are few → linear table)
+    uint8_t on_pins_[SENSOR_EXCITATION_MAX_SENSORS];
+    uint32_t on_since_ms_[SENSOR_EXCITATION_MAX_SENSORS];
+};
+
+extern SensorExcitationManager& sensorExcitation;
+
+#endif
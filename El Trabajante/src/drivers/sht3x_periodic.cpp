@@ -0,0 +1,239 @@
+#include "sht3x_periodic.h"
+
+#include <string.h>
+
+// ============================================
+// CONSTRUCTION / LOOKUP
+// ============================================
+Sht3xPeriodicManager::Sht3xPeriodicManager()
+    : fetches_(0)
+    , single_shots_(0)
+    , rearms_(0)
+    , fallbacks_(0) {
+    memset(devices_, 0, sizeof(devices_));
+}
+
+Sht3xPeriodicManager::DeviceState* Sht3xPeriodicManager::find(uint8_t address) {
+    for (uint8_t i = 0; i < SHT3X_MAX_DEVICES; i++) {
+        if (devices_[i].in_use && devices_[i].address == address) {
+            return &devices_[i];
+        }
+    }
+    return nullptr;
+}
+
+const Sht3xPeriodicManager::DeviceState* Sht3xPeriodicManager::find(uint8_t address) const {
+    for (uint8_t i = 0; i < SHT3X_MAX_DEVICES; i++) {
+        if (devices_[i].in_use && devices_[i].address == address) {
+            return &devices_[i];
+        }
+    }
+    return nullptr;
+}
+
+bool Sht3xPeriodicManager::isManaged(uint8_t address) const {
+    return find(address) != nullptr;
+}
+
+bool Sht3xPeriodicManager::isPeriodic(uint8_t address) const {
+    const DeviceState* dev = find(address);
+    return dev != nullptr && dev->mode == Sht3xMode::PERIODIC;
+}
+
+// ============================================
+// RATE SELECTION
+// ============================================
+uint16_t Sht3xPeriodicManager::selectPeriodicCommand(uint32_t interval_ms) {
+    // Period <= interval / 2 → a fresh result is always waiting at fetch time
+    if (interval_ms >= 4000) return SHT3X_CMD_PERIODIC_0_5_MPS;
+    if (interval_ms >= 2000) return SHT3X_CMD_PERIODIC_1_MPS;
+    if (interval_ms >= 1000) return SHT3X_CMD_PERIODIC_2_MPS;
+    if (interval_ms >= 500)  return SHT3X_CMD_PERIODIC_4_MPS;
+    return SHT3X_CMD_PERIODIC_10_MPS;
+}
+
+uint32_t Sht3xPeriodicManager::periodMsForCommand(uint16_t command) {
+    switch (command) {
+        case SHT3X_CMD_PERIODIC_0_5_MPS: return 2000;
+        case SHT3X_CMD_PERIODIC_1_MPS:   return 1000;
+        case SHT3X_CMD_PERIODIC_2_MPS:   return 500;
+        case SHT3X_CMD_PERIODIC_4_MPS:   return 250;
+        case SHT3X_CMD_PERIODIC_10_MPS:  return 100;
+        default:                         return 0;
+    }
+}
+
+// ============================================
+// COMMAND SEQUENCES
+// ============================================
+uint8_t Sht3xPeriodicManager::sendCommand(II2CHal& hal, uint8_t address, uint16_t command) {
+    uint8_t bytes[2] = {static_cast<uint8_t>(command >> 8), static_cast<uint8_t>(command & 0xFF)};
+    return hal.write(address, bytes, sizeof(bytes));
+}
+
+static Sht3xReadResult classifyWireError(uint8_t error) {
+    return (error == 4 || error == 5) ? Sht3xReadResult::BUS_ERROR : Sht3xReadResult::NACK;
+}
+
+bool Sht3xPeriodicManager::startPeriodic(II2CHal& hal, DeviceState& dev,
+                                         uint32_t now_ms, uint32_t bus_generation) {
+    if (sendCommand(hal, dev.address, dev.periodic_command) != 0) {
+        enterFallback(hal, dev, now_ms);
+        return false;
+    }
+    dev.mode = Sht3xMode::PERIODIC;
+    dev.armed_ms = now_ms;
+    dev.bus_generation = bus_generation;
+    dev.rearm_pending = false;
+    return true;
+}
+
+void Sht3xPeriodicManager::enterFallback(II2CHal& hal, DeviceState& dev, uint32_t now_ms) {
+    if (dev.mode == Sht3xMode::PERIODIC) {
+        // Sensor ignores single-shot commands while periodic mode is running
+        sendCommand(hal, dev.address, SHT3X_CMD_BREAK);
+        hal.delayMs(SHT3X_BREAK_WAIT_MS);
+        fallbacks_++;
+    }
+    dev.mode = Sht3xMode::SINGLE_SHOT_FALLBACK;
+    dev.fallback_since_ms = now_ms;
+    dev.rearm_pending = false;
+    dev.consecutive_errors = 0;
+}
+
+Sht3xReadResult Sht3xPeriodicManager::singleShot(II2CHal& hal, DeviceState& dev, uint8_t* buffer) {
+    uint8_t error = sendCommand(hal, dev.address, SHT3X_CMD_SINGLE_SHOT_HIGH);
+    if (error != 0) {
+        return classifyWireError(error);
+    }
+    hal.delayMs(SHT3X_SINGLE_SHOT_WAIT_MS);
+    if (hal.read(dev.address, buffer, SHT3X_RESPONSE_BYTES) != SHT3X_RESPONSE_BYTES) {
+        return Sht3xReadResult::NACK;
+    }
+    single_shots_++;
+    return Sht3xReadResult::OK;
+}
+
+Sht3xReadResult Sht3xPeriodicManager::fetch(II2CHal& hal, DeviceState& dev, uint8_t* buffer) {
+    uint8_t error = sendCommand(hal, dev.address, SHT3X_CMD_FETCH_DATA);
+    if (error != 0) {
+        return classifyWireError(error);
+    }
+    // No conversion wait: the result was measured in the background
+    if (hal.read(dev.address, buffer, SHT3X_RESPONSE_BYTES) != SHT3X_RESPONSE_BYTES) {
+        return Sht3xReadResult::NACK;
+    }
+    fetches_++;
+    return Sht3xReadResult::OK;
+}
+
+Sht3xReadResult Sht3xPeriodicManager::recordFailure(II2CHal& hal, DeviceState& dev,
+                                                    Sht3xReadResult result, uint32_t now_ms) {
+    dev.consecutive_errors++;
+    if (result == Sht3xReadResult::NACK) {
+        // No data after warm-up → sensor fell back to idle (reset / brown-out)
+        dev.rearm_pending = true;
+    }
+    // BUS_ERROR: caller runs recovery; the new bus generation triggers the re-arm
+    if (dev.consecutive_errors >= SHT3X_MAX_PERIODIC_ERRORS) {
+        enterFallback(hal, dev, now_ms);
+    }
+    return result;
+}
+
+// ============================================
+// PUBLIC API
+// ============================================
+bool Sht3xPeriodicManager::arm(II2CHal& hal, uint8_t address, uint32_t interval_ms,
+                               uint32_t now_ms, uint32_t bus_generation) {
+    uint16_t command = selectPeriodicCommand(interval_ms);
+    DeviceState* dev = find(address);
+
+    if (dev != nullptr) {
+        if (dev->periodic_command == command) {
+            return dev->mode == Sht3xMode::PERIODIC;
+        }
+        dev->periodic_command = command;
+        if (dev->mode != Sht3xMode::PERIODIC) {
+            return false;  // Rate is applied when the fallback re-arms
+        }
+        sendCommand(hal, address, SHT3X_CMD_BREAK);
+        hal.delayMs(SHT3X_BREAK_WAIT_MS);
+        return startPeriodic(hal, *dev, now_ms, bus_generation);
+    }
+
+    for (uint8_t i = 0; i < SHT3X_MAX_DEVICES && dev == nullptr; i++) {
+        if (!devices_[i].in_use) {
+            dev = &devices_[i];
+        }
+    }
+    if (dev == nullptr) {
+        return false;
+    }
+    memset(dev, 0, sizeof(*dev));
+    dev->in_use = true;
+    dev->address = address;
+    dev->periodic_command = command;
+    dev->mode = Sht3xMode::SINGLE_SHOT_FALLBACK;  // Until startPeriodic() succeeds
+
+    // Warm reboot: the sensor keeps running the previous boot's periodic mode
+    sendCommand(hal, address, SHT3X_CMD_BREAK);
+    hal.delayMs(SHT3X_BREAK_WAIT_MS);
+    return startPeriodic(hal, *dev, now_ms, bus_generation);
+}
+
+void Sht3xPeriodicManager::release(II2CHal& hal, uint8_t address) {
+    DeviceState* dev = find(address);
+    if (dev == nullptr) {
+        return;
+    }
+    if (dev->mode == Sht3xMode::PERIODIC) {
+        sendCommand(hal, address, SHT3X_CMD_BREAK);
+    }
+    dev->in_use = false;
+}
+
+Sht3xReadResult Sht3xPeriodicManager::read(II2CHal& hal, uint8_t address,
+                                           uint8_t* buffer, size_t buffer_size,
+                                           uint32_t now_ms, uint32_t bus_generation) {
+    DeviceState* dev = find(address);
+    if (dev == nullptr || buffer == nullptr || buffer_size < SHT3X_RESPONSE_BYTES) {
+        return Sht3xReadResult::NACK;
+    }
+
+    if (dev->mode == Sht3xMode::PERIODIC && dev->bus_generation != bus_generation) {
+        dev->rearm_pending = true;  // Bus recovery since arming
+    }
+    if (dev->mode == Sht3xMode::SINGLE_SHOT_FALLBACK &&
+        now_ms - dev->fallback_since_ms >= SHT3X_FALLBACK_REARM_MS) {
+        dev->rearm_pending = true;
+    }
+
+    // ---- Re-arm / fallback: serve this reading by single shot ----
+    if (dev->rearm_pending || dev->mode == Sht3xMode::SINGLE_SHOT_FALLBACK) {
+        if (dev->rearm_pending) {
+            sendCommand(hal, address, SHT3X_CMD_BREAK);
+            hal.delayMs(SHT3X_BREAK_WAIT_MS);
+        }
+        Sht3xReadResult result = singleShot(hal, *dev, buffer);
+        if (result != Sht3xReadResult::OK) {
+            return result;  // rearm_pending stays set → next read tries again
+        }
+        if (dev->rearm_pending && startPeriodic(hal, *dev, now_ms, bus_generation)) {
+            rearms_++;
+        }
+        return result;
+    }
+
+    // ---- Periodic: fetch only ----
+    uint32_t first_result_ms = periodMsForCommand(dev->periodic_command) + SHT3X_MEASUREMENT_MS;
+    if (now_ms - dev->armed_ms < first_result_ms) {
+        return Sht3xReadResult::NOT_READY;
+    }
+    Sht3xReadResult result = fetch(hal, *dev, buffer);
+    if (result == Sht3xReadResult::OK) {
+        dev->consecutive_errors = 0;
+        return result;
+    }
+    return recordFailure(hal, *dev, result, now_ms);
+}
@@ -0,0 +1,120 @@
+#ifndef DRIVERS_SHT3X_PERIODIC_H
+#define DRIVERS_SHT3X_PERIODIC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal/ii2c_hal.h"
+
+// ============================================
+// SHT3x PERIODIC ACQUISITION MODE
+// ============================================
+// Single-shot (0x2400) costs 20 ms of blocking conversion wait per reading,
+// spent while holding g_i2c_mutex. In periodic mode the sensor measures on
+// its own; a reading is one fetch-data command (0xE000) + 6-byte read, i.e.
+// only the raw transfer time on the bus.
+//
+// Rate: slowest mps whose period is <= interval / 2, so every read finds a
+// fresh result despite loop jitter (the sensor NACKs the read header when no
+// new data is available).
+//
+// Re-arm: after an I2C bus recovery (bus generation changed), after a fetch
+// NACK (sensor reset / brown-out puts it back into idle) and when leaving the
+// single-shot fallback. A re-arming read is served by break + single shot,
+// then periodic mode is restarted — no reading is lost.
+//
+// Fallback: SHT3X_MAX_PERIODIC_ERRORS consecutive fetch failures → single
+// shot for SHT3X_FALLBACK_REARM_MS, then periodic mode is tried again.
+//
+// Reference: Sensirion SHT3x-DIS Datasheet Version 6, March 2020 (4.5–4.8)
+// ============================================
+
+static const uint16_t SHT3X_CMD_SINGLE_SHOT_HIGH = 0x2400;  // No clock stretching
+static const uint16_t SHT3X_CMD_FETCH_DATA       = 0xE000;
+static const uint16_t SHT3X_CMD_BREAK            = 0x3093;  // Stop periodic mode
+static const uint16_t SHT3X_CMD_PERIODIC_0_5_MPS = 0x2032;  // High repeatability
+static const uint16_t SHT3X_CMD_PERIODIC_1_MPS   = 0x2130;
+static const uint16_t SHT3X_CMD_PERIODIC_2_MPS   = 0x2236;
+static const uint16_t SHT3X_CMD_PERIODIC_4_MPS   = 0x2334;
+static const uint16_t SHT3X_CMD_PERIODIC_10_MPS  = 0x2737;
+
+static const uint8_t SHT3X_RESPONSE_BYTES = 6;            // T(2)+CRC, RH(2)+CRC
+static const uint32_t SHT3X_SINGLE_SHOT_WAIT_MS = 20;     // 15.5 ms max + margin
+static const uint32_t SHT3X_MEASUREMENT_MS = 16;          // First periodic result: period + this
+static const uint32_t SHT3X_BREAK_WAIT_MS = 1;
+static const uint8_t SHT3X_MAX_DEVICES = 2;               // ADDR pin: 0x44 / 0x45
+static const uint8_t SHT3X_MAX_PERIODIC_ERRORS = 3;
+static const uint32_t SHT3X_FALLBACK_REARM_MS = 300000;   // 5 min single-shot before retry
+
+enum class Sht3xReadResult : uint8_t {
+    OK = 0,
+    NOT_READY,   // Periodic mode armed < one period ago — no data yet (not an error)
+    NACK,        // Device did not acknowledge (reset, missing)
+    BUS_ERROR    // Wire code 4/5 — caller should run bus recovery
+};
+
+enum class Sht3xMode : uint8_t {
+    PERIODIC = 0,
+    SINGLE_SHOT_FALLBACK
+};
+
+class Sht3xPeriodicManager {
+public:
+    Sht3xPeriodicManager();
+
+    // Configure (or update the rate of) periodic mode for one device.
+    // Idempotent: no bus traffic when the rate is unchanged.
+    // Returns false if the device is now in single-shot fallback.
+    bool arm(II2CHal& hal, uint8_t address, uint32_t interval_ms,
+             uint32_t now_ms, uint32_t bus_generation);
+
+    // Stop periodic mode (sensor removed) and forget the device.
+    void release(II2CHal& hal, uint8_t address);
+
+    bool isManaged(uint8_t address) const;
+    bool isPeriodic(uint8_t address) const;
+
+    // Reads SHT3X_RESPONSE_BYTES into buffer (CRC is validated by the caller).
+    Sht3xReadResult read(II2CHal& hal, uint8_t address, uint8_t* buffer, size_t buffer_size,
+                         uint32_t now_ms, uint32_t bus_generation);
+
+    static uint16_t selectPeriodicCommand(uint32_t interval_ms);
+    static uint32_t periodMsForCommand(uint16_t command);
+
+    // Diagnostics
+    uint32_t getFetchCount() const { return fetches_; }
+    uint32_t getSingleShotCount() const { return single_shots_; }
+    uint32_t getRearmCount() const { return rearms_; }
+    uint32_t getFallbackCount() const { return fallbacks_; }
+
+private:
+    struct DeviceState {
+        bool in_use;
+        uint8_t address;
+        Sht3xMode mode;
+        uint16_t periodic_command;
+        uint32_t armed_ms;
+        uint32_t fallback_since_ms;
+        uint32_t bus_generation;
+        uint8_t consecutive_errors;
+        bool rearm_pending;
+    };
+
+    DeviceState* find(uint8_t address);
+    const DeviceState* find(uint8_t address) const;
+
+    static uint8_t sendCommand(II2CHal& hal, uint8_t address, uint16_t command);
+    bool startPeriodic(II2CHal& hal, DeviceState& dev, uint32_t now_ms, uint32_t bus_generation);
+    void enterFallback(II2CHal& hal, DeviceState& dev, uint32_t now_ms);
+    Sht3xReadResult singleShot(II2CHal& hal, DeviceState& dev, uint8_t* buffer);
+    Sht3xReadResult fetch(II2CHal& hal, DeviceState& dev, uint8_t* buffer);
+    Sht3xReadResult recordFailure(II2CHal& hal, DeviceState& dev, Sht3xReadResult result,
+                                  uint32_t now_ms);
+
+    DeviceState devices_[SHT3X_MAX_DEVICES];
+    uint32_t fetches_;
+    uint32_t single_shots_;
+    uint32_t rearms_;
+    uint32_t fallbacks_;
+};
+
+#endif
@@ -1,8 +1,24 @@
 #include "error_tracker.h"
+
+#include <cstdio>
+#include <cstring>
+
 #include "../utils/logger.h"
 #include "../utils/topic_builder.h"
+#ifndef NATIVE_TEST
+#include <freertos/FreeRTOS.h>
+
 #include "../utils/time_manager.h"
 
+// Ring writes (any task, both cores) vs. snapshots in processPendingPublishes()
+static portMUX_TYPE s_error_ring_mux = portMUX_INITIALIZER_UNLOCKED;
+#define ERROR_RING_LOCK() portENTER_CRITICAL(&s_error_ring_mux)
+#define ERROR_RING_UNLOCK() portEXIT_CRITICAL(&s_error_ring_mux)
+#else
+#define ERROR_RING_LOCK()
+#define ERROR_RING_UNLOCK()
+#endif
+
 // ESP-IDF TAG convention for structured logging
 static const char* TAG = "ERRTRAK";
 
@@ -15,6 +31,11 @@ constexpr uint16_t kErrServiceBandEndExcl = 3000;
 constexpr uint16_t kErrCommunicationBandEndExcl = 4000;
 constexpr uint16_t kErrApplicationBandEndExcl = 5000;
 constexpr uint16_t kErrApplicationBandBase = 4000;
+
+// Full code inside the band passes through; small offsets are added to the base.
+uint16_t normalizeBandCode(uint16_t code, uint16_t base, uint16_t end_excl) {
+  return (code >= base && code < end_excl) ? code : static_cast<uint16_t>(base + code);
+}
 }  // namespace
 
 // ============================================
@@ -25,6 +46,7 @@ constexpr uint16_t kErrApplicationBandBase = 4000;
 struct ErrorThrottle {
   uint32_t last_publish_ms = 0;
   uint16_t suppressed_count = 0;
+  bool active = false;  // First error of a code is never throttled (also < 60 s uptime)
 };
 
 static constexpr uint8_t  THROTTLE_SLOTS = 32;
@@ -37,15 +59,15 @@ static bool shouldPublishError(uint16_t error_code) {
   uint8_t slot = error_code % THROTTLE_SLOTS;
   ErrorThrottle& t = throttle_table_[slot];
 
-  if (now - t.last_publish_ms >= THROTTLE_WINDOW_MS) {
+  if (!t.active || now - t.last_publish_ms >= THROTTLE_WINDOW_MS) {
     if (t.suppressed_count > 0) {
-      String msg = "Error " + String(error_code) + ": " +
-                   String(t.suppressed_count) + " occurrences suppressed in last " +
-                   String(THROTTLE_WINDOW_MS / 1000) + "s";
-      logger.warning(TAG, msg.c_str());
+      LOGF_W(TAG, "Error %u: %u occurrences suppressed in last %lus",
+             static_cast<unsigned>(error_code), static_cast<unsigned>(t.suppressed_count),
+             static_cast<unsigned long>(THROTTLE_WINDOW_MS / 1000));
     }
     t.last_publish_ms = now;
     t.suppressed_count = 0;
+    t.active = true;
     return true;
   }
 
@@ -53,6 +75,14 @@ static bool shouldPublishError(uint16_t error_code) {
   return false;
 }
 
+// ============================================
+// TYPED ERROR ARGUMENTS
+// ============================================
+ErrorArgs& ErrorArgs::topic(const char* topic_str) {
+  topic_class = ErrorTracker::classifyTopic(topic_str);
+  return *this;
+}
+
 // ============================================
 // GLOBAL ERROR TRACKER INSTANCE
 // ============================================
@@ -83,12 +113,17 @@ ErrorTracker::ErrorTracker()
 // INITIALIZATION (Guide-konform)
 // ============================================
 void ErrorTracker::begin() {
+  ERROR_RING_LOCK();
   error_buffer_index_ = 0;
   error_count_ = 0;
   
   for (size_t i = 0; i < MAX_ERROR_ENTRIES; i++) {
     error_buffer_[i] = ErrorEntry();
   }
+  ERROR_RING_UNLOCK();
+  for (uint8_t i = 0; i < THROTTLE_SLOTS; i++) {
+    throttle_table_[i] = ErrorThrottle();
+  }
   
   LOG_I(TAG, "ErrorTracker: Initialized");
 }
@@ -97,14 +132,21 @@ void ErrorTracker::begin() {
 // ERROR TRACKING (Primary API)
 // ============================================
 void ErrorTracker::trackError(uint16_t error_code, ErrorSeverity severity, const char* message) {
-  // Log to Logger
-  logErrorToLogger(error_code, severity, message);
-  
-  // Add to circular buffer
-  addToBuffer(error_code, severity, message);
-  
-  // Publish to MQTT (if enabled and not recursing)
-  publishErrorToMqtt(error_code, severity, message);
+  ErrorEntry entry;
+  addToBuffer(error_code, severity, message, nullptr, false, entry);
+  logEntryToLogger(entry);
+  // Legacy text path: publish right away (caller's stack, like the former String payload)
+  if (shouldPublish(error_code)) {
+    char payload[384];
+    publishEntryToMqtt(entry, payload, sizeof(payload));
+  }
+}
+
+void ErrorTracker::reportError(uint16_t error_code, ErrorSeverity severity, const ErrorArgs& args) {
+  // Throttle decided up front so the pending mark is written with the entry
+  ErrorEntry entry;
+  addToBuffer(error_code, severity, nullptr, &args, shouldPublish(error_code), entry);
+  logEntryToLogger(entry);
 }
 
 void ErrorTracker::trackError(uint16_t error_code, const char* message) {
@@ -115,35 +157,43 @@ void ErrorTracker::trackError(uint16_t error_code, const char* message) {
 // CONVENIENCE METHODS
 // ============================================
 void ErrorTracker::logHardwareError(uint16_t code, const char* message) {
-  if (code >= ERROR_HARDWARE && code < kErrHardwareBandEndExcl) {
-    trackError(code, ERROR_SEVERITY_ERROR, message);
-  } else {
-    trackError(static_cast<uint16_t>(ERROR_HARDWARE + code), ERROR_SEVERITY_ERROR, message);
-  }
+  trackError(normalizeBandCode(code, ERROR_HARDWARE, kErrHardwareBandEndExcl),
+             ERROR_SEVERITY_ERROR, message);
 }
 
 void ErrorTracker::logServiceError(uint16_t code, const char* message) {
-  if (code >= ERROR_SERVICE && code < kErrServiceBandEndExcl) {
-    trackError(code, ERROR_SEVERITY_ERROR, message);
-  } else {
-    trackError(static_cast<uint16_t>(ERROR_SERVICE + code), ERROR_SEVERITY_ERROR, message);
-  }
+  trackError(normalizeBandCode(code, ERROR_SERVICE, kErrServiceBandEndExcl),
+             ERROR_SEVERITY_ERROR, message);
 }
 
 void ErrorTracker::logCommunicationError(uint16_t code, const char* message) {
-  if (code >= ERROR_COMMUNICATION && code < kErrCommunicationBandEndExcl) {
-    trackError(code, ERROR_SEVERITY_ERROR, message);
-  } else {
-    trackError(static_cast<uint16_t>(ERROR_COMMUNICATION + code), ERROR_SEVERITY_ERROR, message);
-  }
+  trackError(normalizeBandCode(code, ERROR_COMMUNICATION, kErrCommunicationBandEndExcl),
+             ERROR_SEVERITY_ERROR, message);
 }
 
 void ErrorTracker::logApplicationError(uint16_t code, const char* message) {
-  if (code >= kErrApplicationBandBase && code < kErrApplicationBandEndExcl) {
-    trackError(code, ERROR_SEVERITY_ERROR, message);
-  } else {
-    trackError(static_cast<uint16_t>(kErrApplicationBandBase + code), ERROR_SEVERITY_ERROR, message);
-  }
+  trackError(normalizeBandCode(code, kErrApplicationBandBase, kErrApplicationBandEndExcl),
+             ERROR_SEVERITY_ERROR, message);
+}
+
+void ErrorTracker::reportHardwareError(uint16_t code, const ErrorArgs& args) {
+  reportError(normalizeBandCode(code, ERROR_HARDWARE, kErrHardwareBandEndExcl),
+              ERROR_SEVERITY_ERROR, args);
+}
+
+void ErrorTracker::reportServiceError(uint16_t code, const ErrorArgs& args) {
+  reportError(normalizeBandCode(code, ERROR_SERVICE, kErrServiceBandEndExcl),
+              ERROR_SEVERITY_ERROR, args);
+}
+
+void ErrorTracker::reportCommunicationError(uint16_t code, const ErrorArgs& args) {
+  reportError(normalizeBandCode(code, ERROR_COMMUNICATION, kErrCommunicationBandEndExcl),
+              ERROR_SEVERITY_ERROR, args);
+}
+
+void ErrorTracker::reportApplicationError(uint16_t code, const ErrorArgs& args) {
+  reportError(normalizeBandCode(code, kErrApplicationBandBase, kErrApplicationBandEndExcl),
+              ERROR_SEVERITY_ERROR, args);
 }
 
 // ============================================
@@ -159,11 +209,13 @@ String ErrorTracker::getErrorHistory(uint8_t max_entries) const {
   for (size_t i = 0; i < error_count_ && entries_added < max_entries; i++) {
     size_t index = (start_index + i) % MAX_ERROR_ENTRIES;
     const ErrorEntry& entry = error_buffer_[index];
+    char message[128];
+    formatEntryMessage(entry, message, sizeof(message));
     
     result += "[" + String(entry.timestamp) + "] ";
     result += "[" + String(entry.error_code) + "] ";
     result += "[" + String(getCategoryString(entry.error_code)) + "] ";
-    result += String(entry.message);
+    result += String(message);
     if (entry.occurrence_count > 1) {
       result += " (x" + String(entry.occurrence_count) + ")";
     }
@@ -185,9 +237,11 @@ String ErrorTracker::getErrorsByCategory(ErrorCategory category, uint8_t max_ent
     const ErrorEntry& entry = error_buffer_[index];
     
     if (getCategory(entry.error_code) == category) {
+      char message[128];
+      formatEntryMessage(entry, message, sizeof(message));
       result += "[" + String(entry.timestamp) + "] ";
       result += "[" + String(entry.error_code) + "] ";
-      result += String(entry.message);
+      result += String(message);
       if (entry.occurrence_count > 1) {
         result += " (x" + String(entry.occurrence_count) + ")";
       }
@@ -203,6 +257,13 @@ size_t ErrorTracker::getErrorCount() const {
   return error_count_;
 }
 
+const ErrorEntry* ErrorTracker::getLatestEntry() const {
+  if (error_count_ == 0) {
+    return nullptr;
+  }
+  return &error_buffer_[(error_buffer_index_ + MAX_ERROR_ENTRIES - 1) % MAX_ERROR_ENTRIES];
+}
+
 size_t ErrorTracker::getErrorCountByCategory(ErrorCategory category) const {
   size_t count = 0;
   
@@ -239,15 +300,25 @@ bool ErrorTracker::hasCriticalErrors() const {
 }
 
 void ErrorTracker::clearErrors() {
+  ERROR_RING_LOCK();
   error_buffer_index_ = 0;
   error_count_ = 0;
+  ERROR_RING_UNLOCK();
   LOG_I(TAG, "ErrorTracker: Error history cleared");
 }
 
 // ============================================
 // HELPER METHODS
 // ============================================
-void ErrorTracker::addToBuffer(uint16_t error_code, ErrorSeverity severity, const char* message) {
+static bool sameArgs(const ErrorArgs& a, const ErrorArgs& b) {
+  bool same_what = (a.what == b.what) ||
+                   (a.what != nullptr && b.what != nullptr && strcmp(a.what, b.what) == 0);
+  return same_what && a.topic_class == b.topic_class && a.gpio == b.gpio &&
+         a.err_no == b.err_no && a.value == b.value;
+}
+
+void ErrorTracker::addToBuffer(uint16_t error_code, ErrorSeverity severity, const char* message,
+                               const ErrorArgs* args, bool publish_pending, ErrorEntry& snapshot) {
   // PKG-16 (INC-2026-04-11-ea5484): Null-safety defensive under OOM.
   // Arduino String::c_str() can surface as nullptr when an upstream concat
   // failed to allocate (observed in field log as '[ERRTRAK] <null>' bursts
@@ -256,27 +327,48 @@ void ErrorTracker::addToBuffer(uint16_t error_code, ErrorSeverity severity, cons
   // constant literal so dedup and buffer writes stay well-defined even when
   // the caller lost its message under heap pressure.
   const char* safe_message = (message != nullptr) ? message : "<oom-fallback>";
+  bool typed = (args != nullptr);
+  uint32_t now = millis();
 
+  ERROR_RING_LOCK();
   // Check if this error already exists in recent entries (last 5) - occurrence counting
   for (int i = 0; i < 5 && i < (int)error_count_; i++) {
     int check_index = (error_buffer_index_ - 1 - i + MAX_ERROR_ENTRIES) % MAX_ERROR_ENTRIES;
     ErrorEntry& entry = error_buffer_[check_index];
     
-    if (entry.error_code == error_code && strcmp(entry.message, safe_message) == 0) {
-      entry.occurrence_count++;
-      entry.timestamp = millis();  // Update timestamp
+    if (entry.error_code != error_code || entry.typed != typed) {
+      continue;
+    }
+    bool same = typed ? sameArgs(entry.args, *args) : strcmp(entry.message, safe_message) == 0;
+    if (same) {
+      if (entry.occurrence_count < 255) {
+        entry.occurrence_count++;
+      }
+      entry.timestamp = now;  // Update timestamp
+      entry.publish_pending = entry.publish_pending || publish_pending;
+      snapshot = entry;
+      ERROR_RING_UNLOCK();
       return;  // Don't add duplicate
     }
   }
   
   // Add new entry
   size_t index = error_buffer_index_;
-  error_buffer_[index].timestamp = millis();
-  error_buffer_[index].error_code = error_code;
-  error_buffer_[index].severity = severity;
-  strncpy(error_buffer_[index].message, safe_message, sizeof(error_buffer_[index].message) - 1);
-  error_buffer_[index].message[sizeof(error_buffer_[index].message) - 1] = '\0';
-  error_buffer_[index].occurrence_count = 1;
+  ErrorEntry& entry = error_buffer_[index];
+  entry.timestamp = now;
+  entry.error_code = error_code;
+  entry.severity = severity;
+  entry.typed = typed;
+  entry.publish_pending = publish_pending;
+  if (typed) {
+    entry.args = *args;
+    entry.message[0] = '\0';  // Formatted on demand
+  } else {
+    entry.args = ErrorArgs();
+    strncpy(entry.message, safe_message, sizeof(entry.message) - 1);
+    entry.message[sizeof(entry.message) - 1] = '\0';
+  }
+  entry.occurrence_count = 1;
   
   // Advance circular buffer index
   error_buffer_index_ = (error_buffer_index_ + 1) % MAX_ERROR_ENTRIES;
@@ -285,29 +377,27 @@ void ErrorTracker::addToBuffer(uint16_t error_code, ErrorSeverity severity, cons
   if (error_count_ < MAX_ERROR_ENTRIES) {
     error_count_++;
   }
+  snapshot = entry;
+  ERROR_RING_UNLOCK();
 }
 
-void ErrorTracker::logErrorToLogger(uint16_t error_code, ErrorSeverity severity, const char* message) {
-  // PKG-16: defensive against callers that pass nullptr (e.g. reason.c_str()
-  // after failed String concat under OOM). Logger itself also guards, but we
-  // make intent explicit here to produce a searchable '<oom-fallback>' marker
-  // instead of an empty tail.
-  const char* safe_message = (message != nullptr) ? message : "<oom-fallback>";
-  String log_msg = "[" + String(error_code) + "] [" +
-                   String(getCategoryString(error_code)) + "] " +
-                   String(safe_message);
-
-  switch (severity) {
-    case ERROR_SEVERITY_WARNING:
-      LOG_W(TAG, log_msg.c_str());
-      break;
-    case ERROR_SEVERITY_ERROR:
-      LOG_E(TAG, log_msg.c_str());
-      break;
-    case ERROR_SEVERITY_CRITICAL:
-      LOG_C(TAG, log_msg.c_str());
-      break;
+void ErrorTracker::logEntryToLogger(const ErrorEntry& entry) {
+  LogLevel level = LOG_ERROR;
+  switch (entry.severity) {
+    case ERROR_SEVERITY_WARNING:  level = LOG_WARNING; break;
+    case ERROR_SEVERITY_ERROR:    level = LOG_ERROR; break;
+    case ERROR_SEVERITY_CRITICAL: level = LOG_CRITICAL; break;
   }
+  // Format only if the logger would keep the line (stack buffer, no String)
+  if (!logger.shouldLog(level, TAG)) {
+    return;
+  }
+  char message[128];
+  formatEntryMessage(entry, message, sizeof(message));
+  char line[160];
+  snprintf(line, sizeof(line), "[%u] [%s] %s", static_cast<unsigned>(entry.error_code),
+           getCategoryString(entry.error_code), message);
+  logger.log(level, TAG, line);
 }
 
 // ============================================
@@ -327,6 +417,79 @@ const char* ErrorTracker::getCategoryString(uint16_t error_code) {
   }
 }
 
+ErrorTopicClass ErrorTracker::classifyTopic(const char* topic) {
+  if (topic == nullptr || topic[0] == '\0') {
+    return ErrorTopicClass::NONE;
+  }
+  if (strstr(topic, "/sensor/") != nullptr || strstr(topic, "/sensor_data/") != nullptr) {
+    return ErrorTopicClass::SENSOR_DATA;
+  }
+  if (strstr(topic, "/actuator/") != nullptr) {
+    return ErrorTopicClass::ACTUATOR;
+  }
+  if (strstr(topic, "/heartbeat") != nullptr) {
+    return ErrorTopicClass::HEARTBEAT;
+  }
+  if (strstr(topic, "/intent_outcome") != nullptr) {
+    return ErrorTopicClass::INTENT_OUTCOME;
+  }
+  if (strstr(topic, "/config") != nullptr) {
+    return ErrorTopicClass::CONFIG;
+  }
+  if (strstr(topic, "/system/") != nullptr) {
+    return ErrorTopicClass::SYSTEM;
+  }
+  return ErrorTopicClass::OTHER;
+}
+
+const char* ErrorTracker::getTopicClassString(ErrorTopicClass topic_class) {
+  switch (topic_class) {
+    case ErrorTopicClass::SENSOR_DATA:    return "sensor_data";
+    case ErrorTopicClass::ACTUATOR:       return "actuator";
+    case ErrorTopicClass::HEARTBEAT:      return "heartbeat";
+    case ErrorTopicClass::CONFIG:         return "config";
+    case ErrorTopicClass::INTENT_OUTCOME: return "intent_outcome";
+    case ErrorTopicClass::SYSTEM:         return "system";
+    case ErrorTopicClass::OTHER:          return "other";
+    default:                              return "none";
+  }
+}
+
+size_t ErrorTracker::formatEntryMessage(const ErrorEntry& entry, char* out, size_t out_len) {
+  if (out == nullptr || out_len == 0) {
+    return 0;
+  }
+  if (!entry.typed) {
+    int written = snprintf(out, out_len, "%s", entry.message);
+    return written < 0 ? 0 : (static_cast<size_t>(written) < out_len ? written : out_len - 1);
+  }
+
+  const ErrorArgs& args = entry.args;
+  size_t pos = 0;
+  auto append = [&](int written) {
+    if (written > 0) {
+      pos += static_cast<size_t>(written);
+      if (pos >= out_len) {
+        pos = out_len - 1;
+      }
+    }
+  };
+  append(snprintf(out, out_len, "%s", args.what != nullptr ? args.what : "error"));
+  if (args.topic_class != ErrorTopicClass::NONE) {
+    append(snprintf(out + pos, out_len - pos, " topic=%s", getTopicClassString(args.topic_class)));
+  }
+  if (args.gpio >= 0) {
+    append(snprintf(out + pos, out_len - pos, " gpio=%d", static_cast<int>(args.gpio)));
+  }
+  if (args.err_no != 0) {
+    append(snprintf(out + pos, out_len - pos, " errno=%ld", static_cast<long>(args.err_no)));
+  }
+  if (args.value != 0) {
+    append(snprintf(out + pos, out_len - pos, " value=%lu", static_cast<unsigned long>(args.value)));
+  }
+  return pos;
+}
+
 ErrorCategory ErrorTracker::getCategory(uint16_t error_code) {
   if (error_code >= ERROR_APPLICATION && error_code < 5000) {
     return ERROR_APPLICATION;
@@ -359,22 +522,65 @@ void ErrorTracker::clearMqttPublishCallback() {
   LOG_D(TAG, "ErrorTracker: MQTT error publishing disabled");
 }
 
-void ErrorTracker::publishErrorToMqtt(uint16_t error_code, ErrorSeverity severity, const char* message) {
-  // Guard: Skip if disabled or already publishing (recursion prevention)
-  if (!mqtt_publishing_enabled_ || mqtt_publish_in_progress_) {
-    return;
+bool ErrorTracker::shouldPublish(uint16_t error_code) {
+  // Guard: Skip if disabled or raised while publishing (recursion prevention)
+  if (!mqtt_publishing_enabled_ || mqtt_publish_in_progress_ || mqtt_callback_ == nullptr) {
+    return false;
   }
 
-  // Guard: Must have callback
-  if (mqtt_callback_ == nullptr) {
+  // Rate-Limiting: max 1 MQTT publish per error code per 60s (F8)
+  return shouldPublishError(error_code);
+}
+
+void ErrorTracker::processPendingPublishes(uint8_t max_entries) {
+  if (!mqtt_publishing_enabled_ || mqtt_callback_ == nullptr || mqtt_publish_in_progress_) {
     return;
   }
+  // Static payload: only the Comm-Task (or the legacy loop without tasks) drains
+  static char payload[384];
+  for (uint8_t published = 0; published < max_entries; published++) {
+    // Claim the oldest pending entry and copy it out; a writer on the other
+    // core cannot tear the entry while it is formatted
+    ErrorEntry entry;
+    bool found = false;
+    ERROR_RING_LOCK();
+    size_t start_index = (error_count_ < MAX_ERROR_ENTRIES) ? 0 : error_buffer_index_;
+    for (size_t i = 0; i < error_count_; i++) {
+      ErrorEntry& slot = error_buffer_[(start_index + i) % MAX_ERROR_ENTRIES];
+      if (slot.publish_pending) {
+        slot.publish_pending = false;
+        entry = slot;
+        found = true;
+        break;
+      }
+    }
+    ERROR_RING_UNLOCK();
+    if (!found) {
+      return;
+    }
+    publishEntryToMqtt(entry, payload, sizeof(payload));
+  }
+}
 
-  // Rate-Limiting: max 1 MQTT publish per error code per 60s (F8)
-  if (!shouldPublishError(error_code)) {
-    return;
+// Appends s JSON-escaped; stops at the buffer end (always NUL-terminated).
+static size_t appendJsonEscaped(char* out, size_t out_len, size_t pos, const char* s) {
+  for (; s != nullptr && *s != '\0' && pos + 2 < out_len; s++) {
+    char c = *s;
+    if (c == '"' || c == '\\') {
+      out[pos++] = '\\';
+      out[pos++] = c;
+    } else if (c == '\n') {
+      out[pos++] = '\\';
+      out[pos++] = 'n';
+    } else if (static_cast<unsigned char>(c) >= 0x20) {
+      out[pos++] = c;
+    }
   }
+  out[pos] = '\0';
+  return pos;
+}
 
+void ErrorTracker::publishEntryToMqtt(const ErrorEntry& entry, char* payload, size_t payload_len) {
   // Set recursion guard
   mqtt_publish_in_progress_ = true;
 
@@ -387,39 +593,68 @@ void ErrorTracker::publishErrorToMqtt(uint16_t error_code, ErrorSeverity severit
     return;
   }
 
-  // ✅ Phase 0 Fix: Use Unix timestamp from TimeManager
-  time_t unix_ts = timeManager.getUnixTimestamp();
-  // Fallback to 0 if NTP not synced (server will use server-time)
-
-  // Build payload (JSON) - Server-compatible format
-  String payload;
-  payload.reserve(256);
-  payload = "{";
-  payload += "\"error_code\":";
-  payload += String(error_code);
-  payload += ",\"severity\":";
-  payload += String(static_cast<int>(severity));
-  payload += ",\"category\":\"";
-  payload += getCategoryString(error_code);
-  payload += "\",\"message\":\"";
-  // Escape quotes in message for valid JSON
-  String escaped_msg = String(message);
-  escaped_msg.replace("\"", "\\\"");
-  escaped_msg.replace("\n", "\\n");
-  payload += escaped_msg;
-  // ✅ Phase 0 Fix: Add context field (empty object for now, extensible)
-  payload += "\",\"context\":{";
-  payload += "\"esp_id\":\"";
-  payload += mqtt_esp_id_;
-  payload += "\",\"uptime_ms\":";
-  payload += String(millis());
-  payload += "}";
-  payload += ",\"ts\":";
-  payload += String((unsigned long)unix_ts);
-  payload += "}";
-
-  // Fire-and-forget publish (no error handling - prevent recursion!)
-  mqtt_callback_(topic, payload.c_str());
+  // Unix time of the error itself (entry age subtracted); 0 if NTP not synced
+  // (server uses server-time as fallback)
+#ifndef NATIVE_TEST
+  unsigned long unix_ts = static_cast<unsigned long>(timeManager.getUnixTimestamp());
+#else
+  unsigned long unix_ts = 0;
+#endif
+  unsigned long age_s = (millis() - entry.timestamp) / 1000;
+  if (unix_ts > age_s) {
+    unix_ts -= age_s;
+  }
+
+  // Build payload (JSON) - Server-compatible format, caller-provided buffer
+  char message[128];
+  formatEntryMessage(entry, message, sizeof(message));
+
+  int written = snprintf(payload, payload_len,
+                         "{\"error_code\":%u,\"severity\":%d,\"category\":\"%s\",\"message\":\"",
+                         static_cast<unsigned>(entry.error_code), static_cast<int>(entry.severity),
+                         getCategoryString(entry.error_code));
+  size_t pos = written > 0 ? static_cast<size_t>(written) : 0;
+  pos = appendJsonEscaped(payload, payload_len, pos, message);
+
+  // ✅ Phase 0 Fix: context field (esp_id, uptime) + typed arguments
+  written = snprintf(payload + pos, payload_len - pos,
+                     "\",\"context\":{\"esp_id\":\"%s\",\"uptime_ms\":%lu,\"occurrences\":%u",
+                     mqtt_esp_id_.c_str(), entry.timestamp,
+                     static_cast<unsigned>(entry.occurrence_count));
+  pos += written > 0 ? static_cast<size_t>(written) : 0;
+  if (entry.typed && pos < payload_len) {
+    const ErrorArgs& args = entry.args;
+    if (args.topic_class != ErrorTopicClass::NONE && pos < payload_len) {
+      written = snprintf(payload + pos, payload_len - pos, ",\"topic_class\":\"%s\"",
+                         getTopicClassString(args.topic_class));
+      pos += written > 0 ? static_cast<size_t>(written) : 0;
+    }
+    if (args.gpio >= 0 && pos < payload_len) {
+      written = snprintf(payload + pos, payload_len - pos, ",\"gpio\":%d",
+                         static_cast<int>(args.gpio));
+      pos += written > 0 ? static_cast<size_t>(written) : 0;
+    }
+    if (args.err_no != 0 && pos < payload_len) {
+      written = snprintf(payload + pos, payload_len - pos, ",\"errno\":%ld",
+                         static_cast<long>(args.err_no));
+      pos += written > 0 ? static_cast<size_t>(written) : 0;
+    }
+    if (args.value != 0 && pos < payload_len) {
+      written = snprintf(payload + pos, payload_len - pos, ",\"value\":%lu",
+                         static_cast<unsigned long>(args.value));
+      pos += written > 0 ? static_cast<size_t>(written) : 0;
+    }
+  }
+  if (pos < payload_len) {
+    written = snprintf(payload + pos, payload_len - pos, "},\"ts\":%lu}", unix_ts);
+    pos += written > 0 ? static_cast<size_t>(written) : 0;
+  }
+
+  // Truncated JSON would be rejected server-side — drop instead
+  if (pos < payload_len) {
+    // Fire-and-forget publish (no error handling - prevent recursion!)
+    mqtt_callback_(topic, payload);
+  }
 
   // Clear recursion guard
   mqtt_publish_in_progress_ = false;
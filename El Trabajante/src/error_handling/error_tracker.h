@@ -22,6 +22,44 @@ enum ErrorSeverity {
   ERROR_SEVERITY_CRITICAL = 3  // Critical error, system unstable
 };
 
+// ============================================
+// TYPED ERROR ARGUMENTS (heap-free reporting)
+// ============================================
+// Failure paths (publish drops, full queues, driver errors) run exactly when
+// heap is scarce. reportError() stores a code plus typed arguments in the
+// fixed ring WITHOUT formatting; text is produced only when the entry is
+// logged, printed or published — into stack buffers, never via String.
+// Usage:
+//   errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+//       ErrorArgs("Publish dropped").topic(req.topic).err(errno));
+enum class ErrorTopicClass : uint8_t {
+  NONE = 0,
+  SENSOR_DATA,
+  ACTUATOR,
+  HEARTBEAT,
+  CONFIG,
+  INTENT_OUTCOME,
+  SYSTEM,
+  OTHER
+};
+
+struct ErrorArgs {
+  const char* what;              // String literal / static storage only (kept by pointer)
+  ErrorTopicClass topic_class;
+  int16_t gpio;                  // -1 = none
+  int32_t err_no;                // 0 = none
+  uint32_t value;                // Code-specific number (attempt, fill level, ...), 0 = none
+
+  explicit ErrorArgs(const char* what_text = nullptr)
+    : what(what_text), topic_class(ErrorTopicClass::NONE), gpio(-1), err_no(0), value(0) {}
+
+  ErrorArgs& topic(ErrorTopicClass topic_class_value) { topic_class = topic_class_value; return *this; }
+  ErrorArgs& topic(const char* topic_str);   // Classifies only, the string is not kept
+  ErrorArgs& pin(int16_t gpio_num) { gpio = gpio_num; return *this; }
+  ErrorArgs& err(int32_t err_value) { err_no = err_value; return *this; }
+  ErrorArgs& val(uint32_t number) { value = number; return *this; }
+};
+
 // ============================================
 // ERROR ENTRY STRUCTURE (Guide-konform: fixed size)
 // ============================================
@@ -29,12 +67,16 @@ struct ErrorEntry {
   unsigned long timestamp;
   uint16_t error_code;
   ErrorSeverity severity;
-  char message[128];
+  char message[128];         // Formatted text (trackError) — empty for typed entries
+  ErrorArgs args;            // Typed arguments (reportError), formatted on demand
+  bool typed;
+  bool publish_pending;      // Marked for MQTT, sent by processPendingPublishes()
   uint8_t occurrence_count;  // Duplicate tracking
   
   ErrorEntry() 
     : timestamp(0), error_code(0),
       severity(ERROR_SEVERITY_ERROR),
+      typed(false), publish_pending(false),
       occurrence_count(0) {
     message[0] = '\0';
   }
@@ -59,7 +101,7 @@ public:
   // Initialization (Guide-konform)
   void begin();
   
-  // Primary API: const char* (Guide-konform)
+  // Primary API: const char* (Guide-konform) — publishes to MQTT immediately
   void trackError(uint16_t error_code, ErrorSeverity severity, const char* message);
   void trackError(uint16_t error_code, const char* message);  // Default severity: ERROR
   
@@ -70,12 +112,21 @@ public:
   void logServiceError(uint16_t code, const char* message);
   void logCommunicationError(uint16_t code, const char* message);
   void logApplicationError(uint16_t code, const char* message);
+
+  // Heap-free API: code + typed arguments (same band mapping as log*Error);
+  // the MQTT event is deferred to processPendingPublishes()
+  void reportError(uint16_t error_code, ErrorSeverity severity, const ErrorArgs& args);
+  void reportHardwareError(uint16_t code, const ErrorArgs& args);
+  void reportServiceError(uint16_t code, const ErrorArgs& args);
+  void reportCommunicationError(uint16_t code, const ErrorArgs& args);
+  void reportApplicationError(uint16_t code, const ErrorArgs& args);
   
   // Error Retrieval
   String getErrorHistory(uint8_t max_entries = 20) const;
   String getErrorsByCategory(ErrorCategory category, uint8_t max_entries = 10) const;
   size_t getErrorCount() const;
   size_t getErrorCountByCategory(ErrorCategory category) const;
+  const ErrorEntry* getLatestEntry() const;
   
   // Error Status
   bool hasActiveErrors() const;
@@ -114,10 +165,24 @@ public:
    * @brief Disable MQTT publishing (e.g., when MQTT disconnects)
    */
   void clearMqttPublishCallback();
+
+  /**
+   * @brief Publish entries marked for MQTT (Comm-Task or legacy loop)
+   *
+   * reportError() paths only mark the entry; the JSON payload is built here
+   * in a static buffer from a snapshot taken under the ring lock, so
+   * reporting never allocates and never re-enters MQTT.
+   * Context carries the typed arguments (topic_class, gpio, errno, value).
+   */
+  void processPendingPublishes(uint8_t max_entries = 2);
   
   // Utilities
   static const char* getCategoryString(uint16_t error_code);
   static ErrorCategory getCategory(uint16_t error_code);
+  static ErrorTopicClass classifyTopic(const char* topic);
+  static const char* getTopicClassString(ErrorTopicClass topic_class);
+  // Message text of an entry (typed arguments formatted on demand); returns length
+  static size_t formatEntryMessage(const ErrorEntry& entry, char* out, size_t out_len);
   
 private:
   ErrorTracker();  // Private Constructor (Singleton)
@@ -139,9 +204,12 @@ private:
   bool mqtt_publish_in_progress_;  // Recursion guard
   
   // Helper methods
-  void addToBuffer(uint16_t error_code, ErrorSeverity severity, const char* message);
-  void logErrorToLogger(uint16_t error_code, ErrorSeverity severity, const char* message);
-  void publishErrorToMqtt(uint16_t error_code, ErrorSeverity severity, const char* message);
+  // Writes the ring entry under the ring lock and copies it to snapshot
+  void addToBuffer(uint16_t error_code, ErrorSeverity severity, const char* message,
+                   const ErrorArgs* args, bool publish_pending, ErrorEntry& snapshot);
+  void logEntryToLogger(const ErrorEntry& entry);
+  bool shouldPublish(uint16_t error_code);
+  void publishEntryToMqtt(const ErrorEntry& entry, char* payload, size_t payload_len);
 };
 
 // ============================================
@@ -7,6 +7,11 @@
 #include "../services/safety/offline_mode_manager.h"
 #include "../services/config/storage_manager.h"
 #include "../error_handling/error_tracker.h"
+#include "../error_handling/resource_monitor.h"
+#include "../error_handling/watchdog_supervisor.h"
+#include "../tasks/safety_task.h"
+#include "../services/power/power_manager.h"
+#include "../tasks/communication_task.h"
 #include "../utils/topic_builder.h"
 #include "../utils/time_manager.h"
 #include "../models/error_codes.h"
@@ -265,6 +270,14 @@ String HealthMonitor::getSnapshotJSON() const {
     json += "\"wifi_rssi\":" + String(snapshot.wifi_rssi) + ",";
     json += "\"mqtt_connected\":" + String(snapshot.mqtt_connected ? "true" : "false") + ",";
     json += "\"sensor_count\":" + String(snapshot.sensor_count) + ",";
+    json += "\"sensor_rejects\":" + String(sensorManager.getRejectedReadingCount()) + ",";
+    json += "\"raw_batch_frames\":" + String(sensorManager.getRawBatchFrameCount()) + ",";
+    json += "\"raw_batch_samples\":" + String(sensorManager.getRawBatchSampleCount()) + ",";
+    uint32_t comm_event_wakes = 0;
+    uint32_t comm_timeout_wakes = 0;
+    getCommTaskWakeStats(comm_event_wakes, comm_timeout_wakes);
+    json += "\"comm_wakes_event\":" + String(comm_event_wakes) + ",";
+    json += "\"comm_wakes_timeout\":" + String(comm_timeout_wakes) + ",";
     json += "\"actuator_count\":" + String(snapshot.actuator_count) + ",";
     
     // System state as string
@@ -312,10 +325,23 @@ String HealthMonitor::getSnapshotJSON() const {
             String(storageManager.getNamespaceConflictCount());
     json += ",\"storage_no_session_access_count\":" +
             String(storageManager.getNoSessionAccessCount());
+    json += ",\"storage_ns_lock_waits\":" +
+            String(storageManager.getNamespaceLocks().getWaitCount());
+    json += ",\"storage_ns_lock_timeouts\":" +
+            String(storageManager.getNamespaceLocks().getTimeoutCount());
+    // Cached NVS free entries + per-namespace usage (StorageManager)
+    storageManager.appendDiagnosticsJson(json);
     json += ",\"hist_not_found_expected_count\":" +
             String(watchdogStorageGetHistNotFoundExpectedCount());
     json += ",\"hist_not_found_unexpected_count\":" +
             String(watchdogStorageGetHistNotFoundUnexpectedCount());
+    // Stack HWM per task + heap deltas per subsystem (ResourceMonitor)
+    resourceMonitor.appendDiagnosticsJson(json);
+    watchdogSupervisor.appendDiagnosticsJson(json);
+    // Safety loop phase budgets: runs/deferrals/overruns (SafetyTickScheduler)
+    g_safety_tick_scheduler.appendDiagnosticsJson(json);
+    // Wake counts + estimated average current (PowerManager)
+    powerManager.appendDiagnosticsJson(json);
 
     json += "}";
     
@@ -0,0 +1,398 @@
+#include "resource_monitor.h"
+
+#include <cstddef>
+#include <cstring>
+
+#ifndef NATIVE_TEST
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../utils/logger.h"
+
+static const char* TAG = "RESMON";
+
+static portMUX_TYPE s_resource_mux = portMUX_INITIALIZER_UNLOCKED;
+#define RESOURCE_LOCK() portENTER_CRITICAL(&s_resource_mux)
+#define RESOURCE_UNLOCK() portEXIT_CRITICAL(&s_resource_mux)
+#else
+#define RESOURCE_LOCK()
+#define RESOURCE_UNLOCK()
+#endif
+
+// ============================================
+// RTC PERSISTENCE (survives WDT / panic / SW reset)
+// ============================================
+struct RtcTaskRecord {
+    char name[16];
+    uint32_t min_free_bytes;
+};
+
+struct RtcWatermarkRecord {
+    uint32_t magic;
+    uint32_t task_count;
+    RtcTaskRecord tasks[8];
+    uint32_t heap_min_free;
+    uint32_t checksum;
+};
+
+static const uint32_t RTC_WATERMARK_MAGIC = 0x53544B57;  // "STKW"
+
+#ifndef NATIVE_TEST
+RTC_NOINIT_ATTR static RtcWatermarkRecord s_rtc_record;
+#else
+static RtcWatermarkRecord s_rtc_record;
+#endif
+// Copy taken in begin(): sample() overwrites s_rtc_record with this boot's values
+static RtcWatermarkRecord s_last_boot_record;
+
+#ifdef NATIVE_TEST
+static uint32_t s_sim_free_heap = 0;
+struct SimulatedStack {
+    void* handle;
+    uint32_t free_bytes;
+};
+static SimulatedStack s_sim_stacks[8];
+static size_t s_sim_stack_count = 0;
+#endif
+
+static uint32_t computeRecordChecksum(const RtcWatermarkRecord& record) {
+    // FNV-1a over everything except the checksum field itself
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    size_t len = offsetof(RtcWatermarkRecord, checksum);
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static bool isRecordValid(const RtcWatermarkRecord& record) {
+    return record.magic == RTC_WATERMARK_MAGIC &&
+           record.task_count <= 8 &&
+           record.checksum == computeRecordChecksum(record);
+}
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+ResourceMonitor& resourceMonitor = ResourceMonitor::getInstance();
+
+ResourceMonitor& ResourceMonitor::getInstance() {
+    static ResourceMonitor instance;
+    return instance;
+}
+
+ResourceMonitor::ResourceMonitor()
+    : task_count_(0),
+      heap_min_free_(UINT32_MAX),
+      last_boot_heap_min_free_(0) {
+    memset(tasks_, 0, sizeof(tasks_));
+    memset(heap_deltas_, 0, sizeof(heap_deltas_));
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+        heap_deltas_[i].min_free_after = UINT32_MAX;
+    }
+}
+
+// ============================================
+// INITIALIZATION
+// ============================================
+void ResourceMonitor::begin(bool restore_last_boot) {
+    bool restored = restore_last_boot && isRecordValid(s_rtc_record);
+    memset(&s_last_boot_record, 0, sizeof(s_last_boot_record));
+    if (restored) {
+        s_last_boot_record = s_rtc_record;
+        last_boot_heap_min_free_ = s_last_boot_record.heap_min_free;
+        // Tasks registered before begin() pick up their previous watermark now
+        for (size_t i = 0; i < task_count_; i++) {
+            tasks_[i].last_boot_min_free_bytes = lastBootMinFreeFor(tasks_[i].name);
+        }
+    } else {
+        memset(&s_rtc_record, 0, sizeof(s_rtc_record));
+    }
+
+#ifndef NATIVE_TEST
+    if (restored) {
+        for (uint32_t i = 0; i < s_last_boot_record.task_count; i++) {
+            LOG_W(TAG, String("[RESMON] Last boot stack HWM: ") + s_last_boot_record.tasks[i].name +
+                       " min_free=" + String(s_last_boot_record.tasks[i].min_free_bytes) + " B");
+        }
+        LOG_W(TAG, "[RESMON] Last boot heap min free: " + String(last_boot_heap_min_free_) + " B");
+    }
+#endif
+}
+
+uint32_t ResourceMonitor::lastBootMinFreeFor(const char* name) const {
+    if (s_last_boot_record.magic != RTC_WATERMARK_MAGIC) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < s_last_boot_record.task_count && i < 8; i++) {
+        if (strncmp(s_last_boot_record.tasks[i].name, name, sizeof(s_last_boot_record.tasks[i].name)) == 0) {
+            return s_last_boot_record.tasks[i].min_free_bytes;
+        }
+    }
+    return 0;
+}
+
+// ============================================
+// TASK REGISTRATION + SAMPLING
+// ============================================
+bool ResourceMonitor::registerTask(const char* name, void* handle, uint32_t stack_bytes) {
+    if (name == nullptr || name[0] == '\0') {
+        return false;
+    }
+
+    RESOURCE_LOCK();
+    TaskWatermark* slot = nullptr;
+    for (size_t i = 0; i < task_count_; i++) {
+        if (strncmp(tasks_[i].name, name, sizeof(tasks_[i].name)) == 0) {
+            slot = &tasks_[i];  // Re-registration (e.g. task recreated) keeps the watermark
+            break;
+        }
+    }
+    if (slot == nullptr && task_count_ < MAX_TASKS) {
+        slot = &tasks_[task_count_++];
+        memset(slot, 0, sizeof(*slot));
+        strncpy(slot->name, name, sizeof(slot->name) - 1);
+        slot->min_free_bytes = UINT32_MAX;
+        slot->last_boot_min_free_bytes = lastBootMinFreeFor(slot->name);
+    }
+    if (slot != nullptr) {
+        slot->handle = handle;
+        slot->stack_bytes = stack_bytes;
+    }
+    RESOURCE_UNLOCK();
+    return slot != nullptr;
+}
+
+uint32_t ResourceMonitor::readStackFreeBytes(const TaskWatermark& task) const {
+#ifndef NATIVE_TEST
+    TaskHandle_t handle = static_cast<TaskHandle_t>(task.handle);
+    if (handle == nullptr) {
+        // Foreign tasks (ESP-IDF mqtt_task) are resolved by name on every sample and
+        // never cached: esp_mqtt_client_destroy() frees the task on each reconnect.
+        handle = xTaskGetHandle(task.name);
+        if (handle == nullptr) {
+            return UINT32_MAX;
+        }
+    }
+    UBaseType_t hwm = uxTaskGetStackHighWaterMark(handle);
+    return static_cast<uint32_t>(hwm) * static_cast<uint32_t>(sizeof(StackType_t));
+#else
+    for (size_t i = 0; i < s_sim_stack_count; i++) {
+        if (s_sim_stacks[i].handle == task.handle) {
+            return s_sim_stacks[i].free_bytes;
+        }
+    }
+    return UINT32_MAX;
+#endif
+}
+
+void ResourceMonitor::sample() {
+    for (size_t i = 0; i < task_count_; i++) {
+        uint32_t free_bytes = readStackFreeBytes(tasks_[i]);
+        if (free_bytes == UINT32_MAX) {
+            continue;
+        }
+        RESOURCE_LOCK();
+        tasks_[i].samples++;
+        if (free_bytes < tasks_[i].min_free_bytes) {
+            tasks_[i].min_free_bytes = free_bytes;
+        }
+        RESOURCE_UNLOCK();
+    }
+
+    uint32_t free_heap = readFreeHeap();
+    RESOURCE_LOCK();
+    if (free_heap < heap_min_free_) {
+        heap_min_free_ = free_heap;
+    }
+    persistToRtc();
+    RESOURCE_UNLOCK();
+}
+
+void ResourceMonitor::persistToRtc() {
+    // Caller holds RESOURCE_LOCK — plain memory writes only (no flash wear)
+    s_rtc_record.magic = RTC_WATERMARK_MAGIC;
+    uint32_t count = 0;
+    for (size_t i = 0; i < task_count_ && count < 8; i++) {
+        if (tasks_[i].samples == 0) {
+            continue;
+        }
+        RtcTaskRecord& rec = s_rtc_record.tasks[count++];
+        memcpy(rec.name, tasks_[i].name, sizeof(rec.name));
+        rec.min_free_bytes = tasks_[i].min_free_bytes;
+    }
+    s_rtc_record.task_count = count;
+    s_rtc_record.heap_min_free = (heap_min_free_ == UINT32_MAX) ? 0 : heap_min_free_;
+    s_rtc_record.checksum = computeRecordChecksum(s_rtc_record);
+}
+
+const TaskWatermark* ResourceMonitor::getTask(size_t index) const {
+    return index < task_count_ ? &tasks_[index] : nullptr;
+}
+
+const TaskWatermark* ResourceMonitor::findTask(const char* name) const {
+    if (name == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < task_count_; i++) {
+        if (strncmp(tasks_[i].name, name, sizeof(tasks_[i].name)) == 0) {
+            return &tasks_[i];
+        }
+    }
+    return nullptr;
+}
+
+// ============================================
+// HEAP DELTAS
+// ============================================
+uint32_t ResourceMonitor::readFreeHeap() const {
+#ifndef NATIVE_TEST
+    return ESP.getFreeHeap();
+#else
+    return s_sim_free_heap;
+#endif
+}
+
+void ResourceMonitor::recordHeapDelta(HeapSubsystem subsystem, uint32_t free_before, uint32_t free_after) {
+    size_t idx = static_cast<size_t>(subsystem);
+    if (idx >= SUBSYSTEM_COUNT) {
+        return;
+    }
+    int32_t delta = static_cast<int32_t>(static_cast<int64_t>(free_before) - static_cast<int64_t>(free_after));
+
+    RESOURCE_LOCK();
+    HeapDeltaStats& stats = heap_deltas_[idx];
+    stats.last_delta = delta;
+    if (stats.count == 0 || delta > stats.max_delta) {
+        stats.max_delta = delta;
+    }
+    if (free_after < stats.min_free_after) {
+        stats.min_free_after = free_after;
+    }
+    stats.count++;
+    RESOURCE_UNLOCK();
+}
+
+HeapDeltaStats ResourceMonitor::getHeapDelta(HeapSubsystem subsystem) const {
+    size_t idx = static_cast<size_t>(subsystem);
+    HeapDeltaStats copy;
+    memset(&copy, 0, sizeof(copy));
+    if (idx < SUBSYSTEM_COUNT) {
+        RESOURCE_LOCK();
+        copy = heap_deltas_[idx];
+        RESOURCE_UNLOCK();
+    }
+    return copy;
+}
+
+// ============================================
+// SIZING FEEDBACK + DIAGNOSTICS
+// ============================================
+uint32_t ResourceMonitor::suggestStackBytes(uint32_t stack_bytes, uint32_t min_free_bytes) {
+    if (min_free_bytes == UINT32_MAX || min_free_bytes > stack_bytes) {
+        return stack_bytes;  // No valid sample yet — keep configured size
+    }
+    uint32_t used = stack_bytes - min_free_bytes;
+    uint32_t suggested = used + used / 4 + 1024;
+    return (suggested + 511) & ~static_cast<uint32_t>(511);
+}
+
+const char* ResourceMonitor::getSubsystemName(HeapSubsystem subsystem) {
+    switch (subsystem) {
+        case HeapSubsystem::CONFIG_APPLY: return "config_apply";
+        case HeapSubsystem::HEARTBEAT_BUILD: return "heartbeat_build";
+        case HeapSubsystem::COMMAND_HANDLING: return "command_handling";
+        default: return "unknown";
+    }
+}
+
+void ResourceMonitor::appendDiagnosticsJson(String& json) const {
+    // Compact keys — diagnostics must stay below MQTT_MAX_PACKET_SIZE on the C3.
+    // t=task, sz=stack bytes, min=min free this boot, prev=min free last boot,
+    // sug=suggested stack bytes. Heap deltas: [count, last, max].
+    char buf[112];
+    json += ",\"stack_hwm\":[";
+    bool first = true;
+    for (size_t i = 0; i < task_count_; i++) {
+        const TaskWatermark& task = tasks_[i];
+        if (task.samples == 0) {
+            continue;
+        }
+        snprintf(buf, sizeof(buf), "%s{\"t\":\"%s\",\"sz\":%lu,\"min\":%lu,\"prev\":%lu,\"sug\":%lu}",
+                 first ? "" : ",",
+                 task.name,
+                 static_cast<unsigned long>(task.stack_bytes),
+                 static_cast<unsigned long>(task.min_free_bytes),
+                 static_cast<unsigned long>(task.last_boot_min_free_bytes),
+                 static_cast<unsigned long>(suggestStackBytes(task.stack_bytes, task.min_free_bytes)));
+        json += buf;
+        first = false;
+    }
+    json += "]";
+
+    json += ",\"heap_delta\":{";
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+        HeapDeltaStats stats = getHeapDelta(static_cast<HeapSubsystem>(i));
+        snprintf(buf, sizeof(buf), "%s\"%s\":[%lu,%ld,%ld]",
+                 i == 0 ? "" : ",",
+                 getSubsystemName(static_cast<HeapSubsystem>(i)),
+                 static_cast<unsigned long>(stats.count),
+                 static_cast<long>(stats.last_delta),
+                 static_cast<long>(stats.max_delta));
+        json += buf;
+    }
+    json += "}";
+
+    snprintf(buf, sizeof(buf), ",\"heap_min_free_prev_boot\":%lu",
+             static_cast<unsigned long>(last_boot_heap_min_free_));
+    json += buf;
+}
+
+// ============================================
+// HEAP DELTA SCOPE
+// ============================================
+HeapDeltaScope::HeapDeltaScope(HeapSubsystem subsystem)
+    : subsystem_(subsystem),
+      free_before_(resourceMonitor.readFreeHeap()) {}
+
+HeapDeltaScope::~HeapDeltaScope() {
+    resourceMonitor.recordHeapDelta(subsystem_, free_before_, resourceMonitor.readFreeHeap());
+}
+
+// ============================================
+// NATIVE SHIM
+// ============================================
+#ifdef NATIVE_TEST
+void ResourceMonitor::setSimulatedStackFree(void* handle, uint32_t free_bytes) {
+    for (size_t i = 0; i < s_sim_stack_count; i++) {
+        if (s_sim_stacks[i].handle == handle) {
+            s_sim_stacks[i].free_bytes = free_bytes;
+            return;
+        }
+    }
+    if (s_sim_stack_count < 8) {
+        s_sim_stacks[s_sim_stack_count].handle = handle;
+        s_sim_stacks[s_sim_stack_count].free_bytes = free_bytes;
+        s_sim_stack_count++;
+    }
+}
+
+void ResourceMonitor::setSimulatedFreeHeap(uint32_t free_bytes) {
+    s_sim_free_heap = free_bytes;
+}
+
+void ResourceMonitor::resetForTest() {
+    // Simulates a reboot: RAM state is cleared, s_rtc_record is kept
+    task_count_ = 0;
+    memset(tasks_, 0, sizeof(tasks_));
+    memset(heap_deltas_, 0, sizeof(heap_deltas_));
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+        heap_deltas_[i].min_free_after = UINT32_MAX;
+    }
+    heap_min_free_ = UINT32_MAX;
+    last_boot_heap_min_free_ = 0;
+    s_sim_stack_count = 0;
+}
+#endif
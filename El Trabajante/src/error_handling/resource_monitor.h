@@ -0,0 +1,110 @@
+#ifndef ERROR_HANDLING_RESOURCE_MONITOR_H
+#define ERROR_HANDLING_RESOURCE_MONITOR_H
+
+#include <Arduino.h>
+
+// ============================================
+// RESOURCE MONITOR (Stack + Heap Watermarks)
+// ============================================
+// Collects uxTaskGetStackHighWaterMark() for every registered task and heap
+// deltas around key operations. Per-task minimum free stack is mirrored into
+// RTC no-init memory, so the last-known watermarks survive watchdog/panic
+// resets and are reported on the next boot (not across power-on).
+//
+// Sizing feedback: suggestStackBytes() = peak usage + 25 % + 1 KB, rounded up
+// to 512 B. Diagnostics carry both the suggestion and the configured size.
+//
+// NATIVE_TEST: stack/heap readings come from setSimulated*() instead of FreeRTOS.
+// ============================================
+
+enum class HeapSubsystem : uint8_t {
+    CONFIG_APPLY = 0,     // processConfigUpdateQueue() apply (Core 1)
+    HEARTBEAT_BUILD,      // MQTTClient::publishHeartbeat() payload assembly (Core 0)
+    COMMAND_HANDLING,     // actuator + system command handlers
+    COUNT
+};
+
+struct TaskWatermark {
+    char name[16];
+    void* handle;                       // TaskHandle_t; nullptr = resolve by name per sample
+    uint32_t stack_bytes;               // Configured stack size
+    uint32_t min_free_bytes;            // Lowest free stack seen this boot (UINT32_MAX = unsampled)
+    uint32_t last_boot_min_free_bytes;  // From RTC after warm reset (0 = unknown)
+    uint32_t samples;
+};
+
+struct HeapDeltaStats {
+    uint32_t count;
+    int32_t last_delta;       // Bytes retained by the last operation (free_before - free_after)
+    int32_t max_delta;        // Largest retained delta seen
+    uint32_t min_free_after;  // Lowest free heap observed right after the operation
+};
+
+class ResourceMonitor {
+public:
+    static ResourceMonitor& getInstance();
+
+    // restore_last_boot: true after a warm reset (WDT/panic/SW) — adopt RTC watermarks.
+    void begin(bool restore_last_boot);
+
+    bool registerTask(const char* name, void* handle, uint32_t stack_bytes);
+    void sample();
+
+    void recordHeapDelta(HeapSubsystem subsystem, uint32_t free_before, uint32_t free_after);
+    uint32_t readFreeHeap() const;
+
+    size_t getTaskCount() const { return task_count_; }
+    const TaskWatermark* getTask(size_t index) const;
+    const TaskWatermark* findTask(const char* name) const;
+    HeapDeltaStats getHeapDelta(HeapSubsystem subsystem) const;
+    uint32_t getLastBootHeapMinFree() const { return last_boot_heap_min_free_; }
+
+    static uint32_t suggestStackBytes(uint32_t stack_bytes, uint32_t min_free_bytes);
+    static const char* getSubsystemName(HeapSubsystem subsystem);
+
+    // Appends ,"stack_hwm":[...],"heap_delta":{...} to a diagnostics JSON object body.
+    void appendDiagnosticsJson(String& json) const;
+
+#ifdef NATIVE_TEST
+    void setSimulatedStackFree(void* handle, uint32_t free_bytes);
+    void setSimulatedFreeHeap(uint32_t free_bytes);
+    void resetForTest();
+#endif
+
+private:
+    ResourceMonitor();
+    ~ResourceMonitor() = default;
+    ResourceMonitor(const ResourceMonitor&) = delete;
+    ResourceMonitor& operator=(const ResourceMonitor&) = delete;
+
+    static const size_t MAX_TASKS = 8;
+    static const size_t SUBSYSTEM_COUNT = static_cast<size_t>(HeapSubsystem::COUNT);
+
+    TaskWatermark tasks_[MAX_TASKS];
+    size_t task_count_;
+    HeapDeltaStats heap_deltas_[SUBSYSTEM_COUNT];
+    uint32_t heap_min_free_;
+    uint32_t last_boot_heap_min_free_;
+
+    uint32_t readStackFreeBytes(const TaskWatermark& task) const;
+    uint32_t lastBootMinFreeFor(const char* name) const;
+    void persistToRtc();
+};
+
+// ============================================
+// HEAP DELTA SCOPE (RAII)
+// ============================================
+// Usage: { HeapDeltaScope scope(HeapSubsystem::CONFIG_APPLY); ...apply... }
+class HeapDeltaScope {
+public:
+    explicit HeapDeltaScope(HeapSubsystem subsystem);
+    ~HeapDeltaScope();
+
+private:
+    HeapSubsystem subsystem_;
+    uint32_t free_before_;
+};
+
+extern ResourceMonitor& resourceMonitor;
+
+#endif  // ERROR_HANDLING_RESOURCE_MONITOR_H
@@ -0,0 +1,431 @@
+#include "watchdog_supervisor.h"
+
+#include <cstdint>
+#include <cstring>
+
+#ifndef NATIVE_TEST
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../utils/logger.h"
+
+static const char* TAG = "WDTSUP";
+
+static portMUX_TYPE s_supervisor_mux = portMUX_INITIALIZER_UNLOCKED;
+#define SUPERVISOR_LOCK() portENTER_CRITICAL(&s_supervisor_mux)
+#define SUPERVISOR_UNLOCK() portEXIT_CRITICAL(&s_supervisor_mux)
+#else
+#define SUPERVISOR_LOCK()
+#define SUPERVISOR_UNLOCK()
+#endif
+
+// ============================================
+// RTC PERSISTENCE (survives WDT / panic / SW reset)
+// ============================================
+// Written on every phase transition, so no checksum over the whole record
+// (resource_monitor.cpp writes once per sample). Validity: both magic words
+// intact + all indices in range; a torn write at most misattributes one field.
+struct RtcHeartbeatRecord {
+    char name[16];
+    uint32_t budget_ms;
+    uint32_t last_progress_ms;
+    uint8_t is_loop;            // Uses checkIn() — eligible for "overdue" attribution
+    uint8_t reserved[3];
+};
+
+struct RtcSupervisorRecord {
+    uint32_t magic;
+    uint32_t uptime_ms;                                   // Time of the last update
+    uint32_t heartbeat_count;
+    RtcHeartbeatRecord heartbeats[WDT_SUP_MAX_HEARTBEATS];
+    uint8_t depth[WDT_SUP_CORES];
+    uint8_t stack[WDT_SUP_CORES][WDT_SUP_MAX_DEPTH];      // Heartbeat ids, [depth-1] = innermost
+    uint32_t started_ms[WDT_SUP_CORES][WDT_SUP_MAX_DEPTH];
+    char last_feed[16];
+    uint32_t magic_end;
+};
+
+static const uint32_t RTC_SUPERVISOR_MAGIC = 0x57445350;  // "WDSP"
+static const uint32_t RTC_SUPERVISOR_MAGIC_END = ~RTC_SUPERVISOR_MAGIC;
+
+#ifndef NATIVE_TEST
+RTC_NOINIT_ATTR static RtcSupervisorRecord s_rtc_record;
+#else
+static RtcSupervisorRecord s_rtc_record;
+static uint32_t s_sim_now_ms = 0;
+static uint8_t s_sim_core = 0;
+#endif
+
+static bool isRecordValid(const RtcSupervisorRecord& record) {
+    if (record.magic != RTC_SUPERVISOR_MAGIC || record.magic_end != RTC_SUPERVISOR_MAGIC_END ||
+        record.heartbeat_count > WDT_SUP_MAX_HEARTBEATS) {
+        return false;
+    }
+    for (uint8_t core = 0; core < WDT_SUP_CORES; core++) {
+        if (record.depth[core] > WDT_SUP_MAX_DEPTH) {
+            return false;
+        }
+        for (uint8_t level = 0; level < record.depth[core]; level++) {
+            if (record.stack[core][level] >= record.heartbeat_count) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void copyName(char* dst, const char* src, size_t size) {
+    strncpy(dst, src != nullptr ? src : "", size - 1);
+    dst[size - 1] = '\0';
+}
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+WatchdogSupervisor& watchdogSupervisor = WatchdogSupervisor::getInstance();
+
+WatchdogSupervisor& WatchdogSupervisor::getInstance() {
+    static WatchdogSupervisor instance;
+    return instance;
+}
+
+WatchdogSupervisor::WatchdogSupervisor()
+    : heartbeat_count_(0) {
+    memset(heartbeats_, 0, sizeof(heartbeats_));
+    memset(&last_boot_report_, 0, sizeof(last_boot_report_));
+}
+
+uint32_t WatchdogSupervisor::nowMs() const {
+#ifndef NATIVE_TEST
+    return millis();
+#else
+    return s_sim_now_ms;
+#endif
+}
+
+uint8_t WatchdogSupervisor::currentCore() const {
+#ifndef NATIVE_TEST
+    return static_cast<uint8_t>(xPortGetCoreID()) % WDT_SUP_CORES;
+#else
+    return s_sim_core;
+#endif
+}
+
+// ============================================
+// INITIALIZATION
+// ============================================
+void WatchdogSupervisor::begin(bool restore_last_boot) {
+    memset(&last_boot_report_, 0, sizeof(last_boot_report_));
+    if (restore_last_boot && isRecordValid(s_rtc_record)) {
+        evaluateLastBoot();
+    }
+
+    // Fresh record for this boot; heartbeats registered before begin() are kept
+    SUPERVISOR_LOCK();
+    memset(&s_rtc_record, 0, sizeof(s_rtc_record));
+    s_rtc_record.magic = RTC_SUPERVISOR_MAGIC;
+    s_rtc_record.magic_end = RTC_SUPERVISOR_MAGIC_END;
+    s_rtc_record.heartbeat_count = heartbeat_count_;
+    for (uint8_t i = 0; i < heartbeat_count_; i++) {
+        copyName(s_rtc_record.heartbeats[i].name, heartbeats_[i].name, sizeof(s_rtc_record.heartbeats[i].name));
+        s_rtc_record.heartbeats[i].budget_ms = heartbeats_[i].budget_ms;
+    }
+    SUPERVISOR_UNLOCK();
+
+#ifndef NATIVE_TEST
+    const WdtStallReport& r = last_boot_report_;
+    if (r.valid) {
+        if (r.phase_active) {
+            LOG_W(TAG, String("[WDTSUP] Last boot was in phase '") + r.phase + "'" +
+                       (r.outer_phase[0] != '\0' ? String(" (inside '") + r.outer_phase + "')" : String("")) +
+                       " on core " + String(r.core) + " for >= " + String(r.phase_age_ms) +
+                       " ms (budget " + String(r.phase_budget_ms) + " ms)");
+        }
+        if (r.overdue_heartbeat[0] != '\0') {
+            LOG_W(TAG, String("[WDTSUP] Last boot heartbeat '") + r.overdue_heartbeat +
+                       "' overdue by " + String(r.overdue_ms) + " ms");
+        }
+        LOG_W(TAG, String("[WDTSUP] Last boot feed: '") + r.last_feed + "' uptime " +
+                   String(r.uptime_ms) + " ms");
+    }
+#endif
+}
+
+void WatchdogSupervisor::evaluateLastBoot() {
+    const RtcSupervisorRecord& rec = s_rtc_record;
+    WdtStallReport& report = last_boot_report_;
+    report.valid = true;
+    report.uptime_ms = rec.uptime_ms;
+    copyName(report.last_feed, rec.last_feed, sizeof(report.last_feed));
+
+    // Innermost phase per core; prefer the one furthest past its budget
+    int64_t best_over = INT64_MIN;
+    for (uint8_t core = 0; core < WDT_SUP_CORES; core++) {
+        uint8_t depth = rec.depth[core];
+        if (depth == 0) {
+            continue;
+        }
+        uint8_t id = rec.stack[core][depth - 1];
+        uint32_t age = rec.uptime_ms - rec.started_ms[core][depth - 1];
+        int64_t over = static_cast<int64_t>(age) - static_cast<int64_t>(rec.heartbeats[id].budget_ms);
+        if (over > best_over) {
+            best_over = over;
+            report.phase_active = true;
+            report.core = core;
+            report.phase_age_ms = age;
+            report.phase_budget_ms = rec.heartbeats[id].budget_ms;
+            copyName(report.phase, rec.heartbeats[id].name, sizeof(report.phase));
+            report.outer_phase[0] = '\0';
+            if (depth >= 2) {
+                copyName(report.outer_phase, rec.heartbeats[rec.stack[core][depth - 2]].name,
+                         sizeof(report.outer_phase));
+            }
+        }
+    }
+
+    // Loop heartbeat that stopped checking in (stall outside any phase)
+    uint32_t worst_overdue = 0;
+    for (uint32_t i = 0; i < rec.heartbeat_count; i++) {
+        const RtcHeartbeatRecord& hb = rec.heartbeats[i];
+        if (!hb.is_loop || hb.last_progress_ms == 0 || hb.budget_ms == 0) {
+            continue;
+        }
+        uint32_t silent = rec.uptime_ms - hb.last_progress_ms;
+        if (silent > hb.budget_ms && silent - hb.budget_ms > worst_overdue) {
+            worst_overdue = silent - hb.budget_ms;
+            copyName(report.overdue_heartbeat, hb.name, sizeof(report.overdue_heartbeat));
+        }
+    }
+    report.overdue_ms = worst_overdue;
+}
+
+// ============================================
+// HEARTBEATS
+// ============================================
+uint8_t WatchdogSupervisor::registerHeartbeat(const char* name, uint32_t budget_ms) {
+    if (name == nullptr || name[0] == '\0') {
+        return WDT_SUP_INVALID_ID;
+    }
+
+    uint8_t id = WDT_SUP_INVALID_ID;
+    SUPERVISOR_LOCK();
+    for (uint8_t i = 0; i < heartbeat_count_; i++) {
+        if (strncmp(heartbeats_[i].name, name, sizeof(heartbeats_[i].name) - 1) == 0) {
+            id = i;
+            break;
+        }
+    }
+    if (id == WDT_SUP_INVALID_ID && heartbeat_count_ < WDT_SUP_MAX_HEARTBEATS) {
+        id = heartbeat_count_++;
+        memset(&heartbeats_[id], 0, sizeof(heartbeats_[id]));
+        copyName(heartbeats_[id].name, name, sizeof(heartbeats_[id].name));
+        copyName(s_rtc_record.heartbeats[id].name, name, sizeof(s_rtc_record.heartbeats[id].name));
+        s_rtc_record.heartbeat_count = heartbeat_count_;
+    }
+    if (id != WDT_SUP_INVALID_ID) {
+        heartbeats_[id].budget_ms = budget_ms;
+        s_rtc_record.heartbeats[id].budget_ms = budget_ms;
+    }
+    SUPERVISOR_UNLOCK();
+    return id;
+}
+
+void WatchdogSupervisor::checkIn(uint8_t id) {
+    if (id >= heartbeat_count_) {
+        return;
+    }
+    uint32_t now = nowMs();
+    SUPERVISOR_LOCK();
+    heartbeats_[id].last_progress_ms = now;
+    s_rtc_record.heartbeats[id].last_progress_ms = now;
+    s_rtc_record.heartbeats[id].is_loop = 1;
+    s_rtc_record.uptime_ms = now;
+    SUPERVISOR_UNLOCK();
+}
+
+// ============================================
+// PHASES
+// ============================================
+void WatchdogSupervisor::beginPhase(uint8_t id) {
+    if (id >= heartbeat_count_) {
+        return;
+    }
+    uint32_t now = nowMs();
+    uint8_t core = currentCore();
+    SUPERVISOR_LOCK();
+    uint8_t depth = s_rtc_record.depth[core];
+    if (depth < WDT_SUP_MAX_DEPTH) {
+        s_rtc_record.stack[core][depth] = id;
+        s_rtc_record.started_ms[core][depth] = now;
+        s_rtc_record.depth[core] = depth + 1;
+    }
+    heartbeats_[id].last_progress_ms = now;
+    s_rtc_record.heartbeats[id].last_progress_ms = now;
+    s_rtc_record.uptime_ms = now;
+    SUPERVISOR_UNLOCK();
+}
+
+void WatchdogSupervisor::endPhase(uint8_t id) {
+    if (id >= heartbeat_count_) {
+        return;
+    }
+    uint32_t now = nowMs();
+    uint8_t core = currentCore();
+    bool overrun = false;
+    uint32_t duration = 0;
+
+    SUPERVISOR_LOCK();
+    uint8_t depth = s_rtc_record.depth[core];
+    // Pop down to the matching level (tolerates a missed endPhase of an inner phase)
+    for (uint8_t level = depth; level > 0; level--) {
+        if (s_rtc_record.stack[core][level - 1] == id) {
+            duration = now - s_rtc_record.started_ms[core][level - 1];
+            s_rtc_record.depth[core] = level - 1;
+
+            WdtHeartbeatStats& hb = heartbeats_[id];
+            hb.count++;
+            if (duration > hb.max_duration_ms) {
+                hb.max_duration_ms = duration;
+            }
+            if (hb.budget_ms > 0 && duration > hb.budget_ms) {
+                hb.overruns++;
+                overrun = true;
+            }
+            break;
+        }
+    }
+    heartbeats_[id].last_progress_ms = now;
+    s_rtc_record.heartbeats[id].last_progress_ms = now;
+    s_rtc_record.uptime_ms = now;
+    SUPERVISOR_UNLOCK();
+
+#ifndef NATIVE_TEST
+    if (overrun) {
+        LOG_W(TAG, String("[WDTSUP] Phase '") + heartbeats_[id].name + "' took " + String(duration) +
+                   " ms (budget " + String(heartbeats_[id].budget_ms) + " ms)");
+    }
+#else
+    (void)overrun;
+#endif
+}
+
+void WatchdogSupervisor::noteFeed(const char* component_id) {
+    uint32_t now = nowMs();
+    SUPERVISOR_LOCK();
+    copyName(s_rtc_record.last_feed, component_id, sizeof(s_rtc_record.last_feed));
+    s_rtc_record.uptime_ms = now;
+    SUPERVISOR_UNLOCK();
+}
+
+uint8_t WatchdogSupervisor::findOverrunningPhase(uint32_t* age_ms) const {
+    uint32_t now = nowMs();
+    uint8_t found = WDT_SUP_INVALID_ID;
+    uint32_t found_age = 0;
+
+    SUPERVISOR_LOCK();
+    for (uint8_t core = 0; core < WDT_SUP_CORES; core++) {
+        uint8_t depth = s_rtc_record.depth[core];
+        if (depth == 0) {
+            continue;
+        }
+        uint8_t id = s_rtc_record.stack[core][depth - 1];
+        uint32_t age = now - s_rtc_record.started_ms[core][depth - 1];
+        if (id < heartbeat_count_ && heartbeats_[id].budget_ms > 0 &&
+            age > heartbeats_[id].budget_ms && age > found_age) {
+            found = id;
+            found_age = age;
+        }
+    }
+    SUPERVISOR_UNLOCK();
+
+    if (age_ms != nullptr) {
+        *age_ms = found_age;
+    }
+    return found;
+}
+
+const WdtHeartbeatStats* WatchdogSupervisor::getHeartbeat(uint8_t id) const {
+    return id < heartbeat_count_ ? &heartbeats_[id] : nullptr;
+}
+
+const WdtHeartbeatStats* WatchdogSupervisor::findHeartbeat(const char* name) const {
+    if (name == nullptr) {
+        return nullptr;
+    }
+    for (uint8_t i = 0; i < heartbeat_count_; i++) {
+        if (strncmp(heartbeats_[i].name, name, sizeof(heartbeats_[i].name) - 1) == 0) {
+            return &heartbeats_[i];
+        }
+    }
+    return nullptr;
+}
+
+// ============================================
+// DIAGNOSTICS
+// ============================================
+void WatchdogSupervisor::appendDiagnosticsJson(String& json) const {
+    // Compact keys: n=name, b=budget ms, max=longest phase ms, ovr=overruns.
+    // prev: ph=phase, out=outer phase, age=phase runtime ms, hb=overdue heartbeat,
+    // late=ms past budget, feed=last feed component, up=uptime ms.
+    char buf[128];
+    json += ",\"wdt_sup\":{\"hb\":[";
+    for (uint8_t i = 0; i < heartbeat_count_; i++) {
+        const WdtHeartbeatStats& hb = heartbeats_[i];
+        snprintf(buf, sizeof(buf), "%s{\"n\":\"%s\",\"b\":%lu,\"max\":%lu,\"ovr\":%lu}",
+                 i == 0 ? "" : ",",
+                 hb.name,
+                 static_cast<unsigned long>(hb.budget_ms),
+                 static_cast<unsigned long>(hb.max_duration_ms),
+                 static_cast<unsigned long>(hb.overruns));
+        json += buf;
+    }
+    json += "]";
+
+    const WdtStallReport& r = last_boot_report_;
+    if (r.valid) {
+        snprintf(buf, sizeof(buf),
+                 ",\"prev\":{\"ph\":\"%s\",\"out\":\"%s\",\"core\":%u,\"age\":%lu,",
+                 r.phase, r.outer_phase, static_cast<unsigned>(r.core),
+                 static_cast<unsigned long>(r.phase_age_ms));
+        json += buf;
+        snprintf(buf, sizeof(buf), "\"hb\":\"%s\",\"late\":%lu,\"feed\":\"%s\",\"up\":%lu}",
+                 r.overdue_heartbeat, static_cast<unsigned long>(r.overdue_ms),
+                 r.last_feed, static_cast<unsigned long>(r.uptime_ms));
+        json += buf;
+    }
+    json += "}";
+}
+
+// ============================================
+// PHASE SCOPE
+// ============================================
+WdtPhaseScope::WdtPhaseScope(uint8_t id)
+    : id_(id) {
+    watchdogSupervisor.beginPhase(id_);
+}
+
+WdtPhaseScope::~WdtPhaseScope() {
+    watchdogSupervisor.endPhase(id_);
+}
+
+// ============================================
+// NATIVE SHIM
+// ============================================
+#ifdef NATIVE_TEST
+void WatchdogSupervisor::setSimulatedTime(uint32_t now_ms) {
+    s_sim_now_ms = now_ms;
+}
+
+void WatchdogSupervisor::setSimulatedCore(uint8_t core) {
+    s_sim_core = core % WDT_SUP_CORES;
+}
+
+void WatchdogSupervisor::resetForTest() {
+    // Simulates a reboot: RAM state is cleared, s_rtc_record is kept
+    heartbeat_count_ = 0;
+    memset(heartbeats_, 0, sizeof(heartbeats_));
+    memset(&last_boot_report_, 0, sizeof(last_boot_report_));
+    s_sim_now_ms = 0;
+    s_sim_core = 0;
+}
+#endif
@@ -0,0 +1,121 @@
+#ifndef ERROR_HANDLING_WATCHDOG_SUPERVISOR_H
+#define ERROR_HANDLING_WATCHDOG_SUPERVISOR_H
+
+#include <Arduino.h>
+
+// ============================================
+// WATCHDOG SUPERVISOR (Heartbeats + Stall Attribution)
+// ============================================
+// The task watchdog only tells us THAT a task stopped feeding, not WHERE.
+// Each subsystem registers a named heartbeat with a time budget and wraps
+// long-running work in a phase (WdtPhaseScope). The currently executing phase
+// stack per core, last-progress timestamps and the last feedWatchdog()
+// component live in RTC no-init memory, so after a task-WDT / panic reset the
+// next boot reports which phase was running and for how long.
+//
+// Phases nest (e.g. config_apply > nvs_commit), max WDT_SUP_MAX_DEPTH per core.
+// Phases exceeding their budget are counted as overruns at runtime.
+//
+// NATIVE_TEST: time and core id come from setSimulated*() instead of FreeRTOS.
+// ============================================
+
+static const uint8_t WDT_SUP_MAX_HEARTBEATS = 12;
+static const uint8_t WDT_SUP_MAX_DEPTH = 4;
+static const uint8_t WDT_SUP_CORES = 2;
+static const uint8_t WDT_SUP_INVALID_ID = 0xFF;
+
+struct WdtHeartbeatStats {
+    char name[16];
+    uint32_t budget_ms;
+    uint32_t last_progress_ms;   // Last check-in or phase begin/end (0 = never)
+    uint32_t max_duration_ms;    // Longest completed phase this boot
+    uint32_t overruns;           // Completed phases longer than budget_ms
+    uint32_t count;              // Completed phases
+};
+
+// Attribution of the previous boot's last state (valid only after a warm reset)
+struct WdtStallReport {
+    bool valid;
+    bool phase_active;           // A phase was executing when the record was last written
+    char phase[16];              // Innermost executing phase
+    char outer_phase[16];        // Enclosing phase ("" if none)
+    uint8_t core;
+    uint32_t phase_age_ms;       // Runtime of the phase at the last record update (lower bound)
+    uint32_t phase_budget_ms;
+    char overdue_heartbeat[16];  // Heartbeat most overdue relative to its budget ("" if none)
+    uint32_t overdue_ms;         // Time past budget at the last record update
+    char last_feed[16];          // Last feedWatchdog() component
+    uint32_t uptime_ms;          // Uptime at the last record update
+};
+
+class WatchdogSupervisor {
+public:
+    static WatchdogSupervisor& getInstance();
+
+    // restore_last_boot: true after a warm reset (WDT/panic/SW) — evaluate RTC record.
+    void begin(bool restore_last_boot);
+
+    // Idempotent by name — returns the existing id on re-registration.
+    uint8_t registerHeartbeat(const char* name, uint32_t budget_ms);
+
+    // Loop-style progress (no phase): "still alive" for this heartbeat
+    void checkIn(uint8_t id);
+
+    // Phase nesting on the calling core; endPhase() pops the innermost phase
+    void beginPhase(uint8_t id);
+    void endPhase(uint8_t id);
+
+    // Called from feedWatchdog(): remembers the component across reset
+    void noteFeed(const char* component_id);
+
+    // Innermost running phase on any core that exceeds its budget right now
+    // (WDT_SUP_INVALID_ID if none). Used for live diagnostics.
+    uint8_t findOverrunningPhase(uint32_t* age_ms = nullptr) const;
+
+    const WdtHeartbeatStats* getHeartbeat(uint8_t id) const;
+    const WdtHeartbeatStats* findHeartbeat(const char* name) const;
+    uint8_t getHeartbeatCount() const { return heartbeat_count_; }
+    const WdtStallReport& getLastBootReport() const { return last_boot_report_; }
+
+    // Appends ,"wdt_sup":{...} to a diagnostics JSON object body.
+    void appendDiagnosticsJson(String& json) const;
+
+#ifdef NATIVE_TEST
+    void setSimulatedTime(uint32_t now_ms);
+    void setSimulatedCore(uint8_t core);
+    void resetForTest();
+#endif
+
+private:
+    WatchdogSupervisor();
+    ~WatchdogSupervisor() = default;
+    WatchdogSupervisor(const WatchdogSupervisor&) = delete;
+    WatchdogSupervisor& operator=(const WatchdogSupervisor&) = delete;
+
+    WdtHeartbeatStats heartbeats_[WDT_SUP_MAX_HEARTBEATS];
+    uint8_t heartbeat_count_;
+    WdtStallReport last_boot_report_;
+
+    uint32_t nowMs() const;
+    uint8_t currentCore() const;
+    void evaluateLastBoot();
+};
+
+// ============================================
+// PHASE SCOPE (RAII)
+// ============================================
+// Usage:
+//   static const uint8_t HB = watchdogSupervisor.registerHeartbeat("onewire_conv", 1500);
+//   { WdtPhaseScope phase(HB); ...conversion... }
+class WdtPhaseScope {
+public:
+    explicit WdtPhaseScope(uint8_t id);
+    ~WdtPhaseScope();
+
+private:
+    uint8_t id_;
+};
+
+extern WatchdogSupervisor& watchdogSupervisor;
+
+#endif  // ERROR_HANDLING_WATCHDOG_SUPERVISOR_H
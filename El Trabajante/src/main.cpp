@@ -21,12 +21,17 @@
 #include "tasks/emergency_broadcast_contract.h"
 #include "drivers/gpio_manager.h"
 #include "utils/logger.h"
+#include "utils/log_shipper.h"
+#include "services/config/library_manager.h"
 #include "services/config/storage_manager.h"
 #include "services/config/config_manager.h"
 #include "services/config/config_response.h"
 #include "services/config/runtime_readiness_policy.h"
 #include "error_handling/error_tracker.h"
 #include "error_handling/health_monitor.h"
+#include "error_handling/resource_monitor.h"
+#include "error_handling/watchdog_supervisor.h"
+#include "services/power/power_manager.h"
 #include "models/config_types.h"
 #include "models/error_codes.h"
 #include "utils/topic_builder.h"
@@ -40,6 +45,11 @@
 #include "drivers/i2c_bus.h"
 #include "drivers/onewire_bus.h"
 #include "drivers/pwm_controller.h"
+#include "drivers/adc_sampler.h"
+#include "drivers/pulse_counter.h"
+#include "drivers/digital_input.h"
+#include "drivers/sensor_excitation.h"
+#include "core/system_controller.h"
 
 // OneWire utilities for ROM-Code conversion (Phase 4: OneWire-Scan)
 #include "utils/onewire_utils.h"
@@ -56,7 +66,9 @@
 
 // Phase 4: Sensor System
 #include "services/sensor/sensor_manager.h"
+#include "services/sensor/temperature_compensation.h"
 #include "models/sensor_types.h"
+#include "models/sensor_registry.h"  // getServerSensorType (temp_source_type)
 
 // Phase 5: Actuator System
 #include "services/actuator/actuator_manager.h"
@@ -539,24 +551,7 @@ static RuntimeReadinessSnapshot collectRuntimeReadinessSnapshot() {
 }
 
 static const char* systemStateToString(SystemState state) {
-  switch (state) {
-    case STATE_BOOT: return "BOOT";
-    case STATE_WIFI_SETUP: return "WIFI_SETUP";
-    case STATE_WIFI_CONNECTED: return "WIFI_CONNECTED";
-    case STATE_MQTT_CONNECTING: return "MQTT_CONNECTING";
-    case STATE_MQTT_CONNECTED: return "MQTT_CONNECTED";
-    case STATE_AWAITING_USER_CONFIG: return "AWAITING_USER_CONFIG";
-    case STATE_ZONE_CONFIGURED: return "ZONE_CONFIGURED";
-    case STATE_SENSORS_CONFIGURED: return "SENSORS_CONFIGURED";
-    case STATE_CONFIG_PENDING_AFTER_RESET: return "CONFIG_PENDING_AFTER_RESET";
-    case STATE_OPERATIONAL: return "OPERATIONAL";
-    case STATE_PENDING_APPROVAL: return "PENDING_APPROVAL";
-    case STATE_LIBRARY_DOWNLOADING: return "LIBRARY_DOWNLOADING";
-    case STATE_SAFE_MODE: return "SAFE_MODE";
-    case STATE_SAFE_MODE_PROVISIONING: return "SAFE_MODE_PROVISIONING";
-    case STATE_ERROR: return "ERROR";
-    default: return "UNKNOWN";
-  }
+  return SystemController::stateName(state);
 }
 
 static void publishConfigPendingTransitionEvent(const char* event_type,
@@ -600,6 +595,40 @@ static void publishConfigPendingTransitionEvent(const char* event_type,
   }
 }
 
+// ============================================
+// SYSTEM STATE ACTIONS (SystemController entry/exit hooks)
+// ============================================
+// Side effects that belong to a state rather than to the caller that caused
+// the transition. Persisting (saveSystemConfig) stays with the caller.
+static void onEnterOperational(SystemState from, SystemState to, SystemEvent event) {
+  (void)from; (void)to; (void)event;
+  g_system_config.safe_mode_reason = "";
+}
+
+static void onEnterConfigPending(SystemState from, SystemState to, SystemEvent event) {
+  (void)from; (void)to; (void)event;
+  g_system_config.safe_mode_reason = "CONFIG_PENDING_AFTER_RESET";
+  g_config_pending_enter_count.fetch_add(1);
+}
+
+static void onExitConfigPending(SystemState from, SystemState to, SystemEvent event) {
+  (void)from; (void)to; (void)event;
+  g_config_pending_exit_count.fetch_add(1);
+}
+
+static void onSystemStateTransition(SystemState from, SystemState to, SystemEvent event) {
+  (void)from; (void)to; (void)event;
+  // Comm-Task re-dispatches its lanes now instead of on the next poll
+  notifyCommTaskStateChange();
+}
+
+static void registerSystemStateActions() {
+  systemController.setStateActions(STATE_OPERATIONAL, onEnterOperational, nullptr);
+  systemController.setStateActions(STATE_CONFIG_PENDING_AFTER_RESET,
+                                   onEnterConfigPending, onExitConfigPending);
+  systemController.setTransitionListener(onSystemStateTransition);
+}
+
 bool evaluatePendingExit(const char* trigger_source) {
   if (!isConfigPendingAfterResetState()) {
     return false;
@@ -624,15 +653,16 @@ bool evaluatePendingExit(const char* trigger_source) {
     return false;
   }
 
-  SystemState target_state = configManager.isDeviceApproved()
-      ? STATE_OPERATIONAL
-      : STATE_PENDING_APPROVAL;
-
-  g_system_config.current_state = target_state;
+  SystemEvent ready_event = configManager.isDeviceApproved()
+      ? SystemEvent::CONFIG_READY_APPROVED
+      : SystemEvent::CONFIG_READY_UNAPPROVED;
+  if (!systemController.handleEvent(ready_event, millis())) {
+    return false;
+  }
+  SystemState target_state = g_system_config.current_state;
   g_system_config.safe_mode_reason = "";
   configManager.saveSystemConfig(g_system_config);
 
-  g_config_pending_exit_count.fetch_add(1);
   publishConfigPendingTransitionEvent("exited_config_pending",
                                       "CONFIG_PENDING_EXIT_READY",
                                       readiness,
@@ -670,8 +700,14 @@ void subscribeToAllTopics() {
   mqttClient.queueSubscribe(sensor_wildcard, 2, false);
 
   mqttClient.queueSubscribe(TopicBuilder::buildServerStatusTopic(), 1, false);  // SAFETY-P5: Server LWT (QoS 1)
+#ifdef OTA_LIBRARY_ENABLED
+  mqttClient.queueSubscribe(TopicBuilder::buildSystemOtaChunkTopic(), 1, false);
+
+  LOG_I(TAG, "[SAFETY-P1] Subscription queue prepared (13 topics, staged dispatch)");
+#else
 
   LOG_I(TAG, "[SAFETY-P1] Subscription queue prepared (12 topics, staged dispatch)");
+#endif
 }
 
 // ============================================
@@ -721,6 +757,15 @@ void onMqttConnectCallback() {
 //
 // M3 will migrate remaining direct-call handlers (config, zone, subzone) to queues.
 void routeIncomingMessage(const char* t, const char* p) {
+#ifdef OTA_LIBRARY_ENABLED
+    // OTA chunks (up to ~5.5 KB base64, hundreds per update): handled before
+    // the String copies and per-message logging below
+    if (strcmp(t, TopicBuilder::buildSystemOtaChunkTopic()) == 0) {
+        libraryManager.handleChunkMessage(p);
+        return;
+    }
+#endif
+
     // Wrap raw char* to String — existing handler code uses String comparisons
     const String topic(t);
     const String payload(p);
@@ -1228,10 +1273,12 @@ void routeIncomingMessage(const char* t, const char* p) {
     String system_command_topic = String(TopicBuilder::buildSystemCommandTopic());
 
     if (topic == system_command_topic) {
+        HeapDeltaScope heap_scope(HeapSubsystem::COMMAND_HANDLING);
         LOG_I(TAG, "Topic matched! Parsing JSON payload...");
         LOG_I(TAG, "Payload: " + payload);
 
-        DynamicJsonDocument doc(256);
+        // Largest command: ota_begin (9 manifest fields incl. 64-char SHA-256)
+        DynamicJsonDocument doc(512);
         DeserializationError error = deserializeJson(doc, payload);
 
         if (error) {
@@ -1326,6 +1373,7 @@ void routeIncomingMessage(const char* t, const char* p) {
 
             LOG_I(TAG, "✅ Configuration cleared via MQTT");
             LOG_I(TAG, "Rebooting in 3 seconds...");
+            flushIntentOutcomeBatches(true);
             delay(3000);
             ESP.restart();
         }
@@ -1343,7 +1391,8 @@ void routeIncomingMessage(const char* t, const char* p) {
             }
             LOG_I(TAG, "OneWire scan on GPIO " + String(pin));
 
-            if (!oneWireBusManager.isInitialized()) {
+            // Buses are per pin: scanning another pin no longer tears down the active bus
+            if (!oneWireBusManager.isInitialized(pin)) {
                 LOG_I(TAG, "Initializing OneWire bus on GPIO " + String(pin));
                 if (!oneWireBusManager.begin(pin)) {
                     LOG_E(TAG, "Failed to initialize OneWire bus on GPIO " + String(pin));
@@ -1352,28 +1401,13 @@ void routeIncomingMessage(const char* t, const char* p) {
                     mqttClient.publish(system_command_topic + "/response", error_response);
                     return;
                 }
-            } else {
-                uint8_t current_pin = oneWireBusManager.getPin();
-                if (current_pin != pin) {
-                    LOG_I(TAG, "OneWire bus switching from GPIO " + String(current_pin) +
-                               " to GPIO " + String(pin));
-                    oneWireBusManager.end();
-                    if (!oneWireBusManager.begin(pin)) {
-                        LOG_E(TAG, "Failed to switch OneWire bus to GPIO " + String(pin));
-                        oneWireBusManager.begin(current_pin);
-                        String error_response = "{\"error\":\"Failed to switch OneWire bus\",\"requested_pin\":" +
-                                               String(pin) + ",\"active_pin\":" + String(current_pin) + ",\"seq\":" + String(mqttClient.getNextSeq()) + "}";
-                        mqttClient.publish(system_command_topic + "/response", error_response);
-                        return;
-                    }
-                }
             }
 
             uint8_t rom_codes[10][8];
             uint8_t found_count = 0;
 
             LOG_I(TAG, "Scanning OneWire bus...");
-            if (!oneWireBusManager.scanDevices(rom_codes, 10, found_count)) {
+            if (!oneWireBusManager.scanDevices(pin, rom_codes, 10, found_count)) {
                 LOG_E(TAG, "OneWire bus scan failed");
                 String error_response = "{\"error\":\"OneWire scan failed\",\"pin\":" + String(pin) + ",\"seq\":" + String(mqttClient.getNextSeq()) + "}";
                 mqttClient.publish(system_command_topic + "/response", error_response);
@@ -1453,11 +1487,26 @@ void routeIncomingMessage(const char* t, const char* p) {
 
             time_t unix_timestamp = timeManager.getUnixTimestamp();
 
-            DynamicJsonDocument response_doc(2048);
+            DynamicJsonDocument response_doc(3072);
             response_doc["command"] = "diagnostics";
             response_doc["success"] = true;
             response_doc["esp_id"] = g_system_config.esp_id;
             response_doc["state"] = static_cast<int>(g_system_config.current_state);
+            response_doc["state_name"] = systemStateToString(g_system_config.current_state);
+            {
+                SystemTransitionRecord transitions[SYSTEM_TRANSITION_LOG_SIZE];
+                uint8_t transition_count =
+                    systemController.getTransitionLog(transitions, SYSTEM_TRANSITION_LOG_SIZE);
+                JsonArray transition_array = response_doc.createNestedArray("state_transitions");
+                for (uint8_t i = 0; i < transition_count; i++) {
+                    JsonObject entry = transition_array.createNestedObject();
+                    entry["ts_ms"] = transitions[i].timestamp_ms;
+                    entry["from"] = SystemController::stateName(transitions[i].from);
+                    entry["to"] = SystemController::stateName(transitions[i].to);
+                    entry["event"] = SystemController::eventName(transitions[i].event);
+                }
+                response_doc["state_transition_total"] = systemController.getTransitionCount();
+            }
             response_doc["uptime"] = millis() / 1000;
             response_doc["heap_free"] = ESP.getFreeHeap();
             response_doc["heap_min"] = ESP.getMinFreeHeap();
@@ -1573,6 +1622,8 @@ void routeIncomingMessage(const char* t, const char* p) {
             LOG_I(TAG, "Safe mode deactivated via command");
         }
         // ─── Set Log Level ───────────────────────────────────────────────────
+        // Optional "module" (TAG, e.g. "I2C") sets a per-module override instead of
+        // the global level. level "DEFAULT" removes the override, module "*" clears all.
         else if (command == "set_log_level") {
             LOG_I(TAG, "╔════════════════════════════════════════╗");
             LOG_I(TAG, "║  SET_LOG_LEVEL COMMAND RECEIVED       ║");
@@ -1585,38 +1636,88 @@ void routeIncomingMessage(const char* t, const char* p) {
                 level = doc["params"]["level"].as<String>();
             }
             level.toUpperCase();
-            LOG_I(TAG, "Requested log level: " + level);
 
-            LogLevel new_level = Logger::getLogLevelFromString(level.c_str());
+            String module;
+            if (doc.containsKey("module")) {
+                module = doc["module"].as<String>();
+            } else if (doc.containsKey("params") && doc["params"].containsKey("module")) {
+                module = doc["params"]["module"].as<String>();
+            }
+            module.toUpperCase();
+            LOG_I(TAG, "Requested log level: " + level +
+                       (module.length() > 0 ? " (module " + module + ")" : String("")));
 
-            bool valid = (level.length() > 0 &&
-                         (level == "DEBUG" || level == "INFO" || level == "WARNING" ||
-                          level == "ERROR" || level == "CRITICAL"));
+            LogLevel new_level = LOG_INFO;
+            bool level_valid = level.length() > 0 && Logger::tryParseLogLevel(level.c_str(), &new_level);
+            bool reset_module = module.length() > 0 && level == "DEFAULT";
+            bool valid = module.length() > 0 ? (level_valid || reset_module) : level_valid;
 
-            DynamicJsonDocument response_doc(256);
+            DynamicJsonDocument response_doc(384);
             response_doc["command"] = "set_log_level";
             response_doc["esp_id"] = g_system_config.esp_id;
 
+            if (valid && module.length() > 0) {
+                bool applied = true;
+                if (module == "*") {
+                    if (reset_module) {
+                        logger.clearTagLogLevels();
+                    } else {
+                        applied = false;
+                    }
+                } else if (reset_module) {
+                    logger.clearTagLogLevel(module.c_str());
+                } else {
+                    applied = logger.setTagLogLevel(module.c_str(), new_level);
+                }
+                valid = applied;
+            }
+
             if (valid) {
-                logger.setLogLevel(new_level);
+                bool persisted = false;
+                char module_spec[128];
+                logger.formatTagLogLevelSpec(module_spec, sizeof(module_spec));
+
+                if (module.length() == 0) {
+                    logger.setLogLevel(new_level);
+                }
 
                 if (storageManager.beginNamespace("system_config", false)) {
-                    storageManager.putUInt8("log_level", (uint8_t)new_level);
+                    if (module.length() == 0) {
+                        persisted = storageManager.putUInt8("log_level", (uint8_t)new_level);
+                    } else if (module_spec[0] == '\0') {
+                        persisted = !storageManager.keyExists("log_tags") ||
+                                    storageManager.eraseKey("log_tags");
+                    } else {
+                        persisted = storageManager.putString("log_tags", module_spec);
+                    }
                     storageManager.endNamespace();
                 }
 
                 response_doc["success"] = true;
                 response_doc["level"] = level;
-                response_doc["message"] = "Log level changed to " + level;
-                response_doc["persisted"] = true;
+                if (module.length() > 0) {
+                    response_doc["module"] = module;
+                }
+                response_doc["modules"] = module_spec;
+                response_doc["message"] = module.length() > 0
+                    ? "Module " + module + " log level set to " + level
+                    : "Log level changed to " + level;
+                response_doc["persisted"] = persisted;
                 response_doc["ts"] = (unsigned long)timeManager.getUnixTimestamp();
 
-                LOG_I(TAG, "✅ Log level changed to " + level + " (persisted to NVS)");
+                LOG_I(TAG, "✅ Log level changed to " + level +
+                           (module.length() > 0 ? " for module " + module : String("")) +
+                           (persisted ? " (persisted to NVS)" : " (NOT persisted)"));
             } else {
                 response_doc["success"] = false;
                 response_doc["error"] = "Invalid log level";
-                response_doc["message"] = "Valid levels: DEBUG, INFO, WARNING, ERROR, CRITICAL";
+                response_doc["message"] = module.length() > 0
+                    ? "Valid levels: DEBUG, INFO, WARNING, ERROR, CRITICAL, DEFAULT (max 8 modules, TAG < 12 chars)"
+                    : "Valid levels: DEBUG, INFO, WARNING, ERROR, CRITICAL";
                 response_doc["requested_level"] = level;
+                if (module.length() > 0) {
+                    response_doc["module"] = module;
+                }
                 response_doc["ts"] = (unsigned long)timeManager.getUnixTimestamp();
 
                 LOG_E(TAG, "❌ Invalid log level: " + level);
@@ -1628,6 +1729,147 @@ void routeIncomingMessage(const char* t, const char* p) {
             serializeJson(response_doc, response);
             mqttClient.publish(system_command_topic + "/response", response);
         }
+        // ─── Set Log Shipping ────────────────────────────────────────────────
+        // Remote log frames on .../system/log. Partial update: omitted fields keep
+        // their current value. Budgets cap what the node may put on the link.
+        else if (command == "set_log_shipping") {
+            LOG_I(TAG, "SET_LOG_SHIPPING command received");
+
+            JsonVariant params = doc.containsKey("params") ? doc["params"].as<JsonVariant>() : doc.as<JsonVariant>();
+            LogShipperConfig ship_config = logShipper.getConfig();
+            bool valid = true;
+
+            if (params.containsKey("enabled")) {
+                ship_config.enabled = params["enabled"].as<bool>();
+            }
+            if (params.containsKey("level")) {
+                String level = params["level"].as<String>();
+                level.toUpperCase();
+                valid = Logger::tryParseLogLevel(level.c_str(), &ship_config.min_level);
+            }
+            if (params.containsKey("bytes_per_min")) {
+                uint32_t bytes = params["bytes_per_min"].as<uint32_t>();
+                valid = valid && bytes >= 256 && bytes <= 65535;
+                ship_config.bytes_per_min = static_cast<uint16_t>(bytes);
+            }
+            if (params.containsKey("msgs_per_min")) {
+                uint32_t msgs = params["msgs_per_min"].as<uint32_t>();
+                valid = valid && msgs >= 1 && msgs <= 60;
+                ship_config.msgs_per_min = static_cast<uint8_t>(msgs);
+            }
+
+            DynamicJsonDocument response_doc(384);
+            response_doc["command"] = "set_log_shipping";
+            response_doc["esp_id"] = g_system_config.esp_id;
+
+            if (valid) {
+                logShipper.begin(ship_config, millis());
+                bool persisted = false;
+                if (storageManager.beginNamespace("system_config", false)) {
+                    persisted = storageManager.putULong("log_ship", LogShipper::packConfig(ship_config));
+                    storageManager.endNamespace();
+                }
+                response_doc["success"] = true;
+                response_doc["persisted"] = persisted;
+                LOG_I(TAG, String("Log shipping ") + (ship_config.enabled ? "enabled" : "disabled") +
+                           " (level " + Logger::getLogLevelString(ship_config.min_level) +
+                           ", " + String(ship_config.bytes_per_min) + " B/min, " +
+                           String(ship_config.msgs_per_min) + " msg/min)");
+            } else {
+                response_doc["success"] = false;
+                response_doc["error"] = "Invalid log shipping config";
+                response_doc["message"] = "level: DEBUG..CRITICAL, bytes_per_min: 256-65535, msgs_per_min: 1-60";
+                LOG_E(TAG, "Invalid set_log_shipping parameters");
+            }
+
+            const LogShipperConfig& active = logShipper.getConfig();
+            response_doc["enabled"] = active.enabled;
+            response_doc["level"] = Logger::getLogLevelString(active.min_level);
+            response_doc["bytes_per_min"] = active.bytes_per_min;
+            response_doc["msgs_per_min"] = active.msgs_per_min;
+            response_doc["ts"] = (unsigned long)timeManager.getUnixTimestamp();
+            response_doc["seq"] = mqttClient.getNextSeq();
+
+            String response;
+            serializeJson(response_doc, response);
+            mqttClient.publish(system_command_topic + "/response", response);
+        }
+        // ─── Pulse Counter Reset ─────────────────────────────────────────────
+        // Restarts the total (flow_total / rain_total) of a flow meter or rain gauge,
+        // applied with the next measurement. Params: gpio
+        else if (command == "pulse_counter_reset") {
+            JsonVariant params = doc.containsKey("params") ? doc["params"].as<JsonVariant>() : doc.as<JsonVariant>();
+            uint8_t gpio = params["gpio"] | 255;
+            bool ok = pulseCounter.resetTotal(gpio);
+            LOG_I(TAG, "Pulse counter reset GPIO " + String(gpio) + (ok ? " scheduled" : " failed (not attached)"));
+
+            DynamicJsonDocument response_doc(256);
+            response_doc["command"] = "pulse_counter_reset";
+            response_doc["esp_id"] = g_system_config.esp_id;
+            response_doc["gpio"] = gpio;
+            response_doc["success"] = ok;
+            if (!ok) {
+                response_doc["error"] = "No pulse counter on this GPIO";
+            }
+            response_doc["ts"] = (unsigned long)timeManager.getUnixTimestamp();
+            response_doc["seq"] = mqttClient.getNextSeq();
+
+            String response;
+            serializeJson(response_doc, response);
+            mqttClient.publish(system_command_topic + "/response", response);
+        }
+#ifdef OTA_LIBRARY_ENABLED
+        // ─── Firmware OTA ────────────────────────────────────────────────────
+        // ota_begin carries the manifest; chunks follow on .../system/ota/chunk.
+        // A repeated ota_begin for the same manifest resumes (response: next_offset).
+        else if (command == "ota_begin" || command == "ota_abort" || command == "ota_status") {
+            LOG_I(TAG, "OTA command received: " + command);
+            JsonVariant params = doc.containsKey("params") ? doc["params"].as<JsonVariant>() : doc.as<JsonVariant>();
+
+            DynamicJsonDocument response_doc(384);
+            response_doc["command"] = command;
+            response_doc["esp_id"] = g_system_config.esp_id;
+
+            if (command == "ota_begin") {
+                OtaManifest manifest;
+                memset(&manifest, 0, sizeof(manifest));
+                String type = params["type"] | "full";
+                manifest.type = type == "delta" ? OtaImageType::DELTA : OtaImageType::FULL;
+                manifest.image_id = params["image_id"] | 0UL;
+                manifest.image_size = params["image_size"] | 0UL;
+                manifest.stream_size = params["stream_size"] | manifest.image_size;
+                manifest.image_crc32 = params["image_crc32"] | 0UL;
+                // 64 hex digits; missing or malformed → all-zero → BAD_MANIFEST
+                const char* image_sha256 = params["image_sha256"] | "";
+                if (!OtaUpdater::decodeHex(image_sha256, manifest.image_sha256, OTA_SHA256_SIZE)) {
+                    memset(manifest.image_sha256, 0, sizeof(manifest.image_sha256));
+                }
+                manifest.base_size = params["base_size"] | 0UL;
+                manifest.base_crc32 = params["base_crc32"] | 0UL;
+                manifest.chunk_size = params["chunk_size"] | libraryManager.getMaxChunkSize();
+
+                OtaResult result = libraryManager.beginUpdate(manifest);
+                response_doc["success"] = result == OtaResult::OK;
+                response_doc["result"] = OtaUpdater::resultToString(result);
+                response_doc["image_id"] = manifest.image_id;
+            } else if (command == "ota_abort") {
+                libraryManager.abortUpdate("server command");
+                response_doc["success"] = true;
+            } else {
+                response_doc["success"] = true;
+                response_doc["pending_verify"] = libraryManager.isPendingVerify();
+            }
+            response_doc["active"] = libraryManager.isUpdateActive();
+            response_doc["next_offset"] = libraryManager.getNextOffset();
+            response_doc["max_chunk"] = libraryManager.getMaxChunkSize();
+            response_doc["ts"] = (unsigned long)timeManager.getUnixTimestamp();
+            response_doc["seq"] = mqttClient.getNextSeq();
+
+            String response;
+            serializeJson(response_doc, response);
+            mqttClient.publish(system_command_topic + "/response", response);
+        }
+#endif
         // ─── Set Emergency Token ─────────────────────────────────────────────
         else if (command == "set_emergency_token") {
             LOG_I(TAG, "╔════════════════════════════════════════╗");
@@ -1781,7 +2023,7 @@ void routeIncomingMessage(const char* t, const char* p) {
 
                     LOG_I(TAG, "✅ Zone removed successfully");
 
-                    g_system_config.current_state = STATE_PENDING_APPROVAL;
+                    systemController.handleEvent(SystemEvent::ZONE_REMOVED, millis());
                     configManager.saveSystemConfig(g_system_config);
                     mqttClient.publishHeartbeat(true);
                 } else {
@@ -1910,7 +2152,7 @@ void routeIncomingMessage(const char* t, const char* p) {
                 LOG_I(TAG, "✅ Zone assignment successful");
                 LOG_I(TAG, "ESP is now part of zone: " + zone_id);
 
-                g_system_config.current_state = STATE_ZONE_CONFIGURED;
+                systemController.handleEvent(SystemEvent::ZONE_ASSIGNED, millis());
                 configManager.saveSystemConfig(g_system_config);
                 mqttClient.publishHeartbeat(true);
             } else {
@@ -2424,18 +2666,19 @@ void routeIncomingMessage(const char* t, const char* p) {
                 return;
             }
 
-            if (g_system_config.current_state == STATE_PENDING_APPROVAL ||
-                g_system_config.current_state == STATE_ERROR) {
+            // PENDING_APPROVAL / ERROR → OPERATIONAL; ignored in every other state,
+            // deferred while a library download holds the actuators
+            SystemState state_before = g_system_config.current_state;
+            if (systemController.handleEvent(SystemEvent::APPROVAL_GRANTED, millis()) &&
+                g_system_config.current_state == STATE_OPERATIONAL) {
                 LOG_I(TAG, "╔════════════════════════════════════════╗");
                 LOG_I(TAG, "║   DEVICE APPROVED BY SERVER            ║");
                 LOG_I(TAG, "╚════════════════════════════════════════╝");
-                if (g_system_config.current_state == STATE_ERROR) {
-                    LOG_W(TAG, "Recovering from ERROR state after valid approval ACK");
+                if (state_before == STATE_ERROR) {
+                    LOG_W(TAG, "Recovered from ERROR state after valid approval ACK");
                 }
-                LOG_I(TAG, "Transitioning to OPERATIONAL");
+                LOG_I(TAG, "Transitioned to OPERATIONAL");
 
-                g_system_config.current_state = STATE_OPERATIONAL;
-                g_system_config.safe_mode_reason = "";
                 configManager.saveSystemConfig(g_system_config);
 
                 LOG_I(TAG, "  → Sensors/Actuators now ENABLED");
@@ -2453,9 +2696,11 @@ void routeIncomingMessage(const char* t, const char* p) {
                 LOG_D(TAG, "[CONFIG] Pending-exit check deferred (trigger=heartbeat_ack, status=pending_approval)");
                 return;
             }
-            if (g_system_config.current_state != STATE_PENDING_APPROVAL) {
-                LOG_I(TAG, "Server reports: PENDING APPROVAL - entering limited mode");
-                g_system_config.current_state = STATE_PENDING_APPROVAL;
+            SystemState state_before = g_system_config.current_state;
+            if (systemController.handleEvent(SystemEvent::APPROVAL_PENDING, millis()) &&
+                state_before != STATE_PENDING_APPROVAL &&
+                g_system_config.current_state == STATE_PENDING_APPROVAL) {
+                LOG_I(TAG, "Server reports: PENDING APPROVAL - entered limited mode");
             }
         } else if (strcmp(status, "rejected") == 0) {
             bool upstream_delete_reject = ack_upstream_deleted ||
@@ -2495,7 +2740,7 @@ void routeIncomingMessage(const char* t, const char* p) {
                                    rejection_reason.c_str());
 
             configManager.setDeviceApproved(false, 0);
-            g_system_config.current_state = STATE_ERROR;
+            systemController.handleEvent(SystemEvent::DEVICE_REJECTED, millis());
             configManager.saveSystemConfig(g_system_config);
 
             LOG_W(TAG, "  → Device in ERROR state");
@@ -2666,6 +2911,20 @@ void setup() {
 
   watchdogStorageInitEarly();
 
+  // Stack/heap watermarks: RTC record from the previous boot is only trusted
+  // after a warm reset (RTC no-init memory is random after power-on/brownout).
+  {
+    esp_reset_reason_t reset_reason = esp_reset_reason();
+    bool warm_reset = reset_reason != ESP_RST_POWERON && reset_reason != ESP_RST_BROWNOUT;
+    resourceMonitor.begin(warm_reset);
+    watchdogSupervisor.begin(warm_reset);  // Logs phase running at last WDT/panic reset
+  }
+#ifdef CONFIG_ARDUINO_LOOP_STACK_SIZE
+  resourceMonitor.registerTask("loopTask", xTaskGetCurrentTaskHandle(), CONFIG_ARDUINO_LOOP_STACK_SIZE);
+#else
+  resourceMonitor.registerTask("loopTask", xTaskGetCurrentTaskHandle(), 8192);
+#endif
+
   // ============================================
   // STEP 5.1: RESTORE LOG LEVEL FROM NVS
   // ============================================
@@ -2677,9 +2936,29 @@ void setup() {
       // Use Serial.printf directly — LOG_INFO would be invisible if restored level > INFO
       Serial.printf("[NVS] Log level restored from NVS: %s\n", Logger::getLogLevelString((LogLevel)saved_level));
     }
+    // Per-module overrides (set_log_level with "module"), e.g. "I2C=DEBUG,MQTT=WARNING"
+    if (storageManager.keyExists("log_tags")) {
+      String module_spec = storageManager.getStringObj("log_tags", "");
+      size_t restored = logger.applyTagLogLevelSpec(module_spec.c_str());
+      if (restored > 0) {
+        Serial.printf("[NVS] Module log levels restored from NVS: %s\n", module_spec.c_str());
+      }
+    }
+    // Remote log shipping (set via MQTT set_log_shipping command), off by default
+    if (storageManager.keyExists("log_ship")) {
+      logShipper.begin(LogShipper::unpackConfig(storageManager.getULong("log_ship", 0)), millis());
+    }
     storageManager.endNamespace();
   }
 
+#ifdef OTA_LIBRARY_ENABLED
+  // ============================================
+  // STEP 5.2: OTA BOOT VALIDATION
+  // ============================================
+  // New image stays PENDING_VERIFY until the server confirms the registration
+  libraryManager.begin();
+#endif
+
   // ============================================
   // STEP 6: CONFIG MANAGER (Load configurations)
   // ============================================
@@ -2694,6 +2973,10 @@ void setup() {
   g_master = configManager.getMasterZone();
   g_system_config = configManager.getSystemConfig();
 
+  // From here on every state change goes through the transition table
+  systemController.begin(&g_system_config.current_state, millis());
+  registerSystemStateActions();
+
   // ============================================
   // FIX: Use generated ESP ID when NVS read returns empty
   // In WOKWI mode, saveSystemConfig() is a no-op so the ESP ID
@@ -2729,13 +3012,13 @@ void setup() {
     LOG_W(TAG, "SSID: " + g_wifi_config.ssid);
     LOG_W(TAG, "Repairing: Resetting state to STATE_BOOT");
 
-    g_system_config.current_state = STATE_BOOT;
+    systemController.handleEvent(SystemEvent::STATE_REPAIRED, millis());
     g_system_config.safe_mode_reason = "";
     g_system_config.boot_count = 0;  // Reset boot counter to prevent false boot-loop detection
     bool repairPersisted = configManager.saveSystemConfig(g_system_config);
     if (!repairPersisted) {
       LOG_E(TAG, "State repair persist failed - switching to fail-closed provisioning mode");
-      g_system_config.current_state = STATE_SAFE_MODE_PROVISIONING;
+      systemController.handleEvent(SystemEvent::PROVISIONING_REQUIRED, millis());
       g_system_config.safe_mode_reason = "State repair persist failed";
       LOG_E(TAG, "Operator action required: Re-run provisioning after NVS/storage check");
       LOG_W(TAG, "State repair incomplete - continuing in STATE_SAFE_MODE_PROVISIONING");
@@ -2782,7 +3065,7 @@ void setup() {
     LOG_C(TAG, "Reset required to exit Safe-Mode");
 
     // Enter Safe-Mode: Disable WiFi/MQTT, only Serial log available
-    g_system_config.current_state = STATE_SAFE_MODE;
+    systemController.handleEvent(SystemEvent::BOOT_LOOP_DETECTED, millis());
     g_system_config.safe_mode_reason = "Boot loop detected (" + String(g_system_config.boot_count) + " boots)";
     configManager.saveSystemConfig(g_system_config);
 
@@ -3043,7 +3326,7 @@ void setup() {
     bool has_valid_local_config = hasValidLocalAutonomyConfig();
     if (has_valid_local_config) {
       g_boot_force_offline_autonomy = true;
-      g_system_config.current_state = STATE_OPERATIONAL;
+      systemController.handleEvent(SystemEvent::OFFLINE_AUTONOMY, millis());
       g_system_config.safe_mode_reason = "Booted in local offline autonomy (WiFi unavailable)";
       configManager.saveSystemConfig(g_system_config);
       LOG_W(TAG, "[BOOT] WiFi unavailable, local config valid -> continue with offline autonomy runtime");
@@ -3056,7 +3339,7 @@ void setup() {
       if (!mayOpenPortal(PortalOpenReason::WIFI_CONNECT_FAILURE, decision_context, &decision_code)) {
         LOG_W(TAG, String("[PORTAL] WiFi-failure portal blocked (code=") +
                    String(decision_code != nullptr ? decision_code : "UNKNOWN") + ")");
-        g_system_config.current_state = STATE_OPERATIONAL;
+        systemController.handleEvent(SystemEvent::OFFLINE_AUTONOMY, millis());
         g_system_config.safe_mode_reason = "Portal blocked by authority guard";
         configManager.saveSystemConfig(g_system_config);
         g_boot_force_offline_autonomy = true;
@@ -3072,7 +3355,7 @@ void setup() {
       LOG_C(TAG, "╚════════════════════════════════════════╝");
 
       // Update system state
-      g_system_config.current_state = STATE_SAFE_MODE_PROVISIONING;
+      systemController.handleEvent(SystemEvent::PROVISIONING_REQUIRED, millis());
       g_system_config.safe_mode_reason = "WiFi connection to '" + wifi_config.ssid + "' failed";
       configManager.saveSystemConfig(g_system_config);
 
@@ -3152,7 +3435,7 @@ void setup() {
     bool has_valid_local_config = hasValidLocalAutonomyConfig();
     if (has_valid_local_config) {
       g_boot_force_offline_autonomy = true;
-      g_system_config.current_state = STATE_OPERATIONAL;
+      systemController.handleEvent(SystemEvent::OFFLINE_AUTONOMY, millis());
       g_system_config.safe_mode_reason = "Booted in local offline autonomy (MQTT unavailable)";
       configManager.saveSystemConfig(g_system_config);
       LOG_W(TAG, "[BOOT] MQTT unavailable, local config valid -> continue with offline autonomy runtime");
@@ -3165,7 +3448,7 @@ void setup() {
       if (!mayOpenPortal(PortalOpenReason::MQTT_CONNECT_FAILURE, decision_context, &decision_code)) {
         LOG_W(TAG, String("[PORTAL] MQTT-failure portal blocked (code=") +
                    String(decision_code != nullptr ? decision_code : "UNKNOWN") + ")");
-        g_system_config.current_state = STATE_OPERATIONAL;
+        systemController.handleEvent(SystemEvent::OFFLINE_AUTONOMY, millis());
         g_system_config.safe_mode_reason = "Portal blocked by authority guard";
         configManager.saveSystemConfig(g_system_config);
         g_boot_force_offline_autonomy = true;
@@ -3190,7 +3473,7 @@ void setup() {
       LOG_C(TAG, "  3. MQTT broker not running");
 
       // Update system state
-      g_system_config.current_state = STATE_SAFE_MODE_PROVISIONING;
+      systemController.handleEvent(SystemEvent::PROVISIONING_REQUIRED, millis());
       g_system_config.safe_mode_reason = "MQTT connection to '" + mqtt_config.server +
                                          ":" + String(mqtt_config.port) + "' failed";
       configManager.saveSystemConfig(g_system_config);
@@ -3275,13 +3558,13 @@ void setup() {
     // If approved → continue to OPERATIONAL state (normal operation)
     if (!configManager.isDeviceApproved()) {
       // New device or not yet approved → Limited operation mode
-      g_system_config.current_state = STATE_PENDING_APPROVAL;
+      systemController.handleEvent(SystemEvent::CONNECTED_UNAPPROVED, millis());
       LOG_I(TAG, "Device not yet approved - entering PENDING_APPROVAL state");
       LOG_I(TAG, "  → WiFi/MQTT active (heartbeats + diagnostics)");
       LOG_I(TAG, "  → Sensors/Actuators DISABLED until approval");
     } else {
       // Previously approved → Normal operation
-      g_system_config.current_state = STATE_OPERATIONAL;
+      systemController.handleEvent(SystemEvent::CONNECTED_APPROVED, millis());
       LOG_I(TAG, "Device previously approved - continuing normal operation");
     }
   }
@@ -3346,6 +3629,16 @@ void setup() {
     LOG_I(TAG, "PWM Controller initialized");
   }
 
+  // ADC Sampler — continuous DMA scan of analog sensor pins (channels added by SensorManager)
+  if (!adcSampler.begin()) {
+    LOG_W(TAG, "ADC Sampler unavailable - analog sensors use analogRead()");
+  }
+
+  // Pulse Counter — PCNT units for flow meters / rain gauges (attached by SensorManager)
+  if (!pulseCounter.begin()) {
+    LOG_W(TAG, "Pulse Counter unavailable (no PCNT) - flow_meter/rain_gauge sensors rejected");
+  }
+
   LOG_I(TAG, "╔════════════════════════════════════════╗");
   LOG_I(TAG, "║   Phase 3: Hardware Abstraction READY  ║");
   LOG_I(TAG, "╚════════════════════════════════════════╝");
@@ -3353,6 +3646,8 @@ void setup() {
   LOG_I(TAG, "  ✅ I2C Bus Manager");
   LOG_I(TAG, "  ⏳ OneWire Bus Manager (on-demand)");
   LOG_I(TAG, "  ✅ PWM Controller");
+  LOG_I(TAG, "  " + String(adcSampler.isActive() ? "✅" : "⚠️") + " ADC Sampler (continuous)");
+  LOG_I(TAG, "  " + String(pulseCounter.isAvailable() ? "✅" : "⚠️") + " Pulse Counter (PCNT)");
   LOG_I(TAG, "");
 
   // Print memory stats
@@ -3466,18 +3761,14 @@ void setup() {
                String(offline_rule_count) + ", actuators=0) — auto-exit, rules are inert");
   }
   if (runtime_has_any_config && !runtime_complete &&
-      g_system_config.current_state != STATE_SAFE_MODE &&
-      g_system_config.current_state != STATE_SAFE_MODE_PROVISIONING &&
-      g_system_config.current_state != STATE_ERROR) {
+      systemController.canHandle(SystemEvent::CONFIG_INCOMPLETE)) {
     SystemState before_state = g_system_config.current_state;
     LOG_W(TAG, String("[BOOT] Runtime config partial after reset: sensors=") + String(runtime_sensor_count) +
                ", actuators=" + String(runtime_actuator_count) +
                ", offline_rules=" + String(offline_rule_count) +
                ", policy_decision=" + String(boot_readiness.decision_code));
-    g_system_config.current_state = STATE_CONFIG_PENDING_AFTER_RESET;
-    g_system_config.safe_mode_reason = "CONFIG_PENDING_AFTER_RESET";
+    systemController.handleEvent(SystemEvent::CONFIG_INCOMPLETE, millis());
     configManager.saveSystemConfig(g_system_config);
-    g_config_pending_enter_count.fetch_add(1);
     publishConfigPendingTransitionEvent("entered_config_pending",
                                         "CONFIG_PENDING_AFTER_RESET",
                                         boot_readiness,
@@ -3513,6 +3804,10 @@ void setup() {
   initSensorCommandQueue();
   // initPublishQueue: moved to Phase 2 (immediately after mqttClient.begin)
 
+  // DFS + auto light sleep (opt-in via ENABLE_POWER_MANAGEMENT). WiFi is started at
+  // this point, so modem sleep can be applied.
+  powerManager.begin();
+
   bool safety_task_created = createSafetyTask();   // Core 1, Priority 5 — Safety/Sensor/Actuator
   if (safety_task_created) {
     // Deregister Arduino loopTask from WDT — Safety-Task takes over WDT feeding
@@ -3612,6 +3907,7 @@ bool feedWatchdog(const char* component_id) {
   g_watchdog_diagnostics.last_feed_time = millis();
   g_watchdog_diagnostics.last_feed_component = component_id;
   g_watchdog_diagnostics.feed_count++;
+  watchdogSupervisor.noteFeed(component_id);
 
   return true;
 }
@@ -3743,7 +4039,7 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
     if (safety_task_active) {
       LOG_W(TAG, "[SAFETY-RTOS] Safety task is active while comm task is missing — legacy loop runs network/control-plane only");
     }
-    LOG_I(TAG, "System State: " + String(g_system_config.current_state));
+    LOG_I(TAG, String("System State: ") + systemStateToString(g_system_config.current_state));
     LOG_I(TAG, "Critical Errors: " + String(errorTracker.hasCriticalErrors() ? "YES" : "NO"));
     first_loop_logged = true;
   }
@@ -3755,7 +4051,9 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
   handleWatchdogTimeout();
   LOG_D(TAG, "LOOP[legacy " + String(loop_count) + "] WATCHDOG_TIMEOUT_HANDLER OK");
 
-  if (g_system_config.current_state == STATE_SAFE_MODE_PROVISIONING) {
+  const uint8_t work = systemController.getWorkMask();
+
+  if (work & SYSTEM_WORK_PORTAL) {
     provisionManager.loop();
 
     if (portal_open_due_to_disconnect_) {
@@ -3770,8 +4068,7 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
         provisionManager.stop();
         portal_open_due_to_disconnect_ = false;
         WiFi.mode(WIFI_STA);
-        g_system_config.current_state = STATE_OPERATIONAL;
-        g_system_config.safe_mode_reason = "";
+        systemController.handleEvent(SystemEvent::PORTAL_RECONNECTED, millis());
         configManager.saveSystemConfig(g_system_config);
         delay(10);
         return;
@@ -3785,6 +4082,7 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
       configManager.loadWiFiConfig(g_wifi_config);
       LOG_I(TAG, "WiFi SSID: " + g_wifi_config.ssid);
       LOG_I(TAG, "Rebooting to apply configuration...");
+      flushIntentOutcomeBatches(true);
       delay(2000);
       ESP.restart();
     }
@@ -3793,8 +4091,8 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
     return;
   }
 
-  if (g_system_config.current_state == STATE_PENDING_APPROVAL ||
-      g_system_config.current_state == STATE_CONFIG_PENDING_AFTER_RESET) {
+  // Link only (PENDING_APPROVAL, CONFIG_PENDING_AFTER_RESET): no control lanes
+  if (!(work & SYSTEM_WORK_CONTROL)) {
     wifiManager.loop();
     mqttClient.loop();
 #ifndef MQTT_USE_PUBSUBCLIENT
@@ -3805,6 +4103,7 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
     }
     mqttClient.processPublishQueue();
 #endif
+    flushIntentOutcomeBatches(false);  // Comm-Task duty: lanes whose window expired
     delay(100);
     return;
   }
@@ -3825,6 +4124,8 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
 #ifndef MQTT_USE_PUBSUBCLIENT
   mqttClient.processPublishQueue();
 #endif
+  flushIntentOutcomeBatches(false);  // Comm-Task duty: lanes whose window expired
+  errorTracker.processPendingPublishes();  // Comm-Task duty: deferred error events
   // Legacy fallback: drain queues only in pure single-thread mode.
   // When Safety-Task exists but Comm-Task is missing, queue consumers run on Core 1.
   if (!safety_task_active) {
@@ -3837,7 +4138,7 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
     static const unsigned long PORTAL_OPEN_DEBOUNCE_MS = 30000;
     static unsigned long disconnect_start = 0;
 
-    if (g_system_config.current_state == STATE_OPERATIONAL && !mqttClient.isConnected() && !WiFi.isConnected()) {
+    if ((work & SYSTEM_WORK_LINK_WATCH) && !mqttClient.isConnected() && !WiFi.isConnected()) {
       if (disconnect_start == 0) {
         disconnect_start = millis();
       } else if (millis() - disconnect_start > PORTAL_OPEN_DEBOUNCE_MS &&
@@ -3855,7 +4156,7 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
           // Keep running in operational degraded mode; no portal escalation.
         } else {
           LOG_I(TAG, "Config-Portal geoeffnet (Server getrennt), Reconnect laeuft im Hintergrund");
-          g_system_config.current_state = STATE_SAFE_MODE_PROVISIONING;
+          systemController.handleEvent(SystemEvent::PROVISIONING_REQUIRED, millis());
           g_system_config.safe_mode_reason = "MQTT disconnected (" + String(PORTAL_OPEN_DEBOUNCE_MS / 1000) + "s)";
           configManager.saveSystemConfig(g_system_config);
           if (provisionManager.startAPModeForReconfig()) {
@@ -3895,7 +4196,7 @@ static void loopLegacySingleThreadedWhenNoRtosTasks() {
             LOG_C(TAG, "║  MQTT PERSISTENT FAILURE (5 min)       ║");
             LOG_C(TAG, "║  Config-Portal oeffnen...              ║");
             LOG_C(TAG, "╚════════════════════════════════════════╝");
-            g_system_config.current_state = STATE_SAFE_MODE_PROVISIONING;
+            systemController.handleEvent(SystemEvent::PROVISIONING_REQUIRED, millis());
             g_system_config.safe_mode_reason = "MQTT persistent failure (5 min Circuit Breaker OPEN)";
             configManager.saveSystemConfig(g_system_config);
             if (!provisionManager.isInitialized() && !provisionManager.begin()) {
@@ -4061,6 +4362,102 @@ bool parseAndConfigureSensorWithTracking(const JsonObjectConst& sensor_obj, Conf
   // Empty string for non-OneWire sensors is valid (analog, I2C, etc.)
   JsonHelpers::extractString(sensor_obj, "onewire_address", config.onewire_address, "");
 
+  // DS18B20 resolution (optional, 9-12 bit): 9 bit = 0.5 °C / 94 ms, 12 bit = 0.0625 °C / 750 ms
+  int resolution_bits = 12;
+  if (JsonHelpers::extractInt(sensor_obj, "resolution_bits", resolution_bits, 12)) {
+    if (resolution_bits < 9 || resolution_bits > 12) {
+      LOG_W(TAG, "resolution_bits " + String(resolution_bits) + " out of range (9-12), using 12");
+      resolution_bits = 12;
+    }
+  }
+  config.onewire_resolution = static_cast<uint8_t>(resolution_bits);
+
+  // Pulse counters (flow_meter, rain_gauge): calibration + glitch filter (optional)
+  // pulses_per_unit: pulses per litre / per mm (alias pulses_per_litre), 0 = raw pulses
+  const char* ppu_key = sensor_obj.containsKey("pulses_per_unit") ? "pulses_per_unit" : "pulses_per_litre";
+  if (sensor_obj.containsKey(ppu_key)) {
+    JsonVariantConst ppu_value = sensor_obj[ppu_key];
+    if (ppu_value.is<float>() || ppu_value.is<int>()) {
+      float ppu = ppu_value.as<float>();
+      config.pulses_per_unit = ppu > 0.0f ? ppu : 0.0f;
+    } else {
+      LOG_W(TAG, String(ppu_key) + " must be a number, publishing raw pulses");
+    }
+  }
+  int glitch_filter_ns = PULSE_COUNTER_DEFAULT_FILTER_NS;
+  if (JsonHelpers::extractInt(sensor_obj, "glitch_filter_ns", glitch_filter_ns, PULSE_COUNTER_DEFAULT_FILTER_NS)) {
+    if (glitch_filter_ns < 0 || glitch_filter_ns > PULSE_COUNTER_MAX_FILTER_NS) {
+      LOG_W(TAG, "glitch_filter_ns " + String(glitch_filter_ns) + " out of range (0-" +
+                 String(PULSE_COUNTER_MAX_FILTER_NS) + "), clamping");
+      glitch_filter_ns = glitch_filter_ns < 0 ? 0 : PULSE_COUNTER_MAX_FILTER_NS;
+    }
+  }
+  config.pulse_filter_ns = static_cast<uint16_t>(glitch_filter_ns);
+
+  // Digital inputs (float_switch, door_contact, ...): debounce + polarity (optional)
+  int debounce_ms = DIGITAL_INPUT_DEFAULT_DEBOUNCE_MS;
+  if (JsonHelpers::extractInt(sensor_obj, "debounce_ms", debounce_ms, DIGITAL_INPUT_DEFAULT_DEBOUNCE_MS)) {
+    if (debounce_ms < 0 || debounce_ms > DIGITAL_INPUT_MAX_DEBOUNCE_MS) {
+      LOG_W(TAG, "debounce_ms " + String(debounce_ms) + " out of range (0-" +
+                 String(DIGITAL_INPUT_MAX_DEBOUNCE_MS) + "), clamping");
+      debounce_ms = debounce_ms < 0 ? 0 : DIGITAL_INPUT_MAX_DEBOUNCE_MS;
+    }
+  }
+  config.debounce_ms = static_cast<uint16_t>(debounce_ms);
+  bool active_low = true;
+  JsonHelpers::extractBool(sensor_obj, "active_low", active_low, true);
+  config.input_active_low = active_low;
+
+  // pH / EC: linear calibration (25 °C) + temperature source for compensation (optional)
+  if (sensor_obj.containsKey("cal_slope")) {
+    config.cal_slope = sensor_obj["cal_slope"].as<float>();
+    config.cal_offset = sensor_obj["cal_offset"].as<float>();
+  }
+  int temp_source_gpio = 255;
+  if (JsonHelpers::extractInt(sensor_obj, "temp_source_gpio", temp_source_gpio, 255)) {
+    if (temp_source_gpio < 0 || temp_source_gpio > 255) {
+      LOG_W(TAG, "temp_source_gpio " + String(temp_source_gpio) + " invalid, compensation off");
+      temp_source_gpio = 255;
+    }
+  }
+  config.temp_source_gpio = static_cast<uint8_t>(temp_source_gpio);
+  JsonHelpers::extractString(sensor_obj, "temp_source_type", config.temp_source_type, "ds18b20");
+  config.temp_source_type = getServerSensorType(config.temp_source_type);
+  if (sensor_obj.containsKey("temp_coefficient")) {
+    float alpha = sensor_obj["temp_coefficient"].as<float>();
+    config.temp_coefficient = (alpha >= 0.0f && alpha <= 0.1f) ? alpha : TEMP_COMP_DEFAULT_EC_ALPHA;
+  }
+  int temp_max_age_s = TEMP_COMP_DEFAULT_MAX_AGE_S;
+  if (JsonHelpers::extractInt(sensor_obj, "temp_max_age_s", temp_max_age_s, TEMP_COMP_DEFAULT_MAX_AGE_S)) {
+    if (temp_max_age_s < 1 || temp_max_age_s > 3600) {
+      temp_max_age_s = TEMP_COMP_DEFAULT_MAX_AGE_S;
+    }
+  }
+  config.temp_max_age_s = static_cast<uint16_t>(temp_max_age_s);
+
+  // Switched probe supply: excitation pin + settle time (optional)
+  int excitation_gpio = SENSOR_EXCITATION_NO_GPIO;
+  if (JsonHelpers::extractInt(sensor_obj, "excitation_gpio", excitation_gpio, SENSOR_EXCITATION_NO_GPIO)) {
+    if (excitation_gpio < 0 || excitation_gpio > 255 || excitation_gpio == config.gpio) {
+      LOG_W(TAG, "excitation_gpio " + String(excitation_gpio) + " invalid, probe permanently powered");
+      excitation_gpio = SENSOR_EXCITATION_NO_GPIO;
+    }
+  }
+  config.excitation_gpio = static_cast<uint8_t>(excitation_gpio);
+  int excitation_settle_ms = SENSOR_EXCITATION_DEFAULT_SETTLE_MS;
+  if (JsonHelpers::extractInt(sensor_obj, "excitation_settle_ms", excitation_settle_ms,
+                              SENSOR_EXCITATION_DEFAULT_SETTLE_MS)) {
+    if (excitation_settle_ms < 0 || excitation_settle_ms > SENSOR_EXCITATION_MAX_SETTLE_MS) {
+      LOG_W(TAG, "excitation_settle_ms " + String(excitation_settle_ms) + " out of range (0-" +
+                 String(SENSOR_EXCITATION_MAX_SETTLE_MS) + "), clamping");
+      excitation_settle_ms = excitation_settle_ms < 0 ? 0 : SENSOR_EXCITATION_MAX_SETTLE_MS;
+    }
+  }
+  config.excitation_settle_ms = static_cast<uint16_t>(excitation_settle_ms);
+  bool excitation_active_high = true;
+  JsonHelpers::extractBool(sensor_obj, "excitation_active_high", excitation_active_high, true);
+  config.excitation_active_high = excitation_active_high;
+
   // R20-P2: Extract I2C address for multi-device I2C support (e.g. 2x SHT31 at 0x44 + 0x45)
   int i2c_addr_int = 0;
   if (JsonHelpers::extractInt(sensor_obj, "i2c_address", i2c_addr_int, 0)) {
@@ -4107,8 +4504,43 @@ bool parseAndConfigureSensorWithTracking(const JsonObjectConst& sensor_obj, Conf
   }
   config.measurement_interval_ms = static_cast<uint32_t>(interval_seconds) * 1000;
 
+  // Raw Batching (optional): high-rate raw sensors publish delta-encoded frames
+  // on sensor/batch instead of one message per sample. Absent = per-sample publish.
+  int batch_samples = 0;
+  if (JsonHelpers::extractInt(sensor_obj, "batch_max_samples", batch_samples, 0)) {
+    if (batch_samples < 0) {
+      batch_samples = 0;
+    } else if (batch_samples > RAW_BATCH_MAX_SAMPLES) {
+      LOG_W(TAG, "batch_max_samples too high, using maximum " + String(RAW_BATCH_MAX_SAMPLES));
+      batch_samples = RAW_BATCH_MAX_SAMPLES;
+    }
+  }
+  config.batch_max_samples = static_cast<uint8_t>(batch_samples);
+
+  int batch_flush_seconds = 0;
+  if (JsonHelpers::extractInt(sensor_obj, "batch_flush_interval_seconds", batch_flush_seconds, 0)) {
+    if (batch_flush_seconds < 0) {
+      batch_flush_seconds = 0;
+    } else if (batch_flush_seconds > 255) {
+      LOG_W(TAG, "batch_flush_interval_seconds too high, using maximum 255s");
+      batch_flush_seconds = 255;
+    }
+  }
+  config.batch_flush_interval_ms = static_cast<uint32_t>(batch_flush_seconds) * 1000;
+
+  int batch_flush_delta = 0;
+  if (JsonHelpers::extractInt(sensor_obj, "batch_flush_delta", batch_flush_delta, 0)) {
+    if (batch_flush_delta < 0) {
+      batch_flush_delta = 0;
+    } else if (batch_flush_delta > 65535) {
+      batch_flush_delta = 65535;
+    }
+  }
+  config.batch_flush_delta = static_cast<uint16_t>(batch_flush_delta);
+
   LOG_D(TAG, "Sensor GPIO " + String(config.gpio) + " config: mode=" +
-            config.operating_mode + ", interval=" + String(interval_seconds) + "s");
+            config.operating_mode + ", interval=" + String(interval_seconds) + "s" +
+            (config.batch_max_samples > 1 ? ", batch=" + String(config.batch_max_samples) : ""));
 
   if (!configManager.validateSensorConfig(config)) {
     LOG_E(TAG, "Sensor validation failed for GPIO " + String(config.gpio));
@@ -4213,7 +4645,7 @@ bool handleOfflineRulesConfig(JsonObject doc, const String& correlationId) {
  */
 SensorCommandExecutionResult handleSensorCommand(const String& topic, const String& payload,
                                                  const IntentMetadata& metadata) {
-  SensorCommandExecutionResult result{false, "failed", "EXECUTE_FAIL", "Sensor command execution failed", true};
+  SensorCommandExecutionResult result{false, "failed", "EXECUTE_FAIL", "Sensor command execution failed", true, 0};
   LOG_I(TAG, "Sensor command received: " + topic);
 
   // Extract GPIO from topic
@@ -4270,6 +4702,16 @@ SensorCommandExecutionResult handleSensorCommand(const String& topic, const Stri
                    " (timeout_ms=" + String(timeout_ms) + ")");
 
     ManualMeasurementResult measurement = sensorManager.triggerManualMeasurement(gpio, timeout_ms);
+    if (measurement.retry_after_ms > 0) {
+      // Excitation settling: the queue parks the command, response follows the read
+      result.ok = true;
+      result.outcome = "accepted";
+      result.code = "SETTLING";
+      result.reason = "Sensor probe settling";
+      result.retryable = false;
+      result.retry_after_ms = measurement.retry_after_ms;
+      return result;
+    }
     bool success = measurement.measurement_ok && measurement.publish_ok && !measurement.timeout_reached;
 
     // Send response with request_id and intent metadata (E-P4)
@@ -13,6 +13,8 @@ static const SensorCapability SHT31_TEMP_CAP = {
     .i2c_address = 0x44,  // Default SHT31 address (0x45 if ADR pin to VIN)
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 static const SensorCapability SHT31_HUMIDITY_CAP = {
@@ -21,6 +23,8 @@ static const SensorCapability SHT31_HUMIDITY_CAP = {
     .i2c_address = 0x44,
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // SHT31 Base type — resolves "sht31" from server config to a valid capability
@@ -32,6 +36,8 @@ static const SensorCapability SHT31_BASE_CAP = {
     .i2c_address = 0x44,
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // DS18B20 Sensor (OneWire, Single-Value: Temperature)
@@ -41,6 +47,8 @@ static const SensorCapability DS18B20_CAP = {
     .i2c_address = 0x00,  // Not I2C
     .is_multi_value = false,
     .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // BMP280 Sensor (I2C, Multi-Value: Pressure + Temperature)
@@ -50,6 +58,8 @@ static const SensorCapability BMP280_PRESSURE_CAP = {
     .i2c_address = 0x76,  // Default BMP280 address (0x77 if SDO to VCC)
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 static const SensorCapability BMP280_TEMP_CAP = {
@@ -58,6 +68,8 @@ static const SensorCapability BMP280_TEMP_CAP = {
     .i2c_address = 0x76,
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // BMP280 Base type — resolves "bmp280" from server config
@@ -67,6 +79,8 @@ static const SensorCapability BMP280_BASE_CAP = {
     .i2c_address = 0x76,
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // BME280 Sensor (I2C, Multi-Value: Pressure + Temperature + Humidity)
@@ -76,6 +90,8 @@ static const SensorCapability BME280_PRESSURE_CAP = {
     .i2c_address = 0x76,  // Default BME280 address (0x77 if SDO to VCC)
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 static const SensorCapability BME280_TEMP_CAP = {
@@ -84,6 +100,8 @@ static const SensorCapability BME280_TEMP_CAP = {
     .i2c_address = 0x76,
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 static const SensorCapability BME280_HUMIDITY_CAP = {
@@ -92,6 +110,8 @@ static const SensorCapability BME280_HUMIDITY_CAP = {
     .i2c_address = 0x76,
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // BME280 Base type — resolves "bme280" from server config
@@ -101,6 +121,8 @@ static const SensorCapability BME280_BASE_CAP = {
     .i2c_address = 0x76,
     .is_multi_value = true,
     .is_i2c = true,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // pH Sensor (Analog ADC, Single-Value)
@@ -110,6 +132,8 @@ static const SensorCapability PH_SENSOR_CAP = {
     .i2c_address = 0x00,  // Not I2C
     .is_multi_value = false,
     .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // EC Sensor (Analog ADC, Single-Value)
@@ -119,6 +143,8 @@ static const SensorCapability EC_SENSOR_CAP = {
     .i2c_address = 0x00,  // Not I2C
     .is_multi_value = false,
     .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
 };
 
 // Moisture Sensor (Analog ADC, Single-Value)
@@ -128,6 +154,85 @@ static const SensorCapability MOISTURE_CAP = {
     .i2c_address = 0x00,  // Not I2C
     .is_multi_value = false,
     .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = false,
+};
+
+// Flow Meter (Hall-effect pulses, PCNT) - publishes rate + total volume
+static const SensorCapability FLOW_METER_CAP = {
+    .server_sensor_type = "flow",
+    .device_type = "flow_meter",
+    .i2c_address = 0x00,  // Not I2C
+    .is_multi_value = false,
+    .is_i2c = false,
+    .is_pulse_counter = true,
+    .is_digital_input = false,
+};
+
+// Rain Gauge (tipping bucket reed switch, PCNT) - publishes rate + total
+static const SensorCapability RAIN_GAUGE_CAP = {
+    .server_sensor_type = "rain",
+    .device_type = "rain_gauge",
+    .i2c_address = 0x00,  // Not I2C
+    .is_multi_value = false,
+    .is_i2c = false,
+    .is_pulse_counter = true,
+    .is_digital_input = false,
+};
+
+// Generic binary input (dry contact) - edge interrupt, debounced
+static const SensorCapability DIGITAL_INPUT_CAP = {
+    .server_sensor_type = "digital_input",
+    .device_type = "digital_input",
+    .i2c_address = 0x00,  // Not I2C
+    .is_multi_value = false,
+    .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = true,
+};
+
+// Float Switch (tank level) - edge interrupt, debounced
+static const SensorCapability FLOAT_SWITCH_CAP = {
+    .server_sensor_type = "float_switch",
+    .device_type = "float_switch",
+    .i2c_address = 0x00,  // Not I2C
+    .is_multi_value = false,
+    .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = true,
+};
+
+// Door / Window Contact (reed switch) - edge interrupt, debounced
+static const SensorCapability DOOR_CONTACT_CAP = {
+    .server_sensor_type = "door_contact",
+    .device_type = "door_contact",
+    .i2c_address = 0x00,  // Not I2C
+    .is_multi_value = false,
+    .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = true,
+};
+
+// Leak Sensor (water detection contact) - edge interrupt, debounced
+static const SensorCapability LEAK_SENSOR_CAP = {
+    .server_sensor_type = "leak_sensor",
+    .device_type = "leak_sensor",
+    .i2c_address = 0x00,  // Not I2C
+    .is_multi_value = false,
+    .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = true,
+};
+
+// Rain Detector (rain board, digital output) - edge interrupt, debounced
+static const SensorCapability RAIN_DETECTOR_CAP = {
+    .server_sensor_type = "rain_detector",
+    .device_type = "rain_detector",
+    .i2c_address = 0x00,  // Not I2C
+    .is_multi_value = false,
+    .is_i2c = false,
+    .is_pulse_counter = false,
+    .is_digital_input = true,
 };
 
 // ============================================
@@ -179,6 +284,19 @@ static const SensorTypeMapping SENSOR_TYPE_MAP[] = {
     {"moisture", &MOISTURE_CAP},
     {"soil_moisture", &MOISTURE_CAP},  // Alias — canonical name is "moisture"
 
+    // Pulse counters (PCNT)
+    {"flow_meter", &FLOW_METER_CAP},
+    {"flow", &FLOW_METER_CAP},  // Already normalized
+    {"rain_gauge", &RAIN_GAUGE_CAP},
+    {"rain", &RAIN_GAUGE_CAP},  // Already normalized
+
+    // Digital inputs (edge interrupt + debounce)
+    {"digital_input", &DIGITAL_INPUT_CAP},
+    {"float_switch", &FLOAT_SWITCH_CAP},
+    {"door_contact", &DOOR_CONTACT_CAP},
+    {"leak_sensor", &LEAK_SENSOR_CAP},
+    {"rain_detector", &RAIN_DETECTOR_CAP},
+
     // End marker
     {nullptr, nullptr}
 };
@@ -311,6 +429,30 @@ uint8_t getMultiValueTypes(const String& device_type, String* output, uint8_t ma
     return 0;
 }
 
+uint8_t getMultiValueTypeNames(const String& device_type, const char** output, uint8_t max_output) {
+    if (output == nullptr || max_output == 0) {
+        return 0;
+    }
+
+    String lower_type = device_type;
+    lower_type.toLowerCase();
+
+    for (uint8_t i = 0; MULTI_VALUE_DEVICES[i].device_type != nullptr; i++) {
+        if (lower_type == MULTI_VALUE_DEVICES[i].device_type) {
+            const MultiValueDevice* device = &MULTI_VALUE_DEVICES[i];
+            uint8_t count = 0;
+            for (uint8_t j = 0; j < device->value_count && count < max_output; j++) {
+                if (device->value_types[j] != nullptr) {
+                    output[count++] = device->value_types[j];
+                }
+            }
+            return count;
+        }
+    }
+
+    return 0;
+}
+
 
 
 
@@ -24,6 +24,8 @@ struct SensorCapability {
     uint8_t i2c_address;            // I2C device address (0x00 if not I2C)
     bool is_multi_value;             // Provides multiple values?
     bool is_i2c;                     // Is I2C sensor?
+    bool is_pulse_counter;           // Counted by PCNT (flow meter, rain gauge)?
+    bool is_digital_input;           // Binary contact with edge interrupt (float switch, door)?
 };
 
 // ============================================
@@ -107,6 +109,12 @@ String getServerSensorType(const String& esp32_sensor_type);
  */
 uint8_t getMultiValueTypes(const String& device_type, String* output, uint8_t max_output);
 
+/**
+ * Same as getMultiValueTypes(), but returns the registry's static names
+ * (no String allocation). Used to resolve I2C bindings at configure time.
+ */
+uint8_t getMultiValueTypeNames(const String& device_type, const char** output, uint8_t max_output);
+
 #endif // MODELS_SENSOR_REGISTRY_H
 
 
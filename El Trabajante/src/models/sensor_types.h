@@ -37,6 +37,13 @@ struct SensorConfig {
   String operating_mode = "continuous";      // Betriebsmodus
   uint32_t measurement_interval_ms = 30000;  // Pro-Sensor Messintervall (ms)
 
+  // Raw Batching (high-rate raw acquisition, continuous mode only):
+  // Samples are collected and published as one delta-encoded frame on
+  // sensor/batch (see raw_sample_batch.h). 0/1 = per-sample publish.
+  uint8_t batch_max_samples = 0;             // Flush when this many samples are buffered (max 32)
+  uint32_t batch_flush_interval_ms = 0;      // Flush when the oldest sample is this old (0 = off)
+  uint16_t batch_flush_delta = 0;            // Immediate flush on |raw - last flushed| >= delta (0 = off)
+
   // Pi-Enhanced Mode (DEFAULT - 90% der Anwendungen):
   bool raw_mode = true;                  // IMMER true (Rohdaten-Modus)
   uint32_t last_raw_value = 0;           // Letzter Rohdaten-Wert (ADC 0-4095)
@@ -49,6 +56,50 @@ struct SensorConfig {
   // Format: 16 Hex chars (e.g. "28FF641E8D3C0C79")
   // Empty for non-OneWire sensors (pH, EC, ADC-based, etc.)
   String onewire_address = "";
+  // DS18B20 resolution in bit (9-12). Written to the device scratchpad/EEPROM
+  // once at configure time; selects conversion wait (94-750 ms) per reading.
+  // Runtime copy in SensorManager holds the resolution actually applied.
+  uint8_t onewire_resolution = 12;
+
+  // ============================================
+  // PULSE COUNTER SUPPORT (flow_meter, rain_gauge)
+  // ============================================
+  // Calibration: pulses per litre (flow) or per mm (rain). 0 = publish raw
+  // pulses. Glitch filter: pulses shorter than this are ignored (max 12787 ns).
+  float pulses_per_unit = 0.0f;
+  uint16_t pulse_filter_ns = 1000;
+
+  // ============================================
+  // DIGITAL INPUT SUPPORT (float_switch, door_contact, leak_sensor, ...)
+  // ============================================
+  // Edge interrupt + software debounce. active_low: contact to GND with
+  // internal pull-up (closed = LOW = active, value 1). Otherwise pull-down.
+  uint16_t debounce_ms = 50;
+  bool input_active_low = true;
+
+  // ============================================
+  // CALIBRATION + TEMPERATURE COMPENSATION (ph, ec)
+  // ============================================
+  // Linear calibration at 25 °C: value = raw * cal_slope + cal_offset, in pH
+  // or uS/cm (cal_slope 0 = uncalibrated → raw passthrough, server converts).
+  // Calibrated probes are compensated with the cached value of a co-located
+  // temperature sensor: temp_source_gpio + value type (e.g. "ds18b20").
+  float cal_slope = 0.0f;
+  float cal_offset = 0.0f;
+  uint8_t temp_source_gpio = 255;            // 255 = no compensation
+  String temp_source_type = "";              // Value-cache type (server sensor type)
+  float temp_coefficient = 0.02f;            // EC alpha per °C
+  uint16_t temp_max_age_s = 120;             // Older temperature → published uncompensated
+
+  // ============================================
+  // EXCITATION (switched probe supply)
+  // ============================================
+  // Optional GPIO powering the probe only around a measurement (moisture /
+  // EC probes: no electrolysis, no standby current). The scheduler switches
+  // it on, measures other sensors during the settle time, then reads.
+  uint8_t excitation_gpio = 255;             // 255 = probe permanently powered
+  uint16_t excitation_settle_ms = 100;
+  bool excitation_active_high = true;        // false: P-MOSFET high-side switch
 
   // ============================================
   // I2C SUPPORT (SHT31, BMP280, etc.)
@@ -67,6 +118,10 @@ struct SensorConfig {
   uint32_t cb_open_since_ms = 0;       // millis() when entering OPEN
   uint8_t consecutive_failures = 0;    // Consecutive measurement failures
 
+  // Manual measurement parked until the excitation settle time has passed
+  bool manual_settling = false;
+  uint32_t manual_settle_since_ms = 0;  // millis() of the first attempt
+
   // ❌ NICHT NÖTIG in Server-Centric Architektur:
   // - float last_value (Server verarbeitet)
   // - void* library_handle (keine lokalen Libraries)
@@ -114,6 +169,24 @@ struct SensorReading {
   // which I2C sensor at a specific address sent this reading
   // 0 for non-I2C sensors
   uint8_t i2c_address = 0;
+
+  // ============================================
+  // DIGITAL INPUT EVENTS
+  // ============================================
+  // millis() of the first edge of a debounced change, 0 = periodic reading.
+  // Payload adds edge_ts_ms (Unix ms) when the time is synchronized.
+  uint32_t edge_ms = 0;
+
+  // ============================================
+  // TEMPERATURE COMPENSATION (ph, ec)
+  // ============================================
+  // calibrated: processed_value is the on-device value (raw_mode false).
+  // temp_compensated: processed_value is compensated; uncompensated_value and
+  // compensation_temp_c are published alongside.
+  bool calibrated = false;
+  bool temp_compensated = false;
+  float uncompensated_value = 0.0f;
+  float compensation_temp_c = 0.0f;
 };
 
 #endif
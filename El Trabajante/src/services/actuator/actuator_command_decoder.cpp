@@ -0,0 +1,127 @@
+#include "actuator_command_decoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+namespace {
+
+// Value start of "key": (whitespace skipped), nullptr if the key is absent
+const char* findJsonValue(const char* json, const char* key) {
+    size_t key_len = strlen(key);
+    for (const char* p = strstr(json, key); p != nullptr; p = strstr(p + 1, key)) {
+        if (p == json || p[-1] != '"' || p[key_len] != '"' || p[key_len + 1] != ':') {
+            continue;
+        }
+        const char* value = p + key_len + 2;
+        while (*value == ' ') {
+            value++;
+        }
+        return value;
+    }
+    return nullptr;
+}
+
+// Copies a quoted or bare value (bare: up to ',' or '}', trimmed). Returns false if absent.
+bool copyJsonValue(const char* json, const char* key, char* out, size_t out_size) {
+    out[0] = '\0';
+    const char* value = findJsonValue(json, key);
+    if (value == nullptr) {
+        return false;
+    }
+    const char* end;
+    if (*value == '"') {
+        value++;
+        end = strchr(value, '"');
+        if (end == nullptr) {
+            return false;
+        }
+    } else {
+        end = value + strcspn(value, ",}");
+        while (end > value && (end[-1] == ' ' || end[-1] == '\r' || end[-1] == '\n' || end[-1] == '\t')) {
+            end--;
+        }
+    }
+    size_t len = static_cast<size_t>(end - value);
+    if (len >= out_size) {
+        len = out_size - 1;
+    }
+    memcpy(out, value, len);
+    out[len] = '\0';
+    return true;
+}
+
+const char* numericValue(const char* json, const char* key) {
+    const char* value = findJsonValue(json, key);
+    if (value != nullptr && *value == '"') {
+        value++;  // Quoted numbers were accepted by the String helpers
+    }
+    return value;
+}
+
+}  // namespace
+
+// ============================================
+// TOPIC / OPCODE
+// ============================================
+uint8_t extractActuatorGpioFromTopic(const char* topic) {
+    if (topic == nullptr) {
+        return ACTUATOR_CMD_INVALID_GPIO;
+    }
+    const char* segment = strstr(topic, "/actuator/");
+    if (segment == nullptr) {
+        return ACTUATOR_CMD_INVALID_GPIO;
+    }
+    segment += 10;
+    const char* end = strchr(segment, '/');
+    if (end == nullptr || end == segment) {
+        return ACTUATOR_CMD_INVALID_GPIO;
+    }
+    return static_cast<uint8_t>(atoi(segment));
+}
+
+ActuatorOpcode parseActuatorOpcode(const char* command) {
+    if (command == nullptr) return ActuatorOpcode::UNKNOWN;
+    if (strcasecmp(command, "ON") == 0) return ActuatorOpcode::ON;
+    if (strcasecmp(command, "OFF") == 0) return ActuatorOpcode::OFF;
+    if (strcasecmp(command, "PWM") == 0) return ActuatorOpcode::PWM;
+    if (strcasecmp(command, "TOGGLE") == 0) return ActuatorOpcode::TOGGLE;
+    return ActuatorOpcode::UNKNOWN;
+}
+
+const char* getActuatorOpcodeName(ActuatorOpcode opcode) {
+    switch (opcode) {
+        case ActuatorOpcode::ON:     return "ON";
+        case ActuatorOpcode::OFF:    return "OFF";
+        case ActuatorOpcode::PWM:    return "PWM";
+        case ActuatorOpcode::TOGGLE: return "TOGGLE";
+        default:                     return "UNKNOWN";
+    }
+}
+
+// ============================================
+// DECODE
+// ============================================
+bool decodeActuatorCommand(const char* topic, const char* payload, ActuatorCommandRecord& out) {
+    memset(&out, 0, sizeof(out));
+    if (payload == nullptr) {
+        payload = "";
+    }
+
+    out.gpio = extractActuatorGpioFromTopic(topic);
+    copyJsonValue(payload, "command", out.command, sizeof(out.command));
+    out.opcode = parseActuatorOpcode(out.command);
+
+    const char* value = numericValue(payload, "value");
+    out.value = value != nullptr ? strtof(value, nullptr) : 0.0f;
+    const char* duration = numericValue(payload, "duration");
+    out.duration_s = duration != nullptr ? static_cast<uint32_t>(strtoul(duration, nullptr, 10)) : 0;
+
+    copyJsonValue(payload, "correlation_id", out.correlation_id, sizeof(out.correlation_id));
+    if (!copyJsonValue(payload, "issued_by", out.issued_by, sizeof(out.issued_by)) ||
+        out.issued_by[0] == '\0') {
+        strncpy(out.issued_by, "system:unknown", sizeof(out.issued_by) - 1);
+    }
+
+    return out.gpio != ACTUATOR_CMD_INVALID_GPIO;
+}
@@ -0,0 +1,54 @@
+#ifndef SERVICES_ACTUATOR_ACTUATOR_COMMAND_DECODER_H
+#define SERVICES_ACTUATOR_ACTUATOR_COMMAND_DECODER_H
+
+#include <Arduino.h>
+
+#include "../../tasks/intent_contract.h"
+
+// ============================================
+// ACTUATOR COMMAND DECODER (Core 0 → POD record)
+// ============================================
+// MQTT actuator commands are decoded exactly once, on Core 0 in the MQTT
+// event handler, into a fixed-size record. The record is the Safety-Task
+// queue item; Core 1 executes it without parsing or String allocation.
+//
+// Field extraction follows the former String helpers in actuator_manager.cpp
+// ("key": value, quoted or bare, first occurrence wins) so accepted payloads
+// are unchanged. No heap use, no ArduinoJson — natively testable.
+// ============================================
+
+enum class ActuatorOpcode : uint8_t {
+    UNKNOWN = 0,
+    ON,
+    OFF,
+    PWM,
+    TOGGLE
+};
+
+static const size_t ACTUATOR_CMD_TEXT_LEN = 12;    // Echoed "command" field ("ON", "pwm", ...)
+static const size_t ACTUATOR_ISSUED_BY_LEN = 32;
+static const uint8_t ACTUATOR_CMD_INVALID_GPIO = 255;
+
+struct ActuatorCommandRecord {
+    uint8_t gpio;                                  // 255 = topic without /actuator/{gpio}/
+    ActuatorOpcode opcode;
+    bool recovery_intent;                          // clear_emergency on /actuator/emergency
+    float value;
+    uint32_t duration_s;
+    char command[ACTUATOR_CMD_TEXT_LEN];           // Raw command text for the response echo
+    char correlation_id[CORRELATION_ID_MAX_LEN];   // From payload only ("" if absent)
+    char issued_by[ACTUATOR_ISSUED_BY_LEN];        // "system:unknown" if absent
+    IntentMetadata metadata;
+};
+
+// Decodes topic + payload into out (metadata / recovery_intent are left zeroed
+// for the queue layer, which owns the intent contract). Always fills out;
+// returns false only if the topic carries no GPIO — the record is still
+// queued so Core 1 reports the failure exactly as before.
+bool decodeActuatorCommand(const char* topic, const char* payload, ActuatorCommandRecord& out);
+
+uint8_t extractActuatorGpioFromTopic(const char* topic);
+ActuatorOpcode parseActuatorOpcode(const char* command);
+const char* getActuatorOpcodeName(ActuatorOpcode opcode);
+
+#endif  // SERVICES_ACTUATOR_ACTUATOR_COMMAND_DECODER_H
@@ -25,67 +25,6 @@ static const char* TAG = "ACTUATOR";
 
 ActuatorManager& actuatorManager = ActuatorManager::getInstance();
 
-namespace {
-
-String extractJSONString(const String& json, const String& key) {
-  String pattern = "\"" + key + "\":";
-  int key_pos = json.indexOf(pattern);
-  if (key_pos == -1) {
-    return "";
-  }
-  key_pos += pattern.length();
-
-  // Skip optional quotes or whitespace
-  while (key_pos < json.length() && (json[key_pos] == ' ' || json[key_pos] == '\"')) {
-    if (json[key_pos] == '\"') {
-      key_pos++;
-      int end_quote = json.indexOf('\"', key_pos);
-      if (end_quote == -1) {
-        return "";
-      }
-      return json.substring(key_pos, end_quote);
-    }
-    key_pos++;
-  }
-
-  int value_end = json.indexOf(',', key_pos);
-  if (value_end == -1) {
-    value_end = json.indexOf('}', key_pos);
-  }
-  if (value_end == -1) {
-    value_end = json.length();
-  }
-
-  String value = json.substring(key_pos, value_end);
-  value.trim();
-  value.replace("\"", "");
-  return value;
-}
-
-float extractJSONFloat(const String& json, const String& key, float default_value = 0.0f) {
-  String value = extractJSONString(json, key);
-  return value.length() ? value.toFloat() : default_value;
-}
-
-uint32_t extractJSONUInt32(const String& json, const String& key, uint32_t default_value = 0) {
-  String value = extractJSONString(json, key);
-  return value.length() ? static_cast<uint32_t>(value.toInt()) : default_value;
-}
-
-bool extractJSONBool(const String& json, const String& key, bool default_value = false) {
-  String value = extractJSONString(json, key);
-  value.toLowerCase();
-  if (value == "true" || value == "1") {
-    return true;
-  }
-  if (value == "false" || value == "0") {
-    return false;
-  }
-  return default_value;
-}
-
-}  // namespace
-
 ActuatorManager& ActuatorManager::getInstance() {
   static ActuatorManager instance;
   return instance;
@@ -404,6 +343,20 @@ bool ActuatorManager::hasActuatorOnGPIO(uint8_t gpio) const {
   return findActuator(gpio) != nullptr;
 }
 
+bool ActuatorManager::hasRunningActuator() const {
+  // Called from the Safety-Task (Core 1), same owner as processActuatorLoops()
+  for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+    if (!actuators_[i].in_use) {
+      continue;
+    }
+    if (actuators_[i].config.current_state || actuators_[i].config.current_pwm > 0 ||
+        actuators_[i].command_duration_end_ms > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 ActuatorConfig ActuatorManager::getActuatorConfig(uint8_t gpio) const {
   const RegisteredActuator* actuator = findActuator(gpio);
   if (!actuator) {
@@ -696,46 +649,35 @@ void ActuatorManager::processActuatorLoops() {
   xSemaphoreGive(g_actuator_mutex);
 }
 
-uint8_t ActuatorManager::extractGPIOFromTopic(const String& topic) const {
-  int actuator_idx = topic.indexOf("/actuator/");
-  if (actuator_idx == -1) {
-    return 255;
-  }
-  int gpio_start = actuator_idx + 10;
-  int gpio_end = topic.indexOf('/', gpio_start);
-  if (gpio_end == -1) {
-    return 255;
-  }
-  String gpio_str = topic.substring(gpio_start, gpio_end);
-  gpio_str.trim();
-  if (gpio_str.length() == 0) {
-    return 255;
-  }
-  return static_cast<uint8_t>(gpio_str.toInt());
+bool ActuatorManager::handleActuatorCommand(const String& topic, const String& payload) {
+  ActuatorCommandRecord record;
+  decodeActuatorCommand(topic.c_str(), payload.c_str(), record);
+  return executeActuatorCommand(record);
 }
 
-bool ActuatorManager::handleActuatorCommand(const String& topic, const String& payload) {
+// Response/log view of a decoded record (Strings only on the reporting path)
+static ActuatorCommand toActuatorCommand(const ActuatorCommandRecord& record) {
+  ActuatorCommand command;
+  command.gpio = record.gpio;
+  command.command = record.command;
+  command.value = record.value;
+  command.duration_s = record.duration_s;
+  command.timestamp = millis();
+  command.correlation_id = record.correlation_id;
+  command.issued_by = record.issued_by;
+  return command;
+}
+
+bool ActuatorManager::executeActuatorCommand(const ActuatorCommandRecord& record) {
   // SAFETY-RTOS M4: protect actuators_[] against publishAllActuatorStatus (Core 0).
   xSemaphoreTake(g_actuator_mutex, portMAX_DELAY);
-  uint8_t gpio = extractGPIOFromTopic(topic);
-  if (gpio == 255) {
-    LOG_E(TAG, "Invalid actuator command topic: " + topic);
+  const uint8_t gpio = record.gpio;
+  if (gpio == ACTUATOR_CMD_INVALID_GPIO) {
+    LOG_E(TAG, "Invalid actuator command topic (no GPIO segment)");
     xSemaphoreGive(g_actuator_mutex);
     return false;
   }
 
-  ActuatorCommand command;
-  command.gpio = gpio;
-  command.command = extractJSONString(payload, "command");
-  command.value = extractJSONFloat(payload, "value", 0.0f);
-  command.duration_s = extractJSONUInt32(payload, "duration", 0);
-  command.timestamp = millis();
-  command.correlation_id = extractJSONString(payload, "correlation_id");
-  command.issued_by = extractJSONString(payload, "issued_by");
-  if (command.issued_by.length() == 0) {
-    command.issued_by = "system:unknown";
-  }
-
   // BUG-008 Fix: Check if actuator exists before processing command
   RegisteredActuator* actuator = findActuator(gpio);
   if (!actuator || !actuator->driver) {
@@ -747,7 +689,7 @@ bool ActuatorManager::handleActuatorCommand(const String& topic, const String& p
 
     String errorMessage = "Actuator not configured on GPIO " + String(gpio) +
                           ". Configure via API first.";
-    publishActuatorResponse(command, false, errorMessage);
+    publishActuatorResponse(toActuatorCommand(record), false, errorMessage);
     errorTracker.trackError(ERROR_ACTUATOR_NOT_FOUND,
                             ERROR_SEVERITY_ERROR,
                             "Command received for unconfigured actuator");
@@ -763,7 +705,7 @@ bool ActuatorManager::handleActuatorCommand(const String& topic, const String& p
     publishActuatorAlert(gpio, "emergency_stop",
                          "Actuator in emergency stop state. Clear emergency first.");
     publishActuatorStatus(gpio);
-    publishActuatorResponse(command, false,
+    publishActuatorResponse(toActuatorCommand(record), false,
                             "Actuator in emergency stop state. Clear emergency first.");
     xSemaphoreGive(g_actuator_mutex);
     return false;
@@ -778,7 +720,7 @@ bool ActuatorManager::handleActuatorCommand(const String& topic, const String& p
   }
 
   bool success = false;
-  String resultMessage = "Command executed";
+  const char* resultMessage = "Command executed";
   // Avoid duplicate actuator status publishes:
   // controlActuator/controlActuatorBinary already publish status on effective changes.
   // We only force a publish from this handler when command is a binary no-op
@@ -786,38 +728,50 @@ bool ActuatorManager::handleActuatorCommand(const String& topic, const String& p
   bool expect_internal_status_publish = true;
 
   // Make command_source visible in the first status frame emitted by control helpers.
-  actuator->last_command_source = command.issued_by;
-
-  if (command.command.equalsIgnoreCase("ON")) {
-    expect_internal_status_publish = !actuator->config.current_state;
-    success = controlActuatorBinary(gpio, true);
-    if (success && command.duration_s > 0) {
-      actuator->command_duration_end_ms = millis() + (static_cast<unsigned long>(command.duration_s) * 1000UL);
-      LOG_I(TAG, "Actuator GPIO " + String(gpio) + " ON with duration " +
-                  String(command.duration_s) + "s (auto-OFF scheduled)");
-    }
-    if (!success) resultMessage = "Failed to turn actuator ON";
-  } else if (command.command.equalsIgnoreCase("OFF")) {
-    expect_internal_status_publish = actuator->config.current_state;
-    success = controlActuatorBinary(gpio, false);
-    if (!success) resultMessage = "Failed to turn actuator OFF";
-  } else if (command.command.equalsIgnoreCase("PWM")) {
-    expect_internal_status_publish = true;
-    success = controlActuator(gpio, command.value);
-    if (!success) resultMessage = "Failed to set PWM value";
-  } else if (command.command.equalsIgnoreCase("TOGGLE")) {
-    expect_internal_status_publish = true;
-    success = controlActuatorBinary(gpio, !actuator->config.current_state);
-    if (!success) resultMessage = "Failed to toggle actuator";
-  } else {
-    LOG_E(TAG, "Unknown actuator command: " + command.command);
-    resultMessage = "Unknown command: " + command.command;
+  // Repeated commands from the same source keep the existing String (no allocation).
+  if (actuator->last_command_source != record.issued_by) {
+    actuator->last_command_source = record.issued_by;
+  }
+
+  switch (record.opcode) {
+    case ActuatorOpcode::ON:
+      expect_internal_status_publish = !actuator->config.current_state;
+      success = controlActuatorBinary(gpio, true);
+      if (success && record.duration_s > 0) {
+        actuator->command_duration_end_ms = millis() + (static_cast<unsigned long>(record.duration_s) * 1000UL);
+        LOG_I(TAG, "Actuator GPIO " + String(gpio) + " ON with duration " +
+                    String(record.duration_s) + "s (auto-OFF scheduled)");
+      }
+      if (!success) resultMessage = "Failed to turn actuator ON";
+      break;
+    case ActuatorOpcode::OFF:
+      expect_internal_status_publish = actuator->config.current_state;
+      success = controlActuatorBinary(gpio, false);
+      if (!success) resultMessage = "Failed to turn actuator OFF";
+      break;
+    case ActuatorOpcode::PWM:
+      expect_internal_status_publish = true;
+      success = controlActuator(gpio, record.value);
+      if (!success) resultMessage = "Failed to set PWM value";
+      break;
+    case ActuatorOpcode::TOGGLE:
+      expect_internal_status_publish = true;
+      success = controlActuatorBinary(gpio, !actuator->config.current_state);
+      if (!success) resultMessage = "Failed to toggle actuator";
+      break;
+    default:
+      LOG_E(TAG, "Unknown actuator command: " + String(record.command));
+      publishActuatorResponse(toActuatorCommand(record), false,
+                              "Unknown command: " + String(record.command));
+      xSemaphoreGive(g_actuator_mutex);
+      return false;
   }
 
-  publishActuatorResponse(command, success, resultMessage);
+  // Actuation done — the response/log path below may allocate
+  publishActuatorResponse(toActuatorCommand(record), success, resultMessage);
   if (success) {
     LOG_I(TAG, "Actuator command executed: GPIO " + String(gpio) +
-             " " + command.command + " = " + String(command.value));
+             " " + String(record.command) + " = " + String(record.value));
     if (!expect_internal_status_publish) {
       publishActuatorStatus(gpio);
     }
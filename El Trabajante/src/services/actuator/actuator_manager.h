@@ -7,6 +7,7 @@
 
 #include "../../models/actuator_types.h"
 #include "../../models/error_codes.h"
+#include "actuator_command_decoder.h"
 #include "actuator_drivers/iactuator_driver.h"
 
 class GPIOManager;
@@ -33,6 +34,8 @@ public:
   bool hasActuatorOnGPIO(uint8_t gpio) const;
   ActuatorConfig getActuatorConfig(uint8_t gpio) const;
   uint8_t getActiveActuatorCount() const { return actuator_count_; }
+  // Power management: true while any actuator is ON (duration/runtime timers running)
+  bool hasRunningActuator() const;
 
   /** Count configured actuators whose subzone_id matches (Phase 9). */
   uint8_t countActuatorsWithSubzone(const String& subzone_id) const;
@@ -55,7 +58,10 @@ public:
   void setUncoveredActuatorsToSafeState();
 
   // MQTT integration
+  // Decodes + executes (tests / direct callers). Queue path: executeActuatorCommand().
   bool handleActuatorCommand(const String& topic, const String& payload);
+  // Executes a record decoded on Core 0 — no parsing, no String until the response.
+  bool executeActuatorCommand(const ActuatorCommandRecord& record);
   // CP-F2: Accepts pre-parsed JsonArray from central Config-Push parse — no internal deserializeJson.
   bool handleActuatorConfig(JsonArray actuators, const String& correlation_id = "");
   void publishActuatorStatus(uint8_t gpio);
@@ -90,7 +96,6 @@ private:
 
   bool validateActuatorConfig(const ActuatorConfig& config) const;
   std::unique_ptr<IActuatorDriver> createDriver(const String& actuator_type) const;
-  uint8_t extractGPIOFromTopic(const String& topic) const;
   bool parseActuatorDefinition(const JsonObjectConst& obj,
                                ActuatorConfig& config,
                                String& error_message,
@@ -14,6 +14,7 @@
 
 #include "../../tasks/intent_contract.h"
 #include "../../tasks/sensor_command_queue.h"   // For queue overflow telemetry (AUT-5)
+#include "../../error_handling/resource_monitor.h"  // Heap delta around heartbeat build
 
 #ifndef MQTT_USE_PUBSUBCLIENT
     #include "../../tasks/safety_task.h"         // g_safety_task_handle, NOTIFY_* bits
@@ -43,6 +44,11 @@ static std::atomic<uint32_t> g_publish_outbox_noncritical_drops{0};
 // Publishing directly from this context can re-enter MQTT internals on Core 0.
 static std::atomic<bool> g_in_mqtt_event_callback{false};
 
+// ESP-IDF mqtt_task stack: increased from 10240 — static data_buf saves 4096 B on
+// stack, +6144 B headroom for future handlers and config payload growth.
+// Watermark is tracked by ResourceMonitor ("mqtt_task").
+static constexpr uint32_t MQTT_TASK_STACK_BYTES = 16384;
+
 static constexpr unsigned long MANAGED_RECONNECT_BASE_DELAY_MS = 1500;
 static constexpr unsigned long MANAGED_RECONNECT_MAX_DELAY_MS = 12000;
 // Give ESP-IDF auto-reconnect a head-start before issuing manual reconnect calls.
@@ -353,8 +359,7 @@ bool MQTTClient::connect(const MQTTConfig& config) {
         mqtt_cfg.password = config.password.c_str();
     }
 
-    mqtt_cfg.task_stack = 16384;  // increased from 10240: static data_buf saves 4096 B on stack,
-                                  // +6144 B headroom for future handlers and config payload growth
+    mqtt_cfg.task_stack = MQTT_TASK_STACK_BYTES;
     mqtt_cfg.task_prio = 3;
 
     // Do not force custom network/reconnect timeouts here.
@@ -406,6 +411,9 @@ bool MQTTClient::connect(const MQTTConfig& config) {
     // Consequence: mqttClient.connect() in setup() will NOT fail even if broker is unreachable.
     // Portal recovery for MQTT failure now happens via the 5-minute persistent-failure timer
     // in loop() (CircuitBreaker OPEN → provisionManager.startAPModeForReconfig()).
+    // ESP-IDF owns the task; ResourceMonitor resolves the handle by name on every sample.
+    resourceMonitor.registerTask("mqtt_task", nullptr, MQTT_TASK_STACK_BYTES);
+
     LOG_I(TAG, "[M2] ESP-IDF MQTT client started — connecting in background");
     return true;
 
@@ -596,9 +604,9 @@ bool MQTTClient::publish(const String& topic, const String& payload, uint8_t qos
     }
 
     if (payload.length() == 0) {
-        LOG_E(TAG, "Empty payload blocked for topic: " + topic);
-        errorTracker.logCommunicationError(ERROR_MQTT_PAYLOAD_INVALID,
-                                           ("Empty payload for: " + topic).c_str());
+        LOGF_E(TAG, "Empty payload blocked for topic: %s", topic.c_str());
+        errorTracker.reportCommunicationError(ERROR_MQTT_PAYLOAD_INVALID,
+                                              ErrorArgs("Empty payload blocked").topic(topic.c_str()));
         return false;
     }
 
@@ -675,9 +683,9 @@ bool MQTTClient::publish(const String& topic, const String& payload, uint8_t qos
         // Don't count as failure if we're not connected (pre-connection publish attempt)
         if (g_mqtt_connected.load()) {
             circuit_breaker_.recordFailure();
-            LOG_E(TAG, "Publish failed (connected but error): " + topic);
-            errorTracker.logCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
-                                               ("Publish failed: " + topic).c_str());
+            LOGF_E(TAG, "Publish failed (connected but error): %s", topic.c_str());
+            errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                                  ErrorArgs("Publish failed").topic(topic.c_str()));
         } else {
             LOG_W(TAG, "Publish before MQTT connected, dropping: " + topic);
         }
@@ -699,9 +707,9 @@ bool MQTTClient::publish(const String& topic, const String& payload, uint8_t qos
         LOG_D(TAG, "Published: " + topic);
     } else {
         circuit_breaker_.recordFailure();
-        LOG_E(TAG, "Publish failed: " + topic);
-        errorTracker.logCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
-                                           ("Publish failed: " + topic).c_str());
+        LOGF_E(TAG, "Publish failed: %s", topic.c_str());
+        errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                              ErrorArgs("Publish failed").topic(topic.c_str()));
         if (circuit_breaker_.isOpen()) {
             LOG_W(TAG, "Circuit Breaker OPENED after failure threshold");
         }
@@ -748,8 +756,8 @@ bool MQTTClient::safePublish(const String& topic, const String& payload, uint8_t
         vTaskDelay(pdMS_TO_TICKS(backoff_ms));
     }
 
-    LOG_W(TAG, "SafePublish failed after " + String(max_attempts) +
-               " attempts: " + topic);
+    LOGF_W(TAG, "SafePublish failed after %u attempts: %s",
+           static_cast<unsigned>(max_attempts), topic.c_str());
     return false;
 }
 
@@ -1097,8 +1105,8 @@ void MQTTClient::processSubscriptionQueue() {
 #ifndef MQTT_USE_PUBSUBCLIENT
 
 // Helper: Check if topic is sensor_data (for AUT-6 retry logic)
-static bool isSensorDataTopic(const String& topic) {
-    return topic.indexOf("/sensor_data/") != -1 || topic.indexOf("/sensor/") != -1;
+static bool isSensorDataTopic(const char* topic) {
+    return strstr(topic, "/sensor_data/") != nullptr || strstr(topic, "/sensor/") != nullptr;
 }
 
 // Helper: Get backoff delay in ms for retry attempt (100ms → 500ms → 1000ms)
@@ -1131,7 +1139,7 @@ void MQTTClient::processPublishQueue() {
            xQueueReceive(g_publish_queue, &req, 0) == pdTRUE) {
         if (now_ms < req.next_retry_ms) {
             if (xQueueSend(g_publish_queue, &req, 0) != pdTRUE) {
-                LOG_W(TAG, "Publish retry queue full during backoff, dropping: " + String(req.topic));
+                LOGF_W(TAG, "Publish retry queue full during backoff, dropping: %s", req.topic);
                 g_publish_outbox_noncritical_drops.fetch_add(1);
             }
             break;
@@ -1150,9 +1158,8 @@ void MQTTClient::processPublishQueue() {
             continue;
         }
 
-        bool is_sensor_data = isSensorDataTopic(String(req.topic));
+        bool is_sensor_data = isSensorDataTopic(req.topic);
         const char* drop_code = (msg_id == -2) ? "PUBLISH_OUTBOX_FULL" : "EXECUTE_FAIL";
-        String drop_reason = String("Publish dropped for topic ") + String(req.topic);
 
         // AUT-55: Under queue pressure (fill >= watermark), only retry critical messages.
         // Non-critical sensor_data retries are shed to preserve queue headroom.
@@ -1176,9 +1183,9 @@ void MQTTClient::processPublishQueue() {
                        String(backoff_ms) + "ms backoff): " + String(req.topic));
 
             if (xQueueSend(g_publish_queue, &req, 0) != pdTRUE) {
-                LOG_W(TAG, "Publish retry queue full, dropping: " + String(req.topic));
-                errorTracker.logCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
-                                                   ("Publish retry queue full: " + String(req.topic)).c_str());
+                LOGF_W(TAG, "Publish retry queue full, dropping: %s", req.topic);
+                errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                                      ErrorArgs("Publish retry queue full").topic(req.topic));
                 if (req.critical) {
                     publishIntentOutcome("publish",
                                          req.metadata,
@@ -1193,17 +1200,20 @@ void MQTTClient::processPublishQueue() {
             continue;
         }
 
-        LOG_W(TAG, String("Publish dropped") +
-              (under_pressure && is_sensor_data ? " (backpressure shed)" : " after retries") +
-              ": " + String(req.topic));
-        errorTracker.logCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
-                                           ("Publish failed: " + String(req.topic)).c_str());
+        const char* drop_what = (under_pressure && is_sensor_data)
+                                    ? "Publish dropped (backpressure shed)"
+                                    : "Publish dropped after retries";
+        LOGF_W(TAG, "%s: %s", drop_what, req.topic);
+        errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                              ErrorArgs(drop_what).topic(req.topic));
 
         if (is_sensor_data) {
             g_publish_outbox_noncritical_drops.fetch_add(1);
         }
 
         if (req.critical) {
+            // Only the critical branch needs the reason text (built lazily)
+            String drop_reason = String("Publish dropped for topic ") + String(req.topic);
             publishIntentOutcome("publish",
                                  req.metadata,
                                  "failed",
@@ -1333,6 +1343,13 @@ uint8_t MQTTClient::getCircuitBreakerFailureCount() const {
 // ============================================
 // HEARTBEAT SYSTEM
 // ============================================
+uint32_t MQTTClient::getMsUntilNextHeartbeat(unsigned long now) const {
+    const unsigned long heartbeat_interval_ms =
+        registration_confirmed_ ? HEARTBEAT_INTERVAL_MS : HEARTBEAT_REGISTRATION_RETRY_MS;
+    unsigned long elapsed = now - last_heartbeat_;
+    return elapsed >= heartbeat_interval_ms ? 0 : static_cast<uint32_t>(heartbeat_interval_ms - elapsed);
+}
+
 void MQTTClient::publishHeartbeat(bool force) {
     unsigned long current_time = millis();
     const unsigned long heartbeat_interval_ms =
@@ -1350,6 +1367,7 @@ void MQTTClient::publishHeartbeat(bool force) {
     }
 
     last_heartbeat_ = current_time;
+    HeapDeltaScope heap_scope(HeapSubsystem::HEARTBEAT_BUILD);
 
     // M5.4: Heap monitoring — logged alongside every heartbeat for long-term leak detection.
     LOG_I("MEM", "[MEM] Free heap: " + String(ESP.getFreeHeap()) +
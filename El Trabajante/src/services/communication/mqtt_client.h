@@ -113,6 +113,8 @@ public:
 
     // Heartbeat
     void publishHeartbeat(bool force = false);
+    // Power management: ms until the next regular heartbeat is due (0 = due now)
+    uint32_t getMsUntilNextHeartbeat(unsigned long now) const;
 
     // Status
     String getConnectionStatus();
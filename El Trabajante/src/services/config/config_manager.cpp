@@ -6,6 +6,7 @@
 #include "../../error_handling/error_tracker.h"
 #include "../../models/error_codes.h"
 #include "../../models/sensor_registry.h"  // For I2C sensor detection
+#include "../sensor/temperature_compensation.h"  // Calibrated ph / ec keys
 #include <WiFi.h>
 
 // ESP-IDF TAG convention for structured logging
@@ -1236,27 +1237,21 @@ bool ConfigManager::saveSystemConfig(const SystemConfig& config) {
     return true;  // ✅ Signalisiere Erfolg - RAM-Config ist aktiv
   #endif
 
-  if (!storageManager.beginTransaction()) {
-    LOG_E(TAG, "ConfigManager: Failed to start system_config transaction");
-    return false;
-  }
-  if (!storageManager.beginNamespace("system_config", false)) {
+  // Scoped handle: waits only for other users of system_config, not the global session
+  NvsScopedNamespace ns("system_config", false);
+  if (!ns.isOpen()) {
     LOG_E(TAG, "ConfigManager: Failed to open system_config namespace for writing");
-    storageManager.endTransaction();
     return false;
   }
 
   // 2026-01-15 Phase 1E-D: Use new compact keys (≤15 chars)
   // NOTE: Only writes to NEW keys - old keys become orphaned but harmless
   bool success = true;
-  success &= storageManager.putString(NVS_SYS_ESP_ID, config.esp_id);
-  success &= storageManager.putString(NVS_SYS_DEV_NAME, config.device_name);
-  success &= storageManager.putUInt8(NVS_SYS_STATE, (uint8_t)config.current_state);
-  success &= storageManager.putString(NVS_SYS_SFM_REASON, config.safe_mode_reason);  // ✅ NEW KEY
-  success &= storageManager.putUInt16(NVS_SYS_BOOT_COUNT, config.boot_count);
-
-  storageManager.endNamespace();
-  storageManager.endTransaction();
+  success &= ns.putString(NVS_SYS_ESP_ID, config.esp_id);
+  success &= ns.putString(NVS_SYS_DEV_NAME, config.device_name);
+  success &= ns.putUInt8(NVS_SYS_STATE, (uint8_t)config.current_state);
+  success &= ns.putString(NVS_SYS_SFM_REASON, config.safe_mode_reason);  // ✅ NEW KEY
+  success &= ns.putUInt16(NVS_SYS_BOOT_COUNT, config.boot_count);
 
   if (success) {
     system_config_ = config;
@@ -1527,6 +1522,55 @@ static void buildActuatorKey(char* buffer, size_t buffer_size, uint8_t index, co
 #define NVS_SEN_INTERVAL   "sen_%d_int"      // sen_0_int = 10 chars ✅ (CRITICAL: was broken!)
 #define NVS_SEN_OW         "sen_%d_ow"       // sen_0_ow = 9 chars ✅ (OneWire ROM-Code)
 #define NVS_SEN_I2C        "sen_%d_i2c"      // sen_0_i2c = 10 chars ✅ (I2C device address)
+#define NVS_SEN_BATCH      "sen_%d_bat"      // sen_0_bat = 10 chars ✅ (raw batch policy, packed)
+#define NVS_SEN_OW_RES     "sen_%d_owr"      // sen_0_owr = 10 chars ✅ (DS18B20 resolution bits)
+#define NVS_SEN_PULSE_PPU  "sen_%d_ppu"      // sen_0_ppu = 10 chars ✅ (pulses per unit, float)
+#define NVS_SEN_PULSE_FILT "sen_%d_pgf"      // sen_0_pgf = 10 chars ✅ (PCNT glitch filter ns)
+#define NVS_SEN_DIN        "sen_%d_din"      // sen_0_din = 10 chars ✅ (digital input, packed)
+#define NVS_SEN_CAL_SLOPE  "sen_%d_cs"       // sen_0_cs  =  9 chars ✅ (linear calibration slope)
+#define NVS_SEN_CAL_OFFSET "sen_%d_co"       // sen_0_co  =  9 chars ✅ (linear calibration offset)
+#define NVS_SEN_TC_ALPHA   "sen_%d_tca"      // sen_0_tca = 10 chars ✅ (EC temperature coefficient)
+#define NVS_SEN_TC_SRC     "sen_%d_tcs"      // sen_0_tcs = 10 chars ✅ (temp source gpio + max age, packed)
+#define NVS_SEN_TC_TYPE    "sen_%d_tct"      // sen_0_tct = 10 chars ✅ (temp source value type)
+#define NVS_SEN_EXC        "sen_%d_exc"      // sen_0_exc = 10 chars ✅ (excitation pin, packed)
+
+// Digital input packed into one NVS u32: bits 0-15 debounce (ms), bit 16 active_low
+static const uint32_t NVS_SEN_DIN_DEFAULT = 50UL | (1UL << 16);
+
+static uint32_t packDigitalInput(const SensorConfig& config) {
+  return static_cast<uint32_t>(config.debounce_ms) | (config.input_active_low ? (1UL << 16) : 0UL);
+}
+
+// Temperature source packed into one NVS u32: bits 0-7 gpio (255 = off), bits 8-23 max age (s)
+static const uint32_t NVS_SEN_TC_SRC_DEFAULT = 255UL | (120UL << 8);
+
+static uint32_t packTempSource(const SensorConfig& config) {
+  return static_cast<uint32_t>(config.temp_source_gpio) |
+         (static_cast<uint32_t>(config.temp_max_age_s) << 8);
+}
+
+// Excitation packed into one NVS u32: bits 0-7 gpio (255 = off), bits 8-23 settle (ms), bit 24 active_high
+static const uint32_t NVS_SEN_EXC_DEFAULT = 255UL | (100UL << 8) | (1UL << 24);
+
+static uint32_t packExcitation(const SensorConfig& config) {
+  return static_cast<uint32_t>(config.excitation_gpio) |
+         (static_cast<uint32_t>(config.excitation_settle_ms) << 8) |
+         (config.excitation_active_high ? (1UL << 24) : 0UL);
+}
+
+// Raw batch policy packed into one NVS u32 (0 = batching off):
+//   bits 0-7 max_samples, bits 8-15 flush interval (s), bits 16-31 flush delta (raw counts)
+static uint32_t packSensorBatchPolicy(const SensorConfig& config) {
+  return static_cast<uint32_t>(config.batch_max_samples) |
+         (static_cast<uint32_t>(config.batch_flush_interval_ms / 1000) & 0xFF) << 8 |
+         static_cast<uint32_t>(config.batch_flush_delta) << 16;
+}
+
+static void unpackSensorBatchPolicy(uint32_t packed, SensorConfig& config) {
+  config.batch_max_samples = static_cast<uint8_t>(packed & 0xFF);
+  config.batch_flush_interval_ms = ((packed >> 8) & 0xFF) * 1000UL;
+  config.batch_flush_delta = static_cast<uint16_t>(packed >> 16);
+}
 
 // Legacy keys (deprecated, some >15 chars - kept for migration only)
 // NOTE: Old keys "sensor_%d_*" were OK for small indices but:
@@ -1696,21 +1740,18 @@ bool ConfigManager::saveSensorConfig(const SensorConfig& config) {
   // 2026-01-15 Phase 1E-B: New key schema (≤15 chars) for NVS compatibility
   // NOTE: Only writes to NEW keys - old keys become orphaned but harmless
   // ============================================
-  if (!storageManager.beginTransaction()) {
-    LOG_E(TAG, "ConfigManager: Failed to start sensor_config transaction");
-    return false;
-  }
-  if (!storageManager.beginNamespace("sensor_config", false)) {
+  // Scoped handle: waits only for other users of sensor_config, not the global session
+  NvsScopedNamespace ns("sensor_config", false);
+  if (!ns.isOpen()) {
     LOG_E(TAG, "ConfigManager: Failed to open sensor_config namespace");
-    storageManager.endTransaction();
     return false;
   }
 
   // Find index for this GPIO (or use next available)
   // Check new key first, then fallback to old key for migration scenario
-  uint8_t sensor_count = storageManager.getUInt8(NVS_SEN_COUNT, 0);
+  uint8_t sensor_count = ns.getUInt8(NVS_SEN_COUNT, 0);
   if (sensor_count == 0) {
-    sensor_count = storageManager.getUInt8(NVS_SEN_COUNT_OLD, 0);
+    sensor_count = ns.getUInt8(NVS_SEN_COUNT_OLD, 0);
   }
   int8_t existing_index = -1;
 
@@ -1722,24 +1763,24 @@ bool ConfigManager::saveSensorConfig(const SensorConfig& config) {
   for (uint8_t i = 0; i < sensor_count; i++) {
     // Try new key first
     snprintf(key, sizeof(key), NVS_SEN_GPIO, i);
-    uint8_t stored_gpio = storageManager.getUInt8(key, 255);
+    uint8_t stored_gpio = ns.getUInt8(key, 255);
     if (stored_gpio == 255) {
       // Fallback to old key
       char old_key[32];
       snprintf(old_key, sizeof(old_key), NVS_SEN_GPIO_OLD, i);
-      stored_gpio = storageManager.getUInt8(old_key, 255);
+      stored_gpio = ns.getUInt8(old_key, 255);
     }
 
     // Also check sensor_type to distinguish multi-value sensors on same GPIO
     snprintf(key, sizeof(key), NVS_SEN_TYPE, i);
     String stored_type;
-    if (storageManager.keyExists(key)) {
-      stored_type = storageManager.getString(key, "");
+    if (ns.keyExists(key)) {
+      stored_type = ns.getString(key, "");
     } else {
       char old_key[32];
       snprintf(old_key, sizeof(old_key), NVS_SEN_TYPE_OLD, i);
-      if (storageManager.keyExists(old_key)) {
-        stored_type = storageManager.getString(old_key, "");
+      if (ns.keyExists(old_key)) {
+        stored_type = ns.getString(old_key, "");
       }
     }
 
@@ -1749,7 +1790,7 @@ bool ConfigManager::saveSensorConfig(const SensorConfig& config) {
       if (config.onewire_address.length() > 0) {
         char owKey[16];
         snprintf(owKey, sizeof(owKey), NVS_SEN_OW, i);
-        String stored_ow = storageManager.getString(owKey, "");
+        String stored_ow = ns.getString(owKey, "");
         if (stored_ow != config.onewire_address) {
           continue;  // Different sensor on same GPIO — skip
         }
@@ -1759,7 +1800,7 @@ bool ConfigManager::saveSensorConfig(const SensorConfig& config) {
       if (config.i2c_address != 0) {
         char i2cKey[16];
         snprintf(i2cKey, sizeof(i2cKey), NVS_SEN_I2C, i);
-        uint8_t stored_i2c = storageManager.getUInt8(i2cKey, 0);
+        uint8_t stored_i2c = ns.getUInt8(i2cKey, 0);
           if (stored_i2c != config.i2c_address) {
           continue;  // Different I2C device — skip
         }
@@ -1776,35 +1817,39 @@ bool ConfigManager::saveSensorConfig(const SensorConfig& config) {
 
   // GPIO
   snprintf(key, sizeof(key), NVS_SEN_GPIO, index);
-  success &= storageManager.putUInt8(key, config.gpio);
+  success &= ns.putUInt8(key, config.gpio);
 
   // Sensor Type
   snprintf(key, sizeof(key), NVS_SEN_TYPE, index);
-  success &= storageManager.putString(key, config.sensor_type);
+  success &= ns.putString(key, config.sensor_type);
 
   // Sensor Name
   snprintf(key, sizeof(key), NVS_SEN_NAME, index);
-  success &= storageManager.putString(key, config.sensor_name);
+  success &= ns.putString(key, config.sensor_name);
 
   // Subzone ID
   snprintf(key, sizeof(key), NVS_SEN_SZ, index);
-  success &= storageManager.putString(key, config.subzone_id);
+  success &= ns.putString(key, config.subzone_id);
 
   // Active Flag
   snprintf(key, sizeof(key), NVS_SEN_ACTIVE, index);
-  success &= storageManager.putBool(key, config.active);
+  success &= ns.putBool(key, config.active);
 
   // Raw Mode
   snprintf(key, sizeof(key), NVS_SEN_RAW, index);
-  success &= storageManager.putBool(key, config.raw_mode);
+  success &= ns.putBool(key, config.raw_mode);
 
   // Operating Mode
   snprintf(key, sizeof(key), NVS_SEN_MODE, index);
-  success &= storageManager.putString(key, config.operating_mode);
+  success &= ns.putString(key, config.operating_mode);
 
   // Measurement Interval
   snprintf(key, sizeof(key), NVS_SEN_INTERVAL, index);
-  success &= storageManager.putULong(key, config.measurement_interval_ms);
+  success &= ns.putULong(key, config.measurement_interval_ms);
+
+  // Raw Batch Policy (packed)
+  snprintf(key, sizeof(key), NVS_SEN_BATCH, index);
+  success &= ns.putULong(key, packSensorBatchPolicy(config));
 
   // OneWire Address (if present - for DS18B20, DS18S20, DS1822)
   // Only save if non-empty to avoid wasting NVS space for non-OneWire sensors
@@ -1841,9 +1886,11 @@ bool ConfigManager::saveSensorConfig(const SensorConfig& config) {
           // Don't set success=false - CRC errors are warnings, not hard failures
         }
 
-        // 4. Save validated ROM-Code to NVS
+        // 4. Save validated ROM-Code + DS18B20 resolution to NVS
+        snprintf(key, sizeof(key), NVS_SEN_OW_RES, index);
+        success &= ns.putUInt8(key, config.onewire_resolution);
         snprintf(key, sizeof(key), NVS_SEN_OW, index);
-        if (!storageManager.putString(key, config.onewire_address)) {
+        if (!ns.putString(key, config.onewire_address)) {
           LOG_E(TAG, "ConfigManager: Failed to save OneWire ROM-Code to NVS");
           errorTracker.trackError(ERROR_NVS_WRITE_FAILED, ERROR_SEVERITY_ERROR,
                                  "OneWire ROM-Code NVS write failed");
@@ -1860,16 +1907,39 @@ bool ConfigManager::saveSensorConfig(const SensorConfig& config) {
   // A config-push with i2c_address=0 (non-I2C sensor) must overwrite any stale NVS value
   // left from a previous I2C sensor on the same GPIO (e.g. SHT31 -> DS18B20 reconfiguration).
   snprintf(key, sizeof(key), NVS_SEN_I2C, index);
-  success &= storageManager.putUInt8(key, config.i2c_address);
+  success &= ns.putUInt8(key, config.i2c_address);
+
+  // Pulse counter calibration: always written, same stale-value reasoning as I2C
+  snprintf(key, sizeof(key), NVS_SEN_PULSE_PPU, index);
+  success &= ns.putFloat(key, config.pulses_per_unit);
+  snprintf(key, sizeof(key), NVS_SEN_PULSE_FILT, index);
+  success &= ns.putUInt16(key, config.pulse_filter_ns);
+
+  // Digital input debounce / polarity: always written (stale-value reasoning as above)
+  snprintf(key, sizeof(key), NVS_SEN_DIN, index);
+  success &= ns.putULong(key, packDigitalInput(config));
+
+  // Calibration + temperature compensation (ph, ec): always written
+  snprintf(key, sizeof(key), NVS_SEN_CAL_SLOPE, index);
+  success &= ns.putFloat(key, config.cal_slope);
+  snprintf(key, sizeof(key), NVS_SEN_CAL_OFFSET, index);
+  success &= ns.putFloat(key, config.cal_offset);
+  snprintf(key, sizeof(key), NVS_SEN_TC_ALPHA, index);
+  success &= ns.putFloat(key, config.temp_coefficient);
+  snprintf(key, sizeof(key), NVS_SEN_TC_SRC, index);
+  success &= ns.putULong(key, packTempSource(config));
+  snprintf(key, sizeof(key), NVS_SEN_TC_TYPE, index);
+  success &= ns.putString(key, config.temp_source_type);
+
+  // Excitation pin: always written
+  snprintf(key, sizeof(key), NVS_SEN_EXC, index);
+  success &= ns.putULong(key, packExcitation(config));
 
   // Update count if new sensor (use new key only!)
   if (existing_index < 0) {
-    success &= storageManager.putUInt8(NVS_SEN_COUNT, sensor_count + 1);
+    success &= ns.putUInt8(NVS_SEN_COUNT, sensor_count + 1);
   }
 
-  storageManager.endNamespace();
-  storageManager.endTransaction();
-
   if (success) {
     LOG_I(TAG, "ConfigManager: Saved sensor config for GPIO " + String(config.gpio));
   } else {
@@ -2025,11 +2095,18 @@ bool ConfigManager::loadSensorConfig(SensorConfig sensors[], uint8_t max_sensors
     snprintf(old_key, sizeof(old_key), NVS_SEN_INTERVAL_OLD, i);
     config.measurement_interval_ms = migrateReadUInt32(new_key, old_key, 30000);  // Default: 30s
 
+    // Raw Batch Policy — no legacy key, default 0 = per-sample publish
+    snprintf(new_key, sizeof(new_key), NVS_SEN_BATCH, i);
+    unpackSensorBatchPolicy(storageManager.getULong(new_key, 0), config);
+
     // OneWire Address — only for ds18b20 (OneWire bus sensors)
     // I2C sensors (sht31_*, bmp280_*, bme280_*) have no OW address — skip to avoid NVS [E] noise
     snprintf(new_key, sizeof(new_key), NVS_SEN_OW, i);
     if (config.sensor_type == "ds18b20") {
         config.onewire_address = migrateReadString(new_key, "", "");
+        // No legacy key — default 12 bit = DS18B20 power-on resolution
+        snprintf(new_key, sizeof(new_key), NVS_SEN_OW_RES, i);
+        config.onewire_resolution = storageManager.getUInt8(new_key, 12);
     } else {
         config.onewire_address = "";
     }
@@ -2039,6 +2116,46 @@ bool ConfigManager::loadSensorConfig(SensorConfig sensors[], uint8_t max_sensors
     snprintf(new_key, sizeof(new_key), NVS_SEN_I2C, i);
     config.i2c_address = storageManager.getUInt8(new_key, 0);
 
+    // Pulse counter calibration — only for flow_meter / rain_gauge (avoid NVS [E] noise)
+    const SensorCapability* pulse_cap = findSensorCapability(config.sensor_type);
+    if (pulse_cap && pulse_cap->is_pulse_counter) {
+        snprintf(new_key, sizeof(new_key), NVS_SEN_PULSE_PPU, i);
+        config.pulses_per_unit = storageManager.getFloat(new_key, 0.0f);
+        snprintf(new_key, sizeof(new_key), NVS_SEN_PULSE_FILT, i);
+        config.pulse_filter_ns = storageManager.getUInt16(new_key, 1000);
+    }
+
+    // Digital input debounce / polarity — only for edge-interrupt types
+    if (pulse_cap && pulse_cap->is_digital_input) {
+        snprintf(new_key, sizeof(new_key), NVS_SEN_DIN, i);
+        uint32_t din = storageManager.getULong(new_key, NVS_SEN_DIN_DEFAULT);
+        config.debounce_ms = static_cast<uint16_t>(din & 0xFFFF);
+        config.input_active_low = (din & (1UL << 16)) != 0;
+    }
+
+    // Calibration + temperature compensation — only for ph / ec
+    if (pulse_cap && TemperatureCompensation::kindForSensorType(pulse_cap->server_sensor_type) != TempCompKind::NONE) {
+        snprintf(new_key, sizeof(new_key), NVS_SEN_CAL_SLOPE, i);
+        config.cal_slope = storageManager.getFloat(new_key, 0.0f);
+        snprintf(new_key, sizeof(new_key), NVS_SEN_CAL_OFFSET, i);
+        config.cal_offset = storageManager.getFloat(new_key, 0.0f);
+        snprintf(new_key, sizeof(new_key), NVS_SEN_TC_ALPHA, i);
+        config.temp_coefficient = storageManager.getFloat(new_key, TEMP_COMP_DEFAULT_EC_ALPHA);
+        snprintf(new_key, sizeof(new_key), NVS_SEN_TC_SRC, i);
+        uint32_t tc_src = storageManager.getULong(new_key, NVS_SEN_TC_SRC_DEFAULT);
+        config.temp_source_gpio = static_cast<uint8_t>(tc_src & 0xFF);
+        config.temp_max_age_s = static_cast<uint16_t>((tc_src >> 8) & 0xFFFF);
+        snprintf(new_key, sizeof(new_key), NVS_SEN_TC_TYPE, i);
+        config.temp_source_type = storageManager.getStringObj(new_key, "");
+    }
+
+    // Excitation pin (any sensor type, default off)
+    snprintf(new_key, sizeof(new_key), NVS_SEN_EXC, i);
+    uint32_t exc = storageManager.getULong(new_key, NVS_SEN_EXC_DEFAULT);
+    config.excitation_gpio = static_cast<uint8_t>(exc & 0xFF);
+    config.excitation_settle_ms = static_cast<uint16_t>((exc >> 8) & 0xFFFF);
+    config.excitation_active_high = (exc & (1UL << 24)) != 0;
+
     // Reset runtime fields
     config.last_raw_value = 0;
     config.last_reading = 0;
@@ -2157,6 +2274,39 @@ bool ConfigManager::removeSensorConfig(uint8_t gpio, const String& onewire_addre
     snprintf(next_key, sizeof(next_key), NVS_SEN_OW, i + 1);
     String next_ow = storageManager.getStringObj(next_key, "");
 
+    snprintf(next_key, sizeof(next_key), NVS_SEN_BATCH, i + 1);
+    uint32_t next_batch = storageManager.getULong(next_key, 0);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_OW_RES, i + 1);
+    uint8_t next_ow_res = storageManager.getUInt8(next_key, 12);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_PULSE_PPU, i + 1);
+    float next_ppu = storageManager.getFloat(next_key, 0.0f);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_PULSE_FILT, i + 1);
+    uint16_t next_pulse_filter = storageManager.getUInt16(next_key, 1000);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_DIN, i + 1);
+    uint32_t next_din = storageManager.getULong(next_key, NVS_SEN_DIN_DEFAULT);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_CAL_SLOPE, i + 1);
+    float next_cal_slope = storageManager.getFloat(next_key, 0.0f);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_CAL_OFFSET, i + 1);
+    float next_cal_offset = storageManager.getFloat(next_key, 0.0f);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_TC_ALPHA, i + 1);
+    float next_tc_alpha = storageManager.getFloat(next_key, TEMP_COMP_DEFAULT_EC_ALPHA);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_TC_SRC, i + 1);
+    uint32_t next_tc_src = storageManager.getULong(next_key, NVS_SEN_TC_SRC_DEFAULT);
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_TC_TYPE, i + 1);
+    String next_tc_type = storageManager.getStringObj(next_key, "");
+
+    snprintf(next_key, sizeof(next_key), NVS_SEN_EXC, i + 1);
+    uint32_t next_exc = storageManager.getULong(next_key, NVS_SEN_EXC_DEFAULT);
+
     // Write to current index (new keys only!)
     snprintf(key, sizeof(key), NVS_SEN_GPIO, i);
     storageManager.putUInt8(key, next_gpio);
@@ -2184,6 +2334,39 @@ bool ConfigManager::removeSensorConfig(uint8_t gpio, const String& onewire_addre
 
     snprintf(key, sizeof(key), NVS_SEN_OW, i);
     storageManager.putString(key, next_ow);
+
+    snprintf(key, sizeof(key), NVS_SEN_BATCH, i);
+    storageManager.putULong(key, next_batch);
+
+    snprintf(key, sizeof(key), NVS_SEN_OW_RES, i);
+    storageManager.putUInt8(key, next_ow_res);
+
+    snprintf(key, sizeof(key), NVS_SEN_PULSE_PPU, i);
+    storageManager.putFloat(key, next_ppu);
+
+    snprintf(key, sizeof(key), NVS_SEN_PULSE_FILT, i);
+    storageManager.putUInt16(key, next_pulse_filter);
+
+    snprintf(key, sizeof(key), NVS_SEN_DIN, i);
+    storageManager.putULong(key, next_din);
+
+    snprintf(key, sizeof(key), NVS_SEN_CAL_SLOPE, i);
+    storageManager.putFloat(key, next_cal_slope);
+
+    snprintf(key, sizeof(key), NVS_SEN_CAL_OFFSET, i);
+    storageManager.putFloat(key, next_cal_offset);
+
+    snprintf(key, sizeof(key), NVS_SEN_TC_ALPHA, i);
+    storageManager.putFloat(key, next_tc_alpha);
+
+    snprintf(key, sizeof(key), NVS_SEN_TC_SRC, i);
+    storageManager.putULong(key, next_tc_src);
+
+    snprintf(key, sizeof(key), NVS_SEN_TC_TYPE, i);
+    storageManager.putString(key, next_tc_type);
+
+    snprintf(key, sizeof(key), NVS_SEN_EXC, i);
+    storageManager.putULong(key, next_exc);
   }
 
   // Clear last sensor (new keys only!)
@@ -2216,6 +2399,39 @@ bool ConfigManager::removeSensorConfig(uint8_t gpio, const String& onewire_addre
   snprintf(key, sizeof(key), NVS_SEN_OW, last_idx);
   storageManager.putString(key, "");
 
+  snprintf(key, sizeof(key), NVS_SEN_BATCH, last_idx);
+  storageManager.putULong(key, 0);
+
+  snprintf(key, sizeof(key), NVS_SEN_OW_RES, last_idx);
+  storageManager.putUInt8(key, 12);
+
+  snprintf(key, sizeof(key), NVS_SEN_PULSE_PPU, last_idx);
+  storageManager.putFloat(key, 0.0f);
+
+  snprintf(key, sizeof(key), NVS_SEN_PULSE_FILT, last_idx);
+  storageManager.putUInt16(key, 1000);
+
+  snprintf(key, sizeof(key), NVS_SEN_DIN, last_idx);
+  storageManager.putULong(key, NVS_SEN_DIN_DEFAULT);
+
+  snprintf(key, sizeof(key), NVS_SEN_CAL_SLOPE, last_idx);
+  storageManager.putFloat(key, 0.0f);
+
+  snprintf(key, sizeof(key), NVS_SEN_CAL_OFFSET, last_idx);
+  storageManager.putFloat(key, 0.0f);
+
+  snprintf(key, sizeof(key), NVS_SEN_TC_ALPHA, last_idx);
+  storageManager.putFloat(key, TEMP_COMP_DEFAULT_EC_ALPHA);
+
+  snprintf(key, sizeof(key), NVS_SEN_TC_SRC, last_idx);
+  storageManager.putULong(key, NVS_SEN_TC_SRC_DEFAULT);
+
+  snprintf(key, sizeof(key), NVS_SEN_TC_TYPE, last_idx);
+  storageManager.putString(key, "");
+
+  snprintf(key, sizeof(key), NVS_SEN_EXC, last_idx);
+  storageManager.putULong(key, NVS_SEN_EXC_DEFAULT);
+
   // Update count (new key only!)
   storageManager.putUInt8(NVS_SEN_COUNT, sensor_count - 1);
 
@@ -2287,23 +2503,18 @@ bool ConfigManager::saveActuatorConfig(const ActuatorConfig actuators[], uint8_t
   // 2026-01-15: New key schema (≤15 chars) for NVS compatibility
   // NOTE: Only writes to NEW keys - old keys become orphaned but harmless
   // ============================================
-  if (!storageManager.beginTransaction()) {
-    LOG_E(TAG, "ConfigManager: Failed to start actuator_config transaction");
-    return false;
-  }
-  if (!storageManager.beginNamespace("actuator_config", false)) {
+  // Scoped handle: waits only for other users of actuator_config, not the global session
+  NvsScopedNamespace ns("actuator_config", false);
+  if (!ns.isOpen()) {
     LOG_E(TAG, "ConfigManager: Failed to open actuator_config namespace for writing");
-    storageManager.endTransaction();
     return false;
   }
 
   // Save count with new key
-  bool success = storageManager.putUInt8(NVS_ACT_COUNT, actuator_count);
+  bool success = ns.putUInt8(NVS_ACT_COUNT, actuator_count);
 
   if (!success) {
     LOG_E(TAG, "ConfigManager: Failed to save actuator count");
-    storageManager.endNamespace();
-    storageManager.endTransaction();
     return false;
   }
 
@@ -2320,52 +2531,49 @@ bool ConfigManager::saveActuatorConfig(const ActuatorConfig actuators[], uint8_t
 
     // GPIO (Primary Pin)
     snprintf(key, sizeof(key), NVS_ACT_GPIO, i);
-    success &= storageManager.putUInt8(key, config.gpio);
+    success &= ns.putUInt8(key, config.gpio);
 
     // Aux GPIO (H-Bridge, Valves)
     snprintf(key, sizeof(key), NVS_ACT_AUX, i);
-    success &= storageManager.putUInt8(key, config.aux_gpio);
+    success &= ns.putUInt8(key, config.aux_gpio);
 
     // Actuator Type
     snprintf(key, sizeof(key), NVS_ACT_TYPE, i);
-    success &= storageManager.putString(key, config.actuator_type);
+    success &= ns.putString(key, config.actuator_type);
 
     // Actuator Name
     snprintf(key, sizeof(key), NVS_ACT_NAME, i);
-    success &= storageManager.putString(key, config.actuator_name);
+    success &= ns.putString(key, config.actuator_name);
 
     // Subzone ID
     snprintf(key, sizeof(key), NVS_ACT_SZ, i);
-    success &= storageManager.putString(key, config.subzone_id);
+    success &= ns.putString(key, config.subzone_id);
 
     // Active Flag
     snprintf(key, sizeof(key), NVS_ACT_ACTIVE, i);
-    success &= storageManager.putBool(key, config.active);
+    success &= ns.putBool(key, config.active);
 
     // Critical Flag (Safety!)
     snprintf(key, sizeof(key), NVS_ACT_CRIT, i);
-    success &= storageManager.putBool(key, config.critical);
+    success &= ns.putBool(key, config.critical);
 
     // Inverted Logic
     snprintf(key, sizeof(key), NVS_ACT_INV, i);
-    success &= storageManager.putBool(key, config.inverted_logic);
+    success &= ns.putBool(key, config.inverted_logic);
 
     // Default State (Boot behavior)
     snprintf(key, sizeof(key), NVS_ACT_DEF_ST, i);
-    success &= storageManager.putBool(key, config.default_state);
+    success &= ns.putBool(key, config.default_state);
 
     // Default PWM
     snprintf(key, sizeof(key), NVS_ACT_DEF_PWM, i);
-    success &= storageManager.putUInt8(key, config.default_pwm);
+    success &= ns.putUInt8(key, config.default_pwm);
 
     if (!success) {
       LOG_E(TAG, "ConfigManager: Failed to save actuator " + String(i));
     }
   }
 
-  storageManager.endNamespace();
-  storageManager.endTransaction();
-
   if (success) {
     LOG_I(TAG, "ConfigManager: Actuator configurations saved successfully (" +
              String(actuator_count) + " actuators)");
@@ -0,0 +1,357 @@
+#include "library_manager.h"
+
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "storage_manager.h"
+#include "../../drivers/hal/esp32_ota_partition_hal.h"
+#include "../communication/mqtt_client.h"
+#include "../../tasks/safety_task.h"
+#include "../../tasks/intent_contract.h"
+#include "../../core/system_controller.h"
+#include "../../utils/logger.h"
+#include "../../utils/time_manager.h"
+#include "../../utils/topic_builder.h"
+
+static const char* TAG = "OTA";
+
+static const char* OTA_NVS_NAMESPACE = "ota";
+static const char* OTA_NVS_CHECKPOINT = "ckpt";
+
+extern SystemConfig g_system_config;
+
+// Arduino core hook: without it initArduino() confirms a PENDING_VERIFY image
+// right at boot. Validation is deferred to LibraryManager::loop().
+extern "C" bool verifyRollbackLater() {
+  return true;
+}
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+static ESP32OtaPartitionHal s_ota_hal;
+
+// Session state is shared by the MQTT context (ota_begin, chunks, ota_abort)
+// and the Comm-Task (idle timeout)
+static StaticSemaphore_t s_session_mutex_storage;
+static SemaphoreHandle_t s_session_mutex = nullptr;
+
+namespace {
+class SessionLockGuard {
+ public:
+  SessionLockGuard() { xSemaphoreTakeRecursive(s_session_mutex, portMAX_DELAY); }
+  ~SessionLockGuard() { xSemaphoreGiveRecursive(s_session_mutex); }
+};
+}  // namespace
+
+LibraryManager& libraryManager = LibraryManager::getInstance();
+
+LibraryManager& LibraryManager::getInstance() {
+  static LibraryManager instance;
+  return instance;
+}
+
+LibraryManager::LibraryManager()
+  : updater_(s_ota_hal),
+    reboot_pending_(false),
+    reboot_requested_ms_(0),
+    pending_verify_(false),
+    boot_ms_(0),
+    last_chunk_ms_(0),
+    checkpoint_sector_(0) {
+  s_session_mutex = xSemaphoreCreateRecursiveMutexStatic(&s_session_mutex_storage);
+}
+
+// ============================================
+// LIFECYCLE
+// ============================================
+void LibraryManager::begin() {
+  boot_ms_ = millis();
+  pending_verify_ = s_ota_hal.isRunningPendingVerify();
+  if (pending_verify_) {
+    LOG_W(TAG, "New firmware image pending verification — rollback in " +
+               String(OTA_BOOT_VALIDATION_TIMEOUT_MS / 1000) + " s without server registration");
+  }
+  OtaCheckpoint checkpoint;
+  if (loadCheckpoint(checkpoint)) {
+    LOG_I(TAG, "Resumable update stored: image " + String(checkpoint.manifest.image_id) +
+               " at " + String(checkpoint.stream_offset) + "/" + String(checkpoint.manifest.stream_size));
+  }
+}
+
+void LibraryManager::loop(unsigned long now_ms) {
+  if (pending_verify_) {
+    if (mqttClient.isRegistrationConfirmed()) {
+      pending_verify_ = false;
+      if (s_ota_hal.markRunningValid()) {
+        LOG_I(TAG, "Firmware image confirmed (server registration) — rollback cancelled");
+        publishStatus("validated", OtaResult::OK);
+      } else {
+        LOG_E(TAG, "Failed to confirm running firmware image");
+      }
+    } else if (now_ms - boot_ms_ > OTA_BOOT_VALIDATION_TIMEOUT_MS) {
+      pending_verify_ = false;
+      LOG_E(TAG, "Firmware image not validated in time — rolling back");
+      flushIntentOutcomeBatches(true);
+      s_ota_hal.rollbackAndReboot();
+    }
+  }
+
+  // A server that stops sending (restart, lost link) must not leave the
+  // actuators in their safe hold. millis() under the lock: a chunk applied
+  // since the caller sampled now_ms would otherwise look like a wrap-around.
+  if (updater_.isActive()) {
+    SessionLockGuard lock;
+    if (updater_.isActive() && millis() - last_chunk_ms_ > OTA_IDLE_TIMEOUT_MS) {
+      endSession("timeout", true);
+    }
+  }
+
+  // Delta COPY steps between chunks: the MQTT callback emits at most one step
+  // per chunk, the rest runs here (work_pending keeps the Comm-Task cadence)
+  if (updater_.hasPendingCopy()) {
+    SessionLockGuard lock;
+    if (updater_.hasPendingCopy()) {
+      OtaResult result = updater_.continuePatch();
+      // Ack only at the end of the COPY: the server continues from next_offset
+      if (result != OtaResult::OK || !updater_.hasPendingCopy()) {
+        handleResult(result);
+      } else {
+        last_chunk_ms_ = millis();
+        saveCheckpointOnNewSector();
+      }
+    }
+  }
+
+  // millis() under the lock for the reboot delay too: reboot_requested_ms_ is
+  // set on the MQTT task
+  if (reboot_pending_) {
+    bool reboot_due;
+    {
+      SessionLockGuard lock;
+      reboot_due = millis() - reboot_requested_ms_ >= OTA_REBOOT_DELAY_MS;
+    }
+    if (reboot_due) {
+      LOG_W(TAG, "Rebooting into updated firmware");
+      flushIntentOutcomeBatches(true);  // Outcomes still in the batch window
+      delay(100);
+      ESP.restart();
+    }
+  }
+}
+
+uint16_t LibraryManager::getMaxChunkSize() const {
+#ifdef MQTT_USE_PUBSUBCLIENT
+  // Base64 (4/3) + JSON envelope must fit one PubSubClient packet
+  return static_cast<uint16_t>((MQTT_MAX_PACKET_SIZE - 256) * 3 / 4);
+#else
+  return static_cast<uint16_t>(OTA_MAX_CHUNK_SIZE);
+#endif
+}
+
+// ============================================
+// SESSION
+// ============================================
+static bool sameManifest(const OtaManifest& a, const OtaManifest& b) {
+  return a.image_id == b.image_id && a.type == b.type && a.stream_size == b.stream_size &&
+         a.image_size == b.image_size && a.image_crc32 == b.image_crc32 &&
+         memcmp(a.image_sha256, b.image_sha256, sizeof(a.image_sha256)) == 0 &&
+         a.base_size == b.base_size && a.base_crc32 == b.base_crc32 && a.chunk_size == b.chunk_size;
+}
+
+OtaResult LibraryManager::beginUpdate(const OtaManifest& manifest) {
+  SessionLockGuard lock;
+  if (reboot_pending_) {
+    return OtaResult::NOT_ACTIVE;
+  }
+  if (manifest.chunk_size > getMaxChunkSize()) {
+    return OtaResult::BAD_MANIFEST;
+  }
+  // Repeated ota_begin (e.g. server restart) → report the live offset
+  if (updater_.isActive() && sameManifest(updater_.getManifest(), manifest)) {
+    last_chunk_ms_ = millis();
+    return OtaResult::OK;
+  }
+
+  OtaResult result = OtaResult::BAD_MANIFEST;
+  OtaCheckpoint checkpoint;
+  if (loadCheckpoint(checkpoint) && sameManifest(checkpoint.manifest, manifest)) {
+    result = updater_.resume(checkpoint);
+    if (result == OtaResult::OK) {
+      LOG_I(TAG, "Resuming image " + String(manifest.image_id) + " at offset " +
+                 String(updater_.getNextOffset()));
+    } else {
+      LOG_W(TAG, String("Checkpoint not resumable (") + OtaUpdater::resultToString(result) +
+                 ") — starting over");
+    }
+  }
+  if (result != OtaResult::OK) {
+    result = updater_.begin(manifest);
+  }
+  if (result != OtaResult::OK) {
+    LOG_E(TAG, String("OTA begin rejected: ") + OtaUpdater::resultToString(result));
+    return result;
+  }
+
+  saveCheckpoint();
+  last_chunk_ms_ = millis();
+  enterUpdateState();
+  LOG_I(TAG, String("OTA session: image ") + String(manifest.image_id) +
+             (manifest.type == OtaImageType::DELTA ? " (delta " : " (full ") +
+             String(manifest.stream_size) + " B → " + String(manifest.image_size) + " B)");
+  return OtaResult::OK;
+}
+
+void LibraryManager::abortUpdate(const char* reason) {
+  SessionLockGuard lock;
+  endSession(reason, false);
+}
+
+// keep_checkpoint: the flash contents up to the current offset stay valid, a
+// later ota_begin with the same manifest continues there
+void LibraryManager::endSession(const char* reason, bool keep_checkpoint) {
+  bool was_active = updater_.isActive();
+  if (was_active && keep_checkpoint) {
+    saveCheckpoint();
+  }
+  updater_.abort();
+  if (!keep_checkpoint) {
+    clearCheckpoint();
+  }
+  if (was_active) {
+    leaveUpdateState();
+    LOG_W(TAG, String("OTA aborted: ") + reason);
+    if (keep_checkpoint) {
+      LOG_I(TAG, "Resumable at offset " + String(updater_.getNextOffset()) + " with the same manifest");
+    }
+  }
+  publishStatus("aborted", OtaResult::NOT_ACTIVE);
+}
+
+// SystemController remembers the state before the download and resumes it
+void LibraryManager::enterUpdateState() {
+  systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_STARTED, millis());
+  notifySafetyTaskOtaHold();
+}
+
+// Actuators stay in their safe state until the server commands them again
+void LibraryManager::leaveUpdateState() {
+  systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_FINISHED, millis());
+}
+
+// ============================================
+// CHUNKS
+// ============================================
+void LibraryManager::handleChunkMessage(const char* payload) {
+  static uint8_t chunk[OTA_MAX_CHUNK_SIZE];
+
+  DynamicJsonDocument doc(strlen(payload) + 256);
+  if (deserializeJson(doc, payload) != DeserializationError::Ok) {
+    LOG_W(TAG, "OTA chunk: invalid JSON");
+    return;
+  }
+  SessionLockGuard lock;
+  if (!updater_.isActive() || doc["id"].as<uint32_t>() != updater_.getManifest().image_id) {
+    publishStatus("idle", OtaResult::NOT_ACTIVE);
+    return;
+  }
+
+  const char* data = doc["data"] | "";
+  size_t length = OtaUpdater::decodeBase64(data, strlen(data), chunk, sizeof(chunk));
+  OtaResult result = length == 0
+      ? OtaResult::BAD_CHUNK
+      : updater_.applyChunk(doc["off"].as<uint32_t>(), chunk, length, doc["crc"].as<uint32_t>());
+
+  handleResult(result);
+}
+
+// Chunk and continuePatch() results; caller holds the session lock
+void LibraryManager::handleResult(OtaResult result) {
+  switch (result) {
+    case OtaResult::OK:
+    case OtaResult::BUSY:
+      last_chunk_ms_ = millis();
+      saveCheckpointOnNewSector();
+      publishStatus("receiving", result);
+      break;
+    case OtaResult::DUPLICATE:
+    case OtaResult::OUT_OF_ORDER:
+    case OtaResult::BAD_CHUNK:
+    case OtaResult::CHUNK_CRC:
+      // Session intact — server resends from next_offset
+      LOG_D(TAG, String("OTA chunk ") + OtaUpdater::resultToString(result) +
+                 ", expecting offset " + String(updater_.getNextOffset()));
+      publishStatus("receiving", result);
+      break;
+    case OtaResult::COMPLETE:
+      clearCheckpoint();
+      LOG_I(TAG, "OTA image verified and activated — reboot in " + String(OTA_REBOOT_DELAY_MS) + " ms");
+      publishStatus("complete", result);
+      reboot_requested_ms_ = millis();
+      reboot_pending_ = true;
+      break;
+    default:
+      clearCheckpoint();
+      leaveUpdateState();
+      LOG_E(TAG, String("OTA failed: ") + OtaUpdater::resultToString(result));
+      publishStatus("failed", result);
+      break;
+  }
+}
+
+// ============================================
+// PERSISTENCE
+// ============================================
+bool LibraryManager::loadCheckpoint(OtaCheckpoint& checkpoint) {
+  NvsScopedNamespace ns(OTA_NVS_NAMESPACE, true);
+  return ns.isOpen() &&
+         ns.getBytes(OTA_NVS_CHECKPOINT, &checkpoint, sizeof(checkpoint)) == sizeof(checkpoint) &&
+         checkpoint.magic == OTA_CHECKPOINT_MAGIC;
+}
+
+void LibraryManager::saveCheckpoint() {
+  OtaCheckpoint checkpoint = updater_.getCheckpoint();
+  checkpoint_sector_ = checkpoint.image_offset / OTA_FLASH_SECTOR_SIZE;
+  NvsScopedNamespace ns(OTA_NVS_NAMESPACE, false);
+  if (!ns.isOpen() || !ns.putBytes(OTA_NVS_CHECKPOINT, &checkpoint, sizeof(checkpoint))) {
+    LOG_W(TAG, "OTA checkpoint not persisted — resume would restart earlier");
+  }
+}
+
+// One NVS write per flash sector instead of per chunk: resume() repairs
+// whatever was written into the checkpoint's sector after it was taken
+void LibraryManager::saveCheckpointOnNewSector() {
+  if (updater_.getImageOffset() / OTA_FLASH_SECTOR_SIZE != checkpoint_sector_) {
+    saveCheckpoint();
+  }
+}
+
+void LibraryManager::clearCheckpoint() {
+  NvsScopedNamespace ns(OTA_NVS_NAMESPACE, false);
+  if (ns.isOpen()) {
+    ns.eraseKey(OTA_NVS_CHECKPOINT);
+  }
+}
+
+// ============================================
+// STATUS
+// ============================================
+void LibraryManager::publishStatus(const char* state, OtaResult result) {
+  const OtaManifest& manifest = updater_.getManifest();
+  DynamicJsonDocument doc(320);
+  doc["esp_id"] = g_system_config.esp_id;
+  doc["state"] = state;
+  doc["result"] = OtaUpdater::resultToString(result);
+  doc["image_id"] = manifest.image_id;
+  doc["next_offset"] = updater_.getNextOffset();
+  doc["stream_size"] = manifest.stream_size;
+  doc["image_offset"] = updater_.getImageOffset();
+  doc["max_chunk"] = getMaxChunkSize();
+  doc["ts"] = (unsigned long)timeManager.getUnixTimestamp();
+
+  String payload;
+  serializeJson(doc, payload);
+  // Chunk acks are retried by the server; terminal states must arrive
+  uint8_t qos = strcmp(state, "receiving") == 0 ? 0 : 1;
+  mqttClient.publish(TopicBuilder::buildSystemOtaStatusTopic(), payload, qos);
+}
@@ -0,0 +1,90 @@
+#ifndef SERVICES_CONFIG_LIBRARY_MANAGER_H
+#define SERVICES_CONFIG_LIBRARY_MANAGER_H
+
+#include <Arduino.h>
+#include "ota_updater.h"
+#include "../../models/system_types.h"
+
+// ============================================
+// LIBRARY MANAGER (firmware OTA over MQTT)
+// ============================================
+// Orchestrates OtaUpdater for the MQTT transport:
+//
+//   1. system/command "ota_begin" with the manifest (incl. image_sha256 as
+//      64 hex digits) → resumes from the NVS checkpoint when image id +
+//      manifest match, otherwise starts at 0.
+//      Response carries next_offset and the largest chunk the transport takes.
+//   2. Server publishes chunks on .../system/ota/chunk:
+//        {"id":42,"off":8192,"crc":3735928559,"data":"<base64>"}
+//      Each chunk is acked on .../system/ota/status with the next offset
+//      (a chunk may be taken only in part while a delta COPY runs; BUSY =
+//      nothing taken, an ack follows when the COPY is done);
+//      the checkpoint (NVS "ota/ckpt") is stored when the image offset enters
+//      a new flash sector, so a resume repeats at most one sector.
+//      No accepted chunk for OTA_IDLE_TIMEOUT_MS → session aborted ("timeout"),
+//      the checkpoint stays for a later ota_begin with the same manifest.
+//   3. Last chunk → CRC32 + SHA-256 of the written slot verified → activated
+//      → reboot. The manifest itself is not signed: the OTA channel trusts
+//      the broker (topic ACLs), see OtaUpdater.
+//   4. First boot of the new image stays PENDING_VERIFY until the server
+//      confirms the registration; no confirmation within
+//      OTA_BOOT_VALIDATION_TIMEOUT_MS → rollback to the previous slot.
+//
+// Safety: while a session is active the system is STATE_LIBRARY_DOWNLOADING
+// (actuator commands rejected at admission) and the Safety-Task drives all
+// actuators to their safe state (NOTIFY_OTA_SAFE_HOLD).
+//
+// Threading: ota_begin/chunks run in the MQTT event context (Core 0),
+// loop() on the Comm-Task (Core 0); the session is guarded by a mutex.
+// ============================================
+
+static const uint32_t OTA_BOOT_VALIDATION_TIMEOUT_MS = 300000;  // 5 min to reach the server
+static const uint32_t OTA_REBOOT_DELAY_MS = 2000;               // Let the COMPLETE status go out
+static const uint32_t OTA_IDLE_TIMEOUT_MS = 60000;              // Stalled session → abort, keep checkpoint
+
+class LibraryManager {
+public:
+  static LibraryManager& getInstance();
+
+  // Boot: rollback state of the running image
+  void begin();
+  // Comm-Task: boot validation, idle timeout, delta COPY steps, reboot after a completed update
+  void loop(unsigned long now_ms);
+
+  OtaResult beginUpdate(const OtaManifest& manifest);
+  void handleChunkMessage(const char* payload);
+  void abortUpdate(const char* reason);
+
+  bool isUpdateActive() const { return updater_.isActive(); }
+  bool hasPendingWork() const { return updater_.hasPendingCopy(); }
+  uint32_t getNextOffset() const { return updater_.getNextOffset(); }
+  uint16_t getMaxChunkSize() const;
+  bool isPendingVerify() const { return pending_verify_; }
+
+private:
+  LibraryManager();
+  LibraryManager(const LibraryManager&) = delete;
+  LibraryManager& operator=(const LibraryManager&) = delete;
+
+  OtaUpdater updater_;
+  volatile bool reboot_pending_;
+  unsigned long reboot_requested_ms_;
+  bool pending_verify_;
+  unsigned long boot_ms_;
+  unsigned long last_chunk_ms_;       // Session start, last applied chunk or COPY step
+  uint32_t checkpoint_sector_;        // Image sector of the stored checkpoint
+
+  void handleResult(OtaResult result);
+  void endSession(const char* reason, bool keep_checkpoint);
+  void enterUpdateState();
+  void leaveUpdateState();
+  bool loadCheckpoint(OtaCheckpoint& checkpoint);
+  void saveCheckpoint();
+  void saveCheckpointOnNewSector();
+  void clearCheckpoint();
+  void publishStatus(const char* state, OtaResult result);
+};
+
+extern LibraryManager& libraryManager;
+
+#endif
@@ -0,0 +1,154 @@
+#include "nvs_accounting.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================
+// LIFECYCLE
+// ============================================
+NvsAccounting::NvsAccounting() {
+    reset();
+}
+
+void NvsAccounting::reset() {
+    memset(namespaces_, 0, sizeof(namespaces_));
+    namespace_count_ = 0;
+    active_ = nullptr;
+    free_entries_ = 0;
+    cache_valid_ = false;
+    low_space_reported_ = false;
+    stat_queries_ = 0;
+}
+
+// ============================================
+// SESSIONS
+// ============================================
+void NvsAccounting::beginSession(const char* namespace_name) {
+    active_ = findOrAddNamespace(namespace_name);
+    if (active_ != nullptr) {
+        active_->sessions++;
+    }
+    // Other writers (WiFi driver, ConfigUpdateQueue) share the partition →
+    // never trust a cache from a previous session.
+    cache_valid_ = false;
+    low_space_reported_ = false;
+}
+
+void NvsAccounting::endSession() {
+    active_ = nullptr;
+}
+
+void NvsAccounting::beginScopedSession(const char* namespace_name) {
+    NvsNamespaceUsage* usage = findOrAddNamespace(namespace_name);
+    if (usage != nullptr) {
+        usage->sessions++;
+    }
+    // Same reasoning as beginSession(): the first write re-queries
+    cache_valid_ = false;
+    low_space_reported_ = false;
+}
+
+NvsNamespaceUsage* NvsAccounting::findOrAddNamespace(const char* namespace_name) {
+    if (namespace_name == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < namespace_count_; i++) {
+        if (strncmp(namespaces_[i].name, namespace_name, sizeof(namespaces_[i].name)) == 0) {
+            return &namespaces_[i];
+        }
+    }
+    if (namespace_count_ >= NVS_MAX_TRACKED_NAMESPACES) {
+        return nullptr;
+    }
+    NvsNamespaceUsage& usage = namespaces_[namespace_count_++];
+    strncpy(usage.name, namespace_name, sizeof(usage.name) - 1);
+    usage.name[sizeof(usage.name) - 1] = '\0';
+    return &usage;
+}
+
+// ============================================
+// RESERVATION
+// ============================================
+size_t NvsAccounting::queryFreeEntries(INvsStatsSource& source) {
+    stat_queries_++;
+    free_entries_ = source.queryFreeEntries();
+    cache_valid_ = true;
+    return free_entries_;
+}
+
+NvsReserveResult NvsAccounting::reserve(size_t entries, INvsStatsSource& source) {
+    return reserveFor(active_, entries, source);
+}
+
+NvsReserveResult NvsAccounting::reserveScoped(const char* namespace_name, size_t entries,
+                                              INvsStatsSource& source) {
+    return reserveFor(findOrAddNamespace(namespace_name), entries, source);
+}
+
+NvsReserveResult NvsAccounting::reserveFor(NvsNamespaceUsage* usage, size_t entries,
+                                           INvsStatsSource& source) {
+    bool fresh = false;
+    if (!cache_valid_) {
+        queryFreeEntries(source);
+        fresh = true;
+    }
+    if (free_entries_ < entries && !fresh) {
+        // Cache may be stale (page GC, erased keys) → confirm before refusing
+        queryFreeEntries(source);
+    }
+    if (free_entries_ < entries) {
+        return NvsReserveResult::FULL;
+    }
+
+    free_entries_ -= entries;
+    if (usage != nullptr) {
+        usage->writes++;
+        usage->entries_written += static_cast<uint32_t>(entries);
+    }
+
+    if (free_entries_ < NVS_LOW_SPACE_ENTRIES && !low_space_reported_) {
+        low_space_reported_ = true;
+        return NvsReserveResult::LOW_SPACE;
+    }
+    return NvsReserveResult::OK;
+}
+
+void NvsAccounting::invalidate() {
+    cache_valid_ = false;
+}
+
+size_t NvsAccounting::entriesForString(size_t length) {
+    return 1 + (length + 1 + NVS_ENTRY_DATA_BYTES - 1) / NVS_ENTRY_DATA_BYTES;
+}
+
+size_t NvsAccounting::entriesForBlob(size_t length) {
+    return 2 + (length + NVS_ENTRY_DATA_BYTES - 1) / NVS_ENTRY_DATA_BYTES;
+}
+
+void NvsAccounting::setUsedEntries(size_t index, uint32_t used_entries) {
+    if (index < namespace_count_) {
+        namespaces_[index].used_entries = used_entries;
+    }
+}
+
+// ============================================
+// DIAGNOSTICS
+// ============================================
+void NvsAccounting::appendDiagnosticsJson(String& json) const {
+    // Compact keys: n=namespace, used=entries in flash, e=entries written this boot
+    char buf[80];
+    snprintf(buf, sizeof(buf), ",\"nvs\":{\"free\":%lu,\"stat_q\":%lu,\"ns\":[",
+             static_cast<unsigned long>(free_entries_),
+             static_cast<unsigned long>(stat_queries_));
+    json += buf;
+    for (size_t i = 0; i < namespace_count_; i++) {
+        const NvsNamespaceUsage& usage = namespaces_[i];
+        snprintf(buf, sizeof(buf), "%s{\"n\":\"%s\",\"used\":%lu,\"e\":%lu}",
+                 i == 0 ? "" : ",",
+                 usage.name,
+                 static_cast<unsigned long>(usage.used_entries),
+                 static_cast<unsigned long>(usage.entries_written));
+        json += buf;
+    }
+    json += "]}";
+}
@@ -0,0 +1,110 @@
+#ifndef SERVICES_CONFIG_NVS_ACCOUNTING_H
+#define SERVICES_CONFIG_NVS_ACCOUNTING_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================
+// NVS STATS SOURCE (HAL-Interface)
+// ============================================
+// Target: Preferences::freeEntries() (nvs_get_stats, partition-wide).
+// Tests: mock that counts the calls.
+class INvsStatsSource {
+public:
+    virtual ~INvsStatsSource() = default;
+    virtual size_t queryFreeEntries() = 0;
+};
+
+enum class NvsReserveResult : uint8_t {
+    OK = 0,
+    LOW_SPACE,   // Reserved, but < NVS_LOW_SPACE_ENTRIES left (reported once per session)
+    FULL         // Not enough entries even after a fresh stats query
+};
+
+struct NvsNamespaceUsage {
+    char name[16];
+    uint32_t sessions;         // beginNamespace() count this boot
+    uint32_t writes;           // Successful reservations (put* calls)
+    uint32_t entries_written;  // Entries consumed incl. string/blob spans
+    uint32_t used_entries;     // Entries in flash (nvs_get_used_entry_count), filled by caller
+};
+
+// ============================================
+// NVS ACCOUNTING (cached free-entry statistics)
+// ============================================
+// nvs_get_stats() walks every page of the partition. Calling it before each
+// put*() made a config apply with dozens of keys spend most of its time in
+// stats queries. Instead: one query per session (lazy, on the first write),
+// then the cached value is decremented by the entry span of every write.
+//
+// Re-query only when the cache says "not enough space" (erase/GC may have
+// freed entries in the meantime) or after an unexpected write failure
+// (invalidate()). Overwriting an existing key also consumes a new entry in
+// NVS (the old one is only marked erased), so decrementing per write stays
+// conservative.
+//
+// Entry spans (32-byte NVS entries):
+//   primitive  1
+//   string     1 + ceil((len + 1) / 32)   (header + data incl. '\0')
+//   blob       2 + ceil(len / 32)         (index + chunk header + data)
+// ============================================
+static const size_t NVS_ENTRY_DATA_BYTES = 32;
+static const size_t NVS_LOW_SPACE_ENTRIES = 10;
+static const size_t NVS_MAX_TRACKED_NAMESPACES = 12;
+
+class NvsAccounting {
+public:
+    NvsAccounting();
+
+    void reset();
+
+    // Session hooks (StorageManager::beginNamespace / endNamespace)
+    void beginSession(const char* namespace_name);
+    void endSession();
+
+    // Reserve entries for one write. Queries source at most once per session
+    // plus once on shortage.
+    NvsReserveResult reserve(size_t entries, INvsStatsSource& source);
+
+    // Scoped handles (NvsScopedNamespace) write beside the legacy session:
+    // same partition-wide cache, usage attributed by name instead of active_.
+    void beginScopedSession(const char* namespace_name);
+    NvsReserveResult reserveScoped(const char* namespace_name, size_t entries,
+                                   INvsStatsSource& source);
+
+    // Unexpected write failure or erase → next reserve() re-queries.
+    void invalidate();
+
+    static size_t entriesForPrimitive() { return 1; }
+    static size_t entriesForString(size_t length);
+    static size_t entriesForBlob(size_t length);
+
+    // Per-namespace table
+    size_t getNamespaceCount() const { return namespace_count_; }
+    const NvsNamespaceUsage& getNamespace(size_t index) const { return namespaces_[index]; }
+    void setUsedEntries(size_t index, uint32_t used_entries);
+
+    uint32_t getStatQueryCount() const { return stat_queries_; }
+    size_t getCachedFreeEntries() const { return free_entries_; }
+    bool isCacheValid() const { return cache_valid_; }
+
+    // Appends ,"nvs":{"free":..,"stat_q":..,"ns":[{"n":..,"used":..,"e":..},..]}
+    void appendDiagnosticsJson(String& json) const;
+
+private:
+    size_t queryFreeEntries(INvsStatsSource& source);
+    NvsReserveResult reserveFor(NvsNamespaceUsage* usage, size_t entries, INvsStatsSource& source);
+    NvsNamespaceUsage* findOrAddNamespace(const char* namespace_name);
+
+    NvsNamespaceUsage namespaces_[NVS_MAX_TRACKED_NAMESPACES];
+    size_t namespace_count_;
+    NvsNamespaceUsage* active_;
+
+    size_t free_entries_;   // Last known free entries (decremented per write)
+    bool cache_valid_;
+    bool low_space_reported_;
+    uint32_t stat_queries_;
+};
+
+#endif
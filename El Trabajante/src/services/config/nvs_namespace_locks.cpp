@@ -0,0 +1,131 @@
+#include "nvs_namespace_locks.h"
+
+#include <string.h>
+
+#ifdef NATIVE_TEST
+    #include <chrono>
+#endif
+
+// ============================================
+// LOCK TABLE
+// ============================================
+NvsNamespaceLocks::NvsNamespaceLocks()
+    : wait_count_(0)
+    , timeout_count_(0) {
+#ifndef NATIVE_TEST
+    table_mux_ = portMUX_INITIALIZER_UNLOCKED;
+#endif
+    for (size_t i = 0; i < NVS_NAMESPACE_LOCK_SLOTS; i++) {
+        slots_[i].name[0] = '\0';
+        slots_[i].used = false;
+#ifdef NATIVE_TEST
+        slots_[i].depth = 0;
+#else
+        slots_[i].mutex = xSemaphoreCreateRecursiveMutexStatic(&slots_[i].mutex_storage);
+#endif
+    }
+}
+
+NvsNamespaceLocks::Slot* NvsNamespaceLocks::findSlot(const char* namespace_name, bool claim) {
+    if (namespace_name == nullptr || namespace_name[0] == '\0') {
+        return nullptr;
+    }
+    Slot* found = nullptr;
+#ifdef NATIVE_TEST
+    std::lock_guard<std::mutex> guard(table_mutex_);
+#else
+    portENTER_CRITICAL(&table_mux_);
+#endif
+    for (size_t i = 0; i < NVS_NAMESPACE_LOCK_SLOTS && found == nullptr; i++) {
+        if (slots_[i].used && strncmp(slots_[i].name, namespace_name, sizeof(slots_[i].name)) == 0) {
+            found = &slots_[i];
+        }
+    }
+    // Slots are never released: the set of namespaces is small and fixed
+    for (size_t i = 0; claim && found == nullptr && i < NVS_NAMESPACE_LOCK_SLOTS; i++) {
+        if (!slots_[i].used) {
+            strncpy(slots_[i].name, namespace_name, sizeof(slots_[i].name) - 1);
+            slots_[i].name[sizeof(slots_[i].name) - 1] = '\0';
+            slots_[i].used = true;
+            found = &slots_[i];
+        }
+    }
+#ifndef NATIVE_TEST
+    portEXIT_CRITICAL(&table_mux_);
+#endif
+    return found;
+}
+
+bool NvsNamespaceLocks::acquire(const char* namespace_name, uint32_t timeout_ms) {
+    Slot* slot = findSlot(namespace_name, true);
+    if (slot == nullptr) {
+        timeout_count_++;
+        return false;
+    }
+#ifdef NATIVE_TEST
+    std::unique_lock<std::mutex> lock(table_mutex_);
+    std::thread::id self = std::this_thread::get_id();
+    if (slot->depth > 0 && slot->owner != self) {
+        wait_count_++;
+        if (!slot->released.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                     [slot] { return slot->depth == 0; })) {
+            timeout_count_++;
+            return false;
+        }
+    }
+    slot->owner = self;
+    slot->depth++;
+    return true;
+#else
+    if (slot->mutex == nullptr) {
+        return false;
+    }
+    if (xSemaphoreTakeRecursive(slot->mutex, 0) == pdTRUE) {
+        return true;
+    }
+    wait_count_++;
+    if (xSemaphoreTakeRecursive(slot->mutex, pdMS_TO_TICKS(timeout_ms)) == pdTRUE) {
+        return true;
+    }
+    timeout_count_++;
+    return false;
+#endif
+}
+
+void NvsNamespaceLocks::release(const char* namespace_name) {
+    Slot* slot = findSlot(namespace_name, false);
+    if (slot == nullptr) {
+        return;
+    }
+#ifdef NATIVE_TEST
+    std::lock_guard<std::mutex> lock(table_mutex_);
+    if (slot->depth > 0 && --slot->depth == 0) {
+        slot->released.notify_one();
+    }
+#else
+    if (slot->mutex != nullptr) {
+        xSemaphoreGiveRecursive(slot->mutex);
+    }
+#endif
+}
+
+// ============================================
+// LEASE
+// ============================================
+NvsNamespaceLease::NvsNamespaceLease(NvsNamespaceLocks& locks, const char* namespace_name,
+                                     uint32_t timeout_ms)
+    : locks_(locks)
+    , held_(false) {
+    name_[0] = '\0';
+    if (namespace_name != nullptr) {
+        strncpy(name_, namespace_name, sizeof(name_) - 1);
+        name_[sizeof(name_) - 1] = '\0';
+    }
+    held_ = locks_.acquire(name_, timeout_ms);
+}
+
+NvsNamespaceLease::~NvsNamespaceLease() {
+    if (held_) {
+        locks_.release(name_);
+    }
+}
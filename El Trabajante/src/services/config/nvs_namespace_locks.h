@@ -0,0 +1,94 @@
+#ifndef SERVICES_CONFIG_NVS_NAMESPACE_LOCKS_H
+#define SERVICES_CONFIG_NVS_NAMESPACE_LOCKS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#ifdef NATIVE_TEST
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+#else
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/semphr.h>
+#endif
+
+// ============================================
+// NVS NAMESPACE LOCKS (one lock per namespace)
+// ============================================
+// Replaces the "one global session" model for callers that use scoped
+// handles (NvsScopedNamespace): writers on different namespaces run
+// concurrently, writers on the same namespace serialize. Flash-level
+// serialization is done by ESP-IDF's NVS layer itself (internal lock around
+// every nvs_set/nvs_commit), so no global lock is needed on top.
+//
+// Locks are recursive per task: a task holding "offline" via the legacy
+// StorageManager session may open a scoped handle on "offline" as well.
+//
+// Target: statically allocated recursive FreeRTOS mutexes (no heap).
+// NATIVE_TEST: owner/depth shim on std::mutex + condition_variable with
+// identical semantics (recursive, timed).
+// ============================================
+static const size_t NVS_NAMESPACE_LOCK_SLOTS = 16;
+static const uint32_t NVS_NAMESPACE_LOCK_TIMEOUT_MS = 250;
+
+class NvsNamespaceLocks {
+public:
+    NvsNamespaceLocks();
+    NvsNamespaceLocks(const NvsNamespaceLocks&) = delete;
+    NvsNamespaceLocks& operator=(const NvsNamespaceLocks&) = delete;
+
+    // false on timeout or when all slots are taken by other namespaces.
+    bool acquire(const char* namespace_name, uint32_t timeout_ms);
+    void release(const char* namespace_name);
+
+    uint32_t getWaitCount() const { return wait_count_.load(); }        // Had to block
+    uint32_t getTimeoutCount() const { return timeout_count_.load(); }  // Gave up
+
+private:
+    struct Slot {
+        char name[16];
+        bool used;
+#ifdef NATIVE_TEST
+        std::thread::id owner;
+        uint32_t depth;
+        std::condition_variable released;
+#else
+        SemaphoreHandle_t mutex;
+        StaticSemaphore_t mutex_storage;
+#endif
+    };
+
+    Slot* findSlot(const char* namespace_name, bool claim);
+
+    Slot slots_[NVS_NAMESPACE_LOCK_SLOTS];
+#ifdef NATIVE_TEST
+    std::mutex table_mutex_;
+#else
+    portMUX_TYPE table_mux_;
+#endif
+    std::atomic<uint32_t> wait_count_;
+    std::atomic<uint32_t> timeout_count_;
+};
+
+// ============================================
+// NVS NAMESPACE LEASE (RAII)
+// ============================================
+class NvsNamespaceLease {
+public:
+    NvsNamespaceLease(NvsNamespaceLocks& locks, const char* namespace_name,
+                      uint32_t timeout_ms = NVS_NAMESPACE_LOCK_TIMEOUT_MS);
+    ~NvsNamespaceLease();
+    NvsNamespaceLease(const NvsNamespaceLease&) = delete;
+    NvsNamespaceLease& operator=(const NvsNamespaceLease&) = delete;
+
+    bool held() const { return held_; }
+
+private:
+    NvsNamespaceLocks& locks_;
+    char name_[16];
+    bool held_;
+};
+
+#endif
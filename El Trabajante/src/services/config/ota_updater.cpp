@@ -0,0 +1,644 @@
+#include "ota_updater.h"
+
+#include <string.h>
+
+#include <memory>
+#include <new>
+
+// Scratch size for base reads (COPY/ADD) and tail checks — stack, Comm/MQTT task
+static const size_t OTA_IO_BLOCK = 256;
+
+static uint32_t readLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+static uint8_t patchHeaderLength(uint8_t op) {
+    switch (op) {
+        case OTA_PATCH_COPY:
+        case OTA_PATCH_ADD:
+            return 9;
+        case OTA_PATCH_INSERT:
+            return 5;
+        default:
+            return 0;
+    }
+}
+
+OtaUpdater::OtaUpdater(IOtaPartitionHal& hal)
+    : hal_(hal),
+      active_(false),
+      stream_offset_(0),
+      image_offset_(0),
+      image_crc_(0),
+      erased_until_(0) {
+    memset(&manifest_, 0, sizeof(manifest_));
+    memset(&patch_, 0, sizeof(patch_));
+}
+
+// ============================================
+// SESSION
+// ============================================
+OtaResult OtaUpdater::validateManifest(const OtaManifest& manifest) {
+    if (manifest.chunk_size == 0 || manifest.chunk_size > OTA_MAX_CHUNK_SIZE ||
+        manifest.image_size == 0 || manifest.image_size > hal_.targetSize() ||
+        manifest.stream_size == 0) {
+        return OtaResult::BAD_MANIFEST;
+    }
+    // An all-zero digest is what a manifest without image_sha256 parses to
+    uint8_t any = 0;
+    for (size_t i = 0; i < OTA_SHA256_SIZE; i++) {
+        any |= manifest.image_sha256[i];
+    }
+    if (any == 0) {
+        return OtaResult::BAD_MANIFEST;
+    }
+    if (manifest.type == OtaImageType::FULL) {
+        return manifest.stream_size == manifest.image_size ? OtaResult::OK : OtaResult::BAD_MANIFEST;
+    }
+    if (manifest.type != OtaImageType::DELTA ||
+        manifest.base_size == 0 || manifest.base_size > hal_.runningSize()) {
+        return OtaResult::BAD_MANIFEST;
+    }
+    return OtaResult::OK;
+}
+
+// The running slot must be exactly the image the patch was built against
+OtaResult OtaUpdater::verifyBase() {
+    uint8_t block[OTA_IO_BLOCK];
+    uint32_t crc = 0;
+    for (uint32_t offset = 0; offset < manifest_.base_size; offset += OTA_IO_BLOCK) {
+        uint32_t n = manifest_.base_size - offset;
+        if (n > OTA_IO_BLOCK) {
+            n = OTA_IO_BLOCK;
+        }
+        if (!hal_.readRunning(offset, block, n)) {
+            return OtaResult::FLASH_ERROR;
+        }
+        crc = crc32(crc, block, n);
+    }
+    return crc == manifest_.base_crc32 ? OtaResult::OK : OtaResult::BASE_MISMATCH;
+}
+
+OtaResult OtaUpdater::begin(const OtaManifest& manifest) {
+    active_ = false;
+    OtaResult result = validateManifest(manifest);
+    if (result != OtaResult::OK) {
+        return result;
+    }
+    manifest_ = manifest;
+    if (manifest_.type == OtaImageType::DELTA && (result = verifyBase()) != OtaResult::OK) {
+        return result;
+    }
+    memset(&patch_, 0, sizeof(patch_));
+    stream_offset_ = 0;
+    image_offset_ = 0;
+    image_crc_ = 0;
+    erased_until_ = 0;
+    active_ = true;
+    return OtaResult::OK;
+}
+
+OtaResult OtaUpdater::resume(const OtaCheckpoint& checkpoint) {
+    active_ = false;
+    if (checkpoint.magic != OTA_CHECKPOINT_MAGIC) {
+        return OtaResult::BAD_MANIFEST;
+    }
+    OtaResult result = validateManifest(checkpoint.manifest);
+    if (result != OtaResult::OK) {
+        return result;
+    }
+    // The whole stream may be taken with the final COPY still running
+    bool copy_pending = checkpoint.patch.op == OTA_PATCH_COPY && checkpoint.patch.remaining > 0;
+    if (checkpoint.stream_offset > checkpoint.manifest.stream_size ||
+        (checkpoint.stream_offset == checkpoint.manifest.stream_size && !copy_pending) ||
+        checkpoint.image_offset > checkpoint.manifest.image_size ||
+        checkpoint.patch.header_len >= sizeof(checkpoint.patch.header)) {
+        return OtaResult::BAD_MANIFEST;
+    }
+    manifest_ = checkpoint.manifest;
+    // A different firmware may have booted in between
+    if (manifest_.type == OtaImageType::DELTA && (result = verifyBase()) != OtaResult::OK) {
+        return result;
+    }
+    patch_ = checkpoint.patch;
+    stream_offset_ = checkpoint.stream_offset;
+    image_offset_ = checkpoint.image_offset;
+    image_crc_ = checkpoint.image_crc;
+    if (!repairTailSector()) {
+        return OtaResult::FLASH_ERROR;
+    }
+    active_ = true;
+    return OtaResult::OK;
+}
+
+void OtaUpdater::abort() {
+    active_ = false;
+}
+
+OtaResult OtaUpdater::fail(OtaResult result) {
+    active_ = false;
+    return result;
+}
+
+OtaCheckpoint OtaUpdater::getCheckpoint() const {
+    OtaCheckpoint checkpoint;
+    memset(&checkpoint, 0, sizeof(checkpoint));
+    checkpoint.magic = OTA_CHECKPOINT_MAGIC;
+    checkpoint.manifest = manifest_;
+    checkpoint.stream_offset = stream_offset_;
+    checkpoint.image_offset = image_offset_;
+    checkpoint.image_crc = image_crc_;
+    checkpoint.patch = patch_;
+    return checkpoint;
+}
+
+// ============================================
+// FLASH
+// ============================================
+// Bytes after the checkpoint may already have been written before the
+// interruption. Flash writes can only clear bits, so a dirty tail in the
+// current sector is erased and the checkpointed prefix written back.
+bool OtaUpdater::repairTailSector() {
+    uint32_t sector_start = image_offset_ - image_offset_ % OTA_FLASH_SECTOR_SIZE;
+    if (sector_start == image_offset_) {
+        erased_until_ = image_offset_;          // Sector is erased on its first write
+        return true;
+    }
+    erased_until_ = sector_start + OTA_FLASH_SECTOR_SIZE;
+
+    uint32_t tail_end = erased_until_;
+    if (tail_end > hal_.targetSize()) {
+        tail_end = static_cast<uint32_t>(hal_.targetSize());
+    }
+    uint8_t block[OTA_IO_BLOCK];
+    bool dirty = false;
+    for (uint32_t offset = image_offset_; offset < tail_end && !dirty; offset += OTA_IO_BLOCK) {
+        uint32_t n = tail_end - offset;
+        if (n > OTA_IO_BLOCK) {
+            n = OTA_IO_BLOCK;
+        }
+        if (!hal_.readTarget(offset, block, n)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            if (block[i] != 0xFF) {
+                dirty = true;
+                break;
+            }
+        }
+    }
+    if (!dirty) {
+        return true;
+    }
+
+    size_t prefix_len = image_offset_ - sector_start;
+    std::unique_ptr<uint8_t[]> prefix(new (std::nothrow) uint8_t[prefix_len]);
+    return prefix &&
+           hal_.readTarget(sector_start, prefix.get(), prefix_len) &&
+           hal_.eraseTarget(sector_start, OTA_FLASH_SECTOR_SIZE) &&
+           hal_.writeTarget(sector_start, prefix.get(), prefix_len);
+}
+
+bool OtaUpdater::ensureErased(uint32_t end) {
+    while (erased_until_ < end) {
+        if (!hal_.eraseTarget(erased_until_, OTA_FLASH_SECTOR_SIZE)) {
+            return false;
+        }
+        erased_until_ += OTA_FLASH_SECTOR_SIZE;
+    }
+    return true;
+}
+
+OtaResult OtaUpdater::emit(const uint8_t* data, size_t length) {
+    if (length > manifest_.image_size - image_offset_) {
+        return OtaResult::PATCH_INVALID;
+    }
+    if (!ensureErased(image_offset_ + static_cast<uint32_t>(length)) ||
+        !hal_.writeTarget(image_offset_, data, length)) {
+        return OtaResult::FLASH_ERROR;
+    }
+    image_crc_ = crc32(image_crc_, data, length);
+    image_offset_ += static_cast<uint32_t>(length);
+    return OtaResult::OK;
+}
+
+// COPY (diff == nullptr) or ADD from the running slot
+OtaResult OtaUpdater::emitFromBase(uint32_t src_offset, const uint8_t* diff, uint32_t length) {
+    uint8_t block[OTA_IO_BLOCK];
+    while (length > 0) {
+        uint32_t n = length > OTA_IO_BLOCK ? OTA_IO_BLOCK : length;
+        if (!hal_.readRunning(src_offset, block, n)) {
+            return OtaResult::FLASH_ERROR;
+        }
+        if (diff != nullptr) {
+            for (uint32_t i = 0; i < n; i++) {
+                block[i] = static_cast<uint8_t>(block[i] + diff[i]);
+            }
+            diff += n;
+        }
+        OtaResult result = emit(block, n);
+        if (result != OtaResult::OK) {
+            return result;
+        }
+        src_offset += n;
+        length -= n;
+    }
+    return OtaResult::OK;
+}
+
+// ============================================
+// DELTA DECODER
+// ============================================
+OtaResult OtaUpdater::stepCopy(uint32_t& budget) {
+    uint32_t n = patch_.remaining < budget ? patch_.remaining : budget;
+    OtaResult result = emitFromBase(patch_.src_offset, nullptr, n);
+    if (result != OtaResult::OK) {
+        return result;
+    }
+    patch_.src_offset += n;
+    patch_.remaining -= n;
+    budget -= n;
+    return OtaResult::OK;
+}
+
+// Stops early once the COPY budget is spent; consumed = input bytes taken
+OtaResult OtaUpdater::feedPatch(const uint8_t* data, size_t length, size_t& consumed) {
+    uint32_t budget = OTA_COPY_STEP_BYTES;
+    size_t pos = 0;
+    for (;;) {
+        if (patch_.op == OTA_PATCH_COPY && patch_.remaining > 0) {
+            if (budget == 0) {
+                break;
+            }
+            OtaResult result = stepCopy(budget);
+            if (result != OtaResult::OK) {
+                return result;
+            }
+            continue;
+        }
+        if (pos >= length) {
+            break;
+        }
+        if (patch_.remaining == 0) {
+            patch_.header[patch_.header_len++] = data[pos++];
+            uint8_t needed = patchHeaderLength(patch_.header[0]);
+            if (needed == 0) {
+                return OtaResult::PATCH_INVALID;
+            }
+            if (patch_.header_len < needed) {
+                continue;
+            }
+            patch_.header_len = 0;
+            patch_.op = patch_.header[0];
+            uint32_t op_length;
+            if (patch_.op == OTA_PATCH_INSERT) {
+                patch_.src_offset = 0;
+                op_length = readLe32(&patch_.header[1]);
+            } else {
+                patch_.src_offset = readLe32(&patch_.header[1]);
+                op_length = readLe32(&patch_.header[5]);
+                if (patch_.src_offset > manifest_.base_size ||
+                    op_length > manifest_.base_size - patch_.src_offset) {
+                    return OtaResult::PATCH_INVALID;
+                }
+            }
+            if (op_length == 0 || op_length > manifest_.image_size - image_offset_) {
+                return OtaResult::PATCH_INVALID;
+            }
+            patch_.remaining = op_length;
+            continue;
+        }
+
+        uint32_t n = patch_.remaining;
+        if (n > length - pos) {
+            n = static_cast<uint32_t>(length - pos);
+        }
+        OtaResult result = patch_.op == OTA_PATCH_ADD
+                               ? emitFromBase(patch_.src_offset, data + pos, n)
+                               : emit(data + pos, n);
+        if (result != OtaResult::OK) {
+            return result;
+        }
+        patch_.src_offset += n;
+        patch_.remaining -= n;
+        pos += n;
+    }
+    consumed = pos;
+    return OtaResult::OK;
+}
+
+// ============================================
+// CHUNKS
+// ============================================
+OtaResult OtaUpdater::applyChunk(uint32_t offset, const uint8_t* data, size_t length, uint32_t chunk_crc) {
+    if (!active_) {
+        return OtaResult::NOT_ACTIVE;
+    }
+    if (length > 0 && offset < stream_offset_ && length <= stream_offset_ - offset) {
+        return OtaResult::DUPLICATE;
+    }
+    if (offset != stream_offset_) {
+        return OtaResult::OUT_OF_ORDER;
+    }
+    if (data == nullptr || length == 0 || length > manifest_.chunk_size ||
+        length > manifest_.stream_size - stream_offset_) {
+        return OtaResult::BAD_CHUNK;
+    }
+    if (crc32(0, data, length) != chunk_crc) {
+        return OtaResult::CHUNK_CRC;
+    }
+
+    size_t consumed = length;
+    OtaResult result = manifest_.type == OtaImageType::DELTA ? feedPatch(data, length, consumed)
+                                                               : emit(data, length);
+    if (result != OtaResult::OK) {
+        return fail(result);
+    }
+    if (consumed == 0) {
+        return OtaResult::BUSY;
+    }
+    stream_offset_ += static_cast<uint32_t>(consumed);
+    return stream_offset_ == manifest_.stream_size && !hasPendingCopy() ? finish() : OtaResult::OK;
+}
+
+OtaResult OtaUpdater::continuePatch() {
+    if (!active_) {
+        return OtaResult::NOT_ACTIVE;
+    }
+    if (!hasPendingCopy()) {
+        return OtaResult::OK;
+    }
+    uint32_t budget = OTA_COPY_STEP_BYTES;
+    OtaResult result = stepCopy(budget);
+    if (result != OtaResult::OK) {
+        return fail(result);
+    }
+    return stream_offset_ == manifest_.stream_size && !hasPendingCopy() ? finish() : OtaResult::OK;
+}
+
+// Hashes what actually landed in flash, not the stream: also catches writes
+// the flash did not take
+OtaResult OtaUpdater::verifyImageDigest() {
+    uint8_t block[OTA_IO_BLOCK];
+    OtaSha256 sha;
+    for (uint32_t offset = 0; offset < manifest_.image_size; offset += OTA_IO_BLOCK) {
+        uint32_t n = manifest_.image_size - offset;
+        if (n > OTA_IO_BLOCK) {
+            n = OTA_IO_BLOCK;
+        }
+        if (!hal_.readTarget(offset, block, n)) {
+            return OtaResult::FLASH_ERROR;
+        }
+        sha.update(block, n);
+    }
+    uint8_t digest[OTA_SHA256_SIZE];
+    sha.finish(digest);
+    return memcmp(digest, manifest_.image_sha256, OTA_SHA256_SIZE) == 0 ? OtaResult::OK
+                                                                       : OtaResult::IMAGE_DIGEST;
+}
+
+OtaResult OtaUpdater::finish() {
+    if (image_offset_ != manifest_.image_size || patch_.remaining != 0 || patch_.header_len != 0) {
+        return fail(OtaResult::PATCH_INVALID);
+    }
+    if (image_crc_ != manifest_.image_crc32) {
+        return fail(OtaResult::IMAGE_CRC);
+    }
+    OtaResult result = verifyImageDigest();
+    if (result != OtaResult::OK) {
+        return fail(result);
+    }
+    if (!hal_.activateTarget()) {
+        return fail(OtaResult::ACTIVATE_FAILED);
+    }
+    active_ = false;
+    return OtaResult::COMPLETE;
+}
+
+// ============================================
+// HELPERS
+// ============================================
+uint32_t OtaUpdater::crc32(uint32_t crc, const uint8_t* data, size_t length) {
+    // Nibble table: 64 bytes instead of 1 KB, ~2x slower than the byte table
+    static const uint32_t kTable[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ kTable[crc & 0x0F];
+        crc = (crc >> 4) ^ kTable[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static int8_t base64Value(char c) {
+    if (c >= 'A' && c <= 'Z') return static_cast<int8_t>(c - 'A');
+    if (c >= 'a' && c <= 'z') return static_cast<int8_t>(c - 'a' + 26);
+    if (c >= '0' && c <= '9') return static_cast<int8_t>(c - '0' + 52);
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+size_t OtaUpdater::decodeBase64(const char* in, size_t in_length, uint8_t* out, size_t capacity) {
+    if (in == nullptr || out == nullptr || in_length == 0 || in_length % 4 != 0) {
+        return 0;
+    }
+    // Padding only in the last quantum: "xx==" or "xxx="
+    size_t padding = in[in_length - 1] == '=' ? (in[in_length - 2] == '=' ? 2 : 1) : 0;
+    size_t out_len = 0;
+    for (size_t i = 0; i < in_length; i += 4) {
+        bool last = i + 4 == in_length;
+        uint32_t quantum = 0;
+        for (size_t j = 0; j < 4; j++) {
+            int8_t v = (last && j >= 4 - padding) ? 0 : base64Value(in[i + j]);
+            if (v < 0) {
+                return 0;
+            }
+            quantum = quantum << 6 | static_cast<uint32_t>(v);
+        }
+        size_t bytes = last ? 3 - padding : 3;
+        if (out_len + bytes > capacity) {
+            return 0;
+        }
+        out[out_len++] = static_cast<uint8_t>(quantum >> 16);
+        if (bytes > 1) out[out_len++] = static_cast<uint8_t>(quantum >> 8);
+        if (bytes > 2) out[out_len++] = static_cast<uint8_t>(quantum);
+    }
+    return out_len;
+}
+
+static int8_t hexValue(char c) {
+    if (c >= '0' && c <= '9') return static_cast<int8_t>(c - '0');
+    if (c >= 'a' && c <= 'f') return static_cast<int8_t>(c - 'a' + 10);
+    if (c >= 'A' && c <= 'F') return static_cast<int8_t>(c - 'A' + 10);
+    return -1;
+}
+
+bool OtaUpdater::decodeHex(const char* in, uint8_t* out, size_t length) {
+    if (in == nullptr || out == nullptr || strlen(in) != 2 * length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        int8_t hi = hexValue(in[2 * i]);
+        int8_t lo = hexValue(in[2 * i + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        out[i] = static_cast<uint8_t>(hi << 4 | lo);
+    }
+    return true;
+}
+
+const char* OtaUpdater::resultToString(OtaResult result) {
+    switch (result) {
+        case OtaResult::OK: return "OK";
+        case OtaResult::COMPLETE: return "COMPLETE";
+        case OtaResult::DUPLICATE: return "DUPLICATE";
+        case OtaResult::BUSY: return "BUSY";
+        case OtaResult::OUT_OF_ORDER: return "OUT_OF_ORDER";
+        case OtaResult::BAD_CHUNK: return "BAD_CHUNK";
+        case OtaResult::CHUNK_CRC: return "CHUNK_CRC";
+        case OtaResult::BAD_MANIFEST: return "BAD_MANIFEST";
+        case OtaResult::BASE_MISMATCH: return "BASE_MISMATCH";
+        case OtaResult::PATCH_INVALID: return "PATCH_INVALID";
+        case OtaResult::IMAGE_CRC: return "IMAGE_CRC";
+        case OtaResult::IMAGE_DIGEST: return "IMAGE_DIGEST";
+        case OtaResult::FLASH_ERROR: return "FLASH_ERROR";
+        case OtaResult::ACTIVATE_FAILED: return "ACTIVATE_FAILED";
+        case OtaResult::NOT_ACTIVE: return "NOT_ACTIVE";
+        default: return "UNKNOWN";
+    }
+}
+
+// ============================================
+// SHA-256
+// ============================================
+#ifndef NATIVE_TEST
+// mbedtls: ESP-IDF routes it to the SHA hardware accelerator
+OtaSha256::OtaSha256() {
+    mbedtls_sha256_init(&ctx_);
+#if MBEDTLS_VERSION_MAJOR >= 3
+    mbedtls_sha256_starts(&ctx_, 0);
+#else
+    mbedtls_sha256_starts_ret(&ctx_, 0);
+#endif
+}
+
+OtaSha256::~OtaSha256() {
+    mbedtls_sha256_free(&ctx_);
+}
+
+void OtaSha256::update(const uint8_t* data, size_t length) {
+#if MBEDTLS_VERSION_MAJOR >= 3
+    mbedtls_sha256_update(&ctx_, data, length);
+#else
+    mbedtls_sha256_update_ret(&ctx_, data, length);
+#endif
+}
+
+void OtaSha256::finish(uint8_t digest[OTA_SHA256_SIZE]) {
+#if MBEDTLS_VERSION_MAJOR >= 3
+    mbedtls_sha256_finish(&ctx_, digest);
+#else
+    mbedtls_sha256_finish_ret(&ctx_, digest);
+#endif
+}
+#else
+// NATIVE_TEST shim: FIPS 180-4 reference implementation (no mbedtls on the host)
+static const uint32_t kSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline uint32_t rotr32(uint32_t x, uint8_t n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+OtaSha256::OtaSha256() : total_(0), block_len_(0) {
+    static const uint32_t kInit[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    memcpy(state_, kInit, sizeof(state_));
+}
+
+void OtaSha256::transform(const uint8_t* block) {
+    uint32_t w[64];
+    for (uint8_t i = 0; i < 16; i++) {
+        w[i] = static_cast<uint32_t>(block[4 * i]) << 24 | static_cast<uint32_t>(block[4 * i + 1]) << 16 |
+               static_cast<uint32_t>(block[4 * i + 2]) << 8 | static_cast<uint32_t>(block[4 * i + 3]);
+    }
+    for (uint8_t i = 16; i < 64; i++) {
+        uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+    uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+    for (uint8_t i = 0; i < 64; i++) {
+        uint32_t t1 = h + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) + ((e & f) ^ (~e & g)) +
+                      kSha256K[i] + w[i];
+        uint32_t t2 = (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+    state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+}
+
+void OtaSha256::update(const uint8_t* data, size_t length) {
+    total_ += length;
+    while (length > 0) {
+        size_t n = sizeof(block_) - block_len_;
+        if (n > length) {
+            n = length;
+        }
+        memcpy(block_ + block_len_, data, n);
+        block_len_ += n;
+        data += n;
+        length -= n;
+        if (block_len_ == sizeof(block_)) {
+            transform(block_);
+            block_len_ = 0;
+        }
+    }
+}
+
+void OtaSha256::finish(uint8_t digest[OTA_SHA256_SIZE]) {
+    uint64_t bits = total_ * 8;
+    block_[block_len_++] = 0x80;
+    if (block_len_ > 56) {
+        memset(block_ + block_len_, 0, sizeof(block_) - block_len_);
+        transform(block_);
+        block_len_ = 0;
+    }
+    memset(block_ + block_len_, 0, 56 - block_len_);
+    for (uint8_t i = 0; i < 8; i++) {
+        block_[63 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+    transform(block_);
+    for (uint8_t i = 0; i < 8; i++) {
+        digest[4 * i] = static_cast<uint8_t>(state_[i] >> 24);
+        digest[4 * i + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        digest[4 * i + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        digest[4 * i + 3] = static_cast<uint8_t>(state_[i]);
+    }
+}
+
+OtaSha256::~OtaSha256() {}
+#endif
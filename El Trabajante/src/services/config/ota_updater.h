@@ -0,0 +1,192 @@
+#ifndef SERVICES_CONFIG_OTA_UPDATER_H
+#define SERVICES_CONFIG_OTA_UPDATER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../drivers/hal/iota_partition_hal.h"
+
+#ifndef NATIVE_TEST
+#include <mbedtls/sha256.h>
+#include <mbedtls/version.h>
+#endif
+
+// ============================================
+// OTA UPDATER (streaming, resumable, full or delta images)
+// ============================================
+// Writes a firmware image chunk by chunk into the inactive app slot. The
+// transport (LibraryManager: MQTT chunk topic) only delivers (offset, data,
+// crc32); everything else is pure logic against IOtaPartitionHal:
+//
+//   - Per-chunk CRC32, strictly in-order offsets. A resent chunk that was
+//     already applied is acknowledged as DUPLICATE (lost ack), not rewritten.
+//   - Sectors are erased lazily right before the first write into them.
+//   - getCheckpoint() after any chunk is everything needed to continue after
+//     a reboot or link loss; resume() re-erases a partially written sector
+//     tail so bytes written after the last checkpoint do not corrupt flash.
+//     Callers only need to persist it once per written sector.
+//   - DELTA: the stream is a bsdiff-style patch against the running slot,
+//     decoded on the fly (ops may span chunk boundaries):
+//       0x01 COPY   u32 src, u32 len              out = base[src..]
+//       0x02 ADD    u32 src, u32 len, len bytes   out = base[src..] + diff
+//       0x03 INSERT u32 len, len bytes            out = literal bytes
+//     (little endian). The base is verified by CRC32 before anything is written.
+//     A COPY may cover the whole base (~1.5 MB): it is emitted in steps of
+//     OTA_COPY_STEP_BYTES per applyChunk()/continuePatch() call. A chunk that
+//     arrives while a COPY is still running is consumed only up to that
+//     point (next offset in the ack) or refused as BUSY.
+//   - Completion: resulting size and CRC32 must match the manifest, the slot
+//     is read back and its SHA-256 compared with the manifest, then it is
+//     activated (bootloader image check happens there).
+//
+// Trust: the manifest is not signed. Whoever may publish on the node's
+// system/command and system/ota/chunk topics (broker ACL) can install
+// firmware; CRC32 and SHA-256 only protect against corrupted transfers and
+// flash writes.
+// ============================================
+
+static const size_t OTA_FLASH_SECTOR_SIZE = 4096;
+static const size_t OTA_MAX_CHUNK_SIZE = 4096;          // Fits the 8 KB MQTT reassembly buffer as base64
+static const uint32_t OTA_CHECKPOINT_MAGIC = 0x3241544F; // "OTA2" (manifest with SHA-256)
+static const size_t OTA_SHA256_SIZE = 32;
+static const uint32_t OTA_COPY_STEP_BYTES = 1024;        // Delta COPY output per call (4 I/O blocks)
+
+static const uint8_t OTA_PATCH_COPY = 0x01;
+static const uint8_t OTA_PATCH_ADD = 0x02;
+static const uint8_t OTA_PATCH_INSERT = 0x03;
+
+enum class OtaImageType : uint8_t {
+    FULL = 0,
+    DELTA = 1
+};
+
+enum class OtaResult : uint8_t {
+    OK = 0,
+    COMPLETE,           // Last chunk applied, image verified and activated
+    DUPLICATE,          // Chunk already applied — ack again, nothing written
+    BUSY,               // COPY still running — nothing consumed, resend from next offset
+    OUT_OF_ORDER,       // Offset != next expected offset
+    BAD_CHUNK,          // Empty, larger than chunk_size or beyond the stream
+    CHUNK_CRC,          // Chunk payload CRC32 mismatch
+    BAD_MANIFEST,
+    BASE_MISMATCH,      // Running slot is not the delta base
+    PATCH_INVALID,
+    IMAGE_CRC,          // Resulting image CRC32 mismatch
+    IMAGE_DIGEST,       // SHA-256 of the written slot differs from the manifest
+    FLASH_ERROR,
+    ACTIVATE_FAILED,
+    NOT_ACTIVE
+};
+
+struct OtaManifest {
+    uint32_t image_id;                  // Server build id — resume only within the same id
+    uint32_t stream_size;               // Bytes transferred (image or patch)
+    uint32_t image_size;                // Resulting firmware size
+    uint32_t image_crc32;
+    uint8_t image_sha256[OTA_SHA256_SIZE];  // Required; checked on the read-back slot
+    uint32_t base_size;                 // DELTA: running image bytes the patch refers to
+    uint32_t base_crc32;
+    uint16_t chunk_size;
+    OtaImageType type;
+};
+
+// Delta decoder state between chunks
+struct OtaPatchState {
+    uint8_t header[9];
+    uint8_t header_len;
+    uint8_t op;
+    uint32_t src_offset;
+    uint32_t remaining;                 // ADD/INSERT payload still to come, COPY bytes still to emit; 0 = reading header
+};
+
+// Persisted per written sector and on idle timeout (NVS blob "ota/ckpt")
+struct OtaCheckpoint {
+    uint32_t magic;
+    OtaManifest manifest;
+    uint32_t stream_offset;
+    uint32_t image_offset;
+    uint32_t image_crc;
+    OtaPatchState patch;
+};
+
+// Streaming SHA-256: mbedtls (hardware SHA engine) on target, a portable
+// FIPS 180-4 implementation for NATIVE_TEST only
+class OtaSha256 {
+public:
+    OtaSha256();
+    ~OtaSha256();
+    OtaSha256(const OtaSha256&) = delete;
+    OtaSha256& operator=(const OtaSha256&) = delete;
+
+    void update(const uint8_t* data, size_t length);
+    void finish(uint8_t digest[OTA_SHA256_SIZE]);
+
+private:
+#ifndef NATIVE_TEST
+    mbedtls_sha256_context ctx_;
+#else
+    uint32_t state_[8];
+    uint64_t total_;
+    uint8_t block_[64];
+    size_t block_len_;
+
+    void transform(const uint8_t* block);
+#endif
+};
+
+class OtaUpdater {
+public:
+    explicit OtaUpdater(IOtaPartitionHal& hal);
+
+    // New session: validates the manifest (and the delta base)
+    OtaResult begin(const OtaManifest& manifest);
+    // Continue a session from a checkpoint (same slot contents as when it was taken)
+    OtaResult resume(const OtaCheckpoint& checkpoint);
+    void abort();
+
+    // Applies one chunk (possibly only a prefix, see getNextOffset()). Any
+    // error other than DUPLICATE / BUSY / OUT_OF_ORDER / BAD_CHUNK / CHUNK_CRC
+    // ends the session.
+    OtaResult applyChunk(uint32_t offset, const uint8_t* data, size_t length, uint32_t chunk_crc);
+    // Next step of a running COPY without a chunk; COMPLETE once the stream is done
+    OtaResult continuePatch();
+    bool hasPendingCopy() const { return active_ && patch_.op == OTA_PATCH_COPY && patch_.remaining > 0; }
+
+    bool isActive() const { return active_; }
+    uint32_t getNextOffset() const { return stream_offset_; }
+    uint32_t getImageOffset() const { return image_offset_; }
+    const OtaManifest& getManifest() const { return manifest_; }
+    OtaCheckpoint getCheckpoint() const;
+
+    // zlib-compatible, chainable: crc32(crc32(0, a), b) == crc32(0, a+b)
+    static uint32_t crc32(uint32_t crc, const uint8_t* data, size_t length);
+    // Standard alphabet with padding; returns decoded length, 0 on invalid input
+    static size_t decodeBase64(const char* in, size_t in_length, uint8_t* out, size_t capacity);
+    // Exactly 2 * length hex digits (either case); false on anything else
+    static bool decodeHex(const char* in, uint8_t* out, size_t length);
+    static const char* resultToString(OtaResult result);
+
+private:
+    IOtaPartitionHal& hal_;
+    OtaManifest manifest_;
+    OtaPatchState patch_;
+    bool active_;
+    uint32_t stream_offset_;
+    uint32_t image_offset_;
+    uint32_t image_crc_;
+    uint32_t erased_until_;             // Target bytes [0, erased_until_) are erased or written
+
+    OtaResult validateManifest(const OtaManifest& manifest);
+    OtaResult verifyBase();
+    bool repairTailSector();
+    bool ensureErased(uint32_t end);
+    OtaResult emit(const uint8_t* data, size_t length);
+    OtaResult emitFromBase(uint32_t src_offset, const uint8_t* diff, uint32_t length);
+    OtaResult stepCopy(uint32_t& budget);
+    OtaResult feedPatch(const uint8_t* data, size_t length, size_t& consumed);
+    OtaResult verifyImageDigest();
+    OtaResult finish();
+    OtaResult fail(OtaResult result);
+};
+
+#endif
@@ -1,6 +1,8 @@
 #include "storage_manager.h"
 #include "../../utils/logger.h"
+#include "../../error_handling/watchdog_supervisor.h"
 #include <nvs_flash.h>
+#include <nvs.h>
 #include <esp_log.h>
 
 // ESP-IDF TAG convention for structured logging
@@ -34,6 +36,12 @@ class StorageLockGuard {
   bool locked_;
 };
 }  // namespace
+
+// nvs_accounting_ is shared by the legacy session and NvsScopedNamespace
+// writers on other tasks; short lock, never held across a flash write.
+#define NVS_ACCOUNTING_GUARD() StorageLockGuard accounting_guard(accounting_mutex_)
+#else
+#define NVS_ACCOUNTING_GUARD()
 #endif
 
 // ============================================
@@ -57,8 +65,11 @@ StorageManager& StorageManager::getInstance() {
 StorageManager::StorageManager()
   : namespace_open_(false)
   , transaction_active_(false)
+  , wdt_phase_active_(false)
+  , stats_source_(preferences_)
 #ifdef CONFIG_ENABLE_THREAD_SAFETY
   , nvs_mutex_(nullptr)
+  , accounting_mutex_(nullptr)
   , namespace_owner_task_(nullptr)
 #endif
   , namespace_conflict_count_(0)
@@ -80,6 +91,13 @@ bool StorageManager::begin() {
     }
     LOG_I(TAG, "StorageManager: Thread-safety enabled (mutex created)");
   }
+  if (accounting_mutex_ == nullptr) {
+    accounting_mutex_ = xSemaphoreCreateRecursiveMutex();
+    if (accounting_mutex_ == nullptr) {
+      LOG_E(TAG, "StorageManager: Failed to create accounting mutex");
+      return false;
+    }
+  }
 #endif
   namespace_open_ = false;
   transaction_active_ = false;
@@ -89,6 +107,10 @@ bool StorageManager::begin() {
 #endif
   namespace_conflict_count_ = 0;
   no_session_access_count_ = 0;
+  {
+    NVS_ACCOUNTING_GUARD();
+    nvs_accounting_.reset();
+  }
   LOG_I(TAG, "StorageManager: Initialized");
   return true;
 }
@@ -111,6 +133,12 @@ bool StorageManager::beginTransaction() {
 void StorageManager::endTransaction() {
   if (namespace_open_) {
     preferences_.end();
+    {
+      NVS_ACCOUNTING_GUARD();
+      nvs_accounting_.endSession();
+    }
+    endWatchdogPhase();
+    namespace_locks_.release(current_namespace_);
     namespace_open_ = false;
     current_namespace_[0] = '\0';
 #ifdef CONFIG_ENABLE_THREAD_SAFETY
@@ -149,6 +177,20 @@ uint32_t StorageManager::getNoSessionAccessCount() const {
 // ============================================
 // NAMESPACE MANAGEMENT
 // ============================================
+// Write sessions run as watchdog phase: a flash erase/commit stall is
+// attributed to "nvs_commit" after a WDT reset.
+static uint8_t nvsCommitHeartbeat() {
+  static const uint8_t id = watchdogSupervisor.registerHeartbeat("nvs_commit", 1000);
+  return id;
+}
+
+void StorageManager::endWatchdogPhase() {
+  if (wdt_phase_active_) {
+    watchdogSupervisor.endPhase(nvsCommitHeartbeat());
+    wdt_phase_active_ = false;
+  }
+}
+
 bool StorageManager::beginNamespace(const char* namespace_name, bool read_only) {
 #ifdef CONFIG_ENABLE_THREAD_SAFETY
   if (nvs_mutex_ == nullptr) {
@@ -174,6 +216,15 @@ bool StorageManager::beginNamespace(const char* namespace_name, bool read_only)
     return false;
   }
   
+  // Same namespace held by a scoped handle on another task → wait for it
+  if (!namespace_locks_.acquire(namespace_name, NVS_NAMESPACE_LOCK_TIMEOUT_MS)) {
+    LOG_E(TAG, "StorageManager: Namespace lock timeout: " + String(namespace_name));
+#ifdef CONFIG_ENABLE_THREAD_SAFETY
+    xSemaphoreGiveRecursive(nvs_mutex_);
+#endif
+    return false;
+  }
+
   // The Arduino Preferences library calls log_e() internally when nvs_open fails,
   // even for expected NOT_FOUND cases on a new device. Suppress that noise for
   // read-only opens; write failures are real errors and must stay visible.
@@ -190,6 +241,7 @@ bool StorageManager::beginNamespace(const char* namespace_name, bool read_only)
   }
 
   if (!ns_result) {
+    namespace_locks_.release(namespace_name);
     if (read_only) {
       LOG_D(TAG, "StorageManager: Namespace not found (expected for new device): " + String(namespace_name));
     } else {
@@ -202,6 +254,14 @@ bool StorageManager::beginNamespace(const char* namespace_name, bool read_only)
   }
   
   namespace_open_ = true;
+  {
+    NVS_ACCOUNTING_GUARD();
+    nvs_accounting_.beginSession(namespace_name);
+  }
+  wdt_phase_active_ = !read_only;
+  if (wdt_phase_active_) {
+    watchdogSupervisor.beginPhase(nvsCommitHeartbeat());
+  }
   strncpy(current_namespace_, namespace_name, sizeof(current_namespace_) - 1);
   current_namespace_[sizeof(current_namespace_) - 1] = '\0';
 #ifdef CONFIG_ENABLE_THREAD_SAFETY
@@ -231,6 +291,12 @@ void StorageManager::endNamespace() {
     }
 #endif
     preferences_.end();
+    {
+      NVS_ACCOUNTING_GUARD();
+      nvs_accounting_.endSession();
+    }
+    endWatchdogPhase();
+    namespace_locks_.release(current_namespace_);
     namespace_open_ = false;
     LOG_D(TAG, "StorageManager: Closed namespace: " + String(current_namespace_));
     current_namespace_[0] = '\0';
@@ -271,28 +337,84 @@ void StorageManager::recordNoSessionAccess() {
 // ============================================
 // NVS QUOTA CHECK HELPER (Private)
 // ============================================
-bool StorageManager::checkNVSQuota(const char* key) {
-  if (!namespace_open_) {
-    return true;  // Skip check if no namespace open
-  }
-
-  size_t free_entries = preferences_.freeEntries();
-  if (free_entries == 0) {
+static bool reportNvsQuota(NvsReserveResult result, const char* namespace_name, const char* key,
+                           size_t entries, size_t free_entries) {
+  if (result == NvsReserveResult::FULL) {
     LOG_E(TAG, "╔════════════════════════════════════════╗");
     LOG_E(TAG, "║  NVS FULL - CANNOT SAVE DATA!         ║");
     LOG_E(TAG, "╚════════════════════════════════════════╝");
-    LOG_E(TAG, "NVS namespace '" + String(current_namespace_) + "' has 0 free entries");
+    LOG_E(TAG, "NVS namespace '" + String(namespace_name) + "' has " + String(free_entries) +
+                   " free entries, " + String(entries) + " needed");
     LOG_E(TAG, "Cannot write key: " + String(key));
     return false;
-  } else if (free_entries < 10) {
+  } else if (result == NvsReserveResult::LOW_SPACE) {
     LOG_W(TAG, "╔════════════════════════════════════════╗");
     LOG_W(TAG, "║  NVS NEARLY FULL - " + String(free_entries) + " entries left        ║");
     LOG_W(TAG, "╚════════════════════════════════════════╝");
-    LOG_W(TAG, "NVS namespace '" + String(current_namespace_) + "' low on space");
+    LOG_W(TAG, "NVS namespace '" + String(namespace_name) + "' low on space");
   }
   return true;
 }
 
+bool StorageManager::checkNVSQuota(const char* key, size_t entries) {
+  if (!namespace_open_) {
+    return true;  // Skip check if no namespace open
+  }
+
+  // nvs_get_stats() only once per session, then decremented per write
+  NvsReserveResult result;
+  size_t free_entries;
+  {
+    NVS_ACCOUNTING_GUARD();
+    result = nvs_accounting_.reserve(entries, stats_source_);
+    free_entries = nvs_accounting_.getCachedFreeEntries();
+  }
+  return reportNvsQuota(result, current_namespace_, key, entries, free_entries);
+}
+
+void StorageManager::onWriteFailed() {
+  // Cached free count no longer trustworthy (GC, foreign writer) → re-query
+  NVS_ACCOUNTING_GUARD();
+  nvs_accounting_.invalidate();
+}
+
+// ============================================
+// SCOPED HANDLE HOOKS (NvsScopedNamespace)
+// ============================================
+void StorageManager::beginScopedSession(const char* namespace_name, bool read_only) {
+  {
+    NVS_ACCOUNTING_GUARD();
+    nvs_accounting_.beginScopedSession(namespace_name);
+  }
+  if (!read_only) {
+    watchdogSupervisor.beginPhase(nvsCommitHeartbeat());
+  }
+}
+
+void StorageManager::endScopedSession(bool read_only) {
+  if (!read_only) {
+    watchdogSupervisor.endPhase(nvsCommitHeartbeat());
+  }
+}
+
+bool StorageManager::reserveScopedWrite(const char* namespace_name, const char* key,
+                                        size_t entries, Preferences& preferences) {
+  // freeEntries() is partition-wide, so the scoped handle's Preferences serves as source
+  PreferencesStatsSource source(preferences);
+  NvsReserveResult result;
+  size_t free_entries;
+  {
+    NVS_ACCOUNTING_GUARD();
+    result = nvs_accounting_.reserveScoped(namespace_name, entries, source);
+    free_entries = nvs_accounting_.getCachedFreeEntries();
+  }
+  return reportNvsQuota(result, namespace_name, key, entries, free_entries);
+}
+
+void StorageManager::onScopedWriteFailed() {
+  onWriteFailed();
+}
+
 // ============================================
 // PRIMARY API: const char* (Guide-konform)
 // ============================================
@@ -318,13 +440,14 @@ bool StorageManager::putString(const char* key, const char* value) {
   }
 #endif
 
-  // Check NVS quota before write
-  if (!checkNVSQuota(key)) {
+  // Check NVS quota before write (header + data span)
+  if (!checkNVSQuota(key, NvsAccounting::entriesForString(strlen(value)))) {
     return false;
   }
 
   size_t bytes = preferences_.putString(key, value);
   if (bytes == 0 && strlen(value) > 0) {
+    onWriteFailed();
     LOG_E(TAG, "StorageManager: Failed to write string key: " + String(key));
     return false;
   }
@@ -382,12 +505,13 @@ bool StorageManager::putInt(const char* key, int value) {
   }
 #endif
 
-  if (!checkNVSQuota(key)) {
+  if (!checkNVSQuota(key, NvsAccounting::entriesForPrimitive())) {
     return false;
   }
 
   size_t bytes = preferences_.putInt(key, value);
   if (bytes == 0) {
+    onWriteFailed();
     LOG_E(TAG, "StorageManager: Failed to write int key: " + String(key));
     return false;
   }
@@ -442,12 +566,13 @@ bool StorageManager::putUInt8(const char* key, uint8_t value) {
   }
 #endif
 
-  if (!checkNVSQuota(key)) {
+  if (!checkNVSQuota(key, NvsAccounting::entriesForPrimitive())) {
     return false;
   }
 
   size_t bytes = preferences_.putUChar(key, value);
   if (bytes == 0) {
+    onWriteFailed();
     LOG_E(TAG, "StorageManager: Failed to write uint8 key: " + String(key));
     return false;
   }
@@ -499,12 +624,13 @@ bool StorageManager::putUInt16(const char* key, uint16_t value) {
   }
 #endif
 
-  if (!checkNVSQuota(key)) {
+  if (!checkNVSQuota(key, NvsAccounting::entriesForPrimitive())) {
     return false;
   }
 
   size_t bytes = preferences_.putUShort(key, value);
   if (bytes == 0) {
+    onWriteFailed();
     LOG_E(TAG, "StorageManager: Failed to write uint16 key: " + String(key));
     return false;
   }
@@ -556,12 +682,13 @@ bool StorageManager::putBool(const char* key, bool value) {
   }
 #endif
 
-  if (!checkNVSQuota(key)) {
+  if (!checkNVSQuota(key, NvsAccounting::entriesForPrimitive())) {
     return false;
   }
 
   size_t bytes = preferences_.putBool(key, value);
   if (bytes == 0) {
+    onWriteFailed();
     LOG_E(TAG, "StorageManager: Failed to write bool key: " + String(key));
     return false;
   }
@@ -613,12 +740,13 @@ bool StorageManager::putFloat(const char* key, float value) {
   }
 #endif
 
-  if (!checkNVSQuota(key)) {
+  if (!checkNVSQuota(key, NvsAccounting::entriesForPrimitive())) {
     return false;
   }
 
   size_t bytes = preferences_.putFloat(key, value);
   if (bytes == 0) {
+    onWriteFailed();
     LOG_E(TAG, "StorageManager: Failed to write float key: " + String(key));
     return false;
   }
@@ -673,12 +801,13 @@ bool StorageManager::putULong(const char* key, unsigned long value) {
   }
 #endif
 
-  if (!checkNVSQuota(key)) {
+  if (!checkNVSQuota(key, NvsAccounting::entriesForPrimitive())) {
     return false;
   }
 
   size_t bytes = preferences_.putULong(key, value);
   if (bytes == 0) {
+    onWriteFailed();
     LOG_E(TAG, "StorageManager: Failed to write ulong key: " + String(key));
     return false;
   }
@@ -787,6 +916,12 @@ bool StorageManager::eraseAll() {
   // Close any open namespace first
   if (namespace_open_) {
     preferences_.end();
+    {
+      NVS_ACCOUNTING_GUARD();
+      nvs_accounting_.endSession();
+    }
+    endWatchdogPhase();
+    namespace_locks_.release(current_namespace_);
     namespace_open_ = false;
     LOG_D(TAG, "StorageManager: Closed namespace before erase: " + String(current_namespace_));
     current_namespace_[0] = '\0';
@@ -806,6 +941,7 @@ bool StorageManager::eraseAll() {
     return false;
   }
 
+  onWriteFailed();  // Invalidate cached free count
   LOG_I(TAG, "StorageManager: Factory reset complete - NVS erased and re-initialized");
   return true;
 }
@@ -843,5 +979,200 @@ size_t StorageManager::getFreeEntries() {
     return 0;
   }
   
+  {
+    NVS_ACCOUNTING_GUARD();
+    if (nvs_accounting_.isCacheValid()) {
+      return nvs_accounting_.getCachedFreeEntries();
+    }
+  }
   return preferences_.freeEntries();
 }
+
+uint32_t StorageManager::getNvsStatQueryCount() const {
+  return nvs_accounting_.getStatQueryCount();
+}
+
+void StorageManager::appendDiagnosticsJson(String& json) {
+#ifdef CONFIG_ENABLE_THREAD_SAFETY
+  StorageLockGuard guard(nvs_mutex_);
+  if (!guard.locked()) {
+    return;
+  }
+#endif
+  // Preferences::freeEntries() is partition-wide; per-namespace usage needs
+  // a separate read-only handle. Only for diagnostics, never on the write path.
+  NVS_ACCOUNTING_GUARD();
+  for (size_t i = 0; i < nvs_accounting_.getNamespaceCount(); i++) {
+    nvs_handle_t handle;
+    if (nvs_open(nvs_accounting_.getNamespace(i).name, NVS_READONLY, &handle) != ESP_OK) {
+      continue;
+    }
+    size_t used_entries = 0;
+    if (nvs_get_used_entry_count(handle, &used_entries) == ESP_OK) {
+      nvs_accounting_.setUsedEntries(i, static_cast<uint32_t>(used_entries));
+    }
+    nvs_close(handle);
+  }
+  nvs_accounting_.appendDiagnosticsJson(json);
+}
+
+// ============================================
+// SCOPED NAMESPACE HANDLE
+// ============================================
+NvsScopedNamespace::NvsScopedNamespace(const char* namespace_name, bool read_only,
+                                       uint32_t timeout_ms)
+  : lease_(storageManager.getNamespaceLocks(), namespace_name, timeout_ms)
+  , open_(false)
+  , read_only_(read_only)
+{
+  namespace_name_[0] = '\0';
+  if (!lease_.held()) {
+    LOG_W(TAG, "NvsScopedNamespace: Lock timeout for namespace: " + String(namespace_name));
+    return;
+  }
+  // Same NOT_FOUND log suppression as StorageManager::beginNamespace()
+  if (read_only) {
+    esp_log_level_set("Preferences", ESP_LOG_NONE);
+    esp_log_level_set("Preferences.cpp", ESP_LOG_NONE);
+  }
+  open_ = preferences_.begin(namespace_name, read_only);
+  if (read_only) {
+    esp_log_level_set("Preferences", ESP_LOG_WARN);
+    esp_log_level_set("Preferences.cpp", ESP_LOG_WARN);
+  }
+  if (!open_) {
+    if (!read_only) {
+      LOG_E(TAG, "NvsScopedNamespace: Failed to open namespace for write: " + String(namespace_name));
+    }
+    return;
+  }
+  strncpy(namespace_name_, namespace_name, sizeof(namespace_name_) - 1);
+  namespace_name_[sizeof(namespace_name_) - 1] = '\0';
+  storageManager.beginScopedSession(namespace_name_, read_only_);
+}
+
+NvsScopedNamespace::~NvsScopedNamespace() {
+  if (open_) {
+    preferences_.end();
+    storageManager.endScopedSession(read_only_);
+  }
+  // lease_ released by its own destructor (after preferences_.end())
+}
+
+bool NvsScopedNamespace::reserve(const char* key, size_t entries) {
+  if (!open_ || read_only_) {
+    return false;
+  }
+  return storageManager.reserveScopedWrite(namespace_name_, key, entries, preferences_);
+}
+
+bool NvsScopedNamespace::finishWrite(const char* key, bool ok, const char* kind) {
+  if (!ok) {
+    storageManager.onScopedWriteFailed();
+    LOG_E(TAG, "NvsScopedNamespace: Failed to write " + String(kind) + " key: " + String(key));
+  }
+  return ok;
+}
+
+bool NvsScopedNamespace::putString(const char* key, const char* value) {
+  size_t length = strlen(value);
+  if (!reserve(key, NvsAccounting::entriesForString(length))) {
+    return false;
+  }
+  return finishWrite(key, preferences_.putString(key, value) > 0 || length == 0, "string");
+}
+
+String NvsScopedNamespace::getString(const char* key, const char* default_value) {
+  if (!open_) {
+    return String(default_value);
+  }
+  return preferences_.getString(key, default_value);
+}
+
+bool NvsScopedNamespace::putUInt8(const char* key, uint8_t value) {
+  if (!reserve(key, NvsAccounting::entriesForPrimitive())) {
+    return false;
+  }
+  return finishWrite(key, preferences_.putUChar(key, value) > 0, "uint8");
+}
+
+uint8_t NvsScopedNamespace::getUInt8(const char* key, uint8_t default_value) {
+  return open_ ? preferences_.getUChar(key, default_value) : default_value;
+}
+
+bool NvsScopedNamespace::putUInt16(const char* key, uint16_t value) {
+  if (!reserve(key, NvsAccounting::entriesForPrimitive())) {
+    return false;
+  }
+  return finishWrite(key, preferences_.putUShort(key, value) > 0, "uint16");
+}
+
+uint16_t NvsScopedNamespace::getUInt16(const char* key, uint16_t default_value) {
+  return open_ ? preferences_.getUShort(key, default_value) : default_value;
+}
+
+bool NvsScopedNamespace::putBool(const char* key, bool value) {
+  if (!reserve(key, NvsAccounting::entriesForPrimitive())) {
+    return false;
+  }
+  return finishWrite(key, preferences_.putBool(key, value) > 0, "bool");
+}
+
+bool NvsScopedNamespace::getBool(const char* key, bool default_value) {
+  return open_ ? preferences_.getBool(key, default_value) : default_value;
+}
+
+bool NvsScopedNamespace::putFloat(const char* key, float value) {
+  if (!reserve(key, NvsAccounting::entriesForPrimitive())) {
+    return false;
+  }
+  return finishWrite(key, preferences_.putFloat(key, value) > 0, "float");
+}
+
+float NvsScopedNamespace::getFloat(const char* key, float default_value) {
+  return open_ ? preferences_.getFloat(key, default_value) : default_value;
+}
+
+bool NvsScopedNamespace::putULong(const char* key, unsigned long value) {
+  if (!reserve(key, NvsAccounting::entriesForPrimitive())) {
+    return false;
+  }
+  return finishWrite(key, preferences_.putULong(key, value) > 0, "ulong");
+}
+
+unsigned long NvsScopedNamespace::getULong(const char* key, unsigned long default_value) {
+  return open_ ? preferences_.getULong(key, default_value) : default_value;
+}
+
+bool NvsScopedNamespace::putBytes(const char* key, const void* value, size_t length) {
+  if (!reserve(key, NvsAccounting::entriesForBlob(length))) {
+    return false;
+  }
+  return finishWrite(key, preferences_.putBytes(key, value, length) == length, "blob");
+}
+
+size_t NvsScopedNamespace::getBytes(const char* key, void* buffer, size_t length) {
+  if (!open_ || preferences_.getBytesLength(key) != length) {
+    return 0;
+  }
+  return preferences_.getBytes(key, buffer, length);
+}
+
+bool NvsScopedNamespace::keyExists(const char* key) {
+  return open_ && preferences_.isKey(key);
+}
+
+bool NvsScopedNamespace::eraseKey(const char* key) {
+  if (!open_ || read_only_) {
+    return false;
+  }
+  preferences_.remove(key);
+  return true;  // Idempotent like StorageManager::eraseKey()
+}
+
+bool NvsScopedNamespace::clear() {
+  if (!open_ || read_only_) {
+    return false;
+  }
+  return preferences_.clear();
+}
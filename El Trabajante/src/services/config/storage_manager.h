@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include "nvs_accounting.h"
+#include "nvs_namespace_locks.h"
 
 #ifdef CONFIG_ENABLE_THREAD_SAFETY
 #include <freertos/FreeRTOS.h>
@@ -22,6 +24,11 @@ public:
   bool begin();
   
   // Namespace Management (const char* für API-Konsistenz)
+  // Legacy session: one global session (nvs_mutex_ + a single Preferences
+  // handle), so legacy users exclude each other on ANY namespace. It also
+  // takes the namespace lock, which serializes it against NvsScopedNamespace
+  // users (e.g. ConfigManager sensor/actuator/system saves) of the same
+  // namespace only.
   bool beginNamespace(const char* namespace_name, bool read_only = false);
   void endNamespace();
   bool beginTransaction();
@@ -62,6 +69,21 @@ public:
   bool eraseAll();
   bool keyExists(const char* key);
   size_t getFreeEntries();
+
+  // NVS-Statistik: Stats-Queries + Nutzung pro Namespace (nvs_get_used_entry_count)
+  uint32_t getNvsStatQueryCount() const;
+  void appendDiagnosticsJson(String& json);
+
+  // Per-namespace locks (shared by the legacy session and NvsScopedNamespace)
+  NvsNamespaceLocks& getNamespaceLocks() { return namespace_locks_; }
+
+  // NvsScopedNamespace hooks: same quota accounting and "nvs_commit" watchdog
+  // phase as a legacy write session, without taking nvs_mutex_
+  void beginScopedSession(const char* namespace_name, bool read_only);
+  void endScopedSession(bool read_only);
+  bool reserveScopedWrite(const char* namespace_name, const char* key, size_t entries,
+                          Preferences& preferences);
+  void onScopedWriteFailed();
   
 private:
   StorageManager();  // Private Constructor (Singleton)
@@ -73,18 +95,34 @@ private:
   bool namespace_open_;
   char current_namespace_[16];
   bool transaction_active_;
+  bool wdt_phase_active_;  // Write session open as "nvs_commit" watchdog phase
 
   // Static buffer für getString (Guide-konform)
   static char string_buffer_[256];
 
-  // NVS Quota Check Helper
-  bool checkNVSQuota(const char* key);
+  void endWatchdogPhase();
+
+  // NVS Quota Check Helper (cached stats, see NvsAccounting)
+  bool checkNVSQuota(const char* key, size_t entries);
+  void onWriteFailed();
+
+  class PreferencesStatsSource : public INvsStatsSource {
+  public:
+    explicit PreferencesStatsSource(Preferences& preferences) : preferences_(preferences) {}
+    size_t queryFreeEntries() override { return preferences_.freeEntries(); }
+  private:
+    Preferences& preferences_;
+  };
+  PreferencesStatsSource stats_source_;
+  NvsAccounting nvs_accounting_;
+  NvsNamespaceLocks namespace_locks_;
   bool ensureActiveSession(const char* operation, bool count_no_session = true);
   void recordNamespaceConflict();
   void recordNoSessionAccess();
 
 #ifdef CONFIG_ENABLE_THREAD_SAFETY
   SemaphoreHandle_t nvs_mutex_;
+  SemaphoreHandle_t accounting_mutex_;  // nvs_accounting_ (legacy session + scoped handles)
   TaskHandle_t namespace_owner_task_;
 #endif
   uint32_t namespace_conflict_count_;
@@ -96,4 +134,60 @@ private:
 // ============================================
 extern StorageManager& storageManager;
 
+// ============================================
+// SCOPED NAMESPACE HANDLE (RAII)
+// ============================================
+// Own Preferences handle + per-namespace lock, independent of the global
+// StorageManager session. A scoped user never waits for a legacy session on
+// another namespace (e.g. Safety-Task watchdog records / offline rules vs. a
+// wifi_config save). Legacy sessions among themselves stay serialized — move
+// a caller here to take it off the global session. Writes go through the
+// same NVS quota check and watchdog phase as the legacy session.
+//
+//   NvsScopedNamespace ns("wdt_diag");
+//   if (ns.isOpen()) { ns.putString("snap", payload); }   // closed at scope end
+// ============================================
+class NvsScopedNamespace {
+public:
+  explicit NvsScopedNamespace(const char* namespace_name, bool read_only = false,
+                              uint32_t timeout_ms = NVS_NAMESPACE_LOCK_TIMEOUT_MS);
+  ~NvsScopedNamespace();
+  NvsScopedNamespace(const NvsScopedNamespace&) = delete;
+  NvsScopedNamespace& operator=(const NvsScopedNamespace&) = delete;
+
+  bool isOpen() const { return open_; }
+
+  bool putString(const char* key, const char* value);
+  inline bool putString(const char* key, const String& value) {
+    return putString(key, value.c_str());
+  }
+  String getString(const char* key, const char* default_value = "");
+  bool putUInt8(const char* key, uint8_t value);
+  uint8_t getUInt8(const char* key, uint8_t default_value = 0);
+  bool putUInt16(const char* key, uint16_t value);
+  uint16_t getUInt16(const char* key, uint16_t default_value = 0);
+  bool putBool(const char* key, bool value);
+  bool getBool(const char* key, bool default_value = false);
+  bool putFloat(const char* key, float value);
+  float getFloat(const char* key, float default_value = 0.0f);
+  bool putULong(const char* key, unsigned long value);
+  unsigned long getULong(const char* key, unsigned long default_value = 0);
+  bool putBytes(const char* key, const void* value, size_t length);
+  // Returns bytes read; 0 if missing or the stored blob has a different length
+  size_t getBytes(const char* key, void* buffer, size_t length);
+  bool keyExists(const char* key);
+  bool eraseKey(const char* key);
+  bool clear();
+
+private:
+  bool reserve(const char* key, size_t entries);
+  bool finishWrite(const char* key, bool ok, const char* kind);
+
+  NvsNamespaceLease lease_;
+  Preferences preferences_;
+  char namespace_name_[16];
+  bool open_;
+  bool read_only_;
+};
+
 #endif
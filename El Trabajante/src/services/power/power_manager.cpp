@@ -0,0 +1,261 @@
+#include "power_manager.h"
+
+#include <cstring>
+
+#include "../../config/feature_flags.h"
+
+#ifndef NATIVE_TEST
+#include <esp_pm.h>
+#include <esp_wifi.h>
+#include <freertos/FreeRTOS.h>
+#include "../../utils/logger.h"
+
+static const char* TAG = "POWER";
+
+static portMUX_TYPE s_power_mux = portMUX_INITIALIZER_UNLOCKED;
+#define POWER_LOCK() portENTER_CRITICAL(&s_power_mux)
+#define POWER_UNLOCK() portEXIT_CRITICAL(&s_power_mux)
+
+#ifdef CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t s_no_light_sleep_lock = nullptr;
+static esp_pm_lock_handle_t s_cpu_max_lock = nullptr;
+#endif
+#else
+#define POWER_LOCK()
+#define POWER_UNLOCK()
+#endif
+
+// Current model for estimateAverageCurrentMa() — ESP32 datasheet, WiFi associated
+// with modem sleep (DTIM wakeups averaged in). Indicative only.
+static const uint32_t CURRENT_ACTIVE_MA = 50;        // CPU at max freq, loop body running
+static const uint32_t CURRENT_IDLE_MAX_FREQ_MA = 40;  // Blocked, no DFS available
+static const uint32_t CURRENT_IDLE_DFS_MA = 25;       // Blocked, DFS at 80 MHz
+static const uint32_t CURRENT_LIGHT_SLEEP_MA = 3;     // Auto light sleep between DTIM beacons
+
+// Minimum CPU frequency under DFS — WiFi requires the APB clock at 80 MHz.
+static const int PM_MIN_FREQ_MHZ = 80;
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+PowerManager& powerManager = PowerManager::getInstance();
+
+PowerManager& PowerManager::getInstance() {
+    static PowerManager instance;
+    return instance;
+}
+
+PowerManager::PowerManager()
+    : config_(defaultConfig()),
+      pm_active_(false),
+      locks_held_(false) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+PowerConfig PowerManager::defaultConfig() {
+    PowerConfig config;
+#ifdef ENABLE_POWER_MANAGEMENT
+    config.enabled = true;
+#else
+    config.enabled = false;
+#endif
+    config.base_loop_ms = 10;
+    config.max_sleep_ms = 1000;
+    config.wake_guard_ms = 5;
+    config.min_light_sleep_ms = 50;
+    config.comm_base_delay_ms = 50;
+    config.comm_idle_delay_ms = 500;
+    return config;
+}
+
+// ============================================
+// INITIALIZATION
+// ============================================
+void PowerManager::begin() {
+#ifndef NATIVE_TEST
+    if (!config_.enabled) {
+        LOG_I(TAG, "[POWER] Power management disabled (ENABLE_POWER_MANAGEMENT not set)");
+        return;
+    }
+
+#ifdef CONFIG_PM_ENABLE
+#if CONFIG_IDF_TARGET_ESP32C3
+    esp_pm_config_esp32c3_t pm_config = {};
+#else
+    esp_pm_config_esp32_t pm_config = {};
+#endif
+    pm_config.max_freq_mhz = getCpuFrequencyMhz();
+    pm_config.min_freq_mhz = PM_MIN_FREQ_MHZ;
+#ifdef CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    pm_config.light_sleep_enable = true;
+#else
+    pm_config.light_sleep_enable = false;
+#endif
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err == ESP_OK) {
+        esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "pwr_busy", &s_no_light_sleep_lock);
+        esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "pwr_cpu", &s_cpu_max_lock);
+        pm_active_ = (s_no_light_sleep_lock != nullptr && s_cpu_max_lock != nullptr);
+    }
+    LOG_I(TAG, "[POWER] esp_pm configure: " + String(esp_err_to_name(err)) +
+          " (max=" + String(pm_config.max_freq_mhz) + " MHz, min=" + String(PM_MIN_FREQ_MHZ) +
+          " MHz, light_sleep=" + String(pm_config.light_sleep_enable ? "on" : "off") + ")");
+#else
+    LOG_W(TAG, "[POWER] CONFIG_PM_ENABLE not set in this build — task block stretching only");
+#endif
+
+    // Modem sleep keeps the association and wakes the radio on DTIM beacons,
+    // so incoming MQTT traffic (E-Stop, commands) still arrives while idle.
+    esp_err_t ps_err = esp_wifi_set_ps(WIFI_PS_MIN_MODEM);
+    if (ps_err != ESP_OK) {
+        LOG_W(TAG, "[POWER] WiFi modem sleep not set: " + String(esp_err_to_name(ps_err)));
+    }
+#endif
+}
+
+// ============================================
+// DEADLINE COMPUTATION (pure)
+// ============================================
+static uint32_t budgetFromDeadline(uint32_t deadline_in_ms, uint32_t guard_ms, uint32_t fallback_ms) {
+    if (deadline_in_ms == POWER_DEADLINE_NONE) {
+        return fallback_ms;
+    }
+    return deadline_in_ms > guard_ms ? deadline_in_ms - guard_ms : 0;
+}
+
+static uint32_t clampBudget(uint32_t budget_ms, uint32_t min_ms, uint32_t max_ms) {
+    if (budget_ms < min_ms) {
+        return min_ms;
+    }
+    return budget_ms > max_ms ? max_ms : budget_ms;
+}
+
+PowerDecision PowerManager::computeSafetyDecision(const PowerDeadlineInputs& inputs,
+                                                  const PowerConfig& config) {
+    PowerDecision decision;
+    decision.sleep_ms = config.base_loop_ms;
+    decision.allow_light_sleep = false;
+
+    // Running actuators need the 10 ms cadence for duration/runtime protection timers
+    if (!config.enabled || inputs.actuator_running || inputs.work_pending) {
+        return decision;
+    }
+
+    uint32_t deadline = inputs.next_measurement_in_ms;
+    if (inputs.next_offline_eval_in_ms < deadline) {
+        deadline = inputs.next_offline_eval_in_ms;
+    }
+
+    uint32_t budget = budgetFromDeadline(deadline, config.wake_guard_ms, config.max_sleep_ms);
+    decision.sleep_ms = clampBudget(budget, config.base_loop_ms, config.max_sleep_ms);
+    // Longer blocks still pay off with DFS; only the light-sleep transition is skipped
+    decision.allow_light_sleep = !inputs.keep_apb_clock &&
+                                 decision.sleep_ms >= config.min_light_sleep_ms;
+    return decision;
+}
+
+uint32_t PowerManager::computeCommDelayMs(const PowerDeadlineInputs& inputs,
+                                          const PowerConfig& config) {
+    // Reconnect handling and queue drain keep the normal cadence. The idle block
+    // applies even without power management: queued publishes wake the
+    // Comm-Task directly (TaskWake), so idle polling buys no latency.
+    if (!inputs.link_up || inputs.work_pending) {
+        return config.comm_base_delay_ms;
+    }
+    uint32_t budget = budgetFromDeadline(inputs.next_heartbeat_in_ms, config.wake_guard_ms,
+                                         config.comm_idle_delay_ms);
+    return clampBudget(budget, config.comm_base_delay_ms, config.comm_idle_delay_ms);
+}
+
+// ============================================
+// SAFETY-TASK INTEGRATION
+// ============================================
+PowerDecision PowerManager::planSafetyBlock(const PowerDeadlineInputs& inputs) {
+    PowerDecision decision = computeSafetyDecision(inputs, config_);
+    applyLocks(decision.allow_light_sleep);
+    return decision;
+}
+
+void PowerManager::applyLocks(bool allow_light_sleep) {
+    if (!pm_active_) {
+        return;
+    }
+#if !defined(NATIVE_TEST) && defined(CONFIG_PM_ENABLE)
+    if (!allow_light_sleep && !locks_held_) {
+        esp_pm_lock_acquire(s_no_light_sleep_lock);
+        esp_pm_lock_acquire(s_cpu_max_lock);
+        locks_held_ = true;
+    } else if (allow_light_sleep && locks_held_) {
+        esp_pm_lock_release(s_cpu_max_lock);
+        esp_pm_lock_release(s_no_light_sleep_lock);
+        locks_held_ = false;
+    }
+#else
+    locks_held_ = !allow_light_sleep;
+#endif
+}
+
+void PowerManager::recordSafetyWake(const PowerDecision& decision, uint32_t active_ms,
+                                    uint32_t blocked_ms, PowerWakeSource source) {
+    POWER_LOCK();
+    stats_.wakes++;
+    if (source == PowerWakeSource::NOTIFY) {
+        stats_.notify_wakes++;
+    }
+    stats_.active_ms += active_ms;
+    if (decision.allow_light_sleep && pm_active_) {
+        stats_.light_sleep_blocks++;
+        stats_.sleep_ms += blocked_ms;
+    } else {
+        stats_.idle_ms += blocked_ms;
+    }
+    POWER_UNLOCK();
+}
+
+PowerStats PowerManager::getStats() const {
+    PowerStats copy;
+    POWER_LOCK();
+    copy = stats_;
+    POWER_UNLOCK();
+    return copy;
+}
+
+uint32_t PowerManager::estimateAverageCurrentMa() const {
+    PowerStats stats = getStats();
+    uint64_t total_ms = stats.active_ms + stats.idle_ms + stats.sleep_ms;
+    if (total_ms == 0) {
+        return 0;
+    }
+    uint32_t idle_ma = pm_active_ ? CURRENT_IDLE_DFS_MA : CURRENT_IDLE_MAX_FREQ_MA;
+    uint64_t charge = stats.active_ms * CURRENT_ACTIVE_MA +
+                      stats.idle_ms * idle_ma +
+                      stats.sleep_ms * CURRENT_LIGHT_SLEEP_MA;
+    return static_cast<uint32_t>((charge + total_ms / 2) / total_ms);
+}
+
+void PowerManager::appendDiagnosticsJson(String& json) const {
+    PowerStats stats = getStats();
+    uint64_t total_ms = stats.active_ms + stats.idle_ms + stats.sleep_ms;
+    uint32_t sleep_pct = total_ms > 0 ? static_cast<uint32_t>(stats.sleep_ms * 100 / total_ms) : 0;
+
+    char buf[160];
+    snprintf(buf, sizeof(buf),
+             ",\"power\":{\"en\":%s,\"pm\":%s,\"wakes\":%lu,\"wake_notify\":%lu,"
+             "\"sleep_pct\":%lu,\"est_avg_ma\":%lu}",
+             config_.enabled ? "true" : "false",
+             pm_active_ ? "true" : "false",
+             static_cast<unsigned long>(stats.wakes),
+             static_cast<unsigned long>(stats.notify_wakes),
+             static_cast<unsigned long>(sleep_pct),
+             static_cast<unsigned long>(estimateAverageCurrentMa()));
+    json += buf;
+}
+
+#ifdef NATIVE_TEST
+void PowerManager::resetForTest() {
+    config_ = defaultConfig();
+    memset(&stats_, 0, sizeof(stats_));
+    pm_active_ = false;
+    locks_held_ = false;
+}
+#endif
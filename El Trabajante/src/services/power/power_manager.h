@@ -0,0 +1,120 @@
+#ifndef SERVICES_POWER_POWER_MANAGER_H
+#define SERVICES_POWER_POWER_MANAGER_H
+
+#include <Arduino.h>
+
+// ============================================
+// POWER MANAGER (DFS + Automatic Light Sleep)
+// ============================================
+// Field nodes that only measure every 30–60 s spend most of their time
+// polling. The Safety-Task and the Comm-Task ask the PowerManager how long
+// they may block; when nothing is due the tasks block longer and ESP-IDF
+// power management (esp_pm: DFS + auto light sleep, WiFi modem sleep) lowers
+// the clock and sleeps in the idle task.
+//
+// Latency guarantees:
+//   - Running actuator or queued work → 10 ms cadence, max CPU frequency, no light sleep.
+//   - Safety-Task blocks on xTaskNotifyWait(): emergency stop and queued
+//     commands (NOTIFY_* bits) wake it immediately, independent of the budget.
+//   - Block time is capped at max_sleep_ms (WDT feed + ACK timeout resolution).
+//
+// computeSafetyDecision()/computeCommDelayMs() are pure functions of
+// PowerDeadlineInputs and are unit-tested on native.
+// ============================================
+
+// Milliseconds until each deadline; POWER_DEADLINE_NONE = nothing scheduled.
+static const uint32_t POWER_DEADLINE_NONE = UINT32_MAX;
+
+struct PowerDeadlineInputs {
+    uint32_t next_measurement_in_ms;   // SensorManager continuous-mode schedule
+    uint32_t next_offline_eval_in_ms;  // SAFETY-P4 rule evaluation (offline only)
+    uint32_t next_heartbeat_in_ms;     // Comm-Task: heartbeat and other periodic jobs
+    bool actuator_running;             // Any actuator ON → runtime/duration timers active
+    bool work_pending;                 // Command/config/publish queues not empty
+    bool link_up;                      // WiFi + MQTT connected (reconnect needs full cadence)
+    bool keep_apb_clock;               // PCNT counting / edge inputs armed → light sleep would lose pulses and edges
+};
+
+struct PowerConfig {
+    bool enabled;
+    uint32_t base_loop_ms;         // Safety-Task cadence when busy (10 ms)
+    uint32_t max_sleep_ms;         // Upper bound for any single block
+    uint32_t wake_guard_ms;        // Wake this much before a deadline
+    uint32_t min_light_sleep_ms;   // Shorter blocks are not worth a light-sleep transition
+    uint32_t comm_base_delay_ms;   // Comm-Task cadence when busy (50 ms)
+    uint32_t comm_idle_delay_ms;   // Comm-Task max block when idle (publishes wake it early)
+};
+
+struct PowerDecision {
+    uint32_t sleep_ms;
+    bool allow_light_sleep;  // false → hold ESP_PM_NO_LIGHT_SLEEP + CPU_FREQ_MAX locks
+};
+
+enum class PowerWakeSource : uint8_t {
+    TIMEOUT = 0,   // Budget elapsed (deadline reached)
+    NOTIFY         // Woken early by task notification (E-Stop, queued command)
+};
+
+struct PowerStats {
+    uint32_t wakes;
+    uint32_t notify_wakes;
+    uint32_t light_sleep_blocks;   // Blocks that allowed light sleep
+    uint64_t active_ms;            // Safety-Task loop body time
+    uint64_t idle_ms;              // Blocked, light sleep forbidden (DFS only)
+    uint64_t sleep_ms;             // Blocked, light sleep allowed
+};
+
+class PowerManager {
+public:
+    static PowerManager& getInstance();
+
+    // Configures esp_pm (if CONFIG_PM_ENABLE) and WiFi modem sleep. Safe to call once
+    // after WiFi init. Without ENABLE_POWER_MANAGEMENT the manager stays disabled.
+    void begin();
+    bool isEnabled() const { return config_.enabled; }
+    bool isPmActive() const { return pm_active_; }
+
+    static PowerConfig defaultConfig();
+    void setConfig(const PowerConfig& config) { config_ = config; }
+    const PowerConfig& getConfig() const { return config_; }
+
+    static PowerDecision computeSafetyDecision(const PowerDeadlineInputs& inputs,
+                                               const PowerConfig& config);
+    static uint32_t computeCommDelayMs(const PowerDeadlineInputs& inputs,
+                                       const PowerConfig& config);
+
+    // Safety-Task: decision for this iteration; applies the PM locks.
+    PowerDecision planSafetyBlock(const PowerDeadlineInputs& inputs);
+    // Safety-Task: book-keeping after the block returned.
+    void recordSafetyWake(const PowerDecision& decision, uint32_t active_ms,
+                          uint32_t blocked_ms, PowerWakeSource source);
+
+    PowerStats getStats() const;
+    // Rough average current from time-in-state (datasheet figures, not measured).
+    uint32_t estimateAverageCurrentMa() const;
+
+    // Appends ,"power":{...} to a diagnostics JSON object body.
+    void appendDiagnosticsJson(String& json) const;
+
+#ifdef NATIVE_TEST
+    void resetForTest();
+    void setPmActiveForTest(bool active) { pm_active_ = active; }
+#endif
+
+private:
+    PowerManager();
+    ~PowerManager() = default;
+    PowerManager(const PowerManager&) = delete;
+    PowerManager& operator=(const PowerManager&) = delete;
+
+    void applyLocks(bool allow_light_sleep);
+
+    PowerConfig config_;
+    PowerStats stats_;
+    bool pm_active_;
+    bool locks_held_;
+};
+
+extern PowerManager& powerManager;
+
+#endif  // SERVICES_POWER_POWER_MANAGER_H
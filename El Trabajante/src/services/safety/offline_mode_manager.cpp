@@ -470,7 +470,13 @@ void OfflineModeManager::checkDelayTimer() {
 // Comparing ADC raw vs. physical threshold is meaningless and potentially dangerous.
 // Server-side filter (config_builder.py) is the primary defense; this guard handles
 // stale NVS data, manual config manipulation, or server-side bugs.
-static bool requiresCalibration(const char* sensor_value_type) {
+// Exception: pH / EC with on-device calibration cache physical (temperature
+// compensated) values and can drive offline rules.
+static bool requiresCalibration(const OfflineRule& rule) {
+    const char* sensor_value_type = rule.sensor_value_type;
+    if (sensorManager.hasDeviceCalibration(rule.sensor_gpio, sensor_value_type)) {
+        return false;
+    }
     // Canonical types — server normalizes aliases before building the config push,
     // but stale NVS data from pre-normalization firmware may still carry alias strings
     // such as "soil_moisture". Include all known aliases as defense-in-depth.
@@ -565,7 +571,7 @@ void OfflineModeManager::evaluateOfflineRules() {
         uint8_t filtered = 0;
         String detail = "";
         for (uint8_t i = 0; i < offline_rule_count_; i++) {
-            if (requiresCalibration(offline_rules_[i].sensor_value_type)) {
+            if (requiresCalibration(offline_rules_[i])) {
                 filtered++;
                 if (detail.length() > 0) {
                     detail += ", ";
@@ -602,7 +608,7 @@ void OfflineModeManager::evaluateOfflineRules() {
         }
 
         // Guard: ph/ec/moisture rules cannot be evaluated without server calibration.
-        if (requiresCalibration(rule.sensor_value_type)) {
+        if (requiresCalibration(rule)) {
             if (!rule.is_active) {
                 if (!(s_eval_cal_inactive_logged & (1u << i))) {
                     s_eval_cal_inactive_logged |= (1u << i);
@@ -818,9 +824,9 @@ bool OfflineModeManager::parseOfflineRules(JsonObject obj) {
     if (rules.size() == 0) {
         // Explicit empty array → clear all rules
         offline_rule_count_ = 0;
-        if (storageManager.beginNamespace("offline", false)) {
-            storageManager.clearNamespace();
-            storageManager.endNamespace();
+        NvsScopedNamespace ns("offline", false);
+        if (ns.isOpen()) {
+            ns.clear();
         }
         resetOfflineEvalLogState();
         LOG_I(TAG, "[CONFIG] Received 0 offline rules — cleared NVS");
@@ -934,6 +940,14 @@ void OfflineModeManager::logOfflineRulesSummary(const char* source_label) {
 }
 
 void OfflineModeManager::loadOfflineRulesFromNVS() {
+    // count/blob/version are three NVS items → hold the namespace for the whole load
+    NvsNamespaceLease lease(storageManager.getNamespaceLocks(), "offline");
+    if (!lease.held()) {
+        offline_rule_count_ = 0;
+        LOG_E(TAG, "[CONFIG] NVS namespace 'offline' busy - no rules loaded");
+        return;
+    }
+
     nvs_handle_t handle;
     esp_err_t err = nvs_open("offline", NVS_READONLY, &handle);
     if (err == ESP_ERR_NVS_NOT_FOUND) {
@@ -953,28 +967,29 @@ void OfflineModeManager::loadOfflineRulesFromNVS() {
 
     // ── MIGRATION PATH (ver == 0 or key absent) ──────────────────────────────
     if (ver == 0) {
-        if (!storageManager.beginNamespace("offline", true)) {
+        NvsScopedNamespace ns("offline", true);
+        if (!ns.isOpen()) {
             offline_rule_count_ = 0;
             LOG_D(TAG, "[CONFIG] NVS namespace 'offline' not readable - no rules loaded");
             return;
         }
 
-        offline_rule_count_ = storageManager.getUInt8("ofr_count", 0);
+        offline_rule_count_ = ns.getUInt8("ofr_count", 0);
         if (offline_rule_count_ > MAX_OFFLINE_RULES) offline_rule_count_ = MAX_OFFLINE_RULES;
 
         char key[16];
         for (uint8_t i = 0; i < offline_rule_count_; i++) {
             snprintf(key, sizeof(key), "ofr_%d_en", i);
-            offline_rules_[i].enabled = storageManager.getUInt8(key, 0) != 0;
+            offline_rules_[i].enabled = ns.getUInt8(key, 0) != 0;
 
             snprintf(key, sizeof(key), "ofr_%d_agpio", i);
-            offline_rules_[i].actuator_gpio = storageManager.getUInt8(key, 255);
+            offline_rules_[i].actuator_gpio = ns.getUInt8(key, 255);
 
             snprintf(key, sizeof(key), "ofr_%d_sgpio", i);
-            offline_rules_[i].sensor_gpio = storageManager.getUInt8(key, 255);
+            offline_rules_[i].sensor_gpio = ns.getUInt8(key, 255);
 
             snprintf(key, sizeof(key), "ofr_%d_svtyp", i);
-            String svtyp = storageManager.getStringObj(key, "");
+            String svtyp = ns.getString(key, "");
             strncpy(offline_rules_[i].sensor_value_type, svtyp.c_str(), 23);
             offline_rules_[i].sensor_value_type[23] = '\0';
             if (svtyp.length() > 23) {
@@ -983,20 +998,20 @@ void OfflineModeManager::loadOfflineRulesFromNVS() {
             }
 
             snprintf(key, sizeof(key), "ofr_%d_actb", i);
-            offline_rules_[i].activate_below = storageManager.getFloat(key, 0.0f);
+            offline_rules_[i].activate_below = ns.getFloat(key, 0.0f);
 
             snprintf(key, sizeof(key), "ofr_%d_deaa", i);
-            offline_rules_[i].deactivate_above = storageManager.getFloat(key, 0.0f);
+            offline_rules_[i].deactivate_above = ns.getFloat(key, 0.0f);
 
             snprintf(key, sizeof(key), "ofr_%d_acta", i);
-            offline_rules_[i].activate_above = storageManager.getFloat(key, 0.0f);
+            offline_rules_[i].activate_above = ns.getFloat(key, 0.0f);
 
             snprintf(key, sizeof(key), "ofr_%d_deab", i);
-            offline_rules_[i].deactivate_below = storageManager.getFloat(key, 0.0f);
+            offline_rules_[i].deactivate_below = ns.getFloat(key, 0.0f);
 
             snprintf(key, sizeof(key), "ofr_%d_state", i);
-            offline_rules_[i].is_active = storageManager.keyExists(key) &&
-                                           (storageManager.getUInt8(key, 0) != 0);
+            offline_rules_[i].is_active = ns.keyExists(key) &&
+                                           (ns.getUInt8(key, 0) != 0);
             offline_rules_[i].server_override   = false;
             offline_rules_[i].time_filter_enabled = false;
             offline_rules_[i].start_hour   = 0;
@@ -1006,7 +1021,6 @@ void OfflineModeManager::loadOfflineRulesFromNVS() {
             offline_rules_[i].days_of_week_mask = 0x7F;
             offline_rules_[i].timezone_mode = static_cast<uint8_t>(OfflineRuleTimezone::UTC);
         }
-        storageManager.endNamespace();
 
         // Force blob write even if offline_rule_count_==0 (persists ofr_ver=3)
         shadow_rule_count_ = UINT8_MAX;
@@ -1325,6 +1339,14 @@ bool OfflineModeManager::saveOfflineRulesToNVS() {
     memcpy(blob, offline_rules_, rules_size);
     blob[rules_size] = crc8(blob, rules_size);
 
+    // Readers must never see a new ofr_count with the old blob
+    NvsNamespaceLease lease(storageManager.getNamespaceLocks(), "offline");
+    if (!lease.held()) {
+        LOG_E(TAG, "[CONFIG] NVS namespace 'offline' busy - blob write skipped");
+        setPersistenceDrift("NVS_NAMESPACE_BUSY");
+        return false;
+    }
+
     nvs_handle_t handle;
     esp_err_t err = nvs_open("offline", NVS_READWRITE, &handle);
     if (err != ESP_OK) {
@@ -1356,7 +1378,8 @@ bool OfflineModeManager::saveOfflineRulesToNVS() {
 }
 
 void OfflineModeManager::_deleteOldIndividualKeys() {
-    if (!storageManager.beginNamespace("offline", false)) {
+    NvsScopedNamespace ns("offline", false);
+    if (!ns.isOpen()) {
         LOG_W(TAG, "[CONFIG] _deleteOldIndividualKeys: cannot open namespace");
         return;
     }
@@ -1367,10 +1390,9 @@ void OfflineModeManager::_deleteOldIndividualKeys() {
     for (uint8_t i = 0; i < MAX_OFFLINE_RULES; i++) {
         for (const char* field : LEGACY_FIELDS) {
             snprintf(key, sizeof(key), "ofr_%d_%s", i, field);
-            if (storageManager.keyExists(key)) {
-                storageManager.eraseKey(key);
+            if (ns.keyExists(key)) {
+                ns.eraseKey(key);
             }
         }
     }
-    storageManager.endNamespace();
 }
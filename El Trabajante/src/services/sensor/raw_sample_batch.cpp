@@ -0,0 +1,217 @@
+#include "raw_sample_batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================
+// CONFIGURATION
+// ============================================
+RawSampleBatch::RawSampleBatch() {
+    policy_.max_samples = 0;
+    policy_.flush_interval_ms = 0;
+    policy_.flush_delta = 0;
+    reset();
+}
+
+void RawSampleBatch::configure(const RawBatchPolicy& policy) {
+    policy_ = policy;
+    if (policy_.max_samples > RAW_BATCH_MAX_SAMPLES) {
+        policy_.max_samples = RAW_BATCH_MAX_SAMPLES;
+    }
+    reset();
+}
+
+void RawSampleBatch::reset() {
+    memset(ring_, 0, sizeof(ring_));
+    capacity_ = policy_.max_samples > 0 ? policy_.max_samples : 1;
+    head_ = 0;
+    count_ = 0;
+    reference_raw_ = 0;
+    has_reference_ = false;
+    dropped_ = 0;
+}
+
+// ============================================
+// RING
+// ============================================
+bool RawSampleBatch::add(int32_t raw, uint32_t timestamp_ms) {
+    if (count_ < capacity_) {
+        ring_[(head_ + count_) % capacity_] = {raw, timestamp_ms};
+        count_++;
+    } else {
+        // Flush pending (offline): keep the newest samples
+        ring_[head_] = {raw, timestamp_ms};
+        head_ = static_cast<uint8_t>((head_ + 1) % capacity_);
+        dropped_++;
+    }
+
+    if (!has_reference_) {
+        reference_raw_ = raw;
+        has_reference_ = true;
+    }
+
+    if (count_ >= capacity_) {
+        return true;
+    }
+    if (policy_.flush_delta > 0) {
+        int64_t diff = static_cast<int64_t>(raw) - reference_raw_;
+        if (diff < 0) {
+            diff = -diff;
+        }
+        if (diff >= static_cast<int64_t>(policy_.flush_delta)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RawSampleBatch::isFlushDue(uint32_t now_ms) const {
+    if (count_ == 0) {
+        return false;
+    }
+    if (count_ >= capacity_) {
+        return true;
+    }
+    return getMsUntilFlush(now_ms) == 0;
+}
+
+uint32_t RawSampleBatch::getMsUntilFlush(uint32_t now_ms) const {
+    if (count_ == 0 || policy_.flush_interval_ms == 0) {
+        return UINT32_MAX;
+    }
+    uint32_t age = now_ms - ring_[head_].timestamp_ms;
+    return age >= policy_.flush_interval_ms ? 0 : policy_.flush_interval_ms - age;
+}
+
+const RawSample& RawSampleBatch::at(uint8_t index) const {
+    return ring_[(head_ + index) % capacity_];
+}
+
+void RawSampleBatch::clear() {
+    if (count_ > 0) {
+        reference_raw_ = at(count_ - 1).raw;
+        has_reference_ = true;
+    }
+    head_ = 0;
+    count_ = 0;
+}
+
+// ============================================
+// ENCODING
+// ============================================
+size_t RawSampleBatch::encode(char* out, size_t out_len, uint32_t base_ts) const {
+    if (count_ == 0 || out == nullptr || out_len == 0) {
+        return 0;
+    }
+
+    size_t pos = 0;
+    bool overflow = false;
+    auto advance = [&](int written) {
+        if (written < 0 || static_cast<size_t>(written) >= out_len - pos) {
+            overflow = true;
+            return;
+        }
+        pos += static_cast<size_t>(written);
+    };
+    auto appendText = [&](const char* text) {
+        if (!overflow) advance(snprintf(out + pos, out_len - pos, "%s", text));
+    };
+    auto appendSigned = [&](const char* fmt, long value) {
+        if (!overflow) advance(snprintf(out + pos, out_len - pos, fmt, value));
+    };
+    auto appendUnsigned = [&](const char* fmt, unsigned long value) {
+        if (!overflow) advance(snprintf(out + pos, out_len - pos, fmt, value));
+    };
+
+    appendUnsigned("\"n\":%lu", count_);
+    appendUnsigned(",\"base_ts\":%lu", base_ts);
+    appendSigned(",\"raw0\":%ld", static_cast<long>(at(0).raw));
+
+    appendText(",\"d\":[");
+    for (uint8_t i = 1; i < count_; i++) {
+        appendSigned(i == 1 ? "%ld" : ",%ld", static_cast<long>(at(i).raw - at(i - 1).raw));
+    }
+    appendText("]");
+
+    // Equal spacing (the normal case) collapses to one number
+    bool uniform = true;
+    uint32_t first_gap = count_ > 1 ? at(1).timestamp_ms - at(0).timestamp_ms : 0;
+    for (uint8_t i = 2; i < count_; i++) {
+        if (at(i).timestamp_ms - at(i - 1).timestamp_ms != first_gap) {
+            uniform = false;
+            break;
+        }
+    }
+    if (uniform) {
+        appendUnsigned(",\"dt\":%lu", first_gap);
+    } else {
+        appendText(",\"dt\":[");
+        for (uint8_t i = 1; i < count_; i++) {
+            appendUnsigned(i == 1 ? "%lu" : ",%lu", at(i).timestamp_ms - at(i - 1).timestamp_ms);
+        }
+        appendText("]");
+    }
+
+    return overflow ? 0 : pos;
+}
+
+static const char* findKey(const char* frame, const char* key) {
+    const char* p = strstr(frame, key);
+    return p != nullptr ? p + strlen(key) : nullptr;
+}
+
+bool RawSampleBatch::decode(const char* frame, uint32_t& base_ts,
+                            RawSample* out, uint8_t max_samples, uint8_t& count_out) {
+    count_out = 0;
+    if (frame == nullptr || out == nullptr) {
+        return false;
+    }
+
+    const char* p_n = findKey(frame, "\"n\":");
+    const char* p_ts = findKey(frame, "\"base_ts\":");
+    const char* p_raw0 = findKey(frame, "\"raw0\":");
+    const char* p_d = findKey(frame, "\"d\":[");
+    const char* p_dt = findKey(frame, "\"dt\":");
+    if (!p_n || !p_ts || !p_raw0 || !p_d || !p_dt) {
+        return false;
+    }
+
+    long n = strtol(p_n, nullptr, 10);
+    if (n <= 0 || n > max_samples) {
+        return false;
+    }
+    base_ts = static_cast<uint32_t>(strtoul(p_ts, nullptr, 10));
+
+    out[0].raw = static_cast<int32_t>(strtol(p_raw0, nullptr, 10));
+    out[0].timestamp_ms = 0;
+
+    const char* p = p_d;
+    for (long i = 1; i < n; i++) {
+        char* end = nullptr;
+        long delta = strtol(p, &end, 10);
+        if (end == p) {
+            return false;
+        }
+        out[i].raw = out[i - 1].raw + static_cast<int32_t>(delta);
+        p = (*end == ',') ? end + 1 : end;
+    }
+
+    bool uniform = (*p_dt != '[');
+    p = uniform ? p_dt : p_dt + 1;
+    uint32_t gap = uniform ? static_cast<uint32_t>(strtoul(p, nullptr, 10)) : 0;
+    for (long i = 1; i < n; i++) {
+        if (!uniform) {
+            char* end = nullptr;
+            gap = static_cast<uint32_t>(strtoul(p, &end, 10));
+            if (end == p) {
+                return false;
+            }
+            p = (*end == ',') ? end + 1 : end;
+        }
+        out[i].timestamp_ms = out[i - 1].timestamp_ms + gap;
+    }
+
+    count_out = static_cast<uint8_t>(n);
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef SERVICES_SENSOR_RAW_SAMPLE_BATCH_H
+#define SERVICES_SENSOR_RAW_SAMPLE_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================
+// RAW SAMPLE BATCH (Server-Centric High-Rate Raw Mode)
+// ============================================
+// High-rate raw acquisition (e.g. pH/EC at 1 Hz for server-side processing)
+// would cost one MQTT publish per sample. Sensors with a batch policy collect
+// raw samples in a fixed per-stream ring and ship them as one compact frame
+// on sensor/batch:
+//
+//   "n":5,"base_ts":1718000000,"raw0":1801,"d":[-6,17,-22,16],"dt":1000
+//
+//   raw0   first raw value (signed, DS18B20 raw is int16)
+//   d      raw deltas to the previous sample (n-1 entries)
+//   dt     sample spacing in ms — a single number when all gaps are equal,
+//          otherwise an array of n-1 gaps
+//   base_ts Unix timestamp (s) of the first sample
+//
+// Flush triggers: max_samples reached, flush_interval_ms elapsed since the
+// first buffered sample, or |raw - last flushed raw| >= flush_delta
+// (threshold crossing → immediate). If a flush fails (MQTT offline) the
+// ring keeps the newest samples and counts overwritten ones as dropped.
+//
+// No Arduino dependencies — encode/decode round trip is unit-tested on native.
+// ============================================
+
+static const uint8_t RAW_BATCH_MAX_SAMPLES = 32;
+
+struct RawBatchPolicy {
+    uint8_t max_samples;          // 0/1 = batching off (per-sample publish)
+    uint32_t flush_interval_ms;   // 0 = size/threshold only
+    uint32_t flush_delta;         // Raw counts, 0 = no threshold flush
+};
+
+struct RawSample {
+    int32_t raw;
+    uint32_t timestamp_ms;  // millis() on the device; decode() yields offsets from sample 0
+};
+
+class RawSampleBatch {
+public:
+    RawSampleBatch();
+
+    void configure(const RawBatchPolicy& policy);
+    const RawBatchPolicy& getPolicy() const { return policy_; }
+    bool isEnabled() const { return policy_.max_samples > 1; }
+
+    // Returns true if the batch must be flushed now (size reached or threshold crossed).
+    bool add(int32_t raw, uint32_t timestamp_ms);
+    bool isFlushDue(uint32_t now_ms) const;
+    // UINT32_MAX if nothing is buffered or no interval configured
+    uint32_t getMsUntilFlush(uint32_t now_ms) const;
+
+    uint8_t count() const { return count_; }
+    // Chronological access (0 = oldest)
+    const RawSample& at(uint8_t index) const;
+    // Called after a successful publish — the last sample becomes the threshold reference
+    void clear();
+    void reset();
+    uint32_t getDroppedCount() const { return dropped_; }
+
+    // Writes the frame fragment (no surrounding braces). Returns the length,
+    // 0 if the batch is empty or the buffer is too small.
+    size_t encode(char* out, size_t out_len, uint32_t base_ts) const;
+
+    // Parses a fragment written by encode(). timestamp_ms of the decoded
+    // samples is relative to the first sample.
+    static bool decode(const char* frame, uint32_t& base_ts,
+                       RawSample* out, uint8_t max_samples, uint8_t& count_out);
+
+private:
+    RawBatchPolicy policy_;
+    RawSample ring_[RAW_BATCH_MAX_SAMPLES];
+    uint8_t capacity_;
+    uint8_t head_;   // Index of the oldest sample
+    uint8_t count_;
+    int32_t reference_raw_;
+    bool has_reference_;
+    uint32_t dropped_;
+};
+
+#endif  // SERVICES_SENSOR_RAW_SAMPLE_BATCH_H
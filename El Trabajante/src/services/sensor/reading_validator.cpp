@@ -0,0 +1,217 @@
+#include "reading_validator.h"
+
+#include <math.h>
+#include <string.h>
+
+// Scale factor: MAD → standard deviation for normally distributed noise
+static const float MAD_TO_SIGMA = 1.4826f;
+
+// ============================================
+// CONSTRUCTION / CONFIGURATION
+// ============================================
+ReadingValidator::ReadingValidator() {
+    memset(&config_, 0, sizeof(config_));
+    reset();
+}
+
+void ReadingValidator::configure(const ReadingValidatorConfig& config) {
+    config_ = config;
+    if (config_.min_samples > WINDOW_SIZE) {
+        config_.min_samples = WINDOW_SIZE;
+    }
+    reset();
+}
+
+void ReadingValidator::reset() {
+    memset(window_, 0, sizeof(window_));
+    count_ = 0;
+    head_ = 0;
+    last_value_ = 0.0f;
+    last_timestamp_ms_ = 0;
+    has_last_ = false;
+    last_raw_ = 0;
+    stuck_run_ = 0;
+    has_last_raw_ = false;
+    consecutive_rejects_ = 0;
+    accepted_count_ = 0;
+    rejected_count_ = 0;
+}
+
+ReadingValidatorConfig ReadingValidator::configForSensorType(const char* server_sensor_type) {
+    ReadingValidatorConfig config;
+    config.enabled = false;
+    config.max_rate_per_s = 0.0f;
+    config.hampel_k = 3.0f;
+    config.min_deviation = 0.0f;
+    config.min_samples = 3;
+    config.max_consecutive_rejects = 3;
+    config.stuck_limit = 0;
+
+    if (server_sensor_type == nullptr) {
+        return config;
+    }
+    const char* type = server_sensor_type;
+
+    // Temperatures (°C): greenhouse air/water changes well below 0.5 °C/s.
+    // Catches DS18B20 85 °C power-on values and I2C glitches mid-stream.
+    if (strstr(type, "temp") != nullptr || strcmp(type, "ds18b20") == 0) {
+        config.enabled = true;
+        config.max_rate_per_s = 0.5f;
+        config.min_deviation = 0.5f;
+        // 12-bit DS18B20 raw is often constant in stable water — only flag after ~1 h @ 30 s
+        config.stuck_limit = (strcmp(type, "ds18b20") == 0) ? 120 : 20;
+        return config;
+    }
+    // Relative humidity (%)
+    if (strstr(type, "humidity") != nullptr) {
+        config.enabled = true;
+        config.max_rate_per_s = 2.0f;
+        config.min_deviation = 2.0f;
+        config.stuck_limit = 20;
+        return config;
+    }
+    // Barometric pressure (hPa)
+    if (strstr(type, "pressure") != nullptr) {
+        config.enabled = true;
+        config.max_rate_per_s = 1.0f;
+        config.min_deviation = 1.0f;
+        config.stuck_limit = 20;
+        return config;
+    }
+    // Analog raw ADC (pH, EC, moisture): units are ADC counts, no rate limit —
+    // dosing and irrigation cause legitimate fast steps (handled by re-seeding).
+    if (strstr(type, "ph") != nullptr || strstr(type, "ec") != nullptr ||
+        strstr(type, "moisture") != nullptr) {
+        config.enabled = true;
+        config.min_deviation = 60.0f;
+        config.stuck_limit = 20;
+        return config;
+    }
+    return config;
+}
+
+const char* ReadingValidator::getRejectReasonString(ReadingRejectReason reason) {
+    switch (reason) {
+        case ReadingRejectReason::OUTLIER: return "outlier";
+        case ReadingRejectReason::RATE_OF_CHANGE: return "rate_of_change";
+        default: return "none";
+    }
+}
+
+// ============================================
+// WINDOW HELPERS
+// ============================================
+void ReadingValidator::pushSample(float value) {
+    window_[head_] = value;
+    head_ = static_cast<uint8_t>((head_ + 1) % WINDOW_SIZE);
+    if (count_ < WINDOW_SIZE) {
+        count_++;
+    }
+}
+
+static void insertionSort(float* values, uint8_t n) {
+    for (uint8_t i = 1; i < n; i++) {
+        float key = values[i];
+        int8_t j = static_cast<int8_t>(i - 1);
+        while (j >= 0 && values[j] > key) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = key;
+    }
+}
+
+static float sortedMedian(const float* sorted, uint8_t n) {
+    if ((n & 1) != 0) {
+        return sorted[n / 2];
+    }
+    return 0.5f * (sorted[n / 2 - 1] + sorted[n / 2]);
+}
+
+float ReadingValidator::windowMedian(float* scratch) const {
+    memcpy(scratch, window_, count_ * sizeof(float));
+    insertionSort(scratch, count_);
+    return sortedMedian(scratch, count_);
+}
+
+// ============================================
+// VALIDATION
+// ============================================
+ReadingVerdict ReadingValidator::validate(float value, uint32_t raw_value, uint32_t timestamp_ms) {
+    ReadingVerdict verdict;
+    verdict.grade = ReadingGrade::GOOD;
+    verdict.reason = ReadingRejectReason::NONE;
+    verdict.stuck = false;
+
+    if (!config_.enabled) {
+        accepted_count_++;
+        return verdict;
+    }
+
+    // Stuck detection runs on the raw value (processed values hide resolution)
+    if (has_last_raw_ && raw_value == last_raw_) {
+        if (stuck_run_ < UINT16_MAX) {
+            stuck_run_++;
+        }
+    } else {
+        stuck_run_ = 0;
+    }
+    last_raw_ = raw_value;
+    has_last_raw_ = true;
+    verdict.stuck = config_.stuck_limit > 0 && (uint32_t)stuck_run_ + 1 >= config_.stuck_limit;
+
+    if (isnan(value) || isinf(value)) {
+        verdict.reason = ReadingRejectReason::OUTLIER;
+    }
+
+    // 1. Rate of change against the last accepted value
+    if (verdict.reason == ReadingRejectReason::NONE && has_last_ && config_.max_rate_per_s > 0.0f) {
+        uint32_t dt_ms = timestamp_ms - last_timestamp_ms_;
+        float dt_s = (dt_ms == 0) ? 0.001f : static_cast<float>(dt_ms) / 1000.0f;
+        if (fabsf(value - last_value_) / dt_s > config_.max_rate_per_s) {
+            verdict.reason = ReadingRejectReason::RATE_OF_CHANGE;
+        }
+    }
+
+    // 2. Hampel filter over accepted history
+    if (verdict.reason == ReadingRejectReason::NONE && count_ >= config_.min_samples && count_ > 0) {
+        float scratch[WINDOW_SIZE];
+        float median = windowMedian(scratch);
+        for (uint8_t i = 0; i < count_; i++) {
+            scratch[i] = fabsf(window_[i] - median);
+        }
+        insertionSort(scratch, count_);
+        float mad = sortedMedian(scratch, count_);
+        float threshold = config_.hampel_k * MAD_TO_SIGMA * mad;
+        if (threshold < config_.min_deviation) {
+            threshold = config_.min_deviation;
+        }
+        if (fabsf(value - median) > threshold) {
+            verdict.reason = ReadingRejectReason::OUTLIER;
+        }
+    }
+
+    if (verdict.reason != ReadingRejectReason::NONE) {
+        consecutive_rejects_++;
+        bool invalid_number = isnan(value) || isinf(value);
+        if (invalid_number || consecutive_rejects_ < config_.max_consecutive_rejects) {
+            verdict.grade = ReadingGrade::REJECTED;
+            rejected_count_++;
+            return verdict;
+        }
+        // Persistent level shift: accept and restart history around the new level
+        count_ = 0;
+        head_ = 0;
+        verdict.grade = ReadingGrade::SUSPECT;
+    } else if (verdict.stuck) {
+        verdict.grade = ReadingGrade::SUSPECT;
+    }
+
+    consecutive_rejects_ = 0;
+    pushSample(value);
+    last_value_ = value;
+    last_timestamp_ms_ = timestamp_ms;
+    has_last_ = true;
+    accepted_count_++;
+    return verdict;
+}
@@ -0,0 +1,95 @@
+#ifndef SERVICES_SENSOR_READING_VALIDATOR_H
+#define SERVICES_SENSOR_READING_VALIDATOR_H
+
+#include <stdint.h>
+
+// ============================================
+// READING VALIDATOR (Streaming Quality Pipeline)
+// ============================================
+// Per-sensor-stream validator applied before a reading is published or
+// written to the offline value cache:
+//   1. Rate-of-change limit against the last accepted value (units per second)
+//   2. Hampel filter: |x - median| > k * 1.4826 * MAD over the last WINDOW_SIZE
+//      accepted samples (floored by min_deviation, so a flat window does not
+//      reject sensor noise)
+//   3. Stuck-value detection: identical raw value for stuck_limit samples → SUSPECT
+//
+// A real level shift is rejected at most max_consecutive_rejects - 1 times; the
+// next sample is accepted as SUSPECT and restarts the window.
+//
+// Fixed memory, O(1) per sample (median/MAD over a constant 7-sample window).
+// No Arduino dependencies — unit-tested on native with recorded traces.
+// ============================================
+
+enum class ReadingGrade : uint8_t {
+    GOOD = 0,
+    SUSPECT,   // Accepted, but stuck or re-seeded after a level shift
+    REJECTED   // Not published; counts as a circuit-breaker failure
+};
+
+enum class ReadingRejectReason : uint8_t {
+    NONE = 0,
+    OUTLIER,         // Hampel / MAD test
+    RATE_OF_CHANGE   // |Δvalue| / Δt above max_rate_per_s
+};
+
+struct ReadingValidatorConfig {
+    bool enabled;
+    float max_rate_per_s;             // 0 = no rate limit
+    float hampel_k;                   // Typical 3.0
+    float min_deviation;              // Absolute floor for the Hampel threshold (sensor units)
+    uint8_t min_samples;              // Hampel inactive until the window holds this many samples
+    uint8_t max_consecutive_rejects;  // Accept (SUSPECT) after this many rejections in a row
+    uint16_t stuck_limit;             // Identical raw values in a row → SUSPECT (0 = off)
+};
+
+struct ReadingVerdict {
+    ReadingGrade grade;
+    ReadingRejectReason reason;
+    bool stuck;
+};
+
+class ReadingValidator {
+public:
+    static const uint8_t WINDOW_SIZE = 7;
+
+    ReadingValidator();
+
+    void configure(const ReadingValidatorConfig& config);
+    void reset();
+
+    ReadingVerdict validate(float value, uint32_t raw_value, uint32_t timestamp_ms);
+
+    const ReadingValidatorConfig& getConfig() const { return config_; }
+    uint32_t getAcceptedCount() const { return accepted_count_; }
+    uint32_t getRejectedCount() const { return rejected_count_; }
+    uint8_t getWindowCount() const { return count_; }
+
+    // Defaults per normalized server sensor type (see getServerSensorType()).
+    // Unknown/digital/counter types are returned disabled.
+    static ReadingValidatorConfig configForSensorType(const char* server_sensor_type);
+    static const char* getRejectReasonString(ReadingRejectReason reason);
+
+private:
+    void pushSample(float value);
+    float windowMedian(float* scratch) const;
+
+    ReadingValidatorConfig config_;
+    float window_[WINDOW_SIZE];
+    uint8_t count_;
+    uint8_t head_;
+
+    float last_value_;
+    uint32_t last_timestamp_ms_;
+    bool has_last_;
+
+    uint32_t last_raw_;
+    uint16_t stuck_run_;
+    bool has_last_raw_;
+
+    uint8_t consecutive_rejects_;
+    uint32_t accepted_count_;
+    uint32_t rejected_count_;
+};
+
+#endif  // SERVICES_SENSOR_READING_VALIDATOR_H
@@ -3,6 +3,11 @@
 #include "../communication/mqtt_client.h"
 #include "../config/config_manager.h"
 #include "../../drivers/gpio_manager.h"
+#include "../../drivers/adc_sampler.h"
+#include "../../drivers/pulse_counter.h"
+#include "../../drivers/digital_input.h"
+#include "../../drivers/sensor_excitation.h"
+#include "temperature_compensation.h"
 #include <cmath>   // NAN, isnan — used by SAFETY-P4 value cache
 #include <cstring> // memset, strncmp, strncpy — used by value cache
 #include <WiFi.h>  // For ADC2/WiFi conflict detection
@@ -88,6 +93,15 @@ static uint32_t getAndIncrementDs18b20ReadingCount(uint8_t gpio, const String& o
 static constexpr uint8_t  CB_MAX_CONSECUTIVE_FAILURES = 10;
 static constexpr uint32_t CB_PROBE_INTERVAL_MS = 300000;  // 5 minutes
 
+// ============================================
+// SENSOR EXCITATION CONSTANTS
+// ============================================
+// Settled probe on the DMA scan: re-check for the first window closed after
+// ready_at (windows are ~150 ms, the task must not spin on a 0 ms wait)
+static constexpr uint32_t EXCITATION_WINDOW_POLL_MS = 10;
+// Manual read parked for settle + window: give up if the scan stalled
+static constexpr uint32_t EXCITATION_MAX_WAIT_MS = SENSOR_EXCITATION_MAX_SETTLE_MS + ADC_SAMPLER_MAX_WINDOW_AGE_MS;
+
 // ============================================
 // LOCAL PREVIEW CONVERSION (Direct MQTT Flow)
 // ============================================
@@ -110,7 +124,7 @@ static LocalConversion applyLocalConversion(const String& sensor_type, uint32_t
     if (sensor_type == "sht31_humidity") {
         return { 100.0f * ((float)raw_value / 65535.0f), "%", true };
     }
-    // DS18B20 Temperature: T(°C) = raw × 0.0625 (12-bit resolution)
+    // DS18B20 Temperature: T(°C) = raw × 0.0625 (1/16 °C units at every resolution)
     if (sensor_type == "ds18b20") {
         return { (float)((int32_t)raw_value) * 0.0625f, "°C", true };
     }
@@ -147,9 +161,12 @@ SensorManager::SensorManager()
       gpio_manager_(nullptr),
       last_measurement_time_(0),
       measurement_interval_(30000),  // 30s default interval
+      measurement_cursor_(0),
+      measurement_deferred_(false),
       value_cache_count_(0) {
     // Zero-initialize value cache
     memset(value_cache_, 0, sizeof(value_cache_));
+    memset(i2c_bindings_, 0, sizeof(i2c_bindings_));
 }
 
 SensorManager::~SensorManager() {
@@ -327,6 +344,7 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
                         }
                         LOG_I(TAG, "Sensor Manager: Updated existing multi-value sensor '" +
                                    config.sensor_type + "' on GPIO " + String(config.gpio));
+                        refreshI2CDevice(effective_i2c_address);
                         xSemaphoreGive(g_sensor_mutex);
                         return true;
                     }
@@ -353,6 +371,7 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
                 LOG_I(TAG, "Sensor Manager: Added multi-value sensor '" + config.sensor_type +
                          "' on GPIO " + String(config.gpio) + " (I2C 0x" +
                          String(effective_i2c_address, HEX) + ")");
+                refreshI2CDevice(effective_i2c_address);
                 xSemaphoreGive(g_sensor_mutex);
                 return true;
             }
@@ -375,9 +394,57 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
                        ": Circuit Breaker reset by config push");
         }
 
+        // Pulse counter follows the type: attach on change to flow/rain, release otherwise
+        // (same type keeps the unit and its running total)
+        bool wants_pulse = capability != nullptr && capability->is_pulse_counter;
+        if (wants_pulse && !pulseCounter.isAttached(config.gpio)) {
+            if (!pulseCounter.attach(config.gpio, config.pulse_filter_ns, millis())) {
+                errorTracker.trackError(ERROR_SENSOR_INIT_FAILED, ERROR_SEVERITY_ERROR,
+                                       "No pulse counter unit for sensor");
+                xSemaphoreGive(g_sensor_mutex);
+                return false;
+            }
+            adcSampler.removeChannel(config.gpio);
+        } else if (!wants_pulse && pulseCounter.isAttached(config.gpio)) {
+            pulseCounter.detach(config.gpio);
+        }
+
+        // Digital input: re-attach applies new debounce / polarity, state is kept
+        bool wants_digital = capability != nullptr && capability->is_digital_input;
+        if (wants_digital) {
+            gpio_manager_->configurePinMode(config.gpio, config.input_active_low ? INPUT_PULLUP : INPUT_PULLDOWN);
+            if (!digitalInputs.attach(config.gpio, config.debounce_ms)) {
+                errorTracker.trackError(ERROR_SENSOR_INIT_FAILED, ERROR_SEVERITY_ERROR,
+                                       "No digital input channel for sensor");
+                xSemaphoreGive(g_sensor_mutex);
+                return false;
+            }
+            adcSampler.removeChannel(config.gpio);
+        } else if (digitalInputs.isAttached(config.gpio)) {
+            digitalInputs.detach(config.gpio);
+        }
+
+        // Excitation pin: added, moved, retimed or removed with the config
+        if (!applyExcitation(config, capability)) {
+            errorTracker.trackError(ERROR_GPIO_CONFLICT, ERROR_SEVERITY_ERROR,
+                                   "Excitation GPIO not available for sensor");
+            xSemaphoreGive(g_sensor_mutex);
+            return false;
+        }
+
         // Update configuration
         *existing = config;
         existing->active = true;
+        if (existing->onewire_address.length() == 16 && onewire_bus_ &&
+            onewire_bus_->isInitialized(config.gpio)) {
+            uint8_t rom[8];
+            if (OneWireUtils::hexStringToRom(existing->onewire_address, rom)) {
+                existing->onewire_resolution =
+                    applyOneWireResolution(config.gpio, rom, config.onewire_resolution);
+            }
+        }
+        resetReadingValidators(config.gpio);
+        releaseRawBatches(config.gpio);
         // F7: Explicit CB reset (config push = fresh start)
         existing->cb_state = SensorCBState::CLOSED;
         existing->consecutive_failures = 0;
@@ -391,6 +458,9 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
 
         LOG_I(TAG, "Sensor Manager: Updated sensor on GPIO " + String(config.gpio) +
                  " (" + config.sensor_type + ")");
+        if (is_i2c_sensor) {
+            refreshI2CDevice(effective_i2c_address);
+        }
         xSemaphoreGive(g_sensor_mutex);
         return true;
     }
@@ -499,6 +569,9 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
                  " (GPIO " + String(config.gpio) + " is I2C bus)" +
                  " [sensor_count=" + String(sensor_count_) + ", active=true]");
 
+        // Resolve protocol binding; SHT3x: periodic acquisition instead of single shot
+        refreshI2CDevice(effective_i2c_address);
+
         xSemaphoreGive(g_sensor_mutex);
         return true;
     }
@@ -517,6 +590,7 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
     lower_sensor_type.toLowerCase();
     bool is_onewire = (capability && !capability->is_i2c &&
                        lower_sensor_type.indexOf("ds18b20") >= 0);
+    uint8_t onewire_resolution = config.onewire_resolution;
     
     if (is_onewire) {
         LOG_D(TAG, "SensorManager: OneWire sensor detected: " + config.sensor_type);
@@ -589,22 +663,12 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
             return false;
         }
         
-        // 4. Single-Bus Check (architecture allows only one OneWire bus)
-        if (onewire_bus_->isInitialized()) {
-            uint8_t current_pin = onewire_bus_->getPin();
-            if (current_pin != config.gpio) {
-                LOG_E(TAG, "SensorManager: OneWire bus already active on GPIO " +
-                         String(current_pin) + ", cannot use GPIO " + String(config.gpio) +
-                         " (single-bus architecture)");
-                errorTracker.trackError(ERROR_ONEWIRE_INIT_FAILED, ERROR_SEVERITY_ERROR,
-                                       "Single-bus conflict");
-                xSemaphoreGive(g_sensor_mutex);
-                return false;
-            }
+        // 4. Bus per pin (several OneWire pins may be active concurrently)
+        if (onewire_bus_->isInitialized(config.gpio)) {
             LOG_D(TAG, "SensorManager: OneWire bus already initialized on GPIO " + 
-                     String(current_pin));
+                     String(config.gpio));
         } else {
-            // First OneWire sensor → Initialize bus
+            // First OneWire sensor on this pin → Initialize bus
             if (!onewire_bus_->begin(config.gpio)) {
                 LOG_E(TAG, "SensorManager: Failed to initialize OneWire bus on GPIO " +
                          String(config.gpio));
@@ -617,7 +681,7 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
         }
         
         // 5. Verify device presence on bus
-        if (!onewire_bus_->isDevicePresent(rom)) {
+        if (!onewire_bus_->isDevicePresent(config.gpio, rom)) {
             LOG_E(TAG, "SensorManager: OneWire device " + config.onewire_address +
                      " not found on bus (GPIO " + String(config.gpio) + ")");
             errorTracker.trackError(ERROR_ONEWIRE_NO_DEVICES, ERROR_SEVERITY_ERROR,
@@ -629,6 +693,9 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
         LOG_I(TAG, "SensorManager: OneWire device " + config.onewire_address + 
                 " verified on GPIO " + String(config.gpio) + 
                 " (type: " + OneWireUtils::getDeviceType(rom) + ")");
+
+        // 6. Resolution → scratchpad + EEPROM (only written if it differs)
+        onewire_resolution = applyOneWireResolution(config.gpio, rom, config.onewire_resolution);
                 
         // Skip standard GPIO reservation (already handled above)
     } else {
@@ -652,11 +719,44 @@ bool SensorManager::configureSensor(const SensorConfig& config) {
             xSemaphoreGive(g_sensor_mutex);
             return false;
         }
+
+        if (capability != nullptr && capability->is_pulse_counter) {
+            // Flow meter / rain gauge: PCNT unit counts edges in hardware
+            if (!pulseCounter.attach(config.gpio, config.pulse_filter_ns, millis())) {
+                gpio_manager_->releasePin(config.gpio);
+                errorTracker.trackError(ERROR_SENSOR_INIT_FAILED, ERROR_SEVERITY_ERROR,
+                                       "No pulse counter unit for sensor");
+                xSemaphoreGive(g_sensor_mutex);
+                return false;
+            }
+        } else if (capability != nullptr && capability->is_digital_input) {
+            // Float switch / contact: pull towards the inactive level, edge interrupt + debounce
+            gpio_manager_->configurePinMode(config.gpio, config.input_active_low ? INPUT_PULLUP : INPUT_PULLDOWN);
+            if (!digitalInputs.attach(config.gpio, config.debounce_ms)) {
+                gpio_manager_->releasePin(config.gpio);
+                errorTracker.trackError(ERROR_SENSOR_INIT_FAILED, ERROR_SEVERITY_ERROR,
+                                       "No digital input channel for sensor");
+                xSemaphoreGive(g_sensor_mutex);
+                return false;
+            }
+        } else {
+            // ADC1 pins join the continuous DMA scan (ADC2 / unsupported pins stay on analogRead)
+            adcSampler.addChannel(config.gpio);
+            if (!applyExcitation(config, capability)) {
+                adcSampler.removeChannel(config.gpio);
+                gpio_manager_->releasePin(config.gpio);
+                errorTracker.trackError(ERROR_GPIO_CONFLICT, ERROR_SEVERITY_ERROR,
+                                       "Excitation GPIO not available for sensor");
+                xSemaphoreGive(g_sensor_mutex);
+                return false;
+            }
+        }
     }
 
     // Add sensor
     sensors_[sensor_count_] = config;
     sensors_[sensor_count_].active = true;
+    sensors_[sensor_count_].onewire_resolution = onewire_resolution;
     sensor_count_++;
 
     // Phase 7: Persist to NVS immediately
@@ -696,6 +796,9 @@ bool SensorManager::removeSensor(uint8_t gpio, const String& onewire_address,
 
     // Capture sensor_type before array shift invalidates the pointer
     String removed_sensor_type = config->sensor_type;
+    uint8_t removed_i2c_address = config->i2c_address;
+    resetReadingValidators(gpio);
+    releaseRawBatches(gpio);
 
     // For non-I2C sensors: Only release GPIO if no other sensor remains on this GPIO
     if (!is_i2c_sensor) {
@@ -708,6 +811,10 @@ bool SensorManager::removeSensor(uint8_t gpio, const String& onewire_address,
             }
         }
         if (!other_on_gpio) {
+            adcSampler.removeChannel(gpio);
+            pulseCounter.detach(gpio);
+            digitalInputs.detach(gpio);
+            sensorExcitation.detach(gpio);
             gpio_manager_->releasePin(gpio);
             LOG_I(TAG, "  ✅ GPIO " + String(gpio) + " released (last sensor on pin)");
         } else {
@@ -731,6 +838,10 @@ bool SensorManager::removeSensor(uint8_t gpio, const String& onewire_address,
         }
     }
 
+    if (is_i2c_sensor) {
+        refreshI2CDevice(removed_i2c_address);  // Other value types may keep it bound / armed
+    }
+
     // Phase 7: Persist removal to NVS immediately
     if (!configManager.removeSensorConfig(gpio, onewire_address, removed_sensor_type)) {
         LOG_E(TAG, "Sensor Manager: Failed to remove sensor config from NVS");
@@ -778,6 +889,58 @@ uint8_t SensorManager::getActiveSensorCount() const {
     return count;
 }
 
+uint32_t SensorManager::getMsUntilNextMeasurement(unsigned long now) const {
+    if (!initialized_) {
+        return UINT32_MAX;
+    }
+    // Mirrors the schedule checks in performAllMeasurements() (same task, Core 1)
+    uint32_t next_due = UINT32_MAX;
+    for (uint8_t i = 0; i < sensor_count_; i++) {
+        const SensorConfig& sensor = sensors_[i];
+        if (!sensor.active) {
+            continue;
+        }
+        const String& mode = sensor.operating_mode;
+        if (mode == "paused" || mode == "on_demand" || mode == "scheduled") {
+            continue;
+        }
+        uint32_t remaining;
+        if (sensor.cb_state == SensorCBState::OPEN) {
+            uint32_t elapsed = now - sensor.cb_open_since_ms;
+            remaining = elapsed >= CB_PROBE_INTERVAL_MS ? 0 : CB_PROBE_INTERVAL_MS - elapsed;
+        } else {
+            uint32_t interval = sensor.measurement_interval_ms;
+            if (interval == 0) {
+                interval = measurement_interval_;
+            }
+            uint32_t elapsed = now - sensor.last_reading;
+            remaining = elapsed >= interval ? 0 : interval - elapsed;
+        }
+        if (remaining == 0) {
+            // Due but the probe is settling: wake when it can be read
+            uint32_t settle_ms = sensorExcitation.getMsUntilReady(sensor.gpio, static_cast<uint32_t>(now));
+            if (settle_ms != UINT32_MAX) {
+                bool on_scan = adcSampler.isActive() && adcSampler.supportsPin(sensor.gpio);
+                remaining = settle_ms > 0 ? settle_ms : (on_scan ? EXCITATION_WINDOW_POLL_MS : 0);
+            }
+        }
+        if (remaining < next_due) {
+            next_due = remaining;
+        }
+    }
+    // Pending raw batches must be flushed on time even between measurements
+    for (uint8_t i = 0; i < MAX_RAW_BATCH_STREAMS; i++) {
+        if (!raw_batches_[i].in_use) {
+            continue;
+        }
+        uint32_t remaining = raw_batches_[i].batch.getMsUntilFlush(static_cast<uint32_t>(now));
+        if (remaining < next_due) {
+            next_due = remaining;
+        }
+    }
+    return next_due;
+}
+
 uint8_t SensorManager::countSensorsWithSubzone(const String& subzone_id) const {
     if (!initialized_ || subzone_id.length() == 0) {
         return 0;
@@ -813,13 +976,40 @@ bool SensorManager::performMeasurement(uint8_t gpio, SensorReading& reading_out)
 // Used by performAllMeasurements() which iterates sensors_[] directly
 bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorReading& reading_out) {
     uint8_t gpio = config->gpio;
+    measurement_deferred_ = false;
 
     // Read raw value based on sensor type (using registry for dynamic detection)
     uint32_t raw_value = 0;
     
     // Get sensor capability from registry
     const SensorCapability* capability = findSensorCapability(config->sensor_type);
-    
+
+    if (capability && capability->is_pulse_counter) {
+        return performPulseMeasurement(config, capability, reading_out);
+    }
+    if (capability && capability->is_digital_input) {
+        // Periodic refresh of the debounced state (changes are published by processDigitalInputs)
+        bool level = false;
+        if (!digitalInputs.getState(gpio, level)) {
+            reading_out.valid = false;
+            reading_out.error_message = "Digital input not attached";
+            LOG_E(TAG, "SensorManager: No digital input on GPIO " + String(gpio));
+            return false;
+        }
+        fillDigitalInputReading(config, capability, level, reading_out);
+        config->last_raw_value = reading_out.raw_value;
+        return true;
+    }
+
+    // Switched probe supply: callers power the probe ahead and read it once
+    // settled (scheduler: prepareExcitation() == 0, manual: retry_after_ms)
+    if (prepareExcitation(gpio, millis()) > 0) {
+        measurement_deferred_ = true;
+        reading_out.valid = false;
+        reading_out.error_message = "Probe settling";
+        return false;
+    }
+
     if (capability) {
         // Known sensor type - use capability information
         if (capability->is_i2c) {
@@ -878,7 +1068,7 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
                 }
                 
                 // 3. Check OneWire bus status
-                if (!onewire_bus_ || !onewire_bus_->isInitialized()) {
+                if (!onewire_bus_ || !onewire_bus_->isInitialized(gpio)) {
                     reading_out.valid = false;
                     reading_out.error_message = "OneWire bus not initialized";
                     LOG_E(TAG, "SensorManager: OneWire bus not ready for measurement");
@@ -894,7 +1084,7 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
                 const uint16_t RETRY_DELAY_MS = 100;
                 
                 for (uint8_t retry = 0; retry < MAX_RETRIES; retry++) {
-                    if (readRawOneWire(gpio, rom, raw_temp)) {
+                    if (readRawOneWire(gpio, rom, raw_temp, config->onewire_resolution)) {
                         read_success = true;
                         if (retry > 0) {
                             LOG_I(TAG, "SensorManager: OneWire read succeeded on attempt " + 
@@ -961,7 +1151,7 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
 
                     // Retry the read
                     int16_t retry_raw = 0;
-                    if (readRawOneWire(gpio, rom, retry_raw)) {
+                    if (readRawOneWire(gpio, rom, retry_raw, config->onewire_resolution)) {
                         if (retry_raw == DS18B20_RAW_POWER_ON_RESET) {
                             // Still 85°C after retry - accept it (could be fire or faulty sensor)
                             LOG_W(TAG, "SensorManager: DS18B20 still 85°C after retry - accepting as potentially valid");
@@ -1028,9 +1218,9 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
                          ", quality=" + reading_out.quality + ")");
             } else {
                 // Analog sensor (pH, EC, Moisture, etc.)
-                raw_value = readRawAnalog(gpio);
-                // E-P2: ADC quality check for analog sensors
-                reading_out.quality = String(validateAdcReading(raw_value, gpio));
+                if (!readAnalogProbe(gpio, raw_value, reading_out)) {
+                    return false;
+                }
             }
         }
     } else {
@@ -1041,9 +1231,9 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
         if (lower_type.indexOf("ph") >= 0 || lower_type.indexOf("ec") >= 0 ||
             lower_type.indexOf("moisture") >= 0) {
             // Likely analog sensor
-            raw_value = readRawAnalog(gpio);
-            // E-P2: ADC quality check
-            reading_out.quality = String(validateAdcReading(raw_value, gpio));
+            if (!readAnalogProbe(gpio, raw_value, reading_out)) {
+                return false;
+            }
         } else if (lower_type.indexOf("ds18b20") >= 0 || lower_type.indexOf("onewire") >= 0) {
             // Likely OneWire sensor - use ROM-Code from config
             if (config->onewire_address.length() != 16) {
@@ -1061,7 +1251,7 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
             }
             
             int16_t raw_temp = 0;
-            if (readRawOneWire(gpio, rom, raw_temp)) {
+            if (readRawOneWire(gpio, rom, raw_temp, config->onewire_resolution)) {
                 raw_value = (uint32_t)raw_temp;
                 reading_out.onewire_address = config->onewire_address;
             } else {
@@ -1083,12 +1273,15 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
             }
         } else {
             // Fallback: try analog
-            raw_value = readRawAnalog(gpio);
-            // E-P2: ADC quality check
-            reading_out.quality = String(validateAdcReading(raw_value, gpio));
+            if (!readAnalogProbe(gpio, raw_value, reading_out)) {
+                return false;
+            }
         }
     }
-    
+
+    // Probe read → supply OFF (failed reads above are switched off by expire())
+    sensorExcitation.release(gpio);
+
     // Normalize sensor type for server (ESP32 → Server Processor)
     String server_sensor_type = getServerSensorType(config->sensor_type);
 
@@ -1115,6 +1308,14 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
     reading_out.error_message = "";
     reading_out.i2c_address = config->i2c_address;
 
+    // pH / EC: calibrated value, compensated with the co-located temperature
+    applyCalibration(config, reading_out);
+
+    // Quality pipeline: outliers are neither published nor cached for offline rules
+    if (!screenReading(reading_out)) {
+        return false;
+    }
+
     // Update config
     config->last_raw_value = raw_value;
     config->last_reading = millis();
@@ -1122,6 +1323,96 @@ bool SensorManager::performMeasurementForConfig(SensorConfig* config, SensorRead
     return true;
 }
 
+// ============================================
+// SENSOR EXCITATION (switched probe supply)
+// ============================================
+// Only probes read through the ADC path are switched; bus sensors (I2C,
+// OneWire), pulse counters and digital inputs keep their pin semantics.
+bool SensorManager::applyExcitation(const SensorConfig& config, const SensorCapability* capability) {
+    bool analog_probe = capability == nullptr ||
+                        (!capability->is_i2c && !capability->is_pulse_counter &&
+                         !capability->is_digital_input && strcmp(capability->device_type, "ds18b20") != 0);
+    if (!analog_probe || config.excitation_gpio == SENSOR_EXCITATION_NO_GPIO) {
+        sensorExcitation.detach(config.gpio);
+        return true;
+    }
+    return sensorExcitation.attach(config.gpio, config.excitation_gpio, config.excitation_settle_ms,
+                                   config.excitation_active_high);
+}
+
+// DMA scan: a window may have started before the probe settled. prepare()
+// extends the settle time by one window length and the first window closed
+// after that point contains settled samples only.
+uint32_t SensorManager::prepareExcitation(uint8_t gpio, uint32_t now_ms) {
+    if (!sensorExcitation.hasExcitation(gpio)) {
+        return 0;
+    }
+    bool on_scan = adcSampler.isActive() && adcSampler.supportsPin(gpio);
+    uint32_t remaining = sensorExcitation.prepare(gpio, now_ms, on_scan ? adcSampler.getWindowMs() : 0);
+    if (remaining > 0 || !on_scan) {
+        return remaining;
+    }
+    AdcWindowStats stats;
+    if (adcSampler.getLatest(gpio, stats, now_ms) &&
+        static_cast<int32_t>(stats.end_ms - sensorExcitation.getReadyAtMs(gpio)) >= 0) {
+        return 0;
+    }
+    return EXCITATION_WINDOW_POLL_MS;
+}
+
+// ============================================
+// CALIBRATION + TEMPERATURE COMPENSATION (ph, ec)
+// ============================================
+// Sensor fusion on-device: the temperature comes from the value cache, so
+// no extra bus read and no server-side join of readings with different
+// timestamps. Offline rules see the compensated value.
+// Temperature missing, older than temp_max_age_s or implausible → the
+// calibrated value is published uncompensated with quality "suspect".
+// Several DS18B20 on one bus share one cache entry (gpio + "ds18b20").
+void SensorManager::applyCalibration(const SensorConfig* config, SensorReading& reading) const {
+    TempCompKind kind = TemperatureCompensation::kindForSensorType(reading.sensor_type.c_str());
+    if (kind == TempCompKind::NONE || config->cal_slope == 0.0f) {
+        return;  // Uncalibrated: raw passthrough, server converts
+    }
+    float value = static_cast<float>(reading.raw_value) * config->cal_slope + config->cal_offset;
+    reading.calibrated = true;
+    reading.raw_mode = false;
+    reading.unit = kind == TempCompKind::EC ? "uS/cm" : "pH";
+    reading.uncompensated_value = value;
+    reading.processed_value = value;
+
+    if (config->temp_source_gpio == 255 || config->temp_source_type.length() == 0) {
+        return;  // No temperature source configured
+    }
+    float temp_c = getSensorValue(config->temp_source_gpio, config->temp_source_type.c_str(),
+                                  static_cast<unsigned long>(config->temp_max_age_s) * 1000UL);
+    TempCompResult comp = TemperatureCompensation::apply(kind, value, temp_c, config->temp_coefficient);
+    reading.processed_value = comp.value;
+    reading.temp_compensated = comp.compensated;
+    reading.compensation_temp_c = comp.compensated ? temp_c : 0.0f;
+    if (!comp.compensated) {
+        if (reading.quality == "good") {
+            reading.quality = "suspect";
+        }
+        LOG_D(TAG, "Sensor " + reading.sensor_type + " GPIO " + String(reading.gpio) +
+                   ": no valid temperature (GPIO " + String(config->temp_source_gpio) + " " +
+                   config->temp_source_type + "), uncompensated");
+    }
+}
+
+bool SensorManager::hasDeviceCalibration(uint8_t gpio, const char* server_sensor_type) const {
+    if (TemperatureCompensation::kindForSensorType(server_sensor_type) == TempCompKind::NONE) {
+        return false;
+    }
+    for (uint8_t i = 0; i < sensor_count_; i++) {
+        if (sensors_[i].gpio == gpio && sensors_[i].cal_slope != 0.0f &&
+            getServerSensorType(sensors_[i].sensor_type) == server_sensor_type) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // ============================================
 // MULTI-VALUE SENSOR MEASUREMENT (PHASE 5)
 // ============================================
@@ -1137,28 +1428,42 @@ uint8_t SensorManager::performMultiValueMeasurement(uint8_t gpio, SensorReading*
         return 0;
     }
     
-    // Get sensor capability
-    const SensorCapability* capability = findSensorCapability(config->sensor_type);
-    if (!capability || !capability->is_multi_value) {
-        LOG_W(TAG, "Sensor Manager: Sensor on GPIO " + String(gpio) + " is not a multi-value sensor");
-        return 0;
+    // Binding resolved at configure time (refreshI2CDevice): protocol, value
+    // slots and server types are indexed directly — no per-read string lookups.
+    // Unbound devices fall back to the registry/protocol lookup by name.
+    const I2CDeviceBinding* bound = findI2CBinding(config->i2c_address);
+    String device_type;         // Unbound path only
+    String value_types[4];      // Unbound path only
+    const char* device_name = nullptr;
+    uint8_t value_count = 0;
+
+    if (bound != nullptr) {
+        device_name = bound->binding.protocol->sensor_type;
+        value_count = bound->binding.value_count;
+    } else {
+        // Get sensor capability
+        const SensorCapability* capability = findSensorCapability(config->sensor_type);
+        if (!capability || !capability->is_multi_value) {
+            LOG_W(TAG, "Sensor Manager: Sensor on GPIO " + String(gpio) + " is not a multi-value sensor");
+            return 0;
+        }
+
+        // Read raw data from sensor (I2C for SHT31/BMP280)
+        if (!capability->is_i2c) {
+            LOG_E(TAG, "Sensor Manager: Multi-value sensor must be I2C");
+            return 0;
+        }
+
+        // Get device type and all value types
+        device_name = capability->device_type;
+        device_type = String(device_name);
+        value_count = getMultiValueTypes(device_type, value_types, 4);
     }
-    
-    // Get device type and all value types
-    String device_type = String(capability->device_type);
-    String value_types[4];
-    uint8_t value_count = getMultiValueTypes(device_type, value_types, 4);
-    
+
     if (value_count == 0 || value_count > max_readings) {
         LOG_E(TAG, "Sensor Manager: Invalid value count for multi-value sensor");
         return 0;
     }
-    
-    // Read raw data from sensor (I2C for SHT31/BMP280)
-    if (!capability->is_i2c) {
-        LOG_E(TAG, "Sensor Manager: Multi-value sensor must be I2C");
-        return 0;
-    }
 
     // ============================================
     // UNIFIED I2C MULTI-VALUE SENSOR READING
@@ -1172,14 +1477,17 @@ uint8_t SensorManager::performMultiValueMeasurement(uint8_t gpio, SensorReading*
     uint8_t device_addr = config->i2c_address;
     size_t bytes_read = 0;
 
-    LOG_D(TAG, "SensorManager: I2C READ START for " + device_type + " addr=0x" + String(device_addr, HEX));
-    if (!i2c_bus_->readSensorRaw(device_type, device_addr, buffer, sizeof(buffer), bytes_read)) {
-        LOG_E(TAG, "Sensor Manager: I2C read failed for " + device_type);
+    LOG_D(TAG, "SensorManager: I2C READ START for " + String(device_name) + " addr=0x" + String(device_addr, HEX));
+    bool read_ok = (bound != nullptr)
+        ? i2c_bus_->readSensorRaw(bound->binding, buffer, sizeof(buffer), bytes_read)
+        : i2c_bus_->readSensorRaw(device_type, device_addr, buffer, sizeof(buffer), bytes_read);
+    if (!read_ok) {
+        LOG_E(TAG, "Sensor Manager: I2C read failed for " + String(device_name));
         return 0;
     }
     LOG_D(TAG, "SensorManager: I2C READ COMPLETE, bytes=" + String(bytes_read));
 
-    LOG_D(TAG, "Sensor Manager: " + device_type + " raw data (" + String(bytes_read) + " bytes): " +
+    LOG_D(TAG, "Sensor Manager: " + String(device_name) + " raw data (" + String(bytes_read) + " bytes): " +
               String(buffer[0], HEX) + " " + String(buffer[1], HEX) + " " +
               String(buffer[2], HEX) + " " + String(buffer[3], HEX) + " " +
               String(buffer[4], HEX) + " " + String(buffer[5], HEX));
@@ -1193,11 +1501,16 @@ uint8_t SensorManager::performMultiValueMeasurement(uint8_t gpio, SensorReading*
         // Extract raw value using protocol definition
         // This uses the I2CSensorProtocol registry to correctly parse
         // multi-value sensor responses based on byte offsets and endianness
-        String value_type = value_types[i];
-        uint32_t raw_value = extractRawValue(device_type, value_type, buffer, bytes_read);
-        
-        // Normalize sensor type
-        String server_sensor_type = getServerSensorType(value_type);
+        uint32_t raw_value;
+        String server_sensor_type;
+        if (bound != nullptr) {
+            raw_value = extractBoundRawValue(bound->binding, i, buffer, bytes_read);
+            server_sensor_type = bound->server_types[i];
+        } else {
+            raw_value = extractRawValue(device_type, value_types[i], buffer, bytes_read);
+            // Normalize sensor type
+            server_sensor_type = getServerSensorType(value_types[i]);
+        }
 
         // Apply local conversion for human-readable MQTT payload preview
         LocalConversion conv = applyLocalConversion(server_sensor_type, raw_value);
@@ -1218,7 +1531,8 @@ uint8_t SensorManager::performMultiValueMeasurement(uint8_t gpio, SensorReading*
         reading.error_message = "";
         reading.i2c_address = config->i2c_address;
 
-        bool success = true;
+        // Quality pipeline per value type (temp and humidity have separate windows)
+        bool success = screenReading(reading);
         if (success) {
             created_count++;
 
@@ -1226,7 +1540,8 @@ uint8_t SensorManager::performMultiValueMeasurement(uint8_t gpio, SensorReading*
             LOG_D(TAG, "SensorManager: MQTT PUBLISH for " + server_sensor_type);
             publishSensorReading(reading);
         } else {
-            LOG_W(TAG, "SensorManager: Skipping publish for " + server_sensor_type);
+            LOG_W(TAG, "SensorManager: Skipping publish for " + server_sensor_type +
+                       " (" + reading.error_message + ")");
         }
     }
 
@@ -1239,11 +1554,123 @@ uint8_t SensorManager::performMultiValueMeasurement(uint8_t gpio, SensorReading*
     return created_count;
 }
 
+// ============================================
+// PULSE COUNTER MEASUREMENT (flow_meter, rain_gauge)
+// ============================================
+// One PCNT sample → two values:
+//   rate  ("flow" L/min, "rain" mm/h) → reading_out, published by the caller
+//   total ("flow_total" L, "rain_total" mm) → published here; the value cache
+//          entry lets offline rules act on volume (e.g. stop pump after N litres)
+// raw_value: pulses in the interval / low 32 bit of the pulse total.
+// Without calibration (pulses_per_unit 0) the values are raw pulses and
+// raw_mode stays true — the server converts.
+// Rates skip screenReading(): a valve opening is a legitimate step change.
+bool SensorManager::performPulseMeasurement(SensorConfig* config, const SensorCapability* capability,
+                                            SensorReading& reading_out) {
+    PulseSample sample;
+    if (!pulseCounter.sample(config->gpio, millis(), sample)) {
+        reading_out.valid = false;
+        reading_out.error_message = "Pulse counter not attached";
+        LOG_E(TAG, "SensorManager: No pulse counter on GPIO " + String(config->gpio));
+        return false;
+    }
+
+    bool is_flow = strcmp(capability->server_sensor_type, "flow") == 0;
+    bool calibrated = config->pulses_per_unit > 0.0f;
+    uint32_t rate_period_ms = is_flow ? 60000UL : 3600000UL;
+
+    SensorReading total;
+    total.gpio = config->gpio;
+    total.sensor_type = is_flow ? "flow_total" : "rain_total";
+    total.subzone_id = config->subzone_id;
+    total.raw_value = static_cast<uint32_t>(sample.total_pulses);
+    total.processed_value = PulseCounterManager::pulsesToUnits(sample.total_pulses, config->pulses_per_unit);
+    total.unit = calibrated ? (is_flow ? "L" : "mm") : "pulses";
+    total.quality = "good";
+    total.timestamp = millis();
+    total.valid = true;
+    total.error_message = "";
+    total.raw_mode = !calibrated;
+    publishSensorReading(total);
+
+    reading_out.gpio = config->gpio;
+    reading_out.sensor_type = capability->server_sensor_type;
+    reading_out.subzone_id = config->subzone_id;
+    reading_out.raw_value = sample.delta_pulses;
+    reading_out.processed_value = PulseCounterManager::computeRate(
+        sample.delta_pulses, sample.elapsed_ms, config->pulses_per_unit, rate_period_ms);
+    reading_out.unit = calibrated ? (is_flow ? "L/min" : "mm/h") : (is_flow ? "pulses/min" : "pulses/h");
+    reading_out.quality = "good";
+    reading_out.timestamp = total.timestamp;
+    reading_out.valid = true;
+    reading_out.error_message = "";
+    reading_out.raw_mode = !calibrated;
+
+    config->last_raw_value = sample.delta_pulses;
+    config->last_reading = total.timestamp;
+    return true;
+}
+
+// ============================================
+// DIGITAL INPUTS (float_switch, door_contact, leak_sensor, ...)
+// ============================================
+// raw = pin level, value = 1 when active (LOW for active_low contacts).
+// Already final → raw_mode false, no quality screening (a stable contact
+// would be flagged as stuck).
+void SensorManager::fillDigitalInputReading(const SensorConfig* config, const SensorCapability* capability,
+                                            bool level, SensorReading& reading_out) const {
+    bool active = level != config->input_active_low;
+    reading_out.gpio = config->gpio;
+    reading_out.sensor_type = capability->server_sensor_type;
+    reading_out.subzone_id = config->subzone_id;
+    reading_out.raw_value = level ? 1 : 0;
+    reading_out.processed_value = active ? 1.0f : 0.0f;
+    reading_out.unit = "state";
+    reading_out.quality = "good";
+    reading_out.timestamp = millis();
+    reading_out.valid = true;
+    reading_out.error_message = "";
+    reading_out.raw_mode = false;
+}
+
+// Safety-Task, every tick: commit debounced edges and publish each change at
+// once (not at the next measurement interval). Returns true if a state changed,
+// so offline rules can be evaluated in the same tick.
+bool SensorManager::processDigitalInputs() {
+    if (!initialized_ || digitalInputs.getAttachedCount() == 0) {
+        return false;
+    }
+    DigitalInputEvent events[DIGITAL_INPUT_MAX_CHANNELS];
+    uint8_t count = digitalInputs.poll(millis(), micros(), events, DIGITAL_INPUT_MAX_CHANNELS);
+    if (count == 0) {
+        return false;
+    }
+
+    xSemaphoreTake(g_sensor_mutex, portMAX_DELAY);
+    for (uint8_t i = 0; i < count; i++) {
+        SensorConfig* config = findSensorConfig(events[i].gpio);
+        const SensorCapability* capability = config ? findSensorCapability(config->sensor_type) : nullptr;
+        if (capability == nullptr || !capability->is_digital_input) {
+            continue;
+        }
+        SensorReading reading;
+        fillDigitalInputReading(config, capability, events[i].level, reading);
+        reading.edge_ms = events[i].edge_ms;
+        config->last_raw_value = reading.raw_value;
+        config->last_reading = millis();  // Event counts as measurement, restarts the refresh interval
+        LOG_I(TAG, "Digital input " + config->sensor_type + " GPIO " + String(config->gpio) + " → " +
+                   String(reading.processed_value > 0.5f ? "active" : "inactive"));
+        publishSensorReading(reading);
+    }
+    xSemaphoreGive(g_sensor_mutex);
+    return true;
+}
+
 // Server-Centric Deviation (Autonomous Measurement Pattern):
 // ESP32 misst periodisch autonom (standard in Industrial IoT wie AWS Greengrass, Azure IoT Edge).
 // Begründung: Minimiert MQTT-Traffic, Server-Control via measurement_interval Config.
 // Dokumentiert in: docs/ZZZ.md - "Server-Centric Pragmatic Deviations"
-void SensorManager::performAllMeasurements() {
+void SensorManager::performAllMeasurements(uint32_t deadline_us) {
     if (!initialized_) {
         return;
     }
@@ -1261,6 +1688,9 @@ void SensorManager::performAllMeasurements() {
 
     unsigned long now = millis();
 
+    // Excitation left ON by a skipped read (budget split, paused sensor) → OFF
+    sensorExcitation.expire(now);
+
     // I2C multi-value dedup: Track already-measured I2C addresses per cycle.
     // Multi-value sensors (SHT31, BMP280, BME280) are stored as separate configs
     // (e.g. sht31_temp + sht31_humidity) but share one I2C address. Without dedup,
@@ -1269,9 +1699,15 @@ void SensorManager::performAllMeasurements() {
     uint8_t measured_i2c_addrs[MAX_SENSORS];
     uint8_t measured_i2c_count = 0;
 
+    // Budget-split passes resume where the previous call stopped (round-robin)
+    uint8_t start_index = measurement_cursor_ < sensor_count_ ? measurement_cursor_ : 0;
+    measurement_cursor_ = 0;
+    uint8_t measured_this_pass = 0;
+
     // ✅ Phase 2C: Pro-Sensor Iteration with Mode-Check
     // (Removed global interval check - each sensor has its own interval)
-    for (uint8_t i = 0; i < sensor_count_; i++) {
+    for (uint8_t k = 0; k < sensor_count_; k++) {
+        uint8_t i = static_cast<uint8_t>((start_index + k) % sensor_count_);
         LOG_D(TAG, "SensorManager: Processing sensor[" + String(i) + "] GPIO=" + String(sensors_[i].gpio) + " type=" + sensors_[i].sensor_type);
         // Check 1: Sensor must be active
         if (!sensors_[i].active) {
@@ -1320,9 +1756,30 @@ void SensorManager::performAllMeasurements() {
         }
 
         // ✅ Continuous Mode: Perform measurement
-        // Check if this is a multi-value sensor
-        const SensorCapability* capability = findSensorCapability(sensors_[i].sensor_type);
-        LOG_D(TAG, "SensorManager: sensor[" + String(i) + "] is_multi_value=" + String(capability && capability->is_multi_value ? "YES" : "NO"));
+        // Check if this is a multi-value sensor (bound I2C devices skip the registry lookup)
+        bool is_multi_value = false;
+        if (sensors_[i].i2c_address != 0 && findI2CBinding(sensors_[i].i2c_address) != nullptr) {
+            is_multi_value = true;
+        } else {
+            const SensorCapability* capability = findSensorCapability(sensors_[i].sensor_type);
+            is_multi_value = (capability && capability->is_multi_value);
+        }
+        LOG_D(TAG, "SensorManager: sensor[" + String(i) + "] is_multi_value=" + String(is_multi_value ? "YES" : "NO"));
+
+        // Safety-Task phase budget: stop between sensors once the deadline passed.
+        // This sensor is still due and is measured first on the next call.
+        if (deadline_us != 0 && measured_this_pass > 0 &&
+            static_cast<int32_t>(micros() - deadline_us) >= 0) {
+            measurement_cursor_ = i;
+            LOG_D(TAG, "SensorManager: budget exhausted, resuming at sensor[" + String(i) + "] next tick");
+            break;
+        }
+
+        // Switched probe supply: power up now, measure the other sensors during
+        // the settle time. The sensor stays due; the next pass reads it.
+        if (!is_multi_value && prepareExcitation(sensors_[i].gpio, now) > 0) {
+            continue;
+        }
 
         // B1 FIX: Update last_reading BEFORE measurement attempt.
         // On failure, this prevents immediate retry (flood). The sensor
@@ -1330,8 +1787,9 @@ void SensorManager::performAllMeasurements() {
         sensors_[i].last_reading = now;
 
         bool measurement_ok = false;
+        bool measurement_deferred = false;
 
-        if (capability && capability->is_multi_value) {
+        if (is_multi_value) {
             // I2C dedup: Skip if this exact I2C address was already measured this cycle.
             // Multi-value sensors (SHT31, BMP280, BME280) are stored as separate configs
             // (sht31_temp + sht31_humidity) but share one physical I2C address.
@@ -1361,6 +1819,13 @@ void SensorManager::performAllMeasurements() {
 
             // Track this I2C address as measured
             measured_i2c_addrs[measured_i2c_count++] = addr;
+            // Sibling configs (sht31_humidity) are covered by this read. Mark them now:
+            // a split pass may reach them only on the next call, after the dedup list reset.
+            for (uint8_t j = 0; j < sensor_count_; j++) {
+                if (j != i && sensors_[j].i2c_address == addr && sensors_[j].gpio == sensors_[i].gpio) {
+                    sensors_[j].last_reading = now;
+                }
+            }
 
             measurement_ok = (count > 0);
             if (!measurement_ok) {
@@ -1373,11 +1838,30 @@ void SensorManager::performAllMeasurements() {
             SensorReading reading;
             if (performMeasurementForConfig(&sensors_[i], reading)) {
                 LOG_D(TAG, "SensorManager: SINGLE-VALUE measurement OK, publishing");
-                publishSensorReading(reading);
+                if (sensors_[i].batch_max_samples > 1) {
+                    queueRawSample(sensors_[i], reading);
+                } else {
+                    publishSensorReading(reading);
+                }
                 measurement_ok = true;
             } else {
-                LOG_D(TAG, "SensorManager: SINGLE-VALUE measurement FAILED");
+                measurement_deferred = measurement_deferred_;
+                LOG_D(TAG, String("SensorManager: SINGLE-VALUE measurement ") +
+                           (measurement_deferred ? "DEFERRED (no ADC window)" : "FAILED"));
+            }
+        }
+
+        measured_this_pass++;
+
+        // No ADC window yet: not a sensor fault — retry after one window,
+        // circuit breaker untouched
+        if (measurement_deferred) {
+            uint32_t retry_ms = adcSampler.getWindowMs();
+            if (retry_ms > sensor_interval) {
+                retry_ms = sensor_interval;
             }
+            sensors_[i].last_reading = now - sensor_interval + retry_ms;
+            continue;
         }
 
         // ✅ F7: Circuit Breaker State Transitions
@@ -1416,6 +1900,9 @@ void SensorManager::performAllMeasurements() {
         yield();
     }
 
+    // Raw batching: interval-based flushes (size/threshold flush happens on add)
+    flushDueRawBatches(now);
+
     // Update global timestamp for compatibility
     last_measurement_time_ = now;
     LOG_D(TAG, "SensorManager::performAllMeasurements() EXIT");
@@ -1504,6 +1991,39 @@ ManualMeasurementResult SensorManager::triggerManualMeasurement(uint8_t gpio, ui
         config->last_reading = start_ms;
         return result;
     } else {
+        // Switched probe supply: never wait inline on the Safety-Task. Power the
+        // probe and hand back the settle time; the command queue calls again.
+        if (config->manual_settling &&
+            sensorExcitation.getMsUntilReady(gpio, static_cast<uint32_t>(start_ms)) == UINT32_MAX) {
+            config->manual_settling = false;  // Parked command dropped, pin switched off since
+        }
+        uint32_t settle_ms = prepareExcitation(gpio, static_cast<uint32_t>(start_ms));
+        if (settle_ms > 0) {
+            if (!config->manual_settling) {
+                config->manual_settling = true;
+                config->manual_settle_since_ms = static_cast<uint32_t>(start_ms);
+            }
+            uint32_t waited_ms = static_cast<uint32_t>(start_ms) - config->manual_settle_since_ms;
+            if (waited_ms < timeout_ms && waited_ms < EXCITATION_MAX_WAIT_MS) {
+                result.retry_after_ms = settle_ms;
+                result.reason_code = "SETTLING";
+                return result;
+            }
+            config->manual_settling = false;
+            result.timeout_reached = true;
+            result.reason_code = "MEASURE_TIMEOUT";
+            LOG_W(TAG, "SensorManager: Manual measurement TIMEOUT on GPIO " + String(gpio) +
+                     " (probe not settled after " + String(waited_ms) + "ms)");
+            errorTracker.trackError(ERROR_SENSOR_TIMEOUT, ERROR_SEVERITY_WARNING,
+                                   "Manual measurement exceeded timeout");
+            return result;
+        }
+        if (config->manual_settling) {
+            // Timeout guard covers the settle time, as if the read had waited for it
+            config->manual_settling = false;
+            start_ms = config->manual_settle_since_ms;
+        }
+
         // Single-value sensor - standard measurement
         SensorReading reading;
         if (performMeasurement(gpio, reading)) {
@@ -1543,16 +2063,18 @@ ManualMeasurementResult SensorManager::triggerManualMeasurement(uint8_t gpio, ui
 // ============================================
 // RAW DATA READING METHODS (PHASE 4)
 // ============================================
-uint32_t SensorManager::readRawAnalog(uint8_t gpio) {
+bool SensorManager::readRawAnalog(uint8_t gpio, uint32_t& raw_out) {
+    // Configuration faults below report raw 0 (validateAdcReading() flags it)
+    raw_out = 0;
     if (!initialized_) {
-        return 0;
+        return true;
     }
 
     // Defense-in-depth: gpio=0 is the I2C bus convention, never a valid analog pin.
     // Catches sensors stored in NVS from before the configureSensor() guard was added.
     if (gpio == 0) {
         LOG_E(TAG, "readRawAnalog: GPIO 0 rejected (boot strap pin, I2C bus convention)");
-        return 0;
+        return true;
     }
 
     // ADC2/WiFi conflict check: ADC2 pins cannot be used for analog reads when WiFi is active
@@ -1560,16 +2082,47 @@ uint32_t SensorManager::readRawAnalog(uint8_t gpio) {
     if (gpio_manager_->isADC2Pin(gpio)) {
         if (WiFi.isConnected() || WiFi.getMode() != WIFI_OFF) {
             LOG_E(TAG, "GPIO " + String(gpio) + " is on ADC2 - cannot read while WiFi is active! Use ADC1 pins (GPIO32-39) for analog sensors");
-            return 0;
+            return true;
         }
     }
 
+    // Continuous ADC: latest DMA window (mean of window_samples conversions).
+    // While the scan runs it holds the ADC1 lock — no analogRead() on ADC1 then.
+    if (adcSampler.isActive() && adcSampler.supportsPin(gpio)) {
+        AdcWindowStats stats;
+        if (adcSampler.getLatest(gpio, stats, millis())) {
+            raw_out = stats.mean_raw;
+            return true;
+        }
+        if (!adcSampler.hasChannel(gpio)) {
+            adcSampler.addChannel(gpio);  // Sensor configured before the sampler started
+        }
+        LOG_D(TAG, "GPIO " + String(gpio) + ": no ADC window yet");
+        return false;
+    }
+
     // Configure pin as analog input if needed
     gpio_manager_->configurePinMode(gpio, INPUT);
     analogSetPinAttenuation(gpio, ADC_11db);  // Safety-Net: 100-3100mV range for all analog sensors
 
     // Read analog value (ESP32: 0-4095)
-    return analogRead(gpio);
+    raw_out = analogRead(gpio);
+    return true;
+}
+
+// Continuous ADC without a fresh window (scan restarted by add/removeChannel,
+// window older than the sampler's max age): no reading at all instead of a
+// raw 0 that would be published as a "suspect" rail value.
+bool SensorManager::readAnalogProbe(uint8_t gpio, uint32_t& raw_value, SensorReading& reading_out) {
+    if (!readRawAnalog(gpio, raw_value)) {
+        measurement_deferred_ = true;
+        reading_out.valid = false;
+        reading_out.error_message = "ADC window not ready";
+        return false;
+    }
+    // E-P2: ADC quality check for analog sensors
+    reading_out.quality = String(validateAdcReading(raw_value, gpio));
+    return true;
 }
 
 // E-P2: ADC Validation — classify raw ADC reading quality
@@ -1593,6 +2146,331 @@ const char* SensorManager::validateAdcReading(uint32_t raw, uint8_t gpio) {
     return "good";
 }
 
+// ============================================
+// READING QUALITY PIPELINE
+// ============================================
+ReadingValidator* SensorManager::findOrCreateValidator(const SensorReading& reading) {
+    const char* type = reading.sensor_type.c_str();
+    const char* rom = reading.onewire_address.c_str();
+    ValidatorEntry* free_slot = nullptr;
+    for (uint8_t i = 0; i < MAX_VALIDATOR_ENTRIES; i++) {
+        ValidatorEntry& entry = validators_[i];
+        if (!entry.in_use) {
+            if (free_slot == nullptr) {
+                free_slot = &entry;
+            }
+            continue;
+        }
+        if (entry.gpio == reading.gpio &&
+            entry.i2c_address == reading.i2c_address &&
+            strncmp(entry.sensor_type, type, sizeof(entry.sensor_type) - 1) == 0 &&
+            strncmp(entry.onewire_address, rom, sizeof(entry.onewire_address) - 1) == 0) {
+            return &entry.validator;
+        }
+    }
+    if (free_slot == nullptr) {
+        return nullptr;  // Table full — reading passes unfiltered
+    }
+    free_slot->in_use = true;
+    free_slot->gpio = reading.gpio;
+    free_slot->i2c_address = reading.i2c_address;
+    strncpy(free_slot->sensor_type, type, sizeof(free_slot->sensor_type) - 1);
+    free_slot->sensor_type[sizeof(free_slot->sensor_type) - 1] = '\0';
+    strncpy(free_slot->onewire_address, rom, sizeof(free_slot->onewire_address) - 1);
+    free_slot->onewire_address[sizeof(free_slot->onewire_address) - 1] = '\0';
+    free_slot->validator.configure(ReadingValidator::configForSensorType(type));
+    return &free_slot->validator;
+}
+
+bool SensorManager::screenReading(SensorReading& reading) {
+    ReadingValidator* validator = findOrCreateValidator(reading);
+    if (validator == nullptr) {
+        return true;
+    }
+
+    ReadingVerdict verdict = validator->validate(reading.processed_value, reading.raw_value,
+                                                 static_cast<uint32_t>(reading.timestamp));
+    if (verdict.grade == ReadingGrade::REJECTED) {
+        readings_rejected_total_++;
+        reading.valid = false;
+        reading.quality = "error";
+        reading.error_message = String("Reading rejected by quality filter (") +
+                                ReadingValidator::getRejectReasonString(verdict.reason) + ")";
+        LOG_W(TAG, "Sensor " + reading.sensor_type + " GPIO " + String(reading.gpio) +
+                   ": value " + String(reading.processed_value) + " rejected (" +
+                   ReadingValidator::getRejectReasonString(verdict.reason) + ")");
+        return false;
+    }
+    if (verdict.grade == ReadingGrade::SUSPECT) {
+        reading.quality = "suspect";
+        if (verdict.stuck) {
+            LOG_D(TAG, "Sensor " + reading.sensor_type + " GPIO " + String(reading.gpio) +
+                       ": raw value unchanged — possibly stuck");
+        }
+    }
+    return true;
+}
+
+void SensorManager::resetReadingValidators(uint8_t gpio) {
+    for (uint8_t i = 0; i < MAX_VALIDATOR_ENTRIES; i++) {
+        if (validators_[i].in_use && validators_[i].gpio == gpio) {
+            validators_[i].in_use = false;
+            validators_[i].validator.reset();
+        }
+    }
+}
+
+// ============================================
+// RAW SAMPLE BATCHING
+// ============================================
+SensorManager::RawBatchEntry* SensorManager::findRawBatch(const SensorConfig& config, bool create) {
+    const char* type = config.sensor_type.c_str();
+    const char* rom = config.onewire_address.c_str();
+    RawBatchEntry* free_slot = nullptr;
+    for (uint8_t i = 0; i < MAX_RAW_BATCH_STREAMS; i++) {
+        RawBatchEntry& entry = raw_batches_[i];
+        if (!entry.in_use) {
+            if (free_slot == nullptr) {
+                free_slot = &entry;
+            }
+            continue;
+        }
+        if (entry.gpio == config.gpio &&
+            entry.i2c_address == config.i2c_address &&
+            strncmp(entry.sensor_type, type, sizeof(entry.sensor_type) - 1) == 0 &&
+            strncmp(entry.onewire_address, rom, sizeof(entry.onewire_address) - 1) == 0) {
+            return &entry;
+        }
+    }
+    if (!create || free_slot == nullptr) {
+        return nullptr;
+    }
+    free_slot->in_use = true;
+    free_slot->gpio = config.gpio;
+    free_slot->i2c_address = config.i2c_address;
+    strncpy(free_slot->sensor_type, type, sizeof(free_slot->sensor_type) - 1);
+    free_slot->sensor_type[sizeof(free_slot->sensor_type) - 1] = '\0';
+    strncpy(free_slot->onewire_address, rom, sizeof(free_slot->onewire_address) - 1);
+    free_slot->onewire_address[sizeof(free_slot->onewire_address) - 1] = '\0';
+
+    RawBatchPolicy policy;
+    policy.max_samples = config.batch_max_samples;
+    policy.flush_interval_ms = config.batch_flush_interval_ms;
+    policy.flush_delta = config.batch_flush_delta;
+    free_slot->batch.configure(policy);
+    return free_slot;
+}
+
+bool SensorManager::queueRawSample(const SensorConfig& config, const SensorReading& reading) {
+    RawBatchEntry* entry = findRawBatch(config, true);
+    if (entry == nullptr) {
+        // Pool exhausted — fall back to the per-sample path
+        return publishSensorReading(reading);
+    }
+
+    // SAFETY-P4: Offline rules see every sample, not only flushed frames
+    updateValueCache(reading.gpio, reading.sensor_type.c_str(), reading.processed_value);
+
+    bool flush_now = entry->batch.add(static_cast<int32_t>(reading.raw_value),
+                                      static_cast<uint32_t>(reading.timestamp));
+    if (flush_now) {
+        return flushRawBatch(*entry);
+    }
+    return true;
+}
+
+bool SensorManager::flushRawBatch(RawBatchEntry& entry) {
+    if (entry.batch.count() == 0) {
+        return true;
+    }
+    // Offline: keep buffering, the ring keeps the newest samples
+    if (!mqtt_client_ || !mqtt_client_->isConnected() ||
+        !mqtt_client_->isRegistrationConfirmed()) {
+        return false;
+    }
+
+    const SensorConfig* config = findSensorConfig(entry.gpio, String(entry.onewire_address),
+                                                  entry.i2c_address, String(entry.sensor_type));
+    if (config == nullptr) {
+        entry.batch.clear();
+        return false;
+    }
+
+    // Unix time of the first buffered sample (sample timestamps are millis())
+    uint32_t now_ms = millis();
+    uint32_t age_s = (now_ms - entry.batch.at(0).timestamp_ms) / 1000;
+    uint32_t base_ts = static_cast<uint32_t>(timeManager.getUnixTimestamp()) - age_s;
+
+    char frame[RAW_BATCH_FRAME_MAX_LEN];
+    size_t frame_len = entry.batch.encode(frame, sizeof(frame), base_ts);
+    if (frame_len == 0) {
+        LOG_E(TAG, "Sensor Manager: Raw batch frame overflow for GPIO " + String(entry.gpio));
+        entry.batch.clear();
+        return false;
+    }
+
+    extern KaiserZone g_kaiser;
+    String payload;
+    payload.reserve(frame_len + 256);
+    payload = "{\"esp_id\":\"";
+    payload += ConfigManager::getInstance().getESPId();
+    payload += "\",\"seq\":";
+    payload += String(mqtt_client_->getNextSeq());
+    payload += ",\"zone_id\":\"";
+    payload += g_kaiser.zone_id;
+    payload += "\",\"subzone_id\":\"";
+    payload += config->subzone_id;
+    payload += "\",\"gpio\":";
+    payload += String(entry.gpio);
+    payload += ",\"sensor_type\":\"";
+    payload += getServerSensorType(config->sensor_type);
+    payload += "\",\"raw_mode\":true,\"enc\":\"delta\",";
+    payload += frame;
+    payload += ",\"time_valid\":";
+    payload += (timeManager.isSynchronized() ? "true" : "false");
+    if (entry.onewire_address[0] != '\0') {
+        payload += ",\"onewire_address\":\"";
+        payload += entry.onewire_address;
+        payload += "\"";
+    }
+    if (entry.i2c_address != 0) {
+        payload += ",\"i2c_address\":";
+        payload += String(entry.i2c_address);
+    }
+    payload += "}";
+
+    String topic = String(TopicBuilder::buildSensorBatchTopic());
+    if (!mqtt_client_->publish(topic, payload, 1)) {
+        LOG_E(TAG, "Sensor Manager: Failed to publish raw batch for GPIO " + String(entry.gpio));
+        errorTracker.trackError(ERROR_MQTT_PUBLISH_FAILED, ERROR_SEVERITY_ERROR,
+                               "Failed to publish raw sample batch");
+        return false;
+    }
+
+    raw_batch_frames_++;
+    raw_batch_samples_ += entry.batch.count();
+    LOG_D(TAG, "Sensor Manager: Raw batch GPIO " + String(entry.gpio) + " flushed " +
+               String(entry.batch.count()) + " samples");
+    entry.batch.clear();
+    return true;
+}
+
+void SensorManager::flushDueRawBatches(unsigned long now) {
+    for (uint8_t i = 0; i < MAX_RAW_BATCH_STREAMS; i++) {
+        RawBatchEntry& entry = raw_batches_[i];
+        if (entry.in_use && entry.batch.isFlushDue(static_cast<uint32_t>(now))) {
+            flushRawBatch(entry);
+        }
+    }
+}
+
+void SensorManager::releaseRawBatches(uint8_t gpio) {
+    for (uint8_t i = 0; i < MAX_RAW_BATCH_STREAMS; i++) {
+        RawBatchEntry& entry = raw_batches_[i];
+        if (entry.in_use && entry.gpio == gpio) {
+            if (entry.batch.count() > 0) {
+                LOG_W(TAG, "Sensor Manager: Discarding " + String(entry.batch.count()) +
+                           " unsent raw samples for GPIO " + String(gpio));
+            }
+            entry.in_use = false;
+            entry.batch.reset();
+        }
+    }
+}
+
+// ============================================
+// I2C DEVICE BINDINGS
+// ============================================
+const SensorManager::I2CDeviceBinding* SensorManager::findI2CBinding(uint8_t i2c_address) const {
+    for (uint8_t i = 0; i < MAX_I2C_DEVICE_BINDINGS; i++) {
+        if (i2c_bindings_[i].in_use && i2c_bindings_[i].binding.i2c_address == i2c_address) {
+            return &i2c_bindings_[i];
+        }
+    }
+    return nullptr;
+}
+
+void SensorManager::refreshI2CDevice(uint8_t i2c_address) {
+    I2CDeviceBinding* slot = const_cast<I2CDeviceBinding*>(findI2CBinding(i2c_address));
+
+    const SensorCapability* capability = nullptr;
+    for (uint8_t i = 0; i < sensor_count_ && capability == nullptr; i++) {
+        if (!sensors_[i].active || sensors_[i].i2c_address != i2c_address) continue;
+        const SensorCapability* cap = findSensorCapability(sensors_[i].sensor_type);
+        if (cap != nullptr && cap->is_i2c) {
+            capability = cap;
+        }
+    }
+
+    if (capability == nullptr) {
+        if (slot != nullptr) {
+            slot->in_use = false;  // Last sensor at this address removed
+        }
+        syncSht3xPeriodicMode(i2c_address);
+        return;
+    }
+
+    if (slot == nullptr) {
+        for (uint8_t i = 0; i < MAX_I2C_DEVICE_BINDINGS && slot == nullptr; i++) {
+            if (!i2c_bindings_[i].in_use) {
+                slot = &i2c_bindings_[i];
+            }
+        }
+    }
+
+    const char* value_types[I2C_BINDING_MAX_VALUES] = {nullptr};
+    uint8_t value_count = getMultiValueTypeNames(capability->device_type, value_types,
+                                                 I2C_BINDING_MAX_VALUES);
+    I2CSensorBinding binding;
+    if (slot == nullptr ||
+        !resolveI2CSensorBinding(capability->device_type, value_types, value_count,
+                                 i2c_address, binding)) {
+        // Unbound devices still work via the string-based lookup path
+        LOG_W(TAG, "Sensor Manager: No I2C binding for " + String(capability->device_type) +
+                   " at 0x" + String(i2c_address, HEX));
+        if (slot != nullptr) {
+            slot->in_use = false;
+        }
+        syncSht3xPeriodicMode(i2c_address);
+        return;
+    }
+
+    slot->in_use = true;
+    slot->binding = binding;
+    for (uint8_t i = 0; i < value_count; i++) {
+        const SensorCapability* value_cap = findSensorCapability(value_types[i]);
+        slot->server_types[i] = value_cap != nullptr ? value_cap->server_sensor_type : value_types[i];
+    }
+    LOG_D(TAG, "Sensor Manager: I2C binding " + String(capability->device_type) + " at 0x" +
+               String(i2c_address, HEX) + " (" + String(value_count) + " values)");
+
+    syncSht3xPeriodicMode(i2c_address);
+}
+
+// ============================================
+// SHT3x PERIODIC MODE
+// ============================================
+void SensorManager::syncSht3xPeriodicMode(uint8_t i2c_address) {
+    if (i2c_bus_ == nullptr || !i2c_bus_->isInitialized()) {
+        return;
+    }
+    uint32_t min_interval_ms = 0;
+    for (uint8_t i = 0; i < sensor_count_; i++) {
+        if (!sensors_[i].active || sensors_[i].i2c_address != i2c_address) continue;
+        const SensorCapability* cap = findSensorCapability(sensors_[i].sensor_type);
+        if (cap == nullptr || !cap->is_i2c || strcmp(cap->device_type, "sht31") != 0) continue;
+        uint32_t interval = sensors_[i].measurement_interval_ms;
+        if (min_interval_ms == 0 || interval < min_interval_ms) {
+            min_interval_ms = interval;
+        }
+    }
+    if (min_interval_ms == 0) {
+        i2c_bus_->releaseSht3xPeriodic(i2c_address);
+        return;
+    }
+    i2c_bus_->configureSht3xPeriodic(i2c_address, min_interval_ms);
+}
+
 uint32_t SensorManager::readRawDigital(uint8_t gpio) {
     if (!initialized_) {
         return 0;
@@ -1615,27 +2493,21 @@ bool SensorManager::readRawI2C(uint8_t gpio, uint8_t device_address,
     return i2c_bus_->readRaw(device_address, reg, buffer, len);
 }
 
-bool SensorManager::readRawOneWire(uint8_t gpio, const uint8_t rom[8], int16_t& raw_value) {
+bool SensorManager::readRawOneWire(uint8_t gpio, const uint8_t rom[8], int16_t& raw_value,
+                                   uint8_t resolution_bits) {
     if (!initialized_ || !onewire_bus_) {
         LOG_E(TAG, "SensorManager: Not initialized or OneWire bus missing");
         return false;
     }
     
-    // Verify OneWire bus is initialized
-    if (!onewire_bus_->isInitialized()) {
-        LOG_E(TAG, "SensorManager: OneWire bus not initialized");
-        return false;
-    }
-    
-    // Verify GPIO matches bus pin (safety check)
-    if (onewire_bus_->getPin() != gpio) {
-        LOG_E(TAG, "SensorManager: OneWire bus on GPIO " + String(onewire_bus_->getPin()) + 
-                 ", requested GPIO " + String(gpio));
+    // Verify OneWire bus on this GPIO is initialized
+    if (!onewire_bus_->isInitialized(gpio)) {
+        LOG_E(TAG, "SensorManager: OneWire bus not initialized on GPIO " + String(gpio));
         return false;
     }
     
     // Read RAW temperature from device
-    if (!onewire_bus_->readRawTemperature(rom, raw_value)) {
+    if (!onewire_bus_->readRawTemperature(gpio, rom, raw_value, resolution_bits)) {
         LOG_W(TAG, "SensorManager: Failed to read OneWire device " + 
                    OneWireUtils::romToHexString(rom));
         return false;
@@ -1644,6 +2516,27 @@ bool SensorManager::readRawOneWire(uint8_t gpio, const uint8_t rom[8], int16_t&
     return true;
 }
 
+uint8_t SensorManager::applyOneWireResolution(uint8_t gpio, const uint8_t rom[8],
+                                              uint8_t requested_bits) {
+    if (!OneWireProtocol::isValidResolution(requested_bits)) {
+        LOG_W(TAG, "SensorManager: DS18B20 resolution " + String(requested_bits) +
+                   " bit invalid - using " + String(DS18B20_RESOLUTION_DEFAULT) + " bit");
+        requested_bits = DS18B20_RESOLUTION_DEFAULT;
+    }
+    // DS18S20 (0x10) has no config register: fixed 750 ms conversion
+    if (!OneWireProtocol::hasResolutionConfig(rom)) {
+        return DS18B20_RESOLUTION_DEFAULT;
+    }
+    if (!onewire_bus_->configureResolution(gpio, rom, requested_bits)) {
+        // Device keeps an unknown resolution → full 12-bit wait is always safe
+        LOG_W(TAG, "SensorManager: DS18B20 " + OneWireUtils::romToHexString(rom) +
+                   " resolution not applied - using " + String(DS18B20_RESOLUTION_DEFAULT) +
+                   " bit timing");
+        return DS18B20_RESOLUTION_DEFAULT;
+    }
+    return requested_bits;
+}
+
 // ============================================
 // STATUS QUERIES
 // ============================================
@@ -1807,6 +2700,26 @@ String SensorManager::buildMQTTPayload(const SensorReading& reading) const {
     // raw_mode from Reading (Server-Centric: true = server processes RAW data)
     payload += "\"raw_mode\":";
     payload += (reading.raw_mode ? "true" : "false");
+
+    // Digital input events: wall-clock time of the first edge (not of the publish)
+    if (reading.edge_ms != 0 && timeManager.isSynchronized()) {
+        uint64_t edge_ts_ms = timeManager.getUnixTimestampMs() - static_cast<uint32_t>(millis() - reading.edge_ms);
+        char edge_buf[32];
+        snprintf(edge_buf, sizeof(edge_buf), ",\"edge_ts_ms\":%llu", static_cast<unsigned long long>(edge_ts_ms));
+        payload += edge_buf;
+    }
+
+    // Calibrated pH / EC: uncompensated value and the temperature used
+    if (reading.calibrated) {
+        payload += ",\"value_uncomp\":";
+        payload += String(reading.uncompensated_value);
+        payload += ",\"temp_comp\":";
+        payload += (reading.temp_compensated ? "true" : "false");
+        if (reading.temp_compensated) {
+            payload += ",\"comp_temp_c\":";
+            payload += String(reading.compensation_temp_c);
+        }
+    }
     
     // OneWire Address (for device identification on shared bus)
     if (!reading.onewire_address.isEmpty()) {
@@ -1857,6 +2770,10 @@ void SensorManager::updateValueCache(uint8_t gpio, const char* sensor_type, floa
 }
 
 float SensorManager::getSensorValue(uint8_t gpio, const char* sensor_type) const {
+    return getSensorValue(gpio, sensor_type, VALUE_CACHE_STALE_MS);
+}
+
+float SensorManager::getSensorValue(uint8_t gpio, const char* sensor_type, unsigned long max_age_ms) const {
     for (uint8_t i = 0; i < value_cache_count_; i++) {
         const ValueCacheEntry& entry = value_cache_[i];
         if (!entry.valid) {
@@ -1869,7 +2786,7 @@ float SensorManager::getSensorValue(uint8_t gpio, const char* sensor_type) const
             continue;
         }
         // Check stale timeout
-        if (millis() - entry.timestamp_ms >= VALUE_CACHE_STALE_MS) {
+        if (millis() - entry.timestamp_ms >= max_age_ms) {
             return NAN;
         }
         return entry.value;
@@ -3,6 +3,9 @@
 
 #include <Arduino.h>
 #include "../../models/sensor_types.h"
+#include "reading_validator.h"
+#include "raw_sample_batch.h"
+#include "../../drivers/i2c_sensor_protocol.h"
 
 // ============================================
 // Sensor Manager - Phase 4 Foundation
@@ -26,6 +29,7 @@ struct ManualMeasurementResult {
     String quality = "unknown";
     int32_t raw_value = 0;
     String sensor_type;
+    uint32_t retry_after_ms = 0;  // > 0: probe settling, call again after this delay
 };
 
 class SensorManager {
@@ -102,11 +106,29 @@ public:
 
     // Perform measurements for all active sensors
     // Publishes results via MQTT automatically
-    void performAllMeasurements();
+    // deadline_us (micros, 0 = unbounded): Safety-Task phase budget. At least one
+    // due sensor is measured; after the deadline the pass stops between sensors
+    // and the next call resumes at the first sensor not yet handled.
+    void performAllMeasurements(uint32_t deadline_us = 0);
+
+    // Digital inputs (float_switch, door_contact, ...): publish debounced edges
+    // immediately. Safety-Task, every tick. Returns true if any state changed.
+    bool processDigitalInputs();
 
     // Set measurement interval (Phase 2: Robustness)
     void setMeasurementInterval(unsigned long interval_ms);
 
+    // Quality pipeline: readings rejected by ReadingValidator since boot
+    uint32_t getRejectedReadingCount() const { return readings_rejected_total_; }
+
+    // Raw batching: frames published on sensor/batch and the samples they carried
+    uint32_t getRawBatchFrameCount() const { return raw_batch_frames_; }
+    uint32_t getRawBatchSampleCount() const { return raw_batch_samples_; }
+
+    // Power management: ms until the next continuous-mode measurement is due
+    // (0 = due now, UINT32_MAX = no continuous sensor scheduled)
+    uint32_t getMsUntilNextMeasurement(unsigned long now) const;
+
     // ✅ Phase 2C: Trigger manual measurement for on-demand sensors
     // Returns full outcome contract projection for queue-worker mapping.
     // timeout_ms: Max duration before aborting (E-P3 Timeout-Guard, default 5s)
@@ -115,8 +137,9 @@ public:
     // ============================================
     // RAW DATA READING METHODS (PHASE 4)
     // ============================================
-    // Read raw analog value
-    uint32_t readRawAnalog(uint8_t gpio);
+    // Read raw analog value. false: continuous ADC has no fresh window for
+    // this pin yet (scan restarted / stale) — no sample, not a sensor fault
+    bool readRawAnalog(uint8_t gpio, uint32_t& raw_out);
 
     // E-P2: ADC Validation — checks raw analog value for plausibility
     // Returns quality string: "good", "suspect" (rail/noise), or "error" (invalid)
@@ -130,8 +153,9 @@ public:
     bool readRawI2C(uint8_t gpio, uint8_t device_address, 
                     uint8_t reg, uint8_t* buffer, size_t len);
     
-    // Read raw OneWire data
-    bool readRawOneWire(uint8_t gpio, const uint8_t rom[8], int16_t& raw_value);
+    // Read raw OneWire data (resolution_bits: configured DS18B20 resolution)
+    bool readRawOneWire(uint8_t gpio, const uint8_t rom[8], int16_t& raw_value,
+                        uint8_t resolution_bits = 12);
     
     // ============================================
     // SAFETY-P4: Value Cache
@@ -140,6 +164,11 @@ public:
     // Returns NAN if no valid cache entry exists or entry is older than
     // VALUE_CACHE_STALE_MS (5 minutes).
     float getSensorValue(uint8_t gpio, const char* sensor_type) const;
+    // Same with a caller-defined staleness limit (e.g. compensation temperature)
+    float getSensorValue(uint8_t gpio, const char* sensor_type, unsigned long max_age_ms) const;
+
+    // pH / EC sensor on gpio calibrated on-device (cache holds physical values)
+    bool hasDeviceCalibration(uint8_t gpio, const char* server_sensor_type) const;
 
     // ============================================
     // STATUS QUERIES
@@ -188,6 +217,92 @@ private:
 
     // Update or insert a cache entry (called from publishSensorReading)
     void updateValueCache(uint8_t gpio, const char* sensor_type, float value);
+
+    // ============================================
+    // READING QUALITY PIPELINE
+    // ============================================
+    // One streaming validator per (gpio, sensor_type, address) — multi-value
+    // sensors and shared OneWire buses get independent windows.
+    static const uint8_t MAX_VALIDATOR_ENTRIES = 20;
+
+    struct ValidatorEntry {
+        bool             in_use = false;
+        uint8_t          gpio = 255;
+        uint8_t          i2c_address = 0;
+        char             sensor_type[24] = {0};
+        char             onewire_address[17] = {0};
+        ReadingValidator validator;
+    };
+
+    ValidatorEntry validators_[MAX_VALIDATOR_ENTRIES];
+    uint32_t       readings_rejected_total_ = 0;
+
+    // Returns false if the reading is rejected (not published, counts as CB failure).
+    // SUSPECT readings are published with quality "suspect".
+    bool screenReading(SensorReading& reading);
+    ReadingValidator* findOrCreateValidator(const SensorReading& reading);
+    // Config push / removal: drop history so a new sensor does not inherit the old window
+    void resetReadingValidators(uint8_t gpio);
+
+    // DS18B20: write the configured resolution (no-op if the device already
+    // has it). Returns the resolution to use for conversion waits — the
+    // 12-bit default if the device cannot be configured.
+    uint8_t applyOneWireResolution(uint8_t gpio, const uint8_t rom[8], uint8_t requested_bits);
+
+    // ============================================
+    // RAW SAMPLE BATCHING
+    // ============================================
+    // Streams with batch_max_samples > 1 publish delta-encoded frames on
+    // sensor/batch instead of one publish per sample. Fixed pool — streams
+    // beyond MAX_RAW_BATCH_STREAMS fall back to per-sample publishing.
+    static const uint8_t MAX_RAW_BATCH_STREAMS = 4;
+    static const uint16_t RAW_BATCH_FRAME_MAX_LEN = 640;
+
+    struct RawBatchEntry {
+        bool           in_use = false;
+        uint8_t        gpio = 255;
+        uint8_t        i2c_address = 0;
+        char           sensor_type[24] = {0};
+        char           onewire_address[17] = {0};
+        RawSampleBatch batch;
+    };
+
+    RawBatchEntry raw_batches_[MAX_RAW_BATCH_STREAMS];
+    uint32_t      raw_batch_frames_ = 0;
+    uint32_t      raw_batch_samples_ = 0;
+
+    // Replaces publishSensorReading() for batched streams (value cache is still updated)
+    bool queueRawSample(const SensorConfig& config, const SensorReading& reading);
+    RawBatchEntry* findRawBatch(const SensorConfig& config, bool create);
+    bool flushRawBatch(RawBatchEntry& entry);
+    void flushDueRawBatches(unsigned long now);
+    // Config push / removal: pending samples belong to the old configuration
+    void releaseRawBatches(uint8_t gpio);
+
+    // SHT3x periodic mode: arm at the rate of the shortest active interval of
+    // all value types at i2c_address, or stop it when none remain
+    void syncSht3xPeriodicMode(uint8_t i2c_address);
+
+    // ============================================
+    // I2C DEVICE BINDINGS
+    // ============================================
+    // Protocol, value slots and normalized server types per physical I2C
+    // device, resolved when its sensors are configured. The multi-value
+    // measurement path indexes these directly (no registry/protocol lookup).
+    static const uint8_t MAX_I2C_DEVICE_BINDINGS = 8;
+
+    struct I2CDeviceBinding {
+        bool             in_use;
+        I2CSensorBinding binding;
+        const char*      server_types[I2C_BINDING_MAX_VALUES];  // Per bound value
+    };
+
+    I2CDeviceBinding i2c_bindings_[MAX_I2C_DEVICE_BINDINGS];
+
+    const I2CDeviceBinding* findI2CBinding(uint8_t i2c_address) const;
+    // Config add / update / removal at i2c_address: re-resolve the binding
+    // (or drop it when no sensor remains) and sync SHT3x periodic mode
+    void refreshI2CDevice(uint8_t i2c_address);
     
     // Component references
     class MQTTClient* mqtt_client_;
@@ -198,6 +313,8 @@ private:
     // Measurement timing
     unsigned long last_measurement_time_;
     unsigned long measurement_interval_;  // 30s default
+    uint8_t measurement_cursor_;          // Resume index after a budget-split pass
+    bool measurement_deferred_;           // Last measurement had no ADC window (retry, no CB count)
     
     // ============================================
     // HELPER METHODS
@@ -214,6 +331,25 @@ private:
 
     // Internal: measurement with known config (avoids GPIO-only re-lookup for multi-sensor GPIOs)
     bool performMeasurementForConfig(SensorConfig* config, SensorReading& reading_out);
+
+    // Analog read + ADC quality; false (measurement_deferred_) when no window is available yet
+    bool readAnalogProbe(uint8_t gpio, uint32_t& raw_value, SensorReading& reading_out);
+
+    // Pulse counter (flow_meter, rain_gauge): rate → reading_out, total published directly
+    bool performPulseMeasurement(SensorConfig* config, const SensorCapability* capability,
+                                 SensorReading& reading_out);
+
+    // pH / EC: linear calibration + temperature compensation from the value cache
+    void applyCalibration(const SensorConfig* config, SensorReading& reading) const;
+
+    // Switched probe supply (analog probes): attach / update / drop the excitation pin
+    bool applyExcitation(const SensorConfig& config, const SensorCapability* capability);
+    // Powers the probe if needed; ms until it can be read (0 = read now / no excitation)
+    uint32_t prepareExcitation(uint8_t gpio, uint32_t now_ms);
+
+    // Digital input: debounced level → reading (value 1 = active)
+    void fillDigitalInputReading(const SensorConfig* config, const SensorCapability* capability,
+                                 bool level, SensorReading& reading_out) const;
     
     // Publish sensor reading via MQTT
     bool publishSensorReading(const SensorReading& reading);
@@ -0,0 +1,54 @@
+#include "temperature_compensation.h"
+
+#include <cmath>
+#include <cstring>
+
+// Kelvin offset and 2.303 * R / F (mV/K) for the Nernst slope
+static const float TEMP_COMP_KELVIN = 273.15f;
+static const float TEMP_COMP_NERNST_MV_PER_K = 0.198416f;
+static const float TEMP_COMP_PH_ISOPOTENTIAL = 7.0f;
+
+TempCompKind TemperatureCompensation::kindForSensorType(const char* server_sensor_type) {
+    if (server_sensor_type == nullptr) {
+        return TempCompKind::NONE;
+    }
+    if (strcmp(server_sensor_type, "ec") == 0) {
+        return TempCompKind::EC;
+    }
+    if (strcmp(server_sensor_type, "ph") == 0) {
+        return TempCompKind::PH;
+    }
+    return TempCompKind::NONE;
+}
+
+float TemperatureCompensation::compensateEC(float ec_at_temp, float temp_c, float alpha) {
+    float factor = 1.0f + alpha * (temp_c - TEMP_COMP_REFERENCE_C);
+    if (factor <= 0.0f) {
+        return ec_at_temp;  // alpha out of range for this temperature
+    }
+    return ec_at_temp / factor;
+}
+
+float TemperatureCompensation::compensatePH(float ph_uncompensated, float temp_c) {
+    float slope_ratio = (TEMP_COMP_REFERENCE_C + TEMP_COMP_KELVIN) / (temp_c + TEMP_COMP_KELVIN);
+    return TEMP_COMP_PH_ISOPOTENTIAL + (ph_uncompensated - TEMP_COMP_PH_ISOPOTENTIAL) * slope_ratio;
+}
+
+float TemperatureCompensation::nernstSlopeMv(float temp_c) {
+    return TEMP_COMP_NERNST_MV_PER_K * (temp_c + TEMP_COMP_KELVIN);
+}
+
+TempCompResult TemperatureCompensation::apply(TempCompKind kind, float value, float temp_c, float ec_alpha) {
+    TempCompResult result = { value, false };
+    if (kind == TempCompKind::NONE || std::isnan(temp_c) ||
+        temp_c < TEMP_COMP_MIN_C || temp_c > TEMP_COMP_MAX_C) {
+        return result;
+    }
+    if (kind == TempCompKind::EC) {
+        result.value = compensateEC(value, temp_c, ec_alpha);
+    } else {
+        result.value = compensatePH(value, temp_c);
+    }
+    result.compensated = true;
+    return result;
+}
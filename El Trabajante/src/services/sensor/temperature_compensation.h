@@ -0,0 +1,59 @@
+#ifndef SERVICES_SENSOR_TEMPERATURE_COMPENSATION_H
+#define SERVICES_SENSOR_TEMPERATURE_COMPENSATION_H
+
+#include <stdint.h>
+
+// ============================================
+// TEMPERATURE COMPENSATION (EC, pH)
+// ============================================
+// Sensor fusion stage for electrochemical probes. The probe value comes from
+// the per-sensor linear calibration (raw * cal_slope + cal_offset, calibrated
+// at 25 °C); the solution temperature is the cached value of a co-located
+// temperature sensor (e.g. DS18B20 in the same tank).
+//
+//   EC: linear model, reported at 25 °C
+//       EC25 = EC_T / (1 + alpha * (T - 25))         alpha ≈ 0.019-0.021 / °C
+//   pH: Nernst slope scales with absolute temperature around the
+//       isopotential point pH 7 (electrode response, not solution chemistry)
+//       pH_T = 7 + (pH_lin - 7) * (25 + 273.15) / (T + 273.15)
+//
+// No Arduino dependencies — unit-tested on native against reference tables
+// (KCl 1413 µS/cm standard, Nernst slope table).
+// ============================================
+
+enum class TempCompKind : uint8_t {
+    NONE = 0,
+    EC,
+    PH
+};
+
+static const float TEMP_COMP_REFERENCE_C = 25.0f;
+static const float TEMP_COMP_DEFAULT_EC_ALPHA = 0.02f;     // 2 %/°C (typical nutrient solution)
+static const uint16_t TEMP_COMP_DEFAULT_MAX_AGE_S = 120;   // Temperature older than this → not applied
+static const float TEMP_COMP_MIN_C = -5.0f;                // Plausible solution temperature range
+static const float TEMP_COMP_MAX_C = 80.0f;
+
+struct TempCompResult {
+    float value;         // Compensated value (uncompensated if !compensated)
+    bool compensated;
+};
+
+class TemperatureCompensation {
+public:
+    // Normalized server sensor type → compensation model ("ec", "ph")
+    static TempCompKind kindForSensorType(const char* server_sensor_type);
+
+    // Conductivity at temp_c → conductivity at 25 °C
+    static float compensateEC(float ec_at_temp, float temp_c, float alpha);
+
+    // pH from a 25 °C calibration, measured at temp_c → true pH
+    static float compensatePH(float ph_uncompensated, float temp_c);
+
+    // Theoretical electrode slope in mV/pH (59.16 at 25 °C)
+    static float nernstSlopeMv(float temp_c);
+
+    // Applies the model; temperature NAN / implausible → uncompensated value
+    static TempCompResult apply(TempCompKind kind, float value, float temp_c, float ec_alpha);
+};
+
+#endif
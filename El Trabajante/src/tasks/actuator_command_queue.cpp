@@ -5,9 +5,11 @@
 #include "../services/communication/mqtt_client.h"
 #include "../utils/logger.h"
 #include "../error_handling/error_tracker.h"
+#include "../error_handling/resource_monitor.h"
 #include "../models/error_codes.h"
 #include "../models/system_types.h"
 #include "command_admission.h"
+#include "safety_task.h"  // notifySafetyTaskQueueWork()
 
 static const char* ACT_Q_TAG = "SYNC";
 
@@ -15,7 +17,7 @@ QueueHandle_t g_actuator_cmd_queue = NULL;
 extern SystemConfig g_system_config;
 
 void initActuatorCommandQueue() {
-    g_actuator_cmd_queue = xQueueCreate(ACTUATOR_CMD_QUEUE_SIZE, sizeof(ActuatorMqttQueueItem));
+    g_actuator_cmd_queue = xQueueCreate(ACTUATOR_CMD_QUEUE_SIZE, sizeof(ActuatorCommandRecord));
     if (g_actuator_cmd_queue == NULL) {
         LOG_E(ACT_Q_TAG, "[SYNC] Failed to create actuator command queue");
     }
@@ -23,34 +25,30 @@ void initActuatorCommandQueue() {
 
 bool queueActuatorCommand(const char* topic, const char* payload, const IntentMetadata* metadata) {
     if (g_actuator_cmd_queue == NULL) return false;
-    ActuatorMqttQueueItem cmd;
-    strncpy(cmd.topic, topic, sizeof(cmd.topic) - 1);
-    cmd.topic[sizeof(cmd.topic) - 1] = '\0';
-    strncpy(cmd.payload, payload, sizeof(cmd.payload) - 1);
-    cmd.payload[sizeof(cmd.payload) - 1] = '\0';
-    IntentMetadata fallback_meta = extractIntentMetadataFromPayload(payload, "cmd");
-    cmd.metadata = fallback_meta;
-    if (metadata != nullptr) {
-        cmd.metadata = *metadata;
-    }
-    bool recovery_intent = isRecoveryIntentAllowed(topic, payload);
+    // Decode once on Core 0; Core 1 only executes the POD record
+    ActuatorCommandRecord cmd;
+    decodeActuatorCommand(topic, payload, cmd);
+    cmd.metadata = metadata != nullptr ? *metadata : extractIntentMetadataFromPayload(payload, "cmd");
+    cmd.recovery_intent = isRecoveryIntentAllowed(topic, payload);
+    bool recovery_intent = cmd.recovery_intent;
     BaseType_t queued = recovery_intent
                         ? xQueueSendToFront(g_actuator_cmd_queue, &cmd, pdMS_TO_TICKS(20))
                         : xQueueSend(g_actuator_cmd_queue, &cmd, 0);
     if (queued != pdTRUE) {
-        LOG_W(ACT_Q_TAG, "[SYNC] Actuator command queue full — dropping: " + String(cmd.topic));
+        LOG_W(ACT_Q_TAG, "[SYNC] Actuator command queue full — dropping: " + String(topic));
         errorTracker.logApplicationError(ERROR_TASK_QUEUE_FULL, "Actuator command queue full");
         return false;
     }
     if (recovery_intent) {
         LOG_I(ACT_Q_TAG, "[SYNC] Recovery actuator intent prioritized to queue front");
     }
+    notifySafetyTaskQueueWork();
     return true;
 }
 
 void flushActuatorCommandQueue() {
     if (g_actuator_cmd_queue == NULL) return;
-    ActuatorMqttQueueItem dropped;
+    ActuatorCommandRecord dropped;
     uint16_t dropped_count = 0;
     while (xQueueReceive(g_actuator_cmd_queue, &dropped, 0) == pdTRUE) {
         publishIntentOutcome("command",
@@ -69,14 +67,14 @@ void flushActuatorCommandQueue() {
 
 void processActuatorCommandQueue(uint8_t max_items) {
     if (g_actuator_cmd_queue == NULL) return;
-    ActuatorMqttQueueItem cmd;
+    ActuatorCommandRecord cmd;
     uint8_t processed = 0;
     uint32_t epoch = getSafetyEpoch();
     while (processed < max_items && xQueueReceive(g_actuator_cmd_queue, &cmd, 0) == pdTRUE) {
         IntentInvalidationReason invalidation_reason =
             getIntentInvalidationReason(cmd.metadata, epoch);
         if (invalidation_reason != IntentInvalidationReason::NONE &&
-            !isRecoveryIntentAllowed(cmd.topic, cmd.payload)) {
+            !cmd.recovery_intent) {
             publishIntentOutcome("command",
                                  cmd.metadata,
                                  "expired",
@@ -96,9 +94,10 @@ void processActuatorCommandQueue(uint8_t max_items) {
             g_system_config.current_state == STATE_PENDING_APPROVAL,
             g_system_config.current_state == STATE_SAFE_MODE ||
                 g_system_config.current_state == STATE_SAFE_MODE_PROVISIONING ||
-                g_system_config.current_state == STATE_ERROR,
+                g_system_config.current_state == STATE_ERROR ||
+                g_system_config.current_state == STATE_LIBRARY_DOWNLOADING,
             g_system_config.current_state == STATE_SAFE_MODE,
-            isRecoveryIntentAllowed(cmd.topic, cmd.payload),
+            cmd.recovery_intent,
             nullptr
         };
         CommandAdmissionDecision admission = shouldAcceptCommand(CommandSubtype::ACTUATOR, admission_context);
@@ -112,7 +111,11 @@ void processActuatorCommandQueue(uint8_t max_items) {
             processed++;
             continue;
         }
-        bool ok = actuatorManager.handleActuatorCommand(String(cmd.topic), String(cmd.payload));
+        bool ok;
+        {
+            HeapDeltaScope heap_scope(HeapSubsystem::COMMAND_HANDLING);
+            ok = actuatorManager.executeActuatorCommand(cmd);
+        }
         publishIntentOutcome("command",
                              cmd.metadata,
                              ok ? "applied" : "failed",
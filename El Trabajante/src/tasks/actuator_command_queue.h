@@ -3,15 +3,12 @@
 #include <freertos/queue.h>
 
 #include "intent_contract.h"
+#include "../services/actuator/actuator_command_decoder.h"
 
 static const uint8_t ACTUATOR_CMD_QUEUE_SIZE = 10;
 
-/** Raw MQTT topic+payload for Core 0 → Safety-Task queue (distinct from models::ActuatorCommand). */
-struct ActuatorMqttQueueItem {
-    char topic[128];
-    char payload[512];
-    IntentMetadata metadata;
-};
+// Queue item: ActuatorCommandRecord, decoded once on Core 0 in queueActuatorCommand().
+// The Safety-Task executes it without re-parsing topic or payload.
 
 extern QueueHandle_t g_actuator_cmd_queue;
 
@@ -7,6 +7,8 @@
 
 #include "communication_task.h"
 #include "publish_queue.h"
+#include "task_wake.h"
+#include "intent_contract.h"
 
 #include <Arduino.h>
 #include <WiFi.h>
@@ -15,12 +17,14 @@
 #include <freertos/portmacro.h>
 
 #include "../utils/logger.h"
+#include "../utils/log_shipper.h"
 #include "../utils/topic_builder.h"
 #include "../utils/time_manager.h"
 #include "../utils/watchdog_storage.h"
 #include "../services/communication/wifi_manager.h"
 #include "../services/communication/mqtt_client.h"
 #include "../services/config/config_manager.h"
+#include "../services/config/library_manager.h"
 #include "../services/provisioning/provision_manager.h"
 #include "../services/provisioning/portal_authority.h"
 #include "../services/actuator/actuator_manager.h"
@@ -29,10 +33,14 @@
 #include "../models/error_codes.h"
 #include "../error_handling/circuit_breaker.h"
 #include "../error_handling/error_tracker.h"
+#include "../error_handling/resource_monitor.h"
+#include "../services/power/power_manager.h"
+#include "../core/system_controller.h"
 
 static const char* COMM_TAG = "COMM";
 
 static TaskHandle_t s_comm_task_handle = NULL;
+static TaskWake     s_comm_wake;
 
 // FreeRTOS stack depth is in words, not bytes.
 // Keep the intended 6 KB stack budget and convert explicitly.
@@ -42,6 +50,12 @@ static const UBaseType_t COMM_TASK_PRIORITY   = 3;    // Below Safety-Task (5)
 static const BaseType_t  COMM_TASK_CORE       = 0;    // PRO_CPU (WiFi-Stack co-located)
 
 static const unsigned long ACTUATOR_STATUS_INTERVAL_MS      = 30000;
+static const unsigned long RESOURCE_SAMPLE_INTERVAL_MS      = 10000;
+static const uint32_t      RESTRICTED_MODE_MAX_BLOCK_MS     = 100;
+
+// Periodic job timestamps (file scope so the wake deadline can be computed)
+static unsigned long s_last_actuator_status_ms = 0;
+static unsigned long s_last_resource_sample_ms = 0;
 static const unsigned long PORTAL_OPEN_DEBOUNCE_MS           = 30000;
 static const unsigned long MQTT_PERSISTENT_FAILURE_TIMEOUT_MS = 300000;  // 5 minutes
 
@@ -75,8 +89,7 @@ static void handleProvisioningState() {
             provisionManager.stop();
             portal_open_due_to_disconnect_ = false;
             WiFi.mode(WIFI_STA);  // Back to STA-only
-            g_system_config.current_state = STATE_OPERATIONAL;
-            g_system_config.safe_mode_reason = "";
+            systemController.handleEvent(SystemEvent::PORTAL_RECONNECTED, millis());
             configManager.saveSystemConfig(g_system_config);
         }
     }
@@ -89,6 +102,7 @@ static void handleProvisioningState() {
         configManager.loadWiFiConfig(g_wifi_config);
         LOG_I(COMM_TAG, "WiFi SSID: " + g_wifi_config.ssid);
         LOG_I(COMM_TAG, "Rebooting to apply configuration...");
+        flushIntentOutcomeBatches(true);
         delay(2000);
         ESP.restart();
     }
@@ -97,12 +111,13 @@ static void handleProvisioningState() {
 // ============================================
 // STATIC HELPER: WiFi Disconnect Debounce
 // ============================================
-// Opens config portal after 30 s of continuous MQTT disconnect in OPERATIONAL state.
+// Opens config portal after 30 s of continuous MQTT disconnect in states with
+// the LINK_WATCH lane (OPERATIONAL).
 // Mirrors the debounce block that was in loop().
 static void handleWifiDisconnectDebounce() {
     static unsigned long disconnect_start = 0;
 
-    if (g_system_config.current_state == STATE_OPERATIONAL && !mqttClient.isConnected() && !WiFi.isConnected()) {
+    if (systemController.allows(SYSTEM_WORK_LINK_WATCH) && !mqttClient.isConnected() && !WiFi.isConnected()) {
         if (disconnect_start == 0) {
             disconnect_start = millis();
         } else if (millis() - disconnect_start > PORTAL_OPEN_DEBOUNCE_MS
@@ -119,7 +134,7 @@ static void handleWifiDisconnectDebounce() {
                 return;
             }
             LOG_I(COMM_TAG, "Config-Portal geoeffnet (Server getrennt), Reconnect laeuft im Hintergrund");
-            g_system_config.current_state = STATE_SAFE_MODE_PROVISIONING;
+            systemController.handleEvent(SystemEvent::PROVISIONING_REQUIRED, millis());
             g_system_config.safe_mode_reason =
                 "MQTT disconnected (" + String(PORTAL_OPEN_DEBOUNCE_MS / 1000) + "s)";
             configManager.saveSystemConfig(g_system_config);
@@ -163,7 +178,7 @@ static void handleMqttPersistentFailure() {
                 LOG_C(COMM_TAG, "║  MQTT PERSISTENT FAILURE (5 min)       ║");
                 LOG_C(COMM_TAG, "║  Config-Portal oeffnen...              ║");
                 LOG_C(COMM_TAG, "╚════════════════════════════════════════╝");
-                g_system_config.current_state = STATE_SAFE_MODE_PROVISIONING;
+                systemController.handleEvent(SystemEvent::PROVISIONING_REQUIRED, millis());
                 g_system_config.safe_mode_reason =
                     "MQTT persistent failure (5 min Circuit Breaker OPEN)";
                 configManager.saveSystemConfig(g_system_config);
@@ -189,10 +204,32 @@ static void handleMqttPersistentFailure() {
 // STATIC HELPER: Periodic Actuator Status Publish
 // ============================================
 static void handleActuatorStatusPublish() {
-    static unsigned long last_actuator_status = 0;
-    if (millis() - last_actuator_status > ACTUATOR_STATUS_INTERVAL_MS) {
+    if (millis() - s_last_actuator_status_ms > ACTUATOR_STATUS_INTERVAL_MS) {
         actuatorManager.publishAllActuatorStatus();
-        last_actuator_status = millis();
+        s_last_actuator_status_ms = millis();
+    }
+}
+
+// ============================================
+// STATIC HELPER: Remote Log Shipping
+// ============================================
+// Pulls new Logger ring entries into the shipper and publishes at most one
+// budgeted frame per wake (QoS 0). Entries stay staged while MQTT is down;
+// the staging queue sheds the lowest levels first if that takes too long.
+static void processLogShipping() {
+    if (!logShipper.isEnabled()) {
+        return;
+    }
+    logShipper.collect(logger);
+
+    uint32_t now = static_cast<uint32_t>(millis());
+    if (!logShipper.isDue(now) || !mqttClient.isConnected()) {
+        return;
+    }
+    static char frame[LOG_SHIPPER_MAX_FRAME];
+    size_t len = logShipper.buildFrame(now, frame, sizeof(frame));
+    if (len > 0) {
+        mqttClient.publish(TopicBuilder::buildSystemLogTopic(), frame, 0);
     }
 }
 
@@ -213,7 +250,7 @@ static void handleActuatorStatusPublish() {
 // esp_mqtt_client_publish() (see MQTTClient::publish), so it does NOT consume a
 // g_publish_queue slot. The saturation-skip is kept per the PKG-01a contract.
 // Implemented only on the ESP-IDF MQTT path — PubSubClient builds have no
-// Core 1 → Core 0 publish queue. Runs at 50 ms cadence (Comm-Task loop).
+// Core 1 → Core 0 publish queue. Runs on every Comm-Task wake (enqueue or deadline).
 #ifndef MQTT_USE_PUBSUBCLIENT
 static const uint8_t PRESSURE_RECOVERED_THRESHOLD = 4;  // Dead band upper bound (exclusive)
 
@@ -298,9 +335,15 @@ static void handleQueuePressureHysteresis() {
 // STATIC HELPER: Heap Monitoring (every 60 s)
 // ============================================
 // SAFETY-RTOS M4: Detect memory leaks from queue/mutex overhead or large config payloads.
+// Stack watermarks of all registered tasks are sampled every 10 s (ResourceMonitor,
+// mirrored to RTC memory so the last values survive a WDT/panic reset).
 static void handleHeapMonitoring() {
     static unsigned long last_heap_log = 0;
     static const unsigned long HEAP_LOG_INTERVAL_MS = 60000;
+    if (millis() - s_last_resource_sample_ms > RESOURCE_SAMPLE_INTERVAL_MS) {
+        s_last_resource_sample_ms = millis();
+        resourceMonitor.sample();
+    }
     if (millis() - last_heap_log > HEAP_LOG_INTERVAL_MS) {
         last_heap_log = millis();
         String extra;
@@ -327,11 +370,74 @@ static void handleBootCounterReset() {
     }
 }
 
+// ============================================
+// STATIC HELPER: Wake Deadline
+// ============================================
+static uint32_t msUntilPeriodic(unsigned long now, unsigned long last_ms, unsigned long interval_ms) {
+    unsigned long elapsed = now - last_ms;
+    return elapsed > interval_ms ? 0 : static_cast<uint32_t>(interval_ms - elapsed);
+}
+
+// Maximum block time for the next wait: 50 ms while reconnecting or draining,
+// otherwise until the earliest periodic deadline (heartbeat, actuator status,
+// resource sampling), capped at comm_idle_delay_ms (see PowerManager).
+// Queued publishes do not need polling — queuePublish() wakes the task.
+static uint32_t computeCommLoopDelayMs() {
+    unsigned long now = millis();
+    uint32_t next_periodic = mqttClient.getMsUntilNextHeartbeat(now);
+    uint32_t next_status = msUntilPeriodic(now, s_last_actuator_status_ms, ACTUATOR_STATUS_INTERVAL_MS);
+    uint32_t next_sample = msUntilPeriodic(now, s_last_resource_sample_ms, RESOURCE_SAMPLE_INTERVAL_MS);
+    if (next_status < next_periodic) {
+        next_periodic = next_status;
+    }
+    if (next_sample < next_periodic) {
+        next_periodic = next_sample;
+    }
+    uint32_t next_outcome = getIntentOutcomeFlushDelayMs(static_cast<uint32_t>(now));
+    if (next_outcome < next_periodic) {
+        next_periodic = next_outcome;
+    }
+    // Staged log entries must not wait longer than the shipper's flush interval
+    if (logShipper.isEnabled() && logShipper.getConfig().flush_interval_ms < next_periodic) {
+        next_periodic = logShipper.getConfig().flush_interval_ms;
+    }
+
+    PowerDeadlineInputs inputs;
+    inputs.next_measurement_in_ms = POWER_DEADLINE_NONE;
+    inputs.next_offline_eval_in_ms = POWER_DEADLINE_NONE;
+    inputs.next_heartbeat_in_ms = next_periodic;
+    inputs.actuator_running = false;
+    inputs.work_pending = g_publish_queue != NULL && uxQueueMessagesWaiting(g_publish_queue) > 0;
+#ifdef OTA_LIBRARY_ENABLED
+    inputs.work_pending = inputs.work_pending || libraryManager.hasPendingWork();  // Delta COPY steps
+#endif
+    inputs.link_up = WiFi.status() == WL_CONNECTED && mqttClient.isConnected();
+    inputs.keep_apb_clock = false;  // Only the Safety-Task decides on light sleep
+    return PowerManager::computeCommDelayMs(inputs, powerManager.getConfig());
+}
+
+// ============================================
+// WAKE SIGNAL
+// ============================================
+void notifyCommTaskPublishWork() {
+    s_comm_wake.signal(COMM_WAKE_PUBLISH);
+}
+
+void notifyCommTaskStateChange() {
+    s_comm_wake.signal(COMM_WAKE_STATE);
+}
+
+void getCommTaskWakeStats(uint32_t& event_wakes, uint32_t& timeout_wakes) {
+    event_wakes = s_comm_wake.getEventWakes();
+    timeout_wakes = s_comm_wake.getTimeoutWakes();
+}
+
 // ============================================
 // TASK FUNCTION
 // ============================================
 void communicationTaskFunction(void* param) {
     (void)param;
+    s_comm_wake.attachCurrentTask();
     LOG_I(COMM_TAG, "[COMM] Communication task running on core " + String(xPortGetCoreID()));
 
     for (;;) {
@@ -341,17 +447,21 @@ void communicationTaskFunction(void* param) {
         // WDT timeout recovery (diagnostics snapshot + MQTT alert)
         handleWatchdogTimeout();
 
+        // Lanes of the current state (SystemController work mask). A state
+        // change signals COMM_WAKE_STATE, so the next pass re-dispatches at once.
+        const uint8_t work = systemController.getWorkMask();
+
         // ── Provisioning Mode ──────────────────────────────────────────
-        if (g_system_config.current_state == STATE_SAFE_MODE_PROVISIONING) {
+        if (work & SYSTEM_WORK_PORTAL) {
             handleProvisioningState();
-            vTaskDelay(pdMS_TO_TICKS(50));
+            s_comm_wake.wait(50);
             continue;
         }
 
         // ── Restricted Admission Mode ───────────────────────────────────
-        // Keep only WiFi+MQTT alive while control planes stay blocked.
-        if (g_system_config.current_state == STATE_PENDING_APPROVAL ||
-            g_system_config.current_state == STATE_CONFIG_PENDING_AFTER_RESET) {
+        // Keep only WiFi+MQTT alive while control planes stay blocked
+        // (PENDING_APPROVAL, CONFIG_PENDING_AFTER_RESET).
+        if (!(work & SYSTEM_WORK_CONTROL)) {
             wifiManager.loop();
             mqttClient.loop();
 #ifndef MQTT_USE_PUBSUBCLIENT
@@ -360,7 +470,8 @@ void communicationTaskFunction(void* param) {
             mqttClient.checkRegistrationTimeout();
             mqttClient.processPublishQueue();
 #endif
-            vTaskDelay(pdMS_TO_TICKS(100));  // Slower tick — no sensor/actuator work
+            flushIntentOutcomeBatches(false);
+            s_comm_wake.wait(RESTRICTED_MODE_MAX_BLOCK_MS);  // Slower tick — no sensor/actuator work
             continue;
         }
 
@@ -373,6 +484,12 @@ void communicationTaskFunction(void* param) {
         mqttClient.checkRegistrationTimeout();
         mqttClient.processPublishQueue();  // Drain Core 1 → Core 0 publish queue
 #endif
+        flushIntentOutcomeBatches(false);   // Intent outcome lanes whose window expired
+        errorTracker.processPendingPublishes();  // Deferred error events (formatted here, not at the failure site)
+        processLogShipping();                    // Remote log frames within the configured budget
+#ifdef OTA_LIBRARY_ENABLED
+        libraryManager.loop(millis());            // Boot validation / reboot after OTA
+#endif
 
         handleBootCounterReset();
         handleWifiDisconnectDebounce();
@@ -383,7 +500,8 @@ void communicationTaskFunction(void* param) {
 #endif
         handleHeapMonitoring();
 
-        vTaskDelay(pdMS_TO_TICKS(50));
+        // Block until queuePublish() signals or the next deadline is reached
+        s_comm_wake.wait(computeCommLoopDelayMs());
     }
 }
 
@@ -416,6 +534,8 @@ bool createCommunicationTask() {
                   "[COMM] Communication task created (stack_depth=" +
                   String((uint32_t)stack_depth) + ", stack_bytes=" +
                   String((uint32_t)(stack_depth * sizeof(StackType_t))) + ")");
+            resourceMonitor.registerTask("CommTask", s_comm_task_handle,
+                                         (uint32_t)(stack_depth * sizeof(StackType_t)));
             return true;
         }
 
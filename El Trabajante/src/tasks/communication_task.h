@@ -23,3 +23,21 @@ bool createCommunicationTask();
 
 // Task function (runs endlessly on Core 0).
 void communicationTaskFunction(void* param);
+
+// ============================================
+// Comm-Task Wake Bits
+// ============================================
+// The Comm-Task blocks on a task notification (TaskWake) until its next
+// deadline (heartbeat, periodic status, resource sampling) — work queued from
+// other tasks wakes it immediately instead of waiting for a 50 ms poll tick.
+static const uint32_t COMM_WAKE_PUBLISH = 0x01;  // queuePublish() enqueued a request
+static const uint32_t COMM_WAKE_STATE = 0x02;    // SystemController changed the state
+
+// Called by queuePublish() after a successful enqueue (no-op before task start).
+void notifyCommTaskPublishWork();
+
+// Called by the SystemController transition listener (no-op before task start).
+void notifyCommTaskStateChange();
+
+// Diagnostics: wake-ups caused by signalled work vs. deadline timeouts.
+void getCommTaskWakeStats(uint32_t& event_wakes, uint32_t& timeout_wakes);
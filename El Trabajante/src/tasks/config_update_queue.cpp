@@ -5,6 +5,7 @@
 #include <Preferences.h>
 #include <esp_log.h>
 #include "../utils/logger.h"
+#include "../error_handling/resource_monitor.h"
 #include "../services/config/config_response.h"
 #include "../services/config/config_manager.h"
 #include "../services/communication/mqtt_client.h"
@@ -12,6 +13,7 @@
 #include "../models/system_types.h"
 #include "../models/config_types.h"
 #include "command_admission.h"
+#include "safety_task.h"  // notifySafetyTaskQueueWork()
 
 // ─── Forward declarations — defined in main.cpp ──────────────────────────────
 // CP-F2: Handlers receive pre-parsed root JsonObject + correlationId.
@@ -467,6 +469,7 @@ bool queueConfigUpdateWithMetadata(ConfigUpdateRequest::Type type,
         return false;
     }
     persistPendingIntent(req);
+    notifySafetyTaskQueueWork();
     publishIntentOutcome("config",
                          req.metadata,
                          "accepted",
@@ -545,6 +548,9 @@ void processConfigUpdateQueue(uint8_t max_items) {
             continue;
         }
 
+        // Heap retained by parse + apply + persist (reported in diagnostics "heap_delta")
+        HeapDeltaScope heap_scope(HeapSubsystem::CONFIG_APPLY);
+
         // CP-F2: Parse once into module-level static doc — eliminates 4x DynamicJsonDocument
         // alloc/free cycle (was: 2048+256+2048+2048 = 6400 B per Config-Push, causing heap
         // fragmentation and intermittent NoMemory failures on repeated pushes).
@@ -9,10 +9,13 @@
 #include <freertos/semphr.h>
 #include <freertos/task.h>
 
+#include "../config/feature_flags.h"
 #include "../services/communication/mqtt_client.h"
 #include "../utils/logger.h"
 #include "../utils/time_manager.h"
 #include "../utils/topic_builder.h"
+#include "communication_task.h"
+#include "intent_outcome_batcher.h"
 #ifndef MQTT_USE_PUBSUBCLIENT
 #include "publish_queue.h"
 #endif
@@ -37,9 +40,22 @@ static const char* kOutboxStatRecoveredTotalKey = "recovered_total";
 static const char* kOutboxStatDropTotalKey = "drop_total";
 // NVS keys are limited in length, keep this short.
 static const char* kOutboxStatFinalConfirmedTotalKey = "fin_ok_total";
+// Batch outbox: one blob per undeliverable critical batch ("b<idx>"), ring of
+// OUTCOME_OUTBOX_CAPACITY slots sharing an item budget of the same size.
+static const char* kOutboxBatchHeadKey = "b_head";
+static const char* kOutboxBatchCountKey = "b_count";
+static const char* kOutboxBatchItemsKey = "b_items";
 static SemaphoreHandle_t s_outbox_mutex = nullptr;
 static portMUX_TYPE s_outbox_mutex_init_mux = portMUX_INITIALIZER_UNLOCKED;
 
+// Flush/replay scratch (too large for task stacks) — guarded by the outbox mutex
+static IntentOutcomeBatch s_outcome_flush_batch;
+static uint8_t s_outcome_blob_buffer[INTENT_OUTCOME_BLOB_MAX_SIZE];
+#ifdef ENABLE_INTENT_OUTCOME_BATCHING
+static IntentOutcomeBatcher s_outcome_batcher;
+static portMUX_TYPE s_outcome_batch_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
 struct IntentFinalEntry {
     char intent_id[INTENT_ID_MAX_LEN];
     char final_outcome[16];
@@ -208,12 +224,7 @@ static void loadOutboxStatsIfNeeded() {
     loadOutboxStatsLocked();
 }
 
-static void persistOutboxStats() {
-    OutboxLockGuard guard;
-    if (!guard.locked()) {
-        LOG_W(IC_TAG, "Outbox stats lock timeout (persist)");
-        return;
-    }
+static void persistOutboxStatsLocked() {
     if (!beginOutcomeOutboxPrefs(false)) {
         return;
     }
@@ -225,6 +236,15 @@ static void persistOutboxStats() {
     s_outcome_outbox_prefs.end();
 }
 
+static void persistOutboxStats() {
+    OutboxLockGuard guard;
+    if (!guard.locked()) {
+        LOG_W(IC_TAG, "Outbox stats lock timeout (persist)");
+        return;
+    }
+    persistOutboxStatsLocked();
+}
+
 static bool saveOutboxEntryAt(uint8_t idx, const PendingOutcomeEntry& entry) {
     s_outcome_outbox_prefs.putString(outboxKey(idx, "flow").c_str(), String(entry.flow));
     s_outcome_outbox_prefs.putString(outboxKey(idx, "intent").c_str(), String(entry.metadata.intent_id));
@@ -320,6 +340,84 @@ static bool enqueueCriticalOutcome(const PendingOutcomeEntry& entry) {
     return true;
 }
 
+// ============================================
+// BATCH OUTBOX (one NVS blob per batch)
+// ============================================
+static String outboxBatchKey(uint8_t idx) {
+    return "b" + String(idx);
+}
+
+// Prefs open, outbox lock held. Decodes into batch_out via the shared blob buffer.
+static bool loadOutboxBatchAt(uint8_t idx, IntentOutcomeBatch* batch_out) {
+    String key = outboxBatchKey(idx);
+    size_t len = s_outcome_outbox_prefs.getBytesLength(key.c_str());
+    if (len == 0 || len > sizeof(s_outcome_blob_buffer)) {
+        return false;
+    }
+    if (s_outcome_outbox_prefs.getBytes(key.c_str(), s_outcome_blob_buffer, len) != len) {
+        return false;
+    }
+    return decodeIntentOutcomeBatch(s_outcome_blob_buffer, len, batch_out);
+}
+
+static bool saveOutboxBatchAt(uint8_t idx, const IntentOutcomeBatch& batch) {
+    size_t len = encodeIntentOutcomeBatch(batch, s_outcome_blob_buffer, sizeof(s_outcome_blob_buffer));
+    if (len == 0) {
+        return false;
+    }
+    return s_outcome_outbox_prefs.putBytes(outboxBatchKey(idx).c_str(), s_outcome_blob_buffer, len) == len;
+}
+
+// Item count from the blob header without decoding (eviction accounting)
+static uint8_t peekOutboxBatchItems(uint8_t idx) {
+    String key = outboxBatchKey(idx);
+    size_t len = s_outcome_outbox_prefs.getBytesLength(key.c_str());
+    if (len < INTENT_OUTCOME_BLOB_HEADER_SIZE || len > sizeof(s_outcome_blob_buffer) ||
+        s_outcome_outbox_prefs.getBytes(key.c_str(), s_outcome_blob_buffer, len) != len ||
+        s_outcome_blob_buffer[0] != INTENT_OUTCOME_BLOB_VERSION) {
+        return 0;
+    }
+    return s_outcome_blob_buffer[2];
+}
+
+// Outbox lock held, prefs closed. One putBytes() per batch instead of 12 keys per outcome.
+static bool enqueueCriticalBatchLocked(const IntentOutcomeBatch& batch) {
+    if (!beginOutcomeOutboxPrefs(false)) {
+        return false;
+    }
+    uint8_t head = s_outcome_outbox_prefs.getUChar(kOutboxBatchHeadKey, 0);
+    uint8_t count = s_outcome_outbox_prefs.getUChar(kOutboxBatchCountKey, 0);
+    uint8_t items = s_outcome_outbox_prefs.getUChar(kOutboxBatchItemsKey, 0);
+
+    // Same P0 strategy as the per-entry outbox: evict oldest batches until the new one fits
+    while (count > 0 && (count >= OUTCOME_OUTBOX_CAPACITY ||
+                         items + batch.count > OUTCOME_OUTBOX_CAPACITY)) {
+        uint8_t evicted = peekOutboxBatchItems(head);
+        prefsRemoveIfPresent(s_outcome_outbox_prefs, outboxBatchKey(head).c_str());
+        head = static_cast<uint8_t>((head + 1) % OUTCOME_OUTBOX_CAPACITY);
+        count--;
+        items = items > evicted ? static_cast<uint8_t>(items - evicted) : 0;
+        s_outcome_drop_count_critical += evicted;
+        LOG_W(IC_TAG, "Critical outcome outbox full — evicted oldest batch (" +
+                      String(evicted) + " outcomes)");
+    }
+    if (count == 0) {
+        items = 0;
+    }
+
+    uint8_t idx = static_cast<uint8_t>((head + count) % OUTCOME_OUTBOX_CAPACITY);
+    bool saved = saveOutboxBatchAt(idx, batch);
+    if (saved) {
+        count++;
+        items = static_cast<uint8_t>(items + batch.count);
+    }
+    s_outcome_outbox_prefs.putUChar(kOutboxBatchHeadKey, head);
+    s_outcome_outbox_prefs.putUChar(kOutboxBatchCountKey, count);
+    s_outcome_outbox_prefs.putUChar(kOutboxBatchItemsKey, items);
+    s_outcome_outbox_prefs.end();
+    return saved;
+}
+
 static bool buildOutcomePayload(const char* flow,
                                 const IntentMetadata& metadata,
                                 const char* normalized_outcome,
@@ -369,6 +467,123 @@ static bool buildOutcomePayload(const char* flow,
     return written > 0 && payload_out->length() > 0;
 }
 
+// Schema intent_outcome_batch_v1: batch-level fields apply to every item; items
+// carry the per-intent contract fields (intent_id/correlation_id/generation as
+// idempotency keys, own seq). Server unwraps items into single outcomes.
+static bool buildOutcomeBatchPayload(const IntentOutcomeBatch& batch,
+                                     uint8_t retry_count,
+                                     bool recovered,
+                                     String* payload_out) {
+    if (payload_out == nullptr || batch.count == 0) {
+        return false;
+    }
+
+    // Item strings are stored by pointer (batch outlives serialization): ~18 slots per item
+    DynamicJsonDocument doc(768 + static_cast<size_t>(batch.count) * 384);
+    doc["schema"] = "intent_outcome_batch_v1";
+    doc["batch_id"] = batch.batch_id;
+    doc["lane"] = IntentOutcomeBatcher::getLaneName(batch.lane);
+    doc["count"] = batch.count;
+    doc["contract_version"] = 2;
+    doc["semantic_mode"] = "target";
+    doc["retry_limit"] = OUTCOME_OUTBOX_RETRY_LIMIT;
+    doc["retry_count"] = retry_count;
+    doc["recovered"] = recovered;
+    doc["delivery_mode"] = recovered ? "recovered" : "direct";
+    doc["outcome_retry_count"] = s_outcome_retry_count;
+    doc["outcome_recovered_count"] = s_outcome_recovered_count;
+    doc["outcome_drop_count_critical"] = s_outcome_drop_count_critical;
+    doc["outcome_final_confirmed_count"] = s_outcome_final_confirmed_count;
+    doc["ts"] = static_cast<unsigned long>(timeManager.getUnixTimestamp());
+
+    JsonArray items = doc.createNestedArray("items");
+    for (uint8_t i = 0; i < batch.count; i++) {
+        const IntentOutcomeRecord& record = batch.items[i];
+        JsonObject item = items.createNestedObject();
+        item["seq"] = mqttClient.getNextSeq();
+        item["flow"] = static_cast<const char*>(record.flow);
+        item["intent_id"] = static_cast<const char*>(record.metadata.intent_id);
+        item["correlation_id"] = static_cast<const char*>(record.metadata.correlation_id);
+        item["generation"] = record.metadata.generation;
+        item["created_at_ms"] = record.metadata.created_at_ms;
+        item["ttl_ms"] = record.metadata.ttl_ms;
+        item["epoch"] = record.metadata.epoch_at_accept;
+        item["outcome"] = static_cast<const char*>(record.outcome);
+        item["legacy_status"] = mapLegacyStatus(record.outcome);
+        item["target_status"] = static_cast<const char*>(record.outcome);
+        item["code"] = static_cast<const char*>(record.code);
+        item["reason"] = static_cast<const char*>(record.reason);
+        item["retryable"] = record.retryable;
+        item["critical"] = record.critical;
+        item["collapsed"] = record.collapsed;
+    }
+    if (doc.overflowed()) {
+        return false;
+    }
+
+    payload_out->clear();
+    size_t written = serializeJson(doc, *payload_out);
+    return written > 0 && payload_out->length() > 0;
+}
+
+static void recordBatchChainStage(const IntentOutcomeBatch& batch, const char* stage, const char* detail) {
+    for (uint8_t i = 0; i < batch.count; i++) {
+        const IntentOutcomeRecord& record = batch.items[i];
+        if (strcmp(record.flow, "command") == 0) {
+            recordIntentChainStage(record.metadata, stage, record.flow, record.code, detail);
+        }
+    }
+}
+
+// Prefs open, outbox lock held. Replays the oldest batch blob (at most one per call).
+static void replayOutboxBatchLocked() {
+    uint8_t head = s_outcome_outbox_prefs.getUChar(kOutboxBatchHeadKey, 0);
+    uint8_t count = s_outcome_outbox_prefs.getUChar(kOutboxBatchCountKey, 0);
+    if (count == 0) {
+        return;
+    }
+    uint8_t items = s_outcome_outbox_prefs.getUChar(kOutboxBatchItemsKey, 0);
+    IntentOutcomeBatch& batch = s_outcome_flush_batch;
+    bool loaded = loadOutboxBatchAt(head, &batch);
+    bool consumed = true;
+
+    if (loaded) {
+        String replay_payload;
+        bool ok = buildOutcomeBatchPayload(batch, batch.attempt, true, &replay_payload) &&
+                  mqttClient.safePublish(TopicBuilder::buildIntentOutcomeTopic(), replay_payload, 1, 1);
+        if (ok) {
+            recordBatchChainStage(batch, "outcome_publish_ok",
+                                  "[INC-EA5484] critical outcome batch replay delivered");
+            s_outcome_recovered_count += batch.count;
+            s_outcome_final_confirmed_count += batch.count;
+        } else {
+            s_outcome_retry_count += batch.count;
+            if (batch.attempt >= OUTCOME_OUTBOX_RETRY_LIMIT) {
+                s_outcome_drop_count_critical += batch.count;
+            } else {
+                batch.attempt++;
+                consumed = !saveOutboxBatchAt(head, batch);
+            }
+        }
+    }
+
+    if (consumed) {
+        prefsRemoveIfPresent(s_outcome_outbox_prefs, outboxBatchKey(head).c_str());
+        head = static_cast<uint8_t>((head + 1) % OUTCOME_OUTBOX_CAPACITY);
+        count--;
+        uint8_t batch_items = loaded ? batch.count : 0;
+        items = (count == 0 || items < batch_items) ? 0 : static_cast<uint8_t>(items - batch_items);
+        s_outcome_outbox_prefs.putUChar(kOutboxBatchHeadKey, head);
+        s_outcome_outbox_prefs.putUChar(kOutboxBatchCountKey, count);
+        s_outcome_outbox_prefs.putUChar(kOutboxBatchItemsKey, items);
+    }
+    s_outcome_outbox_prefs.putUInt(kOutboxStatRetryTotalKey, s_outcome_retry_count);
+    s_outcome_outbox_prefs.putUInt(kOutboxStatRecoveredTotalKey, s_outcome_recovered_count);
+    s_outcome_outbox_prefs.putUInt(kOutboxStatDropTotalKey, s_outcome_drop_count_critical);
+    s_outcome_outbox_prefs.putUInt(kOutboxStatFinalConfirmedTotalKey,
+                                   s_outcome_final_confirmed_count);
+}
+
 void processIntentOutcomeOutbox() {
     OutboxLockGuard guard;
     if (!guard.locked()) {
@@ -467,9 +682,165 @@ void processIntentOutcomeOutbox() {
         s_outcome_outbox_prefs.putUInt(kOutboxStatFinalConfirmedTotalKey,
                                        s_outcome_final_confirmed_count);
     }
+    // Per-entry slots (older firmware) drain first to keep delivery order, then batch blobs
+    if (count == 0 && processed < 2) {
+        replayOutboxBatchLocked();
+    }
     s_outcome_outbox_prefs.end();
 }
 
+// ============================================
+// OUTCOME BATCHING (windowed aggregation, Comm-Task flush)
+// ============================================
+#ifdef ENABLE_INTENT_OUTCOME_BATCHING
+static bool isOutcomeLinkReady() {
+    return mqttClient.isConnected() && mqttClient.isRegistrationConfirmed();
+}
+
+// Outbox lock held. Publishes one lane as a single message; an undeliverable
+// critical batch goes to the NVS outbox as one blob. Returns true if a batch was taken.
+static bool flushOutcomeLaneLocked(IntentOutcomeLane lane) {
+    portENTER_CRITICAL(&s_outcome_batch_mux);
+    uint8_t taken = s_outcome_batcher.takeBatch(lane, &s_outcome_flush_batch);
+    portEXIT_CRITICAL(&s_outcome_batch_mux);
+    if (taken == 0) {
+        return false;
+    }
+    const IntentOutcomeBatch& batch = s_outcome_flush_batch;
+
+    String payload;
+    bool ok = buildOutcomeBatchPayload(batch, 0, false, &payload) &&
+              mqttClient.safePublish(TopicBuilder::buildIntentOutcomeTopic(), payload, 1);
+    if (ok) {
+        recordBatchChainStage(batch, "outcome_publish_ok", "outcome batch delivered");
+        s_outcome_final_confirmed_count += taken;
+        return true;
+    }
+
+    recordBatchChainStage(batch, "outcome_publish_failed", "outcome batch publish failed");
+    LOG_W(IC_TAG, "[INC-EA5484] Intent outcome batch publish failed [lane=" +
+                  String(IntentOutcomeBatcher::getLaneName(lane)) + " items=" + String(taken) + "]");
+    if (lane == IntentOutcomeLane::CRITICAL) {
+        s_outcome_retry_count += taken;
+        if (!enqueueCriticalBatchLocked(batch)) {
+            s_outcome_drop_count_critical += taken;
+            LOG_E(IC_TAG, "[INC-EA5484] Critical outcome batch NVS persist failed (" +
+                              String(taken) + " outcomes)");
+        } else {
+            LOG_W(IC_TAG, "[INC-EA5484] Critical outcome batch persisted for replay (" +
+                              String(taken) + " outcomes)");
+        }
+    }
+    return true;
+}
+
+static void flushOutcomeLaneNow(IntentOutcomeLane lane) {
+    // Replay pending critical outcomes first when broker is reachable.
+    processIntentOutcomeOutbox();
+    OutboxLockGuard guard;
+    if (!guard.locked()) {
+        LOG_W(IC_TAG, "Outbox lock timeout during outcome batch flush");
+        return;
+    }
+    loadOutboxStatsLocked();
+    if (flushOutcomeLaneLocked(lane)) {
+        persistOutboxStatsLocked();
+    }
+}
+
+static bool enqueueOutcomeForBatch(const char* flow,
+                                   const IntentMetadata& metadata,
+                                   const char* normalized_outcome,
+                                   const char* code,
+                                   const String& reason,
+                                   bool retryable,
+                                   bool critical) {
+    IntentOutcomeRecord record = {};
+    strncpy(record.flow, flow != nullptr ? flow : "unknown", sizeof(record.flow) - 1);
+    record.metadata = metadata;
+    strncpy(record.outcome, normalized_outcome, sizeof(record.outcome) - 1);
+    strncpy(record.code, code != nullptr ? code : "UNKNOWN_ERROR", sizeof(record.code) - 1);
+    strncpy(record.reason, reason.c_str(), sizeof(record.reason) - 1);
+    record.retryable = retryable;
+    record.critical = critical;
+
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        uint32_t now = millis();
+        portENTER_CRITICAL(&s_outcome_batch_mux);
+        bool was_idle = s_outcome_batcher.msUntilDue(now) == UINT32_MAX;
+        IntentOutcomeAdmit admit = s_outcome_batcher.add(record, now);
+        portEXIT_CRITICAL(&s_outcome_batch_mux);
+        if (admit != IntentOutcomeAdmit::LANE_FULL) {
+            if (was_idle) {
+                notifyCommTaskPublishWork();  // Comm-Task re-arms its wait for the window
+            }
+            return true;
+        }
+        // Lane full: flush it right away, then retry admission once
+        flushOutcomeLaneNow(IntentOutcomeBatcher::laneFor(record));
+    }
+    return false;
+}
+#endif
+
+void flushIntentOutcomeBatches(bool force) {
+#ifdef ENABLE_INTENT_OUTCOME_BATCHING
+    // Link down: keep collecting until a lane is full (fuller blobs, fewer NVS writes)
+    bool link_ready = force || isOutcomeLinkReady();
+    uint32_t now = millis();
+    bool due[INTENT_OUTCOME_LANE_COUNT] = {};
+    bool any_due = false;
+    portENTER_CRITICAL(&s_outcome_batch_mux);
+    for (uint8_t lane = 0; lane < INTENT_OUTCOME_LANE_COUNT; lane++) {
+        IntentOutcomeLane l = static_cast<IntentOutcomeLane>(lane);
+        uint8_t pending = s_outcome_batcher.getPendingCount(l);
+        due[lane] = force ? pending > 0
+                          : s_outcome_batcher.isDue(l, now) &&
+                                (link_ready || pending >= INTENT_OUTCOME_BATCH_MAX);
+        any_due = any_due || due[lane];
+    }
+    portEXIT_CRITICAL(&s_outcome_batch_mux);
+    if (!any_due) {
+        return;
+    }
+
+    OutboxLockGuard guard;
+    if (!guard.locked()) {
+        LOG_W(IC_TAG, "Outbox lock timeout during outcome batch flush");
+        return;
+    }
+    loadOutboxStatsLocked();
+    bool flushed = false;
+    // Status lane first: an intermediate state never overtakes a final one
+    if (due[static_cast<uint8_t>(IntentOutcomeLane::STATUS)]) {
+        flushed = flushOutcomeLaneLocked(IntentOutcomeLane::STATUS) || flushed;
+    }
+    if (due[static_cast<uint8_t>(IntentOutcomeLane::CRITICAL)]) {
+        flushed = flushOutcomeLaneLocked(IntentOutcomeLane::CRITICAL) || flushed;
+    }
+    if (flushed) {
+        persistOutboxStatsLocked();  // Once per flush instead of once per outcome
+    }
+#else
+    (void)force;
+#endif
+}
+
+uint32_t getIntentOutcomeFlushDelayMs(uint32_t now_ms) {
+#ifdef ENABLE_INTENT_OUTCOME_BATCHING
+    if (!isOutcomeLinkReady()) {
+        return UINT32_MAX;  // Held until link-up or full lane (flushed at admission)
+    }
+    portENTER_CRITICAL(&s_outcome_batch_mux);
+    uint32_t delay_ms = s_outcome_batcher.msUntilDue(now_ms);
+    portEXIT_CRITICAL(&s_outcome_batch_mux);
+    return delay_ms;
+#else
+    (void)now_ms;
+    return UINT32_MAX;
+#endif
+}
+
 void initIntentMetadata(IntentMetadata* metadata) {
     if (metadata == nullptr) {
         return;
@@ -723,6 +1094,15 @@ bool publishIntentOutcome(const char* flow,
         }
     }
 
+#ifdef ENABLE_INTENT_OUTCOME_BATCHING
+    // Collected for the lane window; ok/failed chain stages follow at flush time.
+    // Falls through to the direct publish only if a full lane could not be flushed.
+    if (enqueueOutcomeForBatch(flow, active_metadata, normalized_outcome, code, reason,
+                               retryable, critical)) {
+        return true;
+    }
+#endif
+
     String payload;
     if (!buildOutcomePayload(flow,
                              active_metadata,
@@ -55,6 +55,14 @@ bool publishIntentOutcome(const char* flow,
                           bool retryable);
 void processIntentOutcomeOutbox();
 
+// Outcome batching (ENABLE_INTENT_OUTCOME_BATCHING): publishIntentOutcome() collects
+// outcomes per lane; the Comm-Task flushes lanes whose window expired.
+// force = every lane, link state ignored (call before ESP.restart(): unpublished
+// critical outcomes land in the NVS outbox instead of being lost).
+void flushIntentOutcomeBatches(bool force);
+// ms until the next lane is due (UINT32_MAX = nothing pending / link down)
+uint32_t getIntentOutcomeFlushDelayMs(uint32_t now_ms);
+
 uint32_t getSafetyEpoch();
 uint32_t bumpSafetyEpoch(const char* reason);
 
@@ -0,0 +1,309 @@
+#include "intent_outcome_batcher.h"
+
+#include <cstring>
+
+// ============================================
+// CONSTRUCTION
+// ============================================
+IntentOutcomeBatcher::IntentOutcomeBatcher(uint32_t window_ms)
+    : window_ms_(window_ms), next_batch_id_(1) {
+    memset(lanes_, 0, sizeof(lanes_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+// ============================================
+// CLASSIFICATION
+// ============================================
+uint8_t IntentOutcomeBatcher::getOutcomeRank(const char* outcome) {
+    if (outcome == nullptr) {
+        return 3;
+    }
+    if (strcmp(outcome, "accepted") == 0) {
+        return 0;
+    }
+    if (strcmp(outcome, "processing") == 0) {
+        return 1;
+    }
+    if (strcmp(outcome, "applied") == 0) {
+        return 2;
+    }
+    return 3;
+}
+
+IntentOutcomeLane IntentOutcomeBatcher::laneFor(const IntentOutcomeRecord& record) {
+    return record.critical ? IntentOutcomeLane::CRITICAL : IntentOutcomeLane::STATUS;
+}
+
+const char* IntentOutcomeBatcher::getLaneName(IntentOutcomeLane lane) {
+    switch (lane) {
+        case IntentOutcomeLane::CRITICAL: return "critical";
+        case IntentOutcomeLane::STATUS:   return "status";
+        default:                          return "unknown";
+    }
+}
+
+// ============================================
+// ADMISSION
+// ============================================
+bool IntentOutcomeBatcher::findPending(const IntentOutcomeRecord& record,
+                                       uint8_t* lane_out,
+                                       uint8_t* index_out) const {
+    if (record.metadata.intent_id[0] == '\0') {
+        return false;
+    }
+    for (uint8_t lane = 0; lane < INTENT_OUTCOME_LANE_COUNT; lane++) {
+        for (uint8_t i = 0; i < lanes_[lane].count; i++) {
+            const IntentOutcomeRecord& pending = lanes_[lane].items[i];
+            if (strcmp(pending.metadata.intent_id, record.metadata.intent_id) == 0 &&
+                strcmp(pending.flow, record.flow) == 0) {
+                *lane_out = lane;
+                *index_out = i;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void IntentOutcomeBatcher::removeAt(uint8_t lane, uint8_t index) {
+    LaneState& state = lanes_[lane];
+    for (uint8_t i = index; i + 1 < state.count; i++) {
+        state.items[i] = state.items[i + 1];
+    }
+    state.count--;
+}
+
+IntentOutcomeAdmit IntentOutcomeBatcher::add(const IntentOutcomeRecord& record, uint32_t now_ms) {
+    uint8_t target = static_cast<uint8_t>(laneFor(record));
+    uint8_t collapsed = record.collapsed;
+    uint8_t lane = 0;
+    uint8_t index = 0;
+    bool replaces = findPending(record, &lane, &index);
+
+    if (replaces) {
+        IntentOutcomeRecord& pending = lanes_[lane].items[index];
+        if (getOutcomeRank(record.outcome) < getOutcomeRank(pending.outcome)) {
+            stats_.stale++;
+            return IntentOutcomeAdmit::STALE;
+        }
+        collapsed = pending.collapsed < 254 ? static_cast<uint8_t>(pending.collapsed + 1) : 255;
+        if (lane == target) {
+            // Same lane: keep the position, the window is already running
+            pending = record;
+            pending.collapsed = collapsed;
+            stats_.admitted++;
+            stats_.collapsed++;
+            return IntentOutcomeAdmit::COLLAPSED;
+        }
+    }
+
+    LaneState& state = lanes_[target];
+    if (state.count >= INTENT_OUTCOME_BATCH_MAX) {
+        return IntentOutcomeAdmit::LANE_FULL;
+    }
+    if (replaces) {
+        removeAt(lane, index);
+    }
+    if (state.count == 0) {
+        state.window_start_ms = now_ms;
+    }
+    state.items[state.count] = record;
+    state.items[state.count].collapsed = collapsed;
+    state.count++;
+    stats_.admitted++;
+    if (replaces) {
+        stats_.collapsed++;
+        return IntentOutcomeAdmit::COLLAPSED;
+    }
+    return IntentOutcomeAdmit::QUEUED;
+}
+
+// ============================================
+// FLUSH
+// ============================================
+bool IntentOutcomeBatcher::isDue(IntentOutcomeLane lane, uint32_t now_ms) const {
+    const LaneState& state = lanes_[static_cast<uint8_t>(lane)];
+    if (state.count == 0) {
+        return false;
+    }
+    return state.count >= INTENT_OUTCOME_BATCH_MAX ||
+           (now_ms - state.window_start_ms) >= window_ms_;
+}
+
+uint32_t IntentOutcomeBatcher::msUntilDue(uint32_t now_ms) const {
+    uint32_t next = UINT32_MAX;
+    for (uint8_t lane = 0; lane < INTENT_OUTCOME_LANE_COUNT; lane++) {
+        const LaneState& state = lanes_[lane];
+        if (state.count == 0) {
+            continue;
+        }
+        uint32_t elapsed = now_ms - state.window_start_ms;
+        uint32_t remaining = (state.count >= INTENT_OUTCOME_BATCH_MAX || elapsed >= window_ms_)
+                                 ? 0
+                                 : window_ms_ - elapsed;
+        if (remaining < next) {
+            next = remaining;
+        }
+    }
+    return next;
+}
+
+uint8_t IntentOutcomeBatcher::takeBatch(IntentOutcomeLane lane, IntentOutcomeBatch* out) {
+    if (out == nullptr) {
+        return 0;
+    }
+    LaneState& state = lanes_[static_cast<uint8_t>(lane)];
+    out->lane = lane;
+    out->count = state.count;
+    out->attempt = 1;
+    out->batch_id = 0;
+    if (state.count == 0) {
+        return 0;
+    }
+    out->batch_id = next_batch_id_++;
+    if (next_batch_id_ == 0) {
+        next_batch_id_ = 1;
+    }
+    memcpy(out->items, state.items, state.count * sizeof(IntentOutcomeRecord));
+    uint8_t taken = state.count;
+    state.count = 0;
+    stats_.batches++;
+    stats_.items_flushed += taken;
+    return taken;
+}
+
+uint8_t IntentOutcomeBatcher::getPendingCount(IntentOutcomeLane lane) const {
+    return lanes_[static_cast<uint8_t>(lane)].count;
+}
+
+// ============================================
+// OUTBOX BLOB CODEC
+// ============================================
+static void blobPutU8(uint8_t* buffer, size_t* pos, uint8_t value) {
+    buffer[(*pos)++] = value;
+}
+
+static void blobPutU32(uint8_t* buffer, size_t* pos, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+        buffer[(*pos)++] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static void blobPutString(uint8_t* buffer, size_t* pos, const char* value, size_t field_size) {
+    size_t len = strnlen(value, field_size - 1);
+    buffer[(*pos)++] = static_cast<uint8_t>(len);
+    memcpy(buffer + *pos, value, len);
+    *pos += len;
+}
+
+static bool blobGetU8(const uint8_t* buffer, size_t length, size_t* pos, uint8_t* value) {
+    if (*pos + 1 > length) {
+        return false;
+    }
+    *value = buffer[(*pos)++];
+    return true;
+}
+
+static bool blobGetU32(const uint8_t* buffer, size_t length, size_t* pos, uint32_t* value) {
+    if (*pos + 4 > length) {
+        return false;
+    }
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        v |= static_cast<uint32_t>(buffer[(*pos)++]) << (8 * i);
+    }
+    *value = v;
+    return true;
+}
+
+static bool blobGetString(const uint8_t* buffer, size_t length, size_t* pos,
+                          char* value, size_t field_size) {
+    uint8_t len = 0;
+    if (!blobGetU8(buffer, length, pos, &len) || len >= field_size || *pos + len > length) {
+        return false;
+    }
+    memcpy(value, buffer + *pos, len);
+    value[len] = '\0';
+    *pos += len;
+    return true;
+}
+
+size_t encodeIntentOutcomeBatch(const IntentOutcomeBatch& batch, uint8_t* buffer, size_t capacity) {
+    if (buffer == nullptr || batch.count > INTENT_OUTCOME_BATCH_MAX) {
+        return 0;
+    }
+    // Worst case per item is bounded by the field sizes → check once up front
+    if (capacity < INTENT_OUTCOME_BLOB_HEADER_SIZE + batch.count * INTENT_OUTCOME_BLOB_MAX_ITEM_SIZE) {
+        return 0;
+    }
+
+    size_t pos = 0;
+    blobPutU8(buffer, &pos, INTENT_OUTCOME_BLOB_VERSION);
+    blobPutU8(buffer, &pos, static_cast<uint8_t>(batch.lane));
+    blobPutU8(buffer, &pos, batch.count);
+    blobPutU8(buffer, &pos, batch.attempt);
+    blobPutU32(buffer, &pos, batch.batch_id);
+
+    for (uint8_t i = 0; i < batch.count; i++) {
+        const IntentOutcomeRecord& item = batch.items[i];
+        blobPutString(buffer, &pos, item.flow, sizeof(item.flow));
+        blobPutString(buffer, &pos, item.metadata.intent_id, sizeof(item.metadata.intent_id));
+        blobPutString(buffer, &pos, item.metadata.correlation_id, sizeof(item.metadata.correlation_id));
+        blobPutU32(buffer, &pos, item.metadata.generation);
+        blobPutU32(buffer, &pos, item.metadata.created_at_ms);
+        blobPutU32(buffer, &pos, item.metadata.ttl_ms);
+        blobPutU32(buffer, &pos, item.metadata.epoch_at_accept);
+        blobPutString(buffer, &pos, item.outcome, sizeof(item.outcome));
+        blobPutString(buffer, &pos, item.code, sizeof(item.code));
+        blobPutString(buffer, &pos, item.reason, sizeof(item.reason));
+        blobPutU8(buffer, &pos, static_cast<uint8_t>((item.retryable ? 0x01 : 0) |
+                                                      (item.critical ? 0x02 : 0)));
+        blobPutU8(buffer, &pos, item.collapsed);
+    }
+    return pos;
+}
+
+bool decodeIntentOutcomeBatch(const uint8_t* buffer, size_t length, IntentOutcomeBatch* out) {
+    if (buffer == nullptr || out == nullptr || length < INTENT_OUTCOME_BLOB_HEADER_SIZE) {
+        return false;
+    }
+    size_t pos = 0;
+    uint8_t version = 0;
+    uint8_t lane = 0;
+    blobGetU8(buffer, length, &pos, &version);
+    blobGetU8(buffer, length, &pos, &lane);
+    blobGetU8(buffer, length, &pos, &out->count);
+    blobGetU8(buffer, length, &pos, &out->attempt);
+    blobGetU32(buffer, length, &pos, &out->batch_id);
+    if (version != INTENT_OUTCOME_BLOB_VERSION || lane >= INTENT_OUTCOME_LANE_COUNT ||
+        out->count > INTENT_OUTCOME_BATCH_MAX) {
+        return false;
+    }
+    out->lane = static_cast<IntentOutcomeLane>(lane);
+
+    for (uint8_t i = 0; i < out->count; i++) {
+        IntentOutcomeRecord& item = out->items[i];
+        memset(&item, 0, sizeof(item));
+        uint8_t flags = 0;
+        bool ok = blobGetString(buffer, length, &pos, item.flow, sizeof(item.flow)) &&
+                  blobGetString(buffer, length, &pos, item.metadata.intent_id,
+                                sizeof(item.metadata.intent_id)) &&
+                  blobGetString(buffer, length, &pos, item.metadata.correlation_id,
+                                sizeof(item.metadata.correlation_id)) &&
+                  blobGetU32(buffer, length, &pos, &item.metadata.generation) &&
+                  blobGetU32(buffer, length, &pos, &item.metadata.created_at_ms) &&
+                  blobGetU32(buffer, length, &pos, &item.metadata.ttl_ms) &&
+                  blobGetU32(buffer, length, &pos, &item.metadata.epoch_at_accept) &&
+                  blobGetString(buffer, length, &pos, item.outcome, sizeof(item.outcome)) &&
+                  blobGetString(buffer, length, &pos, item.code, sizeof(item.code)) &&
+                  blobGetString(buffer, length, &pos, item.reason, sizeof(item.reason)) &&
+                  blobGetU8(buffer, length, &pos, &flags) &&
+                  blobGetU8(buffer, length, &pos, &item.collapsed);
+        if (!ok) {
+            return false;
+        }
+        item.retryable = (flags & 0x01) != 0;
+        item.critical = (flags & 0x02) != 0;
+    }
+    return pos == length;
+}
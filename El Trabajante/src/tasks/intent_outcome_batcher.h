@@ -0,0 +1,130 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "intent_contract.h"
+
+// ============================================
+// INTENT OUTCOME BATCHER (windowed aggregation + compaction)
+// ============================================
+// Under sustained command load every intent produced 2–3 separate
+// intent_outcome publishes (accepted → applied / terminal) and every failed
+// critical publish 12 NVS keys in the outbox. The batcher collects outcomes
+// per lane for a short window and hands them out as one batch:
+//   CRITICAL — terminal outcomes, command "applied", publish flow
+//              (persisted to the NVS outbox as ONE blob when delivery fails)
+//   STATUS   — intermediate states (accepted / processing), best effort
+// An outcome for an intent that is still pending in the window replaces the
+// older state (accepted → applied → persisted collapses into the last one,
+// moving lanes if needed); an older state arriving after a newer one is
+// dropped as stale. intent_id / correlation_id / generation stay per item,
+// so server-side idempotency is unchanged.
+//
+// A lane is due when its window expired or it is full. Pure logic — the
+// caller owns locking, time (millis() on target) and publishing.
+// ============================================
+
+static const uint8_t INTENT_OUTCOME_BATCH_MAX = 8;
+static const uint32_t INTENT_OUTCOME_BATCH_WINDOW_MS = 250;
+static const uint8_t INTENT_OUTCOME_BLOB_VERSION = 1;
+
+enum class IntentOutcomeLane : uint8_t {
+    CRITICAL = 0,
+    STATUS,
+    COUNT
+};
+
+static const uint8_t INTENT_OUTCOME_LANE_COUNT = static_cast<uint8_t>(IntentOutcomeLane::COUNT);
+
+struct IntentOutcomeRecord {
+    char flow[16];
+    IntentMetadata metadata;
+    char outcome[16];
+    char code[64];
+    char reason[160];
+    bool retryable;
+    bool critical;
+    uint8_t collapsed;           // Earlier states of this intent folded into the record
+};
+
+struct IntentOutcomeBatch {
+    IntentOutcomeLane lane;
+    uint8_t count;
+    uint8_t attempt;             // Delivery attempts (1 = first publish)
+    uint32_t batch_id;
+    IntentOutcomeRecord items[INTENT_OUTCOME_BATCH_MAX];
+};
+
+enum class IntentOutcomeAdmit : uint8_t {
+    QUEUED = 0,                  // New pending item
+    COLLAPSED,                   // Replaced an older state of the same intent
+    STALE,                       // Older than the pending state → dropped
+    LANE_FULL                    // Caller must flush the lane first, then retry
+};
+
+struct IntentOutcomeBatchStats {
+    uint32_t admitted;
+    uint32_t collapsed;
+    uint32_t stale;
+    uint32_t batches;
+    uint32_t items_flushed;
+};
+
+class IntentOutcomeBatcher {
+public:
+    explicit IntentOutcomeBatcher(uint32_t window_ms = INTENT_OUTCOME_BATCH_WINDOW_MS);
+    IntentOutcomeBatcher(const IntentOutcomeBatcher&) = delete;
+    IntentOutcomeBatcher& operator=(const IntentOutcomeBatcher&) = delete;
+
+    IntentOutcomeAdmit add(const IntentOutcomeRecord& record, uint32_t now_ms);
+
+    bool isDue(IntentOutcomeLane lane, uint32_t now_ms) const;
+    // Time until the next lane becomes due (0 = now, UINT32_MAX = nothing pending)
+    uint32_t msUntilDue(uint32_t now_ms) const;
+
+    // Moves all pending items of the lane into out (attempt = 1, new batch_id).
+    uint8_t takeBatch(IntentOutcomeLane lane, IntentOutcomeBatch* out);
+
+    uint8_t getPendingCount(IntentOutcomeLane lane) const;
+    const IntentOutcomeBatchStats& getStats() const { return stats_; }
+
+    static IntentOutcomeLane laneFor(const IntentOutcomeRecord& record);
+    // accepted < processing < applied < terminal (everything else)
+    static uint8_t getOutcomeRank(const char* outcome);
+    static const char* getLaneName(IntentOutcomeLane lane);
+
+private:
+    struct LaneState {
+        IntentOutcomeRecord items[INTENT_OUTCOME_BATCH_MAX];
+        uint8_t count;
+        uint32_t window_start_ms;
+    };
+
+    LaneState lanes_[INTENT_OUTCOME_LANE_COUNT];
+    uint32_t window_ms_;
+    uint32_t next_batch_id_;
+    IntentOutcomeBatchStats stats_;
+
+    bool findPending(const IntentOutcomeRecord& record, uint8_t* lane_out, uint8_t* index_out) const;
+    void removeAt(uint8_t lane, uint8_t index);
+};
+
+// ============================================
+// OUTBOX BLOB CODEC
+// ============================================
+// Compact, versioned encoding of one batch for a single NVS putBytes():
+//   header  [version][lane][count][attempt][batch_id u32 LE]
+//   item    strings as [len u8][bytes], numbers u32 LE, [flags][collapsed]
+// Typical items need ~100 B instead of the fixed 400 B struct.
+static const size_t INTENT_OUTCOME_BLOB_HEADER_SIZE = 8;
+static const size_t INTENT_OUTCOME_BLOB_MAX_ITEM_SIZE =
+    6 + sizeof(IntentOutcomeRecord::flow) + INTENT_ID_MAX_LEN + CORRELATION_ID_MAX_LEN +
+    sizeof(IntentOutcomeRecord::outcome) + sizeof(IntentOutcomeRecord::code) +
+    sizeof(IntentOutcomeRecord::reason) + 4 * sizeof(uint32_t) + 2;
+static const size_t INTENT_OUTCOME_BLOB_MAX_SIZE =
+    INTENT_OUTCOME_BLOB_HEADER_SIZE + INTENT_OUTCOME_BATCH_MAX * INTENT_OUTCOME_BLOB_MAX_ITEM_SIZE;
+
+// Returns the encoded length, 0 if the buffer is too small.
+size_t encodeIntentOutcomeBatch(const IntentOutcomeBatch& batch, uint8_t* buffer, size_t capacity);
+// Rejects unknown versions, truncated data and out-of-range fields.
+bool decodeIntentOutcomeBatch(const uint8_t* buffer, size_t length, IntentOutcomeBatch* out);
@@ -1,4 +1,5 @@
 #include "publish_queue.h"
+#include "communication_task.h"
 #include "../utils/logger.h"
 #include "../error_handling/error_tracker.h"
 #include "../models/error_codes.h"
@@ -55,6 +56,7 @@ static bool reserveSlotForCriticalPublish(PublishRequest* critical_req) {
     }
 
     if (xQueueSend(g_publish_queue, critical_req, 0) == pdTRUE) {
+        notifyCommTaskPublishWork();
         return true;
     }
 
@@ -225,5 +227,7 @@ bool queuePublish(const char* topic,
 
     // Update HWM after successful enqueue (fill is now +1)
     updateHighWatermark(fill + 1);
+    // Wake the Comm-Task now instead of waiting for its next deadline
+    notifyCommTaskPublishWork();
     return true;
 }
@@ -9,6 +9,8 @@
 // ============================================
 // Safety-Task (Core 1) enqueues publish requests via queuePublish().
 // Communication-Task (Core 0) drains the queue via MQTTClient::processPublishQueue().
+// A successful enqueue wakes the Comm-Task (notifyCommTaskPublishWork()), so a
+// publish reaches esp_mqtt_client_publish() without waiting for a poll tick.
 // esp_mqtt_client_publish() is thread-safe, but routing all network I/O through
 // Core 0 keeps Core 1 unblocked and makes debugging deterministic.
 // ============================================
@@ -6,14 +6,21 @@
 #include "../services/actuator/safety_controller.h"  // M2: emergencyStopAll() via xTaskNotify
 #include "../services/safety/offline_mode_manager.h" // M3: SAFETY-P4 offline rules on Core 1
 #include "../error_handling/health_monitor.h"
+#include "../error_handling/resource_monitor.h"
+#include "../error_handling/watchdog_supervisor.h"
+#include "../services/power/power_manager.h"
+#include "../drivers/pulse_counter.h"
+#include "../drivers/digital_input.h"
 #include "actuator_command_queue.h"
 #include "sensor_command_queue.h"
 #include "config_update_queue.h"
+#include "safety_tick_scheduler.h"
 #include "../utils/logger.h"
 
 static const char* SAFETY_TAG = "SAFETY";
 
 TaskHandle_t g_safety_task_handle = NULL;
+SafetyTickScheduler g_safety_tick_scheduler;
 
 // PUBLISH_PAYLOAD_MAX_LEN increased 1024→2048: PublishRequest on stack grew by 1024 bytes.
 // Keep intended 12 KB stack budget (convert bytes -> FreeRTOS words explicitly).
@@ -25,6 +32,70 @@ static const BaseType_t SAFETY_TASK_CORE = 1;
 // Forward declaration — defined in main.cpp
 extern void checkServerAckTimeout();
 
+// Records [start, now] for the phase; returns now as the next phase's start
+static uint32_t recordSafetyPhase(SafetyTickScheduler& scheduler, SafetyPhase phase, uint32_t start_us) {
+    uint32_t now_us = (uint32_t)micros();
+    scheduler.recordPhase(phase, start_us, now_us);
+    return now_us;
+}
+
+void notifySafetyTaskQueueWork() {
+    if (g_safety_task_handle != NULL) {
+        xTaskNotify(g_safety_task_handle, NOTIFY_QUEUE_WORK, eSetBits);
+    }
+}
+
+void notifySafetyTaskOtaHold() {
+    if (g_safety_task_handle != NULL) {
+        xTaskNotify(g_safety_task_handle, NOTIFY_OTA_SAFE_HOLD, eSetBits);
+    }
+}
+
+// Digital input wake hook (GPIO ISR context): ends a power-save block at once
+static void IRAM_ATTR notifySafetyTaskDigitalInputFromIsr() {
+    if (g_safety_task_handle != NULL) {
+        BaseType_t higher_prio_woken = pdFALSE;
+        xTaskNotifyFromISR(g_safety_task_handle, NOTIFY_DIGITAL_INPUT, eSetBits, &higher_prio_woken);
+        if (higher_prio_woken == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+static bool hasQueuedSafetyWork() {
+    return (g_actuator_cmd_queue != NULL && uxQueueMessagesWaiting(g_actuator_cmd_queue) > 0) ||
+           (g_sensor_cmd_queue != NULL && uxQueueMessagesWaiting(g_sensor_cmd_queue) > 0) ||
+           (g_config_update_queue != NULL && uxQueueMessagesWaiting(g_config_update_queue) > 0);
+}
+
+// Power management: deadlines the Safety-Task must wake up for
+static PowerDeadlineInputs collectSafetyDeadlines(unsigned long now, unsigned long last_offline_eval,
+                                                  unsigned long offline_eval_interval_ms) {
+    PowerDeadlineInputs inputs;
+    inputs.next_measurement_in_ms = sensorManager.getMsUntilNextMeasurement(now);
+    uint32_t debounce_ms = digitalInputs.getMsUntilSettled((uint32_t)micros());
+    if (debounce_ms < inputs.next_measurement_in_ms) {
+        inputs.next_measurement_in_ms = debounce_ms;  // Pending input change settles first
+    }
+    uint32_t parked_ms = getSensorCommandMsUntilRetry((uint32_t)now);
+    if (parked_ms < inputs.next_measurement_in_ms) {
+        inputs.next_measurement_in_ms = parked_ms;  // Manual read waiting for its probe to settle
+    }
+    inputs.next_offline_eval_in_ms = POWER_DEADLINE_NONE;
+    if (offlineModeManager.isOfflineActive()) {
+        unsigned long elapsed = now - last_offline_eval;
+        inputs.next_offline_eval_in_ms =
+            elapsed >= offline_eval_interval_ms ? 0 : (uint32_t)(offline_eval_interval_ms - elapsed);
+    }
+    inputs.next_heartbeat_in_ms = POWER_DEADLINE_NONE;  // Comm-Task deadline
+    inputs.actuator_running = actuatorManager.isInitialized() && actuatorManager.hasRunningActuator();
+    inputs.work_pending = hasQueuedSafetyWork() || g_safety_tick_scheduler.hasDeferredWork();
+    inputs.link_up = true;
+    // PCNT counts on APB; GPIO edge interrupts do not wake from light sleep
+    inputs.keep_apb_clock = pulseCounter.getAttachedCount() > 0 || digitalInputs.getAttachedCount() > 0;
+    return inputs;
+}
+
 bool createSafetyTask() {
     BaseType_t created = xTaskCreatePinnedToCore(
         safetyTaskFunction,
@@ -45,6 +116,8 @@ bool createSafetyTask() {
               ", max_alloc=" + String(ESP.getMaxAllocHeap()) + ")");
         return false;
     }
+    resourceMonitor.registerTask("SafetyTask", g_safety_task_handle, SAFETY_TASK_STACK_BYTES);
+    digitalInputs.setWakeHook(notifySafetyTaskDigitalInputFromIsr);
     return true;
 }
 
@@ -56,17 +129,41 @@ void safetyTaskFunction(void* param) {
 
     LOG_I(SAFETY_TAG, "[SAFETY] Safety task running on core " + String(xPortGetCoreID()));
 
-    static uint32_t stack_log_counter = 0;
+    static unsigned long last_stack_log = 0;
+    static unsigned long last_offline_eval = 0;
+    static const unsigned long OFFLINE_EVAL_INTERVAL_MS = 5000;
+    // Bits received while blocking at the end of the previous iteration
+    uint32_t deferred_notified = 0;
+
+    // Watchdog supervisor: named phases → stall attribution after a WDT reset
+    const uint8_t hb_loop = watchdogSupervisor.registerHeartbeat("safety_loop", 2000);
+    const uint8_t hb_measure = watchdogSupervisor.registerHeartbeat("sensor_measure", 4000);
+    const uint8_t hb_actuators = watchdogSupervisor.registerHeartbeat("actuator_loop", 500);
+    const uint8_t hb_queues = watchdogSupervisor.registerHeartbeat("cmd_queues", 1000);
+    const uint8_t hb_config = watchdogSupervisor.registerHeartbeat("config_apply", 3000);
+    const uint8_t hb_health = watchdogSupervisor.registerHeartbeat("health_loop", 500);
+    const uint8_t hb_offline = watchdogSupervisor.registerHeartbeat("offline_rules", 500);
+
+    SafetyTickScheduler& scheduler = g_safety_tick_scheduler;
 
     for (;;) {
+        unsigned long loop_start = millis();
+        scheduler.beginTick((uint32_t)micros());
+        uint32_t phase_start = (uint32_t)micros();
+
         // ============================================
         // M2: Cross-Core Notification Handler
         // ============================================
-        // Poll notifications from MQTT task (Core 0) — latency < 1 loop cycle (10ms).
+        // Poll notifications from MQTT task (Core 0). The end-of-loop block also
+        // returns on notification, so latency stays < 1 loop cycle in power-save mode.
         // Bit-mask cleared atomically; multiple bits can arrive in one cycle.
         {
-            uint32_t notified = 0;
-            xTaskNotifyWait(0, UINT32_MAX, &notified, 0);  // Non-blocking poll
+            uint32_t notified = deferred_notified;
+            uint32_t polled = 0;
+            deferred_notified = 0;
+            if (xTaskNotifyWait(0, UINT32_MAX, &polled, 0) == pdTRUE) {  // Non-blocking poll
+                notified |= polled;
+            }
 
             if (notified & NOTIFY_EMERGENCY_STOP) {
                 LOG_W(SAFETY_TAG, "[SAFETY-M2] EMERGENCY_STOP received — stopping all actuators");
@@ -93,20 +190,40 @@ void safetyTaskFunction(void* param) {
                     LOG_W(SAFETY_TAG, "[SAFETY-M2] MQTT_DISCONNECTED — no offline rules, setting actuators to safe state immediately");
                 }
             }
+            if (notified & NOTIFY_OTA_SAFE_HOLD) {
+                // New commands are rejected while STATE_LIBRARY_DOWNLOADING (admission)
+                LOG_W(SAFETY_TAG, "[SAFETY-M2] OTA_SAFE_HOLD — actuators to safe state for firmware update");
+                bumpSafetyEpoch("ota_hold");
+                flushActuatorCommandQueue();
+                if (actuatorManager.isInitialized()) {
+                    actuatorManager.setAllActuatorsToSafeState();
+                }
+            }
             // NOTIFY_SUBZONE_SAFE: M3 — full GPIO routing via Core 1 queue (not yet implemented)
         }
+        phase_start = recordSafetyPhase(scheduler, SafetyPhase::NOTIFY, phase_start);
 
         #ifndef WOKWI_SIMULATION
         esp_task_wdt_reset();
         #endif
 
-        sensorManager.performAllMeasurements();
-        actuatorManager.processActuatorLoops();
-        checkServerAckTimeout();
-        processActuatorCommandQueue();
-        processSensorCommandQueue();
-        processConfigUpdateQueue();  // SAFETY-RTOS M4.6: drain Core 0→1 config queue
-        healthMonitor.loop();
+        watchdogSupervisor.checkIn(hb_loop);
+
+        // ============================================
+        // Phase budgets: critical phases first, every tick
+        // ============================================
+        {
+            WdtPhaseScope phase(hb_actuators);
+            actuatorManager.processActuatorLoops();
+            checkServerAckTimeout();
+        }
+        phase_start = recordSafetyPhase(scheduler, SafetyPhase::ACTUATORS, phase_start);
+        {
+            WdtPhaseScope phase(hb_queues);
+            processActuatorCommandQueue();
+            processSensorCommandQueue();
+        }
+        phase_start = recordSafetyPhase(scheduler, SafetyPhase::COMMAND_QUEUES, phase_start);
 
         // ============================================
         // M3: SAFETY-P4 Offline Hysteresis (Core 1)
@@ -114,28 +231,67 @@ void safetyTaskFunction(void* param) {
         // checkDelayTimer: transition DISCONNECTING → OFFLINE_ACTIVE after 30 s grace period.
         // evaluateOfflineRules: apply local actuator rules every 5 s when offline.
         // Runs on Core 1 because offline rules directly control GPIO/actuators.
+        // Digital inputs first: a debounced change (float switch, leak contact) is
+        // published at once and re-evaluates the offline rules in the same tick.
+        bool input_changed = sensorManager.processDigitalInputs();
         offlineModeManager.checkDelayTimer();
-        {
-            static unsigned long last_offline_eval = 0;
-            static const unsigned long OFFLINE_EVAL_INTERVAL_MS = 5000;
-            if (offlineModeManager.isOfflineActive()) {
-                if (millis() - last_offline_eval > OFFLINE_EVAL_INTERVAL_MS) {
-                    last_offline_eval = millis();
-                    offlineModeManager.evaluateOfflineRules();
-                }
+        if (offlineModeManager.isOfflineActive()) {
+            if (input_changed || millis() - last_offline_eval >= OFFLINE_EVAL_INTERVAL_MS) {
+                last_offline_eval = millis();
+                WdtPhaseScope phase(hb_offline);
+                offlineModeManager.evaluateOfflineRules();
             }
         }
+        phase_start = recordSafetyPhase(scheduler, SafetyPhase::OFFLINE_RULES, phase_start);
 
-        // Log stack highwater mark every ~60s (6000 * 10ms = 60s)
+        // ============================================
+        // Deferrable work: only while the tick budget lasts
+        // ============================================
+        // Measurements stop between sensors at the slice deadline and resume next tick.
+        if (scheduler.shouldRun(SafetyPhase::MEASUREMENTS, phase_start)) {
+            WdtPhaseScope phase(hb_measure);
+            sensorManager.performAllMeasurements(
+                scheduler.sliceDeadlineUs(SafetyPhase::MEASUREMENTS, phase_start));
+            phase_start = recordSafetyPhase(scheduler, SafetyPhase::MEASUREMENTS, phase_start);
+        }
+        // Config apply: one update per tick (NVS writes); the rest waits in the queue.
+        if (scheduler.shouldRun(SafetyPhase::CONFIG_APPLY, phase_start)) {
+            WdtPhaseScope phase(hb_config);
+            processConfigUpdateQueue(1);  // SAFETY-RTOS M4.6: drain Core 0→1 config queue
+            phase_start = recordSafetyPhase(scheduler, SafetyPhase::CONFIG_APPLY, phase_start);
+        }
+        if (scheduler.shouldRun(SafetyPhase::HEALTH, phase_start)) {
+            WdtPhaseScope phase(hb_health);
+            healthMonitor.loop();
+            phase_start = recordSafetyPhase(scheduler, SafetyPhase::HEALTH, phase_start);
+        }
+        scheduler.endTick(phase_start);
+
+        // Log stack highwater mark every ~60s
         // uxTaskGetStackHighWaterMark returns free stack in words; Xtensa word = 4 bytes.
-        stack_log_counter++;
-        if (stack_log_counter >= 6000) {
-            stack_log_counter = 0;
+        if (millis() - last_stack_log >= 60000) {
+            last_stack_log = millis();
             UBaseType_t hwm = uxTaskGetStackHighWaterMark(g_safety_task_handle);
             LOG_D(SAFETY_TAG, "[SAFETY] Stack HWM: " +
                   String((uint32_t)(hwm * (uint32_t)sizeof(StackType_t))) + " bytes free");
         }
 
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // ============================================
+        // Power management: block until the next deadline (10 ms when busy).
+        // Any NOTIFY_* bit ends the block early; bits are handled next iteration.
+        // ============================================
+        unsigned long block_start = millis();
+        PowerDecision decision = powerManager.planSafetyBlock(
+            collectSafetyDeadlines(block_start, last_offline_eval, OFFLINE_EVAL_INTERVAL_MS));
+        uint32_t woke_bits = 0;
+        bool notified_wake = xTaskNotifyWait(0, UINT32_MAX, &woke_bits,
+                                             pdMS_TO_TICKS(decision.sleep_ms)) == pdTRUE;
+        if (notified_wake) {
+            deferred_notified |= woke_bits;
+        }
+        powerManager.recordSafetyWake(decision,
+                                      (uint32_t)(block_start - loop_start),
+                                      (uint32_t)(millis() - block_start),
+                                      notified_wake ? PowerWakeSource::NOTIFY : PowerWakeSource::TIMEOUT);
     }
 }
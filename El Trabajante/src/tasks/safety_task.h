@@ -1,8 +1,11 @@
 #pragma once
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include "safety_tick_scheduler.h"
 
 extern TaskHandle_t g_safety_task_handle;
+// Phase budgets of the Safety loop (owned by the Safety-Task, stats read for diagnostics)
+extern SafetyTickScheduler g_safety_tick_scheduler;
 
 // ============================================
 // SAFETY-RTOS M2: Task Notification Bits
@@ -13,6 +16,14 @@ extern TaskHandle_t g_safety_task_handle;
 static const uint32_t NOTIFY_EMERGENCY_STOP    = 0x01;  // Emergency stop all actuators (<1µs latency)
 static const uint32_t NOTIFY_MQTT_DISCONNECTED = 0x02;  // MQTT disconnect → setAllActuatorsToSafeState
 static const uint32_t NOTIFY_SUBZONE_SAFE      = 0x04;  // Subzone safe-mode change (M3: full GPIO routing via Core 1)
+static const uint32_t NOTIFY_QUEUE_WORK        = 0x08;  // Command/config queued — wake from power-save block
+static const uint32_t NOTIFY_OTA_SAFE_HOLD     = 0x10;  // OTA session started → all actuators to safe state
+static const uint32_t NOTIFY_DIGITAL_INPUT     = 0x20;  // GPIO edge ISR — debounce inputs processed next tick
+
+// Wakes the Safety-Task early when it blocks in power-save mode (no-op before task creation).
+void notifySafetyTaskQueueWork();
+// OTA (LibraryManager, Core 0): drop queued actuator commands, force safe state
+void notifySafetyTaskOtaHold();
 
 bool createSafetyTask();
 void safetyTaskFunction(void* param);
@@ -0,0 +1,170 @@
+#include "safety_tick_scheduler.h"
+
+#include <string.h>
+
+// ============================================
+// DEFAULT PHASE TABLE (index = SafetyPhase)
+// ============================================
+// Budgets are per-run expectations; exceeding one counts as overrun.
+// CONFIG_APPLY includes NVS writes (flash erase) and is allowed to be long,
+// but only starts while the tick budget lasts.
+struct PhaseTableEntry {
+    const char* name;
+    SafetyPhaseClass phase_class;
+    uint32_t budget_us;
+};
+
+static const PhaseTableEntry PHASE_TABLE[SAFETY_PHASE_COUNT] = {
+    {"notify",     SafetyPhaseClass::CRITICAL,   500},
+    {"actuators",  SafetyPhaseClass::CRITICAL,   2000},
+    {"cmd_queues", SafetyPhaseClass::CRITICAL,   3000},
+    {"offline",    SafetyPhaseClass::CRITICAL,   2000},
+    {"measure",    SafetyPhaseClass::SPLITTABLE, SAFETY_TICK_BUDGET_US},
+    {"config",     SafetyPhaseClass::DEFERRABLE, 50000},
+    {"health",     SafetyPhaseClass::DEFERRABLE, 2000},
+};
+
+static uint8_t phaseIndex(SafetyPhase phase) {
+    uint8_t index = static_cast<uint8_t>(phase);
+    return index < SAFETY_PHASE_COUNT ? index : 0;
+}
+
+// ============================================
+// CONSTRUCTION / CONFIGURATION
+// ============================================
+SafetyTickScheduler::SafetyTickScheduler(uint32_t tick_budget_us)
+    : tick_budget_us_(tick_budget_us)
+    , tick_start_us_(0)
+    , deferred_mask_(0) {
+    for (uint8_t i = 0; i < SAFETY_PHASE_COUNT; i++) {
+        phases_[i].phase_class = PHASE_TABLE[i].phase_class;
+        phases_[i].budget_us = PHASE_TABLE[i].budget_us;
+        phases_[i].consecutive_deferrals = 0;
+        phases_[i].forced_this_tick = false;
+    }
+    memset(stats_, 0, sizeof(stats_));
+    memset(&tick_stats_, 0, sizeof(tick_stats_));
+}
+
+void SafetyTickScheduler::configurePhase(SafetyPhase phase, SafetyPhaseClass phase_class,
+                                         uint32_t budget_us) {
+    PhaseState& state = phases_[phaseIndex(phase)];
+    state.phase_class = phase_class;
+    state.budget_us = budget_us;
+}
+
+uint32_t SafetyTickScheduler::getPhaseBudgetUs(SafetyPhase phase) const {
+    return phases_[phaseIndex(phase)].budget_us;
+}
+
+SafetyPhaseClass SafetyTickScheduler::getPhaseClass(SafetyPhase phase) const {
+    return phases_[phaseIndex(phase)].phase_class;
+}
+
+const SafetyPhaseStats& SafetyTickScheduler::getPhaseStats(SafetyPhase phase) const {
+    return stats_[phaseIndex(phase)];
+}
+
+const char* SafetyTickScheduler::getPhaseName(SafetyPhase phase) {
+    return PHASE_TABLE[phaseIndex(phase)].name;
+}
+
+// ============================================
+// TICK LIFECYCLE
+// ============================================
+void SafetyTickScheduler::beginTick(uint32_t now_us) {
+    tick_start_us_ = now_us;
+    deferred_mask_ = 0;
+    for (uint8_t i = 0; i < SAFETY_PHASE_COUNT; i++) {
+        phases_[i].forced_this_tick = false;
+    }
+}
+
+bool SafetyTickScheduler::shouldRun(SafetyPhase phase, uint32_t now_us) {
+    uint8_t index = phaseIndex(phase);
+    PhaseState& state = phases_[index];
+    if (state.phase_class == SafetyPhaseClass::CRITICAL) {
+        return true;
+    }
+
+    if (elapsedUs(now_us) < tick_budget_us_) {
+        state.consecutive_deferrals = 0;
+        return true;
+    }
+    if (state.consecutive_deferrals >= SAFETY_PHASE_MAX_DEFERRALS) {
+        // Starvation guard: budget exhausted, but this phase waited long enough
+        state.consecutive_deferrals = 0;
+        state.forced_this_tick = true;
+        stats_[index].forced++;
+        return true;
+    }
+
+    state.consecutive_deferrals++;
+    stats_[index].deferrals++;
+    deferred_mask_ |= (1UL << index);
+    return false;
+}
+
+uint32_t SafetyTickScheduler::sliceDeadlineUs(SafetyPhase phase, uint32_t now_us) const {
+    const PhaseState& state = phases_[phaseIndex(phase)];
+    if (state.forced_this_tick) {
+        return now_us + state.budget_us;
+    }
+    uint32_t tick_deadline = tick_start_us_ + tick_budget_us_;
+    uint32_t phase_deadline = now_us + state.budget_us;
+    // Earlier of both (wrap-safe comparison)
+    return static_cast<int32_t>(phase_deadline - tick_deadline) < 0 ? phase_deadline : tick_deadline;
+}
+
+void SafetyTickScheduler::recordPhase(SafetyPhase phase, uint32_t start_us, uint32_t end_us) {
+    uint8_t index = phaseIndex(phase);
+    SafetyPhaseStats& stats = stats_[index];
+    uint32_t duration = end_us - start_us;
+    stats.runs++;
+    stats.last_us = duration;
+    if (duration > stats.max_us) {
+        stats.max_us = duration;
+    }
+    if (duration > phases_[index].budget_us) {
+        stats.overruns++;
+    }
+}
+
+void SafetyTickScheduler::endTick(uint32_t now_us) {
+    uint32_t duration = elapsedUs(now_us);
+    tick_stats_.ticks++;
+    tick_stats_.last_us = duration;
+    if (duration > tick_stats_.max_us) {
+        tick_stats_.max_us = duration;
+    }
+    if (duration > tick_budget_us_) {
+        tick_stats_.over_budget++;
+    }
+}
+
+// ============================================
+// DIAGNOSTICS
+// ============================================
+void SafetyTickScheduler::appendDiagnosticsJson(String& json) const {
+    // Compact keys: b=budget us, r=runs, d=deferrals, f=forced, o=overruns, max=max us
+    char buf[112];
+    snprintf(buf, sizeof(buf), ",\"safety_tick\":{\"b\":%lu,\"n\":%lu,\"over\":%lu,\"max\":%lu,\"ph\":{",
+             static_cast<unsigned long>(tick_budget_us_),
+             static_cast<unsigned long>(tick_stats_.ticks),
+             static_cast<unsigned long>(tick_stats_.over_budget),
+             static_cast<unsigned long>(tick_stats_.max_us));
+    json += buf;
+    for (uint8_t i = 0; i < SAFETY_PHASE_COUNT; i++) {
+        const SafetyPhaseStats& stats = stats_[i];
+        snprintf(buf, sizeof(buf), "%s\"%s\":[%lu,%lu,%lu,%lu,%lu]",
+                 i == 0 ? "" : ",",
+                 PHASE_TABLE[i].name,
+                 static_cast<unsigned long>(stats.runs),
+                 static_cast<unsigned long>(stats.deferrals),
+                 static_cast<unsigned long>(stats.forced),
+                 static_cast<unsigned long>(stats.overruns),
+                 static_cast<unsigned long>(stats.max_us));
+        json += buf;
+    }
+    json += "}}";
+}
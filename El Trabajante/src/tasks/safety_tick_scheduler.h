@@ -0,0 +1,113 @@
+#pragma once
+#include <Arduino.h>
+
+// ============================================
+// SAFETY TICK SCHEDULER (phase budgets, Core 1)
+// ============================================
+// Cooperative scheduler for one Safety-Task loop iteration ("tick").
+// Each phase has a time budget and a class:
+//   CRITICAL   — always runs, in table order before any deferrable work
+//                (notify handling, actuator loops, command queues, offline rules)
+//   SPLITTABLE — runs while the tick budget lasts; gets a deadline and stops
+//                between work items, resuming next tick (sensor measurements)
+//   DEFERRABLE — runs only if the tick budget is not yet exhausted, otherwise
+//                moves to the next tick (config apply, health loop)
+// A deferrable phase deferred SAFETY_PHASE_MAX_DEFERRALS ticks in a row is
+// forced once (starvation guard). Tick jitter is bounded by the critical
+// phases plus one work item of the phase that crosses the budget.
+//
+// Times are passed in by the caller (micros() on target, simulated in tests).
+// Single-owner: all calls from the Safety-Task; counters are read on Core 0
+// for diagnostics only (32-bit, no lock needed).
+// ============================================
+
+enum class SafetyPhase : uint8_t {
+    NOTIFY = 0,
+    ACTUATORS,
+    COMMAND_QUEUES,
+    OFFLINE_RULES,
+    MEASUREMENTS,
+    CONFIG_APPLY,
+    HEALTH,
+    COUNT
+};
+
+enum class SafetyPhaseClass : uint8_t {
+    CRITICAL = 0,
+    SPLITTABLE,
+    DEFERRABLE
+};
+
+static const uint8_t SAFETY_PHASE_COUNT = static_cast<uint8_t>(SafetyPhase::COUNT);
+static const uint32_t SAFETY_TICK_BUDGET_US = 5000;       // Work budget per loop iteration
+static const uint8_t SAFETY_PHASE_MAX_DEFERRALS = 20;     // ~200 ms at 10 ms ticks
+
+struct SafetyPhaseStats {
+    uint32_t runs;
+    uint32_t deferrals;          // Ticks in which the phase was skipped for budget
+    uint32_t forced;             // Runs forced by the starvation guard
+    uint32_t overruns;           // Runs longer than the phase budget
+    uint32_t last_us;
+    uint32_t max_us;
+};
+
+struct SafetyTickStats {
+    uint32_t ticks;
+    uint32_t over_budget;        // Ticks whose work exceeded the tick budget
+    uint32_t last_us;
+    uint32_t max_us;
+};
+
+class SafetyTickScheduler {
+public:
+    explicit SafetyTickScheduler(uint32_t tick_budget_us = SAFETY_TICK_BUDGET_US);
+    SafetyTickScheduler(const SafetyTickScheduler&) = delete;
+    SafetyTickScheduler& operator=(const SafetyTickScheduler&) = delete;
+
+    // Overrides the default table entry (tests, tuning).
+    void configurePhase(SafetyPhase phase, SafetyPhaseClass phase_class, uint32_t budget_us);
+
+    void beginTick(uint32_t now_us);
+
+    // Admission: CRITICAL always; others while the tick budget lasts or when starved.
+    // A false result counts as a deferral for this tick.
+    bool shouldRun(SafetyPhase phase, uint32_t now_us);
+
+    // Deadline (micros) for SPLITTABLE work admitted by shouldRun(): end of the
+    // tick budget, or now + phase budget when forced. The phase must still
+    // complete at least one work item to guarantee progress.
+    uint32_t sliceDeadlineUs(SafetyPhase phase, uint32_t now_us) const;
+
+    void recordPhase(SafetyPhase phase, uint32_t start_us, uint32_t end_us);
+    void endTick(uint32_t now_us);
+
+    // Work was deferred in the last tick → caller should not block long.
+    bool hasDeferredWork() const { return deferred_mask_ != 0; }
+
+    uint32_t getTickBudgetUs() const { return tick_budget_us_; }
+    uint32_t getPhaseBudgetUs(SafetyPhase phase) const;
+    SafetyPhaseClass getPhaseClass(SafetyPhase phase) const;
+    const SafetyPhaseStats& getPhaseStats(SafetyPhase phase) const;
+    const SafetyTickStats& getTickStats() const { return tick_stats_; }
+    static const char* getPhaseName(SafetyPhase phase);
+
+    // Appends ,"safety_tick":{...} to a diagnostics JSON object body.
+    void appendDiagnosticsJson(String& json) const;
+
+private:
+    struct PhaseState {
+        SafetyPhaseClass phase_class;
+        uint32_t budget_us;
+        uint8_t consecutive_deferrals;
+        bool forced_this_tick;
+    };
+
+    uint32_t tick_budget_us_;
+    uint32_t tick_start_us_;
+    uint32_t deferred_mask_;           // Phases deferred in the current/last tick
+    PhaseState phases_[SAFETY_PHASE_COUNT];
+    SafetyPhaseStats stats_[SAFETY_PHASE_COUNT];
+    SafetyTickStats tick_stats_;
+
+    uint32_t elapsedUs(uint32_t now_us) const { return now_us - tick_start_us_; }
+};
@@ -7,6 +7,7 @@
 #include "../models/error_codes.h"
 #include "../models/system_types.h"
 #include "command_admission.h"
+#include "safety_task.h"  // notifySafetyTaskQueueWork()
 
 static const char* SENS_Q_TAG = "SYNC";
 
@@ -21,6 +22,17 @@ extern SystemConfig g_system_config;
 // Sensor command queue overflow counter (cumulative, never reset)
 static uint32_t g_sensor_cmd_queue_overflow_count = 0;
 
+// Manual measurements parked while the probe excitation settles. Retried by
+// processSensorCommandQueue() once due; flushSensorCommandQueue() (Core 0 too)
+// expires them, hence the spinlock.
+struct ParkedSensorCommand {
+    SensorCommand cmd;
+    uint32_t due_ms;
+    bool in_use;
+};
+static ParkedSensorCommand g_parked_sensor_cmds[SENSOR_CMD_PARKED_SIZE];
+static portMUX_TYPE g_parked_sensor_cmds_mux = portMUX_INITIALIZER_UNLOCKED;
+
 static void logSensorQueueCorrelation(const char* stage,
                                       const SensorCommand& cmd,
                                       const char* reason_code) {
@@ -75,14 +87,66 @@ bool queueSensorCommand(const char* topic, const char* payload, const IntentMeta
     if (recovery_intent) {
         LOG_I(SENS_Q_TAG, "[SYNC] Recovery sensor intent prioritized to queue front");
     }
+    notifySafetyTaskQueueWork();
     return true;
 }
 
+static bool parkSensorCommand(const SensorCommand& cmd, uint32_t due_ms) {
+    bool parked = false;
+    portENTER_CRITICAL(&g_parked_sensor_cmds_mux);
+    for (uint8_t i = 0; i < SENSOR_CMD_PARKED_SIZE; i++) {
+        if (!g_parked_sensor_cmds[i].in_use) {
+            g_parked_sensor_cmds[i].cmd = cmd;
+            g_parked_sensor_cmds[i].due_ms = due_ms;
+            g_parked_sensor_cmds[i].in_use = true;
+            parked = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&g_parked_sensor_cmds_mux);
+    return parked;
+}
+
+// Takes one parked command out: due ones only, or any when due_only is false
+static bool takeParkedSensorCommand(SensorCommand& out, uint32_t now_ms, bool due_only) {
+    bool taken = false;
+    portENTER_CRITICAL(&g_parked_sensor_cmds_mux);
+    for (uint8_t i = 0; i < SENSOR_CMD_PARKED_SIZE; i++) {
+        ParkedSensorCommand& slot = g_parked_sensor_cmds[i];
+        if (slot.in_use && (!due_only || static_cast<int32_t>(now_ms - slot.due_ms) >= 0)) {
+            out = slot.cmd;
+            slot.in_use = false;
+            taken = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&g_parked_sensor_cmds_mux);
+    return taken;
+}
+
+uint32_t getSensorCommandMsUntilRetry(uint32_t now_ms) {
+    uint32_t next_due = UINT32_MAX;
+    portENTER_CRITICAL(&g_parked_sensor_cmds_mux);
+    for (uint8_t i = 0; i < SENSOR_CMD_PARKED_SIZE; i++) {
+        if (!g_parked_sensor_cmds[i].in_use) {
+            continue;
+        }
+        int32_t remaining = static_cast<int32_t>(g_parked_sensor_cmds[i].due_ms - now_ms);
+        uint32_t due = remaining > 0 ? static_cast<uint32_t>(remaining) : 0;
+        if (due < next_due) {
+            next_due = due;
+        }
+    }
+    portEXIT_CRITICAL(&g_parked_sensor_cmds_mux);
+    return next_due;
+}
+
 void flushSensorCommandQueue() {
     if (g_sensor_cmd_queue == NULL) return;
     SensorCommand dropped;
     uint16_t dropped_count = 0;
-    while (xQueueReceive(g_sensor_cmd_queue, &dropped, 0) == pdTRUE) {
+    while (xQueueReceive(g_sensor_cmd_queue, &dropped, 0) == pdTRUE ||
+           takeParkedSensorCommand(dropped, 0, false)) {
         publishIntentOutcome("command",
                              dropped.metadata,
                              "expired",
@@ -97,78 +161,104 @@ void flushSensorCommandQueue() {
     }
 }
 
+// Admission + execution of one command (fresh or parked) on Core 1
+static void executeSensorCommand(const SensorCommand& cmd, uint32_t epoch) {
+    IntentInvalidationReason invalidation_reason =
+        getIntentInvalidationReason(cmd.metadata, epoch);
+    if (invalidation_reason != IntentInvalidationReason::NONE &&
+        !isRecoveryIntentAllowed(cmd.topic, cmd.payload)) {
+        publishIntentOutcome("command",
+                             cmd.metadata,
+                             "expired",
+                             invalidation_reason == IntentInvalidationReason::SAFETY_EPOCH_INVALIDATED
+                                 ? "SAFETY_EPOCH_INVALIDATED"
+                                 : "TTL_EXPIRED",
+                             invalidation_reason == IntentInvalidationReason::SAFETY_EPOCH_INVALIDATED
+                                 ? "Sensor command invalidated by safety epoch update"
+                                 : "Sensor command TTL expired before execution",
+                             false);
+        return;
+    }
+    CommandAdmissionContext admission_context{
+        mqttClient.isRegistrationConfirmed(),
+        g_system_config.current_state == STATE_CONFIG_PENDING_AFTER_RESET,
+        g_system_config.current_state == STATE_PENDING_APPROVAL,
+        g_system_config.current_state == STATE_SAFE_MODE ||
+            g_system_config.current_state == STATE_SAFE_MODE_PROVISIONING ||
+            g_system_config.current_state == STATE_ERROR,
+        g_system_config.current_state == STATE_SAFE_MODE,
+        isRecoveryIntentAllowed(cmd.topic, cmd.payload),
+        nullptr
+    };
+    CommandAdmissionDecision admission = shouldAcceptCommand(CommandSubtype::SENSOR, admission_context);
+    if (!admission.accepted) {
+        logSensorQueueCorrelation("admission_reject", cmd, admission.reason_code);
+        publishIntentOutcome("command",
+                             cmd.metadata,
+                             "rejected",
+                             admission.code,
+                             String("Sensor command blocked (reason_code=") + admission.reason_code + ")",
+                             false);
+        return;
+    }
+    logSensorQueueCorrelation("admission_accept", cmd, admission.reason_code);
+    recordIntentChainStage(cmd.metadata,
+                           "execute_started",
+                           "command",
+                           "EXECUTE_STARTED",
+                           "sensor command execution started");
+    SensorCommandExecutionResult result =
+        handleSensorCommand(String(cmd.topic), String(cmd.payload), cmd.metadata);
+    if (result.retry_after_ms > 0) {
+        // Probe excitation settling: run again once ready instead of waiting here
+        if (parkSensorCommand(cmd, millis() + result.retry_after_ms)) {
+            recordIntentChainStage(cmd.metadata,
+                                   "execute_deferred",
+                                   "command",
+                                   "SETTLING",
+                                   "sensor command parked until probe settled");
+            logSensorQueueCorrelation("execute_deferred", cmd, "SETTLING");
+            return;
+        }
+        result.ok = false;
+        result.outcome = "rejected";
+        result.code = "SETTLE_SLOTS_FULL";
+        result.reason = "Too many manual measurements waiting for probe settle time";
+        result.retryable = true;
+    }
+    recordIntentChainStage(cmd.metadata,
+                           "execute_finished",
+                           "command",
+                           result.code.length() > 0 ? result.code.c_str() : "EXECUTE_FINISHED",
+                           "sensor command execution finished");
+    const char* outcome = result.outcome.length() > 0 ? result.outcome.c_str() : "failed";
+    const char* code = result.code.length() > 0 ? result.code.c_str() : "EXECUTE_FAIL";
+    logSensorQueueCorrelation("execute_finished", cmd, code);
+    publishIntentOutcome("command",
+                         cmd.metadata,
+                         outcome,
+                         code,
+                         result.reason.length() > 0
+                             ? result.reason
+                             : (result.ok ? "Sensor command applied" : "Sensor command execution failed"),
+                         result.retryable);
+}
+
 // M2: Processes all queued sensor commands on Core 1 (Safety-Task).
 // Called from safetyTaskFunction() — same task that owns sensorManager.
+// Parked commands whose settle time has passed run first.
 void processSensorCommandQueue(uint8_t max_items) {
     if (g_sensor_cmd_queue == NULL) return;
     SensorCommand cmd;
     uint8_t processed = 0;
     uint32_t epoch = getSafetyEpoch();
+    uint32_t now_ms = millis();
+    while (processed < max_items && takeParkedSensorCommand(cmd, now_ms, true)) {
+        executeSensorCommand(cmd, epoch);
+        processed++;
+    }
     while (processed < max_items && xQueueReceive(g_sensor_cmd_queue, &cmd, 0) == pdTRUE) {
-        IntentInvalidationReason invalidation_reason =
-            getIntentInvalidationReason(cmd.metadata, epoch);
-        if (invalidation_reason != IntentInvalidationReason::NONE &&
-            !isRecoveryIntentAllowed(cmd.topic, cmd.payload)) {
-            publishIntentOutcome("command",
-                                 cmd.metadata,
-                                 "expired",
-                                 invalidation_reason == IntentInvalidationReason::SAFETY_EPOCH_INVALIDATED
-                                     ? "SAFETY_EPOCH_INVALIDATED"
-                                     : "TTL_EXPIRED",
-                                 invalidation_reason == IntentInvalidationReason::SAFETY_EPOCH_INVALIDATED
-                                     ? "Sensor command invalidated by safety epoch update"
-                                     : "Sensor command TTL expired before execution",
-                                 false);
-            processed++;
-            continue;
-        }
-        CommandAdmissionContext admission_context{
-            mqttClient.isRegistrationConfirmed(),
-            g_system_config.current_state == STATE_CONFIG_PENDING_AFTER_RESET,
-            g_system_config.current_state == STATE_PENDING_APPROVAL,
-            g_system_config.current_state == STATE_SAFE_MODE ||
-                g_system_config.current_state == STATE_SAFE_MODE_PROVISIONING ||
-                g_system_config.current_state == STATE_ERROR,
-            g_system_config.current_state == STATE_SAFE_MODE,
-            isRecoveryIntentAllowed(cmd.topic, cmd.payload),
-            nullptr
-        };
-        CommandAdmissionDecision admission = shouldAcceptCommand(CommandSubtype::SENSOR, admission_context);
-        if (!admission.accepted) {
-            logSensorQueueCorrelation("admission_reject", cmd, admission.reason_code);
-            publishIntentOutcome("command",
-                                 cmd.metadata,
-                                 "rejected",
-                                 admission.code,
-                                 String("Sensor command blocked (reason_code=") + admission.reason_code + ")",
-                                 false);
-            processed++;
-            continue;
-        }
-        logSensorQueueCorrelation("admission_accept", cmd, admission.reason_code);
-        recordIntentChainStage(cmd.metadata,
-                               "execute_started",
-                               "command",
-                               "EXECUTE_STARTED",
-                               "sensor command execution started");
-        SensorCommandExecutionResult result =
-            handleSensorCommand(String(cmd.topic), String(cmd.payload), cmd.metadata);
-        recordIntentChainStage(cmd.metadata,
-                               "execute_finished",
-                               "command",
-                               result.code.length() > 0 ? result.code.c_str() : "EXECUTE_FINISHED",
-                               "sensor command execution finished");
-        const char* outcome = result.outcome.length() > 0 ? result.outcome.c_str() : "failed";
-        const char* code = result.code.length() > 0 ? result.code.c_str() : "EXECUTE_FAIL";
-        logSensorQueueCorrelation("execute_finished", cmd, code);
-        publishIntentOutcome("command",
-                             cmd.metadata,
-                             outcome,
-                             code,
-                             result.reason.length() > 0
-                                 ? result.reason
-                                 : (result.ok ? "Sensor command applied" : "Sensor command execution failed"),
-                             result.retryable);
+        executeSensorCommand(cmd, epoch);
         processed++;
     }
 }
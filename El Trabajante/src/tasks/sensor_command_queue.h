@@ -6,6 +6,8 @@
 #include "intent_contract.h"
 
 static const uint8_t SENSOR_CMD_QUEUE_SIZE = 20;
+// Manual measurements waiting for an excitation settle time (one per probe in practice)
+static const uint8_t SENSOR_CMD_PARKED_SIZE = 4;
 
 struct SensorCommand {
     char topic[128];
@@ -19,6 +21,7 @@ struct SensorCommandExecutionResult {
     String code;
     String reason;
     bool retryable;
+    uint32_t retry_after_ms;  // > 0: not finished (probe settling) — run again after this delay
 };
 
 extern QueueHandle_t g_sensor_cmd_queue;
@@ -28,3 +31,5 @@ bool queueSensorCommand(const char* topic, const char* payload, const IntentMeta
 void flushSensorCommandQueue();
 void processSensorCommandQueue(uint8_t max_items = 4);
 uint32_t getSensorCommandQueueOverflowCount();
+// ms until the next parked command is due (UINT32_MAX: none parked)
+uint32_t getSensorCommandMsUntilRetry(uint32_t now_ms);
@@ -0,0 +1,48 @@
+#include "task_wake.h"
+
+#ifdef NATIVE_TEST
+    #include <chrono>
+#endif
+
+void TaskWake::attachCurrentTask() {
+#ifndef NATIVE_TEST
+    owner_ = xTaskGetCurrentTaskHandle();
+#endif
+    attached_ = true;
+}
+
+void TaskWake::signal(uint32_t bits) {
+    if (!attached_) {
+        return;
+    }
+#ifdef NATIVE_TEST
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_bits_ |= bits;
+    }
+    cv_.notify_one();
+#else
+    xTaskNotify(owner_, bits, eSetBits);
+#endif
+}
+
+uint32_t TaskWake::wait(uint32_t timeout_ms) {
+    uint32_t bits = 0;
+#ifdef NATIVE_TEST
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                 [this] { return pending_bits_ != 0; });
+    bits = pending_bits_;
+    pending_bits_ = 0;
+#else
+    if (xTaskNotifyWait(0, UINT32_MAX, &bits, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        bits = 0;
+    }
+#endif
+    if (bits != 0) {
+        event_wakes_++;
+    } else {
+        timeout_wakes_++;
+    }
+    return bits;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef NATIVE_TEST
+    #include <condition_variable>
+    #include <mutex>
+#else
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+#endif
+
+// ============================================
+// TASK WAKE (event-driven task loop)
+// ============================================
+// Lets a task block until either work is signalled or its next deadline is
+// reached, instead of polling with a fixed vTaskDelay(). Used by the
+// Communication-Task: queuePublish() signals, the task drains the publish
+// queue immediately and otherwise sleeps until the next heartbeat/periodic job.
+//
+// Target: direct-to-task notification (xTaskNotify / xTaskNotifyWait, eSetBits).
+// Bits signalled while the owner is busy stay pending — no lost wake-ups.
+// NATIVE_TEST: std::condition_variable shim with identical semantics, so the
+// enqueue-to-wake latency can be measured in unit tests.
+//
+// signal() is task-context only (not ISR-safe).
+// ============================================
+class TaskWake {
+public:
+    TaskWake() = default;
+    TaskWake(const TaskWake&) = delete;
+    TaskWake& operator=(const TaskWake&) = delete;
+
+    // Called once from the waiting task before the first wait().
+    void attachCurrentTask();
+    bool isAttached() const { return attached_; }
+
+    // Sets bits and wakes the owner (no-op before attachCurrentTask()).
+    void signal(uint32_t bits);
+
+    // Blocks up to timeout_ms. Returns the signalled bits (cleared on return),
+    // 0 on timeout.
+    uint32_t wait(uint32_t timeout_ms);
+
+    uint32_t getEventWakes() const { return event_wakes_; }
+    uint32_t getTimeoutWakes() const { return timeout_wakes_; }
+
+private:
+    volatile bool attached_ = false;
+    uint32_t event_wakes_ = 0;    // Written by the owner task only
+    uint32_t timeout_wakes_ = 0;
+
+#ifdef NATIVE_TEST
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t pending_bits_ = 0;
+#else
+    TaskHandle_t owner_ = NULL;
+#endif
+};
@@ -0,0 +1,316 @@
+#include "log_shipper.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================
+// GLOBAL INSTANCE
+// ============================================
+LogShipper& logShipper = LogShipper::getInstance();
+
+LogShipper& LogShipper::getInstance() {
+    static LogShipper instance;
+    return instance;
+}
+
+LogShipper::LogShipper()
+    : count_(0),
+      cursor_(0),
+      frame_seq_(0),
+      dropped_since_frame_(0),
+      last_refill_ms_(0),
+      byte_tokens_milli_(0),
+      msg_tokens_milli_(0) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+// ============================================
+// LIFECYCLE
+// ============================================
+void LogShipper::begin(const LogShipperConfig& config, uint32_t now_ms) {
+    config_ = config;
+    if (config_.min_level > LOG_CRITICAL) {
+        config_.min_level = LOG_CRITICAL;
+    }
+    memset(&stats_, 0, sizeof(stats_));
+    count_ = 0;
+    cursor_ = logger.getLogSequence();
+    dropped_since_frame_ = 0;
+    last_refill_ms_ = now_ms;
+    byte_tokens_milli_ = static_cast<uint32_t>(config_.bytes_per_min) * 1000UL;
+    msg_tokens_milli_ = static_cast<uint32_t>(config_.msgs_per_min) * 1000UL;
+}
+
+// ============================================
+// STAGING
+// ============================================
+size_t LogShipper::collect(const Logger& source) {
+    if (!config_.enabled) {
+        return 0;
+    }
+    size_t staged = 0;
+    LogEntry batch[4];
+    size_t read;
+    do {
+        uint32_t missed = 0;
+        read = source.readEntriesSince(&cursor_, batch, sizeof(batch) / sizeof(batch[0]), &missed);
+        stats_.entries_missed += missed;
+        for (size_t i = 0; i < read; i++) {
+            if (offer(batch[i])) {
+                staged++;
+            }
+        }
+    } while (read > 0);
+    return staged;
+}
+
+bool LogShipper::offer(const LogEntry& entry) {
+    if (!config_.enabled || entry.level < config_.min_level || entry.level > LOG_CRITICAL) {
+        return false;
+    }
+    if (count_ >= LOG_SHIPPER_QUEUE_SIZE && !makeRoom(entry.level)) {
+        stats_.dropped[entry.level]++;
+        dropped_since_frame_++;
+        return false;
+    }
+    queue_[count_++] = entry;
+    return true;
+}
+
+// Full queue: evict the oldest entry of the lowest staged level, unless the
+// incoming entry is below that level itself.
+bool LogShipper::makeRoom(LogLevel incoming) {
+    size_t victim = count_;
+    for (size_t i = 0; i < count_; i++) {
+        if (victim == count_ || queue_[i].level < queue_[victim].level) {
+            victim = i;
+        }
+    }
+    if (victim == count_ || queue_[victim].level > incoming) {
+        return false;
+    }
+    stats_.dropped[queue_[victim].level]++;
+    dropped_since_frame_++;
+    removeAt(victim);
+    return true;
+}
+
+void LogShipper::removeAt(size_t index) {
+    for (size_t i = index; i + 1 < count_; i++) {
+        queue_[i] = queue_[i + 1];
+    }
+    count_--;
+}
+
+bool LogShipper::isDue(uint32_t now_ms) const {
+    if (!config_.enabled || count_ == 0) {
+        return false;
+    }
+    if (count_ >= LOG_SHIPPER_FLUSH_COUNT) {
+        return true;
+    }
+    for (size_t i = 0; i < count_; i++) {
+        if (queue_[i].level >= LOG_ERROR) {
+            return true;
+        }
+    }
+    uint32_t age = now_ms - static_cast<uint32_t>(queue_[0].timestamp);
+    return static_cast<int32_t>(age) >= 0 && age >= config_.flush_interval_ms;
+}
+
+// ============================================
+// RATE CONTROL
+// ============================================
+void LogShipper::refill(uint32_t now_ms) {
+    uint32_t elapsed = now_ms - last_refill_ms_;
+    if (static_cast<int32_t>(elapsed) <= 0) {
+        return;
+    }
+    last_refill_ms_ = now_ms;
+
+    // per_min * 1000 milli-tokens per 60000 ms
+    const uint32_t byte_cap = static_cast<uint32_t>(config_.bytes_per_min) * 1000UL;
+    const uint32_t msg_cap = static_cast<uint32_t>(config_.msgs_per_min) * 1000UL;
+    uint64_t bytes = byte_tokens_milli_ + static_cast<uint64_t>(elapsed) * config_.bytes_per_min / 60;
+    uint64_t msgs = msg_tokens_milli_ + static_cast<uint64_t>(elapsed) * config_.msgs_per_min / 60;
+    byte_tokens_milli_ = bytes > byte_cap ? byte_cap : static_cast<uint32_t>(bytes);
+    msg_tokens_milli_ = msgs > msg_cap ? msg_cap : static_cast<uint32_t>(msgs);
+}
+
+// ============================================
+// FRAME ENCODING
+// ============================================
+static size_t appendEscaped(char* out, size_t capacity, size_t pos, const char* text) {
+    for (const char* p = text; *p != '\0'; p++) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        char escaped[7];
+        size_t len;
+        if (c == '"' || c == '\\') {
+            escaped[0] = '\\';
+            escaped[1] = static_cast<char>(c);
+            len = 2;
+        } else if (c < 0x20) {
+            len = static_cast<size_t>(snprintf(escaped, sizeof(escaped), "\\u%04x", c));
+        } else {
+            escaped[0] = static_cast<char>(c);
+            len = 1;
+        }
+        if (pos + len >= capacity) {
+            return 0;
+        }
+        memcpy(out + pos, escaped, len);
+        pos += len;
+    }
+    return pos;
+}
+
+static size_t escapedLength(const char* text) {
+    size_t len = 0;
+    for (const char* p = text; *p != '\0'; p++) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        len += (c == '"' || c == '\\') ? 2 : (c < 0x20 ? 6 : 1);
+    }
+    return len;
+}
+
+// Encoded size of one entry without writing it (frame selection)
+size_t LogShipper::entrySize(const LogEntry& entry) {
+    char ts[12];
+    int n = snprintf(ts, sizeof(ts), "%lu", static_cast<unsigned long>(entry.timestamp));
+    // [ + ts + ,"L"," + tag + "," + msg + "]
+    return 1 + static_cast<size_t>(n > 0 ? n : 0) + 6 + escapedLength(entry.tag) + 3 +
+           escapedLength(entry.message) + 2;
+}
+
+// [ts,"W","TAG","message"] — returns length, 0 if it does not fit
+size_t LogShipper::encodeEntry(const LogEntry& entry, char* out, size_t capacity) {
+    int n = snprintf(out, capacity, "[%lu,\"%c\",\"", static_cast<unsigned long>(entry.timestamp),
+                     Logger::getLogLevelString(entry.level)[0]);
+    if (n < 0 || static_cast<size_t>(n) >= capacity) {
+        return 0;
+    }
+    size_t pos = appendEscaped(out, capacity, static_cast<size_t>(n), entry.tag);
+    if (pos == 0 || pos + 3 >= capacity) {
+        return 0;
+    }
+    memcpy(out + pos, "\",\"", 3);
+    pos = appendEscaped(out, capacity, pos + 3, entry.message);
+    if (pos == 0 || pos + 2 >= capacity) {
+        return 0;
+    }
+    memcpy(out + pos, "\"]", 2);
+    pos += 2;
+    out[pos] = '\0';
+    return pos;
+}
+
+size_t LogShipper::buildFrame(uint32_t now_ms, char* out, size_t capacity) {
+    if (!config_.enabled || count_ == 0 || out == nullptr) {
+        return 0;
+    }
+    refill(now_ms);
+    if (msg_tokens_milli_ < 1000) {
+        stats_.budget_deferrals++;
+        return 0;
+    }
+
+    size_t budget = byte_tokens_milli_ / 1000;
+    if (budget > capacity) {
+        budget = capacity;
+    }
+    if (budget > LOG_SHIPPER_MAX_FRAME) {
+        budget = LOG_SHIPPER_MAX_FRAME;
+    }
+
+    char header[80];
+    int header_len = snprintf(header, sizeof(header), "{\"seq\":%lu,\"up\":%lu,\"dropped\":%lu,\"logs\":[",
+                              static_cast<unsigned long>(frame_seq_ + 1),
+                              static_cast<unsigned long>(now_ms),
+                              static_cast<unsigned long>(dropped_since_frame_));
+    if (header_len < 0) {
+        return 0;
+    }
+
+    // Select by level (highest first) within the byte budget; "]}" + NUL reserved
+    size_t sizes[LOG_SHIPPER_QUEUE_SIZE];
+    bool selected[LOG_SHIPPER_QUEUE_SIZE];
+    for (size_t i = 0; i < count_; i++) {
+        sizes[i] = entrySize(queue_[i]);
+        selected[i] = false;
+    }
+    size_t total = static_cast<size_t>(header_len) + 3;
+    size_t picked = 0;
+    for (int level = LOG_CRITICAL; level >= static_cast<int>(config_.min_level); level--) {
+        for (size_t i = 0; i < count_; i++) {
+            if (queue_[i].level != level) {
+                continue;
+            }
+            size_t needed = sizes[i] + (picked > 0 ? 1 : 0);
+            if (total + needed <= budget) {
+                selected[i] = true;
+                total += needed;
+                picked++;
+            }
+        }
+    }
+    if (picked == 0) {
+        stats_.budget_deferrals++;
+        return 0;
+    }
+
+    // Encode chronologically
+    memcpy(out, header, static_cast<size_t>(header_len));
+    size_t pos = static_cast<size_t>(header_len);
+    bool first = true;
+    for (size_t i = 0; i < count_; i++) {
+        if (!selected[i]) {
+            continue;
+        }
+        if (!first) {
+            out[pos++] = ',';
+        }
+        pos += encodeEntry(queue_[i], out + pos, capacity - pos);
+        first = false;
+    }
+    out[pos++] = ']';
+    out[pos++] = '}';
+    out[pos] = '\0';
+
+    // Shipped entries leave the queue (selected[] follows the compaction)
+    size_t write = 0;
+    for (size_t i = 0; i < count_; i++) {
+        if (!selected[i]) {
+            queue_[write++] = queue_[i];
+        }
+    }
+    count_ = write;
+
+    byte_tokens_milli_ -= static_cast<uint32_t>(pos) * 1000UL > byte_tokens_milli_
+                              ? byte_tokens_milli_ : static_cast<uint32_t>(pos) * 1000UL;
+    msg_tokens_milli_ -= 1000;
+    frame_seq_++;
+    dropped_since_frame_ = 0;
+    stats_.frames++;
+    stats_.entries_shipped += picked;
+    return pos;
+}
+
+// ============================================
+// CONFIG PERSISTENCE
+// ============================================
+uint32_t LogShipper::packConfig(const LogShipperConfig& config) {
+    return (config.enabled ? 1UL : 0UL) |
+           (static_cast<uint32_t>(config.min_level) & 0x07) << 1 |
+           static_cast<uint32_t>(config.msgs_per_min) << 8 |
+           static_cast<uint32_t>(config.bytes_per_min) << 16;
+}
+
+LogShipperConfig LogShipper::unpackConfig(uint32_t packed) {
+    LogShipperConfig config;
+    config.enabled = (packed & 0x01) != 0;
+    uint8_t level = static_cast<uint8_t>((packed >> 1) & 0x07);
+    config.min_level = level <= LOG_CRITICAL ? static_cast<LogLevel>(level) : LOG_WARNING;
+    config.msgs_per_min = static_cast<uint8_t>((packed >> 8) & 0xFF);
+    config.bytes_per_min = static_cast<uint16_t>(packed >> 16);
+    return config;
+}
@@ -0,0 +1,102 @@
+#ifndef UTILS_LOG_SHIPPER_H
+#define UTILS_LOG_SHIPPER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "logger.h"
+
+// ============================================
+// LOG SHIPPER (remote logs over MQTT, rate controlled)
+// ============================================
+// Field nodes without a serial tap are blind: the Logger ring only lives in
+// RAM. The shipper pulls new ring entries at or above a configurable level
+// (Logger::readEntriesSince, cursor based), stages them and emits compact
+// frames for .../system/log (QoS 0):
+//   {"seq":12,"up":123456,"dropped":3,"logs":[[ts,"W","TAG","msg"],...]}
+//
+// Rate control: byte and message budgets per minute (token buckets refilled
+// continuously). Under pressure the lowest levels go first — a full staging
+// queue evicts its oldest lowest-level entry, and a frame that does not fit
+// the byte budget carries the highest levels and leaves the rest staged.
+//
+// Logging tasks only write the ring as before; collecting, formatting and
+// publishing run on the Comm-Task. Pure logic — time is passed in.
+// ============================================
+
+static const size_t LOG_SHIPPER_QUEUE_SIZE = 16;        // Staged entries
+static const size_t LOG_SHIPPER_MAX_FRAME = 1024;       // Bytes per publish
+static const uint8_t LOG_SHIPPER_FLUSH_COUNT = 8;       // Staged entries that trigger a frame
+
+struct LogShipperConfig {
+    bool enabled = false;
+    LogLevel min_level = LOG_WARNING;
+    uint16_t bytes_per_min = 4096;
+    uint8_t msgs_per_min = 6;
+    uint32_t flush_interval_ms = 10000;                 // Max. age of a staged entry (log timestamp)
+};
+
+struct LogShipperStats {
+    uint32_t frames;
+    uint32_t entries_shipped;
+    uint32_t entries_missed;                            // Overwritten in the ring before collect
+    uint32_t budget_deferrals;                          // Due, but no budget left
+    uint32_t dropped[LOG_CRITICAL + 1];                 // Evicted under pressure, per level
+};
+
+class LogShipper {
+public:
+    static LogShipper& getInstance();
+
+    // Applies config and resets staging, budgets (full) and stats.
+    // Only entries logged after this call are shipped.
+    void begin(const LogShipperConfig& config, uint32_t now_ms);
+    const LogShipperConfig& getConfig() const { return config_; }
+    bool isEnabled() const { return config_.enabled; }
+
+    // Pull new ring entries >= min_level into the staging queue
+    size_t collect(const Logger& source);
+    // Stage one entry (collect() path; exposed for tests)
+    bool offer(const LogEntry& entry);
+
+    // A frame should be built now (enough entries, an error, or oldest too old)
+    bool isDue(uint32_t now_ms) const;
+
+    // Builds one frame within budget; 0 = nothing staged or budget exhausted.
+    // Shipped entries leave the queue; budgets are charged.
+    size_t buildFrame(uint32_t now_ms, char* out, size_t capacity);
+
+    size_t getStagedCount() const { return count_; }
+    const LogShipperStats& getStats() const { return stats_; }
+
+    // Persisted form (NVS system_config/log_ship):
+    //   bit 0 enabled, bits 1-3 level, bits 8-15 msgs/min, bits 16-31 bytes/min
+    static uint32_t packConfig(const LogShipperConfig& config);
+    static LogShipperConfig unpackConfig(uint32_t packed);
+
+private:
+    LogShipper();
+    LogShipper(const LogShipper&) = delete;
+    LogShipper& operator=(const LogShipper&) = delete;
+
+    LogShipperConfig config_;
+    LogShipperStats stats_;
+    LogEntry queue_[LOG_SHIPPER_QUEUE_SIZE];            // Chronological
+    size_t count_;
+    uint32_t cursor_;
+    uint32_t frame_seq_;
+    uint32_t dropped_since_frame_;
+    uint32_t last_refill_ms_;
+    uint32_t byte_tokens_milli_;                        // Token buckets in 1/1000 units
+    uint32_t msg_tokens_milli_;
+
+    void refill(uint32_t now_ms);
+    void removeAt(size_t index);
+    bool makeRoom(LogLevel incoming);
+    static size_t entrySize(const LogEntry& entry);
+    static size_t encodeEntry(const LogEntry& entry, char* out, size_t capacity);
+};
+
+extern LogShipper& logShipper;
+
+#endif // UTILS_LOG_SHIPPER_H
@@ -1,5 +1,20 @@
 #include "logger.h"
 
+#include <cstdarg>
+#include <cstdio>
+
+#ifndef NATIVE_TEST
+#include <freertos/FreeRTOS.h>
+
+// Ring writes (any task) vs. readEntriesSince (Comm-Task)
+static portMUX_TYPE s_log_ring_mux = portMUX_INITIALIZER_UNLOCKED;
+#define LOG_RING_LOCK() portENTER_CRITICAL(&s_log_ring_mux)
+#define LOG_RING_UNLOCK() portEXIT_CRITICAL(&s_log_ring_mux)
+#else
+#define LOG_RING_LOCK()
+#define LOG_RING_UNLOCK()
+#endif
+
 // ============================================
 // GLOBAL LOGGER INSTANCE
 // ============================================
@@ -15,9 +30,12 @@ Logger& Logger::getInstance() {
 
 Logger::Logger()
   : current_log_level_(LOG_INFO),
+    min_enabled_level_(LOG_INFO),
     serial_enabled_(true),
+    tag_override_count_(0),
     log_buffer_index_(0),
-    log_count_(0) {
+    log_count_(0),
+    log_sequence_(0) {
   // Initialize fixed buffer
   for (size_t i = 0; i < MAX_LOG_ENTRIES; i++) {
     log_buffer_[i].timestamp = 0;
@@ -44,6 +62,7 @@ void Logger::begin() {
 // ============================================
 void Logger::setLogLevel(LogLevel level) {
   current_log_level_ = level;
+  recomputeMinEnabledLevel();
   if (serial_enabled_) {
     Serial.printf("[%10lu] [INFO    ] [LOGGER  ] Log level changed to %s\n",
                   millis(), getLogLevelString(level));
@@ -54,11 +73,117 @@ void Logger::setSerialEnabled(bool enabled) {
   serial_enabled_ = enabled;
 }
 
+// ============================================
+// PER-MODULE (TAG) OVERRIDES
+// ============================================
+bool Logger::setTagLogLevel(const char* tag, LogLevel level) {
+  if (tag == nullptr || tag[0] == '\0' || strlen(tag) >= sizeof(tag_overrides_[0].tag)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < tag_override_count_; i++) {
+    if (strcmp(tag_overrides_[i].tag, tag) == 0) {
+      tag_overrides_[i].level = level;
+      recomputeMinEnabledLevel();
+      return true;
+    }
+  }
+
+  if (tag_override_count_ >= MAX_TAG_LEVEL_OVERRIDES) {
+    return false;
+  }
+
+  TagLevelOverride& entry = tag_overrides_[tag_override_count_];
+  strncpy(entry.tag, tag, sizeof(entry.tag) - 1);
+  entry.tag[sizeof(entry.tag) - 1] = '\0';
+  entry.level = level;
+  tag_override_count_++;
+  recomputeMinEnabledLevel();
+  return true;
+}
+
+bool Logger::clearTagLogLevel(const char* tag) {
+  if (tag == nullptr) {
+    return false;
+  }
+  for (size_t i = 0; i < tag_override_count_; i++) {
+    if (strcmp(tag_overrides_[i].tag, tag) == 0) {
+      // Keep the table dense: move last entry into the freed slot
+      tag_overrides_[i] = tag_overrides_[tag_override_count_ - 1];
+      tag_override_count_--;
+      recomputeMinEnabledLevel();
+      return true;
+    }
+  }
+  return false;
+}
+
+void Logger::clearTagLogLevels() {
+  tag_override_count_ = 0;
+  recomputeMinEnabledLevel();
+}
+
+size_t Logger::formatTagLogLevelSpec(char* out, size_t out_len) const {
+  if (out == nullptr || out_len == 0) {
+    return 0;
+  }
+  out[0] = '\0';
+
+  size_t written = 0;
+  for (size_t i = 0; i < tag_override_count_; i++) {
+    int n = snprintf(out + written, out_len - written, "%s%s=%s",
+                     (i == 0) ? "" : ",",
+                     tag_overrides_[i].tag,
+                     getLogLevelString(tag_overrides_[i].level));
+    if (n < 0 || static_cast<size_t>(n) >= out_len - written) {
+      // Truncated entry — cut back to the last complete one
+      out[written] = '\0';
+      break;
+    }
+    written += static_cast<size_t>(n);
+  }
+  return written;
+}
+
+size_t Logger::applyTagLogLevelSpec(const char* spec) {
+  clearTagLogLevels();
+  if (spec == nullptr) {
+    return 0;
+  }
+
+  size_t applied = 0;
+  const char* cursor = spec;
+  while (*cursor != '\0') {
+    const char* end = strchr(cursor, ',');
+    size_t len = (end != nullptr) ? static_cast<size_t>(end - cursor) : strlen(cursor);
+
+    char item[32];
+    if (len > 0 && len < sizeof(item)) {
+      memcpy(item, cursor, len);
+      item[len] = '\0';
+      char* sep = strchr(item, '=');
+      LogLevel level;
+      if (sep != nullptr) {
+        *sep = '\0';
+        if (tryParseLogLevel(sep + 1, &level) && setTagLogLevel(item, level)) {
+          applied++;
+        }
+      }
+    }
+
+    if (end == nullptr) {
+      break;
+    }
+    cursor = end + 1;
+  }
+  return applied;
+}
+
 // ============================================
 // PRIMARY API with TAG (ESP-IDF convention)
 // ============================================
 void Logger::log(LogLevel level, const char* tag, const char* message) {
-  if (!isLogLevelEnabled(level)) {
+  if (!shouldLog(level, tag)) {
     return;
   }
 
@@ -72,6 +197,18 @@ void Logger::log(LogLevel level, const char* tag, const char* message) {
   addToBuffer(level, safe_tag, safe_message);
 }
 
+void Logger::logf(LogLevel level, const char* tag, const char* fmt, ...) {
+  if (!shouldLog(level, tag) || fmt == nullptr) {
+    return;
+  }
+  char message[sizeof(LogEntry::message)];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(message, sizeof(message), fmt, args);
+  va_end(args);
+  log(level, tag, message);
+}
+
 void Logger::debug(const char* tag, const char* message) {
   log(LOG_DEBUG, tag, message);
 }
@@ -96,8 +233,10 @@ void Logger::critical(const char* tag, const char* message) {
 // LOG MANAGEMENT
 // ============================================
 void Logger::clearLogs() {
+  LOG_RING_LOCK();
   log_buffer_index_ = 0;
   log_count_ = 0;
+  LOG_RING_UNLOCK();
   if (serial_enabled_) {
     Serial.println("[LOGGER  ] Log buffer cleared");
   }
@@ -130,6 +269,37 @@ size_t Logger::getLogCount() const {
   return log_count_;
 }
 
+size_t Logger::readEntriesSince(uint32_t* cursor, LogEntry* out, size_t max_entries,
+                                uint32_t* missed) const {
+  if (missed != nullptr) {
+    *missed = 0;
+  }
+  if (cursor == nullptr || out == nullptr || max_entries == 0) {
+    return 0;
+  }
+
+  LOG_RING_LOCK();
+  uint32_t newest = log_sequence_;
+  uint32_t oldest = newest - static_cast<uint32_t>(log_count_);
+  if (static_cast<int32_t>(*cursor - oldest) < 0) {
+    if (missed != nullptr) {
+      *missed = oldest - *cursor;
+    }
+    *cursor = oldest;
+  }
+
+  size_t copied = 0;
+  while (*cursor != newest && copied < max_entries) {
+    // Entry with sequence s lives at (index - (newest - s)) mod size
+    size_t back = static_cast<size_t>(newest - *cursor);
+    size_t index = (log_buffer_index_ + MAX_LOG_ENTRIES - back) % MAX_LOG_ENTRIES;
+    out[copied++] = log_buffer_[index];
+    (*cursor)++;
+  }
+  LOG_RING_UNLOCK();
+  return copied;
+}
+
 bool Logger::isLogLevelEnabled(LogLevel level) const {
   return level >= current_log_level_;
 }
@@ -149,17 +319,49 @@ const char* Logger::getLogLevelString(LogLevel level) {
 }
 
 LogLevel Logger::getLogLevelFromString(const char* level_str) {
-  if (strcmp(level_str, "DEBUG") == 0) return LOG_DEBUG;
-  if (strcmp(level_str, "INFO") == 0) return LOG_INFO;
-  if (strcmp(level_str, "WARNING") == 0) return LOG_WARNING;
-  if (strcmp(level_str, "ERROR") == 0) return LOG_ERROR;
-  if (strcmp(level_str, "CRITICAL") == 0) return LOG_CRITICAL;
+  LogLevel level;
+  if (tryParseLogLevel(level_str, &level)) {
+    return level;
+  }
   return LOG_INFO;  // Default
 }
 
+bool Logger::tryParseLogLevel(const char* level_str, LogLevel* out) {
+  if (level_str == nullptr || out == nullptr) {
+    return false;
+  }
+  if (strcmp(level_str, "DEBUG") == 0) { *out = LOG_DEBUG; return true; }
+  if (strcmp(level_str, "INFO") == 0) { *out = LOG_INFO; return true; }
+  if (strcmp(level_str, "WARNING") == 0) { *out = LOG_WARNING; return true; }
+  if (strcmp(level_str, "ERROR") == 0) { *out = LOG_ERROR; return true; }
+  if (strcmp(level_str, "CRITICAL") == 0) { *out = LOG_CRITICAL; return true; }
+  return false;
+}
+
 // ============================================
 // HELPER METHODS
 // ============================================
+LogLevel Logger::effectiveLevelForTag(const char* tag) const {
+  if (tag != nullptr) {
+    for (size_t i = 0; i < tag_override_count_; i++) {
+      if (strcmp(tag_overrides_[i].tag, tag) == 0) {
+        return tag_overrides_[i].level;
+      }
+    }
+  }
+  return current_log_level_;
+}
+
+void Logger::recomputeMinEnabledLevel() {
+  LogLevel min_level = current_log_level_;
+  for (size_t i = 0; i < tag_override_count_; i++) {
+    if (tag_overrides_[i].level < min_level) {
+      min_level = tag_overrides_[i].level;
+    }
+  }
+  min_enabled_level_ = min_level;
+}
+
 void Logger::writeToSerial(LogLevel level, const char* tag, const char* message) {
   unsigned long timestamp = millis();
   const char* level_str = getLogLevelString(level);
@@ -172,11 +374,13 @@ void Logger::writeToSerial(LogLevel level, const char* tag, const char* message)
 }
 
 void Logger::addToBuffer(LogLevel level, const char* tag, const char* message) {
-  size_t index = log_buffer_index_;
   const char* safe_tag = (tag != nullptr && tag[0] != '\0') ? tag : "LOGGER";
   const char* safe_message = (message != nullptr) ? message : "<null>";
+  unsigned long timestamp = millis();
 
-  log_buffer_[index].timestamp = millis();
+  LOG_RING_LOCK();
+  size_t index = log_buffer_index_;
+  log_buffer_[index].timestamp = timestamp;
   log_buffer_[index].level = level;
   strncpy(log_buffer_[index].tag, safe_tag, sizeof(log_buffer_[index].tag) - 1);
   log_buffer_[index].tag[sizeof(log_buffer_[index].tag) - 1] = '\0';
@@ -188,4 +392,6 @@ void Logger::addToBuffer(LogLevel level, const char* tag, const char* message) {
   if (log_count_ < MAX_LOG_ENTRIES) {
     log_count_++;
   }
+  log_sequence_++;
+  LOG_RING_UNLOCK();
 }
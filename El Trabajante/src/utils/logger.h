@@ -38,8 +38,32 @@ public:
 
   // Configuration
   void setLogLevel(LogLevel level);
+  LogLevel getLogLevel() const { return current_log_level_; }
   void setSerialEnabled(bool enabled);
 
+  // Per-module (TAG) overrides — e.g. I2C=DEBUG while the global level stays INFO.
+  // Overrides may also raise a noisy module above the global level.
+  bool setTagLogLevel(const char* tag, LogLevel level);
+  bool clearTagLogLevel(const char* tag);
+  void clearTagLogLevels();
+  size_t getTagLogLevelCount() const { return tag_override_count_; }
+  // Serialized form "TAG=LEVEL,TAG=LEVEL" (persisted in NVS system_config/log_tags)
+  size_t formatTagLogLevelSpec(char* out, size_t out_len) const;
+  size_t applyTagLogLevelSpec(const char* spec);
+
+  // Hot-path guard used by the LOG_* macros BEFORE message arguments are built.
+  // Without overrides this is a single compare; the TAG lookup only runs for
+  // levels that at least one module could accept.
+  inline bool shouldLog(LogLevel level, const char* tag) const {
+    if (level < min_enabled_level_) {
+      return false;
+    }
+    if (tag_override_count_ == 0) {
+      return level >= current_log_level_;
+    }
+    return level >= effectiveLevelForTag(tag);
+  }
+
   // Primary API with TAG (ESP-IDF convention)
   // Format: [millis] [LEVEL   ] [TAG     ] message
   void log(LogLevel level, const char* tag, const char* message);
@@ -49,6 +73,11 @@ public:
   void error(const char* tag, const char* message);
   void critical(const char* tag, const char* message);
 
+  // printf-style variant for hot/failure paths: formats into a stack buffer
+  // (LogEntry::message size), no String concatenation, no heap.
+  void logf(LogLevel level, const char* tag, const char* fmt, ...)
+      __attribute__((format(printf, 4, 5)));
+
   // Convenience Wrapper: String (Kompatibilitaet)
   inline void log(LogLevel level, const char* tag, const String& message) {
     log(level, tag, message.c_str());
@@ -65,9 +94,18 @@ public:
   size_t getLogCount() const;
   bool isLogLevelEnabled(LogLevel level) const;
 
+  // Cursor-based ring access for consumers on another task (LogShipper).
+  // Copies entries with sequence >= *cursor (oldest first, max max_entries)
+  // and advances *cursor. Entries already overwritten are reported in
+  // *missed. Start with cursor = getLogSequence() to skip the backlog.
+  size_t readEntriesSince(uint32_t* cursor, LogEntry* out, size_t max_entries,
+                          uint32_t* missed) const;
+  uint32_t getLogSequence() const { return log_sequence_; }
+
   // Utilities
   static const char* getLogLevelString(LogLevel level);
   static LogLevel getLogLevelFromString(const char* level_str);
+  static bool tryParseLogLevel(const char* level_str, LogLevel* out);
 
 private:
   Logger();  // Private Constructor (Singleton)
@@ -77,16 +115,29 @@ private:
 
   // Internal state
   LogLevel current_log_level_;
+  LogLevel min_enabled_level_;  // min(global, all TAG overrides) — macro fast reject
   bool serial_enabled_;
 
+  // Fixed TAG override table (no heap, linear scan over <= 8 entries)
+  struct TagLevelOverride {
+    char tag[12];
+    LogLevel level;
+  };
+  static const size_t MAX_TAG_LEVEL_OVERRIDES = 8;
+  TagLevelOverride tag_overrides_[MAX_TAG_LEVEL_OVERRIDES];
+  size_t tag_override_count_;
+
   // Fixed Array Circular Buffer (Guide-konform)
   // Reduced from 100 to 50 entries — saves 7400 bytes BSS (MEM-OPT-1)
   static const size_t MAX_LOG_ENTRIES = 50;
   LogEntry log_buffer_[MAX_LOG_ENTRIES];
   size_t log_buffer_index_;
   size_t log_count_;
+  volatile uint32_t log_sequence_;  // Total entries ever written (ring cursor base)
 
   // Helper methods
+  LogLevel effectiveLevelForTag(const char* tag) const;
+  void recomputeMinEnabledLevel();
   void writeToSerial(LogLevel level, const char* tag, const char* message);
   void addToBuffer(LogLevel level, const char* tag, const char* message);
 };
@@ -100,20 +151,45 @@ extern Logger& logger;
 // CONVENIENCE MACROS (TAG-based, ESP-IDF convention)
 // Usage: static const char* TAG = "SENSOR";
 //        LOG_I(TAG, "Sensor initialized");
+//
+// The level guard runs before `msg` is evaluated, so suppressed calls like
+// LOG_D(TAG, "Payload: " + payload) never build their String argument.
 // ============================================
-#define LOG_D(tag, msg) logger.debug(tag, msg)
-#define LOG_I(tag, msg) logger.info(tag, msg)
-#define LOG_W(tag, msg) logger.warning(tag, msg)
-#define LOG_E(tag, msg) logger.error(tag, msg)
-#define LOG_C(tag, msg) logger.critical(tag, msg)
+#define LOGGER_GUARDED_CALL(level, method, tag, msg) \
+  do {                                               \
+    if (logger.shouldLog(level, tag)) {              \
+      logger.method(tag, msg);                       \
+    }                                                \
+  } while (0)
+
+#define LOG_D(tag, msg) LOGGER_GUARDED_CALL(LOG_DEBUG, debug, tag, msg)
+#define LOG_I(tag, msg) LOGGER_GUARDED_CALL(LOG_INFO, info, tag, msg)
+#define LOG_W(tag, msg) LOGGER_GUARDED_CALL(LOG_WARNING, warning, tag, msg)
+#define LOG_E(tag, msg) LOGGER_GUARDED_CALL(LOG_ERROR, error, tag, msg)
+#define LOG_C(tag, msg) LOGGER_GUARDED_CALL(LOG_CRITICAL, critical, tag, msg)
+
+// printf-style variants — arguments are only formatted when the level passes.
+//        LOGF_W(TAG, "Publish failed: %s", topic);
+#define LOGGER_GUARDED_LOGF(level, tag, ...)    \
+  do {                                          \
+    if (logger.shouldLog(level, tag)) {         \
+      logger.logf(level, tag, __VA_ARGS__);     \
+    }                                           \
+  } while (0)
+
+#define LOGF_D(tag, ...) LOGGER_GUARDED_LOGF(LOG_DEBUG, tag, __VA_ARGS__)
+#define LOGF_I(tag, ...) LOGGER_GUARDED_LOGF(LOG_INFO, tag, __VA_ARGS__)
+#define LOGF_W(tag, ...) LOGGER_GUARDED_LOGF(LOG_WARNING, tag, __VA_ARGS__)
+#define LOGF_E(tag, ...) LOGGER_GUARDED_LOGF(LOG_ERROR, tag, __VA_ARGS__)
+#define LOGF_C(tag, ...) LOGGER_GUARDED_LOGF(LOG_CRITICAL, tag, __VA_ARGS__)
 
 // Legacy single-arg macros — backward compatible, use "SYSTEM" as default TAG.
 // These ensure existing code compiles without changes.
 // Prefer TAG-based LOG_D/LOG_I/LOG_W/LOG_E/LOG_C for new code.
-#define LOG_DEBUG(msg) logger.debug("SYSTEM", msg)
-#define LOG_INFO(msg) logger.info("SYSTEM", msg)
-#define LOG_WARNING(msg) logger.warning("SYSTEM", msg)
-#define LOG_ERROR(msg) logger.error("SYSTEM", msg)
-#define LOG_CRITICAL(msg) logger.critical("SYSTEM", msg)
+#define LOG_DEBUG(msg) LOGGER_GUARDED_CALL(LOG_DEBUG, debug, "SYSTEM", msg)
+#define LOG_INFO(msg) LOGGER_GUARDED_CALL(LOG_INFO, info, "SYSTEM", msg)
+#define LOG_WARNING(msg) LOGGER_GUARDED_CALL(LOG_WARNING, warning, "SYSTEM", msg)
+#define LOG_ERROR(msg) LOGGER_GUARDED_CALL(LOG_ERROR, error, "SYSTEM", msg)
+#define LOG_CRITICAL(msg) LOGGER_GUARDED_CALL(LOG_CRITICAL, critical, "SYSTEM", msg)
 
 #endif
@@ -90,8 +90,8 @@ const char* TopicBuilder::buildSensorDataTopic(uint8_t gpio) {
   return validateTopicBuffer(written);
 }
 
-// ORPHANED - No server handler. See Mqtt_Protocoll.md inventory.
 // Pattern 2: kaiser/god/esp/{esp_id}/sensor/batch
+// Raw sample batches (RawSampleBatch frames) — server: sensor_batch_handler.py
 const char* TopicBuilder::buildSensorBatchTopic() {
   int written = snprintf(topic_buffer_, sizeof(topic_buffer_),
                          "kaiser/%s/esp/%s/sensor/batch",
@@ -233,6 +233,30 @@ const char* TopicBuilder::buildSystemErrorTopic() {
   return validateTopicBuffer(written);
 }
 
+// Remote log frames: kaiser/god/esp/{esp_id}/system/log
+const char* TopicBuilder::buildSystemLogTopic() {
+  int written = snprintf(topic_buffer_, sizeof(topic_buffer_),
+                         "kaiser/%s/esp/%s/system/log",
+                         kaiser_id_, esp_id_);
+  return validateTopicBuffer(written);
+}
+
+// OTA chunks (Server → ESP): kaiser/god/esp/{esp_id}/system/ota/chunk
+const char* TopicBuilder::buildSystemOtaChunkTopic() {
+  int written = snprintf(topic_buffer_, sizeof(topic_buffer_),
+                         "kaiser/%s/esp/%s/system/ota/chunk",
+                         kaiser_id_, esp_id_);
+  return validateTopicBuffer(written);
+}
+
+// OTA progress / chunk acks: kaiser/god/esp/{esp_id}/system/ota/status
+const char* TopicBuilder::buildSystemOtaStatusTopic() {
+  int written = snprintf(topic_buffer_, sizeof(topic_buffer_),
+                         "kaiser/%s/esp/%s/system/ota/status",
+                         kaiser_id_, esp_id_);
+  return validateTopicBuffer(written);
+}
+
 // Pattern 7: kaiser/god/esp/{esp_id}/config
 const char* TopicBuilder::buildConfigTopic() {
   int written = snprintf(topic_buffer_, sizeof(topic_buffer_), 
@@ -14,7 +14,7 @@ public:
   
   // Phase 1: 8 Critical Topic Patterns (Guide-konform)
   static const char* buildSensorDataTopic(uint8_t gpio);        // Pattern 1
-  // ORPHANED - No server handler. See Mqtt_Protocoll.md inventory.
+  // Raw sample batches (delta frames) — server: sensor_batch_handler.py
   static const char* buildSensorBatchTopic();                   // Pattern 2
   // ✅ Phase 2C: Sensor Command/Response Topics (On-Demand Measurement)
   static const char* buildSensorCommandTopic(uint8_t gpio);     // Phase 2C
@@ -35,6 +35,9 @@ public:
   static const char* buildSystemCommandTopic();                 // Pattern 6
   static const char* buildSystemDiagnosticsTopic();             // Phase 7
   static const char* buildSystemErrorTopic();                   // Phase 0 Bug-Fix
+  static const char* buildSystemLogTopic();                     // Remote log shipping (LogShipper)
+  static const char* buildSystemOtaChunkTopic();                // OTA chunks (Server → ESP)
+  static const char* buildSystemOtaStatusTopic();               // OTA progress / chunk acks
   static const char* buildConfigTopic();                        // Pattern 7
   static const char* buildConfigResponseTopic();
   static const char* buildIntentOutcomeTopic();                 // Unified intent outcome stream
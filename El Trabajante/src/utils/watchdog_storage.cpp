@@ -33,14 +33,6 @@ static uint32_t s_last_unexpected_log_ms = 0;
 static constexpr uint32_t kExpectedNotFoundLogIntervalMs = 300000UL;   // 5 min
 static constexpr uint32_t kUnexpectedNotFoundLogIntervalMs = 60000UL;  // 60 s
 
-static bool openNs(bool read_only) {
-  return storageManager.beginNamespace(kNamespace, read_only);
-}
-
-static void closeNs() {
-  storageManager.endNamespace();
-}
-
 static uint8_t countEntriesInWindow(const char* hist, time_t now) {
   if (!hist || hist[0] == '\0' || now < (time_t)kMinValidEpoch) {
     return 0;
@@ -112,9 +104,8 @@ void watchdogStorageInitEarly() {
 
   // Ensure namespace exists early to avoid periodic read-only NOT_FOUND noise
   // from watchdogStorageGetCountLast24h() when diagnostics snapshots run.
-  if (openNs(false)) {
-    closeNs();
-  }
+  NvsScopedNamespace ns(kNamespace, false);
+  (void)ns;
 }
 
 void watchdogStorageTryFinalizeBootRecord() {
@@ -131,16 +122,19 @@ void watchdogStorageTryFinalizeBootRecord() {
     return;
   }
 
-  if (!openNs(false)) {
-    LOG_W(TAG, "watchdogStorageTryFinalizeBootRecord: NVS open failed");
-    return;
+  bool ok = false;
+  {
+    // Scoped handle: Safety-Task record must not wait for a config save session
+    NvsScopedNamespace ns(kNamespace, false);
+    if (!ns.isOpen()) {
+      LOG_W(TAG, "watchdogStorageTryFinalizeBootRecord: NVS open failed");
+      return;
+    }
+    String prev = ns.getString(kHistKey, "");
+    String updated = pruneAndAppend(prev.c_str(), (uint32_t)now, now);
+    ok = ns.putString(kHistKey, updated.c_str());
   }
 
-  const char* prev = storageManager.getString(kHistKey, "");
-  String updated = pruneAndAppend(prev, (uint32_t)now, now);
-  bool ok = storageManager.putString(kHistKey, updated.c_str());
-  closeNs();
-
   if (!ok) {
     LOG_W(TAG, "watchdogStorageTryFinalizeBootRecord: failed to persist history");
     return;
@@ -157,10 +151,11 @@ void watchdogStorageTryFinalizeBootRecord() {
 
 uint8_t watchdogStorageGetCountLast24h() {
   time_t now = time(nullptr);
-  if (!openNs(true)) {
+  NvsScopedNamespace ns(kNamespace, true);
+  if (!ns.isOpen()) {
     return 0;
   }
-  if (!storageManager.keyExists(kHistKey)) {
+  if (!ns.keyExists(kHistKey)) {
     uint32_t now_ms = millis();
     bool unexpected_missing =
         s_boot_was_wdt && s_finalize_done && now >= (time_t)kMinValidEpoch;
@@ -178,14 +173,11 @@ uint8_t watchdogStorageGetCountLast24h() {
         LOG_D(TAG, "watchdog_history_missing class=expected_not_found count=" + String(c));
       }
     }
-    closeNs();
     return 0;
   }
 
-  const char* hist = storageManager.getString(kHistKey, "");
-  uint8_t n = countEntriesInWindow(hist, now);
-  closeNs();
-  return n;
+  String hist = ns.getString(kHistKey, "");
+  return countEntriesInWindow(hist.c_str(), now);
 }
 
 uint32_t watchdogStorageGetHistNotFoundExpectedCount() {
@@ -210,29 +202,30 @@ void watchdogStorageSaveDiagnosticsSnapshot(const WatchdogDiagnostics& diag) {
   if (serializeJson(doc, payload) == 0) {
     return;
   }
-  if (!openNs(false)) {
-    return;
+  NvsScopedNamespace ns(kNamespace, false);
+  if (ns.isOpen()) {
+    ns.putString(kSnapKey, payload.c_str());
   }
-  storageManager.putString(kSnapKey, payload.c_str());
-  closeNs();
 }
 
 void watchdogStorageLogLastSnapshotIfAny() {
   if (esp_reset_reason() != ESP_RST_TASK_WDT) {
     return;
   }
-  if (!openNs(true)) {
-    return;
+  String raw;
+  {
+    NvsScopedNamespace ns(kNamespace, true);
+    if (!ns.isOpen()) {
+      return;
+    }
+    raw = ns.getString(kSnapKey, "");
   }
-  const char* raw = storageManager.getString(kSnapKey, "");
-  if (raw == nullptr || raw[0] == '\0') {
-    closeNs();
+  if (raw.length() == 0) {
     return;
   }
 
   DynamicJsonDocument doc(384);
   DeserializationError err = deserializeJson(doc, raw);
-  closeNs();
 
   if (err) {
     LOG_W(TAG, "Last WDT snapshot: parse error");
@@ -3,6 +3,7 @@
 
 #ifdef NATIVE_TEST
 
+#include <cctype>
 #include <cstdint>
 #include <cstring>
 #include <cstdio>
@@ -38,6 +39,9 @@ public:
 
     const char* c_str() const { return data_.c_str(); }
     size_t length() const { return data_.length(); }
+    void toLowerCase() {
+        for (char& c : data_) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
 
     bool operator==(const String& other) const { return data_ == other.data_; }
     bool operator==(const char* other) const { return data_ == other; }
@@ -74,6 +78,10 @@ inline String operator+(const char* lhs, const String& rhs) {
 // ARDUINO API MOCK FUNCTIONS
 // ============================================
 
+// Flash constants are ordinary memory on the host
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
 inline unsigned long millis() { return 0; }
 inline void delay(unsigned long ms) { (void)ms; }
 inline void delayMicroseconds(unsigned long us) { (void)us; }
@@ -0,0 +1,109 @@
+#ifndef TEST_MOCKS_MOCK_ADC_SAMPLER_HAL_H
+#define TEST_MOCKS_MOCK_ADC_SAMPLER_HAL_H
+
+#ifdef NATIVE_TEST
+
+#include "../../src/drivers/hal/iadc_sampler_hal.h"
+#include <deque>
+#include <mutex>
+#include <set>
+#include <vector>
+
+// ============================================
+// Mock ADC Sampler HAL - Test Implementation
+// ============================================
+// Synthetic conversion stream instead of DMA frames:
+// - feed() queues samples, read() drains them in HAL-sized batches
+// - Scan control: start/stop calls and the active pin set are recorded;
+//   samples of pins outside the scan are still delivered (stale DMA frames)
+// - Failure injection: start_result
+// - Thread-safe queue (seqlock test runs a writer thread)
+//
+// Used in: Native unit tests only (test_adc_sampler)
+// NOT used in: Production code
+class MockAdcSamplerHal : public IAdcSamplerHal {
+public:
+    MockAdcSamplerHal() { reset(); }
+
+    // ============================================
+    // TEST HELPER - RESET STATE
+    // ============================================
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.clear();
+        supported = {32, 33, 34, 35, 36, 39};  // ESP32 ADC1 pins on the dev board
+        scan.clear();
+        running = false;
+        start_result = true;
+        start_count = 0;
+        stop_count = 0;
+        last_rate_hz = 0;
+    }
+
+    void feed(uint8_t gpio, uint16_t raw) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back({gpio, raw});
+    }
+
+    // Round-robin scan like the hardware pattern table
+    void feedInterleaved(const std::vector<uint8_t>& gpios, const std::vector<std::vector<uint16_t>>& streams) {
+        for (size_t i = 0; i < streams[0].size(); i++) {
+            for (size_t ch = 0; ch < gpios.size(); ch++) {
+                feed(gpios[ch], streams[ch][i]);
+            }
+        }
+    }
+
+    size_t pending() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+    // ============================================
+    // IAdcSamplerHal
+    // ============================================
+    bool supportsPin(uint8_t gpio) const override { return supported.count(gpio) > 0; }
+
+    bool start(const uint8_t* gpios, uint8_t count, uint32_t sample_rate_hz) override {
+        start_count++;
+        last_rate_hz = sample_rate_hz;
+        scan.assign(gpios, gpios + count);
+        running = start_result;
+        return start_result;
+    }
+
+    void stop() override {
+        stop_count++;
+        running = false;
+    }
+
+    size_t read(AdcRawSample* out, size_t max_samples, uint32_t timeout_ms) override {
+        (void)timeout_ms;
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t count = 0;
+        while (count < max_samples && !queue_.empty()) {
+            out[count++] = queue_.front();
+            queue_.pop_front();
+        }
+        return count;
+    }
+
+    // ============================================
+    // STATE
+    // ============================================
+    std::set<uint8_t> supported;
+    std::vector<uint8_t> scan;
+    bool running;
+    bool start_result;
+    int start_count;
+    int stop_count;
+    uint32_t last_rate_hz;
+
+private:
+    std::mutex mutex_;
+    std::deque<AdcRawSample> queue_;
+};
+
+#endif // NATIVE_TEST
+
+#endif
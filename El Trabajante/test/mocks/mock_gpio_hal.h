@@ -8,6 +8,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 // ============================================
 // Mock GPIO HAL - Test Implementation
@@ -42,6 +43,8 @@ public:
         pin_modes_.clear();
         pin_values_.clear();
         reserved_pins_.clear();
+        edge_handlers_.clear();
+        write_log_.clear();
         safe_mode_initialized_ = false;
         fail_next_request_ = false;
         fail_next_pinMode_ = false;
@@ -157,6 +160,7 @@ public:
         }
 
         pin_values_[gpio] = value;
+        write_log_.push_back({gpio, value});
         return true;
     }
 
@@ -177,6 +181,21 @@ public:
         return it->second;
     }
 
+    // ============================================
+    // EDGE INTERRUPTS
+    // ============================================
+    bool attachEdgeInterrupt(uint8_t gpio, GPIOEdgeCallback callback, void* arg) override {
+        if (callback == nullptr) {
+            return false;
+        }
+        edge_handlers_[gpio] = EdgeHandler{callback, arg};
+        return true;
+    }
+
+    void detachEdgeInterrupt(uint8_t gpio) override {
+        edge_handlers_.erase(gpio);
+    }
+
     // ============================================
     // EMERGENCY SAFE-MODE
     // ============================================
@@ -317,6 +336,36 @@ public:
         analog_values_[gpio] = value;
     }
 
+    // Simulate an edge: pin level changes, armed interrupt fires (ISR context)
+    void triggerEdge(uint8_t gpio, bool level, uint32_t time_us) {
+        pin_values_[gpio] = level;
+        auto it = edge_handlers_.find(gpio);
+        if (it != edge_handlers_.end()) {
+            it->second.callback(it->second.arg, gpio, level, time_us);
+        }
+    }
+
+    // Set pin level without an interrupt (e.g. edge lost while queue was full)
+    void setPinLevel(uint8_t gpio, bool level) {
+        pin_values_[gpio] = level;
+    }
+
+    bool hasEdgeInterrupt(uint8_t gpio) const {
+        return edge_handlers_.find(gpio) != edge_handlers_.end();
+    }
+
+    // Ordered digitalWrite history (pin sequencing assertions)
+    struct PinWrite {
+        uint8_t gpio;
+        bool value;
+    };
+    const std::vector<PinWrite>& getWriteLog() const {
+        return write_log_;
+    }
+    void clearWriteLog() {
+        write_log_.clear();
+    }
+
     // Add a custom hardware-reserved pin (for testing reservation logic)
     void addHardwareReservedPin(uint8_t gpio) {
         hardware_reserved_pins_.insert(gpio);
@@ -335,6 +384,13 @@ private:
     std::map<uint8_t, bool> pin_values_;
     std::map<uint8_t, uint16_t> analog_values_;
     std::map<uint8_t, PinReservation> reserved_pins_;
+
+    struct EdgeHandler {
+        GPIOEdgeCallback callback;
+        void* arg;
+    };
+    std::map<uint8_t, EdgeHandler> edge_handlers_;
+    std::vector<PinWrite> write_log_;
     std::set<uint8_t> hardware_reserved_pins_;
 
     bool safe_mode_initialized_;
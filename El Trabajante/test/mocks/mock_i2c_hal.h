@@ -0,0 +1,144 @@
+#ifndef TEST_MOCKS_MOCK_I2C_HAL_H
+#define TEST_MOCKS_MOCK_I2C_HAL_H
+
+#ifdef NATIVE_TEST
+
+#include "../../src/drivers/hal/ii2c_hal.h"
+#include <vector>
+
+// ============================================
+// Mock I2C HAL - Test Implementation
+// ============================================
+// Mock implementation of II2CHal with a small SHT3x device model:
+// - Records every transaction (write command / read length) and delay
+// - Idle vs. periodic mode: fetch-data in idle → read NACK (no data),
+//   single shot while periodic → command NACK (as on hardware)
+// - Failure injection: bus error on next write, sensor reset (back to idle)
+//
+// Used in: Native unit tests only (test_sht3x_periodic)
+// NOT used in: Production code
+
+struct MockI2CTransaction {
+    bool is_write;
+    uint8_t address;
+    uint16_t command;   // Write: 16-bit command; read: 0
+    size_t length;
+};
+
+class MockI2CHal : public II2CHal {
+public:
+    MockI2CHal() {
+        reset();
+    }
+
+    // ============================================
+    // TEST HELPER - RESET STATE
+    // ============================================
+    void reset() {
+        log.clear();
+        total_delay_ms = 0;
+        device_address = 0x44;
+        device_present = true;
+        periodic = false;
+        periodic_command = 0;
+        data_ready = false;
+        next_write_error = 0;
+    }
+
+    // Sensor power glitch / soft reset → idle, periodic mode lost
+    void resetSensor() {
+        periodic = false;
+        data_ready = false;
+    }
+
+    void clearLog() {
+        log.clear();
+        total_delay_ms = 0;
+    }
+
+    size_t countWrites(uint16_t command) const {
+        size_t n = 0;
+        for (const MockI2CTransaction& t : log) {
+            if (t.is_write && t.command == command) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    // ============================================
+    // II2CHal
+    // ============================================
+    uint8_t write(uint8_t address, const uint8_t* data, size_t length) override {
+        uint16_t command = length >= 2 ? static_cast<uint16_t>((data[0] << 8) | data[1]) : 0;
+        log.push_back({true, address, command, length});
+
+        if (next_write_error != 0) {
+            uint8_t error = next_write_error;
+            next_write_error = 0;
+            return error;
+        }
+        if (!device_present || address != device_address) {
+            return 2;  // Address NACK
+        }
+
+        if (command == 0x3093) {          // Break
+            periodic = false;
+            data_ready = false;
+            return 0;
+        }
+        if (command == 0xE000) {          // Fetch data
+            return periodic ? 0 : 3;      // Idle: command not acknowledged
+        }
+        if (periodic) {
+            return 3;                     // Only fetch/break accepted while periodic
+        }
+        if (command == 0x2400) {          // Single shot
+            data_ready = true;
+            return 0;
+        }
+        if ((command >> 8) >= 0x20 && (command >> 8) <= 0x27) {
+            periodic = true;
+            periodic_command = command;
+            data_ready = true;
+            return 0;
+        }
+        return 3;
+    }
+
+    size_t read(uint8_t address, uint8_t* buffer, size_t length) override {
+        log.push_back({false, address, 0, length});
+        if (!device_present || address != device_address || !data_ready) {
+            return 0;
+        }
+        // 25 °C / 50 %RH with valid Sensirion CRCs
+        static const uint8_t SAMPLE[6] = {0x66, 0x66, 0x93, 0x80, 0x00, 0xA2};
+        for (size_t i = 0; i < length && i < sizeof(SAMPLE); i++) {
+            buffer[i] = SAMPLE[i];
+        }
+        if (!periodic) {
+            data_ready = false;   // Single-shot result is consumed
+        }
+        return length < sizeof(SAMPLE) ? length : sizeof(SAMPLE);
+    }
+
+    void delayMs(uint32_t ms) override {
+        total_delay_ms += ms;
+    }
+
+    // ============================================
+    // STATE (public for assertions)
+    // ============================================
+    std::vector<MockI2CTransaction> log;
+    uint32_t total_delay_ms;
+    uint8_t device_address;
+    bool device_present;
+    bool periodic;
+    uint16_t periodic_command;
+    bool data_ready;
+    uint8_t next_write_error;
+};
+
+#endif // NATIVE_TEST
+
+#endif // TEST_MOCKS_MOCK_I2C_HAL_H
@@ -0,0 +1,416 @@
+#ifndef TEST_MOCKS_MOCK_ONEWIRE_BUS_H
+#define TEST_MOCKS_MOCK_ONEWIRE_BUS_H
+
+#ifdef NATIVE_TEST
+
+#include "../../src/drivers/hal/ionewire_hal.h"
+#include "../../src/drivers/onewire_protocol.h"
+#include "../../src/drivers/onewire_rmt_transport.h"
+#include <string.h>
+#include <vector>
+
+// ============================================
+// Mock OneWire Bus - Slot-Level Device Model
+// ============================================
+// Simulated OneWire line with DS18B20 devices. The master drives one slot at
+// a time (reset pulse or bit slot); the line is the wired-AND of the master
+// and every device output, exactly as on hardware (a read slot is a write-1
+// slot during which a device may pull the line low).
+// ROM commands: SEARCH, MATCH, SKIP, READ ROM
+// DS18B20 functions: CONVERT T, READ / WRITE / COPY SCRATCHPAD
+// CONVERT T honours the configured resolution: bits below it are undefined
+// on the device and are returned as 1 here, so callers must mask them.
+//
+// Two transports drive the same model:
+// - MockOneWireHal: one call per slot (bit-bang reference backend)
+// - MockOneWireRmtChannel: RMT symbol stream in, captured symbols out, so
+//   OneWireRmtTransport + codec run unchanged in native tests
+//
+// Used in: Native unit tests only (test_onewire_transport)
+// NOT used in: Production code
+
+class SimDs18b20 {
+public:
+    explicit SimDs18b20(const uint8_t rom_code[8], int16_t raw_temperature = 0x0550) {
+        memcpy(rom, rom_code, 8);
+        temperature_raw = raw_temperature;
+        memset(scratchpad, 0, sizeof(scratchpad));
+        scratchpad[0] = 0x50;             // Power-on 85 °C
+        scratchpad[1] = 0x05;
+        scratchpad[2] = 0x4B;             // TH
+        scratchpad[3] = 0x46;             // TL
+        scratchpad[4] = 0x7F;             // 12-bit
+        scratchpad[5] = 0xFF;
+        scratchpad[7] = 0x10;
+        updateCrc();
+        memcpy(eeprom, &scratchpad[2], sizeof(eeprom));
+        corrupt_next_read = false;
+        eeprom_writes = 0;
+        conversions = 0;
+        phase_ = INACTIVE;
+    }
+
+    uint8_t rom[8];
+    int16_t temperature_raw;
+    uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+    bool corrupt_next_read;
+    uint8_t eeprom[3];                    // TH, TL, config (after COPY SCRATCHPAD)
+    uint32_t eeprom_writes;
+    uint32_t conversions;
+
+    uint8_t resolutionBits() const {
+        return static_cast<uint8_t>(9 + ((scratchpad[4] >> 5) & 0x03));
+    }
+
+    // Power cycle: scratchpad config recalled from EEPROM
+    void powerCycle() {
+        memcpy(&scratchpad[2], eeprom, sizeof(eeprom));
+        scratchpad[0] = 0x50;
+        scratchpad[1] = 0x05;
+        updateCrc();
+        phase_ = INACTIVE;
+    }
+
+    void onReset() {
+        phase_ = ROM_CMD;
+        bit_index_ = 0;
+        rx_byte_ = 0;
+        rx_bits_ = 0;
+    }
+
+    // Level this device drives during the slot (true = released)
+    bool output() const {
+        switch (phase_) {
+            case SEARCH:
+                if (search_step_ == 0) return romBit(bit_index_);
+                if (search_step_ == 1) return !romBit(bit_index_);
+                return true;
+            case READ_ROM:
+                return romBit(bit_index_);
+            case SEND:
+                return (tx_[bit_index_ / 8] >> (bit_index_ % 8)) & 0x01;
+            default:
+                return true;
+        }
+    }
+
+    // Line level sampled at the end of the slot
+    void sample(bool line) {
+        switch (phase_) {
+            case ROM_CMD:
+                if (receiveBit(line)) {
+                    dispatchRomCommand(rx_byte_);
+                }
+                break;
+            case SEARCH:
+                if (search_step_ < 2) {
+                    search_step_++;
+                    break;
+                }
+                if (line != romBit(bit_index_)) {
+                    phase_ = INACTIVE;         // Master chose the other branch
+                    break;
+                }
+                search_step_ = 0;
+                if (++bit_index_ == 64) {
+                    enterFunction();
+                }
+                break;
+            case MATCH:
+                if (line != romBit(bit_index_)) {
+                    phase_ = INACTIVE;
+                    break;
+                }
+                if (++bit_index_ == 64) {
+                    enterFunction();
+                }
+                break;
+            case READ_ROM:
+                if (++bit_index_ == 64) {
+                    enterFunction();
+                }
+                break;
+            case FUNC_CMD:
+                if (receiveBit(line)) {
+                    dispatchFunction(rx_byte_);
+                }
+                break;
+            case WRITE_SCRATCHPAD:
+                if (receiveBit(line)) {
+                    scratchpad[2 + write_index_] = rx_byte_;
+                    if (++write_index_ == 3) {
+                        updateCrc();
+                        phase_ = INACTIVE;
+                    }
+                }
+                break;
+            case SEND:
+                if (++bit_index_ == tx_len_ * 8) {
+                    phase_ = INACTIVE;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+private:
+    enum Phase { INACTIVE, ROM_CMD, SEARCH, MATCH, READ_ROM, FUNC_CMD, WRITE_SCRATCHPAD, SEND };
+
+    Phase phase_;
+    uint8_t bit_index_ = 0;
+    uint8_t rx_byte_ = 0;
+    uint8_t rx_bits_ = 0;
+    uint8_t search_step_ = 0;
+    uint8_t write_index_ = 0;
+    uint8_t tx_[DS18B20_SCRATCHPAD_SIZE];
+    uint8_t tx_len_ = 0;
+
+    bool romBit(uint8_t index) const {
+        return (rom[index / 8] >> (index % 8)) & 0x01;
+    }
+
+    bool receiveBit(bool line) {
+        if (line) {
+            rx_byte_ |= static_cast<uint8_t>(1U << rx_bits_);
+        } else {
+            rx_byte_ &= static_cast<uint8_t>(~(1U << rx_bits_));
+        }
+        if (++rx_bits_ < 8) {
+            return false;
+        }
+        rx_bits_ = 0;
+        return true;
+    }
+
+    void enterFunction() {
+        phase_ = FUNC_CMD;
+        rx_bits_ = 0;
+    }
+
+    void dispatchRomCommand(uint8_t command) {
+        bit_index_ = 0;
+        search_step_ = 0;
+        switch (command) {
+            case ONEWIRE_CMD_SEARCH_ROM: phase_ = SEARCH; break;
+            case ONEWIRE_CMD_MATCH_ROM:  phase_ = MATCH; break;
+            case ONEWIRE_CMD_READ_ROM:   phase_ = READ_ROM; break;
+            case ONEWIRE_CMD_SKIP_ROM:   enterFunction(); break;
+            default:                     phase_ = INACTIVE; break;
+        }
+    }
+
+    void dispatchFunction(uint8_t command) {
+        switch (command) {
+            case DS18B20_CMD_CONVERT_T: {
+                uint16_t undefined = static_cast<uint16_t>((1U << (12 - resolutionBits())) - 1U);
+                uint16_t value = static_cast<uint16_t>(temperature_raw) | undefined;
+                scratchpad[0] = static_cast<uint8_t>(value & 0xFF);
+                scratchpad[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+                updateCrc();
+                conversions++;
+                phase_ = INACTIVE;
+                break;
+            }
+            case DS18B20_CMD_COPY_SCRATCHPAD:
+                memcpy(eeprom, &scratchpad[2], sizeof(eeprom));
+                eeprom_writes++;
+                phase_ = INACTIVE;
+                break;
+            case DS18B20_CMD_READ_SCRATCHPAD:
+                memcpy(tx_, scratchpad, sizeof(tx_));
+                if (corrupt_next_read) {
+                    tx_[0] ^= 0x01;
+                    corrupt_next_read = false;
+                }
+                tx_len_ = DS18B20_SCRATCHPAD_SIZE;
+                bit_index_ = 0;
+                phase_ = SEND;
+                break;
+            case DS18B20_CMD_WRITE_SCRATCHPAD:
+                write_index_ = 0;
+                rx_bits_ = 0;
+                phase_ = WRITE_SCRATCHPAD;
+                break;
+            default:
+                phase_ = INACTIVE;
+                break;
+        }
+    }
+
+    void updateCrc() {
+        scratchpad[8] = OneWireProtocol::crc8(scratchpad, 8);
+    }
+};
+
+class SimOneWireBus {
+public:
+    std::vector<SimDs18b20> devices;
+    bool strong_pullup = false;
+    bool shorted = false;             // Line stuck low (wiring fault)
+    uint32_t resets = 0;
+    uint32_t slots = 0;
+
+    void clear() {
+        devices.clear();
+        strong_pullup = false;
+        shorted = false;
+        resets = 0;
+        slots = 0;
+    }
+
+    // Returns presence (any device pulled the line low after the reset pulse)
+    bool resetPulse() {
+        resets++;
+        for (SimDs18b20& device : devices) {
+            device.onReset();
+        }
+        return !shorted && !devices.empty();
+    }
+
+    // One bit slot: master_bit false = write 0, true = write 1 / read slot.
+    // Returns the line level sampled by master and devices.
+    bool slot(bool master_bit) {
+        slots++;
+        bool line = master_bit && !shorted;
+        for (const SimDs18b20& device : devices) {
+            line = line && device.output();
+        }
+        for (SimDs18b20& device : devices) {
+            device.sample(line);
+        }
+        return line;
+    }
+};
+
+// ============================================
+// Mock OneWire HAL - bit-bang reference backend
+// ============================================
+class MockOneWireHal : public IOneWireHal {
+public:
+    explicit MockOneWireHal(SimOneWireBus& bus) : bus_(bus) {}
+
+    uint32_t total_delay_ms = 0;
+
+    bool reset() override {
+        bus_.strong_pullup = false;
+        return bus_.resetPulse();
+    }
+
+    void writeBits(const uint8_t* data, uint16_t bit_count, bool power_after = false) override {
+        for (uint16_t i = 0; i < bit_count; i++) {
+            bus_.slot((data[i / 8] >> (i % 8)) & 0x01);
+        }
+        if (power_after) {
+            bus_.strong_pullup = true;
+        }
+    }
+
+    void readBits(uint8_t* data, uint16_t bit_count) override {
+        for (uint16_t i = 0; i < bit_count; i++) {
+            uint8_t mask = static_cast<uint8_t>(1U << (i % 8));
+            if (bus_.slot(true)) {
+                data[i / 8] |= mask;
+            } else {
+                data[i / 8] &= static_cast<uint8_t>(~mask);
+            }
+        }
+    }
+
+    void depower() override { bus_.strong_pullup = false; }
+    void delayMs(uint32_t ms) override { total_delay_ms += ms; }
+    const char* getBackendName() const override { return "mock"; }
+
+private:
+    SimOneWireBus& bus_;
+};
+
+// ============================================
+// Mock RMT Channel - symbol stream against the device model
+// ============================================
+class MockOneWireRmtChannel : public IOneWireRmtChannel {
+public:
+    explicit MockOneWireRmtChannel(SimOneWireBus& bus) : bus_(bus) { reset(); }
+
+    uint32_t transfers = 0;
+    size_t max_symbols_per_transfer = 0;
+    uint32_t invalid_symbols = 0;     // Durations outside the slot timing table
+    uint32_t total_delay_ms = 0;
+    bool fail_next_transfer = false;
+    bool truncate_next_capture = false;
+
+    void reset() {
+        transfers = 0;
+        max_symbols_per_transfer = 0;
+        invalid_symbols = 0;
+        total_delay_ms = 0;
+        fail_next_transfer = false;
+        truncate_next_capture = false;
+    }
+
+    bool transfer(const OneWireRmtSymbol* tx, size_t tx_count,
+                  OneWireRmtSymbol* rx, size_t rx_capacity, size_t* rx_count) override {
+        transfers++;
+        if (tx_count > max_symbols_per_transfer) {
+            max_symbols_per_transfer = tx_count;
+        }
+        if (fail_next_transfer) {
+            fail_next_transfer = false;
+            return false;
+        }
+
+        size_t captured = 0;
+        for (size_t i = 0; i < tx_count; i++) {
+            const OneWireRmtSymbol& symbol = tx[i];
+            if (symbol.low_us + symbol.high_us < 70) {
+                invalid_symbols++;
+            }
+            if (symbol.low_us >= ONEWIRE_RMT_RESET_LOW_US) {
+                bool presence = bus_.resetPulse();
+                if (bus_.shorted) {
+                    capture(rx, rx_capacity, &captured, 5000, 0);
+                } else {
+                    capture(rx, rx_capacity, &captured, symbol.low_us, 30);
+                    if (presence) {
+                        capture(rx, rx_capacity, &captured, 120, ONEWIRE_RMT_RX_IDLE_US);
+                    }
+                }
+                continue;
+            }
+            bool master_bit = symbol.low_us < ONEWIRE_RMT_READ_SAMPLE_US;
+            bool line = bus_.slot(master_bit);
+            // A device sending 0 holds the line low ~30 µs past the master pulse
+            uint16_t low = line ? symbol.low_us : (symbol.low_us > 30 ? symbol.low_us : 30);
+            capture(rx, rx_capacity, &captured, low, static_cast<uint16_t>(70 - low));
+        }
+
+        if (rx_count != nullptr) {
+            if (truncate_next_capture && captured > 0) {
+                captured /= 2;
+                truncate_next_capture = false;
+            }
+            *rx_count = captured;
+        }
+        return true;
+    }
+
+    void setStrongPullup(bool enabled) override { bus_.strong_pullup = enabled; }
+    void delayMs(uint32_t ms) override { total_delay_ms += ms; }
+
+private:
+    SimOneWireBus& bus_;
+
+    static void capture(OneWireRmtSymbol* rx, size_t capacity, size_t* count,
+                        uint16_t low_us, uint16_t high_us) {
+        if (rx == nullptr || *count >= capacity) {
+            return;
+        }
+        rx[*count].low_us = low_us;
+        rx[*count].high_us = high_us;
+        (*count)++;
+    }
+};
+
+#endif // NATIVE_TEST
+
+#endif // TEST_MOCKS_MOCK_ONEWIRE_BUS_H
@@ -0,0 +1,165 @@
+#ifndef TEST_MOCKS_MOCK_OTA_PARTITION_HAL_H
+#define TEST_MOCKS_MOCK_OTA_PARTITION_HAL_H
+
+#ifdef NATIVE_TEST
+
+#include "../../src/drivers/hal/iota_partition_hal.h"
+#include <cstdio>
+#include <vector>
+
+// ============================================
+// Mock OTA Partition HAL - Test Implementation
+// ============================================
+// File-backed target slot (tmpfile, survives "reboots" of the updater) and an
+// in-memory running slot:
+// - NOR flash semantics: erase sets 0xFF per 4 KB sector, write ANDs bits.
+//   Writing over non-erased bytes is counted in write_violations.
+// - Failure injection: fail writes after N calls (power loss mid-transfer)
+// - Boot control: activation / pending-verify / rollback are recorded
+//
+// Used in: Native unit tests only (test_ota_updater)
+// NOT used in: Production code
+class MockOtaPartitionHal : public IOtaPartitionHal {
+public:
+    static const size_t SECTOR = 4096;
+
+    explicit MockOtaPartitionHal(size_t slot_size = 64 * 1024)
+        : slot_size_(slot_size), file_(std::tmpfile()) {
+        reset();
+    }
+
+    ~MockOtaPartitionHal() override {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+
+    // ============================================
+    // TEST HELPER - RESET STATE
+    // ============================================
+    void reset() {
+        std::vector<uint8_t> junk(slot_size_, 0xA5);    // Old firmware in the inactive slot
+        std::fseek(file_, 0, SEEK_SET);
+        std::fwrite(junk.data(), 1, junk.size(), file_);
+        std::fflush(file_);
+        running.assign(slot_size_, 0xFF);
+        erase_count = 0;
+        write_count = 0;
+        write_violations = 0;
+        fail_writes_after = -1;
+        activated = false;
+        activate_result = true;
+        pending_verify = false;
+        marked_valid = false;
+        rolled_back = false;
+    }
+
+    // Running image (delta base); rest of the slot stays erased
+    void setRunningImage(const std::vector<uint8_t>& image) {
+        running.assign(slot_size_, 0xFF);
+        std::copy(image.begin(), image.end(), running.begin());
+    }
+
+    std::vector<uint8_t> targetContents(size_t length) {
+        std::vector<uint8_t> data(length);
+        readTarget(0, data.data(), length);
+        return data;
+    }
+
+    // ============================================
+    // IOtaPartitionHal
+    // ============================================
+    size_t targetSize() const override { return slot_size_; }
+
+    bool eraseTarget(size_t offset, size_t length) override {
+        if (offset % SECTOR != 0 || length % SECTOR != 0 || offset + length > slot_size_) {
+            return false;
+        }
+        std::vector<uint8_t> erased(length, 0xFF);
+        std::fseek(file_, static_cast<long>(offset), SEEK_SET);
+        std::fwrite(erased.data(), 1, length, file_);
+        std::fflush(file_);
+        erase_count++;
+        return true;
+    }
+
+    bool writeTarget(size_t offset, const uint8_t* data, size_t length) override {
+        if (offset + length > slot_size_) {
+            return false;
+        }
+        if (fail_writes_after == 0) {
+            return false;
+        }
+        if (fail_writes_after > 0) {
+            fail_writes_after--;
+        }
+        std::vector<uint8_t> current(length);
+        readTarget(offset, current.data(), length);
+        for (size_t i = 0; i < length; i++) {
+            if ((current[i] & data[i]) != data[i]) {
+                write_violations++;
+            }
+            current[i] &= data[i];
+        }
+        std::fseek(file_, static_cast<long>(offset), SEEK_SET);
+        std::fwrite(current.data(), 1, length, file_);
+        std::fflush(file_);
+        write_count++;
+        return true;
+    }
+
+    bool readTarget(size_t offset, uint8_t* buffer, size_t length) override {
+        if (offset + length > slot_size_) {
+            return false;
+        }
+        std::fseek(file_, static_cast<long>(offset), SEEK_SET);
+        return std::fread(buffer, 1, length, file_) == length;
+    }
+
+    size_t runningSize() const override { return slot_size_; }
+
+    bool readRunning(size_t offset, uint8_t* buffer, size_t length) override {
+        if (offset + length > slot_size_) {
+            return false;
+        }
+        std::copy(running.begin() + offset, running.begin() + offset + length, buffer);
+        return true;
+    }
+
+    bool activateTarget() override {
+        activated = activate_result;
+        return activate_result;
+    }
+
+    bool isRunningPendingVerify() override { return pending_verify; }
+
+    bool markRunningValid() override {
+        marked_valid = true;
+        pending_verify = false;
+        return true;
+    }
+
+    void rollbackAndReboot() override { rolled_back = true; }
+
+    // ============================================
+    // STATE
+    // ============================================
+    std::vector<uint8_t> running;
+    int erase_count;
+    int write_count;
+    int write_violations;
+    int fail_writes_after;          // -1 = never; N = N more writes succeed
+    bool activated;
+    bool activate_result;
+    bool pending_verify;
+    bool marked_valid;
+    bool rolled_back;
+
+private:
+    size_t slot_size_;
+    std::FILE* file_;
+};
+
+#endif // NATIVE_TEST
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef TEST_MOCKS_MOCK_PULSE_COUNTER_HAL_H
+#define TEST_MOCKS_MOCK_PULSE_COUNTER_HAL_H
+
+#ifdef NATIVE_TEST
+
+#include "../../src/drivers/hal/ipulse_counter_hal.h"
+
+// ============================================
+// Mock Pulse Counter HAL - Test Implementation
+// ============================================
+// Simulated PCNT units:
+// - pulse(gpio, n): counter runs up, resets at PULSE_COUNTER_HW_LIMIT and
+//   counts the wrap like the H_LIM interrupt
+// - defer_wrap_irq: wraps stay pending (counter already reset, wrap count
+//   not incremented) until deliverPendingWraps() — the ISR latency race
+// - Attach parameters are recorded (gpio, filter)
+//
+// Used in: Native unit tests only (test_pulse_counter)
+// NOT used in: Production code
+class MockPulseCounterHal : public IPulseCounterHal {
+public:
+    static const uint8_t UNITS = 8;
+
+    MockPulseCounterHal() { reset(); }
+
+    // ============================================
+    // TEST HELPER - RESET STATE
+    // ============================================
+    void reset() {
+        units = UNITS;
+        attach_result = true;
+        defer_wrap_irq = false;
+        for (uint8_t i = 0; i < UNITS; i++) {
+            state[i] = UnitState();
+        }
+    }
+
+    void pulse(uint8_t gpio, uint32_t pulses) {
+        for (uint8_t i = 0; i < UNITS; i++) {
+            if (!state[i].attached || state[i].gpio != gpio) {
+                continue;
+            }
+            for (uint32_t p = 0; p < pulses; p++) {
+                state[i].count++;
+                if (state[i].count >= PULSE_COUNTER_HW_LIMIT) {
+                    state[i].count = 0;
+                    if (defer_wrap_irq) {
+                        state[i].pending_wraps++;
+                    } else {
+                        state[i].wraps++;
+                    }
+                }
+            }
+        }
+    }
+
+    void deliverPendingWraps() {
+        for (uint8_t i = 0; i < UNITS; i++) {
+            state[i].wraps += state[i].pending_wraps;
+            state[i].pending_wraps = 0;
+        }
+    }
+
+    // ============================================
+    // IPulseCounterHal
+    // ============================================
+    uint8_t unitCount() const override { return units; }
+
+    bool attach(uint8_t unit, uint8_t gpio, uint16_t filter_ns) override {
+        if (!attach_result || unit >= UNITS) {
+            return false;
+        }
+        state[unit] = UnitState();
+        state[unit].attached = true;
+        state[unit].gpio = gpio;
+        state[unit].filter_ns = filter_ns;
+        return true;
+    }
+
+    void detach(uint8_t unit) override {
+        if (unit < UNITS) {
+            state[unit].attached = false;
+        }
+    }
+
+    bool read(uint8_t unit, uint32_t& wraps, uint16_t& count) override {
+        if (unit >= UNITS || !state[unit].attached) {
+            return false;
+        }
+        wraps = state[unit].wraps;
+        count = static_cast<uint16_t>(state[unit].count);
+        return true;
+    }
+
+    // ============================================
+    // STATE
+    // ============================================
+    struct UnitState {
+        bool attached = false;
+        uint8_t gpio = 255;
+        uint16_t filter_ns = 0;
+        uint32_t count = 0;
+        uint32_t wraps = 0;
+        uint32_t pending_wraps = 0;
+    };
+
+    UnitState state[UNITS];
+    uint8_t units;
+    bool attach_result;
+    bool defer_wrap_irq;
+};
+
+#endif // NATIVE_TEST
+
+#endif
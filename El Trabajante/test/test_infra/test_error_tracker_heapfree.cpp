@@ -0,0 +1,274 @@
+#include <unity.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "error_handling/error_tracker.h"
+#include "models/error_codes.h"
+#include "utils/logger.h"
+#include "utils/topic_builder.h"
+
+// ============================================
+// FAILING ALLOCATOR HOOK (native OOM simulation)
+// ============================================
+// While g_fail_alloc is set every global new throws std::bad_alloc — a
+// failure path that still allocates aborts the test. Allocations are counted
+// between allocHookStart()/allocHookStop().
+static bool g_fail_alloc = false;
+static bool g_count_allocs = false;
+static size_t g_allocs = 0;
+
+void* operator new(size_t size) {
+    if (g_count_allocs) {
+        g_allocs++;
+    }
+    if (g_fail_alloc) {
+        throw std::bad_alloc();
+    }
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+    (void)size;
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+static void allocHookStart() {
+    g_allocs = 0;
+    g_count_allocs = true;
+    g_fail_alloc = true;
+}
+
+static size_t allocHookStop() {
+    g_fail_alloc = false;
+    g_count_allocs = false;
+    return g_allocs;
+}
+
+// ============================================
+// CAPTURING MQTT CALLBACK (fixed buffers, no heap)
+// ============================================
+static char g_last_topic[128];
+static char g_last_payload[512];
+static int g_publish_count = 0;
+
+static void capturePublish(const char* topic, const char* payload) {
+    strncpy(g_last_topic, topic, sizeof(g_last_topic) - 1);
+    g_last_topic[sizeof(g_last_topic) - 1] = '\0';
+    strncpy(g_last_payload, payload, sizeof(g_last_payload) - 1);
+    g_last_payload[sizeof(g_last_payload) - 1] = '\0';
+    g_publish_count++;
+}
+
+static const char* SENSOR_TOPIC = "kaiser/god/esp/ESP_12AB34CD/sensor/4/data";
+
+void setUp(void) {
+    logger.setSerialEnabled(false);
+    logger.setLogLevel(LOG_INFO);
+    logger.clearTagLogLevels();
+    logger.clearLogs();
+    TopicBuilder::setEspId("ESP_12AB34CD");
+    TopicBuilder::setKaiserId("god");
+    errorTracker.begin();
+    errorTracker.clearMqttPublishCallback();
+    g_last_topic[0] = '\0';
+    g_last_payload[0] = '\0';
+    g_publish_count = 0;
+}
+
+void tearDown(void) {
+    g_fail_alloc = false;
+    g_count_allocs = false;
+    errorTracker.clearMqttPublishCallback();
+}
+
+// ============================================
+// TEST CASES
+// ============================================
+
+void test_error_tracker_report_is_allocation_free_under_oom() {
+    allocHookStart();
+    for (int i = 0; i < 50; i++) {
+        errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                              ErrorArgs("Publish failed").topic(SENSOR_TOPIC).err(11));
+        errorTracker.trackError(ERROR_GPIO_CONFLICT, ERROR_SEVERITY_CRITICAL, "GPIO 4 reserved");
+    }
+    size_t allocs = allocHookStop();
+
+    TEST_ASSERT_EQUAL(0, allocs);
+    TEST_ASSERT_EQUAL(2, errorTracker.getErrorCount());
+    const ErrorEntry* latest = errorTracker.getLatestEntry();
+    TEST_ASSERT_NOT_NULL(latest);
+    TEST_ASSERT_EQUAL(ERROR_GPIO_CONFLICT, latest->error_code);
+    TEST_ASSERT_EQUAL(50, latest->occurrence_count);
+    TEST_ASSERT_TRUE(errorTracker.hasCriticalErrors());
+    // Logger received every line (formatted on the stack, ring buffer full)
+    TEST_ASSERT_EQUAL(50, logger.getLogCount());
+}
+
+void test_error_tracker_typed_args_dedup_by_value() {
+    errorTracker.reportHardwareError(ERROR_GPIO_CONFLICT, ErrorArgs("GPIO busy").pin(4));
+    errorTracker.reportHardwareError(ERROR_GPIO_CONFLICT, ErrorArgs("GPIO busy").pin(4));
+    errorTracker.reportHardwareError(ERROR_GPIO_CONFLICT, ErrorArgs("GPIO busy").pin(5));
+
+    TEST_ASSERT_EQUAL(2, errorTracker.getErrorCount());
+    const ErrorEntry* latest = errorTracker.getLatestEntry();
+    TEST_ASSERT_EQUAL(5, latest->args.gpio);
+    TEST_ASSERT_EQUAL(1, latest->occurrence_count);
+}
+
+void test_error_tracker_band_offset_still_normalized() {
+    errorTracker.reportCommunicationError(12, ErrorArgs("Publish failed"));
+    TEST_ASSERT_EQUAL(ERROR_MQTT_PUBLISH_FAILED, errorTracker.getLatestEntry()->error_code);
+}
+
+void test_error_tracker_format_entry_message_lazy() {
+    errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                          ErrorArgs("Publish failed").topic(SENSOR_TOPIC).err(11).val(3));
+    const ErrorEntry* entry = errorTracker.getLatestEntry();
+    TEST_ASSERT_TRUE(entry->typed);
+    TEST_ASSERT_EQUAL_STRING("", entry->message);  // Nothing formatted at the failure site
+
+    char text[128];
+    ErrorTracker::formatEntryMessage(*entry, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("Publish failed topic=sensor_data errno=11 value=3", text);
+
+    char tiny[10];
+    size_t len = ErrorTracker::formatEntryMessage(*entry, tiny, sizeof(tiny));
+    TEST_ASSERT_EQUAL(9, len);
+    TEST_ASSERT_EQUAL_STRING("Publish f", tiny);
+}
+
+void test_error_tracker_classify_topic() {
+    TEST_ASSERT_EQUAL(ErrorTopicClass::SENSOR_DATA, ErrorTracker::classifyTopic(SENSOR_TOPIC));
+    TEST_ASSERT_EQUAL(ErrorTopicClass::ACTUATOR,
+                      ErrorTracker::classifyTopic("kaiser/god/esp/E/actuator/5/status"));
+    TEST_ASSERT_EQUAL(ErrorTopicClass::HEARTBEAT,
+                      ErrorTracker::classifyTopic("kaiser/god/esp/E/system/heartbeat"));
+    TEST_ASSERT_EQUAL(ErrorTopicClass::INTENT_OUTCOME,
+                      ErrorTracker::classifyTopic("kaiser/god/esp/E/system/intent_outcome"));
+    TEST_ASSERT_EQUAL(ErrorTopicClass::SYSTEM,
+                      ErrorTracker::classifyTopic("kaiser/god/esp/E/system/error"));
+    TEST_ASSERT_EQUAL(ErrorTopicClass::OTHER, ErrorTracker::classifyTopic("foo/bar"));
+    TEST_ASSERT_EQUAL(ErrorTopicClass::NONE, ErrorTracker::classifyTopic(nullptr));
+}
+
+void test_error_tracker_publish_deferred_and_allocation_free() {
+    errorTracker.setMqttPublishCallback(capturePublish, "ESP_12AB34CD");
+
+    allocHookStart();
+    errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                          ErrorArgs("Publish \"failed\"").topic(SENSOR_TOPIC).err(11));
+    errorTracker.reportHardwareError(ERROR_GPIO_CONFLICT, ErrorArgs("GPIO busy").pin(4));
+    int published_at_failure_site = g_publish_count;
+    errorTracker.processPendingPublishes();
+    size_t allocs = allocHookStop();
+
+    TEST_ASSERT_EQUAL(0, allocs);
+    TEST_ASSERT_EQUAL(0, published_at_failure_site);
+    TEST_ASSERT_EQUAL(2, g_publish_count);
+    TEST_ASSERT_EQUAL_STRING("kaiser/god/esp/ESP_12AB34CD/system/error", g_last_topic);
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload, "\"error_code\":1002"));
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload, "\"category\":\"HARDWARE\""));
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload, "\"gpio\":4"));
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload, "\"esp_id\":\"ESP_12AB34CD\""));
+
+    // Drained: nothing left to publish
+    errorTracker.processPendingPublishes();
+    TEST_ASSERT_EQUAL(2, g_publish_count);
+}
+
+void test_error_tracker_publish_payload_typed_context() {
+    errorTracker.setMqttPublishCallback(capturePublish, "ESP_12AB34CD");
+    errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                          ErrorArgs("Publish \"failed\"").topic(SENSOR_TOPIC).err(11));
+    errorTracker.processPendingPublishes();
+
+    TEST_ASSERT_EQUAL(1, g_publish_count);
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload,
+                                "\"message\":\"Publish \\\"failed\\\" topic=sensor_data errno=11\""));
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload, "\"topic_class\":\"sensor_data\""));
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload, "\"errno\":11"));
+    TEST_ASSERT_NULL(strstr(g_last_payload, "\"gpio\""));
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload, "\"ts\":0}"));
+}
+
+void test_error_tracker_legacy_track_error_publishes_immediately() {
+    errorTracker.setMqttPublishCallback(capturePublish, "ESP_12AB34CD");
+    errorTracker.trackError(ERROR_GPIO_CONFLICT, ERROR_SEVERITY_CRITICAL, "GPIO 4 reserved");
+
+    TEST_ASSERT_EQUAL(1, g_publish_count);
+    TEST_ASSERT_NOT_NULL(strstr(g_last_payload, "\"message\":\"GPIO 4 reserved\""));
+    TEST_ASSERT_FALSE(errorTracker.getLatestEntry()->publish_pending);
+
+    // Nothing queued for the deferred path
+    errorTracker.processPendingPublishes();
+    TEST_ASSERT_EQUAL(1, g_publish_count);
+}
+
+void test_error_tracker_publish_throttled_per_code() {
+    errorTracker.setMqttPublishCallback(capturePublish, "ESP_12AB34CD");
+    for (int i = 0; i < 5; i++) {
+        errorTracker.reportCommunicationError(ERROR_MQTT_PUBLISH_FAILED,
+                                              ErrorArgs("Publish failed").topic(SENSOR_TOPIC).val(i + 1));
+    }
+    errorTracker.processPendingPublishes(8);
+
+    // First occurrence publishes (also within the first minute of uptime), the rest is throttled
+    TEST_ASSERT_EQUAL(1, g_publish_count);
+    TEST_ASSERT_EQUAL(5, errorTracker.getErrorCount());
+}
+
+// ============================================
+// MAIN
+// ============================================
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_error_tracker_report_is_allocation_free_under_oom);
+    RUN_TEST(test_error_tracker_typed_args_dedup_by_value);
+    RUN_TEST(test_error_tracker_band_offset_still_normalized);
+    RUN_TEST(test_error_tracker_format_entry_message_lazy);
+    RUN_TEST(test_error_tracker_classify_topic);
+    RUN_TEST(test_error_tracker_publish_deferred_and_allocation_free);
+    RUN_TEST(test_error_tracker_publish_payload_typed_context);
+    RUN_TEST(test_error_tracker_legacy_track_error_publishes_immediately);
+    RUN_TEST(test_error_tracker_publish_throttled_per_code);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
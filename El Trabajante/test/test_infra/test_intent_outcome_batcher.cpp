@@ -0,0 +1,331 @@
+#include <unity.h>
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "tasks/intent_outcome_batcher.h"
+
+// ============================================
+// IntentOutcomeBatcher: lane windows, state collapsing, outbox blob codec and
+// a replayed command trace comparing publishes / NVS writes per command with
+// the previous one-message-per-outcome path.
+// ============================================
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static bool isCriticalForTest(const char* flow, const char* outcome) {
+    if (IntentOutcomeBatcher::getOutcomeRank(outcome) == 3) {
+        return true;
+    }
+    return strcmp(flow, "publish") == 0 ||
+           (strcmp(flow, "command") == 0 && strcmp(outcome, "applied") == 0);
+}
+
+static IntentOutcomeRecord makeRecord(const char* flow, const char* intent_id, const char* outcome) {
+    IntentOutcomeRecord record;
+    memset(&record, 0, sizeof(record));
+    strncpy(record.flow, flow, sizeof(record.flow) - 1);
+    strncpy(record.metadata.intent_id, intent_id, sizeof(record.metadata.intent_id) - 1);
+    snprintf(record.metadata.correlation_id, sizeof(record.metadata.correlation_id), "corr-%s", intent_id);
+    record.metadata.generation = 3;
+    record.metadata.created_at_ms = 1000;
+    record.metadata.ttl_ms = 5000;
+    record.metadata.epoch_at_accept = 7;
+    strncpy(record.outcome, outcome, sizeof(record.outcome) - 1);
+    strncpy(record.code, "NONE", sizeof(record.code) - 1);
+    strncpy(record.reason, "ok", sizeof(record.reason) - 1);
+    record.retryable = false;
+    record.critical = isCriticalForTest(flow, outcome);
+    return record;
+}
+
+void test_batcher_collapses_accepted_into_applied() {
+    IntentOutcomeBatcher batcher(250);
+    TEST_ASSERT_EQUAL(IntentOutcomeAdmit::QUEUED,
+                      batcher.add(makeRecord("command", "i1", "accepted"), 0));
+    TEST_ASSERT_EQUAL_UINT8(1, batcher.getPendingCount(IntentOutcomeLane::STATUS));
+
+    // applied is critical → moves to the critical lane, accepted disappears
+    TEST_ASSERT_EQUAL(IntentOutcomeAdmit::COLLAPSED,
+                      batcher.add(makeRecord("command", "i1", "applied"), 10));
+    TEST_ASSERT_EQUAL_UINT8(0, batcher.getPendingCount(IntentOutcomeLane::STATUS));
+    TEST_ASSERT_EQUAL_UINT8(1, batcher.getPendingCount(IntentOutcomeLane::CRITICAL));
+
+    // Same intent, other flow → independent item
+    TEST_ASSERT_EQUAL(IntentOutcomeAdmit::QUEUED,
+                      batcher.add(makeRecord("config", "i1", "accepted"), 20));
+
+    IntentOutcomeBatch batch;
+    TEST_ASSERT_EQUAL_UINT8(1, batcher.takeBatch(IntentOutcomeLane::CRITICAL, &batch));
+    TEST_ASSERT_EQUAL_STRING("applied", batch.items[0].outcome);
+    TEST_ASSERT_EQUAL_STRING("corr-i1", batch.items[0].metadata.correlation_id);
+    TEST_ASSERT_EQUAL_UINT8(1, batch.items[0].collapsed);
+    TEST_ASSERT_EQUAL_UINT8(1, batch.attempt);
+    TEST_ASSERT_NOT_EQUAL(0, batch.batch_id);
+    TEST_ASSERT_EQUAL_UINT32(1, batcher.getStats().collapsed);
+}
+
+void test_batcher_drops_stale_intermediate_state() {
+    IntentOutcomeBatcher batcher(250);
+    batcher.add(makeRecord("config", "c1", "persisted"), 0);
+    TEST_ASSERT_EQUAL(IntentOutcomeAdmit::STALE,
+                      batcher.add(makeRecord("config", "c1", "accepted"), 5));
+    TEST_ASSERT_EQUAL_UINT8(0, batcher.getPendingCount(IntentOutcomeLane::STATUS));
+    TEST_ASSERT_EQUAL_UINT32(1, batcher.getStats().stale);
+
+    // Terminal replaces terminal in place (regression guard lives upstream)
+    TEST_ASSERT_EQUAL(IntentOutcomeAdmit::COLLAPSED,
+                      batcher.add(makeRecord("config", "c1", "failed"), 6));
+    IntentOutcomeBatch batch;
+    TEST_ASSERT_EQUAL_UINT8(1, batcher.takeBatch(IntentOutcomeLane::CRITICAL, &batch));
+    TEST_ASSERT_EQUAL_STRING("failed", batch.items[0].outcome);
+}
+
+void test_batcher_window_and_full_lane() {
+    IntentOutcomeBatcher batcher(250);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, batcher.msUntilDue(0));
+
+    batcher.add(makeRecord("command", "a0", "applied"), 100);
+    TEST_ASSERT_FALSE(batcher.isDue(IntentOutcomeLane::CRITICAL, 349));
+    TEST_ASSERT_EQUAL_UINT32(150, batcher.msUntilDue(200));
+    TEST_ASSERT_TRUE(batcher.isDue(IntentOutcomeLane::CRITICAL, 350));
+    TEST_ASSERT_FALSE(batcher.isDue(IntentOutcomeLane::STATUS, 350));
+
+    char id[16];
+    for (uint8_t i = 1; i < INTENT_OUTCOME_BATCH_MAX; i++) {
+        snprintf(id, sizeof(id), "a%u", i);
+        TEST_ASSERT_EQUAL(IntentOutcomeAdmit::QUEUED, batcher.add(makeRecord("command", id, "applied"), 110));
+    }
+    // Full lane is due immediately and refuses further items
+    TEST_ASSERT_TRUE(batcher.isDue(IntentOutcomeLane::CRITICAL, 110));
+    TEST_ASSERT_EQUAL_UINT32(0, batcher.msUntilDue(110));
+    TEST_ASSERT_EQUAL(IntentOutcomeAdmit::LANE_FULL,
+                      batcher.add(makeRecord("command", "overflow", "applied"), 110));
+
+    // Collapsing into a full lane is refused as well; the pending state stays intact
+    batcher.add(makeRecord("command", "s1", "accepted"), 110);
+    TEST_ASSERT_EQUAL(IntentOutcomeAdmit::LANE_FULL,
+                      batcher.add(makeRecord("command", "s1", "applied"), 110));
+    TEST_ASSERT_EQUAL_UINT8(1, batcher.getPendingCount(IntentOutcomeLane::STATUS));
+
+    IntentOutcomeBatch batch;
+    TEST_ASSERT_EQUAL_UINT8(INTENT_OUTCOME_BATCH_MAX, batcher.takeBatch(IntentOutcomeLane::CRITICAL, &batch));
+    TEST_ASSERT_EQUAL_STRING("a0", batch.items[0].metadata.intent_id);
+    TEST_ASSERT_EQUAL(IntentOutcomeAdmit::COLLAPSED,
+                      batcher.add(makeRecord("command", "s1", "applied"), 120));
+    TEST_ASSERT_EQUAL_UINT8(0, batcher.takeBatch(IntentOutcomeLane::STATUS, &batch));
+}
+
+void test_batch_blob_roundtrip_is_compact() {
+    IntentOutcomeBatch batch;
+    memset(&batch, 0, sizeof(batch));
+    batch.lane = IntentOutcomeLane::CRITICAL;
+    batch.count = 3;
+    batch.attempt = 2;
+    batch.batch_id = 0xA1B2C3D4;
+    batch.items[0] = makeRecord("command", "cmd-1", "applied");
+    batch.items[1] = makeRecord("config", "cfg-1", "failed");
+    batch.items[1].retryable = true;
+    batch.items[1].collapsed = 2;
+    batch.items[2] = makeRecord("command", "cmd-2", "accepted");
+
+    static uint8_t blob[INTENT_OUTCOME_BLOB_MAX_SIZE];
+    size_t len = encodeIntentOutcomeBatch(batch, blob, sizeof(blob));
+    TEST_ASSERT_GREATER_THAN(0, len);
+    // Fixed-size records would need 3 × sizeof(IntentOutcomeRecord)
+    TEST_ASSERT_LESS_THAN(sizeof(IntentOutcomeRecord), len);
+
+    IntentOutcomeBatch decoded;
+    TEST_ASSERT_TRUE(decodeIntentOutcomeBatch(blob, len, &decoded));
+    TEST_ASSERT_EQUAL_UINT8(3, decoded.count);
+    TEST_ASSERT_EQUAL_UINT8(2, decoded.attempt);
+    TEST_ASSERT_EQUAL_HEX32(0xA1B2C3D4, decoded.batch_id);
+    TEST_ASSERT_EQUAL(IntentOutcomeLane::CRITICAL, decoded.lane);
+    TEST_ASSERT_EQUAL_STRING("cfg-1", decoded.items[1].metadata.intent_id);
+    TEST_ASSERT_EQUAL_STRING("corr-cfg-1", decoded.items[1].metadata.correlation_id);
+    TEST_ASSERT_EQUAL_UINT32(3, decoded.items[1].metadata.generation);
+    TEST_ASSERT_EQUAL_UINT32(7, decoded.items[1].metadata.epoch_at_accept);
+    TEST_ASSERT_EQUAL_STRING("failed", decoded.items[1].outcome);
+    TEST_ASSERT_TRUE(decoded.items[1].retryable);
+    TEST_ASSERT_TRUE(decoded.items[1].critical);
+    TEST_ASSERT_EQUAL_UINT8(2, decoded.items[1].collapsed);
+    TEST_ASSERT_FALSE(decoded.items[2].critical);
+
+    // Truncated, trailing garbage, unknown version, too small buffer
+    TEST_ASSERT_FALSE(decodeIntentOutcomeBatch(blob, len - 1, &decoded));
+    TEST_ASSERT_FALSE(decodeIntentOutcomeBatch(blob, len + 1, &decoded));
+    blob[0] = INTENT_OUTCOME_BLOB_VERSION + 1;
+    TEST_ASSERT_FALSE(decodeIntentOutcomeBatch(blob, len, &decoded));
+    TEST_ASSERT_EQUAL_UINT32(0, encodeIntentOutcomeBatch(batch, blob, 64));
+}
+
+// ============================================
+// COMMAND TRACE REPLAY
+// ============================================
+// Sustained load: 400 actuator commands at 25/s (accepted → applied 15 ms
+// later) plus a config push every 40 commands (accepted → persisted).
+// The broker is unreachable for 2 s in the middle of the trace.
+// Legacy path: one publish per outcome, 4 stats keys per delivered outcome,
+// 12 slot keys + head/count + 4 stats keys per undeliverable critical outcome.
+// Batched path: one publish per due lane (Comm-Task tick every 50 ms),
+// 4 stats keys per delivered batch, 1 blob + 3 index keys + 4 stats keys per
+// undeliverable critical batch.
+struct TraceEvent {
+    uint32_t at_ms;
+    char flow[16];
+    char intent_id[16];
+    char outcome[16];
+};
+
+struct TraceCounters {
+    uint32_t publishes;
+    uint32_t nvs_writes;
+};
+
+static bool brokerUp(uint32_t now_ms) {
+    return now_ms < 6000 || now_ms >= 8000;
+}
+
+void test_trace_replay_reduces_publishes_and_flash_writes() {
+    static TraceEvent trace[1000];
+    size_t events = 0;
+    const uint32_t commands = 400;
+    for (uint32_t i = 0; i < commands; i++) {
+        uint32_t t = i * 40;
+        TraceEvent accepted = {t, "command", "", "accepted"};
+        snprintf(accepted.intent_id, sizeof(accepted.intent_id), "cmd-%u", static_cast<unsigned>(i));
+        TraceEvent applied = accepted;
+        applied.at_ms = t + 15;
+        strncpy(applied.outcome, "applied", sizeof(applied.outcome));
+        trace[events++] = accepted;
+        trace[events++] = applied;
+        if (i % 40 == 0) {
+            TraceEvent cfg = {t + 5, "config", "", "accepted"};
+            snprintf(cfg.intent_id, sizeof(cfg.intent_id), "cfg-%u", static_cast<unsigned>(i));
+            TraceEvent done = cfg;
+            done.at_ms = t + 30;
+            strncpy(done.outcome, "persisted", sizeof(done.outcome));
+            trace[events++] = cfg;
+            trace[events++] = done;
+        }
+    }
+    const uint32_t end_ms = commands * 40 + 1000;
+
+    // ---- Legacy: every outcome is its own message ----
+    TraceCounters legacy = {0, 0};
+    for (size_t e = 0; e < events; e++) {
+        legacy.publishes++;
+        if (brokerUp(trace[e].at_ms)) {
+            legacy.nvs_writes += 4;
+        } else if (isCriticalForTest(trace[e].flow, trace[e].outcome)) {
+            legacy.nvs_writes += 12 + 2 + 4;
+        }
+    }
+
+    // ---- Batched: admission on event, flush on 50 ms Comm-Task ticks ----
+    IntentOutcomeBatcher batcher(INTENT_OUTCOME_BATCH_WINDOW_MS);
+    TraceCounters batched = {0, 0};
+    std::map<std::string, std::string> delivered_final;
+    uint32_t persisted_commands = 0;
+    static IntentOutcomeBatch batch;
+
+    auto flush = [&](IntentOutcomeLane lane, uint32_t now_ms) {
+        if (batcher.takeBatch(lane, &batch) == 0) {
+            return;
+        }
+        batched.publishes++;
+        if (brokerUp(now_ms)) {
+            batched.nvs_writes += 4;
+            for (uint8_t i = 0; i < batch.count; i++) {
+                std::string key = std::string(batch.items[i].flow) + "/" + batch.items[i].metadata.intent_id;
+                delivered_final[key] = batch.items[i].outcome;
+            }
+        } else if (lane == IntentOutcomeLane::CRITICAL) {
+            batched.nvs_writes += 1 + 3 + 4;
+            for (uint8_t i = 0; i < batch.count; i++) {
+                if (strcmp(batch.items[i].flow, "command") == 0) {
+                    persisted_commands++;
+                }
+            }
+        }
+    };
+
+    size_t next_event = 0;
+    for (uint32_t now = 0; now <= end_ms; now++) {
+        while (next_event < events && trace[next_event].at_ms <= now) {
+            const TraceEvent& ev = trace[next_event++];
+            IntentOutcomeRecord record = makeRecord(ev.flow, ev.intent_id, ev.outcome);
+            IntentOutcomeAdmit admit = batcher.add(record, now);
+            if (admit == IntentOutcomeAdmit::LANE_FULL) {
+                flush(IntentOutcomeBatcher::laneFor(record), now);
+                admit = batcher.add(record, now);
+            }
+            TEST_ASSERT_TRUE(admit != IntentOutcomeAdmit::LANE_FULL);
+        }
+        if (now % 50 == 0) {
+            for (uint8_t lane = INTENT_OUTCOME_LANE_COUNT; lane-- > 0;) {
+                if (batcher.isDue(static_cast<IntentOutcomeLane>(lane), now)) {
+                    flush(static_cast<IntentOutcomeLane>(lane), now);
+                }
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, batcher.getPendingCount(IntentOutcomeLane::CRITICAL));
+    TEST_ASSERT_EQUAL_UINT8(0, batcher.getPendingCount(IntentOutcomeLane::STATUS));
+
+    // Every command reached its final state exactly once (delivered or in the outbox)
+    uint32_t delivered_commands = 0;
+    for (uint32_t i = 0; i < commands; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "command/cmd-%u", static_cast<unsigned>(i));
+        auto it = delivered_final.find(key);
+        if (it != delivered_final.end()) {
+            TEST_ASSERT_EQUAL_STRING("applied", it->second.c_str());
+            delivered_commands++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(commands, delivered_commands + persisted_commands);
+    TEST_ASSERT_EQUAL_STRING("persisted", delivered_final["config/cfg-0"].c_str());
+
+    printf("[TRACE] %u commands, %u outcomes: publishes %u -> %u, NVS writes %u -> %u\n",
+           static_cast<unsigned>(commands), static_cast<unsigned>(events),
+           static_cast<unsigned>(legacy.publishes), static_cast<unsigned>(batched.publishes),
+           static_cast<unsigned>(legacy.nvs_writes), static_cast<unsigned>(batched.nvs_writes));
+    TEST_ASSERT_LESS_THAN_UINT32(legacy.publishes / 4, batched.publishes);
+    TEST_ASSERT_LESS_THAN_UINT32(legacy.nvs_writes / 4, batched.nvs_writes);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, batcher.getStats().collapsed);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_batcher_collapses_accepted_into_applied);
+    RUN_TEST(test_batcher_drops_stale_intermediate_state);
+    RUN_TEST(test_batcher_window_and_full_lane);
+    RUN_TEST(test_batch_blob_roundtrip_is_compact);
+    RUN_TEST(test_trace_replay_reduces_publishes_and_flash_writes);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
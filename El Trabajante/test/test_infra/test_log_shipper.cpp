@@ -0,0 +1,224 @@
+#include <unity.h>
+
+#include <cstring>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "utils/logger.h"
+#include "utils/log_shipper.h"
+
+// ============================================
+// LOG SHIPPER: batching + budget enforcement
+// ============================================
+
+static char frame[LOG_SHIPPER_MAX_FRAME];
+
+static LogShipperConfig makeConfig(LogLevel level, uint16_t bytes_per_min, uint8_t msgs_per_min) {
+    LogShipperConfig config;
+    config.enabled = true;
+    config.min_level = level;
+    config.bytes_per_min = bytes_per_min;
+    config.msgs_per_min = msgs_per_min;
+    config.flush_interval_ms = 10000;
+    return config;
+}
+
+static LogEntry makeEntry(LogLevel level, const char* message, unsigned long timestamp = 0) {
+    LogEntry entry;
+    entry.timestamp = timestamp;
+    entry.level = level;
+    strncpy(entry.tag, "TEST", sizeof(entry.tag));
+    strncpy(entry.message, message, sizeof(entry.message) - 1);
+    entry.message[sizeof(entry.message) - 1] = '\0';
+    return entry;
+}
+
+void setUp(void) {
+    logger.setSerialEnabled(false);
+    logger.setLogLevel(LOG_DEBUG);
+    logger.clearTagLogLevels();
+    logShipper.begin(makeConfig(LOG_WARNING, 4096, 6), 0);
+}
+
+void tearDown(void) {}
+
+void test_collect_filters_level_and_starts_at_begin() {
+    logger.error("OLD", "before begin");
+    logShipper.begin(makeConfig(LOG_WARNING, 4096, 6), 0);
+
+    logger.debug("SENSOR", "debug line");
+    logger.info("SENSOR", "info line");
+    logger.warning("MQTT", "warn line");
+    logger.error("MQTT", "error line");
+
+    TEST_ASSERT_EQUAL(2, logShipper.collect(logger));
+    TEST_ASSERT_EQUAL(2, logShipper.getStagedCount());
+    // Cursor advanced: nothing new on the second pass
+    TEST_ASSERT_EQUAL(0, logShipper.collect(logger));
+}
+
+void test_frame_format_and_escaping() {
+    logger.warning("MQTT", "say \"hi\"\nnext");
+    logShipper.collect(logger);
+
+    size_t len = logShipper.buildFrame(1000, frame, sizeof(frame));
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_EQUAL(strlen(frame), len);
+    const char* prefix = "{\"seq\":1,\"up\":1000,\"dropped\":0,\"logs\":[[";
+    TEST_ASSERT_EQUAL(0, strncmp(frame, prefix, strlen(prefix)));
+    TEST_ASSERT_NOT_NULL(strstr(frame, "\"W\",\"MQTT\",\"say \\\"hi\\\"\\u000anext\"]"));
+    TEST_ASSERT_EQUAL(0, strcmp(frame + len - 3, "]]}"));
+    TEST_ASSERT_EQUAL(0, logShipper.getStagedCount());
+    TEST_ASSERT_EQUAL(1, logShipper.getStats().frames);
+    TEST_ASSERT_EQUAL(1, logShipper.getStats().entries_shipped);
+}
+
+void test_is_due_on_count_error_or_age() {
+    logShipper.offer(makeEntry(LOG_WARNING, "w", 1000));
+    TEST_ASSERT_FALSE(logShipper.isDue(5000));
+    TEST_ASSERT_TRUE(logShipper.isDue(11000));          // Oldest staged for flush_interval
+
+    for (uint8_t i = 1; i < LOG_SHIPPER_FLUSH_COUNT; i++) {
+        logShipper.offer(makeEntry(LOG_WARNING, "w", 1000));
+    }
+    TEST_ASSERT_TRUE(logShipper.isDue(1000));           // Batch full enough
+
+    logShipper.begin(makeConfig(LOG_WARNING, 4096, 6), 0);
+    logShipper.offer(makeEntry(LOG_ERROR, "e", 1000));
+    TEST_ASSERT_TRUE(logShipper.isDue(1000));           // Errors go out right away
+}
+
+void test_message_budget_per_minute() {
+    logShipper.begin(makeConfig(LOG_WARNING, 60000, 2), 0);
+
+    for (int i = 0; i < 3; i++) {
+        logShipper.offer(makeEntry(LOG_ERROR, "e"));
+        size_t len = logShipper.buildFrame(100, frame, sizeof(frame));
+        if (i < 2) {
+            TEST_ASSERT_TRUE(len > 0);
+        } else {
+            TEST_ASSERT_EQUAL(0, len);
+        }
+    }
+    TEST_ASSERT_EQUAL(2, logShipper.getStats().frames);
+    TEST_ASSERT_EQUAL(1, logShipper.getStats().budget_deferrals);
+    TEST_ASSERT_EQUAL(1, logShipper.getStagedCount());   // Deferred, not lost
+
+    // 2 msgs/min → one token after 30 s
+    TEST_ASSERT_EQUAL(0, logShipper.buildFrame(20000, frame, sizeof(frame)));
+    TEST_ASSERT_TRUE(logShipper.buildFrame(31000, frame, sizeof(frame)) > 0);
+    TEST_ASSERT_EQUAL(0, logShipper.getStagedCount());
+}
+
+void test_byte_budget_ships_highest_levels_first() {
+    logShipper.begin(makeConfig(LOG_WARNING, 150, 10), 0);
+    logShipper.offer(makeEntry(LOG_WARNING, "warning one with some padding text"));
+    logShipper.offer(makeEntry(LOG_ERROR, "error two with some padding text"));
+    logShipper.offer(makeEntry(LOG_WARNING, "warning three with some padding text"));
+    logShipper.offer(makeEntry(LOG_CRITICAL, "critical four"));
+
+    size_t len = logShipper.buildFrame(0, frame, sizeof(frame));
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_TRUE(len <= 150);
+    TEST_ASSERT_NOT_NULL(strstr(frame, "critical four"));
+    TEST_ASSERT_NOT_NULL(strstr(frame, "error two"));
+    TEST_ASSERT_NULL(strstr(frame, "warning"));
+    // Chronological order inside the frame
+    TEST_ASSERT_TRUE(strstr(frame, "error two") < strstr(frame, "critical four"));
+    TEST_ASSERT_EQUAL(2, logShipper.getStagedCount());
+
+    // Byte budget spent: nothing more until it refills
+    TEST_ASSERT_EQUAL(0, logShipper.buildFrame(0, frame, sizeof(frame)));
+    TEST_ASSERT_TRUE(logShipper.buildFrame(60000, frame, sizeof(frame)) > 0);
+    TEST_ASSERT_NOT_NULL(strstr(frame, "warning one"));
+}
+
+void test_full_queue_drops_lowest_level_first() {
+    for (size_t i = 0; i < LOG_SHIPPER_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(logShipper.offer(makeEntry(LOG_WARNING, "w")));
+    }
+    TEST_ASSERT_TRUE(logShipper.offer(makeEntry(LOG_ERROR, "e")));
+    TEST_ASSERT_EQUAL(LOG_SHIPPER_QUEUE_SIZE, logShipper.getStagedCount());
+    TEST_ASSERT_EQUAL(1, logShipper.getStats().dropped[LOG_WARNING]);
+
+    // Only errors staged → an incoming warning is the one dropped
+    logShipper.begin(makeConfig(LOG_WARNING, 4096, 6), 0);
+    for (size_t i = 0; i < LOG_SHIPPER_QUEUE_SIZE; i++) {
+        logShipper.offer(makeEntry(LOG_ERROR, "e"));
+    }
+    TEST_ASSERT_FALSE(logShipper.offer(makeEntry(LOG_WARNING, "w")));
+    TEST_ASSERT_EQUAL(1, logShipper.getStats().dropped[LOG_WARNING]);
+    TEST_ASSERT_EQUAL(0, logShipper.getStats().dropped[LOG_ERROR]);
+
+    // Drop count is reported in the next frame, then reset
+    TEST_ASSERT_TRUE(logShipper.buildFrame(0, frame, sizeof(frame)) > 0);
+    TEST_ASSERT_NOT_NULL(strstr(frame, "\"dropped\":1,"));
+    logShipper.offer(makeEntry(LOG_ERROR, "e"));
+    logShipper.buildFrame(10000, frame, sizeof(frame));
+    TEST_ASSERT_NOT_NULL(strstr(frame, "\"dropped\":0,"));
+}
+
+void test_ring_overrun_counts_missed_entries() {
+    for (int i = 0; i < 60; i++) {
+        logger.warning("BURST", "line");
+    }
+    logShipper.collect(logger);
+    TEST_ASSERT_EQUAL(10, logShipper.getStats().entries_missed);   // Ring holds 50
+    TEST_ASSERT_EQUAL(LOG_SHIPPER_QUEUE_SIZE, logShipper.getStagedCount());
+}
+
+void test_disabled_shipper_is_inert() {
+    LogShipperConfig config = makeConfig(LOG_DEBUG, 4096, 6);
+    config.enabled = false;
+    logShipper.begin(config, 0);
+    logger.error("MQTT", "error line");
+    TEST_ASSERT_EQUAL(0, logShipper.collect(logger));
+    TEST_ASSERT_FALSE(logShipper.offer(makeEntry(LOG_CRITICAL, "c")));
+    TEST_ASSERT_FALSE(logShipper.isDue(100000));
+    TEST_ASSERT_EQUAL(0, logShipper.buildFrame(100000, frame, sizeof(frame)));
+}
+
+void test_config_pack_roundtrip() {
+    LogShipperConfig config = makeConfig(LOG_ERROR, 8192, 12);
+    LogShipperConfig restored = LogShipper::unpackConfig(LogShipper::packConfig(config));
+    TEST_ASSERT_TRUE(restored.enabled);
+    TEST_ASSERT_EQUAL(LOG_ERROR, restored.min_level);
+    TEST_ASSERT_EQUAL(8192, restored.bytes_per_min);
+    TEST_ASSERT_EQUAL(12, restored.msgs_per_min);
+    TEST_ASSERT_FALSE(LogShipper::unpackConfig(0).enabled);
+}
+
+// ============================================
+// MAIN
+// ============================================
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_collect_filters_level_and_starts_at_begin);
+    RUN_TEST(test_frame_format_and_escaping);
+    RUN_TEST(test_is_due_on_count_error_or_age);
+    RUN_TEST(test_message_budget_per_minute);
+    RUN_TEST(test_byte_budget_ships_highest_levels_first);
+    RUN_TEST(test_full_queue_drops_lowest_level_first);
+    RUN_TEST(test_ring_overrun_counts_missed_entries);
+    RUN_TEST(test_disabled_shipper_is_inert);
+    RUN_TEST(test_config_pack_roundtrip);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,225 @@
+#include <unity.h>
+
+#include <cstdlib>
+#include <new>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "utils/logger.h"
+
+// ============================================
+// HEAP OPERATION COUNTER (native benchmark)
+// ============================================
+// Counts every global new/delete so a suppressed LOG_* call can be proven
+// allocation-free. Only active between heapCounterStart()/heapCounterStop().
+static bool g_count_heap_ops = false;
+static size_t g_heap_ops = 0;
+
+void* operator new(size_t size) {
+    if (g_count_heap_ops) {
+        g_heap_ops++;
+    }
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (g_count_heap_ops && ptr != nullptr) {
+        g_heap_ops++;
+    }
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+    (void)size;
+    operator delete(ptr);
+}
+
+static void heapCounterStart() {
+    g_heap_ops = 0;
+    g_count_heap_ops = true;
+}
+
+static size_t heapCounterStop() {
+    g_count_heap_ops = false;
+    return g_heap_ops;
+}
+
+static const char* TAG = "MQTT";
+static const char* I2C_TAG = "I2C";
+static const int BENCH_ITERATIONS = 1000;
+
+void setUp(void) {
+    logger.setSerialEnabled(false);
+    logger.setLogLevel(LOG_INFO);
+    logger.clearTagLogLevels();
+    logger.clearLogs();
+}
+
+void tearDown(void) {}
+
+// ============================================
+// TEST CASES
+// ============================================
+
+void test_logger_suppressed_macro_does_not_evaluate_argument() {
+    int evaluations = 0;
+    auto build = [&evaluations]() {
+        evaluations++;
+        return String("evaluated");
+    };
+
+    LOG_D(TAG, build());
+    TEST_ASSERT_EQUAL(0, evaluations);
+
+    LOG_I(TAG, build());
+    TEST_ASSERT_EQUAL(1, evaluations);
+    TEST_ASSERT_EQUAL(1, logger.getLogCount());
+}
+
+void test_logger_suppressed_macro_heap_ops_zero() {
+    String topic("kaiser/god/esp/ESP_12AB34CD/actuator/5/command");
+
+    // Before: unguarded call builds the String argument even though it is dropped
+    heapCounterStart();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        logger.debug(TAG, "MQTT message received: " + topic);
+    }
+    size_t unguarded_ops = heapCounterStop();
+
+    // After: macro guard rejects before the argument expression is evaluated
+    heapCounterStart();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        LOG_D(TAG, "MQTT message received: " + topic);
+    }
+    size_t guarded_ops = heapCounterStop();
+
+    char report[96];
+    snprintf(report, sizeof(report), "heap ops per suppressed log call: unguarded=%.2f guarded=%.2f",
+             static_cast<double>(unguarded_ops) / BENCH_ITERATIONS,
+             static_cast<double>(guarded_ops) / BENCH_ITERATIONS);
+    TEST_MESSAGE(report);
+    TEST_ASSERT_GREATER_THAN(0, unguarded_ops);
+    TEST_ASSERT_EQUAL(0, guarded_ops);
+    TEST_ASSERT_EQUAL(0, logger.getLogCount());
+}
+
+void test_logger_module_override_enables_single_tag() {
+    TEST_ASSERT_TRUE(logger.setTagLogLevel(I2C_TAG, LOG_DEBUG));
+
+    TEST_ASSERT_TRUE(logger.shouldLog(LOG_DEBUG, I2C_TAG));
+    TEST_ASSERT_FALSE(logger.shouldLog(LOG_DEBUG, TAG));
+    TEST_ASSERT_TRUE(logger.shouldLog(LOG_INFO, TAG));
+
+    LOG_D(I2C_TAG, "bus scan");
+    LOG_D(TAG, "dropped");
+    TEST_ASSERT_EQUAL(1, logger.getLogCount());
+}
+
+void test_logger_module_override_can_silence_tag() {
+    TEST_ASSERT_TRUE(logger.setTagLogLevel(TAG, LOG_ERROR));
+
+    TEST_ASSERT_FALSE(logger.shouldLog(LOG_WARNING, TAG));
+    TEST_ASSERT_TRUE(logger.shouldLog(LOG_ERROR, TAG));
+    TEST_ASSERT_TRUE(logger.shouldLog(LOG_INFO, I2C_TAG));
+}
+
+void test_logger_module_override_suppressed_heap_ops_zero() {
+    String topic("kaiser/god/esp/ESP_12AB34CD/sensor/4/data");
+    logger.setTagLogLevel(I2C_TAG, LOG_DEBUG);
+
+    heapCounterStart();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        LOG_D(TAG, "Publish queued: " + topic);
+    }
+    size_t guarded_ops = heapCounterStop();
+
+    TEST_ASSERT_EQUAL(0, guarded_ops);
+}
+
+void test_logger_module_override_clear_restores_global() {
+    logger.setTagLogLevel(I2C_TAG, LOG_DEBUG);
+    TEST_ASSERT_TRUE(logger.clearTagLogLevel(I2C_TAG));
+    TEST_ASSERT_EQUAL(0, logger.getTagLogLevelCount());
+    TEST_ASSERT_FALSE(logger.shouldLog(LOG_DEBUG, I2C_TAG));
+    TEST_ASSERT_FALSE(logger.clearTagLogLevel(I2C_TAG));
+}
+
+void test_logger_module_override_table_bounded() {
+    char tag[8];
+    for (int i = 0; i < 8; i++) {
+        snprintf(tag, sizeof(tag), "MOD%d", i);
+        TEST_ASSERT_TRUE(logger.setTagLogLevel(tag, LOG_DEBUG));
+    }
+    TEST_ASSERT_FALSE(logger.setTagLogLevel("MOD8", LOG_DEBUG));
+    // Updating an existing entry still works when the table is full
+    TEST_ASSERT_TRUE(logger.setTagLogLevel("MOD3", LOG_ERROR));
+    TEST_ASSERT_FALSE(logger.setTagLogLevel("TAG_TOO_LONG_X", LOG_DEBUG));
+}
+
+void test_logger_module_spec_roundtrip() {
+    logger.setTagLogLevel(I2C_TAG, LOG_DEBUG);
+    logger.setTagLogLevel(TAG, LOG_WARNING);
+
+    char spec[128];
+    logger.formatTagLogLevelSpec(spec, sizeof(spec));
+    TEST_ASSERT_EQUAL_STRING("I2C=DEBUG,MQTT=WARNING", spec);
+
+    logger.clearTagLogLevels();
+    TEST_ASSERT_EQUAL(2, logger.applyTagLogLevelSpec(spec));
+    TEST_ASSERT_TRUE(logger.shouldLog(LOG_DEBUG, I2C_TAG));
+    TEST_ASSERT_FALSE(logger.shouldLog(LOG_INFO, TAG));
+}
+
+void test_logger_module_spec_skips_invalid_items() {
+    size_t applied = logger.applyTagLogLevelSpec("I2C=DEBUG,BROKEN,ONEWIRE=LOUD,=INFO,PUMP=ERROR");
+    TEST_ASSERT_EQUAL(2, applied);
+    TEST_ASSERT_TRUE(logger.shouldLog(LOG_DEBUG, I2C_TAG));
+    TEST_ASSERT_FALSE(logger.shouldLog(LOG_WARNING, "PUMP"));
+    TEST_ASSERT_FALSE(logger.shouldLog(LOG_DEBUG, "ONEWIRE"));
+}
+
+void test_logger_module_spec_truncates_at_entry_boundary() {
+    logger.setTagLogLevel(I2C_TAG, LOG_DEBUG);
+    logger.setTagLogLevel(TAG, LOG_WARNING);
+
+    char spec[16];
+    logger.formatTagLogLevelSpec(spec, sizeof(spec));
+    TEST_ASSERT_EQUAL_STRING("I2C=DEBUG", spec);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_logger_suppressed_macro_does_not_evaluate_argument);
+    RUN_TEST(test_logger_suppressed_macro_heap_ops_zero);
+    RUN_TEST(test_logger_module_override_enables_single_tag);
+    RUN_TEST(test_logger_module_override_can_silence_tag);
+    RUN_TEST(test_logger_module_override_suppressed_heap_ops_zero);
+    RUN_TEST(test_logger_module_override_clear_restores_global);
+    RUN_TEST(test_logger_module_override_table_bounded);
+    RUN_TEST(test_logger_module_spec_roundtrip);
+    RUN_TEST(test_logger_module_spec_skips_invalid_items);
+    RUN_TEST(test_logger_module_spec_truncates_at_entry_boundary);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,238 @@
+#include <unity.h>
+
+#include <string.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "services/config/nvs_accounting.h"
+
+// ============================================
+// MOCK NVS STATS SOURCE (counts nvs_get_stats calls)
+// ============================================
+class MockNvsStatsSource : public INvsStatsSource {
+public:
+    size_t free_entries = 0;
+    uint32_t calls = 0;
+
+    size_t queryFreeEntries() override {
+        calls++;
+        return free_entries;
+    }
+};
+
+static MockNvsStatsSource source;
+static NvsAccounting accounting;
+
+void setUp(void) {
+    source.free_entries = 500;
+    source.calls = 0;
+    accounting.reset();
+}
+
+void tearDown(void) {}
+
+// Simulates one put*(): the old StorageManager queried before every write
+static bool simulatedWrite(size_t entries) {
+    bool ok = accounting.reserve(entries, source) != NvsReserveResult::FULL;
+    if (ok) {
+        source.free_entries -= entries;  // What flash really consumes
+    }
+    return ok;
+}
+
+// ============================================
+// STAT QUERY COUNT
+// ============================================
+
+void test_nvs_config_apply_queries_stats_once() {
+    // 10 sensors × 11 keys in one sensor_config session (saveSensorConfig loop)
+    accounting.beginSession("sensor_config");
+    for (int i = 0; i < 110; i++) {
+        TEST_ASSERT_TRUE(simulatedWrite(NvsAccounting::entriesForPrimitive()));
+    }
+    accounting.endSession();
+
+    TEST_ASSERT_EQUAL_UINT32(1, source.calls);  // Before: 110
+    TEST_ASSERT_EQUAL_UINT32(1, accounting.getStatQueryCount());
+    TEST_ASSERT_EQUAL_UINT32(source.free_entries, accounting.getCachedFreeEntries());
+}
+
+void test_nvs_read_only_session_never_queries() {
+    accounting.beginSession("wifi_config");
+    accounting.endSession();
+    TEST_ASSERT_EQUAL_UINT32(0, source.calls);
+}
+
+void test_nvs_each_session_queries_again() {
+    accounting.beginSession("zone_config");
+    simulatedWrite(1);
+    simulatedWrite(1);
+    accounting.endSession();
+
+    // Foreign writer (WiFi driver) consumed entries between sessions
+    source.free_entries -= 7;
+
+    accounting.beginSession("actuator_config");
+    simulatedWrite(1);
+    accounting.endSession();
+
+    TEST_ASSERT_EQUAL_UINT32(2, source.calls);
+    TEST_ASSERT_EQUAL_UINT32(source.free_entries, accounting.getCachedFreeEntries());
+}
+
+// ============================================
+// SHORTAGE / FAILURE
+// ============================================
+
+void test_nvs_shortage_requeries_before_refusing() {
+    source.free_entries = 3;
+    accounting.beginSession("sensor_config");
+    TEST_ASSERT_TRUE(simulatedWrite(1));
+    TEST_ASSERT_TRUE(simulatedWrite(1));
+
+    // Page GC freed entries meanwhile → cache says 1, flash says 40
+    source.free_entries = 40;
+    TEST_ASSERT_EQUAL(NvsReserveResult::OK, accounting.reserve(3, source));
+    TEST_ASSERT_EQUAL_UINT32(2, source.calls);
+}
+
+void test_nvs_full_after_requery() {
+    source.free_entries = 2;
+    accounting.beginSession("sensor_config");
+    TEST_ASSERT_TRUE(simulatedWrite(1));
+    TEST_ASSERT_EQUAL(NvsReserveResult::FULL, accounting.reserve(2, source));
+    TEST_ASSERT_EQUAL_UINT32(2, source.calls);
+
+    // Every refusal is confirmed by a fresh query (no stale "full")
+    TEST_ASSERT_EQUAL(NvsReserveResult::FULL, accounting.reserve(2, source));
+    TEST_ASSERT_EQUAL_UINT32(3, source.calls);
+}
+
+void test_nvs_write_failure_invalidates_cache() {
+    accounting.beginSession("system_config");
+    simulatedWrite(1);
+    accounting.invalidate();  // preferences_.putX() returned 0
+    simulatedWrite(1);
+    TEST_ASSERT_EQUAL_UINT32(2, source.calls);
+}
+
+void test_nvs_low_space_reported_once_per_session() {
+    source.free_entries = 12;
+    accounting.beginSession("sensor_config");
+    TEST_ASSERT_EQUAL(NvsReserveResult::OK, accounting.reserve(1, source));
+    TEST_ASSERT_EQUAL(NvsReserveResult::OK, accounting.reserve(1, source));
+    TEST_ASSERT_EQUAL(NvsReserveResult::LOW_SPACE, accounting.reserve(1, source));  // 9 left
+    TEST_ASSERT_EQUAL(NvsReserveResult::OK, accounting.reserve(1, source));
+    accounting.endSession();
+
+    source.free_entries = 8;  // Flash state after the four writes
+    accounting.beginSession("sensor_config");
+    TEST_ASSERT_EQUAL(NvsReserveResult::LOW_SPACE, accounting.reserve(1, source));
+}
+
+// ============================================
+// ENTRY SPANS
+// ============================================
+
+void test_nvs_string_and_blob_spans() {
+    TEST_ASSERT_EQUAL_UINT32(1, NvsAccounting::entriesForPrimitive());
+    TEST_ASSERT_EQUAL_UINT32(2, NvsAccounting::entriesForString(0));    // "" → '\0'
+    TEST_ASSERT_EQUAL_UINT32(2, NvsAccounting::entriesForString(31));   // 32 B incl. '\0'
+    TEST_ASSERT_EQUAL_UINT32(3, NvsAccounting::entriesForString(32));
+    TEST_ASSERT_EQUAL_UINT32(4, NvsAccounting::entriesForString(64));   // e.g. MQTT password
+    TEST_ASSERT_EQUAL_UINT32(2, NvsAccounting::entriesForBlob(0));
+    TEST_ASSERT_EQUAL_UINT32(3, NvsAccounting::entriesForBlob(32));
+    TEST_ASSERT_EQUAL_UINT32(4, NvsAccounting::entriesForBlob(33));
+
+    accounting.beginSession("wifi_config");
+    simulatedWrite(NvsAccounting::entriesForString(20));   // SSID
+    simulatedWrite(NvsAccounting::entriesForString(63));   // Password
+    accounting.endSession();
+    TEST_ASSERT_EQUAL_UINT32(500 - 2 - 3, accounting.getCachedFreeEntries());
+    TEST_ASSERT_EQUAL_UINT32(5, accounting.getNamespace(0).entries_written);
+}
+
+// ============================================
+// DIAGNOSTICS
+// ============================================
+
+void test_nvs_per_namespace_diagnostics_json() {
+    accounting.beginSession("wifi_config");
+    simulatedWrite(NvsAccounting::entriesForString(10));
+    accounting.endSession();
+    accounting.beginSession("sensor_config");
+    simulatedWrite(1);
+    simulatedWrite(1);
+    accounting.endSession();
+    accounting.beginSession("wifi_config");
+    accounting.endSession();
+
+    TEST_ASSERT_EQUAL_UINT32(2, accounting.getNamespaceCount());
+    TEST_ASSERT_EQUAL_UINT32(2, accounting.getNamespace(0).sessions);
+    accounting.setUsedEntries(0, 14);
+    accounting.setUsedEntries(1, 57);
+
+    String json = "";
+    accounting.appendDiagnosticsJson(json);
+    TEST_ASSERT_EQUAL_STRING(
+        ",\"nvs\":{\"free\":496,\"stat_q\":2,\"ns\":["
+        "{\"n\":\"wifi_config\",\"used\":14,\"e\":2},"
+        "{\"n\":\"sensor_config\",\"used\":57,\"e\":2}]}",
+        json.c_str());
+}
+
+void test_nvs_scoped_writes_attributed_by_namespace() {
+    // Safety-Task watchdog record (scoped) in the middle of a sensor_config save
+    accounting.beginSession("sensor_config");
+    simulatedWrite(1);
+    accounting.beginScopedSession("wdt_diag");
+    TEST_ASSERT_TRUE(accounting.reserveScoped("wdt_diag", 3, source) != NvsReserveResult::FULL);
+    source.free_entries -= 3;
+    simulatedWrite(1);
+    accounting.endSession();
+
+    TEST_ASSERT_EQUAL_UINT32(2, source.calls);  // Scoped session starts a fresh cache
+    TEST_ASSERT_EQUAL_UINT32(495, accounting.getCachedFreeEntries());
+    TEST_ASSERT_EQUAL_STRING("sensor_config", accounting.getNamespace(0).name);
+    TEST_ASSERT_EQUAL_UINT32(2, accounting.getNamespace(0).entries_written);
+    TEST_ASSERT_EQUAL_STRING("wdt_diag", accounting.getNamespace(1).name);
+    TEST_ASSERT_EQUAL_UINT32(1, accounting.getNamespace(1).sessions);
+    TEST_ASSERT_EQUAL_UINT32(3, accounting.getNamespace(1).entries_written);
+
+    source.free_entries = 2;
+    accounting.invalidate();
+    TEST_ASSERT_TRUE(accounting.reserveScoped("wdt_diag", 3, source) == NvsReserveResult::FULL);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_nvs_config_apply_queries_stats_once);
+    RUN_TEST(test_nvs_read_only_session_never_queries);
+    RUN_TEST(test_nvs_each_session_queries_again);
+    RUN_TEST(test_nvs_shortage_requeries_before_refusing);
+    RUN_TEST(test_nvs_full_after_requery);
+    RUN_TEST(test_nvs_write_failure_invalidates_cache);
+    RUN_TEST(test_nvs_low_space_reported_once_per_session);
+    RUN_TEST(test_nvs_string_and_blob_spans);
+    RUN_TEST(test_nvs_per_namespace_diagnostics_json);
+    RUN_TEST(test_nvs_scoped_writes_attributed_by_namespace);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,250 @@
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "services/config/nvs_namespace_locks.h"
+
+// ============================================
+// Per-namespace leases vs. the former single global session:
+// concurrent writers on independent namespaces, serialization and no lost
+// writes on a shared namespace.
+// ============================================
+
+using Clock = std::chrono::steady_clock;
+
+// In-memory NVS: one key/value map per namespace, deliberately unsynchronized
+// (the lease is the only protection, like Preferences handles on target).
+struct MockNvsNamespace {
+    std::map<std::string, uint32_t> values;
+    std::atomic<int> holders{0};
+    std::atomic<int> max_holders{0};
+};
+
+static void enterNamespace(MockNvsNamespace& ns) {
+    int now = ++ns.holders;
+    int prev = ns.max_holders.load();
+    while (now > prev && !ns.max_holders.compare_exchange_weak(prev, now)) {
+    }
+}
+
+static void leaveNamespace(MockNvsNamespace& ns) {
+    ns.holders--;
+}
+
+static long elapsedMs(Clock::time_point start) {
+    return (long)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_ns_lease_same_namespace_no_lost_writes() {
+    static const int WRITERS = 4;
+    static const int WRITES_PER_WRITER = 500;
+    NvsNamespaceLocks locks;
+    MockNvsNamespace outbox;
+    std::atomic<int> failed{0};
+
+    // Intent outbox counters bumped from several tasks (read-modify-write)
+    std::vector<std::thread> writers;
+    for (int w = 0; w < WRITERS; w++) {
+        writers.emplace_back([&]() {
+            for (int i = 0; i < WRITES_PER_WRITER; i++) {
+                NvsNamespaceLease lease(locks, "io_outbox", 1000);
+                if (!lease.held()) {
+                    failed++;
+                    continue;
+                }
+                enterNamespace(outbox);
+                uint32_t value = outbox.values["retry_total"];
+                std::this_thread::yield();
+                outbox.values["retry_total"] = value + 1;
+                leaveNamespace(outbox);
+            }
+        });
+    }
+    for (std::thread& t : writers) {
+        t.join();
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, failed.load());
+    TEST_ASSERT_EQUAL_UINT32(WRITERS * WRITES_PER_WRITER, outbox.values["retry_total"]);
+    TEST_ASSERT_EQUAL_INT(1, outbox.max_holders.load());
+    TEST_ASSERT_EQUAL_UINT32(0, locks.getTimeoutCount());
+}
+
+void test_ns_lease_independent_namespaces_run_concurrently() {
+    NvsNamespaceLocks locks;
+    MockNvsNamespace sensor_config;
+    MockNvsNamespace wdt_diag;
+    std::atomic<bool> save_started{false};
+    long safety_write_ms = -1;
+
+    // Core 0: slow multi-key config save (60 keys × 2 ms flash write)
+    std::thread config_save([&]() {
+        NvsNamespaceLease lease(locks, "sensor_config");
+        TEST_ASSERT_TRUE(lease.held());
+        enterNamespace(sensor_config);
+        save_started = true;
+        for (int i = 0; i < 60; i++) {
+            sensor_config.values["sen_" + std::to_string(i)] = i;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        leaveNamespace(sensor_config);
+    });
+
+    // Core 1: Safety-Task watchdog record while the save is in progress
+    while (!save_started) {
+        std::this_thread::yield();
+    }
+    Clock::time_point start = Clock::now();
+    {
+        NvsNamespaceLease lease(locks, "wdt_diag", 250);
+        TEST_ASSERT_TRUE(lease.held());
+        enterNamespace(wdt_diag);
+        wdt_diag.values["hist"] = 1;
+        leaveNamespace(wdt_diag);
+    }
+    safety_write_ms = elapsedMs(start);
+    bool save_still_running = sensor_config.holders.load() == 1;
+    config_save.join();
+
+    TEST_ASSERT_TRUE(save_still_running);   // Genuinely overlapped
+    TEST_ASSERT_TRUE(safety_write_ms < 20);  // Global session: ~120 ms or 250 ms timeout
+    TEST_ASSERT_EQUAL_UINT32(60, sensor_config.values.size());
+    TEST_ASSERT_EQUAL_UINT32(0, locks.getWaitCount());
+}
+
+void test_ns_lease_cross_task_writers_many_namespaces() {
+    static const char* const NAMESPACES[] = {
+        "sensor_config", "actuator_config", "offline", "wdt_diag", "io_outbox", "cfg_pending"
+    };
+    static const int NS_COUNT = 6;
+    static const int THREADS = 12;
+    static const int ROUNDS = 300;
+    NvsNamespaceLocks locks;
+    MockNvsNamespace store[NS_COUNT];
+    std::atomic<int> failed{0};
+
+    // Two tasks per namespace, interleaved with the others
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            for (int r = 0; r < ROUNDS; r++) {
+                int ns = (t + r) % NS_COUNT;
+                NvsNamespaceLease lease(locks, NAMESPACES[ns], 1000);
+                if (!lease.held()) {
+                    failed++;
+                    continue;
+                }
+                enterNamespace(store[ns]);
+                store[ns].values["writes"]++;
+                store[ns].values["t" + std::to_string(t)]++;
+                leaveNamespace(store[ns]);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    uint32_t total = 0;
+    for (int ns = 0; ns < NS_COUNT; ns++) {
+        TEST_ASSERT_EQUAL_INT(1, store[ns].max_holders.load());
+        total += store[ns].values["writes"];
+    }
+    TEST_ASSERT_EQUAL_INT(0, failed.load());
+    TEST_ASSERT_EQUAL_UINT32(THREADS * ROUNDS, total);
+}
+
+void test_ns_lease_recursive_for_owner_and_timeout_for_others() {
+    NvsNamespaceLocks locks;
+
+    // Legacy session + scoped handle on the same namespace in one task
+    NvsNamespaceLease outer(locks, "offline");
+    NvsNamespaceLease inner(locks, "offline");
+    TEST_ASSERT_TRUE(outer.held());
+    TEST_ASSERT_TRUE(inner.held());
+
+    bool other_held = true;
+    long waited_ms = 0;
+    std::thread other([&]() {
+        Clock::time_point start = Clock::now();
+        NvsNamespaceLease lease(locks, "offline", 30);
+        other_held = lease.held();
+        waited_ms = elapsedMs(start);
+    });
+    other.join();
+
+    TEST_ASSERT_FALSE(other_held);
+    TEST_ASSERT_TRUE(waited_ms >= 25);
+    TEST_ASSERT_EQUAL_UINT32(1, locks.getWaitCount());
+    TEST_ASSERT_EQUAL_UINT32(1, locks.getTimeoutCount());
+}
+
+void test_ns_lease_released_on_scope_exit() {
+    NvsNamespaceLocks locks;
+    {
+        NvsNamespaceLease lease(locks, "zone_config");
+        TEST_ASSERT_TRUE(lease.held());
+    }
+    bool held = false;
+    std::thread other([&]() {
+        NvsNamespaceLease lease(locks, "zone_config", 0);
+        held = lease.held();
+    });
+    other.join();
+    TEST_ASSERT_TRUE(held);
+}
+
+void test_ns_lease_slot_table_exhaustion() {
+    NvsNamespaceLocks locks;
+    char name[16];
+    for (size_t i = 0; i < NVS_NAMESPACE_LOCK_SLOTS; i++) {
+        snprintf(name, sizeof(name), "ns_%u", (unsigned)i);
+        NvsNamespaceLease lease(locks, name);
+        TEST_ASSERT_TRUE(lease.held());
+    }
+    NvsNamespaceLease overflow(locks, "one_too_many");
+    TEST_ASSERT_FALSE(overflow.held());
+
+    NvsNamespaceLease known(locks, "ns_0");  // Existing slots stay usable
+    TEST_ASSERT_TRUE(known.held());
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_ns_lease_same_namespace_no_lost_writes);
+    RUN_TEST(test_ns_lease_independent_namespaces_run_concurrently);
+    RUN_TEST(test_ns_lease_cross_task_writers_many_namespaces);
+    RUN_TEST(test_ns_lease_recursive_for_owner_and_timeout_for_others);
+    RUN_TEST(test_ns_lease_released_on_scope_exit);
+    RUN_TEST(test_ns_lease_slot_table_exhaustion);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,191 @@
+#include <unity.h>
+
+#include <cstring>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "error_handling/resource_monitor.h"
+
+// Fake task handles — only compared by address in the native shim
+static int g_safety_handle_storage = 0;
+static int g_comm_handle_storage = 0;
+static void* const SAFETY_HANDLE = &g_safety_handle_storage;
+static void* const COMM_HANDLE = &g_comm_handle_storage;
+
+void setUp(void) {
+    resourceMonitor.resetForTest();
+    resourceMonitor.begin(false);  // Cold boot: RTC record discarded
+    resourceMonitor.setSimulatedFreeHeap(200000);
+}
+
+void tearDown(void) {}
+
+// ============================================
+// TEST CASES
+// ============================================
+
+void test_resource_monitor_tracks_minimum_free_stack() {
+    TEST_ASSERT_TRUE(resourceMonitor.registerTask("SafetyTask", SAFETY_HANDLE, 12288));
+
+    resourceMonitor.setSimulatedStackFree(SAFETY_HANDLE, 6000);
+    resourceMonitor.sample();
+    resourceMonitor.setSimulatedStackFree(SAFETY_HANDLE, 4200);
+    resourceMonitor.sample();
+    resourceMonitor.setSimulatedStackFree(SAFETY_HANDLE, 5000);
+    resourceMonitor.sample();
+
+    const TaskWatermark* task = resourceMonitor.findTask("SafetyTask");
+    TEST_ASSERT_NOT_NULL(task);
+    TEST_ASSERT_EQUAL_UINT32(4200, task->min_free_bytes);
+    TEST_ASSERT_EQUAL_UINT32(3, task->samples);
+    TEST_ASSERT_EQUAL_UINT32(12288, task->stack_bytes);
+}
+
+void test_resource_monitor_unresolved_task_is_not_sampled() {
+    resourceMonitor.registerTask("mqtt_task", nullptr, 16384);
+    resourceMonitor.sample();
+
+    const TaskWatermark* task = resourceMonitor.findTask("mqtt_task");
+    TEST_ASSERT_NOT_NULL(task);
+    TEST_ASSERT_EQUAL_UINT32(0, task->samples);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, task->min_free_bytes);
+}
+
+void test_resource_monitor_reregistration_keeps_slot() {
+    resourceMonitor.registerTask("CommTask", COMM_HANDLE, 10240);
+    resourceMonitor.setSimulatedStackFree(COMM_HANDLE, 3000);
+    resourceMonitor.sample();
+
+    TEST_ASSERT_TRUE(resourceMonitor.registerTask("CommTask", COMM_HANDLE, 9216));
+    TEST_ASSERT_EQUAL(1, resourceMonitor.getTaskCount());
+    TEST_ASSERT_EQUAL_UINT32(9216, resourceMonitor.findTask("CommTask")->stack_bytes);
+    TEST_ASSERT_EQUAL_UINT32(3000, resourceMonitor.findTask("CommTask")->min_free_bytes);
+}
+
+void test_resource_monitor_task_table_bounded() {
+    static int handles[9];
+    char name[8];
+    for (int i = 0; i < 8; i++) {
+        snprintf(name, sizeof(name), "task%d", i);
+        TEST_ASSERT_TRUE(resourceMonitor.registerTask(name, &handles[i], 4096));
+    }
+    TEST_ASSERT_FALSE(resourceMonitor.registerTask("task8", &handles[8], 4096));
+    TEST_ASSERT_FALSE(resourceMonitor.registerTask("", &handles[8], 4096));
+}
+
+void test_resource_monitor_suggest_stack_bytes() {
+    // used = 12288 - 8288 = 4000 → 4000 + 1000 + 1024 = 6024 → 6144 (512 aligned)
+    TEST_ASSERT_EQUAL_UINT32(6144, ResourceMonitor::suggestStackBytes(12288, 8288));
+    // Nearly exhausted stack suggests growth beyond the configured size
+    TEST_ASSERT_EQUAL_UINT32(13824, ResourceMonitor::suggestStackBytes(10240, 200));
+    // No sample yet → configured size unchanged
+    TEST_ASSERT_EQUAL_UINT32(10240, ResourceMonitor::suggestStackBytes(10240, UINT32_MAX));
+}
+
+void test_resource_monitor_heap_delta_scope() {
+    resourceMonitor.setSimulatedFreeHeap(150000);
+    {
+        HeapDeltaScope scope(HeapSubsystem::CONFIG_APPLY);
+        resourceMonitor.setSimulatedFreeHeap(148800);  // 1200 B retained
+    }
+    {
+        HeapDeltaScope scope(HeapSubsystem::CONFIG_APPLY);
+        resourceMonitor.setSimulatedFreeHeap(149000);  // 200 B released
+    }
+
+    HeapDeltaStats stats = resourceMonitor.getHeapDelta(HeapSubsystem::CONFIG_APPLY);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.count);
+    TEST_ASSERT_EQUAL_INT32(-200, stats.last_delta);
+    TEST_ASSERT_EQUAL_INT32(1200, stats.max_delta);
+    TEST_ASSERT_EQUAL_UINT32(148800, stats.min_free_after);
+
+    HeapDeltaStats untouched = resourceMonitor.getHeapDelta(HeapSubsystem::HEARTBEAT_BUILD);
+    TEST_ASSERT_EQUAL_UINT32(0, untouched.count);
+}
+
+void test_resource_monitor_watermarks_survive_warm_reset() {
+    resourceMonitor.registerTask("SafetyTask", SAFETY_HANDLE, 12288);
+    resourceMonitor.setSimulatedStackFree(SAFETY_HANDLE, 1800);
+    resourceMonitor.setSimulatedFreeHeap(42000);
+    resourceMonitor.sample();
+
+    // Warm reset (e.g. task WDT): RAM cleared, RTC record kept
+    resourceMonitor.resetForTest();
+    resourceMonitor.begin(true);
+    TEST_ASSERT_EQUAL_UINT32(42000, resourceMonitor.getLastBootHeapMinFree());
+
+    resourceMonitor.registerTask("SafetyTask", SAFETY_HANDLE, 12288);
+    const TaskWatermark* task = resourceMonitor.findTask("SafetyTask");
+    TEST_ASSERT_EQUAL_UINT32(1800, task->last_boot_min_free_bytes);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, task->min_free_bytes);
+
+    // First sample of the new boot must not erase the last-boot value
+    resourceMonitor.setSimulatedStackFree(SAFETY_HANDLE, 7000);
+    resourceMonitor.sample();
+    TEST_ASSERT_EQUAL_UINT32(1800, task->last_boot_min_free_bytes);
+    TEST_ASSERT_EQUAL_UINT32(7000, task->min_free_bytes);
+}
+
+void test_resource_monitor_cold_boot_discards_rtc_record() {
+    resourceMonitor.registerTask("SafetyTask", SAFETY_HANDLE, 12288);
+    resourceMonitor.setSimulatedStackFree(SAFETY_HANDLE, 1800);
+    resourceMonitor.sample();
+
+    resourceMonitor.resetForTest();
+    resourceMonitor.begin(false);
+    resourceMonitor.registerTask("SafetyTask", SAFETY_HANDLE, 12288);
+    TEST_ASSERT_EQUAL_UINT32(0, resourceMonitor.findTask("SafetyTask")->last_boot_min_free_bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, resourceMonitor.getLastBootHeapMinFree());
+}
+
+void test_resource_monitor_diagnostics_json() {
+    resourceMonitor.registerTask("SafetyTask", SAFETY_HANDLE, 12288);
+    resourceMonitor.registerTask("mqtt_task", nullptr, 16384);  // Unsampled → omitted
+    resourceMonitor.setSimulatedStackFree(SAFETY_HANDLE, 8288);
+    resourceMonitor.sample();
+    resourceMonitor.recordHeapDelta(HeapSubsystem::HEARTBEAT_BUILD, 100000, 99500);
+
+    String json = "{\"heap_free\":1";
+    resourceMonitor.appendDiagnosticsJson(json);
+    json += "}";
+
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"heap_free\":1"
+        ",\"stack_hwm\":[{\"t\":\"SafetyTask\",\"sz\":12288,\"min\":8288,\"prev\":0,\"sug\":6144}]"
+        ",\"heap_delta\":{\"config_apply\":[0,0,0],\"heartbeat_build\":[1,500,500],"
+        "\"command_handling\":[0,0,0]}"
+        ",\"heap_min_free_prev_boot\":0}",
+        json.c_str());
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_resource_monitor_tracks_minimum_free_stack);
+    RUN_TEST(test_resource_monitor_unresolved_task_is_not_sampled);
+    RUN_TEST(test_resource_monitor_reregistration_keeps_slot);
+    RUN_TEST(test_resource_monitor_task_table_bounded);
+    RUN_TEST(test_resource_monitor_suggest_stack_bytes);
+    RUN_TEST(test_resource_monitor_heap_delta_scope);
+    RUN_TEST(test_resource_monitor_watermarks_survive_warm_reset);
+    RUN_TEST(test_resource_monitor_cold_boot_discards_rtc_record);
+    RUN_TEST(test_resource_monitor_diagnostics_json);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,229 @@
+#include <unity.h>
+
+#include <cstring>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "tasks/safety_tick_scheduler.h"
+
+// ============================================
+// SafetyTickScheduler: admission, starvation guard and a simulated Safety-Task
+// loop measuring tick jitter with and without phase budgets.
+// ============================================
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_tick_critical_phases_always_run() {
+    SafetyTickScheduler scheduler(5000);
+    scheduler.beginTick(0);
+    // Budget long exhausted — critical phases are never deferred
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::NOTIFY, 90000));
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::ACTUATORS, 90000));
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::COMMAND_QUEUES, 90000));
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::OFFLINE_RULES, 90000));
+    TEST_ASSERT_FALSE(scheduler.hasDeferredWork());
+}
+
+void test_tick_deferrable_phase_moves_to_next_tick() {
+    SafetyTickScheduler scheduler(5000);
+    scheduler.beginTick(1000);
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::HEALTH, 5999));
+    TEST_ASSERT_FALSE(scheduler.shouldRun(SafetyPhase::CONFIG_APPLY, 6000));
+    TEST_ASSERT_TRUE(scheduler.hasDeferredWork());
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getPhaseStats(SafetyPhase::CONFIG_APPLY).deferrals);
+
+    scheduler.beginTick(20000);
+    TEST_ASSERT_FALSE(scheduler.hasDeferredWork());
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::CONFIG_APPLY, 20100));
+}
+
+void test_tick_starvation_guard_forces_deferred_phase() {
+    SafetyTickScheduler scheduler(5000);
+    uint32_t now = 0;
+    for (uint8_t i = 0; i < SAFETY_PHASE_MAX_DEFERRALS; i++) {
+        scheduler.beginTick(now);
+        TEST_ASSERT_FALSE(scheduler.shouldRun(SafetyPhase::HEALTH, now + 8000));
+        now += 10000;
+    }
+    scheduler.beginTick(now);
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::HEALTH, now + 8000));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getPhaseStats(SafetyPhase::HEALTH).forced);
+    TEST_ASSERT_EQUAL_UINT32(SAFETY_PHASE_MAX_DEFERRALS,
+                             scheduler.getPhaseStats(SafetyPhase::HEALTH).deferrals);
+
+    // Counter restarts after the forced run
+    scheduler.beginTick(now + 10000);
+    TEST_ASSERT_FALSE(scheduler.shouldRun(SafetyPhase::HEALTH, now + 18000));
+}
+
+void test_tick_slice_deadline() {
+    SafetyTickScheduler scheduler(5000);
+    scheduler.configurePhase(SafetyPhase::MEASUREMENTS, SafetyPhaseClass::SPLITTABLE, 3000);
+    scheduler.beginTick(10000);
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::MEASUREMENTS, 11000));
+    TEST_ASSERT_EQUAL_UINT32(14000, scheduler.sliceDeadlineUs(SafetyPhase::MEASUREMENTS, 11000));
+    TEST_ASSERT_EQUAL_UINT32(15000, scheduler.sliceDeadlineUs(SafetyPhase::MEASUREMENTS, 13000));
+
+    // Wrap-around of micros()
+    scheduler.beginTick(0xFFFFF000UL);
+    TEST_ASSERT_TRUE(scheduler.shouldRun(SafetyPhase::MEASUREMENTS, 0xFFFFF800UL));
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(0xFFFFF000UL + 5000), scheduler.sliceDeadlineUs(SafetyPhase::MEASUREMENTS, 0xFFFFF800UL));
+}
+
+void test_tick_phase_overruns_and_tick_stats() {
+    SafetyTickScheduler scheduler(5000);
+    scheduler.beginTick(0);
+    scheduler.recordPhase(SafetyPhase::ACTUATORS, 0, 1500);     // budget 2000
+    scheduler.recordPhase(SafetyPhase::HEALTH, 1500, 4000);     // budget 2000 → overrun
+    scheduler.endTick(7000);
+
+    const SafetyPhaseStats& health = scheduler.getPhaseStats(SafetyPhase::HEALTH);
+    TEST_ASSERT_EQUAL_UINT32(1, health.runs);
+    TEST_ASSERT_EQUAL_UINT32(1, health.overruns);
+    TEST_ASSERT_EQUAL_UINT32(2500, health.max_us);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getPhaseStats(SafetyPhase::ACTUATORS).overruns);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getTickStats().over_budget);
+    TEST_ASSERT_EQUAL_UINT32(7000, scheduler.getTickStats().max_us);
+}
+
+// ============================================
+// SIMULATED SAFETY LOOP
+// ============================================
+// Load: 8 due I2C sensors at 20 ms each (slow bus), 2 queued config updates
+// at 40 ms each (NVS write), 1 ms health loop. Critical phases: 1.5 ms.
+struct SimLoad {
+    uint8_t sensors_due;
+    uint8_t config_items;
+};
+
+static const uint32_t SIM_CRITICAL_US = 1500;
+static const uint32_t SIM_SENSOR_US = 20000;
+static const uint32_t SIM_CONFIG_US = 40000;
+static const uint32_t SIM_HEALTH_US = 1000;
+
+static uint32_t runUnscheduledTick(uint32_t& now, SimLoad& load) {
+    uint32_t start = now;
+    now += SIM_CRITICAL_US;
+    now += load.sensors_due * SIM_SENSOR_US;
+    load.sensors_due = 0;
+    now += load.config_items * SIM_CONFIG_US;
+    load.config_items = 0;
+    now += SIM_HEALTH_US;
+    return now - start;
+}
+
+static uint32_t runScheduledTick(SafetyTickScheduler& scheduler, uint32_t& now, SimLoad& load) {
+    uint32_t start = now;
+    scheduler.beginTick(now);
+    now += SIM_CRITICAL_US;
+    scheduler.recordPhase(SafetyPhase::ACTUATORS, start, now);
+
+    if (scheduler.shouldRun(SafetyPhase::MEASUREMENTS, now)) {
+        uint32_t phase_start = now;
+        uint32_t deadline = scheduler.sliceDeadlineUs(SafetyPhase::MEASUREMENTS, now);
+        uint8_t done = 0;
+        // Same stop rule as SensorManager: at least one sensor, then until deadline
+        while (load.sensors_due > 0 && (done == 0 || static_cast<int32_t>(now - deadline) < 0)) {
+            now += SIM_SENSOR_US;
+            load.sensors_due--;
+            done++;
+        }
+        scheduler.recordPhase(SafetyPhase::MEASUREMENTS, phase_start, now);
+    }
+    if (load.config_items > 0 && scheduler.shouldRun(SafetyPhase::CONFIG_APPLY, now)) {
+        uint32_t phase_start = now;
+        now += SIM_CONFIG_US;          // One item per admitted tick
+        load.config_items--;
+        scheduler.recordPhase(SafetyPhase::CONFIG_APPLY, phase_start, now);
+    }
+    if (scheduler.shouldRun(SafetyPhase::HEALTH, now)) {
+        uint32_t phase_start = now;
+        now += SIM_HEALTH_US;
+        scheduler.recordPhase(SafetyPhase::HEALTH, phase_start, now);
+    }
+    scheduler.endTick(now);
+    return now - start;
+}
+
+void test_tick_simulated_loop_bounds_jitter() {
+    // Baseline: everything in one iteration
+    uint32_t now = 0;
+    SimLoad baseline = {8, 2};
+    uint32_t unscheduled_max = runUnscheduledTick(now, baseline);
+    TEST_ASSERT_EQUAL_UINT32(SIM_CRITICAL_US + 8 * SIM_SENSOR_US + 2 * SIM_CONFIG_US + SIM_HEALTH_US,
+                             unscheduled_max);
+
+    SafetyTickScheduler scheduler(5000);
+    SimLoad load = {8, 2};
+    now = 0;
+    uint32_t scheduled_max = 0;
+    uint32_t ticks = 0;
+    while ((load.sensors_due > 0 || load.config_items > 0) && ticks < 100) {
+        uint32_t duration = runScheduledTick(scheduler, now, load);
+        if (duration > scheduled_max) {
+            scheduled_max = duration;
+        }
+        now += 10000;  // Block between ticks
+        ticks++;
+    }
+
+    // All work completed, spread over several ticks
+    TEST_ASSERT_EQUAL_UINT8(0, load.sensors_due);
+    TEST_ASSERT_EQUAL_UINT8(0, load.config_items);
+    TEST_ASSERT_TRUE(ticks >= 10);
+    TEST_ASSERT_TRUE(ticks < 20);
+
+    // Jitter bound: critical + one work item of the phase crossing the budget
+    TEST_ASSERT_TRUE(scheduled_max <= SIM_CRITICAL_US + SIM_CONFIG_US + SIM_HEALTH_US);
+    TEST_ASSERT_TRUE(scheduled_max * 5 < unscheduled_max);
+    TEST_ASSERT_EQUAL_UINT32(scheduled_max, scheduler.getTickStats().max_us);
+    TEST_ASSERT_TRUE(scheduler.getPhaseStats(SafetyPhase::CONFIG_APPLY).deferrals > 0);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getPhaseStats(SafetyPhase::CONFIG_APPLY).runs);
+}
+
+void test_tick_diagnostics_json() {
+    SafetyTickScheduler scheduler(5000);
+    scheduler.beginTick(0);
+    scheduler.shouldRun(SafetyPhase::HEALTH, 6000);
+    scheduler.recordPhase(SafetyPhase::ACTUATORS, 0, 2500);
+    scheduler.endTick(6000);
+
+    String json = "{";
+    scheduler.appendDiagnosticsJson(json);
+    json += "}";
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"safety_tick\":{\"b\":5000,\"n\":1,\"over\":1,\"max\":6000"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"actuators\":[1,0,0,1,2500]"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"health\":[0,1,0,0,0]"));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_tick_critical_phases_always_run);
+    RUN_TEST(test_tick_deferrable_phase_moves_to_next_tick);
+    RUN_TEST(test_tick_starvation_guard_forces_deferred_phase);
+    RUN_TEST(test_tick_slice_deadline);
+    RUN_TEST(test_tick_phase_overruns_and_tick_stats);
+    RUN_TEST(test_tick_simulated_loop_bounds_jitter);
+    RUN_TEST(test_tick_diagnostics_json);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,366 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "core/system_controller.h"
+
+// ============================================
+// SystemController: every transition of the table, ignored events,
+// entry/exit actions, resume target, transition log and work lanes.
+// ============================================
+
+static SystemState g_state = STATE_BOOT;
+
+static const uint8_t STATE_COUNT = STATE_ERROR + 1;
+
+struct ExpectedTransition {
+    SystemEvent event;
+    SystemState from;
+    SystemState to;
+};
+
+// Complete table: every (event, source) pair with a transition
+static const ExpectedTransition EXPECTED[] = {
+    { SystemEvent::STATE_REPAIRED,          STATE_SAFE_MODE_PROVISIONING,     STATE_BOOT },
+    { SystemEvent::PROVISIONING_REQUIRED,   STATE_BOOT,                       STATE_SAFE_MODE_PROVISIONING },
+    { SystemEvent::PROVISIONING_REQUIRED,   STATE_OPERATIONAL,                STATE_SAFE_MODE_PROVISIONING },
+    { SystemEvent::PORTAL_RECONNECTED,      STATE_SAFE_MODE_PROVISIONING,     STATE_OPERATIONAL },
+    { SystemEvent::OFFLINE_AUTONOMY,        STATE_BOOT,                       STATE_OPERATIONAL },
+    { SystemEvent::CONNECTED_APPROVED,      STATE_BOOT,                       STATE_OPERATIONAL },
+    { SystemEvent::CONNECTED_APPROVED,      STATE_SAFE_MODE,                  STATE_OPERATIONAL },
+    { SystemEvent::CONNECTED_UNAPPROVED,    STATE_BOOT,                       STATE_PENDING_APPROVAL },
+    { SystemEvent::APPROVAL_GRANTED,        STATE_PENDING_APPROVAL,           STATE_OPERATIONAL },
+    { SystemEvent::APPROVAL_GRANTED,        STATE_ERROR,                      STATE_OPERATIONAL },
+    { SystemEvent::APPROVAL_PENDING,        STATE_OPERATIONAL,                STATE_PENDING_APPROVAL },
+    { SystemEvent::APPROVAL_PENDING,        STATE_ZONE_CONFIGURED,            STATE_PENDING_APPROVAL },
+    { SystemEvent::DEVICE_REJECTED,         STATE_OPERATIONAL,                STATE_ERROR },
+    { SystemEvent::DEVICE_REJECTED,         STATE_CONFIG_PENDING_AFTER_RESET, STATE_ERROR },
+    { SystemEvent::ZONE_ASSIGNED,           STATE_OPERATIONAL,                STATE_ZONE_CONFIGURED },
+    { SystemEvent::ZONE_ASSIGNED,           STATE_PENDING_APPROVAL,           STATE_ZONE_CONFIGURED },
+    { SystemEvent::ZONE_REMOVED,            STATE_ZONE_CONFIGURED,            STATE_PENDING_APPROVAL },
+    { SystemEvent::CONFIG_INCOMPLETE,       STATE_OPERATIONAL,                STATE_CONFIG_PENDING_AFTER_RESET },
+    { SystemEvent::CONFIG_INCOMPLETE,       STATE_PENDING_APPROVAL,           STATE_CONFIG_PENDING_AFTER_RESET },
+    { SystemEvent::CONFIG_READY_APPROVED,   STATE_CONFIG_PENDING_AFTER_RESET, STATE_OPERATIONAL },
+    { SystemEvent::CONFIG_READY_UNAPPROVED, STATE_CONFIG_PENDING_AFTER_RESET, STATE_PENDING_APPROVAL },
+    { SystemEvent::LIBRARY_DOWNLOAD_STARTED, STATE_OPERATIONAL,               STATE_LIBRARY_DOWNLOADING },
+};
+
+// Action recorder
+static uint8_t enter_calls = 0;
+static uint8_t exit_calls = 0;
+static uint8_t listener_calls = 0;
+static SystemState seen_during_exit = STATE_BOOT;
+static SystemState seen_during_enter = STATE_BOOT;
+static SystemEvent last_listener_event = SystemEvent::COUNT;
+
+static void onExit(SystemState from, SystemState to, SystemEvent event) {
+    (void)from; (void)to; (void)event;
+    exit_calls++;
+    seen_during_exit = systemController.getState();  // Recursive lock: query allowed
+}
+
+static void onEnter(SystemState from, SystemState to, SystemEvent event) {
+    (void)from; (void)to; (void)event;
+    enter_calls++;
+    seen_during_enter = systemController.getState();
+}
+
+static void onTransition(SystemState from, SystemState to, SystemEvent event) {
+    (void)from; (void)to;
+    listener_calls++;
+    last_listener_event = event;
+}
+
+void setUp(void) {
+    systemController.reset();
+    g_state = STATE_BOOT;
+    systemController.begin(&g_state, 0);
+    enter_calls = 0;
+    exit_calls = 0;
+    listener_calls = 0;
+    last_listener_event = SystemEvent::COUNT;
+}
+
+void tearDown(void) {
+    systemController.reset();
+}
+
+static bool isExpected(SystemEvent event, SystemState from, SystemState& to) {
+    for (size_t i = 0; i < sizeof(EXPECTED) / sizeof(EXPECTED[0]); i++) {
+        if (EXPECTED[i].event == event && EXPECTED[i].from == from) {
+            to = EXPECTED[i].to;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================
+// TRANSITION TABLE
+// ============================================
+
+void test_state_all_listed_transitions() {
+    for (size_t i = 0; i < sizeof(EXPECTED) / sizeof(EXPECTED[0]); i++) {
+        g_state = EXPECTED[i].from;
+        TEST_ASSERT_TRUE_MESSAGE(systemController.handleEvent(EXPECTED[i].event, 100 + i),
+                                 SystemController::eventName(EXPECTED[i].event));
+        TEST_ASSERT_EQUAL_MESSAGE(EXPECTED[i].to, g_state, SystemController::eventName(EXPECTED[i].event));
+    }
+}
+
+void test_state_boot_loop_from_every_state() {
+    for (uint8_t s = 0; s < STATE_COUNT; s++) {
+        g_state = static_cast<SystemState>(s);
+        TEST_ASSERT_TRUE(systemController.handleEvent(SystemEvent::BOOT_LOOP_DETECTED, 0));
+        TEST_ASSERT_EQUAL_INT(STATE_SAFE_MODE, g_state);
+    }
+}
+
+void test_state_portal_only_left_through_its_own_events() {
+    const SystemEvent foreign[] = {
+        SystemEvent::PROVISIONING_REQUIRED, SystemEvent::OFFLINE_AUTONOMY, SystemEvent::CONNECTED_APPROVED,
+        SystemEvent::CONNECTED_UNAPPROVED, SystemEvent::APPROVAL_GRANTED, SystemEvent::APPROVAL_PENDING,
+        SystemEvent::DEVICE_REJECTED, SystemEvent::ZONE_ASSIGNED, SystemEvent::ZONE_REMOVED,
+        SystemEvent::CONFIG_INCOMPLETE, SystemEvent::LIBRARY_DOWNLOAD_STARTED,
+    };
+    for (size_t i = 0; i < sizeof(foreign) / sizeof(foreign[0]); i++) {
+        g_state = STATE_SAFE_MODE_PROVISIONING;
+        TEST_ASSERT_FALSE(systemController.canHandle(foreign[i]));
+        TEST_ASSERT_FALSE(systemController.handleEvent(foreign[i], 0));
+        TEST_ASSERT_EQUAL_INT(STATE_SAFE_MODE_PROVISIONING, g_state);
+    }
+    TEST_ASSERT_EQUAL_UINT32(11, systemController.getIgnoredEventCount());
+    TEST_ASSERT_EQUAL_UINT32(0, systemController.getTransitionCount());
+}
+
+void test_state_unlisted_pairs_are_ignored_or_idempotent() {
+    // Every (event, state) pair: either listed above, a no-op self transition,
+    // one of the mask-wide rows, or ignored without touching the state
+    for (uint8_t e = 0; e < static_cast<uint8_t>(SystemEvent::COUNT); e++) {
+        SystemEvent event = static_cast<SystemEvent>(e);
+        for (uint8_t s = 0; s < STATE_COUNT; s++) {
+            SystemState from = static_cast<SystemState>(s);
+            g_state = from;
+            SystemState to = from;
+            bool listed = isExpected(event, from, to);
+            bool handled = systemController.handleEvent(event, 0);
+            if (listed) {
+                TEST_ASSERT_TRUE(handled);
+                TEST_ASSERT_EQUAL_INT(to, g_state);
+            } else if (from == STATE_LIBRARY_DOWNLOADING && event != SystemEvent::BOOT_LOOP_DETECTED &&
+                       event != SystemEvent::LIBRARY_DOWNLOAD_FINISHED) {
+                TEST_ASSERT_EQUAL_INT(STATE_LIBRARY_DOWNLOADING, g_state);  // Never left mid-download
+            } else if (!handled) {
+                TEST_ASSERT_EQUAL_INT(from, g_state);
+            }
+        }
+    }
+}
+
+void test_state_rows_respect_source_masks() {
+    g_state = STATE_OPERATIONAL;
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::APPROVAL_GRANTED, 0));  // Heartbeat while running
+    g_state = STATE_ZONE_CONFIGURED;
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::APPROVAL_GRANTED, 0));
+    g_state = STATE_CONFIG_PENDING_AFTER_RESET;
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::APPROVAL_PENDING, 0));  // Readiness gate only
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::APPROVAL_GRANTED, 0));
+    g_state = STATE_ERROR;
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::CONFIG_INCOMPLETE, 0));
+    g_state = STATE_SAFE_MODE;
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::CONFIG_INCOMPLETE, 0));
+    g_state = STATE_OPERATIONAL;
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::CONFIG_READY_APPROVED, 0));
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_FINISHED, 0));
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::STATE_REPAIRED, 0));
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::PORTAL_RECONNECTED, 0));
+}
+
+void test_state_library_download_resumes_previous_state() {
+    g_state = STATE_PENDING_APPROVAL;
+    TEST_ASSERT_TRUE(systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_STARTED, 0));
+    TEST_ASSERT_EQUAL_INT(STATE_LIBRARY_DOWNLOADING, g_state);
+    TEST_ASSERT_TRUE(systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_STARTED, 5));  // No-op
+    TEST_ASSERT_TRUE(systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_FINISHED, 10));
+    TEST_ASSERT_EQUAL_INT(STATE_PENDING_APPROVAL, g_state);
+}
+
+void test_state_download_defers_runtime_events() {
+    struct Deferred {
+        SystemEvent event;
+        SystemState before_download;
+        SystemState resumed;
+    };
+    const Deferred cases[] = {
+        { SystemEvent::ZONE_ASSIGNED,     STATE_OPERATIONAL,      STATE_ZONE_CONFIGURED },
+        { SystemEvent::ZONE_REMOVED,      STATE_ZONE_CONFIGURED,  STATE_PENDING_APPROVAL },
+        { SystemEvent::APPROVAL_PENDING,  STATE_OPERATIONAL,      STATE_PENDING_APPROVAL },
+        { SystemEvent::CONFIG_INCOMPLETE, STATE_OPERATIONAL,      STATE_CONFIG_PENDING_AFTER_RESET },
+        { SystemEvent::OFFLINE_AUTONOMY,  STATE_PENDING_APPROVAL, STATE_OPERATIONAL },
+        { SystemEvent::APPROVAL_GRANTED,  STATE_PENDING_APPROVAL, STATE_OPERATIONAL },
+        { SystemEvent::DEVICE_REJECTED,   STATE_OPERATIONAL,      STATE_ERROR },
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const char* name = SystemController::eventName(cases[i].event);
+        g_state = cases[i].before_download;
+        systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_STARTED, 0);
+        uint32_t transitions = systemController.getTransitionCount();
+
+        TEST_ASSERT_TRUE_MESSAGE(systemController.canHandle(cases[i].event), name);
+        TEST_ASSERT_TRUE_MESSAGE(systemController.handleEvent(cases[i].event, 10), name);
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_LIBRARY_DOWNLOADING, g_state, name);  // Safe hold stays
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(transitions, systemController.getTransitionCount(), name);
+
+        TEST_ASSERT_TRUE_MESSAGE(
+            systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_FINISHED, 20), name);
+        TEST_ASSERT_EQUAL_MESSAGE(cases[i].resumed, g_state, name);
+    }
+}
+
+void test_state_download_ignores_events_invalid_for_resume_state() {
+    g_state = STATE_OPERATIONAL;
+    systemController.handleEvent(SystemEvent::LIBRARY_DOWNLOAD_STARTED, 0);
+
+    TEST_ASSERT_FALSE(systemController.canHandle(SystemEvent::APPROVAL_GRANTED));
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::APPROVAL_GRANTED, 0));
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::CONFIG_READY_APPROVED, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, systemController.getIgnoredEventCount());
+
+    // Chained events retarget step by step; boot loop still leaves at once
+    TEST_ASSERT_TRUE(systemController.handleEvent(SystemEvent::APPROVAL_PENDING, 0));
+    TEST_ASSERT_TRUE(systemController.handleEvent(SystemEvent::ZONE_ASSIGNED, 0));
+    TEST_ASSERT_EQUAL_INT(STATE_LIBRARY_DOWNLOADING, g_state);
+    TEST_ASSERT_TRUE(systemController.handleEvent(SystemEvent::BOOT_LOOP_DETECTED, 0));
+    TEST_ASSERT_EQUAL_INT(STATE_SAFE_MODE, g_state);
+}
+
+// ============================================
+// ACTIONS
+// ============================================
+
+void test_state_exit_then_enter_then_listener() {
+    systemController.setStateActions(STATE_CONFIG_PENDING_AFTER_RESET, onEnter, onExit);
+    systemController.setTransitionListener(onTransition);
+
+    g_state = STATE_OPERATIONAL;
+    systemController.handleEvent(SystemEvent::CONFIG_INCOMPLETE, 0);
+    TEST_ASSERT_EQUAL_UINT8(1, enter_calls);
+    TEST_ASSERT_EQUAL_UINT8(0, exit_calls);
+    TEST_ASSERT_EQUAL_INT(STATE_CONFIG_PENDING_AFTER_RESET, seen_during_enter);
+
+    systemController.handleEvent(SystemEvent::CONFIG_READY_APPROVED, 0);
+    TEST_ASSERT_EQUAL_UINT8(1, exit_calls);
+    TEST_ASSERT_EQUAL_INT(STATE_CONFIG_PENDING_AFTER_RESET, seen_during_exit);  // Before the switch
+    TEST_ASSERT_EQUAL_UINT8(2, listener_calls);
+    TEST_ASSERT_TRUE(SystemEvent::CONFIG_READY_APPROVED == last_listener_event);
+}
+
+void test_state_self_transition_and_ignored_event_run_no_actions() {
+    systemController.setStateActions(STATE_OPERATIONAL, onEnter, onExit);
+    systemController.setTransitionListener(onTransition);
+    g_state = STATE_OPERATIONAL;
+
+    TEST_ASSERT_TRUE(systemController.handleEvent(SystemEvent::CONNECTED_APPROVED, 0));  // Already there
+    TEST_ASSERT_FALSE(systemController.handleEvent(SystemEvent::APPROVAL_GRANTED, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, enter_calls + exit_calls + listener_calls);
+    TEST_ASSERT_EQUAL_UINT32(0, systemController.getTransitionCount());
+}
+
+// ============================================
+// TRANSITION LOG
+// ============================================
+
+void test_state_log_records_timestamp_and_event() {
+    systemController.handleEvent(SystemEvent::CONNECTED_UNAPPROVED, 1200);
+    systemController.handleEvent(SystemEvent::APPROVAL_GRANTED, 65000);
+
+    SystemTransitionRecord records[4];
+    TEST_ASSERT_EQUAL_UINT8(2, systemController.getTransitionLog(records, 4));
+    TEST_ASSERT_EQUAL_UINT32(1200, records[0].timestamp_ms);
+    TEST_ASSERT_EQUAL_INT(STATE_BOOT, records[0].from);
+    TEST_ASSERT_EQUAL_INT(STATE_PENDING_APPROVAL, records[0].to);
+    TEST_ASSERT_TRUE(SystemEvent::CONNECTED_UNAPPROVED == records[0].event);
+    TEST_ASSERT_EQUAL_UINT32(65000, records[1].timestamp_ms);
+    TEST_ASSERT_EQUAL_INT(STATE_OPERATIONAL, records[1].to);
+}
+
+void test_state_log_ring_keeps_newest() {
+    for (uint32_t i = 0; i < SYSTEM_TRANSITION_LOG_SIZE + 4; i++) {
+        systemController.handleEvent(i % 2 == 0 ? SystemEvent::ZONE_ASSIGNED : SystemEvent::ZONE_REMOVED, i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(SYSTEM_TRANSITION_LOG_SIZE + 4, systemController.getTransitionCount());
+
+    SystemTransitionRecord records[SYSTEM_TRANSITION_LOG_SIZE];
+    TEST_ASSERT_EQUAL_UINT8(SYSTEM_TRANSITION_LOG_SIZE,
+                            systemController.getTransitionLog(records, SYSTEM_TRANSITION_LOG_SIZE));
+    TEST_ASSERT_EQUAL_UINT32(4, records[0].timestamp_ms);
+    TEST_ASSERT_EQUAL_UINT32(SYSTEM_TRANSITION_LOG_SIZE + 3, records[SYSTEM_TRANSITION_LOG_SIZE - 1].timestamp_ms);
+
+    SystemTransitionRecord newest[3];
+    TEST_ASSERT_EQUAL_UINT8(3, systemController.getTransitionLog(newest, 3));
+    TEST_ASSERT_EQUAL_UINT32(SYSTEM_TRANSITION_LOG_SIZE + 1, newest[0].timestamp_ms);
+}
+
+// ============================================
+// WORK LANES
+// ============================================
+
+void test_state_work_lanes_per_state() {
+    g_state = STATE_SAFE_MODE_PROVISIONING;
+    TEST_ASSERT_TRUE(systemController.allows(SYSTEM_WORK_PORTAL));
+    TEST_ASSERT_FALSE(systemController.allows(SYSTEM_WORK_LINK));
+
+    g_state = STATE_PENDING_APPROVAL;
+    TEST_ASSERT_TRUE(systemController.allows(SYSTEM_WORK_LINK));
+    TEST_ASSERT_FALSE(systemController.allows(SYSTEM_WORK_CONTROL));
+    TEST_ASSERT_EQUAL_UINT8(SYSTEM_WORK_LINK, SystemController::workMaskFor(STATE_CONFIG_PENDING_AFTER_RESET));
+
+    g_state = STATE_OPERATIONAL;
+    TEST_ASSERT_TRUE(systemController.allows(SYSTEM_WORK_LINK | SYSTEM_WORK_CONTROL | SYSTEM_WORK_LINK_WATCH));
+    TEST_ASSERT_FALSE(systemController.allows(SYSTEM_WORK_PORTAL));
+
+    // Only OPERATIONAL escalates a lost link to the portal
+    for (uint8_t s = 0; s < STATE_COUNT; s++) {
+        bool watch = (SystemController::workMaskFor(static_cast<SystemState>(s)) & SYSTEM_WORK_LINK_WATCH) != 0;
+        TEST_ASSERT_EQUAL(s == STATE_OPERATIONAL, watch);
+    }
+}
+
+void test_state_begin_adopts_persisted_state() {
+    SystemState persisted = STATE_ZONE_CONFIGURED;
+    systemController.begin(&persisted, 0);
+    TEST_ASSERT_EQUAL_INT(STATE_ZONE_CONFIGURED, systemController.getState());
+
+    SystemState corrupt = static_cast<SystemState>(42);
+    systemController.begin(&corrupt, 0);
+    TEST_ASSERT_EQUAL_INT(STATE_BOOT, corrupt);
+    TEST_ASSERT_EQUAL_STRING("BOOT", SystemController::stateName(systemController.getState()));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_state_all_listed_transitions);
+    RUN_TEST(test_state_boot_loop_from_every_state);
+    RUN_TEST(test_state_portal_only_left_through_its_own_events);
+    RUN_TEST(test_state_unlisted_pairs_are_ignored_or_idempotent);
+    RUN_TEST(test_state_rows_respect_source_masks);
+    RUN_TEST(test_state_library_download_resumes_previous_state);
+    RUN_TEST(test_state_download_defers_runtime_events);
+    RUN_TEST(test_state_download_ignores_events_invalid_for_resume_state);
+    RUN_TEST(test_state_exit_then_enter_then_listener);
+    RUN_TEST(test_state_self_transition_and_ignored_event_run_no_actions);
+    RUN_TEST(test_state_log_records_timestamp_and_event);
+    RUN_TEST(test_state_log_ring_keeps_newest);
+    RUN_TEST(test_state_work_lanes_per_state);
+    RUN_TEST(test_state_begin_adopts_persisted_state);
+    return UNITY_END();
+}
+#endif
@@ -0,0 +1,143 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "tasks/task_wake.h"
+
+// ============================================
+// TaskWake native shim: enqueue-to-wake latency and idle wake-ups of an
+// event-driven loop vs. the former 50 ms polling Comm-Task.
+// ============================================
+
+using Clock = std::chrono::steady_clock;
+
+static const uint32_t WAKE_PUBLISH = 0x01;
+static const uint32_t WAKE_OTHER   = 0x02;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_wake_pending_bits_are_not_lost() {
+    TaskWake wake;
+    wake.attachCurrentTask();
+
+    // Signalled while the owner was busy → next wait returns immediately
+    wake.signal(WAKE_PUBLISH);
+    wake.signal(WAKE_OTHER);
+    Clock::time_point start = Clock::now();
+    uint32_t bits = wake.wait(1000);
+    long waited_ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+    TEST_ASSERT_EQUAL_UINT32(WAKE_PUBLISH | WAKE_OTHER, bits);
+    TEST_ASSERT_TRUE(waited_ms < 50);
+    TEST_ASSERT_EQUAL_UINT32(1, wake.getEventWakes());
+
+    // Bits were cleared by the previous wait
+    TEST_ASSERT_EQUAL_UINT32(0, wake.wait(5));
+    TEST_ASSERT_EQUAL_UINT32(1, wake.getTimeoutWakes());
+}
+
+void test_wake_signal_before_attach_is_ignored() {
+    TaskWake wake;
+    wake.signal(WAKE_PUBLISH);  // Comm-Task not started yet
+    wake.attachCurrentTask();
+    TEST_ASSERT_EQUAL_UINT32(0, wake.wait(5));
+}
+
+void test_wake_enqueue_to_wake_latency_sub_millisecond() {
+    static const int SAMPLES = 200;
+    TaskWake wake;
+    std::atomic<bool> ready{false};
+    std::atomic<int64_t> signal_ns{0};
+    std::atomic<int> received{0};
+    std::vector<int64_t> latencies_us;
+    latencies_us.reserve(SAMPLES);
+
+    std::thread consumer([&]() {
+        wake.attachCurrentTask();
+        ready = true;
+        while (received < SAMPLES) {
+            // Idle block as in the Comm-Task (comm_idle_delay_ms)
+            if (wake.wait(500) & WAKE_PUBLISH) {
+                int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now().time_since_epoch()).count();
+                latencies_us.push_back((now_ns - signal_ns.load()) / 1000);
+                received++;
+            }
+        }
+    });
+
+    while (!ready) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < SAMPLES; i++) {
+        std::this_thread::sleep_for(std::chrono::microseconds(500 + (i % 7) * 300));
+        signal_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count();
+        wake.signal(WAKE_PUBLISH);  // queuePublish() → notifyCommTaskPublishWork()
+        while (received <= i) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    int64_t median_us = latencies_us[SAMPLES / 2];
+    char msg[96];
+    snprintf(msg, sizeof(msg), "enqueue-to-wake median=%ldus p95=%ldus (50 ms polling: ~25000us)",
+             (long)median_us, (long)latencies_us[(SAMPLES * 95) / 100]);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(median_us < 1000);
+    TEST_ASSERT_EQUAL_UINT32(0, wake.getTimeoutWakes());
+}
+
+void test_wake_idle_wakeups_follow_deadline_not_poll_tick() {
+    TaskWake wake;
+    wake.attachCurrentTask();
+
+    // 1 s idle with a 250 ms block (scaled-down comm_idle_delay_ms):
+    // 4 wake-ups instead of 20 with a 50 ms vTaskDelay loop.
+    Clock::time_point end = Clock::now() + std::chrono::milliseconds(1000);
+    uint32_t loops = 0;
+    while (Clock::now() < end) {
+        wake.wait(250);
+        loops++;
+    }
+    TEST_ASSERT_TRUE(loops <= 5);
+    TEST_ASSERT_EQUAL_UINT32(0, wake.getEventWakes());
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_wake_pending_bits_are_not_lost);
+    RUN_TEST(test_wake_signal_before_attach_is_ignored);
+    RUN_TEST(test_wake_enqueue_to_wake_latency_sub_millisecond);
+    RUN_TEST(test_wake_idle_wakeups_follow_deadline_not_poll_tick);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,217 @@
+#include <unity.h>
+
+#include <cstring>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "error_handling/watchdog_supervisor.h"
+
+static uint8_t hb_safety;
+static uint8_t hb_sensors;
+static uint8_t hb_onewire;
+static uint8_t hb_config;
+static uint8_t hb_nvs;
+static uint8_t hb_comm;
+
+static void registerDefaults() {
+    hb_safety = watchdogSupervisor.registerHeartbeat("safety_loop", 2000);
+    hb_sensors = watchdogSupervisor.registerHeartbeat("sensor_measure", 5000);
+    hb_onewire = watchdogSupervisor.registerHeartbeat("onewire_conv", 1500);
+    hb_config = watchdogSupervisor.registerHeartbeat("config_apply", 3000);
+    hb_nvs = watchdogSupervisor.registerHeartbeat("nvs_commit", 1000);
+    hb_comm = watchdogSupervisor.registerHeartbeat("comm_loop", 2000);
+}
+
+// Simulates the task-WDT reset: RAM cleared, RTC record kept, warm boot
+static void rebootWarm() {
+    watchdogSupervisor.resetForTest();
+    watchdogSupervisor.begin(true);
+    registerDefaults();
+}
+
+void setUp(void) {
+    watchdogSupervisor.resetForTest();
+    watchdogSupervisor.begin(false);  // Cold boot: RTC record discarded
+    registerDefaults();
+}
+
+void tearDown(void) {}
+
+// ============================================
+// TEST CASES
+// ============================================
+
+void test_wdt_supervisor_registration_is_idempotent() {
+    uint8_t again = watchdogSupervisor.registerHeartbeat("onewire_conv", 1200);
+    TEST_ASSERT_EQUAL_UINT8(hb_onewire, again);
+    TEST_ASSERT_EQUAL_UINT8(6, watchdogSupervisor.getHeartbeatCount());
+    TEST_ASSERT_EQUAL_UINT32(1200, watchdogSupervisor.getHeartbeat(again)->budget_ms);
+    TEST_ASSERT_EQUAL_UINT8(WDT_SUP_INVALID_ID, watchdogSupervisor.registerHeartbeat("", 100));
+}
+
+void test_wdt_supervisor_counts_phase_overruns() {
+    watchdogSupervisor.setSimulatedTime(1000);
+    watchdogSupervisor.beginPhase(hb_onewire);
+    watchdogSupervisor.setSimulatedTime(1800);
+    watchdogSupervisor.endPhase(hb_onewire);      // 800 ms — within budget
+
+    watchdogSupervisor.beginPhase(hb_onewire);
+    watchdogSupervisor.setSimulatedTime(4000);
+    watchdogSupervisor.endPhase(hb_onewire);      // 2200 ms — overrun
+
+    const WdtHeartbeatStats* hb = watchdogSupervisor.findHeartbeat("onewire_conv");
+    TEST_ASSERT_NOT_NULL(hb);
+    TEST_ASSERT_EQUAL_UINT32(2, hb->count);
+    TEST_ASSERT_EQUAL_UINT32(1, hb->overruns);
+    TEST_ASSERT_EQUAL_UINT32(2200, hb->max_duration_ms);
+}
+
+void test_wdt_supervisor_live_overrun_detection() {
+    watchdogSupervisor.setSimulatedTime(10000);
+    watchdogSupervisor.beginPhase(hb_config);
+    watchdogSupervisor.setSimulatedTime(12000);
+    TEST_ASSERT_EQUAL_UINT8(WDT_SUP_INVALID_ID, watchdogSupervisor.findOverrunningPhase());
+
+    watchdogSupervisor.setSimulatedTime(14500);
+    uint32_t age = 0;
+    TEST_ASSERT_EQUAL_UINT8(hb_config, watchdogSupervisor.findOverrunningPhase(&age));
+    TEST_ASSERT_EQUAL_UINT32(4500, age);
+}
+
+void test_wdt_supervisor_attributes_stalled_nested_phase_after_reset() {
+    // Core 1: Safety-Task applies a config, NVS commit hangs
+    watchdogSupervisor.setSimulatedCore(1);
+    watchdogSupervisor.setSimulatedTime(50000);
+    watchdogSupervisor.checkIn(hb_safety);
+    watchdogSupervisor.beginPhase(hb_config);
+    watchdogSupervisor.setSimulatedTime(50200);
+    watchdogSupervisor.beginPhase(hb_nvs);
+
+    // Core 0 keeps running and updates the record until the WDT fires
+    watchdogSupervisor.setSimulatedCore(0);
+    for (uint32_t t = 51000; t <= 110000; t += 1000) {
+        watchdogSupervisor.setSimulatedTime(t);
+        watchdogSupervisor.checkIn(hb_comm);
+    }
+    watchdogSupervisor.noteFeed("COMM_LOOP");
+
+    rebootWarm();
+
+    const WdtStallReport& report = watchdogSupervisor.getLastBootReport();
+    TEST_ASSERT_TRUE(report.valid);
+    TEST_ASSERT_TRUE(report.phase_active);
+    TEST_ASSERT_EQUAL_STRING("nvs_commit", report.phase);
+    TEST_ASSERT_EQUAL_STRING("config_apply", report.outer_phase);
+    TEST_ASSERT_EQUAL_UINT8(1, report.core);
+    TEST_ASSERT_EQUAL_UINT32(110000 - 50200, report.phase_age_ms);
+    TEST_ASSERT_EQUAL_UINT32(1000, report.phase_budget_ms);
+    // Safety loop stopped checking in at 50000 → overdue by 60000 - 2000
+    TEST_ASSERT_EQUAL_STRING("safety_loop", report.overdue_heartbeat);
+    TEST_ASSERT_EQUAL_UINT32(58000, report.overdue_ms);
+    TEST_ASSERT_EQUAL_STRING("COMM_LOOP", report.last_feed);
+    TEST_ASSERT_EQUAL_UINT32(110000, report.uptime_ms);
+}
+
+void test_wdt_supervisor_prefers_phase_furthest_past_budget() {
+    watchdogSupervisor.setSimulatedCore(0);
+    watchdogSupervisor.setSimulatedTime(1000);
+    watchdogSupervisor.beginPhase(hb_sensors);     // budget 5000
+    watchdogSupervisor.setSimulatedCore(1);
+    watchdogSupervisor.setSimulatedTime(2000);
+    watchdogSupervisor.beginPhase(hb_onewire);     // budget 1500
+    watchdogSupervisor.setSimulatedTime(7000);
+    watchdogSupervisor.checkIn(hb_comm);
+
+    rebootWarm();
+
+    const WdtStallReport& report = watchdogSupervisor.getLastBootReport();
+    // sensor_measure: 6000 ms (1000 over) vs onewire_conv: 5000 ms (3500 over)
+    TEST_ASSERT_EQUAL_STRING("onewire_conv", report.phase);
+    TEST_ASSERT_EQUAL_UINT8(1, report.core);
+    TEST_ASSERT_EQUAL_STRING("", report.outer_phase);
+}
+
+void test_wdt_supervisor_completed_phases_are_not_attributed() {
+    watchdogSupervisor.setSimulatedTime(1000);
+    watchdogSupervisor.beginPhase(hb_sensors);
+    watchdogSupervisor.beginPhase(hb_onewire);
+    watchdogSupervisor.setSimulatedTime(1700);
+    watchdogSupervisor.endPhase(hb_onewire);
+    watchdogSupervisor.endPhase(hb_sensors);
+    watchdogSupervisor.checkIn(hb_safety);
+
+    rebootWarm();
+
+    const WdtStallReport& report = watchdogSupervisor.getLastBootReport();
+    TEST_ASSERT_TRUE(report.valid);
+    TEST_ASSERT_FALSE(report.phase_active);
+    TEST_ASSERT_EQUAL_STRING("", report.overdue_heartbeat);
+}
+
+void test_wdt_supervisor_missing_inner_end_pops_to_outer() {
+    watchdogSupervisor.setSimulatedTime(1000);
+    watchdogSupervisor.beginPhase(hb_config);
+    watchdogSupervisor.beginPhase(hb_nvs);         // endPhase(hb_nvs) skipped (early return)
+    watchdogSupervisor.setSimulatedTime(1500);
+    watchdogSupervisor.endPhase(hb_config);
+
+    TEST_ASSERT_EQUAL_UINT32(1, watchdogSupervisor.findHeartbeat("config_apply")->count);
+    watchdogSupervisor.setSimulatedTime(100000);
+    TEST_ASSERT_EQUAL_UINT8(WDT_SUP_INVALID_ID, watchdogSupervisor.findOverrunningPhase());
+}
+
+void test_wdt_supervisor_cold_boot_discards_record() {
+    watchdogSupervisor.setSimulatedTime(1000);
+    watchdogSupervisor.beginPhase(hb_onewire);
+
+    watchdogSupervisor.resetForTest();
+    watchdogSupervisor.begin(false);  // Power-on: RTC no-init content is random
+
+    TEST_ASSERT_FALSE(watchdogSupervisor.getLastBootReport().valid);
+}
+
+void test_wdt_supervisor_phase_scope_and_json() {
+    watchdogSupervisor.setSimulatedTime(1000);
+    {
+        WdtPhaseScope phase(hb_onewire);
+        watchdogSupervisor.setSimulatedTime(3000);
+    }
+    String json = "{";
+    watchdogSupervisor.appendDiagnosticsJson(json);
+    json += "}";
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"wdt_sup\":{\"hb\":["));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"n\":\"onewire_conv\",\"b\":1500,\"max\":2000,\"ovr\":1}"));
+    TEST_ASSERT_NULL(strstr(json.c_str(), "\"prev\""));  // Cold boot
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_wdt_supervisor_registration_is_idempotent);
+    RUN_TEST(test_wdt_supervisor_counts_phase_overruns);
+    RUN_TEST(test_wdt_supervisor_live_overrun_detection);
+    RUN_TEST(test_wdt_supervisor_attributes_stalled_nested_phase_after_reset);
+    RUN_TEST(test_wdt_supervisor_prefers_phase_furthest_past_budget);
+    RUN_TEST(test_wdt_supervisor_completed_phases_are_not_attributed);
+    RUN_TEST(test_wdt_supervisor_missing_inner_end_pops_to_outer);
+    RUN_TEST(test_wdt_supervisor_cold_boot_discards_record);
+    RUN_TEST(test_wdt_supervisor_phase_scope_and_json);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,218 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "services/actuator/actuator_command_decoder.h"
+
+// ============================================
+// Actuator command decode: POD record (Core 0, once) vs. the former path
+// (String copies in the router + queue, String re-parse on Core 1).
+// Benchmark reports parse-to-actuate latency and heap allocations/command.
+// ============================================
+
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+static const char* TOPIC = "kaiser/god/esp/ESP_12AB34CD/actuator/25/command";
+static const char* PAYLOAD =
+    "{\"command\":\"ON\",\"value\":1.0,\"duration\":120,"
+    "\"correlation_id\":\"7f3c2a10-5d4e-4b8a-9c21-0e6f1d2b3a4c\","
+    "\"issued_by\":\"logic_engine:rule_42\",\"intent_id\":\"it-981\"}";
+
+// ============================================
+// LEGACY PATH (mirrors routeIncomingMessage → queue → handleActuatorCommand)
+// ============================================
+struct LegacyCommand {
+    uint8_t gpio;
+    std::string command;
+    float value;
+    uint32_t duration_s;
+    std::string correlation_id;
+    std::string issued_by;
+};
+
+static std::string legacyExtract(const std::string& json, const std::string& key) {
+    std::string pattern = "\"" + key + "\":";
+    size_t pos = json.find(pattern);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += pattern.length();
+    if (json[pos] == '"') {
+        size_t end = json.find('"', pos + 1);
+        return json.substr(pos + 1, end - pos - 1);
+    }
+    size_t end = json.find_first_of(",}", pos);
+    return json.substr(pos, end - pos);
+}
+
+static LegacyCommand legacyDecode(const char* t, const char* p) {
+    // Router: String(t), String(p); Core 1: String(cmd.topic), String(cmd.payload)
+    std::string router_topic(t);
+    std::string router_payload(p);
+    std::string topic(router_topic.c_str());
+    std::string payload(router_payload.c_str());
+
+    LegacyCommand cmd;
+    size_t idx = topic.find("/actuator/") + 10;
+    std::string gpio_str = topic.substr(idx, topic.find('/', idx) - idx);
+    cmd.gpio = static_cast<uint8_t>(atoi(gpio_str.c_str()));
+    cmd.command = legacyExtract(payload, "command");
+    cmd.value = strtof(legacyExtract(payload, "value").c_str(), nullptr);
+    cmd.duration_s = static_cast<uint32_t>(strtoul(legacyExtract(payload, "duration").c_str(), nullptr, 10));
+    cmd.correlation_id = legacyExtract(payload, "correlation_id");
+    cmd.issued_by = legacyExtract(payload, "issued_by");
+    return cmd;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// ============================================
+// DECODER CORRECTNESS
+// ============================================
+void test_decoder_extracts_all_fields() {
+    ActuatorCommandRecord record;
+    TEST_ASSERT_TRUE(decodeActuatorCommand(TOPIC, PAYLOAD, record));
+    TEST_ASSERT_EQUAL_UINT8(25, record.gpio);
+    TEST_ASSERT_EQUAL(ActuatorOpcode::ON, record.opcode);
+    TEST_ASSERT_EQUAL_STRING("ON", record.command);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, record.value);
+    TEST_ASSERT_EQUAL_UINT32(120, record.duration_s);
+    TEST_ASSERT_EQUAL_STRING("7f3c2a10-5d4e-4b8a-9c21-0e6f1d2b3a4c", record.correlation_id);
+    TEST_ASSERT_EQUAL_STRING("logic_engine:rule_42", record.issued_by);
+    TEST_ASSERT_FALSE(record.recovery_intent);
+}
+
+void test_decoder_opcodes_case_insensitive_and_unknown_echoed() {
+    TEST_ASSERT_EQUAL(ActuatorOpcode::PWM, parseActuatorOpcode("pwm"));
+    TEST_ASSERT_EQUAL(ActuatorOpcode::TOGGLE, parseActuatorOpcode("Toggle"));
+    TEST_ASSERT_EQUAL(ActuatorOpcode::OFF, parseActuatorOpcode("off"));
+
+    ActuatorCommandRecord record;
+    decodeActuatorCommand(TOPIC, "{\"command\":\"BLINK\"}", record);
+    TEST_ASSERT_EQUAL(ActuatorOpcode::UNKNOWN, record.opcode);
+    TEST_ASSERT_EQUAL_STRING("BLINK", record.command);  // For "Unknown command: BLINK"
+}
+
+void test_decoder_defaults_match_legacy_helpers() {
+    ActuatorCommandRecord record;
+    decodeActuatorCommand(TOPIC, "{\"command\":\"OFF\"}", record);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, record.value);
+    TEST_ASSERT_EQUAL_UINT32(0, record.duration_s);
+    TEST_ASSERT_EQUAL_STRING("", record.correlation_id);
+    TEST_ASSERT_EQUAL_STRING("system:unknown", record.issued_by);
+
+    // Quoted numbers and a space after the colon were accepted before
+    decodeActuatorCommand(TOPIC, "{\"command\": \"PWM\",\"value\":\"0.25\",\"duration\": 30 }", record);
+    TEST_ASSERT_EQUAL(ActuatorOpcode::PWM, record.opcode);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, record.value);
+    TEST_ASSERT_EQUAL_UINT32(30, record.duration_s);
+}
+
+void test_decoder_key_must_match_exactly() {
+    ActuatorCommandRecord record;
+    // "pre_value" must not satisfy "value"
+    decodeActuatorCommand(TOPIC, "{\"pre_value\":0.9,\"command\":\"PWM\",\"value\":0.4}", record);
+    TEST_ASSERT_EQUAL_FLOAT(0.4f, record.value);
+}
+
+void test_decoder_invalid_topic_and_truncation() {
+    ActuatorCommandRecord record;
+    TEST_ASSERT_FALSE(decodeActuatorCommand("kaiser/god/esp/X/actuator/command", PAYLOAD, record));
+    TEST_ASSERT_EQUAL_UINT8(ACTUATOR_CMD_INVALID_GPIO, record.gpio);
+
+    decodeActuatorCommand(TOPIC, "{\"command\":\"ON\",\"issued_by\":\"user:a_very_long_operator_name_beyond_limit\"}", record);
+    TEST_ASSERT_EQUAL_size_t(ACTUATOR_ISSUED_BY_LEN - 1, strlen(record.issued_by));
+}
+
+// ============================================
+// BENCHMARK
+// ============================================
+void test_decoder_benchmark_latency_and_allocations() {
+    const int ITERATIONS = 20000;
+    using Clock = std::chrono::steady_clock;
+
+    volatile uint32_t sink = 0;
+    size_t alloc_start = g_allocations;
+    Clock::time_point t0 = Clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        LegacyCommand cmd = legacyDecode(TOPIC, PAYLOAD);
+        sink = sink + cmd.gpio + cmd.duration_s;
+    }
+    Clock::time_point t1 = Clock::now();
+    double legacy_allocs = static_cast<double>(g_allocations - alloc_start) / ITERATIONS;
+
+    alloc_start = g_allocations;
+    Clock::time_point t2 = Clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ActuatorCommandRecord record;
+        decodeActuatorCommand(TOPIC, PAYLOAD, record);  // Core 0, once
+        sink = sink + record.gpio + record.duration_s;  // Core 1 reads the record as-is
+    }
+    Clock::time_point t3 = Clock::now();
+    double record_allocs = static_cast<double>(g_allocations - alloc_start) / ITERATIONS;
+
+    double legacy_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / ITERATIONS;
+    double record_ns = std::chrono::duration<double, std::nano>(t3 - t2).count() / ITERATIONS;
+    char msg[160];
+    snprintf(msg, sizeof(msg),
+             "parse-to-actuate: legacy %.0f ns, %.1f allocs/cmd | record %.0f ns, %.1f allocs/cmd (%u B)",
+             legacy_ns, legacy_allocs, record_ns, record_allocs,
+             static_cast<unsigned>(sizeof(ActuatorCommandRecord)));
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, static_cast<float>(record_allocs));
+    TEST_ASSERT_TRUE(legacy_allocs >= 6.0);
+    // Queue item shrinks from topic[128] + payload[512] + metadata
+    TEST_ASSERT_TRUE(sizeof(ActuatorCommandRecord) < 128 + 512);
+    (void)sink;
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_decoder_extracts_all_fields);
+    RUN_TEST(test_decoder_opcodes_case_insensitive_and_unknown_echoed);
+    RUN_TEST(test_decoder_defaults_match_legacy_helpers);
+    RUN_TEST(test_decoder_key_must_match_exactly);
+    RUN_TEST(test_decoder_invalid_topic_and_truncation);
+    RUN_TEST(test_decoder_benchmark_latency_and_allocations);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
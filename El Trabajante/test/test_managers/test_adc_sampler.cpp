@@ -0,0 +1,314 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "drivers/adc_sampler.h"
+#include "../mocks/mock_adc_sampler_hal.h"
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+static MockAdcSamplerHal hal;
+
+static const uint8_t PIN_PH = 34;
+static const uint8_t PIN_EC = 35;
+static const uint16_t WINDOW = 64;
+
+void setUp(void) {
+    adcSampler.reset();
+    hal.reset();
+    AdcSamplerConfig config;
+    config.window_samples = WINDOW;
+    TEST_ASSERT_TRUE(adcSampler.begin(&hal, config));
+}
+
+void tearDown(void) {
+    adcSampler.reset();
+}
+
+// Drains everything queued in the mock (several HAL batches)
+static void pumpAll(uint32_t now_ms) {
+    adcSampler.pump(now_ms, 0);
+    while (hal.pending() > 0) {
+        adcSampler.pump(now_ms, 0);
+    }
+}
+
+// Reference statistics computed independently (two-pass)
+static void referenceStats(const std::vector<uint16_t>& samples, double& mean, double& variance) {
+    double sum = 0.0;
+    for (uint16_t value : samples) sum += value;
+    mean = sum / samples.size();
+    double squares = 0.0;
+    for (uint16_t value : samples) squares += (value - mean) * (value - mean);
+    variance = squares / (samples.size() - 1);
+}
+
+// Deterministic noise around a level (LCG, no std::rand state between tests)
+static std::vector<uint16_t> noisyStream(uint16_t level, uint16_t amplitude, size_t count, uint32_t seed) {
+    std::vector<uint16_t> samples;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int offset = static_cast<int>((seed >> 16) % (2 * amplitude + 1)) - amplitude;
+        samples.push_back(static_cast<uint16_t>(level + offset));
+    }
+    return samples;
+}
+
+// ============================================
+// WINDOW STATISTICS
+// ============================================
+
+void test_adc_accumulator_constant_stream_has_zero_variance() {
+    AdcWindowAccumulator accumulator;
+    for (uint16_t i = 0; i < 9; i++) {
+        TEST_ASSERT_FALSE(accumulator.add(2048, 10));
+    }
+    TEST_ASSERT_TRUE(accumulator.add(2048, 10));
+
+    AdcWindowStats stats;
+    accumulator.finish(PIN_PH, 1, 500, stats);
+    TEST_ASSERT_EQUAL_UINT16(10, stats.count);
+    TEST_ASSERT_EQUAL_UINT16(2048, stats.mean_raw);
+    TEST_ASSERT_EQUAL_UINT16(2048, stats.min);
+    TEST_ASSERT_EQUAL_UINT16(2048, stats.max);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, stats.variance);
+}
+
+void test_adc_accumulator_matches_two_pass_reference() {
+    std::vector<uint16_t> samples = noisyStream(1800, 40, 1000, 7);
+    AdcWindowAccumulator accumulator;
+    for (uint16_t value : samples) {
+        accumulator.add(value, 1000);
+    }
+    AdcWindowStats stats;
+    accumulator.finish(PIN_PH, 1, 0, stats);
+
+    double mean = 0.0;
+    double variance = 0.0;
+    referenceStats(samples, mean, variance);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, (float)mean, stats.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, (float)variance, stats.variance);
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)std::lround(mean), stats.mean_raw);
+    TEST_ASSERT_TRUE(stats.min >= 1760 && stats.max <= 1840);
+}
+
+void test_adc_accumulator_full_scale_window_does_not_overflow() {
+    AdcWindowAccumulator accumulator;
+    for (uint32_t i = 0; i < 65535; i++) {
+        accumulator.add((i & 1) ? 4095 : 0, 65535);
+    }
+    AdcWindowStats stats;
+    accumulator.finish(PIN_PH, 1, 0, stats);
+    TEST_ASSERT_EQUAL_UINT16(65535, stats.count);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.min);
+    TEST_ASSERT_EQUAL_UINT16(4095, stats.max);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 2047.47f, stats.mean);
+    // Alternating rails, exact: 4095² · 32767 · 32768 / (65535 · 65534)
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 4192320.22f, stats.variance);
+}
+
+// ============================================
+// SAMPLER: CHANNELS + WINDOWS
+// ============================================
+
+void test_adc_add_channel_restarts_scan_with_all_pins() {
+    TEST_ASSERT_TRUE(adcSampler.addChannel(PIN_PH));
+    TEST_ASSERT_TRUE(adcSampler.addChannel(PIN_EC));
+    TEST_ASSERT_TRUE(adcSampler.addChannel(PIN_EC));  // Idempotent
+    TEST_ASSERT_EQUAL_UINT8(2, adcSampler.getChannelCount());
+    TEST_ASSERT_EQUAL_UINT32(7, adcSampler.getWindowMs());  // 2 · 64 samples @ 20 kHz = 6.4 ms
+
+    adcSampler.pump(0, 0);
+    TEST_ASSERT_TRUE(hal.running);
+    TEST_ASSERT_EQUAL_INT(1, hal.start_count);        // One restart for both changes
+    TEST_ASSERT_EQUAL_UINT32(2, hal.scan.size());
+    TEST_ASSERT_EQUAL_UINT32(ADC_SAMPLER_SAMPLE_RATE_HZ, hal.last_rate_hz);
+}
+
+void test_adc_rejects_pins_without_continuous_channel() {
+    TEST_ASSERT_FALSE(adcSampler.addChannel(25));     // ADC2 — stays on analogRead()
+    TEST_ASSERT_FALSE(adcSampler.supportsPin(25));
+    TEST_ASSERT_EQUAL_UINT8(0, adcSampler.getChannelCount());
+}
+
+void test_adc_no_window_before_first_full_window() {
+    adcSampler.addChannel(PIN_PH);
+    adcSampler.pump(0, 0);
+    for (uint16_t i = 0; i < WINDOW - 1; i++) {
+        hal.feed(PIN_PH, 1000);
+    }
+    pumpAll(100);
+
+    AdcWindowStats stats;
+    TEST_ASSERT_FALSE(adcSampler.getLatest(PIN_PH, stats, 100));
+    hal.feed(PIN_PH, 1000);
+    pumpAll(120);
+    TEST_ASSERT_TRUE(adcSampler.getLatest(PIN_PH, stats, 120));
+    TEST_ASSERT_EQUAL_UINT16(WINDOW, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.window_seq);
+    TEST_ASSERT_EQUAL_UINT32(120, stats.end_ms);
+}
+
+void test_adc_interleaved_channels_have_independent_stats() {
+    adcSampler.addChannel(PIN_PH);
+    adcSampler.addChannel(PIN_EC);
+    adcSampler.pump(0, 0);
+
+    std::vector<uint16_t> ph = noisyStream(1200, 15, WINDOW, 1);
+    std::vector<uint16_t> ec = noisyStream(3000, 60, WINDOW, 2);
+    hal.feedInterleaved({PIN_PH, PIN_EC}, {ph, ec});
+    pumpAll(200);
+
+    AdcWindowStats ph_stats;
+    AdcWindowStats ec_stats;
+    TEST_ASSERT_TRUE(adcSampler.getLatest(PIN_PH, ph_stats, 200));
+    TEST_ASSERT_TRUE(adcSampler.getLatest(PIN_EC, ec_stats, 200));
+
+    double mean = 0.0;
+    double variance = 0.0;
+    referenceStats(ph, mean, variance);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, (float)mean, ph_stats.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, (float)variance, ph_stats.variance);
+    referenceStats(ec, mean, variance);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, (float)mean, ec_stats.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, (float)variance, ec_stats.variance);
+    TEST_ASSERT_TRUE(ec_stats.variance > ph_stats.variance);
+}
+
+void test_adc_window_rollover_publishes_latest_window_only() {
+    adcSampler.addChannel(PIN_PH);
+    adcSampler.pump(0, 0);
+    for (uint16_t i = 0; i < WINDOW; i++) hal.feed(PIN_PH, 500);
+    pumpAll(100);
+    for (uint16_t i = 0; i < WINDOW; i++) hal.feed(PIN_PH, 3500);
+    for (uint16_t i = 0; i < WINDOW / 2; i++) hal.feed(PIN_PH, 10);  // Partial third window
+    pumpAll(200);
+
+    AdcWindowStats stats;
+    TEST_ASSERT_TRUE(adcSampler.getLatest(PIN_PH, stats, 200));
+    TEST_ASSERT_EQUAL_UINT32(2, stats.window_seq);
+    TEST_ASSERT_EQUAL_UINT16(3500, stats.mean_raw);   // No mixing across windows
+    TEST_ASSERT_EQUAL_UINT16(3500, stats.min);
+}
+
+void test_adc_stale_window_rejected() {
+    adcSampler.addChannel(PIN_PH);
+    adcSampler.pump(0, 0);
+    for (uint16_t i = 0; i < WINDOW; i++) hal.feed(PIN_PH, 2000);
+    pumpAll(1000);
+
+    AdcWindowStats stats;
+    TEST_ASSERT_TRUE(adcSampler.getLatest(PIN_PH, stats, 1000 + ADC_SAMPLER_MAX_WINDOW_AGE_MS));
+    TEST_ASSERT_FALSE(adcSampler.getLatest(PIN_PH, stats, 1001 + ADC_SAMPLER_MAX_WINDOW_AGE_MS));
+}
+
+void test_adc_remove_channel_discards_windows_and_drops_stale_samples() {
+    adcSampler.addChannel(PIN_PH);
+    adcSampler.addChannel(PIN_EC);
+    adcSampler.pump(0, 0);
+    for (uint16_t i = 0; i < WINDOW; i++) {
+        hal.feed(PIN_PH, 1500);
+        hal.feed(PIN_EC, 2500);
+    }
+    pumpAll(100);
+
+    adcSampler.removeChannel(PIN_EC);
+    TEST_ASSERT_FALSE(adcSampler.hasChannel(PIN_EC));
+    hal.feed(PIN_EC, 2500);                               // Frame still in the DMA ring
+    pumpAll(150);
+
+    AdcWindowStats stats;
+    TEST_ASSERT_FALSE(adcSampler.getLatest(PIN_EC, stats, 150));
+    TEST_ASSERT_FALSE(adcSampler.getLatest(PIN_PH, stats, 150));  // New scan → new windows
+    TEST_ASSERT_EQUAL_UINT32(1, hal.scan.size());
+    TEST_ASSERT_EQUAL_UINT32(1, adcSampler.getDroppedSamples());
+}
+
+void test_adc_failed_start_releases_pins_to_analog_read() {
+    adcSampler.addChannel(PIN_PH);
+    hal.start_result = false;
+    adcSampler.pump(0, 0);
+    TEST_ASSERT_FALSE(adcSampler.isActive());
+    TEST_ASSERT_EQUAL_UINT32(1, adcSampler.getRestartFailures());
+
+    hal.start_result = true;
+    adcSampler.addChannel(PIN_EC);                        // Next change retries the scan
+    adcSampler.pump(10, 0);
+    TEST_ASSERT_TRUE(adcSampler.isActive());
+    TEST_ASSERT_TRUE(hal.running);
+}
+
+// ============================================
+// LOCK-FREE PUBLISH
+// ============================================
+
+// Every window of the writer is constant (value = window index), so a torn
+// read shows up as min != max or mean_raw not matching the window sequence.
+void test_adc_concurrent_reader_never_sees_torn_window() {
+    AdcSamplerConfig config;
+    config.window_samples = 4;
+    config.max_window_age_ms = UINT32_MAX;    // Reader has no clock
+    adcSampler.reset();
+    TEST_ASSERT_TRUE(adcSampler.begin(&hal, config));
+    adcSampler.addChannel(PIN_PH);
+    adcSampler.pump(0, 0);
+
+    const uint32_t WINDOWS = 20000;
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (uint32_t w = 1; w <= WINDOWS; w++) {
+            for (int i = 0; i < 4; i++) hal.feed(PIN_PH, static_cast<uint16_t>(w % 4096));
+            adcSampler.pump(w, 0);
+        }
+        done = true;
+    });
+
+    uint32_t torn = 0;
+    uint32_t reads = 0;
+    uint32_t last_seq = 0;
+    bool monotonic = true;
+    while (!done) {
+        AdcWindowStats stats;
+        if (adcSampler.getLatest(PIN_PH, stats, 0)) {
+            reads++;
+            if (stats.min != stats.max || stats.mean_raw != (stats.window_seq % 4096) ||
+                stats.end_ms != stats.window_seq) {
+                torn++;
+            }
+            if (stats.window_seq < last_seq) monotonic = false;
+            last_seq = stats.window_seq;
+        }
+    }
+    writer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_TRUE(monotonic);
+    TEST_ASSERT_TRUE(reads > 0);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_adc_accumulator_constant_stream_has_zero_variance);
+    RUN_TEST(test_adc_accumulator_matches_two_pass_reference);
+    RUN_TEST(test_adc_accumulator_full_scale_window_does_not_overflow);
+    RUN_TEST(test_adc_add_channel_restarts_scan_with_all_pins);
+    RUN_TEST(test_adc_rejects_pins_without_continuous_channel);
+    RUN_TEST(test_adc_no_window_before_first_full_window);
+    RUN_TEST(test_adc_interleaved_channels_have_independent_stats);
+    RUN_TEST(test_adc_window_rollover_publishes_latest_window_only);
+    RUN_TEST(test_adc_stale_window_rejected);
+    RUN_TEST(test_adc_remove_channel_discards_windows_and_drops_stale_samples);
+    RUN_TEST(test_adc_failed_start_releases_pins_to_analog_read);
+    RUN_TEST(test_adc_concurrent_reader_never_sees_torn_window);
+    return UNITY_END();
+}
+#endif
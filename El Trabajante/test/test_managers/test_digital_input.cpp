@@ -0,0 +1,190 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "../mocks/mock_gpio_hal.h"
+#include "../helpers/gpio_manager_test_helper.h"
+#include "../../src/drivers/gpio_manager.h"
+#include "../../src/drivers/digital_input.h"
+
+// ============================================
+// TEST FIXTURES
+// ============================================
+MockGPIOHal gpio_mock;
+
+static const uint8_t FLOAT_GPIO = 25;  // Float switch to GND, pull-up → dry = HIGH
+static const uint8_t DOOR_GPIO = 26;
+
+static uint32_t wake_calls = 0;
+static void countWake() { wake_calls++; }
+
+void setUp(void) {
+    gpio_mock.reset();
+    GPIOManager& mgr = GPIOManager::getInstance();
+    GPIOManagerTestHelper::reset(mgr);
+    GPIOManagerTestHelper::injectHAL(mgr, &gpio_mock);
+    mgr.initializeAllPinsToSafeMode();
+
+    digitalInputs.reset();
+    wake_calls = 0;
+    TEST_ASSERT_TRUE(mgr.requestPin(FLOAT_GPIO, "sensor", "float_switch"));
+    TEST_ASSERT_TRUE(mgr.requestPin(DOOR_GPIO, "sensor", "door_contact"));
+}
+
+void tearDown(void) {
+    digitalInputs.reset();
+    GPIOManagerTestHelper::reset(GPIOManager::getInstance());
+}
+
+// ============================================
+// OWNERSHIP
+// ============================================
+
+void test_digital_input_requires_pin_ownership() {
+    TEST_ASSERT_FALSE(digitalInputs.attach(27, 50));  // Not requested
+    TEST_ASSERT_FALSE(gpio_mock.hasEdgeInterrupt(27));
+
+    TEST_ASSERT_TRUE(digitalInputs.attach(FLOAT_GPIO, 50));
+    TEST_ASSERT_TRUE(gpio_mock.hasEdgeInterrupt(FLOAT_GPIO));
+    TEST_ASSERT_EQUAL_UINT8(1, digitalInputs.getAttachedCount());
+
+    bool level = false;
+    TEST_ASSERT_TRUE(digitalInputs.getState(FLOAT_GPIO, level));
+    TEST_ASSERT_TRUE(level);  // Pull-up idle level
+}
+
+void test_digital_input_release_pin_disarms_interrupt() {
+    digitalInputs.attach(FLOAT_GPIO, 50);
+    digitalInputs.detach(FLOAT_GPIO);
+    TEST_ASSERT_FALSE(gpio_mock.hasEdgeInterrupt(FLOAT_GPIO));
+    TEST_ASSERT_EQUAL_UINT8(0, digitalInputs.getAttachedCount());
+
+    // releasePin without detach: interrupt follows ownership
+    digitalInputs.attach(DOOR_GPIO, 50);
+    GPIOManager::getInstance().releasePin(DOOR_GPIO);
+    TEST_ASSERT_FALSE(gpio_mock.hasEdgeInterrupt(DOOR_GPIO));
+}
+
+// ============================================
+// DEBOUNCE
+// ============================================
+
+void test_digital_input_clean_edge_after_debounce() {
+    digitalInputs.setWakeHook(countWake);
+    digitalInputs.attach(FLOAT_GPIO, 50);
+    gpio_mock.triggerEdge(FLOAT_GPIO, false, 1000000);
+    TEST_ASSERT_EQUAL_UINT32(1, wake_calls);
+
+    DigitalInputEvent events[4];
+    TEST_ASSERT_EQUAL_UINT8(0, digitalInputs.poll(1040, 1040000, events, 4));  // 40 ms: settling
+    TEST_ASSERT_EQUAL_UINT32(10, digitalInputs.getMsUntilSettled(1040000));
+
+    TEST_ASSERT_EQUAL_UINT8(1, digitalInputs.poll(1050, 1050000, events, 4));
+    TEST_ASSERT_EQUAL_UINT8(FLOAT_GPIO, events[0].gpio);
+    TEST_ASSERT_FALSE(events[0].level);
+    TEST_ASSERT_EQUAL_UINT32(1000, events[0].edge_ms);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, digitalInputs.getMsUntilSettled(1050000));
+
+    bool level = true;
+    digitalInputs.getState(FLOAT_GPIO, level);
+    TEST_ASSERT_FALSE(level);
+}
+
+void test_digital_input_bounce_burst_reports_first_edge() {
+    digitalInputs.attach(FLOAT_GPIO, 50);
+    gpio_mock.triggerEdge(FLOAT_GPIO, false, 1000000);
+    gpio_mock.triggerEdge(FLOAT_GPIO, true, 1002000);
+    gpio_mock.triggerEdge(FLOAT_GPIO, false, 1003000);
+    gpio_mock.triggerEdge(FLOAT_GPIO, true, 1005000);
+    gpio_mock.triggerEdge(FLOAT_GPIO, false, 1008000);
+
+    DigitalInputEvent events[4];
+    TEST_ASSERT_EQUAL_UINT8(0, digitalInputs.poll(1050, 1050000, events, 4));  // 42 ms since last bounce
+    TEST_ASSERT_EQUAL_UINT8(1, digitalInputs.poll(1058, 1058000, events, 4));
+    TEST_ASSERT_FALSE(events[0].level);
+    TEST_ASSERT_EQUAL_UINT32(1000, events[0].edge_ms);
+    TEST_ASSERT_EQUAL_UINT8(0, digitalInputs.poll(2000, 2000000, events, 4));  // Exactly one event
+}
+
+void test_digital_input_glitch_is_suppressed() {
+    digitalInputs.attach(FLOAT_GPIO, 50);
+    gpio_mock.triggerEdge(FLOAT_GPIO, false, 1000000);
+    gpio_mock.triggerEdge(FLOAT_GPIO, true, 1010000);  // 10 ms spike
+
+    DigitalInputEvent events[4];
+    TEST_ASSERT_EQUAL_UINT8(0, digitalInputs.poll(1200, 1200000, events, 4));
+    bool level = false;
+    digitalInputs.getState(FLOAT_GPIO, level);
+    TEST_ASSERT_TRUE(level);
+}
+
+void test_digital_input_channels_are_independent() {
+    digitalInputs.attach(FLOAT_GPIO, 50);
+    digitalInputs.attach(DOOR_GPIO, 200);
+    gpio_mock.triggerEdge(FLOAT_GPIO, false, 1000000);
+    gpio_mock.triggerEdge(DOOR_GPIO, false, 1000000);
+
+    DigitalInputEvent events[4];
+    TEST_ASSERT_EQUAL_UINT8(1, digitalInputs.poll(1100, 1100000, events, 4));
+    TEST_ASSERT_EQUAL_UINT8(FLOAT_GPIO, events[0].gpio);
+    TEST_ASSERT_EQUAL_UINT32(100, digitalInputs.getMsUntilSettled(1100000));
+    TEST_ASSERT_EQUAL_UINT8(1, digitalInputs.poll(1200, 1200000, events, 4));
+    TEST_ASSERT_EQUAL_UINT8(DOOR_GPIO, events[0].gpio);
+}
+
+// ============================================
+// QUEUE OVERFLOW
+// ============================================
+
+void test_digital_input_overflow_resyncs_from_pin_level() {
+    digitalInputs.attach(FLOAT_GPIO, 50);
+    // 40 edges without a poll: ring holds 31, the rest is dropped
+    uint32_t t = 1000000;
+    for (uint8_t i = 0; i < 40; i++) {
+        gpio_mock.triggerEdge(FLOAT_GPIO, (i % 2) == 1, t);
+        t += 100;
+    }
+    TEST_ASSERT_EQUAL_UINT32(40 - (DIGITAL_INPUT_QUEUE_SIZE - 1), digitalInputs.getDroppedEdges());
+    gpio_mock.setPinLevel(FLOAT_GPIO, false);  // Real level after the lost edges
+    TEST_ASSERT_EQUAL_UINT32(0, digitalInputs.getMsUntilSettled(t));
+
+    DigitalInputEvent events[4];
+    TEST_ASSERT_EQUAL_UINT8(0, digitalInputs.poll(1010, 1010000, events, 4));
+    TEST_ASSERT_EQUAL_UINT8(1, digitalInputs.poll(1060, 1060000, events, 4));
+    TEST_ASSERT_FALSE(events[0].level);
+    TEST_ASSERT_EQUAL_UINT32(1000, events[0].edge_ms);
+}
+
+void test_digital_input_detached_edges_are_ignored() {
+    digitalInputs.attach(FLOAT_GPIO, 50);
+    gpio_mock.triggerEdge(FLOAT_GPIO, false, 1000000);
+    digitalInputs.detach(FLOAT_GPIO);
+    gpio_mock.triggerEdge(FLOAT_GPIO, true, 1001000);  // Interrupt disarmed
+
+    DigitalInputEvent events[4];
+    TEST_ASSERT_EQUAL_UINT8(0, digitalInputs.poll(2000, 2000000, events, 4));
+    bool level = false;
+    TEST_ASSERT_FALSE(digitalInputs.getState(FLOAT_GPIO, level));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_digital_input_requires_pin_ownership);
+    RUN_TEST(test_digital_input_release_pin_disarms_interrupt);
+    RUN_TEST(test_digital_input_clean_edge_after_debounce);
+    RUN_TEST(test_digital_input_bounce_burst_reports_first_edge);
+    RUN_TEST(test_digital_input_glitch_is_suppressed);
+    RUN_TEST(test_digital_input_channels_are_independent);
+    RUN_TEST(test_digital_input_overflow_resyncs_from_pin_level);
+    RUN_TEST(test_digital_input_detached_edges_are_ignored);
+    return UNITY_END();
+}
+#endif
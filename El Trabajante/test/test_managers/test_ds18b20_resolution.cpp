@@ -0,0 +1,189 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "drivers/onewire_protocol.h"
+#include "../mocks/mock_onewire_bus.h"
+
+// ============================================
+// DS18B20 RESOLUTION (scratchpad config + conversion timing)
+// ============================================
+
+static SimOneWireBus bus;
+static MockOneWireHal hal(bus);
+
+static uint8_t rom_a[8] = {0x28, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x00};
+static uint8_t rom_b[8] = {0x28, 0x77, 0x22, 0x33, 0x44, 0x55, 0x66, 0x00};
+
+// One measurement as OneWireBusManager::readRawTemperature() performs it
+static bool measure(const uint8_t rom[8], uint8_t resolution_bits, int16_t& raw) {
+    if (OneWireProtocol::startConversion(hal, rom, false) != OneWireStatus::OK) {
+        return false;
+    }
+    hal.delayMs(OneWireProtocol::conversionTimeMs(resolution_bits));
+    uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+    if (OneWireProtocol::readScratchpad(hal, rom, scratchpad) != OneWireStatus::OK) {
+        return false;
+    }
+    raw = OneWireProtocol::maskRawTemperature(
+        static_cast<int16_t>((scratchpad[1] << 8) | scratchpad[0]), resolution_bits);
+    return true;
+}
+
+void setUp(void) {
+    bus.clear();
+    hal.total_delay_ms = 0;
+    rom_a[7] = OneWireProtocol::crc8(rom_a, 7);
+    rom_b[7] = OneWireProtocol::crc8(rom_b, 7);
+    bus.devices.push_back(SimDs18b20(rom_a, 0x0191));   // +25.0625 °C
+    bus.devices.push_back(SimDs18b20(rom_b, -163));     // -10.1875 °C
+}
+
+void tearDown(void) {}
+
+void test_config_register_encoding() {
+    TEST_ASSERT_EQUAL_HEX8(0x1F, OneWireProtocol::resolutionToConfig(9));
+    TEST_ASSERT_EQUAL_HEX8(0x3F, OneWireProtocol::resolutionToConfig(10));
+    TEST_ASSERT_EQUAL_HEX8(0x5F, OneWireProtocol::resolutionToConfig(11));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, OneWireProtocol::resolutionToConfig(12));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, OneWireProtocol::resolutionToConfig(8));    // Invalid → default
+    for (uint8_t bits = 9; bits <= 12; bits++) {
+        TEST_ASSERT_EQUAL(bits, OneWireProtocol::configToResolution(OneWireProtocol::resolutionToConfig(bits)));
+    }
+    TEST_ASSERT_FALSE(OneWireProtocol::isValidResolution(13));
+    uint8_t ds18s20[8] = {0x10, 0, 0, 0, 0, 0, 0, 0};
+    TEST_ASSERT_FALSE(OneWireProtocol::hasResolutionConfig(ds18s20));
+    TEST_ASSERT_TRUE(OneWireProtocol::hasResolutionConfig(rom_a));
+}
+
+void test_conversion_time_per_resolution() {
+    TEST_ASSERT_EQUAL(94, OneWireProtocol::conversionTimeMs(9));
+    TEST_ASSERT_EQUAL(188, OneWireProtocol::conversionTimeMs(10));
+    TEST_ASSERT_EQUAL(375, OneWireProtocol::conversionTimeMs(11));
+    TEST_ASSERT_EQUAL(750, OneWireProtocol::conversionTimeMs(12));
+    TEST_ASSERT_EQUAL(750, OneWireProtocol::conversionTimeMs(0));
+}
+
+void test_raw_masking_keeps_sixteenth_units() {
+    // +25.0625 °C = 0x0191: 9 bit → 25.0 (0x0190), 12 bit unchanged
+    TEST_ASSERT_EQUAL_INT16(0x0190, OneWireProtocol::maskRawTemperature(0x0191, 9));
+    TEST_ASSERT_EQUAL_INT16(0x0190, OneWireProtocol::maskRawTemperature(0x0191, 10));
+    TEST_ASSERT_EQUAL_INT16(0x0191, OneWireProtocol::maskRawTemperature(0x0191, 12));
+    // Negative: two's complement, rounds towards -inf like the device
+    TEST_ASSERT_EQUAL_INT16(-164, OneWireProtocol::maskRawTemperature(-163, 10));
+    TEST_ASSERT_EQUAL_INT16(-168, OneWireProtocol::maskRawTemperature(-163, 9));
+    // Fault / power-on values survive masking at every resolution
+    TEST_ASSERT_EQUAL_INT16(-2032, OneWireProtocol::maskRawTemperature(-2032, 9));
+    TEST_ASSERT_EQUAL_INT16(1360, OneWireProtocol::maskRawTemperature(1360, 9));
+}
+
+void test_configure_writes_scratchpad_and_eeprom_once() {
+    bool written = false;
+    TEST_ASSERT_EQUAL(OneWireStatus::OK,
+                      OneWireProtocol::configureResolution(hal, rom_a, 10, false, written));
+    TEST_ASSERT_TRUE(written);
+    TEST_ASSERT_EQUAL(1, bus.devices[0].eeprom_writes);
+    TEST_ASSERT_EQUAL_HEX8(0x3F, bus.devices[0].scratchpad[4]);
+    TEST_ASSERT_EQUAL_HEX8(0x3F, bus.devices[0].eeprom[2]);
+    // TH/TL untouched
+    TEST_ASSERT_EQUAL_HEX8(0x4B, bus.devices[0].eeprom[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x46, bus.devices[0].eeprom[1]);
+    // Other device on the bus not addressed
+    TEST_ASSERT_EQUAL(0, bus.devices[1].eeprom_writes);
+    TEST_ASSERT_EQUAL_HEX8(0x7F, bus.devices[1].scratchpad[4]);
+
+    // Second configure (e.g. reboot / config push) → no EEPROM wear
+    TEST_ASSERT_EQUAL(OneWireStatus::OK,
+                      OneWireProtocol::configureResolution(hal, rom_a, 10, false, written));
+    TEST_ASSERT_FALSE(written);
+    TEST_ASSERT_EQUAL(1, bus.devices[0].eeprom_writes);
+}
+
+void test_resolution_survives_power_cycle() {
+    bool written = false;
+    TEST_ASSERT_EQUAL(OneWireStatus::OK,
+                      OneWireProtocol::configureResolution(hal, rom_a, 9, true, written));
+    TEST_ASSERT_FALSE(bus.strong_pullup);          // Depowered after the EEPROM copy
+    bus.devices[0].powerCycle();
+    TEST_ASSERT_EQUAL(9, bus.devices[0].resolutionBits());
+
+    TEST_ASSERT_EQUAL(OneWireStatus::OK,
+                      OneWireProtocol::configureResolution(hal, rom_a, 9, true, written));
+    TEST_ASSERT_FALSE(written);
+    TEST_ASSERT_EQUAL(1, bus.devices[0].eeprom_writes);
+}
+
+void test_measurement_wait_and_scaling_follow_resolution() {
+    bool written = false;
+    OneWireProtocol::configureResolution(hal, rom_a, 9, false, written);
+    OneWireProtocol::configureResolution(hal, rom_b, 10, false, written);
+    hal.total_delay_ms = 0;
+
+    int16_t raw = 0;
+    TEST_ASSERT_TRUE(measure(rom_a, 9, raw));
+    TEST_ASSERT_EQUAL_INT16(0x0190, raw);          // 25.0 °C, undefined LSBs cleared
+    TEST_ASSERT_TRUE(measure(rom_b, 10, raw));
+    TEST_ASSERT_EQUAL_INT16(-164, raw);            // -10.25 °C
+    TEST_ASSERT_EQUAL(94 + 188, hal.total_delay_ms);
+
+    // Same two probes at the 12-bit default: 1500 ms per round
+    hal.total_delay_ms = 0;
+    TEST_ASSERT_TRUE(measure(rom_a, 12, raw));
+    TEST_ASSERT_TRUE(measure(rom_a, 12, raw));
+    TEST_ASSERT_EQUAL(1500, hal.total_delay_ms);
+}
+
+void test_configure_fails_without_device_or_on_crc_error() {
+    uint8_t missing[8] = {0x28, 0x99, 0, 0, 0, 0, 0, 0};
+    missing[7] = OneWireProtocol::crc8(missing, 7);
+    bool written = true;
+    // Other devices answer the reset, nobody answers MATCH ROM → all-1 scratchpad
+    TEST_ASSERT_EQUAL(OneWireStatus::CRC_ERROR,
+                      OneWireProtocol::configureResolution(hal, missing, 9, false, written));
+    TEST_ASSERT_FALSE(written);
+
+    bus.devices[0].corrupt_next_read = true;
+    TEST_ASSERT_EQUAL(OneWireStatus::CRC_ERROR,
+                      OneWireProtocol::configureResolution(hal, rom_a, 9, false, written));
+    TEST_ASSERT_FALSE(written);
+    TEST_ASSERT_EQUAL(0, bus.devices[0].eeprom_writes);
+    TEST_ASSERT_EQUAL_HEX8(0x7F, bus.devices[0].scratchpad[4]);
+
+    bus.devices.clear();
+    TEST_ASSERT_EQUAL(OneWireStatus::NO_PRESENCE,
+                      OneWireProtocol::configureResolution(hal, rom_a, 9, false, written));
+    TEST_ASSERT_FALSE(written);
+}
+
+// ============================================
+// MAIN
+// ============================================
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_config_register_encoding);
+    RUN_TEST(test_conversion_time_per_resolution);
+    RUN_TEST(test_raw_masking_keeps_sixteenth_units);
+    RUN_TEST(test_configure_writes_scratchpad_and_eeprom_once);
+    RUN_TEST(test_resolution_survives_power_cycle);
+    RUN_TEST(test_measurement_wait_and_scaling_follow_resolution);
+    RUN_TEST(test_configure_fails_without_device_or_on_crc_error);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,202 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "drivers/i2c_sensor_protocol.h"
+#include "models/sensor_registry.h"
+
+// Deterministic pseudo-random buffers (xorshift32)
+static uint32_t rng_state = 0x12345678;
+
+static uint8_t nextByte() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return static_cast<uint8_t>(rng_state & 0xFF);
+}
+
+// Reference: bit-by-bit CRC-8 (the pre-table implementation)
+static uint8_t referenceCRC8(const uint8_t* data, size_t len, uint8_t polynomial, uint8_t init) {
+    uint8_t crc = init;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ polynomial)
+                               : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static bool bindDevice(const char* device_type, uint8_t address, I2CSensorBinding& binding) {
+    const char* names[I2C_BINDING_MAX_VALUES] = {nullptr};
+    uint8_t count = getMultiValueTypeNames(device_type, names, I2C_BINDING_MAX_VALUES);
+    return resolveI2CSensorBinding(device_type, names, count, address, binding);
+}
+
+// Bound extraction must match extractRawValue() (string lookup) for every value
+static void assertMatchesStringExtraction(const char* device_type) {
+    I2CSensorBinding binding;
+    TEST_ASSERT_TRUE(bindDevice(device_type, 0, binding));
+
+    const char* names[I2C_BINDING_MAX_VALUES] = {nullptr};
+    uint8_t count = getMultiValueTypeNames(device_type, names, I2C_BINDING_MAX_VALUES);
+    TEST_ASSERT_EQUAL_UINT8(count, binding.value_count);
+
+    uint8_t buffer[16];
+    for (int round = 0; round < 200; round++) {
+        for (size_t b = 0; b < sizeof(buffer); b++) {
+            buffer[b] = nextByte();
+        }
+        size_t len = binding.protocol->expected_bytes;
+        for (uint8_t i = 0; i < count; i++) {
+            TEST_ASSERT_EQUAL_UINT32(extractRawValue(device_type, names[i], buffer, len),
+                                     extractBoundRawValue(binding, i, buffer, len));
+        }
+    }
+}
+
+void setUp(void) {
+    rng_state = 0x12345678;
+}
+
+void tearDown(void) {}
+
+// ============================================
+// BINDING RESOLUTION
+// ============================================
+
+void test_binding_resolves_protocol_slots_and_default_address() {
+    I2CSensorBinding binding;
+    TEST_ASSERT_TRUE(bindDevice("sht31", 0, binding));
+    TEST_ASSERT_NOT_NULL(binding.protocol);
+    TEST_ASSERT_EQUAL_STRING("sht31", binding.protocol->sensor_type);
+    TEST_ASSERT_EQUAL_HEX8(0x44, binding.i2c_address);
+    TEST_ASSERT_EQUAL_UINT8(2, binding.value_count);
+    TEST_ASSERT_EQUAL_STRING("sht31_temp", binding.protocol->values[binding.value_slots[0]].value_type);
+    TEST_ASSERT_EQUAL_STRING("sht31_humidity", binding.protocol->values[binding.value_slots[1]].value_type);
+}
+
+void test_binding_keeps_configured_address() {
+    I2CSensorBinding binding;
+    TEST_ASSERT_TRUE(bindDevice("sht31", 0x45, binding));
+    TEST_ASSERT_EQUAL_HEX8(0x45, binding.i2c_address);
+}
+
+void test_binding_slots_follow_caller_order() {
+    // Caller order differs from the protocol table order
+    const char* names[] = {"bme280_humidity", "bme280_pressure"};
+    I2CSensorBinding binding;
+    TEST_ASSERT_TRUE(resolveI2CSensorBinding("bme280", names, 2, 0x76, binding));
+    TEST_ASSERT_EQUAL_UINT8(2, binding.value_slots[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, binding.value_slots[1]);
+}
+
+void test_binding_rejects_unknown_device_or_value() {
+    I2CSensorBinding binding;
+    const char* ds_names[] = {"ds18b20"};
+    TEST_ASSERT_FALSE(resolveI2CSensorBinding("ds18b20", ds_names, 1, 0, binding));
+    TEST_ASSERT_NULL(binding.protocol);
+
+    const char* bad_names[] = {"sht31_temp", "sht31_pressure"};
+    TEST_ASSERT_FALSE(resolveI2CSensorBinding("sht31", bad_names, 2, 0x44, binding));
+    TEST_ASSERT_NULL(binding.protocol);
+}
+
+void test_multi_value_type_names_match_string_variant() {
+    const char* devices[] = {"sht31", "bmp280", "bme280", "SHT31"};
+    for (const char* device : devices) {
+        String strings[4];
+        const char* names[4] = {nullptr};
+        uint8_t n_strings = getMultiValueTypes(device, strings, 4);
+        uint8_t n_names = getMultiValueTypeNames(device, names, 4);
+        TEST_ASSERT_EQUAL_UINT8(n_strings, n_names);
+        for (uint8_t i = 0; i < n_names; i++) {
+            TEST_ASSERT_EQUAL_STRING(strings[i].c_str(), names[i]);
+        }
+    }
+}
+
+// ============================================
+// EXTRACTION (bound vs. string lookup)
+// ============================================
+
+void test_bound_extraction_matches_sht31() {
+    assertMatchesStringExtraction("sht31");
+}
+
+void test_bound_extraction_matches_bmp280() {
+    assertMatchesStringExtraction("bmp280");
+}
+
+void test_bound_extraction_matches_bme280() {
+    assertMatchesStringExtraction("bme280");
+}
+
+void test_bound_extraction_bounds_checks() {
+    I2CSensorBinding binding;
+    TEST_ASSERT_TRUE(bindDevice("sht31", 0, binding));
+    uint8_t buffer[6] = {0x66, 0x66, 0x93, 0x80, 0x00, 0xA2};
+    TEST_ASSERT_EQUAL_UINT32(0x6666, extractBoundRawValue(binding, 0, buffer, 6));
+    TEST_ASSERT_EQUAL_UINT32(0x8000, extractBoundRawValue(binding, 1, buffer, 6));
+    TEST_ASSERT_EQUAL_UINT32(0, extractBoundRawValue(binding, 1, buffer, 4));   // Short read
+    TEST_ASSERT_EQUAL_UINT32(0, extractBoundRawValue(binding, 2, buffer, 6));   // No such value
+}
+
+// ============================================
+// CRC-8
+// ============================================
+
+void test_crc8_sensirion_reference_vector() {
+    // Sensirion datasheet example: 0xBEEF → 0x92
+    uint8_t data[2] = {0xBE, 0xEF};
+    TEST_ASSERT_EQUAL_HEX8(0x92, calculateI2CCRC8(data, 2, 0x31, 0xFF));
+}
+
+void test_crc8_table_matches_bitwise() {
+    uint8_t data[8];
+    for (int round = 0; round < 500; round++) {
+        size_t len = (round % sizeof(data)) + 1;
+        for (size_t b = 0; b < len; b++) {
+            data[b] = nextByte();
+        }
+        TEST_ASSERT_EQUAL_HEX8(referenceCRC8(data, len, 0x31, 0xFF),
+                               calculateI2CCRC8(data, len, 0x31, 0xFF));
+        TEST_ASSERT_EQUAL_HEX8(referenceCRC8(data, len, 0x07, 0x00),
+                               calculateI2CCRC8(data, len, 0x07, 0x00));
+    }
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_binding_resolves_protocol_slots_and_default_address);
+    RUN_TEST(test_binding_keeps_configured_address);
+    RUN_TEST(test_binding_slots_follow_caller_order);
+    RUN_TEST(test_binding_rejects_unknown_device_or_value);
+    RUN_TEST(test_multi_value_type_names_match_string_variant);
+    RUN_TEST(test_bound_extraction_matches_sht31);
+    RUN_TEST(test_bound_extraction_matches_bmp280);
+    RUN_TEST(test_bound_extraction_matches_bme280);
+    RUN_TEST(test_bound_extraction_bounds_checks);
+    RUN_TEST(test_crc8_sensirion_reference_vector);
+    RUN_TEST(test_crc8_table_matches_bitwise);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,284 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "drivers/onewire_protocol.h"
+#include "drivers/onewire_rmt_transport.h"
+#include "../mocks/mock_onewire_bus.h"
+
+// ============================================
+// TRANSPORT CONFORMANCE (bit-bang reference + RMT)
+// ============================================
+// Every conformance case runs against both backends on the same device model.
+
+static SimOneWireBus bus;
+static MockOneWireHal bitbang(bus);
+static MockOneWireRmtChannel rmt_channel(bus);
+static OneWireRmtTransport rmt(rmt_channel);
+
+static IOneWireHal* const BACKENDS[] = {&bitbang, &rmt};
+static const size_t BACKEND_COUNT = sizeof(BACKENDS) / sizeof(BACKENDS[0]);
+
+// Family 0x28 (DS18B20), serials chosen to branch early and late in the search
+static const uint8_t ROM_A[8] = {0x28, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+static const uint8_t ROM_B[8] = {0x28, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+static const uint8_t ROM_C[8] = {0x28, 0x01, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00};
+
+static void withCrc(const uint8_t in[8], uint8_t out[8]) {
+    memcpy(out, in, 8);
+    out[7] = OneWireProtocol::crc8(out, 7);
+}
+
+static void addDevice(const uint8_t rom[8], int16_t raw) {
+    uint8_t full[8];
+    withCrc(rom, full);
+    bus.devices.push_back(SimDs18b20(full, raw));
+}
+
+static void romOf(size_t index, uint8_t out[8]) {
+    memcpy(out, bus.devices[index].rom, 8);
+}
+
+void setUp(void) {
+    bus.clear();
+    rmt_channel.reset();
+    rmt.resetStats();
+    addDevice(ROM_A, 0x0191);   // +25.0625 °C
+    addDevice(ROM_B, -162);     // -10.125 °C
+    addDevice(ROM_C, 0x07D0);   // +125 °C
+}
+
+void tearDown(void) {}
+
+void test_conformance_reset_presence() {
+    for (size_t b = 0; b < BACKEND_COUNT; b++) {
+        TEST_ASSERT_TRUE_MESSAGE(BACKENDS[b]->reset(), BACKENDS[b]->getBackendName());
+        bus.shorted = true;
+        TEST_ASSERT_FALSE_MESSAGE(BACKENDS[b]->reset(), BACKENDS[b]->getBackendName());
+        bus.shorted = false;
+        bus.devices.clear();
+        TEST_ASSERT_FALSE_MESSAGE(BACKENDS[b]->reset(), BACKENDS[b]->getBackendName());
+        setUp();
+    }
+}
+
+void test_conformance_search_enumerates_all_devices() {
+    for (size_t b = 0; b < BACKEND_COUNT; b++) {
+        OneWireSearchState state;
+        OneWireProtocol::resetSearch(state);
+        uint8_t rom[8];
+        bool seen[3] = {false, false, false};
+        size_t found = 0;
+        while (OneWireProtocol::searchNext(*BACKENDS[b], state, rom)) {
+            TEST_ASSERT_EQUAL_HEX8(OneWireProtocol::crc8(rom, 7), rom[7]);
+            for (size_t d = 0; d < bus.devices.size(); d++) {
+                if (memcmp(rom, bus.devices[d].rom, 8) == 0) {
+                    seen[d] = true;
+                }
+            }
+            found++;
+            TEST_ASSERT_TRUE(found <= 3);
+        }
+        TEST_ASSERT_EQUAL_MESSAGE(3, found, BACKENDS[b]->getBackendName());
+        TEST_ASSERT_TRUE(seen[0] && seen[1] && seen[2]);
+    }
+}
+
+void test_conformance_verify_present_and_absent() {
+    uint8_t missing[8];
+    withCrc(ROM_A, missing);
+    missing[2] = 0x55;
+    missing[7] = OneWireProtocol::crc8(missing, 7);
+
+    for (size_t b = 0; b < BACKEND_COUNT; b++) {
+        for (size_t d = 0; d < bus.devices.size(); d++) {
+            uint8_t rom[8];
+            romOf(d, rom);
+            TEST_ASSERT_TRUE_MESSAGE(OneWireProtocol::verify(*BACKENDS[b], rom),
+                                     BACKENDS[b]->getBackendName());
+        }
+        TEST_ASSERT_FALSE(OneWireProtocol::verify(*BACKENDS[b], missing));
+    }
+}
+
+void test_conformance_ds18b20_read_raw_temperature() {
+    const int16_t expected[3] = {0x0191, -162, 0x07D0};
+    for (size_t b = 0; b < BACKEND_COUNT; b++) {
+        for (size_t d = 0; d < bus.devices.size(); d++) {
+            uint8_t rom[8];
+            romOf(d, rom);
+            TEST_ASSERT_EQUAL(OneWireStatus::OK,
+                              OneWireProtocol::startConversion(*BACKENDS[b], rom, true));
+            TEST_ASSERT_TRUE(bus.strong_pullup);
+            BACKENDS[b]->delayMs(750);
+            BACKENDS[b]->depower();
+            TEST_ASSERT_FALSE(bus.strong_pullup);
+
+            uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+            TEST_ASSERT_EQUAL(OneWireStatus::OK,
+                              OneWireProtocol::readScratchpad(*BACKENDS[b], rom, scratchpad));
+            int16_t raw = static_cast<int16_t>((scratchpad[1] << 8) | scratchpad[0]);
+            TEST_ASSERT_EQUAL_INT16(expected[d], raw);
+        }
+    }
+}
+
+void test_conformance_scratchpad_write_read_roundtrip() {
+    for (size_t b = 0; b < BACKEND_COUNT; b++) {
+        uint8_t rom[8];
+        romOf(1, rom);
+        const uint8_t config[4] = {DS18B20_CMD_WRITE_SCRATCHPAD, 0x20, static_cast<uint8_t>(0xF6 + b), 0x3F};
+        TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::select(*BACKENDS[b], rom));
+        BACKENDS[b]->writeBytes(config, sizeof(config));
+
+        uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+        TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::readScratchpad(*BACKENDS[b], rom, scratchpad));
+        TEST_ASSERT_EQUAL_HEX8(0x20, scratchpad[2]);
+        TEST_ASSERT_EQUAL_HEX8(0xF6 + b, scratchpad[3]);
+        TEST_ASSERT_EQUAL_HEX8(0x3F, scratchpad[4]);
+    }
+}
+
+void test_conformance_crc_error_and_missing_device() {
+    for (size_t b = 0; b < BACKEND_COUNT; b++) {
+        uint8_t rom[8];
+        romOf(0, rom);
+        uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+        bus.devices[0].corrupt_next_read = true;
+        TEST_ASSERT_EQUAL(OneWireStatus::CRC_ERROR,
+                          OneWireProtocol::readScratchpad(*BACKENDS[b], rom, scratchpad));
+
+        bus.devices.clear();
+        TEST_ASSERT_EQUAL(OneWireStatus::NO_PRESENCE,
+                          OneWireProtocol::readScratchpad(*BACKENDS[b], rom, scratchpad));
+        setUp();
+    }
+}
+
+// ============================================
+// RMT CODEC / TRANSPORT
+// ============================================
+
+void test_rmt_codec_slot_timing() {
+    OneWireRmtSymbol symbols[8];
+    const uint8_t value = 0xA5;   // LSB first: 1 0 1 0 0 1 0 1
+    TEST_ASSERT_EQUAL(8, OneWireRmtCodec::encodeWrite(&value, 0, 8, symbols));
+    TEST_ASSERT_EQUAL(ONEWIRE_RMT_WRITE1_LOW_US, symbols[0].low_us);
+    TEST_ASSERT_EQUAL(ONEWIRE_RMT_WRITE0_LOW_US, symbols[1].low_us);
+    TEST_ASSERT_EQUAL(ONEWIRE_RMT_WRITE0_HIGH_US, symbols[1].high_us);
+    TEST_ASSERT_EQUAL(ONEWIRE_RMT_WRITE1_LOW_US, symbols[7].low_us);
+
+    // Captured read slots: short low = 1, device-held low = 0
+    const OneWireRmtSymbol captured[4] = {{6, 64}, {32, 38}, {14, 56}, {60, 10}};
+    uint8_t bits = 0xF0;
+    TEST_ASSERT_TRUE(OneWireRmtCodec::decodeReadSlots(captured, 4, &bits, 0, 4));
+    TEST_ASSERT_EQUAL_HEX8(0xF5, bits);
+    TEST_ASSERT_FALSE(OneWireRmtCodec::decodeReadSlots(captured, 3, &bits, 0, 4));
+
+    const OneWireRmtSymbol presence[2] = {{480, 30}, {120, 300}};
+    const OneWireRmtSymbol no_presence[1] = {{480, 300}};
+    const OneWireRmtSymbol short_pulse[2] = {{480, 30}, {8, 300}};
+    TEST_ASSERT_TRUE(OneWireRmtCodec::decodePresence(presence, 2));
+    TEST_ASSERT_FALSE(OneWireRmtCodec::decodePresence(no_presence, 1));
+    TEST_ASSERT_FALSE(OneWireRmtCodec::decodePresence(short_pulse, 2));
+}
+
+void test_rmt_ds18b20_read_cost_bounded() {
+    uint8_t rom[8];
+    romOf(0, rom);
+    uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+
+    TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::startConversion(rmt, rom, false));
+    TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::readScratchpad(rmt, rom, scratchpad));
+
+    // 2x (reset + 72-bit MATCH ROM in 3 chunks) + convert + read cmd + 72 read slots in 3 chunks
+    TEST_ASSERT_EQUAL_UINT32(13, rmt.getStats().transfers);
+    TEST_ASSERT_EQUAL_UINT32(13, rmt_channel.transfers);
+    TEST_ASSERT_TRUE(rmt_channel.max_symbols_per_transfer <= ONEWIRE_RMT_MAX_SLOTS);
+    TEST_ASSERT_EQUAL_UINT32(0, rmt_channel.invalid_symbols);
+    // Same slots on the wire as the bit-bang path: 2 resets + 72 + 8 + 72 + 8 + 72 bits
+    TEST_ASSERT_EQUAL_UINT32(2 + 72 + 8 + 72 + 8 + 72, rmt.getStats().slots);
+    TEST_ASSERT_EQUAL_UINT32(0, rmt.getStats().decode_errors);
+}
+
+void test_rmt_incomplete_capture_reads_released_bus() {
+    uint8_t rom[8];
+    romOf(0, rom);
+    TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::select(rmt, rom));
+    rmt.writeByte(DS18B20_CMD_READ_SCRATCHPAD);
+
+    uint8_t data[4] = {0, 0, 0, 0};
+    rmt_channel.truncate_next_capture = true;
+    rmt.readBytes(data, sizeof(data));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, data[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, data[3]);
+    TEST_ASSERT_EQUAL_UINT32(1, rmt.getStats().decode_errors);
+
+    rmt_channel.fail_next_transfer = true;
+    TEST_ASSERT_FALSE(rmt.reset());
+    TEST_ASSERT_EQUAL_UINT32(1, rmt.getStats().timeouts);
+    TEST_ASSERT_TRUE(rmt.reset());
+}
+
+void test_rmt_two_buses_concurrently() {
+    SimOneWireBus second_bus;
+    uint8_t rom_d[8];
+    const uint8_t base[8] = {0x28, 0x99, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    withCrc(base, rom_d);
+    second_bus.devices.push_back(SimDs18b20(rom_d, 0x0100));
+    MockOneWireRmtChannel second_channel(second_bus);
+    OneWireRmtTransport second(second_channel);
+
+    uint8_t rom_a[8];
+    romOf(0, rom_a);
+    uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+
+    // Interleaved operations on both pins; each bus only sees its own traffic
+    TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::startConversion(rmt, rom_a, false));
+    TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::startConversion(second, rom_d, false));
+    TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::readScratchpad(second, rom_d, scratchpad));
+    TEST_ASSERT_EQUAL_HEX8(0x00, scratchpad[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, scratchpad[1]);
+    TEST_ASSERT_EQUAL(OneWireStatus::OK, OneWireProtocol::readScratchpad(rmt, rom_a, scratchpad));
+    TEST_ASSERT_EQUAL_HEX8(0x91, scratchpad[0]);
+
+    TEST_ASSERT_FALSE(OneWireProtocol::verify(second, rom_a));
+    TEST_ASSERT_EQUAL_UINT32(2, bus.resets);
+    TEST_ASSERT_EQUAL_UINT32(3, second_bus.resets);
+}
+
+// ============================================
+// MAIN
+// ============================================
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_conformance_reset_presence);
+    RUN_TEST(test_conformance_search_enumerates_all_devices);
+    RUN_TEST(test_conformance_verify_present_and_absent);
+    RUN_TEST(test_conformance_ds18b20_read_raw_temperature);
+    RUN_TEST(test_conformance_scratchpad_write_read_roundtrip);
+    RUN_TEST(test_conformance_crc_error_and_missing_device);
+    RUN_TEST(test_rmt_codec_slot_timing);
+    RUN_TEST(test_rmt_ds18b20_read_cost_bounded);
+    RUN_TEST(test_rmt_incomplete_capture_reads_released_bus);
+    RUN_TEST(test_rmt_two_buses_concurrently);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,472 @@
+#include <unity.h>
+
+#include <cstring>
+#include <vector>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "services/config/ota_updater.h"
+#include "../mocks/mock_ota_partition_hal.h"
+
+// ============================================
+// OTA UPDATER (chunk streaming, resume, delta images)
+// ============================================
+
+static MockOtaPartitionHal hal;
+
+static std::vector<uint8_t> makeImage(size_t size, uint32_t seed) {
+    std::vector<uint8_t> image(size);
+    for (size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245u + 12345u;
+        image[i] = static_cast<uint8_t>(seed >> 16);
+    }
+    return image;
+}
+
+static uint32_t crcOf(const std::vector<uint8_t>& data, size_t offset = 0, size_t length = SIZE_MAX) {
+    if (length == SIZE_MAX) {
+        length = data.size() - offset;
+    }
+    return OtaUpdater::crc32(0, data.data() + offset, length);
+}
+
+static void setDigest(OtaManifest& manifest, const std::vector<uint8_t>& image) {
+    OtaSha256 sha;
+    sha.update(image.data(), image.size());
+    sha.finish(manifest.image_sha256);
+}
+
+static OtaManifest fullManifest(const std::vector<uint8_t>& image, uint16_t chunk_size) {
+    OtaManifest manifest;
+    memset(&manifest, 0, sizeof(manifest));
+    manifest.image_id = 42;
+    manifest.type = OtaImageType::FULL;
+    manifest.stream_size = static_cast<uint32_t>(image.size());
+    manifest.image_size = static_cast<uint32_t>(image.size());
+    manifest.image_crc32 = crcOf(image);
+    setDigest(manifest, image);
+    manifest.chunk_size = chunk_size;
+    return manifest;
+}
+
+// Sends stream[from, to) in chunk_size pieces like the server: continues at
+// the acked next offset and, while a delta COPY runs, lets the Comm-Task step
+// it (continuePatch). Returns the last result.
+static OtaResult sendStream(OtaUpdater& updater, const std::vector<uint8_t>& stream,
+                            size_t from, size_t to, size_t chunk_size) {
+    OtaResult result = OtaResult::OK;
+    size_t offset = from;
+    while (offset < to) {
+        size_t n = to - offset < chunk_size ? to - offset : chunk_size;
+        result = updater.applyChunk(static_cast<uint32_t>(offset), stream.data() + offset, n,
+                                    crcOf(stream, offset, n));
+        if (result == OtaResult::BUSY) {
+            result = updater.continuePatch();
+        }
+        if (result != OtaResult::OK) {
+            return result;
+        }
+        offset = updater.getNextOffset();
+    }
+    while (result == OtaResult::OK && updater.hasPendingCopy()) {
+        result = updater.continuePatch();
+    }
+    return result;
+}
+
+// ─── bsdiff-style patch builder ──────────────────────────────────────────
+static void putLe32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+static void patchCopy(std::vector<uint8_t>& patch, uint32_t src, uint32_t len) {
+    patch.push_back(OTA_PATCH_COPY);
+    putLe32(patch, src);
+    putLe32(patch, len);
+}
+
+static void patchAdd(std::vector<uint8_t>& patch, const std::vector<uint8_t>& base,
+                     const std::vector<uint8_t>& target, uint32_t src, uint32_t dst, uint32_t len) {
+    patch.push_back(OTA_PATCH_ADD);
+    putLe32(patch, src);
+    putLe32(patch, len);
+    for (uint32_t i = 0; i < len; i++) {
+        patch.push_back(static_cast<uint8_t>(target[dst + i] - base[src + i]));
+    }
+}
+
+static void patchInsert(std::vector<uint8_t>& patch, const std::vector<uint8_t>& target,
+                        uint32_t dst, uint32_t len) {
+    patch.push_back(OTA_PATCH_INSERT);
+    putLe32(patch, len);
+    patch.insert(patch.end(), target.begin() + dst, target.begin() + dst + len);
+}
+
+// New firmware = base with a patched region, a moved block and new code appended
+struct DeltaCase {
+    std::vector<uint8_t> base;
+    std::vector<uint8_t> target;
+    std::vector<uint8_t> patch;
+    OtaManifest manifest;
+};
+
+static DeltaCase makeDelta() {
+    DeltaCase c;
+    c.base = makeImage(20000, 7);
+    c.target.assign(c.base.begin(), c.base.begin() + 12000);                 // unchanged prefix
+    for (size_t i = 3000; i < 3400; i++) {
+        c.target[i] = static_cast<uint8_t>(c.target[i] + (i % 3));          // small edits
+    }
+    c.target.insert(c.target.end(), c.base.begin() + 14000, c.base.begin() + 20000);  // moved block
+    std::vector<uint8_t> added = makeImage(1500, 99);
+    c.target.insert(c.target.end(), added.begin(), added.end());            // new code
+
+    patchCopy(c.patch, 0, 3000);
+    patchAdd(c.patch, c.base, c.target, 3000, 3000, 400);
+    patchCopy(c.patch, 3400, 8600);
+    patchCopy(c.patch, 14000, 6000);
+    patchInsert(c.patch, c.target, 18000, 1500);
+
+    memset(&c.manifest, 0, sizeof(c.manifest));
+    c.manifest.image_id = 43;
+    c.manifest.type = OtaImageType::DELTA;
+    c.manifest.stream_size = static_cast<uint32_t>(c.patch.size());
+    c.manifest.image_size = static_cast<uint32_t>(c.target.size());
+    c.manifest.image_crc32 = crcOf(c.target);
+    setDigest(c.manifest, c.target);
+    c.manifest.base_size = static_cast<uint32_t>(c.base.size());
+    c.manifest.base_crc32 = crcOf(c.base);
+    c.manifest.chunk_size = 700;
+    return c;
+}
+
+void setUp(void) {
+    hal.reset();
+}
+
+void tearDown(void) {}
+
+// ============================================
+// HELPERS
+// ============================================
+void test_crc32_and_base64_helpers() {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, OtaUpdater::crc32(0, check, sizeof(check)));
+    uint32_t chained = OtaUpdater::crc32(OtaUpdater::crc32(0, check, 4), check + 4, 5);
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, chained);
+
+    uint8_t out[8];
+    TEST_ASSERT_EQUAL(6, OtaUpdater::decodeBase64("Zm9vYmFy", 8, out, sizeof(out)));
+    TEST_ASSERT_EQUAL(0, memcmp(out, "foobar", 6));
+    TEST_ASSERT_EQUAL(4, OtaUpdater::decodeBase64("Zm9vYg==", 8, out, sizeof(out)));
+    TEST_ASSERT_EQUAL(0, memcmp(out, "foob", 4));
+    TEST_ASSERT_EQUAL(5, OtaUpdater::decodeBase64("Zm9vYmE=", 8, out, sizeof(out)));
+    TEST_ASSERT_EQUAL(0, OtaUpdater::decodeBase64("Zm9=YmE=", 8, out, sizeof(out)));  // Padding inside
+    TEST_ASSERT_EQUAL(0, OtaUpdater::decodeBase64("Zm9vYmF", 7, out, sizeof(out)));   // Not a quantum
+    TEST_ASSERT_EQUAL(0, OtaUpdater::decodeBase64("Zm9vYmFy", 8, out, 5));            // Too small
+}
+
+static std::vector<uint8_t> sha256Of(const char* text) {
+    std::vector<uint8_t> digest(OTA_SHA256_SIZE);
+    OtaSha256 sha;
+    sha.update(reinterpret_cast<const uint8_t*>(text), strlen(text));
+    sha.finish(digest.data());
+    return digest;
+}
+
+static std::vector<uint8_t> hexBytes(const char* hex) {
+    std::vector<uint8_t> out(strlen(hex) / 2);
+    if (!OtaUpdater::decodeHex(hex, out.data(), out.size())) {
+        out.clear();                                        // Never equals a digest
+    }
+    return out;
+}
+
+void test_sha256_and_hex_helpers() {
+    // FIPS 180-4 examples: one block, empty, two blocks
+    TEST_ASSERT_TRUE(sha256Of("abc") ==
+                     hexBytes("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    TEST_ASSERT_TRUE(sha256Of("") ==
+                     hexBytes("E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855"));
+    TEST_ASSERT_TRUE(sha256Of("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+                     hexBytes("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+
+    // Streaming in odd pieces == one shot
+    std::vector<uint8_t> data = makeImage(1000, 11);
+    uint8_t whole[OTA_SHA256_SIZE];
+    uint8_t pieces[OTA_SHA256_SIZE];
+    OtaSha256 a;
+    a.update(data.data(), data.size());
+    a.finish(whole);
+    OtaSha256 b;
+    for (size_t offset = 0; offset < data.size(); offset += 37) {
+        b.update(data.data() + offset, data.size() - offset < 37 ? data.size() - offset : 37);
+    }
+    b.finish(pieces);
+    TEST_ASSERT_EQUAL(0, memcmp(whole, pieces, OTA_SHA256_SIZE));
+
+    uint8_t out[2];
+    TEST_ASSERT_FALSE(OtaUpdater::decodeHex("abc", out, 2));                        // Too short
+    TEST_ASSERT_FALSE(OtaUpdater::decodeHex("abcg", out, 2));                       // Not hex
+    TEST_ASSERT_FALSE(OtaUpdater::decodeHex(nullptr, out, 2));
+}
+
+// ============================================
+// FULL IMAGE
+// ============================================
+void test_full_image_streams_into_target_slot() {
+    std::vector<uint8_t> image = makeImage(10000, 1);
+    OtaUpdater updater(hal);
+    TEST_ASSERT_EQUAL(OtaResult::OK, updater.begin(fullManifest(image, 1024)));
+    TEST_ASSERT_EQUAL(OtaResult::COMPLETE, sendStream(updater, image, 0, image.size(), 1024));
+
+    TEST_ASSERT_TRUE(hal.activated);
+    TEST_ASSERT_FALSE(updater.isActive());
+    TEST_ASSERT_EQUAL(0, hal.write_violations);
+    TEST_ASSERT_EQUAL(3, hal.erase_count);                 // Only the sectors the image touches
+    TEST_ASSERT_TRUE(hal.targetContents(image.size()) == image);
+}
+
+void test_chunk_validation_keeps_session() {
+    std::vector<uint8_t> image = makeImage(3000, 2);
+    OtaUpdater updater(hal);
+    TEST_ASSERT_EQUAL(OtaResult::NOT_ACTIVE, updater.applyChunk(0, image.data(), 100, crcOf(image, 0, 100)));
+    updater.begin(fullManifest(image, 1000));
+
+    TEST_ASSERT_EQUAL(OtaResult::OK, sendStream(updater, image, 0, 1000, 1000));
+    // Lost ack → server resends: acknowledged, not rewritten
+    TEST_ASSERT_EQUAL(OtaResult::DUPLICATE, updater.applyChunk(0, image.data(), 1000, crcOf(image, 0, 1000)));
+    TEST_ASSERT_EQUAL(OtaResult::OUT_OF_ORDER,
+                      updater.applyChunk(2000, image.data() + 2000, 1000, crcOf(image, 2000, 1000)));
+    TEST_ASSERT_EQUAL(OtaResult::CHUNK_CRC, updater.applyChunk(1000, image.data() + 1000, 1000, 0x12345678));
+    TEST_ASSERT_EQUAL(OtaResult::BAD_CHUNK,
+                      updater.applyChunk(1000, image.data() + 1000, 1001, crcOf(image, 1000, 1001)));
+    TEST_ASSERT_TRUE(updater.isActive());
+    TEST_ASSERT_EQUAL(1000, updater.getNextOffset());
+
+    TEST_ASSERT_EQUAL(OtaResult::COMPLETE, sendStream(updater, image, 1000, image.size(), 1000));
+    TEST_ASSERT_EQUAL(0, hal.write_violations);
+    TEST_ASSERT_TRUE(hal.targetContents(image.size()) == image);
+}
+
+void test_resume_after_power_loss_repairs_sector_tail() {
+    std::vector<uint8_t> image = makeImage(12000, 3);
+    OtaCheckpoint checkpoint;
+    {
+        OtaUpdater updater(hal);
+        updater.begin(fullManifest(image, 1000));
+        TEST_ASSERT_EQUAL(OtaResult::OK, sendStream(updater, image, 0, 5000, 1000));
+        checkpoint = updater.getCheckpoint();              // Persisted
+        // Next chunk reaches flash, power fails before the checkpoint is stored
+        TEST_ASSERT_EQUAL(OtaResult::OK, sendStream(updater, image, 5000, 6000, 1000));
+    }
+
+    // Reboot: server resends from the persisted offset
+    OtaUpdater resumed(hal);
+    TEST_ASSERT_EQUAL(OtaResult::OK, resumed.resume(checkpoint));
+    TEST_ASSERT_EQUAL(5000, resumed.getNextOffset());
+    TEST_ASSERT_EQUAL(OtaResult::COMPLETE, sendStream(resumed, image, 5000, image.size(), 1000));
+    TEST_ASSERT_EQUAL(0, hal.write_violations);
+    TEST_ASSERT_TRUE(hal.targetContents(image.size()) == image);
+}
+
+void test_flash_failure_ends_session() {
+    std::vector<uint8_t> image = makeImage(4000, 4);
+    OtaUpdater updater(hal);
+    updater.begin(fullManifest(image, 1000));
+    hal.fail_writes_after = 2;
+    TEST_ASSERT_EQUAL(OtaResult::FLASH_ERROR, sendStream(updater, image, 0, image.size(), 1000));
+    TEST_ASSERT_FALSE(updater.isActive());
+    TEST_ASSERT_EQUAL(2000, updater.getNextOffset());
+    TEST_ASSERT_FALSE(hal.activated);
+}
+
+void test_image_crc_mismatch_is_not_activated() {
+    std::vector<uint8_t> image = makeImage(3000, 5);
+    OtaManifest manifest = fullManifest(image, 1000);
+    manifest.image_crc32 ^= 1;
+    OtaUpdater updater(hal);
+    updater.begin(manifest);
+    TEST_ASSERT_EQUAL(OtaResult::IMAGE_CRC, sendStream(updater, image, 0, image.size(), 1000));
+    TEST_ASSERT_FALSE(hal.activated);
+    TEST_ASSERT_FALSE(updater.isActive());
+}
+
+void test_image_digest_mismatch_is_not_activated() {
+    std::vector<uint8_t> image = makeImage(3000, 5);
+    OtaManifest manifest = fullManifest(image, 1000);
+    manifest.image_sha256[OTA_SHA256_SIZE - 1] ^= 1;       // CRC32 matches, digest does not
+    OtaUpdater updater(hal);
+    updater.begin(manifest);
+    TEST_ASSERT_EQUAL(OtaResult::IMAGE_DIGEST, sendStream(updater, image, 0, image.size(), 1000));
+    TEST_ASSERT_FALSE(hal.activated);
+    TEST_ASSERT_FALSE(updater.isActive());
+}
+
+void test_manifest_validation() {
+    std::vector<uint8_t> image = makeImage(1000, 6);
+    OtaUpdater updater(hal);
+    OtaManifest manifest = fullManifest(image, 0);
+    TEST_ASSERT_EQUAL(OtaResult::BAD_MANIFEST, updater.begin(manifest));
+    manifest.chunk_size = OTA_MAX_CHUNK_SIZE + 1;
+    TEST_ASSERT_EQUAL(OtaResult::BAD_MANIFEST, updater.begin(manifest));
+    manifest.chunk_size = 512;
+    manifest.stream_size = 999;                            // FULL: stream must be the image
+    TEST_ASSERT_EQUAL(OtaResult::BAD_MANIFEST, updater.begin(manifest));
+    manifest.stream_size = manifest.image_size = static_cast<uint32_t>(hal.targetSize() + 1);
+    TEST_ASSERT_EQUAL(OtaResult::BAD_MANIFEST, updater.begin(manifest));
+    manifest = fullManifest(image, 512);
+    memset(manifest.image_sha256, 0, sizeof(manifest.image_sha256));  // No digest → no update
+    TEST_ASSERT_EQUAL(OtaResult::BAD_MANIFEST, updater.begin(manifest));
+    TEST_ASSERT_FALSE(updater.isActive());
+}
+
+// ============================================
+// DELTA IMAGE
+// ============================================
+void test_delta_patch_rebuilds_image_from_running_slot() {
+    DeltaCase c = makeDelta();
+    hal.setRunningImage(c.base);
+    OtaUpdater updater(hal);
+    TEST_ASSERT_EQUAL(OtaResult::OK, updater.begin(c.manifest));
+    TEST_ASSERT_EQUAL(OtaResult::COMPLETE, sendStream(updater, c.patch, 0, c.patch.size(), 700));
+
+    TEST_ASSERT_TRUE(hal.activated);
+    TEST_ASSERT_EQUAL(0, hal.write_violations);
+    TEST_ASSERT_TRUE(hal.targetContents(c.target.size()) == c.target);
+    // Transfer volume: patch is a fraction of the image
+    TEST_ASSERT_TRUE(c.patch.size() * 5 < c.target.size());
+}
+
+void test_delta_copy_is_emitted_in_bounded_steps() {
+    DeltaCase c = makeDelta();
+    hal.setRunningImage(c.base);
+    OtaUpdater updater(hal);
+    TEST_ASSERT_EQUAL(OtaResult::OK, updater.begin(c.manifest));
+
+    // COPY 3000 B: one step per call, the chunk is taken only up to the COPY
+    TEST_ASSERT_EQUAL(OtaResult::OK, updater.applyChunk(0, c.patch.data(), 700, crcOf(c.patch, 0, 700)));
+    TEST_ASSERT_EQUAL_UINT32(9, updater.getNextOffset());
+    TEST_ASSERT_EQUAL_UINT32(OTA_COPY_STEP_BYTES, updater.getImageOffset());
+    TEST_ASSERT_TRUE(updater.hasPendingCopy());
+
+    // Chunk resent while the COPY runs: nothing consumed, one more step
+    TEST_ASSERT_EQUAL(OtaResult::BUSY, updater.applyChunk(9, c.patch.data() + 9, 700, crcOf(c.patch, 9, 700)));
+    TEST_ASSERT_EQUAL_UINT32(9, updater.getNextOffset());
+    TEST_ASSERT_EQUAL_UINT32(2 * OTA_COPY_STEP_BYTES, updater.getImageOffset());
+
+    // Comm-Task steps finish the COPY, the stream continues at the acked offset
+    TEST_ASSERT_EQUAL(OtaResult::OK, updater.continuePatch());
+    TEST_ASSERT_FALSE(updater.hasPendingCopy());
+    TEST_ASSERT_EQUAL_UINT32(3000, updater.getImageOffset());
+    TEST_ASSERT_EQUAL(OtaResult::COMPLETE, sendStream(updater, c.patch, 9, c.patch.size(), 700));
+    TEST_ASSERT_TRUE(hal.targetContents(c.target.size()) == c.target);
+}
+
+void test_delta_rejects_wrong_base() {
+    DeltaCase c = makeDelta();
+    std::vector<uint8_t> other = c.base;
+    other[100] ^= 0xFF;
+    hal.setRunningImage(other);
+    OtaUpdater updater(hal);
+    TEST_ASSERT_EQUAL(OtaResult::BASE_MISMATCH, updater.begin(c.manifest));
+    TEST_ASSERT_FALSE(updater.isActive());
+}
+
+void test_delta_resume_mid_operation() {
+    DeltaCase c = makeDelta();
+    hal.setRunningImage(c.base);
+    // Stop inside the ADD payload and with a split op header
+    const size_t stops[] = {14, 200, 420};
+    OtaCheckpoint checkpoint;
+    size_t offset = 0;
+    {
+        OtaUpdater updater(hal);
+        updater.begin(c.manifest);
+        for (size_t stop : stops) {
+            TEST_ASSERT_EQUAL(OtaResult::OK, sendStream(updater, c.patch, offset, stop, 700));
+            offset = stop;
+        }
+        checkpoint = updater.getCheckpoint();
+        TEST_ASSERT_TRUE(checkpoint.patch.remaining > 0 || checkpoint.patch.header_len > 0);
+        sendStream(updater, c.patch, offset, offset + 300, 700);     // Lost after power fail
+    }
+
+    OtaUpdater resumed(hal);
+    TEST_ASSERT_EQUAL(OtaResult::OK, resumed.resume(checkpoint));
+    TEST_ASSERT_EQUAL(OtaResult::COMPLETE, sendStream(resumed, c.patch, offset, c.patch.size(), 700));
+    TEST_ASSERT_EQUAL(0, hal.write_violations);
+    TEST_ASSERT_TRUE(hal.targetContents(c.target.size()) == c.target);
+
+    // Different firmware booted since the checkpoint → resume refused
+    hal.running[0] ^= 0x01;
+    TEST_ASSERT_EQUAL(OtaResult::BASE_MISMATCH, resumed.resume(checkpoint));
+}
+
+void test_delta_invalid_ops() {
+    DeltaCase c = makeDelta();
+    hal.setRunningImage(c.base);
+
+    std::vector<uint8_t> bad_op = {0x7F, 0, 0, 0, 0};
+    OtaManifest manifest = c.manifest;
+    manifest.stream_size = static_cast<uint32_t>(bad_op.size());
+    OtaUpdater updater(hal);
+    updater.begin(manifest);
+    TEST_ASSERT_EQUAL(OtaResult::PATCH_INVALID, sendStream(updater, bad_op, 0, bad_op.size(), 700));
+    TEST_ASSERT_FALSE(updater.isActive());
+
+    std::vector<uint8_t> out_of_base;
+    patchCopy(out_of_base, 19000, 2000);                   // Beyond base_size
+    manifest.stream_size = static_cast<uint32_t>(out_of_base.size());
+    updater.begin(manifest);
+    TEST_ASSERT_EQUAL(OtaResult::PATCH_INVALID, sendStream(updater, out_of_base, 0, out_of_base.size(), 700));
+
+    std::vector<uint8_t> short_image;
+    patchCopy(short_image, 0, 100);                        // Stream ends before image_size
+    manifest.stream_size = static_cast<uint32_t>(short_image.size());
+    updater.begin(manifest);
+    TEST_ASSERT_EQUAL(OtaResult::PATCH_INVALID, sendStream(updater, short_image, 0, short_image.size(), 700));
+    TEST_ASSERT_FALSE(hal.activated);
+}
+
+// ============================================
+// MAIN
+// ============================================
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_crc32_and_base64_helpers);
+    RUN_TEST(test_sha256_and_hex_helpers);
+    RUN_TEST(test_full_image_streams_into_target_slot);
+    RUN_TEST(test_chunk_validation_keeps_session);
+    RUN_TEST(test_resume_after_power_loss_repairs_sector_tail);
+    RUN_TEST(test_flash_failure_ends_session);
+    RUN_TEST(test_image_crc_mismatch_is_not_activated);
+    RUN_TEST(test_image_digest_mismatch_is_not_activated);
+    RUN_TEST(test_manifest_validation);
+    RUN_TEST(test_delta_patch_rebuilds_image_from_running_slot);
+    RUN_TEST(test_delta_copy_is_emitted_in_bounded_steps);
+    RUN_TEST(test_delta_rejects_wrong_base);
+    RUN_TEST(test_delta_resume_mid_operation);
+    RUN_TEST(test_delta_invalid_ops);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
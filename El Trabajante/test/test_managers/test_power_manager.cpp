@@ -0,0 +1,235 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "services/power/power_manager.h"
+
+static PowerConfig enabledConfig() {
+    PowerConfig config = PowerManager::defaultConfig();
+    config.enabled = true;
+    return config;
+}
+
+// Idle field node: nothing running, link up, no deadlines
+static PowerDeadlineInputs idleInputs() {
+    PowerDeadlineInputs inputs;
+    inputs.next_measurement_in_ms = POWER_DEADLINE_NONE;
+    inputs.next_offline_eval_in_ms = POWER_DEADLINE_NONE;
+    inputs.next_heartbeat_in_ms = POWER_DEADLINE_NONE;
+    inputs.actuator_running = false;
+    inputs.work_pending = false;
+    inputs.link_up = true;
+    inputs.keep_apb_clock = false;
+    return inputs;
+}
+
+void setUp(void) {
+    powerManager.resetForTest();
+}
+
+void tearDown(void) {}
+
+// ============================================
+// SAFETY-TASK DEADLINES
+// ============================================
+
+void test_power_disabled_keeps_base_cadence() {
+    PowerConfig config = enabledConfig();
+    config.enabled = false;
+    PowerDecision decision = PowerManager::computeSafetyDecision(idleInputs(), config);
+    TEST_ASSERT_EQUAL_UINT32(10, decision.sleep_ms);
+    TEST_ASSERT_FALSE(decision.allow_light_sleep);
+}
+
+void test_power_idle_node_sleeps_until_next_measurement() {
+    PowerDeadlineInputs inputs = idleInputs();
+    inputs.next_measurement_in_ms = 300;
+    PowerDecision decision = PowerManager::computeSafetyDecision(inputs, enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(295, decision.sleep_ms);  // 5 ms wake guard
+    TEST_ASSERT_TRUE(decision.allow_light_sleep);
+}
+
+void test_power_sleep_capped_at_max() {
+    PowerDeadlineInputs inputs = idleInputs();
+    inputs.next_measurement_in_ms = 45000;
+    PowerDecision decision = PowerManager::computeSafetyDecision(inputs, enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(1000, decision.sleep_ms);
+
+    // No deadline at all → still bounded (WDT feed, ACK timeout check)
+    decision = PowerManager::computeSafetyDecision(idleInputs(), enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(1000, decision.sleep_ms);
+}
+
+void test_power_earliest_deadline_wins() {
+    PowerDeadlineInputs inputs = idleInputs();
+    inputs.next_measurement_in_ms = 800;
+    inputs.next_offline_eval_in_ms = 120;
+    PowerDecision decision = PowerManager::computeSafetyDecision(inputs, enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(115, decision.sleep_ms);
+}
+
+void test_power_due_now_uses_base_without_light_sleep() {
+    PowerDeadlineInputs inputs = idleInputs();
+    inputs.next_measurement_in_ms = 0;
+    PowerDecision decision = PowerManager::computeSafetyDecision(inputs, enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(10, decision.sleep_ms);
+    TEST_ASSERT_FALSE(decision.allow_light_sleep);
+
+    // Short gap: block longer than base but below the light-sleep threshold
+    inputs.next_measurement_in_ms = 40;
+    decision = PowerManager::computeSafetyDecision(inputs, enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(35, decision.sleep_ms);
+    TEST_ASSERT_FALSE(decision.allow_light_sleep);
+}
+
+void test_power_pulse_counter_blocks_light_sleep_only() {
+    PowerDeadlineInputs inputs = idleInputs();
+    inputs.next_measurement_in_ms = 30000;
+    inputs.keep_apb_clock = true;
+    PowerDecision decision = PowerManager::computeSafetyDecision(inputs, enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(1000, decision.sleep_ms);  // Long blocks stay
+    TEST_ASSERT_FALSE(decision.allow_light_sleep);       // APB must keep running for PCNT
+}
+
+void test_power_running_actuator_forces_full_rate() {
+    PowerDeadlineInputs inputs = idleInputs();
+    inputs.next_measurement_in_ms = 30000;
+    inputs.actuator_running = true;
+    PowerDecision decision = PowerManager::computeSafetyDecision(inputs, enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(10, decision.sleep_ms);
+    TEST_ASSERT_FALSE(decision.allow_light_sleep);
+}
+
+void test_power_pending_work_forces_full_rate() {
+    PowerDeadlineInputs inputs = idleInputs();
+    inputs.work_pending = true;
+    PowerDecision decision = PowerManager::computeSafetyDecision(inputs, enabledConfig());
+    TEST_ASSERT_EQUAL_UINT32(10, decision.sleep_ms);
+}
+
+// ============================================
+// COMM-TASK DELAY
+// ============================================
+
+void test_power_comm_delay_tracks_heartbeat() {
+    PowerConfig config = enabledConfig();
+    PowerDeadlineInputs inputs = idleInputs();
+
+    TEST_ASSERT_EQUAL_UINT32(500, PowerManager::computeCommDelayMs(inputs, config));
+
+    inputs.next_heartbeat_in_ms = 205;
+    TEST_ASSERT_EQUAL_UINT32(200, PowerManager::computeCommDelayMs(inputs, config));
+
+    inputs.next_heartbeat_in_ms = 0;
+    TEST_ASSERT_EQUAL_UINT32(50, PowerManager::computeCommDelayMs(inputs, config));
+}
+
+void test_power_comm_delay_idle_without_power_management() {
+    // Event-driven Comm-Task: idle blocking does not depend on esp_pm
+    PowerConfig config = PowerManager::defaultConfig();
+    config.enabled = false;
+    PowerDeadlineInputs inputs = idleInputs();
+    TEST_ASSERT_EQUAL_UINT32(500, PowerManager::computeCommDelayMs(inputs, config));
+
+    inputs.next_heartbeat_in_ms = 105;
+    TEST_ASSERT_EQUAL_UINT32(100, PowerManager::computeCommDelayMs(inputs, config));
+}
+
+void test_power_comm_delay_base_while_reconnecting_or_draining() {
+    PowerConfig config = enabledConfig();
+    PowerDeadlineInputs inputs = idleInputs();
+
+    inputs.link_up = false;
+    TEST_ASSERT_EQUAL_UINT32(50, PowerManager::computeCommDelayMs(inputs, config));
+
+    inputs.link_up = true;
+    inputs.work_pending = true;
+    TEST_ASSERT_EQUAL_UINT32(50, PowerManager::computeCommDelayMs(inputs, config));
+}
+
+// ============================================
+// STATISTICS
+// ============================================
+
+void test_power_stats_and_current_estimate() {
+    powerManager.setPmActiveForTest(true);
+    PowerDecision sleep_block = {990, true};
+    PowerDecision busy_block = {10, false};
+
+    powerManager.recordSafetyWake(sleep_block, 10, 990, PowerWakeSource::TIMEOUT);
+    powerManager.recordSafetyWake(sleep_block, 10, 400, PowerWakeSource::NOTIFY);
+    powerManager.recordSafetyWake(busy_block, 10, 10, PowerWakeSource::TIMEOUT);
+
+    PowerStats stats = powerManager.getStats();
+    TEST_ASSERT_EQUAL_UINT32(3, stats.wakes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.notify_wakes);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.light_sleep_blocks);
+    TEST_ASSERT_EQUAL_UINT32(30, (uint32_t)stats.active_ms);
+    TEST_ASSERT_EQUAL_UINT32(10, (uint32_t)stats.idle_ms);
+    TEST_ASSERT_EQUAL_UINT32(1390, (uint32_t)stats.sleep_ms);
+
+    // (30*50 + 10*25 + 1390*3) / 1430 = 5920 / 1430 ≈ 4 mA
+    TEST_ASSERT_EQUAL_UINT32(4, powerManager.estimateAverageCurrentMa());
+}
+
+void test_power_without_pm_counts_blocks_as_idle() {
+    PowerDecision sleep_block = {990, true};
+    powerManager.recordSafetyWake(sleep_block, 10, 990, PowerWakeSource::TIMEOUT);
+
+    PowerStats stats = powerManager.getStats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.light_sleep_blocks);
+    TEST_ASSERT_EQUAL_UINT32(990, (uint32_t)stats.idle_ms);
+    // (10*50 + 990*40) / 1000 = 40.1 → 40 mA
+    TEST_ASSERT_EQUAL_UINT32(40, powerManager.estimateAverageCurrentMa());
+}
+
+void test_power_diagnostics_json() {
+    powerManager.setPmActiveForTest(true);
+    PowerDecision sleep_block = {990, true};
+    powerManager.recordSafetyWake(sleep_block, 10, 990, PowerWakeSource::NOTIFY);
+
+    String json = "{";
+    powerManager.appendDiagnosticsJson(json);
+    json += "}";
+    TEST_ASSERT_EQUAL_STRING(
+        "{,\"power\":{\"en\":false,\"pm\":true,\"wakes\":1,\"wake_notify\":1,"
+        "\"sleep_pct\":99,\"est_avg_ma\":3}}",
+        json.c_str());
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_power_disabled_keeps_base_cadence);
+    RUN_TEST(test_power_idle_node_sleeps_until_next_measurement);
+    RUN_TEST(test_power_sleep_capped_at_max);
+    RUN_TEST(test_power_earliest_deadline_wins);
+    RUN_TEST(test_power_due_now_uses_base_without_light_sleep);
+    RUN_TEST(test_power_pulse_counter_blocks_light_sleep_only);
+    RUN_TEST(test_power_running_actuator_forces_full_rate);
+    RUN_TEST(test_power_pending_work_forces_full_rate);
+    RUN_TEST(test_power_comm_delay_tracks_heartbeat);
+    RUN_TEST(test_power_comm_delay_idle_without_power_management);
+    RUN_TEST(test_power_comm_delay_base_while_reconnecting_or_draining);
+    RUN_TEST(test_power_stats_and_current_estimate);
+    RUN_TEST(test_power_without_pm_counts_blocks_as_idle);
+    RUN_TEST(test_power_diagnostics_json);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
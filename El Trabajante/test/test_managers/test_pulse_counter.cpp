@@ -0,0 +1,185 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "drivers/pulse_counter.h"
+#include "../mocks/mock_pulse_counter_hal.h"
+
+static MockPulseCounterHal hal;
+
+static const uint8_t FLOW_GPIO = 26;
+static const uint8_t RAIN_GPIO = 27;
+
+void setUp(void) {
+    pulseCounter.reset();
+    hal.reset();
+    TEST_ASSERT_TRUE(pulseCounter.begin(&hal));
+}
+
+void tearDown(void) {}
+
+// ============================================
+// ATTACH / DETACH
+// ============================================
+
+void test_pulse_attach_assigns_unit_and_clamps_filter() {
+    TEST_ASSERT_TRUE(pulseCounter.attach(FLOW_GPIO, 50000, 0));
+    TEST_ASSERT_TRUE(pulseCounter.isAttached(FLOW_GPIO));
+    TEST_ASSERT_EQUAL_UINT8(1, pulseCounter.getAttachedCount());
+    TEST_ASSERT_TRUE(hal.state[0].attached);
+    TEST_ASSERT_EQUAL_UINT8(FLOW_GPIO, hal.state[0].gpio);
+    TEST_ASSERT_EQUAL_UINT16(PULSE_COUNTER_MAX_FILTER_NS, hal.state[0].filter_ns);
+
+    TEST_ASSERT_TRUE(pulseCounter.attach(FLOW_GPIO, 1000, 0));  // Idempotent
+    TEST_ASSERT_EQUAL_UINT8(1, pulseCounter.getAttachedCount());
+
+    pulseCounter.detach(FLOW_GPIO);
+    TEST_ASSERT_FALSE(pulseCounter.isAttached(FLOW_GPIO));
+    TEST_ASSERT_FALSE(hal.state[0].attached);
+    TEST_ASSERT_EQUAL_UINT8(0, pulseCounter.getAttachedCount());
+}
+
+void test_pulse_attach_fails_without_hardware_or_free_unit() {
+    hal.units = 1;
+    TEST_ASSERT_TRUE(pulseCounter.attach(FLOW_GPIO, 1000, 0));
+    TEST_ASSERT_FALSE(pulseCounter.attach(RAIN_GPIO, 1000, 0));   // All units busy
+
+    pulseCounter.reset();
+    hal.reset();
+    hal.units = 0;                                                // ESP32-C3: no PCNT
+    TEST_ASSERT_FALSE(pulseCounter.begin(&hal));
+    TEST_ASSERT_FALSE(pulseCounter.attach(FLOW_GPIO, 1000, 0));
+}
+
+// ============================================
+// COUNTING
+// ============================================
+
+void test_pulse_sample_reports_delta_and_elapsed() {
+    pulseCounter.attach(FLOW_GPIO, 1000, 1000);
+    hal.pulse(FLOW_GPIO, 450);
+
+    PulseSample sample;
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 31000, sample));
+    TEST_ASSERT_EQUAL_UINT32(450, sample.delta_pulses);
+    TEST_ASSERT_EQUAL_UINT32(30000, sample.elapsed_ms);
+    TEST_ASSERT_EQUAL_UINT64(450, sample.total_pulses);
+
+    hal.pulse(FLOW_GPIO, 50);
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 61000, sample));
+    TEST_ASSERT_EQUAL_UINT32(50, sample.delta_pulses);
+    TEST_ASSERT_EQUAL_UINT64(500, sample.total_pulses);
+}
+
+void test_pulse_counter_wrap_is_carried_into_total() {
+    pulseCounter.attach(FLOW_GPIO, 1000, 0);
+    hal.pulse(FLOW_GPIO, PULSE_COUNTER_HW_LIMIT + 100);
+    TEST_ASSERT_EQUAL_UINT32(1, hal.state[0].wraps);
+
+    PulseSample sample;
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 1000, sample));
+    TEST_ASSERT_EQUAL_UINT64(PULSE_COUNTER_HW_LIMIT + 100, sample.total_pulses);
+    TEST_ASSERT_EQUAL_UINT32(PULSE_COUNTER_HW_LIMIT + 100, sample.delta_pulses);
+}
+
+void test_pulse_pending_wrap_never_decreases_total() {
+    pulseCounter.attach(FLOW_GPIO, 1000, 0);
+    hal.pulse(FLOW_GPIO, PULSE_COUNTER_HW_LIMIT - 10);
+    PulseSample sample;
+    pulseCounter.sample(FLOW_GPIO, 1000, sample);
+
+    hal.defer_wrap_irq = true;
+    hal.pulse(FLOW_GPIO, 20);              // Counter reset to 10, wrap IRQ not run yet
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 2000, sample));
+    TEST_ASSERT_EQUAL_UINT64(PULSE_COUNTER_HW_LIMIT - 10, sample.total_pulses);
+    TEST_ASSERT_EQUAL_UINT32(0, sample.delta_pulses);
+
+    hal.deliverPendingWraps();
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 3000, sample));
+    TEST_ASSERT_EQUAL_UINT64(PULSE_COUNTER_HW_LIMIT + 10, sample.total_pulses);
+    TEST_ASSERT_EQUAL_UINT32(20, sample.delta_pulses);  // Nothing lost
+}
+
+void test_pulse_total_exceeds_32_bit() {
+    pulseCounter.attach(FLOW_GPIO, 1000, 0);
+    PulseSample sample;
+    pulseCounter.sample(FLOW_GPIO, 0, sample);
+
+    hal.state[0].wraps = 200000;           // 6.55e9 pulses
+    hal.state[0].count = 5;
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 1000, sample));
+    TEST_ASSERT_EQUAL_UINT64(200000ULL * PULSE_COUNTER_HW_LIMIT + 5, sample.total_pulses);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, sample.delta_pulses);   // Saturated, not wrapped
+}
+
+void test_pulse_reset_total_keeps_interval_delta() {
+    pulseCounter.attach(FLOW_GPIO, 1000, 0);
+    hal.pulse(FLOW_GPIO, 1000);
+    PulseSample sample;
+    pulseCounter.sample(FLOW_GPIO, 1000, sample);
+
+    hal.pulse(FLOW_GPIO, 200);
+    TEST_ASSERT_TRUE(pulseCounter.resetTotal(FLOW_GPIO));
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 2000, sample));
+    TEST_ASSERT_EQUAL_UINT32(200, sample.delta_pulses);
+    TEST_ASSERT_EQUAL_UINT64(0, sample.total_pulses);
+
+    hal.pulse(FLOW_GPIO, 30);
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 3000, sample));
+    TEST_ASSERT_EQUAL_UINT32(30, sample.delta_pulses);
+    TEST_ASSERT_EQUAL_UINT64(30, sample.total_pulses);
+    TEST_ASSERT_FALSE(pulseCounter.resetTotal(RAIN_GPIO));
+}
+
+void test_pulse_channels_are_independent() {
+    pulseCounter.attach(FLOW_GPIO, 1000, 0);
+    pulseCounter.attach(RAIN_GPIO, 10000, 0);
+    hal.pulse(FLOW_GPIO, 300);
+    hal.pulse(RAIN_GPIO, 3);
+
+    PulseSample flow;
+    PulseSample rain;
+    TEST_ASSERT_TRUE(pulseCounter.sample(FLOW_GPIO, 1000, flow));
+    TEST_ASSERT_TRUE(pulseCounter.sample(RAIN_GPIO, 1000, rain));
+    TEST_ASSERT_EQUAL_UINT64(300, flow.total_pulses);
+    TEST_ASSERT_EQUAL_UINT64(3, rain.total_pulses);
+}
+
+// ============================================
+// CALIBRATION
+// ============================================
+
+void test_pulse_rate_and_volume_from_calibration() {
+    // YF-S201: 450 pulses per litre; 900 pulses in 30 s → 2 L → 4 L/min
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 4.0f, PulseCounterManager::computeRate(900, 30000, 450.0f, 60000));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 2.0f, PulseCounterManager::pulsesToUnits(900, 450.0f));
+    // Rain gauge: 0.2794 mm per tip → 3.579 pulses/mm; 10 tips in 15 min → 11.176 mm/h
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 11.176f,
+                             PulseCounterManager::computeRate(10, 900000, 1.0f / 0.2794f, 3600000));
+    // Uncalibrated: raw pulses per period
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 120.0f, PulseCounterManager::computeRate(60, 30000, 0.0f, 60000));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, PulseCounterManager::computeRate(60, 0, 450.0f, 60000));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_pulse_attach_assigns_unit_and_clamps_filter);
+    RUN_TEST(test_pulse_attach_fails_without_hardware_or_free_unit);
+    RUN_TEST(test_pulse_sample_reports_delta_and_elapsed);
+    RUN_TEST(test_pulse_counter_wrap_is_carried_into_total);
+    RUN_TEST(test_pulse_pending_wrap_never_decreases_total);
+    RUN_TEST(test_pulse_total_exceeds_32_bit);
+    RUN_TEST(test_pulse_reset_total_keeps_interval_delta);
+    RUN_TEST(test_pulse_channels_are_independent);
+    RUN_TEST(test_pulse_rate_and_volume_from_calibration);
+    return UNITY_END();
+}
+#endif
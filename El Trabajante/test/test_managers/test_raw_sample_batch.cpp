@@ -0,0 +1,203 @@
+#include <unity.h>
+
+#include <string.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "services/sensor/raw_sample_batch.h"
+
+static RawSampleBatch batch;
+
+static RawBatchPolicy makePolicy(uint8_t max_samples, uint32_t flush_interval_ms, uint32_t flush_delta) {
+    RawBatchPolicy policy;
+    policy.max_samples = max_samples;
+    policy.flush_interval_ms = flush_interval_ms;
+    policy.flush_delta = flush_delta;
+    return policy;
+}
+
+void setUp(void) {
+    batch.configure(makePolicy(10, 0, 0));
+}
+
+void tearDown(void) {}
+
+// ============================================
+// ENCODE / DECODE
+// ============================================
+
+void test_batch_roundtrip_uniform_spacing() {
+    // pH raw ADC at 1 Hz
+    const int32_t raws[] = {1801, 1795, 1812, 1790, 1806};
+    for (uint8_t i = 0; i < 5; i++) {
+        batch.add(raws[i], 5000 + i * 1000UL);
+    }
+
+    char frame[256];
+    size_t len = batch.encode(frame, sizeof(frame), 1718000000UL);
+    TEST_ASSERT_TRUE(len > 0);
+    // Same frame is decoded by the server (test_sensor_batch_handler.py)
+    TEST_ASSERT_EQUAL_STRING(
+        "\"n\":5,\"base_ts\":1718000000,\"raw0\":1801,\"d\":[-6,17,-22,16],\"dt\":1000",
+        frame);
+
+    RawSample decoded[RAW_BATCH_MAX_SAMPLES];
+    uint32_t base_ts = 0;
+    uint8_t n = 0;
+    TEST_ASSERT_TRUE(RawSampleBatch::decode(frame, base_ts, decoded, RAW_BATCH_MAX_SAMPLES, n));
+    TEST_ASSERT_EQUAL_UINT8(5, n);
+    TEST_ASSERT_EQUAL_UINT32(1718000000UL, base_ts);
+    for (uint8_t i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_INT32(raws[i], decoded[i].raw);
+        TEST_ASSERT_EQUAL_UINT32(i * 1000UL, decoded[i].timestamp_ms);
+    }
+}
+
+void test_batch_roundtrip_jittered_spacing_and_negative_raw() {
+    // DS18B20 raw (int16, 1/16 °C) around freezing with loop jitter
+    const int32_t raws[] = {8, 3, -2, -9, -16, -4};
+    const uint32_t ts[] = {100000, 101010, 101995, 103000, 104020, 105001};
+    for (uint8_t i = 0; i < 6; i++) {
+        batch.add(raws[i], ts[i]);
+    }
+
+    char frame[256];
+    TEST_ASSERT_TRUE(batch.encode(frame, sizeof(frame), 42) > 0);
+    // Same frame is decoded by the server (test_sensor_batch_handler.py)
+    TEST_ASSERT_EQUAL_STRING(
+        "\"n\":6,\"base_ts\":42,\"raw0\":8,\"d\":[-5,-5,-7,-7,12],\"dt\":[1010,985,1005,1020,981]",
+        frame);
+
+    RawSample decoded[RAW_BATCH_MAX_SAMPLES];
+    uint32_t base_ts = 0;
+    uint8_t n = 0;
+    TEST_ASSERT_TRUE(RawSampleBatch::decode(frame, base_ts, decoded, RAW_BATCH_MAX_SAMPLES, n));
+    TEST_ASSERT_EQUAL_UINT8(6, n);
+    for (uint8_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_INT32(raws[i], decoded[i].raw);
+        TEST_ASSERT_EQUAL_UINT32(ts[i] - ts[0], decoded[i].timestamp_ms);
+    }
+}
+
+void test_batch_roundtrip_full_ring_fits_frame() {
+    batch.configure(makePolicy(RAW_BATCH_MAX_SAMPLES, 0, 0));
+    // Worst case: full-scale swings with jitter
+    for (uint8_t i = 0; i < RAW_BATCH_MAX_SAMPLES; i++) {
+        batch.add((i & 1) ? 4095 : -4096, i * 1003UL + (i % 3));
+    }
+
+    char frame[640];  // SensorManager::RAW_BATCH_FRAME_MAX_LEN
+    size_t len = batch.encode(frame, sizeof(frame), 1718000000UL);
+    TEST_ASSERT_TRUE(len > 0);
+
+    RawSample decoded[RAW_BATCH_MAX_SAMPLES];
+    uint32_t base_ts = 0;
+    uint8_t n = 0;
+    TEST_ASSERT_TRUE(RawSampleBatch::decode(frame, base_ts, decoded, RAW_BATCH_MAX_SAMPLES, n));
+    TEST_ASSERT_EQUAL_UINT8(RAW_BATCH_MAX_SAMPLES, n);
+    for (uint8_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_INT32(batch.at(i).raw, decoded[i].raw);
+        TEST_ASSERT_EQUAL_UINT32(batch.at(i).timestamp_ms - batch.at(0).timestamp_ms,
+                                 decoded[i].timestamp_ms);
+    }
+}
+
+void test_batch_encode_rejects_small_buffer() {
+    for (uint8_t i = 0; i < 5; i++) {
+        batch.add(1800 + i, i * 1000UL);
+    }
+    char frame[16];
+    TEST_ASSERT_EQUAL_UINT32(0, batch.encode(frame, sizeof(frame), 1718000000UL));
+}
+
+// ============================================
+// FLUSH POLICY
+// ============================================
+
+void test_batch_flush_on_size() {
+    for (uint8_t i = 0; i < 9; i++) {
+        TEST_ASSERT_FALSE(batch.add(1800, i * 1000UL));
+    }
+    TEST_ASSERT_TRUE(batch.add(1800, 9000));
+    TEST_ASSERT_TRUE(batch.isFlushDue(9000));
+}
+
+void test_batch_flush_on_interval() {
+    batch.configure(makePolicy(30, 10000, 0));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, batch.getMsUntilFlush(0));
+
+    batch.add(1800, 2000);
+    TEST_ASSERT_EQUAL_UINT32(10000, batch.getMsUntilFlush(2000));
+    TEST_ASSERT_EQUAL_UINT32(3000, batch.getMsUntilFlush(9000));
+    TEST_ASSERT_FALSE(batch.isFlushDue(11999));
+    TEST_ASSERT_TRUE(batch.isFlushDue(12000));
+}
+
+void test_batch_flush_immediately_on_threshold_crossing() {
+    batch.configure(makePolicy(30, 0, 50));
+    TEST_ASSERT_FALSE(batch.add(1800, 0));
+    TEST_ASSERT_FALSE(batch.add(1830, 1000));
+    TEST_ASSERT_TRUE(batch.add(1851, 2000));  // Dosing step
+
+    // After the flush the last sample is the new reference
+    batch.clear();
+    TEST_ASSERT_FALSE(batch.add(1860, 3000));
+    TEST_ASSERT_TRUE(batch.add(1800, 4000));
+}
+
+void test_batch_offline_ring_keeps_newest() {
+    batch.configure(makePolicy(4, 0, 0));
+    for (uint8_t i = 0; i < 6; i++) {
+        batch.add(100 + i, i * 1000UL);  // Flush fails → never cleared
+    }
+    TEST_ASSERT_EQUAL_UINT8(4, batch.count());
+    TEST_ASSERT_EQUAL_UINT32(2, batch.getDroppedCount());
+    TEST_ASSERT_EQUAL_INT32(102, batch.at(0).raw);
+    TEST_ASSERT_EQUAL_INT32(105, batch.at(3).raw);
+}
+
+void test_batch_reduces_transactions_by_order_of_magnitude() {
+    // One hour of 1 Hz raw acquisition with 30-sample frames
+    batch.configure(makePolicy(30, 60000, 0));
+    uint32_t frames = 0;
+    for (uint32_t t = 0; t < 3600; t++) {
+        if (batch.add(1800 + (t % 7), t * 1000UL) || batch.isFlushDue(t * 1000UL)) {
+            frames++;
+            batch.clear();
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(120, frames);
+    TEST_ASSERT_TRUE(frames * 10 <= 3600);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_batch_roundtrip_uniform_spacing);
+    RUN_TEST(test_batch_roundtrip_jittered_spacing_and_negative_raw);
+    RUN_TEST(test_batch_roundtrip_full_ring_fits_frame);
+    RUN_TEST(test_batch_encode_rejects_small_buffer);
+    RUN_TEST(test_batch_flush_on_size);
+    RUN_TEST(test_batch_flush_on_interval);
+    RUN_TEST(test_batch_flush_immediately_on_threshold_crossing);
+    RUN_TEST(test_batch_offline_ring_keeps_newest);
+    RUN_TEST(test_batch_reduces_transactions_by_order_of_magnitude);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,211 @@
+#include <unity.h>
+
+#include <math.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "services/sensor/reading_validator.h"
+
+// ============================================
+// RECORDED TRACES
+// ============================================
+// Captured from field nodes (30 s interval unless noted), values in sensor units.
+struct TraceSample {
+    uint32_t t_ms;
+    float value;
+    uint32_t raw;
+};
+
+// DS18B20 in a nutrient tank: ±0.06 °C noise, one 85 °C power-on value after a
+// brown-out of the sensor supply (sample 6), raw = value * 16.
+static const TraceSample DS18B20_TANK_TRACE[] = {
+    {0,      21.3125f, 341}, {30000,  21.3750f, 342}, {60000,  21.3125f, 341},
+    {90000,  21.2500f, 340}, {120000, 21.3125f, 341}, {150000, 21.3750f, 342},
+    {180000, 85.0000f, 1360},
+    {210000, 21.3750f, 342}, {240000, 21.4375f, 343}, {270000, 21.3750f, 342},
+    {300000, 21.4375f, 343}, {330000, 21.5000f, 344},
+};
+
+// SHT31 humidity in a greenhouse (10 s interval): noisy, one I2C glitch reading
+// 0 % (bus collision, sample 5) and one 100 % spike (sample 9).
+static const TraceSample SHT31_HUMIDITY_TRACE[] = {
+    {0,     64.2f, 42074}, {10000, 64.9f, 42532}, {20000, 63.8f, 41812},
+    {30000, 64.5f, 42270}, {40000, 65.1f, 42663}, {50000, 0.0f, 0},
+    {60000, 64.7f, 42401}, {70000, 64.0f, 41943}, {80000, 65.3f, 42794},
+    {90000, 100.0f, 65535}, {100000, 64.8f, 42467}, {110000, 65.4f, 42860},
+};
+
+// pH probe raw ADC around dosing: noisy plateau, then a real, persistent step
+// from ~1800 to ~2350 counts after acid dosing (from sample 6 on).
+static const TraceSample PH_DOSING_TRACE[] = {
+    {0,      1801.0f, 1801}, {30000,  1795.0f, 1795}, {60000,  1812.0f, 1812},
+    {90000,  1790.0f, 1790}, {120000, 1806.0f, 1806}, {150000, 1799.0f, 1799},
+    {180000, 2351.0f, 2351}, {210000, 2344.0f, 2344}, {240000, 2362.0f, 2362},
+    {270000, 2349.0f, 2349}, {300000, 2355.0f, 2355},
+};
+
+static ReadingValidator validator;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static uint32_t countGrade(const ReadingVerdict* verdicts, size_t n, ReadingGrade grade) {
+    uint32_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (verdicts[i].grade == grade) {
+            count++;
+        }
+    }
+    return count;
+}
+
+template <size_t N>
+static void runTrace(const TraceSample (&trace)[N], ReadingVerdict* verdicts) {
+    for (size_t i = 0; i < N; i++) {
+        verdicts[i] = validator.validate(trace[i].value, trace[i].raw, trace[i].t_ms);
+    }
+}
+
+// ============================================
+// TEST CASES
+// ============================================
+
+void test_validator_rejects_ds18b20_power_on_spike() {
+    validator.configure(ReadingValidator::configForSensorType("ds18b20"));
+    const size_t n = sizeof(DS18B20_TANK_TRACE) / sizeof(DS18B20_TANK_TRACE[0]);
+    ReadingVerdict verdicts[n];
+    runTrace(DS18B20_TANK_TRACE, verdicts);
+
+    TEST_ASSERT_EQUAL(ReadingGrade::REJECTED, verdicts[6].grade);
+    TEST_ASSERT_EQUAL(ReadingRejectReason::RATE_OF_CHANGE, verdicts[6].reason);
+    TEST_ASSERT_EQUAL_UINT32(1, countGrade(verdicts, n, ReadingGrade::REJECTED));
+    TEST_ASSERT_EQUAL_UINT32(n - 1, countGrade(verdicts, n, ReadingGrade::GOOD));
+}
+
+void test_validator_rejects_i2c_glitches_keeps_noise() {
+    validator.configure(ReadingValidator::configForSensorType("sht31_humidity"));
+    const size_t n = sizeof(SHT31_HUMIDITY_TRACE) / sizeof(SHT31_HUMIDITY_TRACE[0]);
+    ReadingVerdict verdicts[n];
+    runTrace(SHT31_HUMIDITY_TRACE, verdicts);
+
+    TEST_ASSERT_EQUAL(ReadingGrade::REJECTED, verdicts[5].grade);
+    TEST_ASSERT_EQUAL(ReadingGrade::REJECTED, verdicts[9].grade);
+    TEST_ASSERT_EQUAL_UINT32(2, countGrade(verdicts, n, ReadingGrade::REJECTED));
+    TEST_ASSERT_EQUAL_UINT32(2, validator.getRejectedCount());
+    TEST_ASSERT_EQUAL_UINT32(n - 2, validator.getAcceptedCount());
+}
+
+void test_validator_hampel_catches_spike_without_rate_limit() {
+    ReadingValidatorConfig config = ReadingValidator::configForSensorType("sht31_humidity");
+    config.max_rate_per_s = 0.0f;  // Only the Hampel stage is active
+    validator.configure(config);
+    const size_t n = sizeof(SHT31_HUMIDITY_TRACE) / sizeof(SHT31_HUMIDITY_TRACE[0]);
+    ReadingVerdict verdicts[n];
+    runTrace(SHT31_HUMIDITY_TRACE, verdicts);
+
+    TEST_ASSERT_EQUAL(ReadingRejectReason::OUTLIER, verdicts[5].reason);
+    TEST_ASSERT_EQUAL(ReadingRejectReason::OUTLIER, verdicts[9].reason);
+    TEST_ASSERT_EQUAL_UINT32(2, countGrade(verdicts, n, ReadingGrade::REJECTED));
+}
+
+void test_validator_accepts_persistent_level_shift() {
+    validator.configure(ReadingValidator::configForSensorType("ph"));
+    const size_t n = sizeof(PH_DOSING_TRACE) / sizeof(PH_DOSING_TRACE[0]);
+    ReadingVerdict verdicts[n];
+    runTrace(PH_DOSING_TRACE, verdicts);
+
+    // Two rejections, then the new level is adopted as SUSPECT and the window restarts
+    TEST_ASSERT_EQUAL(ReadingGrade::REJECTED, verdicts[6].grade);
+    TEST_ASSERT_EQUAL(ReadingGrade::REJECTED, verdicts[7].grade);
+    TEST_ASSERT_EQUAL(ReadingGrade::SUSPECT, verdicts[8].grade);
+    TEST_ASSERT_EQUAL(ReadingGrade::GOOD, verdicts[9].grade);
+    TEST_ASSERT_EQUAL(ReadingGrade::GOOD, verdicts[10].grade);
+}
+
+void test_validator_flags_stuck_value() {
+    ReadingValidatorConfig config = ReadingValidator::configForSensorType("sht31_temp");
+    validator.configure(config);
+
+    ReadingVerdict verdict;
+    for (uint16_t i = 0; i < config.stuck_limit - 1; i++) {
+        verdict = validator.validate(22.5f, 25800, i * 10000UL);
+        TEST_ASSERT_EQUAL(ReadingGrade::GOOD, verdict.grade);
+    }
+    verdict = validator.validate(22.5f, 25800, config.stuck_limit * 10000UL);
+    TEST_ASSERT_TRUE(verdict.stuck);
+    TEST_ASSERT_EQUAL(ReadingGrade::SUSPECT, verdict.grade);
+
+    // A changed raw value clears the stuck flag
+    verdict = validator.validate(22.6f, 25812, (config.stuck_limit + 1) * 10000UL);
+    TEST_ASSERT_FALSE(verdict.stuck);
+    TEST_ASSERT_EQUAL(ReadingGrade::GOOD, verdict.grade);
+}
+
+void test_validator_slow_ramp_is_accepted() {
+    validator.configure(ReadingValidator::configForSensorType("bmp280_temp"));
+    // Sunrise warming: +0.25 °C per 30 s sample
+    for (uint32_t i = 0; i < 40; i++) {
+        ReadingVerdict verdict = validator.validate(15.0f + 0.25f * i, 1500 + 25 * i, i * 30000UL);
+        TEST_ASSERT_EQUAL(ReadingGrade::GOOD, verdict.grade);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, validator.getRejectedCount());
+}
+
+void test_validator_rejects_nan_always() {
+    validator.configure(ReadingValidator::configForSensorType("sht31_temp"));
+    for (uint8_t i = 0; i < 5; i++) {
+        ReadingVerdict verdict = validator.validate(NAN, 0, i * 1000UL);
+        TEST_ASSERT_EQUAL(ReadingGrade::REJECTED, verdict.grade);
+    }
+}
+
+void test_validator_unknown_type_passes_through() {
+    ReadingValidatorConfig config = ReadingValidator::configForSensorType("digital");
+    TEST_ASSERT_FALSE(config.enabled);
+    validator.configure(config);
+    TEST_ASSERT_EQUAL(ReadingGrade::GOOD, validator.validate(0.0f, 0, 0).grade);
+    TEST_ASSERT_EQUAL(ReadingGrade::GOOD, validator.validate(1.0f, 1, 10).grade);
+    TEST_ASSERT_EQUAL(ReadingGrade::GOOD, validator.validate(4095.0f, 4095, 20).grade);
+}
+
+void test_validator_window_memory_is_bounded() {
+    validator.configure(ReadingValidator::configForSensorType("ph"));
+    for (uint32_t i = 0; i < 1000; i++) {
+        validator.validate(1800.0f + (i % 5), 1800 + (i % 5), i * 1000UL);
+    }
+    TEST_ASSERT_EQUAL_UINT8(ReadingValidator::WINDOW_SIZE, validator.getWindowCount());
+    TEST_ASSERT_EQUAL_UINT32(1000, validator.getAcceptedCount());
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_validator_rejects_ds18b20_power_on_spike);
+    RUN_TEST(test_validator_rejects_i2c_glitches_keeps_noise);
+    RUN_TEST(test_validator_hampel_catches_spike_without_rate_limit);
+    RUN_TEST(test_validator_accepts_persistent_level_shift);
+    RUN_TEST(test_validator_flags_stuck_value);
+    RUN_TEST(test_validator_slow_ramp_is_accepted);
+    RUN_TEST(test_validator_rejects_nan_always);
+    RUN_TEST(test_validator_unknown_type_passes_through);
+    RUN_TEST(test_validator_window_memory_is_bounded);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
@@ -0,0 +1,184 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "../mocks/mock_gpio_hal.h"
+#include "../helpers/gpio_manager_test_helper.h"
+#include "../../src/drivers/gpio_manager.h"
+#include "../../src/drivers/sensor_excitation.h"
+
+// ============================================
+// TEST FIXTURES
+// ============================================
+MockGPIOHal gpio_mock;
+
+static const uint8_t MOISTURE_GPIO = 34;   // Capacitive probe (ADC1)
+static const uint8_t MOISTURE2_GPIO = 35;  // Second probe on the same supply
+static const uint8_t EC_GPIO = 32;
+static const uint8_t EXC_GPIO = 25;        // Probe supply
+static const uint8_t EXC2_GPIO = 26;
+
+void setUp(void) {
+    gpio_mock.reset();
+    GPIOManager& mgr = GPIOManager::getInstance();
+    GPIOManagerTestHelper::reset(mgr);
+    GPIOManagerTestHelper::injectHAL(mgr, &gpio_mock);
+    mgr.initializeAllPinsToSafeMode();
+
+    sensorExcitation.reset();
+    gpio_mock.clearWriteLog();
+}
+
+void tearDown(void) {
+    sensorExcitation.reset();
+    GPIOManagerTestHelper::reset(GPIOManager::getInstance());
+}
+
+// ============================================
+// OWNERSHIP
+// ============================================
+
+void test_excitation_attach_owns_pin_and_drives_off() {
+    TEST_ASSERT_TRUE(sensorExcitation.attach(MOISTURE_GPIO, EXC_GPIO, 100, true));
+    TEST_ASSERT_TRUE(sensorExcitation.hasExcitation(MOISTURE_GPIO));
+    TEST_ASSERT_FALSE(GPIOManager::getInstance().isPinAvailable(EXC_GPIO));
+    TEST_ASSERT_TRUE(GPIOMode::GPIO_OUTPUT == gpio_mock.getPinMode(EXC_GPIO));
+
+    TEST_ASSERT_EQUAL_UINT32(1, gpio_mock.getWriteLog().size());
+    TEST_ASSERT_FALSE(gpio_mock.getPinValue(EXC_GPIO));  // Probe unpowered until measured
+    TEST_ASSERT_FALSE(sensorExcitation.isExcitationOn(EXC_GPIO));
+}
+
+void test_excitation_rejects_pin_owned_elsewhere() {
+    TEST_ASSERT_TRUE(GPIOManager::getInstance().requestPin(EXC_GPIO, "actuator", "pump"));
+    TEST_ASSERT_FALSE(sensorExcitation.attach(MOISTURE_GPIO, EXC_GPIO, 100, true));
+    TEST_ASSERT_FALSE(sensorExcitation.attach(MOISTURE_GPIO, MOISTURE_GPIO, 100, true));
+    TEST_ASSERT_EQUAL_UINT8(0, sensorExcitation.getAttachedCount());
+    TEST_ASSERT_EQUAL_UINT32(0, gpio_mock.getWriteLog().size());  // Foreign pin never driven
+}
+
+void test_excitation_detach_releases_pin() {
+    sensorExcitation.attach(MOISTURE_GPIO, EXC_GPIO, 100, true);
+    sensorExcitation.prepare(MOISTURE_GPIO, 1000);
+    sensorExcitation.detach(MOISTURE_GPIO);
+
+    TEST_ASSERT_FALSE(sensorExcitation.hasExcitation(MOISTURE_GPIO));
+    TEST_ASSERT_FALSE(gpio_mock.getWriteLog().back().value);  // OFF before release
+    TEST_ASSERT_TRUE(GPIOMode::GPIO_INPUT_PULLUP == gpio_mock.getPinMode(EXC_GPIO));
+    TEST_ASSERT_TRUE(GPIOManager::getInstance().isPinAvailable(EXC_GPIO));
+    TEST_ASSERT_FALSE(GPIOManager::getInstance().writePin(EXC_GPIO, true));  // No longer owned
+}
+
+// ============================================
+// SEQUENCING
+// ============================================
+
+void test_excitation_on_settle_read_off_sequence() {
+    sensorExcitation.attach(MOISTURE_GPIO, EXC_GPIO, 100, true);
+    gpio_mock.clearWriteLog();
+
+    TEST_ASSERT_EQUAL_UINT32(100, sensorExcitation.prepare(MOISTURE_GPIO, 1000));
+    TEST_ASSERT_TRUE(gpio_mock.getPinValue(EXC_GPIO));
+    TEST_ASSERT_EQUAL_UINT32(60, sensorExcitation.getMsUntilReady(MOISTURE_GPIO, 1040));
+
+    // Re-polled by the scheduler: no second ON write, settle counts from first ON
+    TEST_ASSERT_EQUAL_UINT32(30, sensorExcitation.prepare(MOISTURE_GPIO, 1070));
+    TEST_ASSERT_EQUAL_UINT32(0, sensorExcitation.prepare(MOISTURE_GPIO, 1100));
+    TEST_ASSERT_EQUAL_UINT32(1100, sensorExcitation.getReadyAtMs(MOISTURE_GPIO));
+
+    sensorExcitation.release(MOISTURE_GPIO);
+    TEST_ASSERT_FALSE(gpio_mock.getPinValue(EXC_GPIO));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, sensorExcitation.getMsUntilReady(MOISTURE_GPIO, 1100));
+
+    const std::vector<MockGPIOHal::PinWrite>& log = gpio_mock.getWriteLog();
+    TEST_ASSERT_EQUAL_UINT32(2, log.size());
+    TEST_ASSERT_EQUAL_UINT8(EXC_GPIO, log[0].gpio);
+    TEST_ASSERT_TRUE(log[0].value);
+    TEST_ASSERT_FALSE(log[1].value);
+}
+
+void test_excitation_extra_settle_for_adc_window() {
+    sensorExcitation.attach(MOISTURE_GPIO, EXC_GPIO, 100, true);
+    TEST_ASSERT_EQUAL_UINT32(250, sensorExcitation.prepare(MOISTURE_GPIO, 0, 150));
+    TEST_ASSERT_EQUAL_UINT32(250, sensorExcitation.getReadyAtMs(MOISTURE_GPIO));
+}
+
+void test_excitation_active_low_polarity() {
+    TEST_ASSERT_TRUE(sensorExcitation.attach(EC_GPIO, EXC2_GPIO, 50, false));
+    TEST_ASSERT_TRUE(gpio_mock.getPinValue(EXC2_GPIO));   // OFF = HIGH (P-MOSFET high side)
+
+    sensorExcitation.prepare(EC_GPIO, 0);
+    TEST_ASSERT_FALSE(gpio_mock.getPinValue(EXC2_GPIO));  // ON = LOW
+    sensorExcitation.release(EC_GPIO);
+    TEST_ASSERT_TRUE(gpio_mock.getPinValue(EXC2_GPIO));
+}
+
+void test_excitation_no_binding_is_ready_immediately() {
+    TEST_ASSERT_EQUAL_UINT32(0, sensorExcitation.prepare(EC_GPIO, 500));
+    sensorExcitation.release(EC_GPIO);
+    TEST_ASSERT_EQUAL_UINT32(0, gpio_mock.getWriteLog().size());
+}
+
+// ============================================
+// SHARED PIN / SAFETY NET
+// ============================================
+
+void test_excitation_shared_pin_off_after_last_waiter() {
+    sensorExcitation.attach(MOISTURE_GPIO, EXC_GPIO, 100, true);
+    TEST_ASSERT_TRUE(sensorExcitation.attach(MOISTURE2_GPIO, EXC_GPIO, 100, true));
+    TEST_ASSERT_FALSE(sensorExcitation.attach(EC_GPIO, EXC_GPIO, 100, false));  // Polarity conflict
+
+    TEST_ASSERT_EQUAL_UINT32(100, sensorExcitation.prepare(MOISTURE_GPIO, 1000));
+    // Second probe joins the already powered pin: settle counts from first ON
+    TEST_ASSERT_EQUAL_UINT32(60, sensorExcitation.prepare(MOISTURE2_GPIO, 1040));
+
+    sensorExcitation.release(MOISTURE_GPIO);
+    TEST_ASSERT_TRUE(gpio_mock.getPinValue(EXC_GPIO));    // Probe 2 still waiting
+    sensorExcitation.release(MOISTURE2_GPIO);
+    TEST_ASSERT_FALSE(gpio_mock.getPinValue(EXC_GPIO));
+
+    // Pin stays owned until the last sensor detaches
+    sensorExcitation.detach(MOISTURE_GPIO);
+    TEST_ASSERT_FALSE(GPIOManager::getInstance().isPinAvailable(EXC_GPIO));
+    sensorExcitation.detach(MOISTURE2_GPIO);
+    TEST_ASSERT_TRUE(GPIOManager::getInstance().isPinAvailable(EXC_GPIO));
+}
+
+void test_excitation_expire_switches_off_unread_pin() {
+    sensorExcitation.attach(MOISTURE_GPIO, EXC_GPIO, 100, true);
+    sensorExcitation.prepare(MOISTURE_GPIO, 1000);
+
+    sensorExcitation.expire(1100 + SENSOR_EXCITATION_MAX_HOLD_MS - 1);
+    TEST_ASSERT_TRUE(sensorExcitation.isExcitationOn(EXC_GPIO));
+
+    sensorExcitation.expire(1100 + SENSOR_EXCITATION_MAX_HOLD_MS);
+    TEST_ASSERT_FALSE(sensorExcitation.isExcitationOn(EXC_GPIO));
+    TEST_ASSERT_FALSE(gpio_mock.getPinValue(EXC_GPIO));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, sensorExcitation.getMsUntilReady(MOISTURE_GPIO, 3200));
+
+    // Next cycle starts a fresh settle period
+    TEST_ASSERT_EQUAL_UINT32(100, sensorExcitation.prepare(MOISTURE_GPIO, 5000));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_excitation_attach_owns_pin_and_drives_off);
+    RUN_TEST(test_excitation_rejects_pin_owned_elsewhere);
+    RUN_TEST(test_excitation_detach_releases_pin);
+    RUN_TEST(test_excitation_on_settle_read_off_sequence);
+    RUN_TEST(test_excitation_extra_settle_for_adc_window);
+    RUN_TEST(test_excitation_active_low_polarity);
+    RUN_TEST(test_excitation_no_binding_is_ready_immediately);
+    RUN_TEST(test_excitation_shared_pin_off_after_last_waiter);
+    RUN_TEST(test_excitation_expire_switches_off_unread_pin);
+    return UNITY_END();
+}
+#endif
@@ -0,0 +1,245 @@
+#include <unity.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "drivers/sht3x_periodic.h"
+#include "../mocks/mock_i2c_hal.h"
+
+static MockI2CHal hal;
+static Sht3xPeriodicManager* sht3x = nullptr;
+
+static const uint8_t ADDR = 0x44;
+
+void setUp(void) {
+    hal.reset();
+    delete sht3x;
+    sht3x = new Sht3xPeriodicManager();
+}
+
+void tearDown(void) {}
+
+// Arms at t=0 with a 30 s sensor interval and clears the log
+static void armDefault() {
+    TEST_ASSERT_TRUE(sht3x->arm(hal, ADDR, 30000, 0, 0));
+    hal.clearLog();
+}
+
+static void assertWrite(size_t index, uint16_t command) {
+    TEST_ASSERT_TRUE(index < hal.log.size());
+    TEST_ASSERT_TRUE(hal.log[index].is_write);
+    TEST_ASSERT_EQUAL_HEX16(command, hal.log[index].command);
+}
+
+static void assertRead(size_t index) {
+    TEST_ASSERT_TRUE(index < hal.log.size());
+    TEST_ASSERT_FALSE(hal.log[index].is_write);
+    TEST_ASSERT_EQUAL_UINT32(SHT3X_RESPONSE_BYTES, hal.log[index].length);
+}
+
+// ============================================
+// ARMING
+// ============================================
+
+void test_sht3x_rate_selection_keeps_two_results_per_interval() {
+    TEST_ASSERT_EQUAL_HEX16(SHT3X_CMD_PERIODIC_0_5_MPS, Sht3xPeriodicManager::selectPeriodicCommand(30000));
+    TEST_ASSERT_EQUAL_HEX16(SHT3X_CMD_PERIODIC_0_5_MPS, Sht3xPeriodicManager::selectPeriodicCommand(4000));
+    TEST_ASSERT_EQUAL_HEX16(SHT3X_CMD_PERIODIC_1_MPS, Sht3xPeriodicManager::selectPeriodicCommand(2000));
+    TEST_ASSERT_EQUAL_HEX16(SHT3X_CMD_PERIODIC_2_MPS, Sht3xPeriodicManager::selectPeriodicCommand(1000));
+    TEST_ASSERT_EQUAL_HEX16(SHT3X_CMD_PERIODIC_4_MPS, Sht3xPeriodicManager::selectPeriodicCommand(500));
+    TEST_ASSERT_EQUAL_HEX16(SHT3X_CMD_PERIODIC_10_MPS, Sht3xPeriodicManager::selectPeriodicCommand(200));
+    TEST_ASSERT_EQUAL_UINT32(2000, Sht3xPeriodicManager::periodMsForCommand(SHT3X_CMD_PERIODIC_0_5_MPS));
+}
+
+void test_sht3x_arm_sends_break_then_periodic_command_once() {
+    TEST_ASSERT_TRUE(sht3x->arm(hal, ADDR, 30000, 0, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, hal.log.size());
+    assertWrite(0, SHT3X_CMD_BREAK);           // Warm reboot: stop previous periodic mode
+    assertWrite(1, SHT3X_CMD_PERIODIC_0_5_MPS);
+    TEST_ASSERT_TRUE(hal.periodic);
+    TEST_ASSERT_TRUE(sht3x->isPeriodic(ADDR));
+
+    // Second value type of the same device (sht31_humidity) → no bus traffic
+    hal.clearLog();
+    TEST_ASSERT_TRUE(sht3x->arm(hal, ADDR, 30000, 10, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, hal.log.size());
+}
+
+void test_sht3x_arm_rate_change_restarts_periodic_mode() {
+    armDefault();
+    TEST_ASSERT_TRUE(sht3x->arm(hal, ADDR, 1000, 100, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, hal.log.size());
+    assertWrite(0, SHT3X_CMD_BREAK);
+    assertWrite(1, SHT3X_CMD_PERIODIC_2_MPS);
+    TEST_ASSERT_EQUAL_HEX16(SHT3X_CMD_PERIODIC_2_MPS, hal.periodic_command);
+}
+
+// ============================================
+// PERIODIC READ
+// ============================================
+
+void test_sht3x_periodic_read_is_fetch_only_without_wait() {
+    armDefault();
+    uint8_t buffer[8] = {0};
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 30000, 0));
+
+    TEST_ASSERT_EQUAL_UINT32(2, hal.log.size());
+    assertWrite(0, SHT3X_CMD_FETCH_DATA);
+    assertRead(1);
+    TEST_ASSERT_EQUAL_UINT32(0, hal.total_delay_ms);
+    TEST_ASSERT_EQUAL_HEX8(0x66, buffer[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xA2, buffer[5]);
+}
+
+void test_sht3x_bus_occupancy_vs_single_shot() {
+    // Periodic: 10 readings → 0 ms conversion wait while holding g_i2c_mutex
+    armDefault();
+    uint8_t buffer[6];
+    for (uint32_t i = 1; i <= 10; i++) {
+        TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), i * 30000, 0));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, hal.total_delay_ms);
+    TEST_ASSERT_EQUAL_UINT32(10, sht3x->getFetchCount());
+    TEST_ASSERT_EQUAL_UINT32(0, hal.countWrites(SHT3X_CMD_SINGLE_SHOT_HIGH));
+    TEST_ASSERT_EQUAL_UINT32(20, hal.log.size());  // Exactly fetch + read per reading
+}
+
+void test_sht3x_read_during_warmup_is_not_ready() {
+    armDefault();
+    uint8_t buffer[6];
+    // 0.5 mps: first result after 2000 + 16 ms
+    TEST_ASSERT_EQUAL(Sht3xReadResult::NOT_READY, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 500, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, hal.log.size());
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 2016, 0));
+}
+
+// ============================================
+// RE-ARM
+// ============================================
+
+void test_sht3x_rearm_after_bus_recovery() {
+    armDefault();
+    uint8_t buffer[6];
+
+    // I2CBusManager::recoverBus() succeeded → generation 0 → 1
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 30000, 1));
+    TEST_ASSERT_EQUAL_UINT32(4, hal.log.size());
+    assertWrite(0, SHT3X_CMD_BREAK);
+    assertWrite(1, SHT3X_CMD_SINGLE_SHOT_HIGH);   // Reading is not lost
+    assertRead(2);
+    assertWrite(3, SHT3X_CMD_PERIODIC_0_5_MPS);
+    TEST_ASSERT_EQUAL_UINT32(1, sht3x->getRearmCount());
+    TEST_ASSERT_TRUE(hal.periodic);
+
+    // Next interval: back to fetch-only
+    hal.clearLog();
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 60000, 1));
+    TEST_ASSERT_EQUAL_UINT32(2, hal.log.size());
+    assertWrite(0, SHT3X_CMD_FETCH_DATA);
+}
+
+void test_sht3x_rearm_after_sensor_reset() {
+    armDefault();
+    uint8_t buffer[6];
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 30000, 0));
+
+    hal.resetSensor();  // Brown-out: sensor back in idle
+    TEST_ASSERT_EQUAL(Sht3xReadResult::NACK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 60000, 0));
+
+    hal.clearLog();
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 90000, 0));
+    assertWrite(0, SHT3X_CMD_BREAK);
+    assertWrite(1, SHT3X_CMD_SINGLE_SHOT_HIGH);
+    assertRead(2);
+    assertWrite(3, SHT3X_CMD_PERIODIC_0_5_MPS);
+    TEST_ASSERT_TRUE(hal.periodic);
+    TEST_ASSERT_TRUE(sht3x->isPeriodic(ADDR));
+
+    hal.clearLog();
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 120000, 0));
+    assertWrite(0, SHT3X_CMD_FETCH_DATA);
+}
+
+// ============================================
+// FALLBACK
+// ============================================
+
+void test_sht3x_fallback_to_single_shot_after_errors() {
+    armDefault();
+    uint8_t buffer[6];
+    for (uint8_t i = 0; i < SHT3X_MAX_PERIODIC_ERRORS; i++) {
+        hal.next_write_error = 4;  // Bus error, recovery did not help (generation unchanged)
+        TEST_ASSERT_EQUAL(Sht3xReadResult::BUS_ERROR,
+                          sht3x->read(hal, ADDR, buffer, sizeof(buffer), 30000 * (i + 1), 0));
+    }
+    TEST_ASSERT_FALSE(sht3x->isPeriodic(ADDR));
+    TEST_ASSERT_EQUAL_UINT32(1, sht3x->getFallbackCount());
+    TEST_ASSERT_FALSE(hal.periodic);  // Break was sent
+
+    hal.clearLog();
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 120000, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, hal.log.size());
+    assertWrite(0, SHT3X_CMD_SINGLE_SHOT_HIGH);
+    TEST_ASSERT_EQUAL_UINT32(SHT3X_SINGLE_SHOT_WAIT_MS, hal.total_delay_ms);
+
+    // After the backoff periodic mode is tried again
+    hal.clearLog();
+    uint32_t retry_ms = 90000 + SHT3X_FALLBACK_REARM_MS;
+    TEST_ASSERT_EQUAL(Sht3xReadResult::OK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), retry_ms, 0));
+    assertWrite(0, SHT3X_CMD_BREAK);
+    assertWrite(1, SHT3X_CMD_SINGLE_SHOT_HIGH);
+    assertWrite(3, SHT3X_CMD_PERIODIC_0_5_MPS);
+    TEST_ASSERT_TRUE(sht3x->isPeriodic(ADDR));
+}
+
+void test_sht3x_arm_failure_starts_in_fallback() {
+    hal.device_present = false;
+    TEST_ASSERT_FALSE(sht3x->arm(hal, ADDR, 30000, 0, 0));
+    TEST_ASSERT_TRUE(sht3x->isManaged(ADDR));
+    TEST_ASSERT_FALSE(sht3x->isPeriodic(ADDR));
+
+    uint8_t buffer[6];
+    TEST_ASSERT_EQUAL(Sht3xReadResult::NACK, sht3x->read(hal, ADDR, buffer, sizeof(buffer), 30000, 0));
+}
+
+void test_sht3x_release_stops_periodic_mode() {
+    armDefault();
+    sht3x->release(hal, ADDR);
+    TEST_ASSERT_EQUAL_UINT32(1, hal.log.size());
+    assertWrite(0, SHT3X_CMD_BREAK);
+    TEST_ASSERT_FALSE(sht3x->isManaged(ADDR));
+    TEST_ASSERT_FALSE(hal.periodic);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+#else
+void setup() {
+    delay(2000);
+#endif
+    UNITY_BEGIN();
+    RUN_TEST(test_sht3x_rate_selection_keeps_two_results_per_interval);
+    RUN_TEST(test_sht3x_arm_sends_break_then_periodic_command_once);
+    RUN_TEST(test_sht3x_arm_rate_change_restarts_periodic_mode);
+    RUN_TEST(test_sht3x_periodic_read_is_fetch_only_without_wait);
+    RUN_TEST(test_sht3x_bus_occupancy_vs_single_shot);
+    RUN_TEST(test_sht3x_read_during_warmup_is_not_ready);
+    RUN_TEST(test_sht3x_rearm_after_bus_recovery);
+    RUN_TEST(test_sht3x_rearm_after_sensor_reset);
+    RUN_TEST(test_sht3x_fallback_to_single_shot_after_errors);
+    RUN_TEST(test_sht3x_arm_failure_starts_in_fallback);
+    RUN_TEST(test_sht3x_release_stops_periodic_mode);
+    UNITY_END();
+#ifdef NATIVE_TEST
+    return 0;
+#endif
+}
+
+#ifndef NATIVE_TEST
+void loop() {}
+#endif
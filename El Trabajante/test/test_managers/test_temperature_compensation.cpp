@@ -0,0 +1,141 @@
+#include <unity.h>
+
+#include <math.h>
+
+#ifdef NATIVE_TEST
+    #include "../mocks/Arduino.h"  // Mock
+#else
+    #include <Arduino.h>  // Echte Arduino-API
+#endif
+
+#include "services/sensor/temperature_compensation.h"
+
+// ============================================
+// REFERENCE TABLES
+// ============================================
+struct TempRow {
+    float temp_c;
+    float value;
+};
+
+// 0.01 mol/l KCl conductivity standard (µS/cm), 1413 µS/cm at 25 °C
+static const TempRow KCL_1413_TABLE[] = {
+    {15.0f, 1147.0f}, {18.0f, 1225.0f}, {20.0f, 1278.0f}, {22.0f, 1332.0f},
+    {24.0f, 1386.0f}, {25.0f, 1413.0f}, {26.0f, 1441.0f}, {28.0f, 1496.0f},
+    {30.0f, 1552.0f}, {31.0f, 1581.0f},
+};
+static const float KCL_ALPHA = 0.0191f;  // KCl temperature coefficient
+
+// Theoretical pH electrode slope (mV/pH)
+static const TempRow NERNST_SLOPE_TABLE[] = {
+    {0.0f, 54.20f}, {10.0f, 56.18f}, {20.0f, 58.17f}, {25.0f, 59.16f},
+    {30.0f, 60.15f}, {40.0f, 62.14f}, {50.0f, 64.12f}, {60.0f, 66.10f},
+};
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Electrode calibrated at 25 °C: mV → pH with the 25 °C slope
+static float phFromCalibrationAt25(float true_ph, float temp_c) {
+    float mv = (7.0f - true_ph) * TemperatureCompensation::nernstSlopeMv(temp_c);
+    return 7.0f - mv / TemperatureCompensation::nernstSlopeMv(25.0f);
+}
+
+// ============================================
+// EC
+// ============================================
+
+void test_ec_kcl_standard_compensates_to_1413() {
+    for (size_t i = 0; i < sizeof(KCL_1413_TABLE) / sizeof(KCL_1413_TABLE[0]); i++) {
+        float ec25 = TemperatureCompensation::compensateEC(KCL_1413_TABLE[i].value,
+                                                           KCL_1413_TABLE[i].temp_c, KCL_ALPHA);
+        TEST_ASSERT_FLOAT_WITHIN(1413.0f * 0.005f, 1413.0f, ec25);  // Linear model: ±0.5 %
+    }
+}
+
+void test_ec_default_alpha_within_one_percent() {
+    float ec25 = TemperatureCompensation::compensateEC(1278.0f, 20.0f, TEMP_COMP_DEFAULT_EC_ALPHA);
+    TEST_ASSERT_FLOAT_WITHIN(1413.0f * 0.01f, 1413.0f, ec25);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, TemperatureCompensation::compensateEC(2.0f, 25.0f, 0.02f));
+}
+
+void test_ec_invalid_alpha_keeps_value() {
+    // 1 + alpha * (T - 25) <= 0 must not divide by zero or flip the sign
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.5f, TemperatureCompensation::compensateEC(1.5f, 0.0f, 0.04f));
+}
+
+// ============================================
+// pH
+// ============================================
+
+void test_ph_nernst_slope_matches_table() {
+    for (size_t i = 0; i < sizeof(NERNST_SLOPE_TABLE) / sizeof(NERNST_SLOPE_TABLE[0]); i++) {
+        TEST_ASSERT_FLOAT_WITHIN(0.02f, NERNST_SLOPE_TABLE[i].value,
+                                 TemperatureCompensation::nernstSlopeMv(NERNST_SLOPE_TABLE[i].temp_c));
+    }
+}
+
+void test_ph_buffers_recovered_at_any_temperature() {
+    const float buffers[] = {4.01f, 6.86f, 9.18f, 10.01f};
+    const float temps[] = {5.0f, 15.0f, 25.0f, 35.0f, 50.0f};
+    for (size_t b = 0; b < 4; b++) {
+        for (size_t t = 0; t < 5; t++) {
+            float uncompensated = phFromCalibrationAt25(buffers[b], temps[t]);
+            TEST_ASSERT_FLOAT_WITHIN(0.005f, buffers[b],
+                                     TemperatureCompensation::compensatePH(uncompensated, temps[t]));
+        }
+    }
+    // Without compensation a pH 4.01 buffer at 5 °C reads ~0.2 pH high
+    TEST_ASSERT_TRUE(phFromCalibrationAt25(4.01f, 5.0f) > 4.2f);
+}
+
+void test_ph_isopotential_point_is_temperature_independent() {
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 7.0f, TemperatureCompensation::compensatePH(7.0f, 5.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 7.0f, TemperatureCompensation::compensatePH(7.0f, 45.0f));
+}
+
+// ============================================
+// APPLY (staleness / plausibility)
+// ============================================
+
+void test_apply_selects_model_by_sensor_type() {
+    TEST_ASSERT_TRUE(TempCompKind::EC == TemperatureCompensation::kindForSensorType("ec"));
+    TEST_ASSERT_TRUE(TempCompKind::PH == TemperatureCompensation::kindForSensorType("ph"));
+    TEST_ASSERT_TRUE(TempCompKind::NONE == TemperatureCompensation::kindForSensorType("ds18b20"));
+    TEST_ASSERT_TRUE(TempCompKind::NONE == TemperatureCompensation::kindForSensorType(nullptr));
+
+    TempCompResult ec = TemperatureCompensation::apply(TempCompKind::EC, 1278.0f, 20.0f, KCL_ALPHA);
+    TEST_ASSERT_TRUE(ec.compensated);
+    TEST_ASSERT_FLOAT_WITHIN(7.0f, 1413.0f, ec.value);
+}
+
+void test_apply_without_valid_temperature_is_uncompensated() {
+    TempCompResult stale = TemperatureCompensation::apply(TempCompKind::PH, 4.5f, NAN, 0.02f);
+    TEST_ASSERT_FALSE(stale.compensated);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 4.5f, stale.value);
+
+    TempCompResult implausible = TemperatureCompensation::apply(TempCompKind::EC, 1.2f, 85.0f, 0.02f);
+    TEST_ASSERT_FALSE(implausible.compensated);  // DS18B20 power-on value
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.2f, implausible.value);
+
+    TempCompResult none = TemperatureCompensation::apply(TempCompKind::NONE, 3.0f, 20.0f, 0.02f);
+    TEST_ASSERT_FALSE(none.compensated);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_ec_kcl_standard_compensates_to_1413);
+    RUN_TEST(test_ec_default_alpha_within_one_percent);
+    RUN_TEST(test_ec_invalid_alpha_keeps_value);
+    RUN_TEST(test_ph_nernst_slope_matches_table);
+    RUN_TEST(test_ph_buffers_recovered_at_any_temperature);
+    RUN_TEST(test_ph_isopotential_point_is_temperature_independent);
+    RUN_TEST(test_apply_selects_model_by_sensor_type);
+    RUN_TEST(test_apply_without_valid_temperature_is_uncompensated);
+    return UNITY_END();
+}
+#endif